@@ -3,67 +3,36 @@
 #include <cmath>
 #include <algorithm>
 
-BehaviorSpline::BehaviorSpline(const std::vector<Vector3>& waypoints, float duration, bool isWorldSpace)
-    : waypoints_(waypoints), duration_(duration), isWorldSpace_(isWorldSpace) {
+BehaviorSpline::BehaviorSpline(std::shared_ptr<const ArcLengthSpline> spline, float duration, bool isWorldSpace)
+    : spline_(std::move(spline)), duration_(duration), isWorldSpace_(isWorldSpace) {
 }
 
 void BehaviorSpline::Update(Enemy* enemy) {
-    if (!enemy || waypoints_.size() < 4) return;
+    if (!enemy || !spline_ || spline_->GetControlPoints().size() < 4) return;
 
     float aliveTime = enemy->GetAliveTime();
 
-    int maxSegments = static_cast<int>(waypoints_.size()) - 1;
-    if (maxSegments < 1) return;
-
     if (duration_ <= 0.0f) duration_ = 1.0f; // ゼロ割防止
-    float totalT = (aliveTime / duration_) * static_cast<float>(maxSegments);
 
-    
+    // 走り切る時間はそのままに、ウェイポイントの間隔に関係なく一定の速さで進む
+    float progress = aliveTime / duration_;
+
     // 終端でストップするか、消滅させるか
-    if (totalT >= maxSegments) {
-        totalT = static_cast<float>(maxSegments);
+    if (progress >= 1.0f) {
         enemy->TakeDamage(9999, true); // 走り終わったら消滅させる
         return;
     }
 
-    int segmentIndex = static_cast<int>(totalT);
-    if (segmentIndex >= maxSegments) {
-        segmentIndex = maxSegments - 1;
-    }
-
-    float t = totalT - segmentIndex;
-
-    auto getWaypoint = [&](int index) -> const Vector3& {
-        return waypoints_[(std::max)(0, (std::min)(index, static_cast<int>(waypoints_.size() - 1)))];
-    };
-
-    const Vector3& p0 = getWaypoint(segmentIndex - 1);
-    const Vector3& p1 = getWaypoint(segmentIndex);
-    const Vector3& p2 = getWaypoint(segmentIndex + 1);
-    const Vector3& p3 = getWaypoint(segmentIndex + 2);
+    // 共有テーブルから位置と進行方向を取得
+    ArcLengthSpline::Sample sample = spline_->SampleAtDistance(progress * spline_->GetLength());
+    const Vector3& localPos = sample.position;
+    const Vector3& localDir = sample.tangent;
 
-    // Spline座標の計算 (MathUtil.hのCatmullRomを使用)
-    Vector3 localPos = CatmullRom(p0, p1, p2, p3, t);
-
-    // 向きの計算 (少し先の未来の座標を見てそこを向く)
-    float tNext = t + 0.05f;
-    Vector3 nextLocalPos;
-    if (tNext >= 1.0f && segmentIndex + 1 < maxSegments) {
-        const Vector3& np0 = getWaypoint(segmentIndex);
-        const Vector3& np1 = getWaypoint(segmentIndex + 1);
-        const Vector3& np2 = getWaypoint(segmentIndex + 2);
-        const Vector3& np3 = getWaypoint(segmentIndex + 3);
-        nextLocalPos = CatmullRom(np0, np1, np2, np3, tNext - 1.0f);
-    } else {
-        tNext = std::min(1.0f, tNext);
-        nextLocalPos = CatmullRom(p0, p1, p2, p3, tNext);
-    }
-    
-    Vector3 nextWorldPos;
+    Vector3 dir;
 
     if (isWorldSpace_) {
         enemy->GetTransform().translate = localPos;
-        nextWorldPos = nextLocalPos;
+        dir = localDir;
     } else {
         // カメラ相対座標系へ変換
         const Vector3& cameraPos = enemy->GetBasePosition();
@@ -84,25 +53,13 @@ void BehaviorSpline::Update(Enemy* enemy) {
             Vector3{cameraRight.x * finalLocal.x, cameraRight.y * finalLocal.x, cameraRight.z * finalLocal.x} +
             Vector3{cameraUp.x * finalLocal.y, cameraUp.y * finalLocal.y, cameraUp.z * finalLocal.y} +
             Vector3{cameraForward.x * finalLocal.z, cameraForward.y * finalLocal.z, cameraForward.z * finalLocal.z};
-        
-        Vector3 nextFinalLocal = {
-            nextLocalPos.x + spawnOffset.x,
-            nextLocalPos.y + spawnOffset.y,
-            nextLocalPos.z + spawnOffset.z
-        };
 
-        nextWorldPos = 
-            cameraPos +
-            Vector3{cameraRight.x * nextFinalLocal.x, cameraRight.y * nextFinalLocal.x, cameraRight.z * nextFinalLocal.x} +
-            Vector3{cameraUp.x * nextFinalLocal.y, cameraUp.y * nextFinalLocal.y, cameraUp.z * nextFinalLocal.y} +
-            Vector3{cameraForward.x * nextFinalLocal.z, cameraForward.y * nextFinalLocal.z, cameraForward.z * nextFinalLocal.z};
+        // 向きは回転だけ適用する
+        dir =
+            Vector3{cameraRight.x * localDir.x, cameraRight.y * localDir.x, cameraRight.z * localDir.x} +
+            Vector3{cameraUp.x * localDir.y, cameraUp.y * localDir.y, cameraUp.z * localDir.y} +
+            Vector3{cameraForward.x * localDir.z, cameraForward.y * localDir.z, cameraForward.z * localDir.z};
     }
-
-    Vector3 dir = {
-        nextWorldPos.x - enemy->GetTransform().translate.x,
-        nextWorldPos.y - enemy->GetTransform().translate.y,
-        nextWorldPos.z - enemy->GetTransform().translate.z
-    };
     
     if (std::abs(dir.x) > 0.001f || std::abs(dir.z) > 0.001f) {
         enemy->GetTransform().rotate.y = std::atan2(dir.x, dir.z);
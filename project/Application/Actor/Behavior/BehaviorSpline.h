@@ -1,18 +1,20 @@
 #pragma once
 #include "IEnemyBehavior.h"
+#include "Math/ArcLengthSpline.h"
 #include "Math/MathUtil.h"
-#include <vector>
+#include <memory>
 
 // Catmull-Rom曲線に沿って移動するAI
 class BehaviorSpline : public IEnemyBehavior {
 public:
+    // spline: 共有の弧長テーブル（同じスプラインを使う敵同士で使い回す）
     // duration: レールを走り切る秒数
     // isWorldSpace: true=ワールド空間として評価, false=カメラからのローカル空間として評価
-    BehaviorSpline(const std::vector<Vector3>& waypoints, float duration, bool isWorldSpace = false);
+    BehaviorSpline(std::shared_ptr<const ArcLengthSpline> spline, float duration, bool isWorldSpace = false);
     void Update(Enemy* enemy) override;
 
 private:
-    std::vector<Vector3> waypoints_;
+    std::shared_ptr<const ArcLengthSpline> spline_;
     float duration_;
     bool isWorldSpace_;
 };
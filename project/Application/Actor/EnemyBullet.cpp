@@ -23,6 +23,8 @@ void EnemyBullet::Initialize(Object3dRenderer *renderer,
                              Player *player, EnemyBulletType type) {
   object3d_ = std::make_unique<Object3d>();
   object3d_->Initialize(renderer);
+  // 同じ見た目の弾はまとめて1回で描く
+  object3d_->SetInstancingEnabled(true);
 
   type_ = type;
   velocity_ = velocity;
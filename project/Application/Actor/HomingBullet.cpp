@@ -20,6 +20,8 @@ HomingBullet::~HomingBullet() {
 void HomingBullet::Initialize(Object3dRenderer* renderer, const Vector3& startPos, BaseActor* target, const Vector3& initialVelocity) {
   object3d_ = std::make_unique<Object3d>();
   object3d_->Initialize(renderer);
+  // 同じ見た目の弾はまとめて1回で描く
+  object3d_->SetInstancingEnabled(true);
   
   // 一旦仮のモデルとしてsuzanneを使用（スケールを小さくして色を変える）
   object3d_->SetModel("suzanne.obj"); 
@@ -1,9 +1,14 @@
 #include "LockOn.h"
+#include "Core/Dx12Core.h"
+#include "Core/WindowSystem.h"
 #include "Math/MathUtil.h"
 #include "Framework/BaseActor.h"
 #include "Render/Object3d/Object3d.h"
+#include "Renderer/SpriteRenderer.h"
 
 void LockOn::Initialize(SpriteRenderer *spriteRenderer) {
+  spriteRenderer_ = spriteRenderer;
+
   // レティクル（カーソル）用のスプライトを最大数分、生成・初期化
   for (int i = 0; i < kMaxLockOnCount; ++i) {
     reticles_[i] = std::make_unique<Sprite>();
@@ -29,6 +34,8 @@ void LockOn::Update(const std::vector<BaseActor *> &inputTargets,
 
   // ロックオンモード（長押し中）でのみ、新たな敵をストックする
   if (isLockOnMode && targets_.size() < kMaxLockOnCount) {
+    candidates_.clear();
+    worldPositions_.clear();
     for (BaseActor* target : inputTargets) {
       if (!target) continue;
 
@@ -40,29 +47,55 @@ void LockOn::Update(const std::vector<BaseActor *> &inputTargets,
         continue;
       }
 
-      Vector3 worldPos = target->GetTransform().translate;
-      Vector2 screenPos = WorldToScreen(worldPos, viewProjectionMatrix, 1280.0f, 720.0f);
+      candidates_.push_back(target);
+      worldPositions_.push_back(target->GetTransform().translate);
+    }
+
+    // 候補をまとめてスクリーン座標に変換する
+    screenPositions_.resize(worldPositions_.size());
+    onScreen_.resize(worldPositions_.size());
+    WorldToScreenBatch(worldPositions_, viewProjectionMatrix, GetViewport(),
+                       screenPositions_, {}, onScreen_);
+
+    const float radiusSq = lockOnRadius * lockOnRadius;
+    for (size_t i = 0; i < candidates_.size(); ++i) {
+      // 画面外の敵はロックオンしない
+      if (!onScreen_[i]) continue;
 
       // 照準と敵の画面上の距離を計算
-      float dx = screenPos.x - reticlePos.x;
-      float dy = screenPos.y - reticlePos.y;
-      float dist = std::sqrt(dx * dx + dy * dy);
+      float dx = screenPositions_[i].x - reticlePos.x;
+      float dy = screenPositions_[i].y - reticlePos.y;
 
-      if (dist <= lockOnRadius) {
-        targets_.push_back(target); // ロックオンストックに追加
+      if (dx * dx + dy * dy <= radiusSq) {
+        targets_.push_back(candidates_[i]); // ロックオンストックに追加
         break; // 1フレームに1体ずつロックオンする
       }
     }
   }
 }
 
+Viewport LockOn::GetViewport() const {
+  if (spriteRenderer_ && spriteRenderer_->GetDx12Core()) {
+    const D3D12_VIEWPORT &viewport = spriteRenderer_->GetDx12Core()->GetViewport();
+    return {viewport.TopLeftX, viewport.TopLeftY, viewport.Width, viewport.Height};
+  }
+  return {0.0f, 0.0f, float(WindowSystem::kClientWidth), float(WindowSystem::kClientHeight)};
+}
+
 void LockOn::Draw() {
+  // ロックオン中の敵をまとめてスクリーン座標に変換する
+  worldPositions_.resize(targets_.size());
+  for (size_t i = 0; i < targets_.size(); ++i) {
+    worldPositions_[i] = targets_[i] ? targets_[i]->GetTransform().translate : Vector3{};
+  }
+  screenPositions_.resize(targets_.size());
+  WorldToScreenBatch(worldPositions_, viewProjectionMatrix_, GetViewport(), screenPositions_);
+
   for (size_t i = 0; i < targets_.size(); ++i) {
     BaseActor* target = targets_[i];
     if (!target) continue;
     
-    Vector3 targetPos = target->GetTransform().translate;
-    Vector2 screenPos = WorldToScreen(targetPos, viewProjectionMatrix_, 1280.0f, 720.0f);
+    const Vector2 &screenPos = screenPositions_[i];
 
     Vector2 drawPos;
     drawPos.x = screenPos.x - 25.0f; // サイズの半分
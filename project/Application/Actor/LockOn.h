@@ -1,5 +1,6 @@
 #pragma once
 #include "Math/Matrix4x4.h"
+#include "Math/ScreenProjection.h"
 #include "Math/Vector2.h"
 #include "Math/Vector3.h"
 #include "Render/Sprite/Sprite.h"
@@ -53,4 +54,17 @@ private:
   std::array<std::unique_ptr<Sprite>, kMaxLockOnCount> reticles_;
   
   Matrix4x4 viewProjectionMatrix_;  // 描画用のカメラ行列キャッシュ
+
+  SpriteRenderer *spriteRenderer_ = nullptr;
+
+  /// <summary>
+  /// 現在の描画先のビューポートを取得
+  /// </summary>
+  Viewport GetViewport() const;
+
+  // スクリーン座標変換用の作業領域（毎フレーム確保し直さないよう保持）
+  std::vector<BaseActor *> candidates_;
+  std::vector<Vector3> worldPositions_;
+  std::vector<Vector2> screenPositions_;
+  std::vector<uint8_t> onScreen_;
 };
@@ -20,6 +20,8 @@ NormalBullet::~NormalBullet() {
 void NormalBullet::Initialize(Object3dRenderer* renderer, const Vector3& startPos, const Vector3& velocity) {
   object3d_ = std::make_unique<Object3d>();
   object3d_->Initialize(renderer);
+  // 同じ見た目の弾はまとめて1回で描く
+  object3d_->SetInstancingEnabled(true);
   
   // 通常弾のモデル
   object3d_->SetModel("suzanne.obj"); 
@@ -22,25 +22,74 @@ RailCamera::RailCamera() {
 void RailCamera::Initialize(const std::vector<Vector3> &waypoints) {
   waypoints_ = waypoints;
   t_ = 0.0f;
+  distance_ = 0.0f;
   isFinished_ = false;
 
+  railSpline_.Build(waypoints_, 16, true);
+  isRailDirty_ = false;
+
   if (waypoints_.size() > 0) {
     transform_.translate = waypoints_[0];
   }
 }
 
+void RailCamera::SetT(float t) {
+  t_ = t;
+  RebuildRailIfNeeded();
+  distance_ = railSpline_.ParamToDistance(t_);
+  if (waypoints_.size() > 0 && t_ < static_cast<float>(waypoints_.size() - 1)) {
+    isFinished_ = false;
+  }
+}
+
+void RailCamera::SetWaypoint(size_t index, const Vector3 &position) {
+  if (index < waypoints_.size()) {
+    waypoints_[index] = position;
+    isRailDirty_ = true;
+  }
+}
+
+void RailCamera::AddWaypoint(const Vector3 &position) {
+  waypoints_.push_back(position);
+  isRailDirty_ = true;
+}
+
+void RailCamera::RemoveWaypoint(size_t index) {
+  if (index < waypoints_.size()) {
+    waypoints_.erase(waypoints_.begin() + index);
+    isRailDirty_ = true;
+  }
+}
+
+void RailCamera::RebuildRailIfNeeded() {
+  if (!isRailDirty_) {
+    return;
+  }
+  // エディタでウェイポイントが動かされた場合も、進行度tの位置は保つ
+  railSpline_.Build(waypoints_, 16, true);
+  distance_ = railSpline_.ParamToDistance(t_);
+  isRailDirty_ = false;
+}
+
 void RailCamera::Update() {
   if (waypoints_.size() < 2)
     return;
 
-  if (!isFinished_ && isAutoMove_) {
-    // 時間で進行度を進める (speed_ は 1秒間に何セグメント進むか)
-    t_ += speed_ * (1.0f / 60.0f);
+  RebuildRailIfNeeded();
 
-    float maxT = static_cast<float>(waypoints_.size() - 1);
-    if (t_ >= maxT) {
-      t_ = maxT;
+  if (!isFinished_ && isAutoMove_) {
+    // 距離で進める。speed_ は従来どおり「1秒間に何セグメント進むか」の感覚で指定できるよう、
+    // 平均セグメント長を掛けてワールド単位の速さにする（全体の所要時間は従来と同じ）
+    float segmentCount = static_cast<float>(waypoints_.size() - 1);
+    float unitsPerSecond = speed_ * railSpline_.GetLength() / segmentCount;
+    distance_ += unitsPerSecond * (1.0f / 60.0f);
+
+    if (distance_ >= railSpline_.GetLength()) {
+      distance_ = railSpline_.GetLength();
+      t_ = segmentCount;
       isFinished_ = true;
+    } else {
+      t_ = railSpline_.DistanceToParam(distance_);
     }
   }
 
@@ -70,9 +119,19 @@ void RailCamera::Update() {
 
   // --- バンク・首振りの計算（プレイヤー連動） ---
   Vector3 tangentNow = CalcTangent(t_);
-  Vector3 worldUp = {0.0f, 1.0f, 0.0f};
-  Vector3 right = SafeNormalize(Cross(worldUp, tangentNow));
-  Vector3 upApprox = SafeNormalize(Cross(tangentNow, right)); // レールの近似上方向
+  Vector3 right;
+  Vector3 upApprox; // レールの近似上方向
+  if (useParallelTransportFrame_ && railSpline_.HasFrames()) {
+    // 事前計算したねじれのない基底を使う（宙返りするようなレールでも反転しない）
+    ArcLengthSpline::Frame frame = railSpline_.GetFrameAtDistance(distance_);
+    tangentNow = frame.forward;
+    right = frame.right;
+    upApprox = frame.up;
+  } else {
+    Vector3 worldUp = {0.0f, 1.0f, 0.0f};
+    right = SafeNormalize(Cross(worldUp, tangentNow));
+    upApprox = SafeNormalize(Cross(tangentNow, right));
+  }
 
   // レールの基準ベクトルと座標を保存しておく（敵などがカメラの首振りやシェイクに影響されずに移動するため）
   railPos_ = currentPos;
@@ -125,31 +184,8 @@ void RailCamera::Update() {
 }
 
 Vector3 RailCamera::CalcPosition(float t) const {
-  if (waypoints_.empty())
-    return {0.0f, 0.0f, 0.0f};
-  if (waypoints_.size() == 1)
-    return waypoints_[0];
-
-  int maxIdx = static_cast<int>(waypoints_.size() - 1);
-  int i = static_cast<int>(t);
-  if (i >= maxIdx) {
-    return waypoints_.back();
-  }
-
-  float localT = t - static_cast<float>(i);
-
-  // 4つの制御点を取得（範囲外にならないようにClampする）
-  int idx0 = std::max(i - 1, 0);
-  int idx1 = i;
-  int idx2 = std::min(i + 1, maxIdx);
-  int idx3 = std::min(i + 2, maxIdx);
-
-  const Vector3 &p0 = waypoints_[idx0];
-  const Vector3 &p1 = waypoints_[idx1];
-  const Vector3 &p2 = waypoints_[idx2];
-  const Vector3 &p3 = waypoints_[idx3];
-
-  return CatmullRom(p0, p1, p2, p3, localT);
+  // エディタから編集直後でも正しい位置を返せるよう、テーブルではなく制御点から直接計算する
+  return ArcLengthSpline::EvaluatePosition(waypoints_, t);
 }
 
 void RailCamera::Shake(float intensity, float duration) {
@@ -160,10 +196,6 @@ void RailCamera::Shake(float intensity, float duration) {
 }
 
 Vector3 RailCamera::CalcTangent(float t) const {
-  float delta = 0.01f;
-  float maxT = static_cast<float>(waypoints_.size() - 1);
-  Vector3 p0 = CalcPosition((std::max)(t - delta, 0.0f));
-  Vector3 p1 = CalcPosition((std::min)(t + delta, maxT));
-  Vector3 tangent = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
-  return SafeNormalize(tangent);
+  // Catmull-Romの微分から解析的に求める
+  return SafeNormalize(ArcLengthSpline::EvaluateDerivative(waypoints_, t));
 }
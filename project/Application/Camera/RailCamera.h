@@ -1,5 +1,6 @@
 #pragma once
 #include "Render/Camera/ICamera.h"
+#include "Math/ArcLengthSpline.h"
 #include "Math/Matrix4x4.h"
 #include "Math/Transform.h"
 #include "Math/Vector3.h"
@@ -40,18 +41,24 @@ public:
   const Vector3& GetRotate() const { return transform_.rotate; }
   bool IsFinished() const { return isFinished_; }
   float GetT() const { return t_; }
-  void SetT(float t) { 
-    t_ = t; 
-    if (waypoints_.size() > 0 && t_ < static_cast<float>(waypoints_.size() - 1)) {
-      isFinished_ = false;
-    }
-  }
+  void SetT(float t);
+
+  // レールに沿って進んだ距離（ワールド単位）
+  float GetDistance() const { return distance_; }
+  float GetRailLength() const { return railSpline_.GetLength(); }
+
+  // 平行移動フレームでバンクの基準軸を作るか（falseならワールドの上方向基準）
+  void SetUseParallelTransportFrame(bool use) { useParallelTransportFrame_ = use; }
   
   // 自動進行フラグ
   void SetAutoMove(bool autoMove) { isAutoMove_ = autoMove; }
   bool GetAutoMove() const { return isAutoMove_; }
   const std::vector<Vector3>& GetWaypoints() const { return waypoints_; }
-  std::vector<Vector3>& GetWaypointsRef() { return waypoints_; }
+
+  // ウェイポイントの編集（エディタ用）。弧長テーブルは次の Update / SetT で作り直す
+  void SetWaypoint(size_t index, const Vector3& position);
+  void AddWaypoint(const Vector3& position);
+  void RemoveWaypoint(size_t index);
 
   /// <summary>
   /// 進行度tから現在の座標を計算する
@@ -84,10 +91,21 @@ private:
   // レール移動用
   std::vector<Vector3> waypoints_; // 通過ポイント
   float t_ = 0.0f; // 現在の進行度
-  float speed_ = 0.5f; // 進行スピード
+  float speed_ = 0.5f; // 進行スピード（平均的なセグメント長を1とした 1秒あたりの移動量）
   bool isFinished_ = false;
   bool isAutoMove_ = true; // 自動で前進するかどうか
 
+  // 弧長テーブル（ウェイポイント間隔に依存せず一定の速さで進むため）
+  ArcLengthSpline railSpline_;
+  float distance_ = 0.0f; // レールに沿って進んだ距離
+  bool useParallelTransportFrame_ = false;
+  bool isRailDirty_ = false; // ウェイポイントが編集されて弧長テーブルが古いか
+
+  /// <summary>
+  /// ウェイポイントが編集されていたら弧長テーブルを作り直す
+  /// </summary>
+  void RebuildRailIfNeeded();
+
   // 画面揺れ用
   float shakeIntensity_ = 0.0f;
   float shakeDuration_ = 0.0f;
@@ -450,6 +450,9 @@ void Game::Draw() {
   renderPipeline_->Begin3DPass(dx12Core_.get());
   SceneManager::GetInstance()->Draw();
 
+  // シーンが End3D を呼ばなくても、描画キューの残りはポストプロセスの前に描く
+  object3dRenderer_->Flush();
+
   // プロジェクション逆行列のセット（PostProcessが必要とするため）
   auto pp = SceneManager::GetInstance()->GetCurrentScenePostProcess();
   if (pp) {
@@ -469,6 +472,7 @@ void Game::Draw() {
 #ifdef USE_IMGUI
   if (g_showUIEditor) {
     UIManager::GetInstance()->Draw();
+    GetSpriteRenderer()->Flush();
   }
 #endif
 
@@ -584,6 +588,17 @@ void Game::DrawWorldSettingsUI() {
     }
   }
 
+  if (ImGui::CollapsingHeader("Rendering")) {
+    FrustumCuller *culler = GetObject3dRenderer()->GetCuller();
+    bool enableCulling = culler->IsEnabled();
+    if (ImGui::Checkbox("Frustum Culling", &enableCulling)) {
+      culler->SetEnabled(enableCulling);
+    }
+    ImGui::Text("Submitted: %u", culler->GetSubmittedCount());
+    ImGui::Text("Visible  : %u", culler->GetVisibleCount());
+    ImGui::Text("Culled   : %u", culler->GetCulledCount());
+  }
+
   ImGui::End();
 #endif
 }
@@ -127,31 +127,29 @@ void EffectManager::Update(const ICamera *camera) {
   if (!activeShockwaves_.empty()) {
     postProcess->SetPostEffectType(10); // 10: Shockwave
 
+    // 波紋の中心をまとめて UV 座標 (0～1) に変換する
+    shockwaveWorldPositions_.resize(activeShockwaves_.size());
+    for (size_t i = 0; i < activeShockwaves_.size(); ++i) {
+      shockwaveWorldPositions_[i] = activeShockwaves_[i].worldPos;
+    }
+    shockwaveUVs_.resize(activeShockwaves_.size());
+    shockwaveDepths_.resize(activeShockwaves_.size());
+    WorldToScreenBatch(shockwaveWorldPositions_, viewProj, {0.0f, 0.0f, 1.0f, 1.0f},
+                       shockwaveUVs_, shockwaveDepths_);
+
     std::vector<PostProcess::ShockwaveParams> shockwaveParams;
-    for (const auto &sw : activeShockwaves_) {
-      Vector3 pos = sw.worldPos;
-      float w = pos.x * viewProj.m[0][3] + pos.y * viewProj.m[1][3] +
-                pos.z * viewProj.m[2][3] + viewProj.m[3][3];
-      if (w <= 0.0f)
-        w = 0.0001f;
-
-      Vector3 ndcPos = {(pos.x * viewProj.m[0][0] + pos.y * viewProj.m[1][0] +
-                         pos.z * viewProj.m[2][0] + viewProj.m[3][0]) /
-                            w,
-                        (pos.x * viewProj.m[0][1] + pos.y * viewProj.m[1][1] +
-                         pos.z * viewProj.m[2][1] + viewProj.m[3][1]) /
-                            w,
-                        (pos.x * viewProj.m[0][2] + pos.y * viewProj.m[1][2] +
-                         pos.z * viewProj.m[2][2] + viewProj.m[3][2]) /
-                            w};
-
-      float uvX = (ndcPos.x + 1.0f) * 0.5f;
-      float uvY = (1.0f - ndcPos.y) * 0.5f;
+    for (size_t i = 0; i < activeShockwaves_.size(); ++i) {
+      const auto &sw = activeShockwaves_[i];
+
+      // カメラの後ろで発生した波紋は画面に出さない
+      if (shockwaveDepths_[i] < 0.0f)
+        continue;
+
       float t = sw.timer / shockwaveConfig_.duration;
 
       PostProcess::ShockwaveParams param;
-      param.center[0] = uvX;
-      param.center[1] = uvY;
+      param.center[0] = shockwaveUVs_[i].x;
+      param.center[1] = shockwaveUVs_[i].y;
       param.radius = (1.0f - t) * shockwaveConfig_.maxRadius;
       param.thickness = shockwaveConfig_.thickness;
       param.weight = t;
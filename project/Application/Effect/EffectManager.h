@@ -1,5 +1,6 @@
 #pragma once
 #include "Math/Matrix4x4.h"
+#include "Math/ScreenProjection.h"
 #include "Math/Vector3.h"
 #include <vector>
 #include <memory>
@@ -81,6 +82,10 @@ private:
   };
   std::vector<ActiveShockwave> activeShockwaves_;
 
+  // 波紋の中心をUV座標に変換するための作業領域
+  std::vector<Vector3> shockwaveWorldPositions_;
+  std::vector<Vector2> shockwaveUVs_;
+  std::vector<float> shockwaveDepths_;
 
   void SaveShockwaveConfig();
   void LoadShockwaveConfig();
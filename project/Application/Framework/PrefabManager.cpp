@@ -132,6 +132,8 @@ std::unique_ptr<Enemy> PrefabManager::InstantiateEnemy(const std::string& prefab
     // モデルを持たせる
     auto dummyModel = std::make_unique<Object3d>();
     dummyModel->Initialize(object3dRenderer_);
+    // 同じモデル・色の敵はまとめて1回で描く（被弾で色が変わったものは別のまとまりになる）
+    dummyModel->SetInstancingEnabled(true);
     dummyModel->SetModel(modelPath);
     dummyModel->SetColor({1.0f, 0.2f, 0.2f, 1.0f});
     newEnemy->SetModel(std::move(dummyModel));
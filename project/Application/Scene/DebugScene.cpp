@@ -30,6 +30,17 @@ void DebugScene::Initialize(EngineBase *engine) {
   // マネージャーを初期化して、テスト用のプレイヤーを1人放り込む
   ActorManager::GetInstance()->Initialize();
 
+  // 使うアセットを先にまとめて非同期で読み始めておく
+  // 下の同期読み込みは、そのアセットの読み込みが終わるのを待つだけになる
+  ModelManager::GetInstance()->LoadModelAsync("terrain.obj");
+  ModelManager::GetInstance()->LoadModelAsync("suzanne.obj");
+  ModelManager::GetInstance()->LoadModelAsync("AnimatedCube.gltf");
+  TextureManager::GetInstance()->LoadTextureAsync("resources/Skybox/Skybox.dds");
+  TextureManager::GetInstance()->LoadTextureAsync("resources/noise0.png");
+  TextureManager::GetInstance()->LoadTextureAsync("resources/noise1.png");
+  SoundManager::GetInstance()->LoadAsync("mokugyo", "resources/mokugyo.wav");
+  SoundManager::GetInstance()->LoadAsync("se", "resources/fanfare.wav");
+
   // PostProcess用テクスチャ
   TextureManager::GetInstance()->LoadTexture("resources/noise0.png");
   TextureManager::GetInstance()->LoadTexture("resources/noise1.png");
@@ -590,10 +601,8 @@ void DebugScene::Update() {
   sneakWalk_->Update(1.0f / 60.0f);
 
   for (size_t i = 0; i < sneakWalk_->GetSkeleton().joints.size(); ++i) {
-    const Joint &joint = sneakWalk_->GetSkeleton().joints[i];
-    Vector3 pos = {joint.skeletonSpaceMatrix.m[3][0],
-                   joint.skeletonSpaceMatrix.m[3][1],
-                   joint.skeletonSpaceMatrix.m[3][2]};
+    const Matrix4x4 &jointMatrix = sneakWalk_->GetSkeleton().skeletonSpaceMatrices[i];
+    Vector3 pos = {jointMatrix.m[3][0], jointMatrix.m[3][1], jointMatrix.m[3][2]};
     jointObjects_[i]->SetTranslation(pos);
     jointObjects_[i]->Update();
   }
@@ -850,17 +859,16 @@ void DebugScene::Draw3D() {
   engine_->GetObject3dRenderer()->SetDepthEnable(false);
 
   // 関節間のLineを登録
-  for (size_t i = 0; i < sneakWalk_->GetSkeleton().joints.size(); ++i) {
-    const Joint &joint = sneakWalk_->GetSkeleton().joints[i];
-    if (joint.parent) {
-      const Joint &parentJoint =
-          sneakWalk_->GetSkeleton().joints[*joint.parent];
-      Vector3 start = {parentJoint.skeletonSpaceMatrix.m[3][0],
-                       parentJoint.skeletonSpaceMatrix.m[3][1],
-                       parentJoint.skeletonSpaceMatrix.m[3][2]};
-      Vector3 end = {joint.skeletonSpaceMatrix.m[3][0],
-                     joint.skeletonSpaceMatrix.m[3][1],
-                     joint.skeletonSpaceMatrix.m[3][2]};
+  const Skeleton &skeleton = sneakWalk_->GetSkeleton();
+  for (size_t i = 0; i < skeleton.joints.size(); ++i) {
+    int32_t parentIndex = skeleton.parentIndices[i];
+    if (parentIndex >= 0) {
+      const Matrix4x4 &parentMatrix = skeleton.skeletonSpaceMatrices[parentIndex];
+      const Matrix4x4 &jointMatrix = skeleton.skeletonSpaceMatrices[i];
+      Vector3 start = {parentMatrix.m[3][0], parentMatrix.m[3][1],
+                       parentMatrix.m[3][2]};
+      Vector3 end = {jointMatrix.m[3][0], jointMatrix.m[3][1],
+                     jointMatrix.m[3][2]};
       engine_->GetLineRenderer()->DrawLine(start, end,
                                            {1.0f, 1.0f, 1.0f, 1.0f}); // 白い線
     }
@@ -872,6 +880,9 @@ void DebugScene::Draw3D() {
   }
   engine_->GetObject3dRenderer()->SetDepthEnable(true); // 元に戻す
 
+  // 登録済みの3Dモデルを描き切る（半透明のパーティクルより先に）
+  engine_->GetObject3dRenderer()->Flush();
+
   testParticleGroup_->Draw();
   clearParticleGroup_->Draw();
   hitParticleGroup_->Draw();
@@ -904,7 +915,6 @@ void DebugScene::Draw2D() {
   // ここから下で2DオブジェクトのDrawを呼ぶ
 
   // まず通常描画で下地となる文字（上半分が見える部分）を描画
-  engine_->GetSpriteRenderer()->Begin();
   sprites_[0]->Draw();
 
   // その上に、波エフェクト専用のシェーダーでもう一度描画（波の形にマスクされる）
@@ -916,11 +926,8 @@ void DebugScene::Draw2D() {
   //  波打ちエフェクト (時間, タイプ, Yの境界線, 揺れ幅, 細かさ, スピード)
   sprites_[0]->SetUIEffectParams(effectTime, 1, 0.2f, 0.05f, 20.0f, 1.0f);
 
-  engine_->GetSpriteRenderer()->BeginUIEffect();
   sprites_[0]->DrawUIEffect();
 
-  // 通常描画に戻す
-  engine_->GetSpriteRenderer()->Begin();
   // for (uint32_t i = 0; i < kSpriteCount_; ++i) {
   //   sprites_[i]->Draw();
   // }
@@ -134,6 +134,14 @@ void GamePlayScene::Initialize(EngineBase *engine) {
   fog.enabled = 1.0f;
   engine_->GetObject3dRenderer()->SetFog(fog);
 
+  // 使うアセットを先にまとめて非同期で読み始めておく
+  // 下の同期読み込みは、そのアセットの読み込みが終わるのを待つだけになる
+  ModelManager::GetInstance()->LoadModelAsync("suzanne.obj");
+  ModelManager::GetInstance()->LoadModelAsync("monsterBall.obj");
+  TextureManager::GetInstance()->LoadTextureAsync("resources/Skybox/Skybox.dds");
+  TextureManager::GetInstance()->LoadTextureAsync("resources/circle.png");
+  SoundManager::GetInstance()->LoadAsync("boss_explosion", "resources/Sounds/explosion.mp3");
+
   //===========================
   // テクスチャファイルの読み込み
   //===========================
@@ -712,7 +720,7 @@ void GamePlayScene::Update() {
   }
   if (isRailCameraOpen) {
     if (railCamera_) {
-      auto &waypoints = railCamera_->GetWaypointsRef();
+      const auto &waypoints = railCamera_->GetWaypoints();
       for (size_t i = 0; i < waypoints.size(); ++i) {
         ImGui::PushID(static_cast<int>(i));
         std::string wpLabel = "Waypoint " + std::to_string(i);
@@ -891,24 +899,27 @@ void GamePlayScene::Update() {
     ImGui::Separator();
 
     if (railCamera_) {
-      auto &waypoints = railCamera_->GetWaypointsRef();
+      const auto &waypoints = railCamera_->GetWaypoints();
       for (size_t i = 0; i < waypoints.size(); ++i) {
         ImGui::PushID(static_cast<int>(i));
         ImGui::Text("Point %zu", i);
         ImGui::SameLine();
         if (ImGui::Button("Delete")) {
-          waypoints.erase(waypoints.begin() + i);
+          railCamera_->RemoveWaypoint(i);
           ImGui::PopID();
           break; // 安全のため1フレームに1つだけ削除
         }
-        ImGui::DragFloat3("##Pos", &waypoints[i].x, 0.1f);
+        Vector3 position = waypoints[i];
+        if (ImGui::DragFloat3("##Pos", &position.x, 0.1f)) {
+          railCamera_->SetWaypoint(i, position);
+        }
         ImGui::PopID();
       }
       if (ImGui::Button("Add Waypoint")) {
         if (!waypoints.empty()) {
-          waypoints.push_back(waypoints.back() + Vector3{0, 0, 10.0f});
+          railCamera_->AddWaypoint(waypoints.back() + Vector3{0, 0, 10.0f});
         } else {
-          waypoints.push_back({0, 0, 0});
+          railCamera_->AddWaypoint({0, 0, 0});
         }
       }
     }
@@ -1048,7 +1059,7 @@ void GamePlayScene::Update() {
       Vector3 camPos = railCamera_->CalcPosition(ev.spawnTime);
       Vector3 nextPos = railCamera_->CalcPosition(std::min(
           ev.spawnTime + 0.01f,
-          static_cast<float>(railCamera_->GetWaypointsRef().size() - 1)));
+          static_cast<float>(railCamera_->GetWaypoints().size() - 1)));
       Vector3 forwardDir = {nextPos.x - camPos.x, nextPos.y - camPos.y,
                             nextPos.z - camPos.z};
       forwardDir = SafeNormalize(forwardDir);
@@ -1454,7 +1465,7 @@ void GamePlayScene::DrawEditorUI() {
   // ======================================
   else if (isWaypointMode) {
     if (railCamera_) {
-      auto &waypoints = railCamera_->GetWaypointsRef();
+      const auto &waypoints = railCamera_->GetWaypoints();
       if (selectedWaypointIndex_ < waypoints.size()) {
         Vector3 wp = waypoints[selectedWaypointIndex_];
         Matrix4x4 worldMatrix = MakeTranslateMatrix(wp);
@@ -1464,8 +1475,9 @@ void GamePlayScene::DrawEditorUI() {
                              &worldMatrix.m[0][0]);
 
         if (ImGuizmo::IsUsing()) {
-          waypoints[selectedWaypointIndex_] = {
-              worldMatrix.m[3][0], worldMatrix.m[3][1], worldMatrix.m[3][2]};
+          railCamera_->SetWaypoint(selectedWaypointIndex_,
+                                   {worldMatrix.m[3][0], worldMatrix.m[3][1],
+                                    worldMatrix.m[3][2]});
         }
       }
     }
@@ -1612,7 +1624,7 @@ void GamePlayScene::Draw3D() {
     if (!ev.splineName.empty()) {
       auto it = loadedSplines_.find(ev.splineName);
       if (it != loadedSplines_.end()) {
-        const auto &points = it->second;
+        const auto &points = it->second->GetControlPoints();
         if (points.size() >= 2) {
           Vector4 orange = {1.0f, 0.5f, 0.0f, 1.0f};
           Vector3 cameraPos = {0, 0, 0};
@@ -1668,6 +1680,9 @@ void GamePlayScene::Draw3D() {
   engine_->GetLineRenderer()->Render(activeCamera->GetViewProjectionMatrix());
 #endif
 
+  // 登録済みの3Dモデルを描き切る（半透明のパーティクルより先に）
+  engine_->GetObject3dRenderer()->Flush();
+
   // パーティクルの更新と発生（ルートシグネチャが変わるため、3Dモデル描画後に）
   ParticleManager::GetInstance()->Update();
   if (activeCamera) {
@@ -1987,7 +2002,10 @@ void GamePlayScene::LoadSplines() {
                            static_cast<float>(p[1].get<double>()),
                            static_cast<float>(p[2].get<double>())});
           }
-          loadedSplines_[name] = pts;
+          auto spline = std::make_shared<ArcLengthSpline>();
+          spline->Build(pts);
+          spline->BakeDistanceSamples(kSplineSampleSpacing);
+          loadedSplines_[name] = spline;
         }
         Logger::Log("Successfully loaded " +
                     std::to_string(loadedSplines_.size()) +
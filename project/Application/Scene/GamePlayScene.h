@@ -1,8 +1,10 @@
 #pragma once
 #include "Audio/SoundManager.h"
 #include "Core/EngineBase.h"
+#include "Math/ArcLengthSpline.h"
 #include "Math/MathUtil.h"
 #include "Scene/BaseScene.h"
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -76,7 +78,9 @@ private: // メンバ変数(ゲーム用)
   std::vector<Enemy *> enemyPtrs_;
 
   // ロード済みスプラインデータ (Blender JSON等から)
-  std::unordered_map<std::string, std::vector<Vector3>> loadedSplines_;
+  // 弧長テーブルはロード時に1回だけ作り、同じスプラインを使う敵全員で共有する
+  std::unordered_map<std::string, std::shared_ptr<const ArcLengthSpline>> loadedSplines_;
+  static constexpr float kSplineSampleSpacing = 0.25f; // 位置・向きを焼き込む間隔
   void LoadSplines(); // splines.jsonを読み込んでloadedSplines_に格納
 
   // スポーンイベント
@@ -0,0 +1,31 @@
+#include "Object3d.hlsli"
+
+struct TransformationMatrix {
+	float4x4 WVP;
+	float4x4 World;
+	float4x4 WorldInverseTranspose;
+};
+
+// インスタンスごとの行列（InstanceBatcher::InstanceData）
+// ルート SRV の先頭をグループの先頭にずらしてあるので、SV_InstanceID でそのまま引ける
+StructuredBuffer<TransformationMatrix> gInstances : register(t0, space1);
+
+
+struct VertexShaderInput {
+	float4 position : POSITION0;
+	float2 texcoord : TEXCOORD0;
+	float3 normal : NORMAL0;
+};
+
+
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID) {
+	TransformationMatrix transformation = gInstances[instanceId];
+
+	VertexShaderOutput output;
+	output.position = mul(input.position, transformation.WVP);
+	output.texcoord = input.texcoord;
+	output.normal = normalize(mul(input.normal, (float3x3) transformation.WorldInverseTranspose));
+	output.worldPosition = mul(input.position, transformation.World).xyz;
+	
+	return output;
+}
@@ -9,21 +9,21 @@ struct Vertex {
 	float3 normal;
 };
 
-struct VertexInfluence {
-	float4 weight;
-	int4 index;
-};
-
 struct SkinningInformation {
 	uint numVertices;
+	uint influenceCount; // 4 か 8
+	uint weightBits;     // 8 (UNORM8) か 16 (UNORM16)
+	uint indexBits;      // 8 か 16
+	uint weightWords;    // 1頂点の重みが使う uint の数（Joint 番号はその後ろ）
+	uint strideInWords;  // 1頂点分の uint の数
 };
 
 // SkinningObject3d.VS.hlslで作ったものと同じPalette
 StructuredBuffer<Well> gMatrixPalette : register(t0);
 // VertexBufferViewのstream0として利用していた入力頂点
 StructuredBuffer<Vertex> gInputVertices : register(t1);
-// VertexBufferViewのstream1として利用していた入力インフルエンス
-StructuredBuffer<VertexInfluence> gInfluences : register(t2);
+// 入力インフルエンス。1頂点 strideInWords 個の uint に、重み（大きい順）と Joint 番号を下位ビットから詰めたもの
+StructuredBuffer<uint> gInfluences : register(t2);
 
 // Skinning計算後の頂点データ。SkinnedVertex
 RWStructuredBuffer<Vertex> gOutputVertices : register(u0);
@@ -31,30 +31,41 @@ RWStructuredBuffer<Vertex> gOutputVertices : register(u0);
 // Skinningに関するちょっとした情報
 ConstantBuffer<SkinningInformation> gSkinningInformation : register(b0);
 
+// base から始まる1頂点分の中の、bits ビットずつ詰めた element 番目の値を取り出す
+uint ReadPacked(uint base, uint element, uint bits) {
+	uint perWord = 32 / bits;
+	uint word = gInfluences[base + element / perWord];
+	return (word >> ((element % perWord) * bits)) & ((1u << bits) - 1u);
+}
+
 [numthreads(1024, 1, 1)]
 void main(uint3 DTid : SV_DispatchThreadID) {
 	uint vertexIndex = DTid.x;
 	if (vertexIndex < gSkinningInformation.numVertices) {
 		// 必要なデータをStructuredBufferから取ってくる
 		Vertex input = gInputVertices[vertexIndex];
-		VertexInfluence influence = gInfluences[vertexIndex];
+		uint base = vertexIndex * gSkinningInformation.strideInWords;
+		float weightScale = 1.0f / float((1u << gSkinningInformation.weightBits) - 1u);
 
 		// skinning後の頂点を計算
 		Vertex skinned;
 		skinned.texcoord = input.texcoord;
+		skinned.position = float4(0.0f, 0.0f, 0.0f, 0.0f);
+		skinned.normal = float3(0.0f, 0.0f, 0.0f);
 
-		// 位置の変換
-		skinned.position  = mul(input.position, gMatrixPalette[influence.index.x].skeletonSpaceMatrix) * influence.weight.x;
-		skinned.position += mul(input.position, gMatrixPalette[influence.index.y].skeletonSpaceMatrix) * influence.weight.y;
-		skinned.position += mul(input.position, gMatrixPalette[influence.index.z].skeletonSpaceMatrix) * influence.weight.z;
-		skinned.position += mul(input.position, gMatrixPalette[influence.index.w].skeletonSpaceMatrix) * influence.weight.w;
-		skinned.position.w = 1.0f; // 確実に1を入れる
+		for (uint k = 0; k < gSkinningInformation.influenceCount; ++k) {
+			float weight = float(ReadPacked(base, k, gSkinningInformation.weightBits)) * weightScale;
+			if (weight == 0.0f) {
+				break; // 大きい順に並んでいるので、0 が出たら残りも 0
+			}
+			Well well = gMatrixPalette[ReadPacked(base + gSkinningInformation.weightWords, k, gSkinningInformation.indexBits)];
 
-		// 法線の変換
-		skinned.normal  = mul(input.normal, (float3x3)gMatrixPalette[influence.index.x].skeletonSpaceInverseTransposeMatrix) * influence.weight.x;
-		skinned.normal += mul(input.normal, (float3x3)gMatrixPalette[influence.index.y].skeletonSpaceInverseTransposeMatrix) * influence.weight.y;
-		skinned.normal += mul(input.normal, (float3x3)gMatrixPalette[influence.index.z].skeletonSpaceInverseTransposeMatrix) * influence.weight.z;
-		skinned.normal += mul(input.normal, (float3x3)gMatrixPalette[influence.index.w].skeletonSpaceInverseTransposeMatrix) * influence.weight.w;
+			// 位置の変換
+			skinned.position += mul(input.position, well.skeletonSpaceMatrix) * weight;
+			// 法線の変換
+			skinned.normal += mul(input.normal, (float3x3)well.skeletonSpaceInverseTransposeMatrix) * weight;
+		}
+		skinned.position.w = 1.0f; // 確実に1を入れる
 		skinned.normal = normalize(skinned.normal); // 正規化して戻してあげる
 
 		// Skinning後の頂点データを格納、つまり書き込む。
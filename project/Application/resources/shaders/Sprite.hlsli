@@ -1,4 +0,0 @@
-struct VertexShaderOutput {
-	float4 position : SV_POSITION;
-	float2 texcoord : TEXCOORD0;
-};
\ No newline at end of file
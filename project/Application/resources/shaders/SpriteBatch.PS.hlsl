@@ -0,0 +1,29 @@
+#include "SpriteBatch.hlsli"
+
+Texture2D<float4> gTexture : register(t0);
+SamplerState gSampler : register(s0);
+
+struct PixelShaderOutput {
+	float4 color : SV_TARGET0;
+};
+
+PixelShaderOutput main(VertexShaderOutput input) {
+	
+	//=========================
+	// Sampling (uvTransform は頂点のUVに適用済み)
+	//=========================
+	float4 textureColor = gTexture.Sample(gSampler, input.texcoord);
+	
+	//アルファテスト
+	if (textureColor.a <= 0.5) {
+		discard;
+	}
+	
+	//=========================
+	// Output
+	//=========================
+	PixelShaderOutput output;
+	output.color = input.color * textureColor;
+	
+	return output;
+}
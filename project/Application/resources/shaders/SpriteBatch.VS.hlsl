@@ -0,0 +1,21 @@
+#include "SpriteBatch.hlsli"
+
+// 座標はCPUでWVPを掛けてあり、色・UV・エフェクトのパラメータも頂点に入っている（SpriteBatch::Vertex）
+struct VertexShaderInput {
+	float4 position : POSITION0;
+	float2 texcoord : TEXCOORD0;
+	float4 color : COLOR0;
+	float4 effectParams0 : TEXCOORD1;
+	float4 effectParams1 : TEXCOORD2;
+};
+
+VertexShaderOutput main(VertexShaderInput input) {
+	VertexShaderOutput output;
+	output.position = input.position;
+	output.texcoord = input.texcoord;
+	output.color = input.color;
+	output.effectParams0 = input.effectParams0;
+	output.effectParams1 = input.effectParams1;
+	
+	return output;
+}
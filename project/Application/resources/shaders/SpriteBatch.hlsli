@@ -0,0 +1,8 @@
+
+struct VertexShaderOutput {
+	float4 position : SV_POSITION;
+	float2 texcoord : TEXCOORD0;
+	float4 color : COLOR0;
+	float4 effectParams0 : TEXCOORD1; // UIEffect: time, effectType, splitY, amplitude
+	float4 effectParams1 : TEXCOORD2; // UIEffect: frequency, speed, blurWidth, boundaryAmp
+};
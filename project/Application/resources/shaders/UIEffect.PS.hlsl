@@ -1,15 +1,9 @@
-#include "Sprite.hlsli"
+#include "SpriteBatch.hlsli"
 
 Texture2D<float4> gTexture : register(t0);
 SamplerState gSampler : register(s0);
 
-struct Material {
-	float4 color;
-	float4x4 uvTransform;
-};
-ConstantBuffer<Material> gMaterial : register(b0);
-
-// 新しく追加するUIエフェクト用の定数バッファ
+// UIエフェクトのパラメータ（SpriteBatch で頂点に入れて渡す）
 struct UIEffectParams {
 	float time; // 経過時間
 	int effectType; // 0: Normal, 1: Wave (波打ち)
@@ -20,27 +14,39 @@ struct UIEffectParams {
 	float blurWidth; // (padding1) 横方向のブラー幅
 	float boundaryAmp; // (padding2) 境界線の波打ち幅
 };
-ConstantBuffer<UIEffectParams> gUIEffect : register(b1);
+
+UIEffectParams LoadUIEffectParams(VertexShaderOutput input) {
+	UIEffectParams params;
+	params.time = input.effectParams0.x;
+	params.effectType = (int) round(input.effectParams0.y);
+	params.splitY = input.effectParams0.z;
+	params.amplitude = input.effectParams0.w;
+	params.frequency = input.effectParams1.x;
+	params.speed = input.effectParams1.y;
+	params.blurWidth = input.effectParams1.z;
+	params.boundaryAmp = input.effectParams1.w;
+	return params;
+}
 
 struct PixelShaderOutput {
 	float4 color : SV_TARGET0;
 };
 
 PixelShaderOutput main(VertexShaderOutput input) {
-    //  UV座標の取得
-	float4 transformedUV = mul(float4(input.texcoord, 0.0f, 1.0f), gMaterial.uvTransform);
-	float2 uv = transformedUV.xy;
+    //  UV座標の取得（uvTransform は頂点のUVに適用済み）
+	float2 uv = input.texcoord;
+	UIEffectParams effect = LoadUIEffectParams(input);
 
-	if (gUIEffect.effectType == 1) {
+	if (effect.effectType == 1) {
 		// --- UI波打ちエフェクト ---
-		float blurW = (gUIEffect.blurWidth > 0.0f) ? gUIEffect.blurWidth : 0.04f;
-		float bAmp = (gUIEffect.boundaryAmp > 0.0f) ? gUIEffect.boundaryAmp : 0.04f;
-		float t = gUIEffect.time;
+		float blurW = (effect.blurWidth > 0.0f) ? effect.blurWidth : 0.04f;
+		float bAmp = (effect.boundaryAmp > 0.0f) ? effect.boundaryAmp : 0.04f;
+		float t = effect.time;
         
 		// 波の上端Y座標を計算
-		float w1_top = gUIEffect.splitY + 0.02f + sin(uv.x * 2.0f + t * 2.5f) * bAmp * 1.8f;
-		float w2_top = gUIEffect.splitY - 0.03f + sin(uv.x * 1.5f - t * 1.8f) * bAmp * 2.0f;
-		float base_top = gUIEffect.splitY + sin(uv.x * 1.0f + t * 2.0f) * bAmp * 1.5f;
+		float w1_top = effect.splitY + 0.02f + sin(uv.x * 2.0f + t * 2.5f) * bAmp * 1.8f;
+		float w2_top = effect.splitY - 0.03f + sin(uv.x * 1.5f - t * 1.8f) * bAmp * 2.0f;
+		float base_top = effect.splitY + sin(uv.x * 1.0f + t * 2.0f) * bAmp * 1.5f;
 
 		// シルエットの境界（最も高い波を採用）
 		float silhouette_top = min(min(w1_top, w2_top), base_top);
@@ -71,7 +77,7 @@ PixelShaderOutput main(VertexShaderOutput input) {
 		if (inW2) { shiftX += cos(uv.x * 1.5f - t * 1.8f) * 3.0f; }
 		if (inW1) { shiftX += cos(uv.x * 2.0f + t * 2.5f) * 3.0f; }
         
-		shiftX = shiftX * gUIEffect.amplitude * 0.15f;
+		shiftX = shiftX * effect.amplitude * 0.15f;
 
 		// --- Pixel Rendering ---
 		// Apply horizontal motion blur
@@ -91,7 +97,7 @@ PixelShaderOutput main(VertexShaderOutput input) {
 		// 合成処理
 		if (blurredColor.a > 0.05f) {
 			// テクスチャ範囲内（スクリーン合成）
-			float3 baseText = saturate((gMaterial.color * blurredColor).rgb);
+			float3 baseText = saturate((input.color * blurredColor).rgb);
 			float3 waveColorScreen = saturate(waveTintColor.rgb);
 			finalColor.rgb = 1.0f - (1.0f - baseText) * (1.0f - waveColorScreen);
 			finalColor.a = blurredColor.a;
@@ -115,6 +121,6 @@ PixelShaderOutput main(VertexShaderOutput input) {
 	}
 	
 	PixelShaderOutput output;
-	output.color = gMaterial.color * textureColor;
+	output.color = input.color * textureColor;
 	return output;
 }
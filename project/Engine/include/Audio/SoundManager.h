@@ -1,4 +1,5 @@
 #pragma once
+#include "Util/AsyncLoader.h"
 #include <cassert>
 #include <cstring>
 #include <fstream>
@@ -53,6 +54,11 @@ public:
   void Update();
 
   void Load(const std::string &key, const std::string &filename);
+
+  /// <summary>
+  /// 非同期で読み込む（デコードはワーカースレッド）。読み込み中の再生は無音でスキップされる
+  /// </summary>
+  LoadHandle LoadAsync(const std::string &key, const std::string &filename);
   void Unload(const std::string &key);
 
   void PlaySE(const std::string &key);
@@ -105,6 +111,14 @@ private:
 
   std::unordered_map<std::string, SoundData> sounds_;
 
+  // 非同期で読み込み中の音声
+  std::unordered_map<std::string, LoadHandle> pendingSounds_;
+
+  /// <summary>
+  /// 読み込み中なら true（再生をスキップする）
+  /// </summary>
+  bool SkipIfLoading(const std::string &key);
+
   // BGM（1本だけ）
   IXAudio2SourceVoice *bgmVoice_ = nullptr;
   std::string bgmKey_;
@@ -1,4 +1,5 @@
 #pragma once
+#include "Core/LinearUploadAllocator.h"
 #include "Core/WindowSystem.h"
 #include "Math/Vector4.h"
 #include "DirectXTex.h"
@@ -10,6 +11,7 @@
 #include <string>
 #include <wrl.h>
 #include <unordered_map>
+#include <vector>
 
 Microsoft::WRL::ComPtr<ID3D12Resource>
 CreateRenderTextureResource(Microsoft::WRL::ComPtr<ID3D12Device> device, uint32_t width, uint32_t height, DXGI_FORMAT format, const Vector4& clearColor);
@@ -255,6 +257,11 @@ public:
     return depthStencilResource.Get();
   }
 
+  /// <summary>
+  /// 描画先のビューポート（スクリーン座標変換に使う）
+  /// </summary>
+  const D3D12_VIEWPORT &GetViewport() const { return viewport; }
+
   /// <summary>
   /// バックバッファのRTVハンドルを取得
   /// </summary>
@@ -287,6 +294,11 @@ public:
   Microsoft::WRL::ComPtr<ID3D12Resource>
   CreateBufferResource(size_t sizeInBytes);
 
+  /// <summary>
+  /// フレームごとの定数データ用のアロケータ（このフレームの GPU 処理が終わるまで有効な領域を切り出す）
+  /// </summary>
+  LinearUploadAllocator &GetFrameUploadAllocator() { return frameUploadAllocator_; }
+
   /// <summary>
   /// UAV用のリソースを生成 (DEFAULTヒープ)
   /// </summary>
@@ -348,6 +360,15 @@ private:
   // 全てのリソースの現在の状態を監視する名簿
   std::unordered_map<ID3D12Resource*, D3D12_RESOURCE_STATES> resourceStates_;
 
+  // フレームごとの定数データ用のアロケータと、そのページ（Map したまま持っておく）
+  LinearUploadAllocator frameUploadAllocator_;
+  std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> frameUploadPages_;
+
+  /// <summary>
+  /// フレームごとの定数データ用のアロケータの初期化
+  /// </summary>
+  void InitializeFrameUploadAllocator();
+
 public:
   // 最大SRV数(最大テクスチャ枚数)
   // static const uint32_t kMaxSRVCount;
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// フレームごとの定数データ用の線形アロケータ
+/// 大きなアップロードページ（Map したまま）の先頭から順に切り出し、フレームの終わりにフェンス値を付けて手放す
+/// GPU がそのフェンス値まで進んだら（Reclaim）ページを使い回す。個別の解放はない
+/// ページの作成は呼び出し側に任せるので、D3D12 に触れずにテストできる
+/// </summary>
+class LinearUploadAllocator {
+public:
+  // 定数バッファビューのアドレスの境界（D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT）
+  static constexpr size_t kConstantBufferAlignment = 256;
+  static constexpr size_t kDefaultPageSize = 2 * 1024 * 1024;
+
+  // 呼び出し側が作るページ（CPU から書けて、GPU アドレスを持つ連続した領域）
+  struct Page {
+    uint8_t *cpu = nullptr;
+    uint64_t gpuAddress = 0;
+    size_t size = 0;
+  };
+
+  struct Allocation {
+    void *cpu = nullptr;
+    uint64_t gpuAddress = 0;
+    size_t size = 0;
+    explicit operator bool() const { return cpu != nullptr; }
+  };
+
+  struct Stats {
+    uint32_t pageCount = 0;       // 作ったページの数
+    uint32_t freePageCount = 0;   // 空いているページの数
+    uint32_t retiredPageCount = 0; // GPU の完了待ちのページの数
+    uint32_t allocationCount = 0; // このフレームの Allocate の回数
+    size_t frameBytes = 0;        // このフレームで切り出した量（境界合わせの隙間を含む）
+  };
+
+  /// <summary>
+  /// ページを作る。size 以上の領域を page に入れて true を返す
+  /// </summary>
+  using CreatePage = std::function<bool(size_t size, Page &page)>;
+
+  /// <summary>
+  /// 初期化
+  /// </summary>
+  /// <param name="pageSize">ページの大きさ（これより大きな要求にはその大きさのページを作る）</param>
+  void Initialize(size_t pageSize, CreatePage createPage);
+
+  /// <summary>
+  /// このフレームの領域を切り出す。ページが作れなければ空の Allocation を返す
+  /// </summary>
+  /// <param name="alignment">2 のべき乗</param>
+  Allocation Allocate(size_t size, size_t alignment = kConstantBufferAlignment);
+
+  /// <summary>
+  /// data をコピーした領域を切り出す（定数バッファ1つ分）
+  /// </summary>
+  template <typename T> Allocation Upload(const T &data) {
+    Allocation allocation = Allocate(sizeof(T));
+    if (allocation) {
+      std::memcpy(allocation.cpu, &data, sizeof(T));
+    }
+    return allocation;
+  }
+
+  /// <summary>
+  /// このフレームの GPU 処理の後に Signal するフェンス値を付けて、使ったページを完了待ちにする
+  /// 以降の Allocate は次のフレームの領域になる
+  /// </summary>
+  void EndFrame(uint64_t fenceValue);
+
+  /// <summary>
+  /// completedFenceValue まで完了したページを空きに戻す
+  /// </summary>
+  void Reclaim(uint64_t completedFenceValue);
+
+  const Stats &GetStats() const { return stats_; }
+  size_t GetPageSize() const { return pageSize_; }
+
+private:
+  struct Retired {
+    uint64_t fenceValue = 0;
+    uint32_t page = 0;
+  };
+
+  // size 以上の空きページを取る（なければ作る）。取れなければ false
+  bool AcquirePage(size_t size);
+
+  size_t pageSize_ = kDefaultPageSize;
+  CreatePage createPage_;
+
+  std::vector<Page> pages_;          // 作ったページすべて
+  std::vector<uint32_t> freePages_;  // pages_ の番号
+  std::deque<Retired> retiredPages_; // フェンス値の順
+  std::vector<uint32_t> framePages_; // このフレームで使ったページ（最後が書き込み中）
+  size_t offset_ = 0;                // 書き込み中のページの使った量
+
+  Stats stats_;
+};
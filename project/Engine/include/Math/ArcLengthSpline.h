@@ -0,0 +1,114 @@
+#pragma once
+#include "Vector3.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 弧長でパラメータ化した Catmull-Rom スプライン
+/// 制御点から「進んだ距離 → パラメータt」の対応表を作っておき、二分探索で引く。
+/// パラメータ t はセグメント単位（0 ～ 制御点数-1）で、端の制御点はクランプする
+/// </summary>
+class ArcLengthSpline {
+public:
+  /// <summary>
+  /// 移動方向に沿った正規直交基底
+  /// </summary>
+  struct Frame {
+    Vector3 forward; // 接線
+    Vector3 right;   // 右
+    Vector3 up;      // 上
+  };
+
+  /// <summary>
+  /// 距離での位置と進行方向
+  /// </summary>
+  struct Sample {
+    Vector3 position; // 位置
+    Vector3 tangent;  // 進行方向（正規化済み）
+  };
+
+  /// <summary>
+  /// 対応表を作る
+  /// </summary>
+  /// <param name="controlPoints">制御点</param>
+  /// <param name="samplesPerSegment">1セグメントあたりの分割数</param>
+  /// <param name="bakeFrames">平行移動フレームも作るか</param>
+  void Build(const std::vector<Vector3> &controlPoints, uint32_t samplesPerSegment = 16,
+             bool bakeFrames = false);
+
+  bool IsValid() const { return controlPoints_.size() >= 2; }
+  bool HasFrames() const { return !frameUps_.empty(); }
+  float GetLength() const { return cumulativeLengths_.empty() ? 0.0f : cumulativeLengths_.back(); }
+  float GetMaxParam() const;
+  const std::vector<Vector3> &GetControlPoints() const { return controlPoints_; }
+
+  /// <summary>
+  /// 距離 → パラメータ（O(log n)）
+  /// </summary>
+  float DistanceToParam(float distance) const;
+
+  /// <summary>
+  /// パラメータ → 距離（O(1)）
+  /// </summary>
+  float ParamToDistance(float t) const;
+
+  Vector3 GetPosition(float t) const { return EvaluatePosition(controlPoints_, t); }
+  Vector3 GetTangent(float t) const;
+  Vector3 GetPositionAtDistance(float distance) const { return GetPosition(DistanceToParam(distance)); }
+  Vector3 GetTangentAtDistance(float distance) const { return GetTangent(DistanceToParam(distance)); }
+
+  /// <summary>
+  /// 等距離間隔で距離 → パラメータの対応を焼き込む（大量の敵で共有して使う場合向け）
+  /// </summary>
+  /// <param name="spacing">サンプル間隔（ワールド単位）</param>
+  void BakeDistanceSamples(float spacing);
+
+  /// <summary>
+  /// 距離での位置と進行方向をまとめて取得
+  /// BakeDistanceSamples 済みならパラメータを隣接サンプルの補間で引き（O(1)）、そうでなければ探索する
+  /// 位置と進行方向はどちらもそのパラメータで曲線から直接求める（急なカーブでも接線がずれない）
+  /// </summary>
+  Sample SampleAtDistance(float distance) const;
+
+  /// <summary>
+  /// 距離での基底を取得（Build で bakeFrames を指定した場合のみ有効）
+  /// </summary>
+  Frame GetFrameAtDistance(float distance) const;
+
+  /// <summary>
+  /// 制御点列上の座標を計算する（端はクランプ）
+  /// </summary>
+  static Vector3 EvaluatePosition(const std::vector<Vector3> &controlPoints, float t);
+
+  /// <summary>
+  /// 制御点列上の微分（正規化していない接線）を計算する
+  /// </summary>
+  static Vector3 EvaluateDerivative(const std::vector<Vector3> &controlPoints, float t);
+
+private:
+  std::vector<Vector3> controlPoints_;
+  uint32_t samplesPerSegment_ = 16;
+
+  // サンプル i のパラメータは i / samplesPerSegment_
+  std::vector<float> cumulativeLengths_;
+
+  // 平行移動フレーム（サンプルごとの上方向）
+  std::vector<Vector3> frameUps_;
+
+  // 等距離サンプルごとのパラメータ
+  std::vector<float> distanceParams_;
+
+  // セグメントごとの3次式 a t^3 + b t^2 + c t + d の係数（SampleAtDistance で位置と接線を直接求める）
+  struct Cubic {
+    Vector3 a, b, c, d;
+  };
+  std::vector<Cubic> segmentCubics_;
+  float distanceSampleSpacing_ = 0.0f;
+
+  void BakeFrames();
+
+  /// <summary>
+  /// パラメータ区間 [t0, t1] の曲線の長さ（ガウス・ルジャンドル積分）
+  /// </summary>
+  float IntegrateLength(float t0, float t1) const;
+};
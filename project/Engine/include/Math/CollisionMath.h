@@ -16,4 +16,10 @@ bool IsCollision(const AABB &aabb, const Sphere &s);
 // 線分と球の当たり判定
 bool IsCollision(const Segment &segment, const Sphere &sphere);
 
+// 視錐台と球の当たり判定（一部でも内側にあれば true）
+bool IsCollision(const Frustum &frustum, const Sphere &sphere);
+
+// 視錐台とAABBの当たり判定（一部でも内側にあれば true）
+bool IsCollision(const Frustum &frustum, const AABB &aabb);
+
 } // namespace CollisionMath
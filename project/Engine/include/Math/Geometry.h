@@ -31,3 +31,15 @@ struct Ray {
   Vector3 origin; // 始点
   Vector3 diff;   // 方向ベクトル
 };
+
+// 平面 (Plane)  dot(normal, p) + distance >= 0 が表側
+struct Plane {
+  Vector3 normal; // 法線（正規化済み）
+  float distance; // 原点からの符号付き距離
+};
+
+// 視錐台 (Frustum)  各平面の法線は内側を向く
+struct Frustum {
+  // 左, 右, 下, 上, 近, 遠 の順
+  Plane planes[6];
+};
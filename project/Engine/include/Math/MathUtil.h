@@ -62,6 +62,17 @@ inline Vector3 CatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p
   return result;
 }
 
+// Catmull-Rom曲線のtでの微分（接線方向・速さ）を計算する
+inline Vector3 CatmullRomDerivative(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) {
+  float t2 = t * t;
+
+  Vector3 result;
+  result.x = 0.5f * ((-p0.x + p2.x) + 2.0f * (2.0f * p0.x - 5.0f * p1.x + 4.0f * p2.x - p3.x) * t + 3.0f * (-p0.x + 3.0f * p1.x - 3.0f * p2.x + p3.x) * t2);
+  result.y = 0.5f * ((-p0.y + p2.y) + 2.0f * (2.0f * p0.y - 5.0f * p1.y + 4.0f * p2.y - p3.y) * t + 3.0f * (-p0.y + 3.0f * p1.y - 3.0f * p2.y + p3.y) * t2);
+  result.z = 0.5f * ((-p0.z + p2.z) + 2.0f * (2.0f * p0.z - 5.0f * p1.z + 4.0f * p2.z - p3.z) * t + 3.0f * (-p0.z + 3.0f * p1.z - 3.0f * p2.z + p3.z) * t2);
+  return result;
+}
+
 Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
 
 //=========================
@@ -69,6 +80,7 @@ Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
 //=========================
 struct Ray;
 struct Sphere;
+struct AABB;
 // レイと球の交差判定。ヒットした場合は true を返し、outDistance にレイの始点から交点までの距離を格納する（任意）
 bool IsCollision(const Ray& ray, const Sphere& sphere, float* outDistance = nullptr);
 
@@ -181,9 +193,26 @@ Matrix4x4 Inverse(Matrix4x4 matrix);
 // 法線の変換（回転・スケールのみ適用／平行移動は無視）
 Vector3 TransformNormal(const Vector3 &v, const Matrix4x4 &m);
 
+// 行ベクトルに行列を掛ける（シェーダーの mul(v, m) と同じ。w で割らない）
+Vector4 Multiply(const Vector4 &v, const Matrix4x4 &m);
+
 // ワールド座標からスクリーン座標への変換（ロックオンなどに使用）
 Vector2 WorldToScreen(const Vector3& worldPos, const Matrix4x4& viewProjMatrix, float screenWidth, float screenHeight);
 
+struct Frustum;
+/// <summary>
+/// ビュープロジェクション行列から視錐台の6平面を取り出す
+/// </summary>
+/// <param name="viewProjection">ビュープロジェクション行列</param>
+/// <returns>法線が内側を向いた正規化済みの視錐台</returns>
+Frustum MakeFrustum(const Matrix4x4& viewProjection);
+
+// 境界球をアフィン行列で変換（半径は最も大きい軸の拡縮に合わせる）
+Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& matrix);
+
+// AABBをアフィン行列で変換し、変換後の箱を包むAABBを返す（8頂点を変換せず、軸ごとの寄与の最小・最大を足す）
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& matrix);
+
 Matrix4x4 Transpose(Matrix4x4 matrix);
 
 static float DegToRad(float deg) { return deg * 3.14159265f / 180.0f; }
@@ -0,0 +1,30 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <span>
+
+/// <summary>
+/// スクリーン座標の変換先となる描画領域（ピクセル単位）
+/// </summary>
+struct Viewport {
+  float left;   // 左上X
+  float top;    // 左上Y
+  float width;  // 幅
+  float height; // 高さ
+};
+
+/// <summary>
+/// ワールド座標をまとめてスクリーン座標に変換する（SSEで4点ずつ処理）
+/// カメラの後ろにある点は WorldToScreen と同じく {-10000, -10000} になる
+/// </summary>
+/// <param name="worldPositions">ワールド座標</param>
+/// <param name="viewProjection">ビュープロジェクション行列</param>
+/// <param name="viewport">描画領域</param>
+/// <param name="outScreen">スクリーン座標（worldPositions と同じ個数）</param>
+/// <param name="outDepth">NDCの深度 0～1（不要なら空）</param>
+/// <param name="outOnScreen">視錐台の内側なら 1（不要なら空）</param>
+void WorldToScreenBatch(std::span<const Vector3> worldPositions, const Matrix4x4 &viewProjection,
+                        const Viewport &viewport, std::span<Vector2> outScreen,
+                        std::span<float> outDepth = {}, std::span<uint8_t> outOnScreen = {});
@@ -0,0 +1,77 @@
+#pragma once
+#include "Math/Geometry.h"
+#include "Math/Matrix4x4.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 視錐台カリング
+/// 毎フレーム Update 側でワールド空間の境界球を登録し、描画前に Cull() でまとめて判定する。
+/// 判定は SoA 配列に対して SIMD で4個ずつ行う
+/// </summary>
+class FrustumCuller {
+public:
+  /// <summary>
+  /// フレーム開始。前フレームの登録内容を破棄する
+  /// </summary>
+  void BeginFrame();
+
+  /// <summary>
+  /// 境界球を登録する
+  /// </summary>
+  /// <param name="worldSphere">ワールド空間の境界球</param>
+  /// <returns>登録番号（IsVisible に渡す）</returns>
+  uint32_t Submit(const Sphere &worldSphere);
+
+  /// <summary>
+  /// 登録済みの境界球をまとめて判定する
+  /// </summary>
+  /// <param name="viewProjection">カメラのビュープロジェクション行列</param>
+  void Cull(const Matrix4x4 &viewProjection);
+
+  /// <summary>
+  /// 描画してよいか
+  /// 別フレームの登録番号や Cull() 後に登録されたものは、判定できないので描画する側に倒す
+  /// </summary>
+  bool IsVisible(uint32_t index, uint32_t frame) const;
+
+  uint32_t GetFrame() const { return frame_; }
+  const Frustum &GetFrustum() const { return frustum_; }
+
+  void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+  bool IsEnabled() const { return isEnabled_; }
+
+  // 統計
+  uint32_t GetSubmittedCount() const { return submittedCount_; }
+  uint32_t GetVisibleCount() const { return visibleCount_; }
+  uint32_t GetCulledCount() const { return culledCount_; }
+
+  /// <summary>
+  /// SoA 配列の球をまとめて判定する（SSE が使えない環境ではスカラーで判定）
+  /// </summary>
+  /// <param name="outVisible">判定結果（見えていれば 1）</param>
+  static void CullSpheres(const Frustum &frustum, const float *centerX, const float *centerY,
+                          const float *centerZ, const float *radius, uint32_t count,
+                          uint8_t *outVisible);
+
+private:
+  // 境界球 (SoA)
+  std::vector<float> centerX_;
+  std::vector<float> centerY_;
+  std::vector<float> centerZ_;
+  std::vector<float> radius_;
+
+  // 判定結果
+  std::vector<uint8_t> visible_;
+
+  Frustum frustum_{};
+
+  uint32_t frame_ = 0;
+  uint32_t culledSize_ = 0; // 直近の Cull() で判定した個数
+
+  bool isEnabled_ = true;
+
+  uint32_t submittedCount_ = 0;
+  uint32_t visibleCount_ = 0;
+  uint32_t culledCount_ = 0;
+};
@@ -0,0 +1,182 @@
+#pragma once
+#include "Math/Transform.h"
+#include "Render/Model/Skeleton.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Joint ごとの姿勢を成分ごとの配列で持つ（SoA）。ブレンドを Joint 4つずつまとめて計算できる
+/// 配列は4の倍数に切り上げて確保し、余りは単位の姿勢で埋める
+/// </summary>
+struct PoseBuffer {
+  std::vector<float> translateX, translateY, translateZ;
+  std::vector<float> rotateX, rotateY, rotateZ, rotateW;
+  std::vector<float> scaleX, scaleY, scaleZ;
+  size_t jointCount = 0;
+
+  void Resize(size_t count);
+  void SetJoint(size_t joint, const QuaternionTransform &transform);
+  QuaternionTransform GetJoint(size_t joint) const;
+};
+
+/// <summary>
+/// Skeleton にバインドした再生用のクリップ（Animation か CompressedAnimation のどちらか一方を指す）
+/// 同じ Skeleton・同じクリップのインスタンス同士で共有できる。元のクリップより長く生きないこと
+/// </summary>
+struct AnimationClip {
+  const Animation *animation = nullptr;
+  const CompressedAnimation *compressed = nullptr;
+  AnimationBinding binding;
+  float duration = 0.0f;
+};
+
+AnimationClip MakeAnimationClip(const Skeleton &skeleton, const Animation &animation);
+AnimationClip MakeAnimationClip(const Skeleton &skeleton, const CompressedAnimation &animation);
+
+/// <summary>
+/// SoA の姿勢同士の計算。out は入力と同じバッファでもよい
+/// weight は全体の重み、jointWeights（マスク）は Joint ごとの重み（nullptr なら全部 1）で、掛けたものを使う
+/// </summary>
+namespace PoseBlend {
+
+/// <summary>
+/// a から b へ補間する（位置・スケールは線形、回転は近い側を通る nlerp）
+/// </summary>
+void Blend(const PoseBuffer &a, const PoseBuffer &b, float weight, const float *jointWeights,
+           PoseBuffer &out);
+
+/// <summary>
+/// 加算用の差分を作る（位置は差、回転は reference からの相対回転、スケールは比）
+/// </summary>
+void MakeAdditive(const PoseBuffer &source, const PoseBuffer &reference, PoseBuffer &out);
+
+/// <summary>
+/// base に差分を重み付きで足す（weight = 1 で MakeAdditive の source に戻る）
+/// </summary>
+void ApplyAdditive(const PoseBuffer &base, const PoseBuffer &additive, float weight,
+                   const float *jointWeights, PoseBuffer &out);
+
+/// <summary>
+/// クリップを time で評価する。クリップにない Joint は basePose の値になる
+/// </summary>
+/// <param name="cursors">Animation のときのキーフレームのカーソル（チャンネル数に合わせて確保する）</param>
+/// <param name="scratch">作業用（Joint 数に合わせて確保する）</param>
+void SampleClip(const AnimationClip &clip, float time, const std::vector<QuaternionTransform> &basePose,
+                std::vector<NodeAnimationCursor> &cursors, std::vector<QuaternionTransform> &scratch,
+                PoseBuffer &out);
+
+/// <summary>
+/// root とその子孫の Joint を weight、それ以外を 0 にしたマスク（上半身だけ別のクリップにするなど）
+/// root が見つからなければ全部 0
+/// </summary>
+std::vector<float> MakeJointMask(const Skeleton &skeleton, const std::string &rootJointName,
+                                 float weight = 1.0f);
+
+} // namespace PoseBlend
+
+/// <summary>
+/// レイヤーを重ねてアニメーションを評価する（インスタンスごとに1つ持つ）
+/// レイヤー0が土台で、上のレイヤーを順に上書き（Override）または加算（Additive）する
+/// 各レイヤーはクリップの切り替えをクロスフェードできる
+/// </summary>
+class AnimationController {
+public:
+  enum class BlendMode : uint8_t {
+    Override, // 下までの結果へ重み付きで補間する
+    Additive, // クリップの先頭フレームからの差分を足す（呼吸・のけぞりなど）
+  };
+
+  /// <summary>
+  /// 初期化。Skeleton の今の姿勢をクリップにない Joint の値として使う
+  /// </summary>
+  void Initialize(const Skeleton &skeleton);
+
+  /// <summary>
+  /// レイヤーを足す。番号を返す（レイヤー0は Initialize で作られる）
+  /// </summary>
+  uint32_t AddLayer(BlendMode mode, float weight = 1.0f);
+  void SetLayerWeight(uint32_t layer, float weight);
+  /// <summary>
+  /// Joint ごとの重み（MakeJointMask などで作る）。空なら全部 1
+  /// </summary>
+  void SetLayerMask(uint32_t layer, std::vector<float> jointWeights);
+
+  /// <summary>
+  /// クリップを再生する。fadeSeconds > 0 なら今のクリップからクロスフェードする
+  /// </summary>
+  void Play(const AnimationClip &clip, float fadeSeconds = 0.0f, uint32_t layer = 0, bool loop = true);
+
+  /// <summary>
+  /// レイヤーを止める（レイヤー0以外。fadeSeconds かけて重みを 0 にしていく）
+  /// </summary>
+  void Stop(uint32_t layer, float fadeSeconds = 0.0f);
+
+  /// <summary>
+  /// 時間を進める
+  /// </summary>
+  void Update(float deltaTime);
+
+  /// <summary>
+  /// 今の姿勢を評価して skeleton.transforms に書く（行列の更新は呼び出し側で ::Update する）
+  /// </summary>
+  void Evaluate(Skeleton &skeleton);
+
+  /// <summary>
+  /// 複数インスタンスの Update と Evaluate を TaskPool で並列に行う
+  /// </summary>
+  static void UpdateAndEvaluateParallel(std::span<AnimationController *const> controllers,
+                                        std::span<Skeleton *const> skeletons, float deltaTime);
+
+  /// <summary>
+  /// レイヤー0のクリップを time で評価して skeleton.transforms に書く（他のレイヤー・フェードは使わない）
+  /// 姿勢を共有するとき（PoseCache）に、丸めた時刻で評価するのに使う
+  /// </summary>
+  void EvaluateBaseAt(float time, Skeleton &skeleton);
+
+  const PoseBuffer &GetPose() const { return result_; }
+  size_t GetLayerCount() const { return layers_.size(); }
+  float GetLayerTime(uint32_t layer) const;
+  bool IsFading(uint32_t layer) const;
+  const AnimationClip *GetLayerClip(uint32_t layer) const;
+
+  /// <summary>
+  /// 姿勢がレイヤー0のクリップと時刻だけで決まるか（フェード中でなく、他のレイヤーが効いていない）
+  /// </summary>
+  bool IsSingleClip() const;
+
+private:
+  struct Playback {
+    const AnimationClip *clip = nullptr;
+    float time = 0.0f;
+    bool loop = true;
+    std::vector<NodeAnimationCursor> cursors;
+    PoseBuffer additiveReference; // Additive のときの差分の基準（このクリップの先頭フレーム）
+  };
+
+  struct Layer {
+    BlendMode mode = BlendMode::Override;
+    float weight = 1.0f;
+    std::vector<float> mask; // 空なら全部 1（使うときは 4 の倍数に切り上げてある）
+    Playback current;
+    Playback previous; // クロスフェード元
+    float fadeElapsed = 0.0f;
+    float fadeDuration = 0.0f; // 0 ならフェードしていない
+    float stopFadeDuration = 0.0f; // Stop のフェード
+    float stopFadeElapsed = 0.0f;
+  };
+
+  void Advance(Playback &playback, float deltaTime) const;
+  void SampleLayer(Layer &layer, PoseBuffer &out);
+  float EffectiveWeight(const Layer &layer) const;
+
+  std::vector<QuaternionTransform> bindPose_;
+  std::vector<Layer> layers_;
+  PoseBuffer result_;
+  PoseBuffer layerPose_;
+  PoseBuffer fadePose_;
+  std::vector<QuaternionTransform> scratch_;
+  std::vector<NodeAnimationCursor> referenceCursors_;
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "AnimationSet.h"
+#include "MeshCache.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// ファイル内の全アニメーションをバイナリで保存し、次回以降は Assimp なしで読み戻すキャッシュ
+/// 置き場所とキー（元ファイルのハッシュ）は MeshCache と共有する
+/// </summary>
+namespace AnimationCache {
+
+// フォーマットや座標変換を変えたら上げる（古いキャッシュは自動で作り直される）
+constexpr uint32_t kVersion = 1;
+
+/// <summary>
+/// 元ファイルに対応するキャッシュファイルのパス（MeshCache と同じ場所で、拡張子だけ .anim）
+/// </summary>
+std::string GetCachePath(const std::string &sourcePath);
+
+/// <summary>
+/// キャッシュを書き出す（一時ファイルに書いてから置き換える）
+/// </summary>
+/// <returns>書き込めたら true</returns>
+bool Save(const std::string &cachePath, const MeshCache::Key &key,
+          const std::vector<NamedAnimation> &animations);
+
+/// <summary>
+/// キャッシュを読み込む。ファイルがない・バージョンやキーが違う・壊れている場合は false
+/// </summary>
+bool Load(const std::string &cachePath, const MeshCache::Key &key,
+          std::vector<NamedAnimation> &outAnimations);
+
+} // namespace AnimationCache
@@ -0,0 +1,46 @@
+#pragma once
+#include "AnimationSet.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/// <summary>
+/// アニメーションをファイル単位で一度だけ読み込み、インスタンス間で共有する
+/// 読み込みは AnimationCache（MeshCache と同じ場所）を優先し、なければ Assimp で全クリップを取り込む
+/// 返したポインタは Finalize まで有効。ワーカースレッドから呼んでもよい
+/// </summary>
+class AnimationLibrary {
+public:
+  static AnimationLibrary *GetInstance();
+
+  /// <summary>
+  /// 全部破棄する（以降、返したポインタは使えない）
+  /// </summary>
+  void Finalize();
+
+  /// <summary>
+  /// ファイル内の全クリップを読み込む（読み込み済みならそれを返す）。読めなければ nullptr
+  /// </summary>
+  /// <param name="filePath">ファイルパス（directoryPath + "/" + filename）</param>
+  const AnimationSet *Load(const std::string &filePath);
+
+  /// <summary>
+  /// 読み込み済みの中から探す（読み込みはしない）
+  /// </summary>
+  const AnimationSet *Find(const std::string &filePath) const;
+
+  /// <summary>
+  /// Load してクリップを名前で引く。ファイルかクリップがなければ nullptr
+  /// </summary>
+  const Animation *LoadAnimation(const std::string &filePath, const std::string &clipName);
+
+private:
+  AnimationLibrary() = default;
+  ~AnimationLibrary() = default;
+  AnimationLibrary(const AnimationLibrary &) = delete;
+  AnimationLibrary &operator=(const AnimationLibrary &) = delete;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<AnimationSet>> sets_;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include "Animation.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// キーフレーム列のカーソル。前回サンプリングした区間（keyframes[index] ～ keyframes[index + 1]）を覚えておき、
+/// 時刻が少し進んだだけなら先頭から探し直さずに済ませる
+/// チャンネル（translate / rotate / scale）ごと、再生しているインスタンスごとに持つ
+/// </summary>
+struct KeyframeCursor {
+  uint32_t index = 0;
+};
+
+/// <summary>
+/// NodeAnimation 1つ分のカーソル
+/// </summary>
+struct NodeAnimationCursor {
+  KeyframeCursor translate;
+  KeyframeCursor rotate;
+  KeyframeCursor scale;
+};
+
+/// <summary>
+/// キーフレームを補間した値を求める（先頭から線形に探す。SampleKeyframes の基準実装）
+/// </summary>
+Vector3 CalculateValue(const std::vector<KeyframeVector3> &keyframes, float time);
+Quaternion CalculateValue(const std::vector<KeyframeQuaternion> &keyframes, float time);
+
+/// <summary>
+/// CalculateValue と同じ値を、カーソルを使って求める
+/// 順再生ならカーソルの区間かその次を見るだけで済み、シークやループで外れたときは二分探索する
+/// キーフレームは時刻順に並んでいること（Assimp が出力する順）
+/// </summary>
+Vector3 SampleKeyframes(const std::vector<KeyframeVector3> &keyframes, float time,
+                        KeyframeCursor &cursor);
+Quaternion SampleKeyframes(const std::vector<KeyframeQuaternion> &keyframes, float time,
+                           KeyframeCursor &cursor);
+
+/// <summary>
+/// time を含む区間の先頭インデックスを返す（CalculateValue が線形探索で最初に見つける区間と同じ）
+/// time が最後のキーより後なら keyframes.size() - 1 を返す
+/// </summary>
+template <typename tValue>
+uint32_t FindKeyframeSegment(const std::vector<Keyframe<tValue>> &keyframes, float time,
+                             KeyframeCursor &cursor);
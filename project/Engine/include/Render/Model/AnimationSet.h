@@ -0,0 +1,45 @@
+#pragma once
+#include "Animation.h"
+#include "CompressedAnimation.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 名前付きのアニメーションクリップ（ファイルから取り出したままのもの）
+/// </summary>
+struct NamedAnimation {
+  std::string name;
+  Animation animation;
+};
+
+/// <summary>
+/// 1ファイルに入っている全アニメーションクリップ（idle / walk / attack など）
+/// 番号はファイル内の並び順。名前が重なったクリップは名前では最初のものだけ引ける
+/// </summary>
+struct AnimationSet {
+  std::string sourcePath;
+  std::vector<std::string> names;
+  std::vector<Animation> animations;
+  std::vector<CompressedAnimation> compressedAnimations; // animations と同じ並び
+  std::unordered_map<std::string, uint32_t> indexByName;
+
+  size_t GetCount() const { return animations.size(); }
+
+  /// <summary>
+  /// 名前から番号を引く。見つからなければ -1
+  /// </summary>
+  int32_t FindIndex(const std::string &name) const;
+
+  const Animation *Get(size_t index) const;
+  const CompressedAnimation *GetCompressed(size_t index) const;
+  const Animation *Find(const std::string &name) const;
+  const CompressedAnimation *FindCompressed(const std::string &name) const;
+};
+
+/// <summary>
+/// 取り出したクリップから AnimationSet を作る（名前の索引と、再生用の圧縮もここで作る）
+/// 名前が空のクリップは "Animation<番号>" にする
+/// </summary>
+AnimationSet MakeAnimationSet(const std::string &sourcePath, std::vector<NamedAnimation> clips);
@@ -0,0 +1,107 @@
+#pragma once
+#include "Animation.h"
+#include "Math/Transform.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 圧縮したアニメーションクリップ
+/// 各チャンネルを一定間隔で再サンプリングし（キーごとの時刻を持たない）、
+/// 量子化したサンプルを1本の配列にまとめて持つ（量子化で許容誤差に収まらないトラックだけ float のまま）
+/// </summary>
+struct CompressedAnimation {
+  /// <summary>
+  /// 1チャンネル分（translate / rotate / scale のどれか）
+  /// 値は value = rangeMin + q * rangeScale で戻す（rotate は最小3成分の番号付き）
+  /// quantized が false なら1サンプルは float 4つ（uint16_t 8つ分）をそのまま持つ
+  /// </summary>
+  struct Track {
+    uint32_t offset = 0;      // samples 内の先頭（uint16_t 単位）
+    uint32_t sampleCount = 1; // 1 なら一定値で、rangeMin がそのままの値
+    uint16_t stride = 1;      // 何フレームごとに1サンプル残したか（キーフレーム削減）
+    bool quantized = true;
+    float rangeMin[4] = {};
+    float rangeScale[4] = {};
+  };
+
+  struct NodeTracks {
+    Track translate;
+    Track rotate;
+    Track scale;
+  };
+
+  float duration = 0.0f;   // 秒
+  float sampleRate = 30.0f; // 1秒あたりのフレーム数
+  uint32_t frameCount = 1;  // 元のサンプル数（最後のフレームは duration ちょうど）
+
+  std::vector<std::string> nodeNames; // 名前順（FindNode は二分探索）
+  std::vector<NodeTracks> nodes;       // nodeNames と同じ並び
+  std::vector<uint16_t> samples;       // 全チャンネルのサンプル。1サンプル4つ（xyz + 0 / 最小3成分 + 番号）
+
+  /// <summary>
+  /// ノード名から番号を引く。見つからなければ -1
+  /// </summary>
+  int32_t FindNode(const std::string &name) const;
+
+  /// <summary>
+  /// 使っているメモリ量（バイト）
+  /// </summary>
+  size_t GetMemorySize() const;
+};
+
+/// <summary>
+/// アニメーションの圧縮（一定間隔での再サンプリング・許容誤差内のキーフレーム削減・量子化）と展開
+/// </summary>
+namespace AnimationCompression {
+
+struct Settings {
+  // 最低のサンプリングレート。元のキーの間隔がこれより細かければ、その間隔に合わせる
+  float sampleRate = 30.0f;
+  // 元のキーと比べて許容誤差に収まらなければ、この値まで倍にして作り直す
+  float maxSampleRate = 240.0f;
+  float translationTolerance = 0.0005f; // 位置の許容誤差（長さの単位）
+  float rotationTolerance = 0.001f;     // 回転の許容誤差（ラジアン）
+  float scaleTolerance = 0.0005f;       // スケールの許容誤差
+  uint16_t maxStride = 8;               // キーフレーム削減で間引く最大の間隔（2の累乗、16 まで）
+};
+
+/// <summary>
+/// 圧縮する。各トラックは量子化・間引きの後の値を元のキー（キーの時刻とその中間）と比べ、
+/// 許容誤差に収まる最大の間隔を選ぶ。間引かなくても収まらなければ、量子化をやめるかサンプリングレートを上げる
+/// </summary>
+CompressedAnimation Compress(const Animation &animation, const Settings &settings = {});
+
+/// <summary>
+/// 1ノード分の姿勢を求める。time は [0, duration] に丸める（ループは呼び出し側で fmod する）
+/// 回転はフレーム間を正規化線形補間（nlerp）する
+/// </summary>
+QuaternionTransform SampleNode(const CompressedAnimation &animation, uint32_t nodeIndex,
+                               float time);
+
+/// <summary>
+/// 全ノード分の姿勢をまとめて求める
+/// </summary>
+/// <param name="outPose">nodes.size() 個の書き込み先</param>
+void SamplePose(const CompressedAnimation &animation, float time, QuaternionTransform *outPose);
+
+/// <summary>
+/// 指定したノードだけ求めて、それぞれ別の番号へ書き込む（Skeleton にバインド済みのチャンネルを適用する用）
+/// outPose[outIndices[i]] = nodeIndices[i] 番ノードの姿勢
+/// </summary>
+void SampleNodes(const CompressedAnimation &animation, float time, const uint32_t *nodeIndices,
+                 const int32_t *outIndices, size_t count, QuaternionTransform *outPose);
+
+/// <summary>
+/// 最小3成分の量子化（最も絶対値の大きい成分を捨てて番号で持ち、残り3成分を 16bit にする）
+/// </summary>
+void PackQuaternion(const Quaternion &q, uint16_t out[4]);
+Quaternion UnpackQuaternion(const uint16_t in[4]);
+
+/// <summary>
+/// 圧縮前のアニメーションが使っているメモリ量（キーフレームとノード名。比較用）
+/// </summary>
+size_t GetMemorySize(const Animation &animation);
+
+} // namespace AnimationCompression
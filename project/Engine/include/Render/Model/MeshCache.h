@@ -0,0 +1,51 @@
+#pragma once
+#include "ModelAssetData.h"
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// Assimp での読み込み結果をバイナリで保存し、次回以降は解析なしで読み戻すキャッシュ
+/// 頂点・インデックス・サブメッシュ・LOD・マテリアル参照・ノード階層（スケルトンの元）・スキンクラスタを保持する
+/// </summary>
+namespace MeshCache {
+
+// フォーマットや座標変換を変えたら上げる（古いキャッシュは自動で作り直される）
+constexpr uint32_t kVersion = 4;
+
+/// <summary>
+/// キャッシュの有効性を判定するキー
+/// </summary>
+struct Key {
+  uint64_t sourceHash = 0;  // 元ファイル（と付随ファイル）の内容のハッシュ
+  uint32_t importFlags = 0; // Assimp の後処理フラグ
+};
+
+/// <summary>
+/// キャッシュの置き場所（既定は cache/mesh）
+/// </summary>
+void SetCacheDirectory(const std::string &directory);
+const std::string &GetCacheDirectory();
+
+/// <summary>
+/// 元ファイルに対応するキャッシュファイルのパス
+/// </summary>
+std::string GetCachePath(const std::string &sourcePath);
+
+/// <summary>
+/// 元ファイルの内容をハッシュする
+/// .obj は同名の .mtl、.gltf は同名の .bin も含める（読めなければ 0）
+/// </summary>
+uint64_t HashSourceFiles(const std::string &sourcePath);
+
+/// <summary>
+/// キャッシュを書き出す（一時ファイルに書いてから置き換える）
+/// </summary>
+/// <returns>書き込めたら true</returns>
+bool Save(const std::string &cachePath, const Key &key, const ModelAsset::ModelData &modelData);
+
+/// <summary>
+/// キャッシュを読み込む。ファイルがない・バージョンやキーが違う・壊れている場合は false
+/// </summary>
+bool Load(const std::string &cachePath, const Key &key, ModelAsset::ModelData &outModelData);
+
+} // namespace MeshCache
@@ -0,0 +1,65 @@
+#pragma once
+#include "ModelAssetData.h"
+#include <cstdint>
+#include <span>
+
+/// <summary>
+/// 読み込み時のメッシュ最適化（重複頂点の結合・頂点キャッシュ向けの並べ替え・頂点フェッチ順・オーバードロー順）
+/// サブメッシュごとに処理し、スキンのウェイトの頂点番号も合わせて付け替える
+/// </summary>
+namespace MeshOptimizer {
+
+// 頂点キャッシュの想定サイズ（FIFO）
+constexpr uint32_t kDefaultCacheSize = 16;
+
+/// <summary>
+/// 頂点キャッシュの効率
+/// </summary>
+struct CacheStats {
+  float acmr = 0.0f; // 1三角形あたりの頂点シェーダー実行回数（0.5～3、小さいほど良い）
+  float atvr = 0.0f; // 使用頂点1つあたりの実行回数（1.0 が理想）
+};
+
+struct Options {
+  bool weldVertices = true;       // 完全に同じ頂点を1つにまとめる
+  bool optimizeVertexCache = true; // Tipsify で三角形を並べ替える
+  bool optimizeOverdraw = true;   // キャッシュ効率を保ったまま外向きのクラスタから描く
+  bool optimizeVertexFetch = true; // 頂点を最初に使われる順に並べ替える
+  uint32_t cacheSize = kDefaultCacheSize;
+};
+
+/// <summary>
+/// 最適化の結果（ログ・確認用）
+/// </summary>
+struct Report {
+  uint32_t verticesBefore = 0;
+  uint32_t verticesAfter = 0;
+  CacheStats before;
+  CacheStats after;
+};
+
+/// <summary>
+/// FIFO キャッシュを模擬して ACMR / ATVR を求める
+/// </summary>
+CacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount,
+                              uint32_t cacheSize = kDefaultCacheSize);
+
+/// <summary>
+/// 三角形の順番を Tipsify（Sander ら 2007）で並べ替える。頂点番号は 0～vertexCount-1
+/// </summary>
+void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount,
+                         uint32_t cacheSize = kDefaultCacheSize);
+
+/// <summary>
+/// キャッシュ最適化済みの並びをクラスタに分け、外向きのクラスタが先に描かれるよう並べ替える
+/// （クラスタ内の順番は保つので ACMR はほぼ変わらない）
+/// </summary>
+void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const ModelAsset::VertexData> vertices,
+                      uint32_t cacheSize = kDefaultCacheSize);
+
+/// <summary>
+/// モデル全体を最適化する
+/// </summary>
+Report Optimize(ModelAsset::ModelData &modelData, const Options &options = {});
+
+} // namespace MeshOptimizer
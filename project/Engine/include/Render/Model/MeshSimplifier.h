@@ -0,0 +1,49 @@
+#pragma once
+#include "ModelAssetData.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 二次誤差（QEM, Garland & Heckbert 1997）による辺の縮約でメッシュを簡略化し、LOD を作る
+/// 頂点は隣の既存頂点へ寄せるだけなので新しい頂点は作らず、頂点バッファ（スキンも含む）は LOD0 と共有できる
+/// UV・法線の継ぎ目と穴の縁の頂点は動かさない（ひび割れ防止）
+/// </summary>
+namespace MeshSimplifier {
+
+/// <summary>
+/// LOD 生成の設定（各配列は LOD1, LOD2, ... の順）
+/// </summary>
+struct LodSettings {
+  std::vector<float> targetRatios = {0.5f, 0.25f, 0.12f};  // LOD0 の三角形数に対する目標
+  std::vector<float> maxErrors = {0.005f, 0.015f, 0.04f}; // 許容する形状のずれ（モデルの大きさに対する比）
+  std::vector<float> screenSizes = {0.35f, 0.15f, 0.06f}; // 投影サイズがこれを下回ったら使う
+  float minReduction = 0.85f; // 直前の LOD の三角形数のこの割合より減らなければ打ち切る
+};
+
+struct Result {
+  std::vector<uint32_t> indices;
+  float error = 0.0f; // 元の頂点から簡略化後の面までの距離の上限（モデル空間の距離）
+};
+
+/// <summary>
+/// 三角形リストを目標のインデックス数か誤差の上限まで簡略化する
+/// </summary>
+/// <param name="indices">vertices 内の番号で書かれたインデックス</param>
+/// <param name="targetIndexCount">目標のインデックス数</param>
+/// <param name="targetError">元の頂点から簡略化後の面までの距離の上限（モデル空間の距離）</param>
+Result Simplify(std::span<const uint32_t> indices, std::span<const ModelAsset::VertexData> vertices,
+                size_t targetIndexCount, float targetError);
+
+/// <summary>
+/// 頂点の AABB の最も長い辺（誤差を比で扱うときの基準）
+/// </summary>
+float ComputeExtent(std::span<const ModelAsset::VertexData> vertices);
+
+/// <summary>
+/// LOD0 のサブメッシュごとに簡略化して modelData.lods を作り直す
+/// 追加したインデックスは頂点キャッシュ向けに並べ替えてから indices の末尾に置く
+/// </summary>
+void GenerateLods(ModelAsset::ModelData &modelData, const LodSettings &settings = {});
+
+} // namespace MeshSimplifier
@@ -1,6 +1,10 @@
 #pragma once
 #include "Animation.h"
+#include "AnimationSampler.h"
+#include "Math/Geometry.h"
 #include "Math/MathUtil.h"
+#include "ModelAssetData.h"
+#include "ModelBounds.h"
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
@@ -13,47 +17,22 @@
 
 class ModelRenderer;
 class Dx12Core;
+class ICommandRecorder;
 struct SkinCluster;
 
 class Model {
 
 public:
-  struct VertexData {
-    Vector4 position;
-    Vector2 texcoord;
-    Vector3 normal;
-  };
-  struct MaterialData {
-    std::string textureFilePath;
-    // uint32_t textureIndex = 0;
-  };
-
-public:
-  struct Node {
-    QuaternionTransform transform;
-    Matrix4x4 localMatrix;
-    std::string name;
-    std::vector<Node> children;
-  };
-
-public:
-  struct VertexWeightData {
-      float weight;
-      uint32_t vertexIndex;
-  };
-
-  struct JointWeightData {
-      Matrix4x4 inverseBindPoseMatrix;
-      std::vector<VertexWeightData> vertexWeights;
-  };
-
-  struct ModelData {
-    std::vector<VertexData> vertices;
-    std::vector<uint32_t> indices;
-    MaterialData material;
-    Node rootNode;
-    std::map<std::string, JointWeightData> skinClusterData;
-  };
+  // データ構造の実体は ModelAssetData.h（メッシュキャッシュと共有するため）
+  using VertexData = ModelAsset::VertexData;
+  using MaterialData = ModelAsset::MaterialData;
+  using Node = ModelAsset::Node;
+  using VertexWeightData = ModelAsset::VertexWeightData;
+  using JointWeightData = ModelAsset::JointWeightData;
+  using SubMesh = ModelAsset::SubMesh;
+  using DrawRange = ModelAsset::DrawRange;
+  using MeshLod = ModelAsset::MeshLod;
+  using ModelData = ModelAsset::ModelData;
 
 public:
   struct Material {
@@ -78,6 +57,19 @@ public:
                   const std::string &directorypath,
                   const std::string &filename);
 
+  /// <summary>
+  /// 読み込み済みのモデルデータから初期化（非同期読み込みの後処理用。メインスレッドで呼ぶ）
+  /// </summary>
+  /// <param name="loadTexturesAsync">true ならテクスチャも非同期で読み、届くまで白テクスチャで描く</param>
+  void InitializeFromData(ModelRenderer *modelRenderer, ModelData &&modelData,
+                          bool loadTexturesAsync);
+
+  /// <summary>
+  /// モデルファイルを読んで CPU 側のデータだけを返す（GPU に触れないのでワーカースレッドから呼べる）
+  /// </summary>
+  static ModelData ReadModelFile(const std::string &directoryPath,
+                                 const std::string &filename);
+
   /// <summary>
   /// 頂点データから初期化（Primitive用）
   /// </summary>
@@ -87,16 +79,33 @@ public:
   /// <summary>
   /// 描画
   /// </summary>
-  void Draw(const SkinCluster* skinCluster = nullptr);
+  /// <param name="lodIndex">0 が元のメッシュ。LOD がない・範囲外なら元のメッシュで描く</param>
+  void Draw(const SkinCluster* skinCluster = nullptr, uint32_t lodIndex = 0);
+
+  /// <summary>
+  /// 描画コマンドを recorder に積む（Draw はコマンドリストに直接積む場合）
+  /// 頂点・インデックスバッファとマテリアルごとのテクスチャを設定し、instanceCount 個のインスタンスで描く
+  /// </summary>
+  void Record(ICommandRecorder &recorder, const SkinCluster *skinCluster, uint32_t lodIndex,
+              uint32_t instanceCount);
+
+  /// <summary>
+  /// GPU リソースまで用意できているか（非同期読み込み中のプレースホルダーは false）
+  /// </summary>
+  bool IsReady() const { return isReady_; }
 
 private:
-  ModelRenderer *modelRenderer_;
+  ModelRenderer *modelRenderer_ = nullptr;
 
   Dx12Core *dx12Core_ = nullptr;
 
   // Objファイルのデータ
   ModelData modelData_;
 
+  // マテリアルごとにまとめた描画範囲（テクスチャの切り替え回数＝描画コマンド数）
+  std::vector<DrawRange> drawRanges_;
+  std::vector<std::vector<DrawRange>> lodDrawRanges_; // LOD1 以降
+
   /// <summary>
   /// mtlファイルを読む
   /// </summary>
@@ -139,6 +148,13 @@ private:
   /// </summary>
   void CreateVertexData();
 
+  /// <summary>
+  /// modelData_ から境界・頂点バッファ・マテリアル・テクスチャ・描画範囲を用意する
+  /// </summary>
+  void SetupResources(bool loadTexturesAsync);
+
+  bool isReady_ = false;
+
 private:
   Material defaultMaterial_;
 
@@ -156,12 +172,38 @@ public:
 
   const Node &GetRootNode() const { return modelData_.rootNode; }
   const ModelData &GetModelData() const { return modelData_; }
+  const std::vector<DrawRange> &GetDrawRanges(uint32_t lodIndex = 0) const {
+    return (lodIndex == 0 || lodIndex > lodDrawRanges_.size()) ? drawRanges_
+                                                               : lodDrawRanges_[lodIndex - 1];
+  }
+  const std::vector<MeshLod> &GetLods() const { return modelData_.lods; }
+
+private:
+  /* 境界ボリューム（メッシュのローカル空間）
+  -----------------------------*/
+  AABB localAABB_{};
+  Sphere localSphere_{};
+  std::vector<BoundingVolume> subMeshBounds_; // サブメッシュごと（modelData_.subMeshes と同じ並び）
+  JointBounds jointBounds_; // スキンメッシュの Joint ごと（アニメーション中の境界を毎フレーム作るのに使う）
+
+  /// <summary>
+  /// 頂点データから境界ボリュームを計算
+  /// </summary>
+  void CalculateBounds();
+
+public:
+  const AABB &GetLocalAABB() const { return localAABB_; }
+  const Sphere &GetLocalSphere() const { return localSphere_; }
+  const std::vector<BoundingVolume> &GetSubMeshBounds() const { return subMeshBounds_; }
+
+  /// <summary>
+  /// Joint ごとの境界（スキンがなければ空）。ModelBounds::ComputeSkinnedAABB で姿勢ごとの境界にする
+  /// </summary>
+  const JointBounds &GetJointBounds() const { return jointBounds_; }
 };
 
+/// <summary>
+/// ファイルの最初のアニメーションを返す（全クリップは AnimationLibrary から名前・番号で引ける）
+/// </summary>
 Animation LoadAnimationFile(const std::string &directoryPath,
                             const std::string &filename);
-
-Vector3 CalculateValue(const std::vector<KeyframeVector3> &keyframes,
-                       float time);
-Quaternion CalculateValue(const std::vector<KeyframeQuaternion> &keyframes,
-                          float time);
@@ -0,0 +1,127 @@
+#pragma once
+#include "Math/Matrix4x4.h"
+#include "Math/Transform.h"
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+#include "Math/Vector4.h"
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// モデルファイルから読み込んだCPU側のデータ
+/// D3D12 / Assimp に依存しないので、メッシュキャッシュやツールからも使える
+/// （Model からは Model::VertexData などの名前で参照する）
+/// </summary>
+namespace ModelAsset {
+
+struct VertexData {
+  Vector4 position;
+  Vector2 texcoord;
+  Vector3 normal;
+};
+
+struct MaterialData {
+  std::string textureFilePath;
+};
+
+struct Node {
+  QuaternionTransform transform;
+  Matrix4x4 localMatrix;
+  std::string name;
+  std::vector<Node> children;
+};
+
+struct VertexWeightData {
+  float weight;
+  uint32_t vertexIndex;
+};
+
+struct JointWeightData {
+  Matrix4x4 inverseBindPoseMatrix;
+  std::vector<VertexWeightData> vertexWeights;
+};
+
+/// <summary>
+/// 結合済みの頂点・インデックスバッファ内での1メッシュ分の範囲
+/// インデックスは結合後の頂点番号を指す（vertexOffset 加算済み）
+/// </summary>
+struct SubMesh {
+  uint32_t vertexOffset;
+  uint32_t vertexCount;
+  uint32_t indexOffset;
+  uint32_t indexCount;
+  uint32_t materialIndex;
+};
+
+/// <summary>
+/// 1回の描画コマンドで描ける範囲（同じマテリアルで連続したサブメッシュをまとめたもの）
+/// </summary>
+struct DrawRange {
+  uint32_t indexOffset;
+  uint32_t indexCount;
+  uint32_t materialIndex;
+};
+
+/// <summary>
+/// 読み込み時に自動生成した詳細度（LOD1 以降。LOD0 は ModelData::subMeshes）
+/// インデックスは ModelData::indices の末尾に追加され、頂点バッファは LOD0 と共有する
+/// </summary>
+struct MeshLod {
+  float error;       // 元の形状からのずれ（モデルの大きさに対する比）
+  float screenSize;  // 画面の高さに対する投影サイズがこれを下回ったら使う
+  std::vector<SubMesh> subMeshes; // LOD0 のサブメッシュと同じ並び・同じ頂点範囲
+};
+
+struct ModelData {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  std::vector<MaterialData> materials; // SubMesh::materialIndex で引く
+  std::vector<SubMesh> subMeshes;
+  std::vector<MeshLod> lods; // 粗くなる順
+  Node rootNode;
+  std::map<std::string, JointWeightData> skinClusterData;
+};
+
+/// <summary>
+/// 同じマテリアルのメッシュがインデックスバッファ上で隣り合うよう、メッシュを結合する順番を作る
+/// マテリアル番号の小さい順で、同じマテリアルの中は元の順のまま
+/// </summary>
+/// <param name="materialIndices">メッシュごとのマテリアル番号（ファイル内の並び）</param>
+/// <returns>AppendSubMesh に渡すメッシュの番号の並び</returns>
+std::vector<uint32_t> MakeMaterialOrder(std::span<const uint32_t> materialIndices);
+
+/// <summary>
+/// メッシュを結合バッファの末尾に追加する
+/// </summary>
+/// <param name="vertices">メッシュの頂点</param>
+/// <param name="indices">メッシュ内の頂点番号で書かれたインデックス</param>
+/// <param name="materialIndex">マテリアル番号</param>
+/// <returns>追加した範囲（ボーンの頂点番号は vertexOffset を足して使う）</returns>
+SubMesh AppendSubMesh(ModelData &modelData, std::span<const VertexData> vertices,
+                      std::span<const uint32_t> indices, uint32_t materialIndex);
+
+/// <summary>
+/// サブメッシュをマテリアルごとにまとめた描画範囲を作る
+/// インデックスが連続している同じマテリアルのサブメッシュは1つの範囲になる
+/// </summary>
+std::vector<DrawRange> BuildDrawRanges(const std::vector<SubMesh> &subMeshes);
+
+/// <summary>
+/// 境界球が画面の高さに占める割合（直径 / 画面の高さ）
+/// </summary>
+/// <param name="radius">ワールド空間での半径</param>
+/// <param name="distance">カメラから球の中心までの距離</param>
+/// <param name="projectionScaleY">射影行列の m[1][1]（1 / tan(fovY / 2)）</param>
+float ProjectedScreenSize(float radius, float distance, float projectionScaleY);
+
+/// <summary>
+/// 投影サイズから使う LOD を選ぶ（0 が最も細かい）
+/// 境界付近で毎フレーム切り替わらないよう、しきい値の前後 hysteresis の割合は今の LOD を保つ
+/// </summary>
+uint32_t SelectLod(const std::vector<MeshLod> &lods, float screenSize, uint32_t currentLod,
+                   float hysteresis);
+
+} // namespace ModelAsset
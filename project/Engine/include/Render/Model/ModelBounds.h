@@ -0,0 +1,72 @@
+#pragma once
+#include "Math/Geometry.h"
+#include "Math/Matrix4x4.h"
+#include "ModelAssetData.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+struct Skeleton;
+
+/// <summary>
+/// 境界ボリューム（同じ頂点を包む AABB と球）
+/// </summary>
+struct BoundingVolume {
+  AABB aabb;
+  Sphere sphere;
+};
+
+/// <summary>
+/// スキンメッシュの Joint ごとの境界
+/// 各 Joint の影響を受ける頂点を、逆バインド行列で Joint の空間に移して包んだ AABB
+/// Joint の skeletonSpaceMatrix で変換した箱を全部合わせると、スキニング後の頂点は必ずその中に入る
+/// （スキニング後の頂点は、影響する Joint で変換した点の重み付き平均なので）
+/// </summary>
+struct JointBounds {
+  std::vector<std::string> jointNames; // 頂点に影響する Joint（ModelData::skinClusterData の名前）
+  std::vector<AABB> aabbs;             // jointNames と同じ並び
+};
+
+namespace ModelBounds {
+
+/// <summary>
+/// 頂点を包む AABB と球（球は AABB の中心から最も遠い頂点までを半径にする）。頂点がなければ原点で大きさ 0
+/// </summary>
+BoundingVolume Compute(std::span<const ModelAsset::VertexData> vertices);
+
+/// <summary>
+/// サブメッシュごとの境界（ModelData::subMeshes と同じ並び）
+/// </summary>
+std::vector<BoundingVolume> ComputeSubMeshes(const ModelAsset::ModelData &modelData);
+
+/// <summary>
+/// Joint ごとの境界。スキンを持たないモデルなら空
+/// </summary>
+JointBounds ComputeJointBounds(const ModelAsset::ModelData &modelData);
+
+/// <summary>
+/// JointBounds の各 Joint を Skeleton の番号に解決する（Skeleton にない Joint は -1。スキニングにも使われない）
+/// Skeleton ごとに1回だけ呼び、毎フレームは名前を引かない
+/// </summary>
+std::vector<int32_t> ResolveJoints(const JointBounds &jointBounds, const Skeleton &skeleton);
+
+/// <summary>
+/// 今の姿勢でのスキニング後の頂点を包む AABB（モデル空間）。影響する Joint がなければ原点で大きさ 0
+/// </summary>
+/// <param name="jointIndices">ResolveJoints の結果</param>
+/// <param name="skeletonSpaceMatrices">Skeleton::skeletonSpaceMatrices</param>
+AABB ComputeSkinnedAABB(const JointBounds &jointBounds, std::span<const int32_t> jointIndices,
+                        const Matrix4x4 *skeletonSpaceMatrices);
+
+/// <summary>
+/// 2つの AABB を包む AABB
+/// </summary>
+AABB Union(const AABB &a, const AABB &b);
+
+/// <summary>
+/// AABB を包む球（中心は AABB の中心、半径は対角線の半分）
+/// </summary>
+Sphere MakeSphere(const AABB &aabb);
+
+} // namespace ModelBounds
@@ -1,7 +1,9 @@
 #pragma once
+#include "Util/AsyncLoader.h"
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 class Model;
 
@@ -32,6 +34,15 @@ private:
 
   std::unique_ptr<ModelRenderer> modelRenderer = nullptr;
 
+  // 非同期で読み込み中のモデル（models にはプレースホルダーが入っている）
+  std::unordered_map<std::string, LoadHandle> pendingModels_;
+
+  /// <summary>
+  /// 解決済みのパスをディレクトリとファイル名に分ける
+  /// </summary>
+  static void SplitModelPath(const std::string &resolved, std::string &directoryPath,
+                             std::string &filename);
+
 public:
   /// <summary>
   /// モデルファイルの読み込み
@@ -39,6 +50,13 @@ public:
   /// <param name="filePath">ファイルパス</param>
   void LoadModel(const std::string &filePath);
 
+  /// <summary>
+  /// モデルファイルを非同期で読み込む
+  /// すぐに FindModel で見つかるプレースホルダーを登録し、準備できるまでは描画しない（Model::IsReady）
+  /// </summary>
+  /// <param name="filePath">ファイルパス</param>
+  LoadHandle LoadModelAsync(const std::string &filePath);
+
   /// <summary>
   /// モデルの検索
   /// </summary>
@@ -47,5 +65,8 @@ public:
 
   ModelRenderer *GetModelRenderer() const { return modelRenderer.get(); }
 
+  /// <summary>
+  /// ファイル名だけの指定を resources 以下の実パスに解決する（AssetIndex を参照）
+  /// </summary>
   static std::string ResolveModelPath(const std::string &input);
 };
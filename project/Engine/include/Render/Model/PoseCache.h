@@ -0,0 +1,132 @@
+#pragma once
+#include "Math/Geometry.h"
+#include "Model/Skinning.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct Skeleton;
+struct AnimationClip;
+
+/// <summary>
+/// 同じ Skeleton・同じクリップを再生している群衆で、評価済みのパレット（と境界）を共有するキャッシュ
+/// キーは（Skeleton, クリップ, 丸めた時刻）。時刻は sampleRate のフレームに丸めるので、
+/// 位相がそろっているほど評価（サンプリング・行列の伝播・パレット作成）の回数が減る
+/// 参照カウントで使用中のものを残し、BeginFrame で一定フレーム使われなかったものを捨てる
+/// スレッドセーフではない（更新ループから呼ぶ）
+/// </summary>
+class PoseCache {
+public:
+  struct Settings {
+    float sampleRate = 30.0f;    // 時刻を丸める間隔（1秒あたりのフレーム数）
+    uint32_t maxIdleFrames = 2;  // 誰も使っていないエントリーを何フレーム残すか
+    size_t maxEntries = 1024;    // これを超えたら古いものから捨てる（使用中のものは捨てない）
+  };
+
+  struct Key {
+    uint64_t skeleton = 0;          // MakeSkeletonKey の値
+    const void *clip = nullptr;     // 再生しているクリップ（AnimationClip など。クリップより先に捨てること）
+    int32_t frame = 0;              // 丸めた時刻
+    bool operator==(const Key &other) const {
+      return skeleton == other.skeleton && clip == other.clip && frame == other.frame;
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::vector<WellForGPU> palette;
+    AABB bounds{}; // その姿勢でのスキニング後の境界（モデル空間）
+    uint32_t refCount = 0;
+    uint64_t lastUsedFrame = 0;
+  };
+
+  /// <summary>
+  /// 初期化（エントリーは全部捨てる）
+  /// </summary>
+  void Initialize(const Settings &settings);
+
+  /// <summary>
+  /// フレームの先頭で呼ぶ。誰も使っていないまま maxIdleFrames を過ぎたエントリーを捨てる
+  /// </summary>
+  void BeginFrame();
+
+  /// <summary>
+  /// 全部捨てる（使用中のエントリーがあってはいけない）
+  /// </summary>
+  void Clear();
+
+  /// <summary>
+  /// キーを作る。時刻は sampleRate のフレームに丸める
+  /// </summary>
+  Key MakeKey(uint64_t skeletonKey, const void *clip, float time) const;
+
+  /// <summary>
+  /// 再生中の AnimationClip からキーを作る。AnimationClip はインスタンスごとに作るので、
+  /// 元データ（AnimationLibrary が共有する Animation / CompressedAnimation）をクリップとして使う
+  /// </summary>
+  Key MakeKey(uint64_t skeletonKey, const AnimationClip &clip, float time) const;
+
+  /// <summary>
+  /// キーの丸めた時刻（評価にはこの時刻を使う）
+  /// </summary>
+  float GetKeyTime(const Key &key) const;
+
+  /// <summary>
+  /// キーのエントリーを参照する（参照カウントを増やす）。なければ evaluate(時刻, エントリー) で
+  /// palette（jointCount 個に確保済み）と bounds を書いて作る
+  /// 使い終わったら Release する。返したポインタは Release するまで有効
+  /// </summary>
+  template <typename Evaluate> Entry *Acquire(const Key &key, size_t jointCount, Evaluate &&evaluate);
+
+  /// <summary>
+  /// Acquire したエントリーを返す
+  /// </summary>
+  void Release(Entry *entry);
+
+  /// <summary>
+  /// Skeleton を見分けるキー（Joint の名前・親・初期姿勢と、あれば逆バインド行列から作る）
+  /// 同じモデルのインスタンスは同じ値になる。Skeleton は初期姿勢のまま渡す
+  /// </summary>
+  static uint64_t MakeSkeletonKey(const Skeleton &skeleton, const Matrix4x4 *inverseBindPoseMatrices);
+
+  const Settings &GetSettings() const { return settings_; }
+  size_t GetEntryCount() const { return entries_.size(); }
+  uint64_t GetHitCount() const { return hitCount_; }
+  uint64_t GetMissCount() const { return missCount_; }
+  uint64_t GetEvictionCount() const { return evictionCount_; }
+
+private:
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+
+  Entry *Find(const Key &key);
+  Entry *Insert(const Key &key, size_t jointCount);
+  void Evict(std::unordered_map<Key, std::unique_ptr<Entry>, KeyHash>::iterator it);
+
+  Settings settings_;
+  uint64_t frame_ = 0;
+  // エントリーは unique_ptr で持つ（返したポインタが rehash で動かないように）
+  std::unordered_map<Key, std::unique_ptr<Entry>, KeyHash> entries_;
+  std::vector<std::vector<WellForGPU>> freePalettes_; // 捨てたエントリーのパレット（確保し直さない）
+  uint64_t hitCount_ = 0;
+  uint64_t missCount_ = 0;
+  uint64_t evictionCount_ = 0;
+};
+
+template <typename Evaluate>
+PoseCache::Entry *PoseCache::Acquire(const Key &key, size_t jointCount, Evaluate &&evaluate) {
+  Entry *entry = Find(key);
+  if (entry) {
+    ++hitCount_;
+  } else {
+    ++missCount_;
+    entry = Insert(key, jointCount);
+    evaluate(GetKeyTime(key), *entry);
+  }
+  ++entry->refCount;
+  entry->lastUsedFrame = frame_;
+  return entry;
+}
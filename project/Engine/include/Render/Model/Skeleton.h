@@ -1,16 +1,16 @@
 #pragma once
 #include "Math/MathUtil.h"
 #include "Math/Transform.h"
-#include "Render/Model/Model.h"
+#include "Render/Model/Animation.h"
+#include "Render/Model/AnimationSampler.h"
+#include "Render/Model/CompressedAnimation.h"
+#include "Render/Model/ModelAssetData.h"
 #include <map>
 #include <optional>
 #include <string>
 #include <vector>
 
 struct Joint {
-    QuaternionTransform transform; // Transform情報
-    Matrix4x4 localMatrix; // localMatrix
-    Matrix4x4 skeletonSpaceMatrix; // skeletonSpaceでの変換行列
     std::string name; // 名前
     std::vector<int32_t> children; // 子JointのIndexのリスト。いなければ空
     int32_t index; // 自身のIndex
@@ -21,10 +21,56 @@ struct Skeleton {
     int32_t root; // RootJointのIndex
     std::map<std::string, int32_t> jointMap; // Joint名とIndexとの辞書
     std::vector<Joint> joints; // 所属しているジョイント
+
+    // 毎フレーム書き換える値は Joint ごとではなく連続した配列で持つ（どれも joints と同じ並び）
+    // 親は必ず子より前にあるので、先頭から順に回せば親から子へ伝播できる
+    std::vector<int32_t> parentIndices; // 親JointのIndex。いなければ -1
+    std::vector<QuaternionTransform> transforms; // Transform情報
+    std::vector<Matrix4x4> localMatrices; // localMatrix
+    std::vector<Matrix4x4> skeletonSpaceMatrices; // skeletonSpaceでの変換行列
+};
+
+/// <summary>
+/// アニメーションのチャンネルと Joint の対応
+/// Skeleton とクリップの組ごとに1回だけ作り、毎フレームは名前を引かずにこの配列を回す
+/// （同じモデル・同じクリップのインスタンス同士で共有できる）
+/// </summary>
+struct AnimationBinding {
+    std::vector<int32_t> jointIndices; // チャンネルごとの適用先 Joint
+    std::vector<const NodeAnimation*> nodeAnimations; // Animation から作ったとき（jointIndices と同じ並び）
+    std::vector<uint32_t> nodeIndices; // CompressedAnimation から作ったとき（jointIndices と同じ並び）
+    size_t jointCount = 0; // 作ったときの Skeleton の Joint 数（取り違えの検出用）
 };
 
 void Update(Skeleton& skeleton);
 void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime);
 
-Skeleton CreateSkeleton(const Model::Node& rootNode);
-int32_t CreateJoint(const Model::Node& node, const std::optional<int32_t>& parent, std::vector<Joint>& joints);
+/// <summary>
+/// キーフレームのカーソルを使ってアニメーションを適用する（結果はカーソルなし版と同じ）
+/// </summary>
+/// <param name="cursors">再生しているインスタンスごとに持つ。Joint 数に合わせて自動で確保する</param>
+void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime,
+                    std::vector<NodeAnimationCursor>& cursors);
+
+/// <summary>
+/// 圧縮したアニメーションを適用する（キーの位置から直接引けるのでカーソルは要らない）
+/// </summary>
+void ApplyAnimation(Skeleton& skeleton, const CompressedAnimation& animation, float animationTime);
+
+/// <summary>
+/// チャンネルを Joint の番号に解決しておく。animation は binding より長く生きていること
+/// </summary>
+AnimationBinding BindAnimation(const Skeleton& skeleton, const Animation& animation);
+AnimationBinding BindAnimation(const Skeleton& skeleton, const CompressedAnimation& animation);
+
+/// <summary>
+/// バインド済みのチャンネルだけを回してアニメーションを適用する（結果は名前で引く版と同じ）
+/// </summary>
+/// <param name="cursors">再生しているインスタンスごとに持つ。チャンネル数に合わせて自動で確保する</param>
+void ApplyAnimation(Skeleton& skeleton, const AnimationBinding& binding, float animationTime,
+                    std::vector<NodeAnimationCursor>& cursors);
+void ApplyAnimation(Skeleton& skeleton, const CompressedAnimation& animation,
+                    const AnimationBinding& binding, float animationTime);
+
+Skeleton CreateSkeleton(const ModelAsset::Node& rootNode);
+int32_t CreateJoint(const ModelAsset::Node& node, const std::optional<int32_t>& parent, Skeleton& skeleton);
@@ -6,26 +6,20 @@
 #include <d3d12.h>
 #include "Math/MathUtil.h"
 #include "Render/Model/Model.h"
+#include "Render/Model/Skinning.h"
 
 class Dx12Core;
 class SrvManager;
 struct Skeleton;
 
-// 最大4Jointの影響を受ける
-const uint32_t kNumMaxInfluence = 4;
-
-struct VertexInfluence {
-    std::array<float, kNumMaxInfluence> weights;
-    std::array<int32_t, kNumMaxInfluence> jointIndices;
-};
-
-struct WellForGPU {
-    Matrix4x4 skeletonSpaceMatrix; // 位置用
-    Matrix4x4 skeletonSpaceInverseTransposeMatrix; // 法線用
-};
-
+// Skinning.CS の gSkinningInformation と同じ並び
 struct SkinningInformation {
     uint32_t numVertices;
+    uint32_t influenceCount; // 4 か 8
+    uint32_t weightBits;     // 8 (UNORM8) か 16 (UNORM16)
+    uint32_t indexBits;      // 8 か 16
+    uint32_t weightWords;    // 1頂点の重みが使う uint の数（Joint 番号はその後ろ）
+    uint32_t strideInWords;  // 1頂点分の uint の数
 };
 
 
@@ -33,7 +27,7 @@ struct SkinCluster {
     std::vector<Matrix4x4> inverseBindPoseMatrices;
 
     Microsoft::WRL::ComPtr<ID3D12Resource> influenceResource;
-    std::span<VertexInfluence> mappedInfluence;
+    std::span<uint32_t> mappedInfluence; // PackSkinWeights でパックしたもの（1頂点 strideInWords 個）
     std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE> influenceSrvHandle;
 
     Microsoft::WRL::ComPtr<ID3D12Resource> paletteResource;
@@ -49,5 +43,9 @@ struct SkinCluster {
     Microsoft::WRL::ComPtr<ID3D12Resource> skinningInformationResource;
 };
 
-SkinCluster CreateSkinCluster(Dx12Core* dx12Core, SrvManager* srvManager, const Skeleton& skeleton, Model* model);
+/// <summary>
+/// スキンクラスターの作成。影響は頂点ごとに大きい順の上限個まで残して正規化し、パックして GPU に置く
+/// </summary>
+SkinCluster CreateSkinCluster(Dx12Core* dx12Core, SrvManager* srvManager, const Skeleton& skeleton, Model* model,
+                              const SkinWeightSettings& weightSettings = {});
 void Update(SkinCluster& skinCluster, const Skeleton& skeleton);
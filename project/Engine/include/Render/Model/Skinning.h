@@ -0,0 +1,105 @@
+#pragma once
+#include "Math/Matrix4x4.h"
+#include "Render/Model/ModelAssetData.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 最大4Jointの影響を受ける
+const uint32_t kNumMaxInfluence = 4;
+
+// パックしない形（float の重みと int32 の番号）。CPU での比較用
+struct VertexInfluence {
+  std::array<float, kNumMaxInfluence> weights;
+  std::array<int32_t, kNumMaxInfluence> jointIndices;
+};
+
+// パックした影響で持てる上限（8影響モード）
+const uint32_t kNumMaxPackedInfluence = 8;
+
+/// <summary>
+/// インポートした影響1つ（どの頂点が、どの Joint から、どれだけ影響を受けるか）
+/// </summary>
+struct SkinWeight {
+  uint32_t vertexIndex;
+  uint32_t jointIndex;
+  float weight;
+};
+
+/// <summary>
+/// 影響のパックの設定
+/// </summary>
+struct SkinWeightSettings {
+  uint32_t maxInfluences = 4; // 4 か 8。これを超えた分は小さい方から落として残りを正規化する
+  uint32_t weightBits = 16;   // 8 (UNORM8) か 16 (UNORM16)
+  uint32_t indexBits = 0;     // 8 か 16。0 なら Joint 数から決める（256 以下なら 8）
+};
+
+/// <summary>
+/// Skinning.CS の gInfluences と同じ並びにパックした影響
+/// 1頂点 strideInWords 個の uint で、先に重み、続けて Joint 番号を下位ビットから詰める
+/// 重みは大きい順で、量子化したあとの合計がちょうど 1 になるようにしてある（使わない枠は重み 0）
+/// </summary>
+struct PackedSkinWeights {
+  uint32_t influenceCount = 4;
+  uint32_t weightBits = 16;
+  uint32_t indexBits = 8;
+  uint32_t weightWords = 0;   // 1頂点の重みが使う uint の数（Joint 番号はその後ろから）
+  uint32_t strideInWords = 0; // 1頂点分の uint の数
+  size_t vertexCount = 0;
+  std::vector<uint32_t> words;
+
+  // パックしたときの記録
+  uint32_t maxSourceInfluences = 0;  // 1頂点が元々持っていた影響の最大数
+  uint32_t truncatedVertexCount = 0; // 上限を超えて影響を落とした頂点の数
+  float maxDroppedWeight = 0.0f;     // 落とした重みの、元の合計に対する割合の最大
+
+  /// <summary>
+  /// 1頂点分を戻す（Skinning.CS と同じ計算）。重みが 0 でない影響の数を返す
+  /// </summary>
+  uint32_t Decode(size_t vertex, float *outWeights, uint32_t *outJointIndices) const;
+};
+
+struct WellForGPU {
+  Matrix4x4 skeletonSpaceMatrix;                 // 位置用
+  Matrix4x4 skeletonSpaceInverseTransposeMatrix; // 法線用
+};
+
+/// <summary>
+/// スキニングの CPU 側の計算（パレットの作成と、Skinning.CS と同じ頂点変換）
+/// D3D12 に依存しないので、ツールや GPU の結果の確認にも使える
+/// </summary>
+namespace Skinning {
+
+/// <summary>
+/// パレットを作る。位置用は inverseBindPose * skeletonSpace、
+/// 法線用は位置用の左上3x3の逆転置（余因子を行列式で割って求める。4行4列目以外の平行移動の成分は 0）
+/// </summary>
+/// <param name="outPalette">jointCount 個の書き込み先（Map したアップロード用バッファでもよい。読み戻さない）</param>
+void BuildPalette(const Matrix4x4 *inverseBindPoseMatrices, const Matrix4x4 *skeletonSpaceMatrices,
+                  size_t jointCount, WellForGPU *outPalette);
+
+/// <summary>
+/// 線形ブレンドスキニング。Skinning.CS と同じ計算を CPU で行う
+/// （4つの影響それぞれで変換して重みを掛けて足し、位置の w は 1、法線は正規化する。texcoord はそのまま）
+/// </summary>
+void SkinVertices(const WellForGPU *palette, const ModelAsset::VertexData *inputVertices,
+                  const VertexInfluence *influences, size_t vertexCount,
+                  ModelAsset::VertexData *outVertices);
+
+/// <summary>
+/// 影響を頂点ごとにまとめて大きい順に並べ、上限までを残して正規化し、量子化して詰める
+/// </summary>
+/// <param name="weights">頂点の順番は問わない</param>
+/// <param name="jointCount">Joint 数（番号のビット数を決めるのに使う）</param>
+PackedSkinWeights PackSkinWeights(const SkinWeight *weights, size_t weightCount, size_t vertexCount,
+                                  uint32_t jointCount, const SkinWeightSettings &settings = {});
+
+/// <summary>
+/// パックした影響での線形ブレンドスキニング。Skinning.CS と同じ結果になる（シェーダーは重み 0 の枠を飛ばすが、0 を掛けて足しても変わらない）
+/// </summary>
+void SkinVerticesPacked(const WellForGPU *palette, const ModelAsset::VertexData *inputVertices,
+                        const PackedSkinWeights &influences, ModelAsset::VertexData *outVertices);
+
+} // namespace Skinning
@@ -14,6 +14,7 @@ class Dx12Core;
 class Object3dRenderer;
 
 class ICamera;
+class ICommandRecorder;
 struct SkinCluster;
 
 class Object3d {
@@ -36,10 +37,40 @@ public:
   void Update();
 
   /// <summary>
-  /// 描画
+  /// 描画（インスタンス描画が有効なら Object3dRenderer に登録するだけ）
   /// </summary>
   void Draw();
 
+  /// <summary>
+  /// このオブジェクトの描画を積む（共通のルートパラメータは Object3dRenderer::RecordSharedParameters で積んでおく）
+  /// </summary>
+  void RecordDraw(ICommandRecorder &recorder) const;
+
+  /// <summary>
+  /// オブジェクトごとのルートパラメータ（マテリアル・カメラ・マスク）を積む
+  /// インスタンス描画ではグループの代表のものを使う
+  /// </summary>
+  void RecordObjectParameters(ICommandRecorder &recorder) const;
+
+  /// <summary>
+  /// インスタンス描画の有効/無効。有効にすると、同じモデル・マテリアル・PSO・カメラのものと
+  /// まとめて1回で描かれる（個別に描くものより後になるので、不透明なものに使う）
+  /// </summary>
+  void SetInstancingEnabled(bool enabled) { isInstancingEnabled_ = enabled; }
+  bool IsInstancingEnabled() const { return isInstancingEnabled_; }
+
+  /// <summary>
+  /// 描画キューのレイヤー（0～14。小さいほど先に描く。デプステストなしで描くものは最後のレイヤーになる）
+  /// </summary>
+  void SetRenderLayer(uint32_t layer) { renderLayer_ = layer; }
+  uint32_t GetRenderLayer() const { return renderLayer_; }
+
+  // 色のアルファが 1 未満か（描画キューで奥から描く）。Draw で更新する
+  bool IsTransparent() const { return isTransparent_; }
+
+  // 描画キューの深度（Update で求めたカメラからの距離の2乗）
+  float GetSortDepth() const { return sortDepth_; }
+
 private:
   Object3dRenderer *object3dRenderer_ = nullptr;
 
@@ -63,45 +94,35 @@ public:
   ActorTag tag_ = ActorTag::Untagged;
 
 private:
-  /* 座標変換行列データ
+  /* GPUに送るデータ
   -----------------------------*/
-  // バッファリソース
-  Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource = nullptr;
+  // 座標変換行列（transformation_）・カメラ・マテリアルは CPU 側に持っておき、
+  // 描くたびにフレームのアップロード領域（Dx12Core::GetFrameUploadAllocator）へ書き出す
+  CameraForGPU cameraForGPU_{};
+  Model::Material material_{};
 
-  // バッファリソース内のデータを指すポインタ
-  TransformationMatrix *transformationMatrixData = nullptr;
+  // このフレームに書き出した定数バッファのアドレス
+  uint64_t transformationAddress_ = 0;
+  uint64_t cameraAddress_ = 0;
+  uint64_t materialAddress_ = 0;
 
   /// <summary>
-  /// 座標変換行列データを生成
+  /// マテリアルの初期値を設定
   /// </summary>
-  void CreateTransformationMatrixData();
-
-  /* 鏡面反射用データ
-  -----------------------------*/
-  // バッファリソース
-  Microsoft::WRL::ComPtr<ID3D12Resource> cameraForGPUResource = nullptr;
-
-  // バッファリソース内のデータを指すポインタ
-  CameraForGPU *cameraForGPUData = nullptr;
+  void InitializeMaterial();
 
   /// <summary>
-  /// カメラデータを生成
+  /// 定数データをこのフレームのアップロード領域へ書き出す（描くたびに呼ぶ）
   /// </summary>
-  void CreateCameraForGPUData();
+  /// <param name="includeTransformation">座標変換行列も書き出すか（インスタンス描画ではインスタンスバッファに入れる）</param>
+  void UploadFrameConstants(bool includeTransformation);
 
-  /* マテリアルデータ
-----------------------------*/
+  // インスタンス描画・描画キューのキーにするマテリアル（とマスク）の内容のハッシュ
+  uint64_t materialKey_ = 0;
+  bool materialKeyDirty_ = true;
+  bool isTransparent_ = false;
 
-  // マテリアルバッファリソース
-  Microsoft::WRL::ComPtr<ID3D12Resource> materialResource = nullptr;
-
-  // バッファリソース内のデータを指すポインタ
-  Model::Material *materialData = nullptr;
-
-  /// <summary>
-  /// マテリアルデータを作成
-  /// </summary>
-  void CreateMaterialData();
+  uint64_t GetMaterialKey();
 
 private:
   Transform transform_{
@@ -112,12 +133,14 @@ private:
 
   Animation currentAnimation_;
   float animationTime_ = 0.0f;
+  NodeAnimationCursor animationCursor_; // ルートノードのキーフレームのカーソル
   bool isPlayingAnimation_ = false;
 
 public:
   void PlayAnimation(const Animation& animation) {
       currentAnimation_ = animation;
       animationTime_ = 0.0f;
+      animationCursor_ = {};
       isPlayingAnimation_ = true;
   }
 
@@ -139,39 +162,35 @@ public:
   }
 
   Vector4 GetColor() const {
-    return materialData ? materialData->color : Vector4(1, 1, 1, 1);
+    return material_.color;
   }
 
   void SetColor(const Vector4 &color) {
-    if (materialData) {
-      materialData->color = color;
-    }
+    material_.color = color;
+    materialKeyDirty_ = true;
   }
 
   void SetAlpha(float a) {
-    if (materialData) {
-      materialData->color.w = a;
-    }
+    material_.color.w = a;
+    materialKeyDirty_ = true;
   }
 
   bool GetEnableLighting() const {
-    return materialData ? (materialData->enableLighting != 0) : true;
+    return material_.enableLighting != 0;
   }
 
   void SetEnableLighting(bool enable) {
-    if (materialData) {
-      materialData->enableLighting = enable ? 1 : 0;
-    }
+    material_.enableLighting = enable ? 1 : 0;
+    materialKeyDirty_ = true;
   }
 
   float GetEnvironmentCoefficient() const {
-    return materialData ? materialData->environmentCoefficient : 0.0f;
+    return material_.environmentCoefficient;
   }
 
   void SetEnvironmentCoefficient(float coefficient) {
-    if (materialData) {
-      materialData->environmentCoefficient = coefficient;
-    }
+    material_.environmentCoefficient = coefficient;
+    materialKeyDirty_ = true;
   }
 
   /// <summary>
@@ -179,9 +198,8 @@ public:
   /// </summary>
   /// <param name="enable">trueで有効、falseで無効</param>
   void SetEnableDissolve(bool enable) {
-    if (materialData) {
-      materialData->enableDissolve = enable ? 1 : 0;
-    }
+    material_.enableDissolve = enable ? 1 : 0;
+    materialKeyDirty_ = true;
   }
 
   /// <summary>
@@ -189,9 +207,8 @@ public:
   /// </summary>
   /// <param name="threshold">0.0f（完全表示）～ 1.0f（完全消失）</param>
   void SetDissolveThreshold(float threshold) {
-    if (materialData) {
-      materialData->dissolveThreshold = threshold;
-    }
+    material_.dissolveThreshold = threshold;
+    materialKeyDirty_ = true;
   }
 
   /// <summary>
@@ -199,9 +216,8 @@ public:
   /// </summary>
   /// <param name="range">エッジの太さ（例: 0.05f）</param>
   void SetDissolveEdgeRange(float range) {
-    if (materialData) {
-      materialData->dissolveEdgeRange = range;
-    }
+    material_.dissolveEdgeRange = range;
+    materialKeyDirty_ = true;
   }
 
   /// <summary>
@@ -209,9 +225,8 @@ public:
   /// </summary>
   /// <param name="color">RGBAカラー</param>
   void SetDissolveEdgeColor(const Vector4& color) {
-    if (materialData) {
-      materialData->dissolveEdgeColor = color;
-    }
+    material_.dissolveEdgeColor = color;
+    materialKeyDirty_ = true;
   }
 
   /// <summary>
@@ -225,9 +240,8 @@ public:
   /// </summary>
   /// <param name="transform">UVの移動量（X, Y）</param>
   void SetMaskTransform(const Vector2& transform) {
-    if (materialData) {
-      materialData->maskTransform = transform;
-    }
+    material_.maskTransform = transform;
+    materialKeyDirty_ = true;
   }
 
 private:
@@ -236,13 +250,55 @@ private:
 
 private:
   const ICamera *camera_ = nullptr;
+  const ICamera *drawCamera_ = nullptr; // Update で使ったカメラ（カメラの定数バッファの中身）
+
+  // Update で求めた行列の写し（インスタンス描画で集める）
+  TransformationMatrix transformation_{};
+  bool isInstancingEnabled_ = false;
+
+  uint32_t renderLayer_ = 0;
+  float sortDepth_ = 0.0f;
 
   const Object3d *parent_ = nullptr;
   Matrix4x4 worldMatrix_{};
 
+  // 視錐台カリングの登録番号（Updateで登録、Drawで参照）
+  uint32_t cullIndex_ = 0;
+  uint32_t cullFrame_ = 0;
+  bool isCullRegistered_ = false;
+
+  // LOD の選択（しきい値の前後この割合は今の LOD を保ち、境界でのちらつきを防ぐ）
+  static constexpr float kLodHysteresis = 0.15f;
+  uint32_t lodIndex_ = 0;
+  bool lodEnabled_ = true;
+
 public:
   void SetCamera(const ICamera *camera) { this->camera_ = camera; }
 
+  // 今フレーム描く LOD（0 が元のメッシュ）
+  uint32_t GetLodIndex() const { return lodIndex_; }
+  void SetLodEnabled(bool enabled) { lodEnabled_ = enabled; }
+
   void SetParent(const Object3d *parent) { parent_ = parent; }
   const Matrix4x4& GetWorldMatrix() const { return worldMatrix_; }
+
+  /// <summary>
+  /// アニメーション中の境界（モデル空間）を設定する。モデルのバインドポーズの境界の代わりに使い、スキニングでもカリングする
+  /// スキニングは毎フレーム Update の前に今の姿勢の境界を渡す（SkinnedObject が行う）
+  /// </summary>
+  void SetAnimatedBounds(const AABB &localAABB) {
+    animatedAABB_ = localAABB;
+    hasAnimatedBounds_ = true;
+  }
+  void ClearAnimatedBounds() { hasAnimatedBounds_ = false; }
+
+  // Update で求めたワールド空間の境界（ブロードフェーズや LOD の大きさに使う）
+  const AABB &GetWorldAABB() const { return worldAABB_; }
+  const Sphere &GetWorldSphere() const { return worldSphere_; }
+
+private:
+  AABB animatedAABB_{};
+  bool hasAnimatedBounds_ = false;
+  AABB worldAABB_{};
+  Sphere worldSphere_{};
 };
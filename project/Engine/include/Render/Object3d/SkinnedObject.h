@@ -3,9 +3,13 @@
 #include "Render/Object3d/Object3d.h"
 #include "Render/Model/SkinCluster.h"
 #include "Math/MathUtil.h"
+#include "Model/AnimationBlend.h"
+#include "Model/AnimationSet.h"
+#include "Model/PoseCache.h"
 #include "Model/Skeleton.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 class Object3dRenderer;
 class SrvManager;
@@ -13,7 +17,7 @@ class SrvManager;
 class SkinnedObject {
 public:
     SkinnedObject() = default;
-    ~SkinnedObject() = default;
+    ~SkinnedObject();
 
     /// <summary>
     /// 初期化
@@ -41,15 +45,71 @@ public:
     const Skeleton& GetSkeleton() const { return skeleton_; }
     Model* GetModel() const { return model_.get(); }
 
+    AnimationController& GetAnimationController() { return animationController_; }
+    const AnimationSet* GetAnimationSet() const { return animationSet_; }
+
+    /// <summary>
+    /// 今の姿勢でのスキニング後の境界（モデル空間）。ワールド空間は GetObject3d()->GetWorldAABB()
+    /// </summary>
+    const AABB& GetLocalBounds() const { return localBounds_; }
+
+    /// <summary>
+    /// このモデルの Skeleton にバインドしたクリップを名前で引く（圧縮を使う設定なら圧縮版）。なければ nullptr
+    /// </summary>
+    const AnimationClip* FindClip(const std::string& clipName) const;
+
+    /// <summary>
+    /// ファイル内のクリップを名前で再生する。見つからなければ false
+    /// </summary>
+    bool PlayAnimation(const std::string& clipName, float fadeSeconds = 0.0f, uint32_t layer = 0, bool loop = true);
+
+    /// <summary>
+    /// クリップを再生する（fadeSeconds > 0 ならクロスフェード）。clip はこのモデルの Skeleton にバインドしたもの
+    /// </summary>
+    void PlayAnimation(const AnimationClip& clip, float fadeSeconds = 0.0f, uint32_t layer = 0, bool loop = true);
+
+    /// <summary>
+    /// 圧縮したアニメーションで再生するか（false なら元のキーフレームから。比較用。クリップは頭から再生し直す）
+    /// </summary>
+    void SetUseCompressedAnimation(bool enabled);
+
+    /// <summary>
+    /// 同じモデル・同じクリップのインスタンスとパレットを共有する（nullptr で共有しない）
+    /// 共有するのはレイヤー0のクリップだけを再生しているときだけ。時刻はキャッシュの間隔に丸める
+    /// 共有している間は GetSkeleton の姿勢・行列を更新しない（パレットだけ書く）
+    /// </summary>
+    void SetPoseCache(PoseCache* poseCache);
+
 private:
     Object3dRenderer* object3dRenderer_ = nullptr;
     SrvManager* srvManager_ = nullptr;
     std::unique_ptr<Model> model_ = nullptr;
     std::unique_ptr<Object3d> object3d_ = nullptr;
     
-    Animation animation_;
-    float animationTime_ = 0.0f;
+    const AnimationSet* animationSet_ = nullptr; // AnimationLibrary が持っているファイル内の全クリップ（共有）
+    bool useCompressedAnimation_ = true;
+    std::vector<AnimationClip> animationClips_; // animationSet_ の各クリップを Skeleton にバインドしたもの
+    std::vector<AnimationClip> compressedAnimationClips_; // 圧縮版を Skeleton にバインドしたもの
+    size_t baseClipIndex_ = 0; // レイヤー0で再生しているクリップ（圧縮の切り替えで再生し直す）
+    AnimationController animationController_; // レイヤー・クロスフェードの評価
     
     Skeleton skeleton_;
     SkinCluster skinCluster_;
+
+    PoseCache* poseCache_ = nullptr; // 群衆でパレットを共有するキャッシュ（外で持つ）
+    PoseCache::Entry* poseCacheEntry_ = nullptr; // いまパレットに書いてあるエントリー
+    uint64_t skeletonKey_ = 0; // PoseCache::MakeSkeletonKey の値
+
+    std::vector<int32_t> boundJointIndices_; // Model::GetJointBounds の各 Joint の Skeleton での番号
+    AABB localBounds_{}; // 今の姿勢の境界
+
+    /// <summary>
+    /// 共有しているパレットがあれば返す
+    /// </summary>
+    void ReleasePoseCacheEntry();
+
+    /// <summary>
+    /// PoseCache から姿勢を引いてパレットに書く。共有できないときは false
+    /// </summary>
+    bool UpdatePaletteFromPoseCache();
 };
@@ -0,0 +1,42 @@
+#pragma once
+#include "Renderer/ICommandRecorder.h"
+#include <d3d12.h>
+
+/// <summary>
+/// ICommandRecorder の D3D12 実装。受け取ったコマンドをそのままコマンドリストに積む
+/// コマンドリストは借りるだけ（寿命は呼び出し側が持つ）
+/// </summary>
+class D3D12CommandRecorder : public ICommandRecorder {
+public:
+  explicit D3D12CommandRecorder(ID3D12GraphicsCommandList *commandList) : commandList_(commandList) {}
+
+  void SetRootSignature(RootSignatureHandle rootSignature) override;
+  void SetPipelineState(PipelineHandle pipelineState) override;
+  void SetPrimitiveTopology(PrimitiveTopology topology) override;
+
+  void SetRootConstantBufferView(uint32_t rootIndex, GpuAddress address) override;
+  void SetRootShaderResourceView(uint32_t rootIndex, GpuAddress address) override;
+  void SetRootDescriptorTable(uint32_t rootIndex, DescriptorHandle handle) override;
+
+  void SetVertexBuffer(uint32_t slot, const VertexBufferView &view) override;
+  void SetIndexBuffer(const IndexBufferView &view) override;
+
+  void DrawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+                     uint32_t startInstance) override;
+  void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex,
+                            int32_t baseVertex, uint32_t startInstance) override;
+
+  ID3D12GraphicsCommandList *GetCommandList() const { return commandList_; }
+
+  // D3D12 のビューからの変換
+  static VertexBufferView ToVertexBufferView(const D3D12_VERTEX_BUFFER_VIEW &view) {
+    return {view.BufferLocation, view.SizeInBytes, view.StrideInBytes};
+  }
+  static IndexBufferView ToIndexBufferView(const D3D12_INDEX_BUFFER_VIEW &view) {
+    return {view.BufferLocation, view.SizeInBytes,
+            view.Format == DXGI_FORMAT_R16_UINT ? IndexFormat::UInt16 : IndexFormat::UInt32};
+  }
+
+private:
+  ID3D12GraphicsCommandList *commandList_ = nullptr;
+};
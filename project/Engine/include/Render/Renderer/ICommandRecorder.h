@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// 描画コマンドを積むインターフェース（グラフィックスAPIに依存しない）
+/// D3D12 では D3D12CommandRecorder がコマンドリストに積み、テストでは RecordingCommandRecorder が記録する
+/// 値の型は D3D12 と同じ大きさにしてあるので、D3D12 側はそのまま渡せる
+/// </summary>
+class ICommandRecorder {
+public:
+  using GpuAddress = uint64_t;          // D3D12_GPU_VIRTUAL_ADDRESS
+  using DescriptorHandle = uint64_t;    // D3D12_GPU_DESCRIPTOR_HANDLE::ptr
+  using PipelineHandle = const void *;  // ID3D12PipelineState*
+  using RootSignatureHandle = const void *; // ID3D12RootSignature*
+
+  struct VertexBufferView {
+    GpuAddress location = 0;
+    uint32_t sizeInBytes = 0;
+    uint32_t strideInBytes = 0;
+  };
+
+  enum class IndexFormat : uint8_t {
+    UInt16,
+    UInt32,
+  };
+
+  struct IndexBufferView {
+    GpuAddress location = 0;
+    uint32_t sizeInBytes = 0;
+    IndexFormat format = IndexFormat::UInt32;
+  };
+
+  enum class PrimitiveTopology : uint8_t {
+    TriangleList,
+    LineList,
+  };
+
+  virtual ~ICommandRecorder() = default;
+
+  virtual void SetRootSignature(RootSignatureHandle rootSignature) = 0;
+  virtual void SetPipelineState(PipelineHandle pipelineState) = 0;
+  virtual void SetPrimitiveTopology(PrimitiveTopology topology) = 0;
+
+  // ルートパラメータ
+  virtual void SetRootConstantBufferView(uint32_t rootIndex, GpuAddress address) = 0;
+  virtual void SetRootShaderResourceView(uint32_t rootIndex, GpuAddress address) = 0;
+  virtual void SetRootDescriptorTable(uint32_t rootIndex, DescriptorHandle handle) = 0;
+
+  // 入力アセンブラ
+  virtual void SetVertexBuffer(uint32_t slot, const VertexBufferView &view) = 0;
+  virtual void SetIndexBuffer(const IndexBufferView &view) = 0;
+
+  // 描画
+  virtual void DrawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+                             uint32_t startInstance) = 0;
+  virtual void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex,
+                                    int32_t baseVertex, uint32_t startInstance) = 0;
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include "Math/Matrix4x4.h"
+#include "Renderer/ICommandRecorder.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 同じ（メッシュ, LOD, PSO, マテリアル, カメラ）で描くオブジェクトをまとめ、グループごとに1回のインスタンス描画にする
+/// 使い方: Clear → Add（オブジェクトごと）→ Build → GetInstances を StructuredBuffer に書く → Record
+/// グループの並びは最初に Add された順（描画順をなるべく変えない）
+/// GPU に触れないので、RecordingCommandRecorder と組み合わせてテストできる
+/// </summary>
+class InstanceBatcher {
+public:
+  /// <summary>
+  /// インスタンスごとのデータ（Object3dInstanced.VS.hlsl の StructuredBuffer の要素と同じ並び）
+  /// </summary>
+  struct InstanceData {
+    Matrix4x4 WVP;
+    Matrix4x4 World;
+    Matrix4x4 WorldInverseTranspose;
+  };
+
+  struct Key {
+    const void *mesh = nullptr;                           // 描くメッシュ（Model）
+    uint32_t lodIndex = 0;                                // 描く LOD
+    ICommandRecorder::PipelineHandle pipeline = nullptr;  // PSO
+    uint64_t material = 0;                                // マテリアルの内容のハッシュ（HashBytes）
+    const void *view = nullptr;                           // カメラ
+    bool operator==(const Key &other) const {
+      return mesh == other.mesh && lodIndex == other.lodIndex && pipeline == other.pipeline &&
+             material == other.material && view == other.view;
+    }
+  };
+
+  struct Group {
+    Key key;
+    uint32_t firstInstance = 0;  // GetInstances() の中の先頭
+    uint32_t instanceCount = 0;
+    uint32_t representative = 0; // グループに最初に Add された userData（マテリアルなどはこれのものを使う）
+  };
+
+  /// <summary>
+  /// 登録を捨てる（確保したメモリは残す）
+  /// </summary>
+  void Clear();
+
+  /// <summary>
+  /// インスタンスを登録する
+  /// </summary>
+  /// <param name="userData">呼び出し側の識別子（グループの代表として Group::representative に入る）</param>
+  void Add(const Key &key, const InstanceData &instance, uint32_t userData);
+
+  /// <summary>
+  /// 登録されたインスタンスをグループ順に並べる。Add の後、GetInstances/GetGroups/Record の前に呼ぶ
+  /// </summary>
+  void Build();
+
+  /// <summary>
+  /// グループごとに、インスタンスの StructuredBuffer を設定して drawGroup(recorder, group) を呼ぶ
+  /// PSO は変わるときだけ設定する。drawGroup はメッシュの頂点バッファ等を設定し、
+  /// group.instanceCount 個のインスタンスで描画する（開始インスタンスは 0。バッファの先頭をずらしてある）
+  /// </summary>
+  /// <param name="instanceBuffer">GetInstances() をそのまま書き込んだバッファの GPU アドレス</param>
+  /// <param name="instanceRootIndex">StructuredBuffer のルートパラメータ（ルート SRV）の番号</param>
+  template <typename DrawGroup>
+  void Record(ICommandRecorder &recorder, ICommandRecorder::GpuAddress instanceBuffer,
+              uint32_t instanceRootIndex, DrawGroup &&drawGroup) const;
+
+  // Build 後のインスタンス（グループ順に詰めてある）とグループ
+  const std::vector<InstanceData> &GetInstances() const { return instances_; }
+  const std::vector<Group> &GetGroups() const { return groups_; }
+
+  // 登録されたインスタンスの数
+  size_t GetSubmittedCount() const { return pending_.size(); }
+
+  /// <summary>
+  /// グループの先頭のインスタンスのアドレス（ルート SRV に設定する）
+  /// SV_InstanceID は開始インスタンスを含まないので、グループの先頭はアドレスで渡す
+  /// </summary>
+  static ICommandRecorder::GpuAddress GetInstanceAddress(ICommandRecorder::GpuAddress instanceBuffer,
+                                                         const Group &group) {
+    return instanceBuffer + uint64_t(group.firstInstance) * sizeof(InstanceData);
+  }
+
+  /// <summary>
+  /// バイト列のハッシュ（FNV-1a）。マテリアルのキーを作るのに使う
+  /// </summary>
+  static uint64_t HashBytes(const void *data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+private:
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+
+  struct Pending {
+    InstanceData instance;
+    uint32_t group = 0;
+  };
+
+  std::unordered_map<Key, uint32_t, KeyHash> groupIndices_;
+  std::vector<Pending> pending_;
+  std::vector<InstanceData> instances_;
+  std::vector<Group> groups_;
+  std::vector<uint32_t> cursors_; // Build の作業用
+};
+
+template <typename DrawGroup>
+void InstanceBatcher::Record(ICommandRecorder &recorder, ICommandRecorder::GpuAddress instanceBuffer,
+                             uint32_t instanceRootIndex, DrawGroup &&drawGroup) const {
+  ICommandRecorder::PipelineHandle currentPipeline = nullptr;
+  for (const Group &group : groups_) {
+    if (group.key.pipeline != currentPipeline) {
+      recorder.SetPipelineState(group.key.pipeline);
+      currentPipeline = group.key.pipeline;
+    }
+    recorder.SetRootShaderResourceView(instanceRootIndex, GetInstanceAddress(instanceBuffer, group));
+    drawGroup(recorder, group);
+  }
+}
@@ -1,9 +1,14 @@
 #pragma once
 #include "Core/Dx12Core.h"
+#include "Culling/FrustumCuller.h"
 #include "Math/MathUtil.h"
 #include "Renderer/Fog.h"
+#include "Renderer/InstanceBatcher.h"
+#include "Renderer/RenderQueue.h"
+#include <vector>
 
 class ICamera;
+class Object3d;
 
 class Object3dRenderer {
 
@@ -15,7 +20,12 @@ public:
   void Initialize(Dx12Core *dx12Core);
 
   /// <summary>
-  /// 描画前共通部分処理
+  /// フレーム開始（カリングの登録とインスタンスバッファをやり直す）
+  /// </summary>
+  void BeginFrame();
+
+  /// <summary>
+  /// 描画前共通部分処理（登録済みのインスタンスがあれば先に描く）
   /// </summary>
   void Begin();
 
@@ -24,6 +34,55 @@ public:
   /// </summary>
   void SetDepthEnable(bool enable);
 
+  /// <summary>
+  /// 描画キューに登録する（並べ替えが有効なときの Object3d::Draw）。Flush でソートキーの順に描く
+  /// </summary>
+  /// <param name="object">描くオブジェクト（Flush まで生かしておく）</param>
+  /// <param name="materialKey">マテリアルの内容のハッシュ</param>
+  void SubmitObject(const Object3d *object, uint64_t materialKey);
+
+  /// <summary>
+  /// インスタンス描画に登録する。Flush でキーごとにまとめて1回ずつ描く
+  /// </summary>
+  /// <param name="object">マテリアルなどのルートパラメータを借りるオブジェクト（Flush まで生かしておく）</param>
+  void SubmitInstance(const Object3d *object, const InstanceBatcher::Key &key,
+                      const InstanceBatcher::InstanceData &instance);
+
+  /// <summary>
+  /// 登録済みの描画（キューとインスタンス）をソートキーの順に描く。3D 描画の最後、Begin、
+  /// ほかのレンダラー（パーティクルなど）で描く前に呼ぶ
+  /// </summary>
+  void Flush();
+
+  /// <summary>
+  /// 並べ替えの有効/無効。無効なら Object3d::Draw はその場で積む（インスタンス描画は Flush で描く）
+  /// </summary>
+  void SetSortEnabled(bool enabled) { isSortEnabled_ = enabled; }
+  bool IsSortEnabled() const { return isSortEnabled_; }
+
+  // インスタンス描画に使う、今のデプス設定の PSO
+  ICommandRecorder::PipelineHandle GetInstancedPipelineState() const {
+    return isDepthEnabled_ ? instancedPipelineState_.Get()
+                           : instancedPipelineStateDepthDisabled_.Get();
+  }
+
+  // このフレームの Flush の統計
+  struct RenderStats {
+    uint32_t items = 0;                // キューで並べた描画（インスタンス描画は1グループで1つ）
+    uint32_t instances = 0;            // まとめて描いたオブジェクトの数
+    uint32_t groups = 0;               // インスタンス描画の回数（メッシュのマテリアル範囲ごとにはさらに分かれる）
+    uint32_t rootSignatureChanges = 0; // 通常/インスタンス描画のルートシグネチャの切り替え
+    uint32_t pipelineChanges = 0;      // PSO の切り替え
+    uint32_t materialChanges = 0;      // マテリアルの切り替え（ソートキーで数える）
+  };
+  const RenderStats &GetRenderStats() const { return renderStats_; }
+
+  /// <summary>
+  /// 全オブジェクト共通のルートパラメータ（ライト・環境マップ・フォグ）を積む
+  /// ルートシグネチャを設定し直したら積み直す
+  /// </summary>
+  void RecordSharedParameters(ICommandRecorder &recorder) const;
+
 private:
   Dx12Core *dx12Core_ = nullptr;
 
@@ -40,6 +99,53 @@ private:
   Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipeLineStateDepthDisabled_ = nullptr;
   Microsoft::WRL::ComPtr<ID3D12PipelineState> skinningComputePipelineState_ = nullptr;
 
+  // インスタンス描画用（rootParameter[1] が行列の StructuredBuffer になっている）
+  Microsoft::WRL::ComPtr<ID3D12RootSignature> instancedRootSignature_ = nullptr;
+  Microsoft::WRL::ComPtr<ID3D12PipelineState> instancedPipelineState_ = nullptr;
+  Microsoft::WRL::ComPtr<ID3D12PipelineState> instancedPipelineStateDepthDisabled_ = nullptr;
+
+  bool isDepthEnabled_ = true;
+
+  /* 描画キュー
+  -----------------------------*/
+  // payload の最上位ビットが立っていればインスタンス描画のグループ番号、なければ queuedObjects_ の番号
+  static constexpr uint32_t kGroupPayloadBit = 0x80000000u;
+
+  struct QueuedObject {
+    const Object3d *object = nullptr;
+    ICommandRecorder::PipelineHandle pipeline = nullptr;
+  };
+
+  bool isSortEnabled_ = true;
+  RenderQueue queue_;
+  std::vector<QueuedObject> queuedObjects_;
+  RenderStats renderStats_;
+
+  /// <summary>
+  /// オブジェクトのソートキー（デプスなしの PSO は重ねて描くものとして最後のレイヤーにする）
+  /// </summary>
+  uint64_t MakeSortKey(const Object3d *object, ICommandRecorder::PipelineHandle pipeline,
+                       uint64_t materialKey);
+
+  /* インスタンス描画
+  -----------------------------*/
+  static constexpr uint32_t kMinInstanceCapacity = 256;
+
+  InstanceBatcher batcher_;
+  std::vector<const Object3d *> instancedObjects_; // batcher_ の userData の番号
+
+  // フレームごとに先頭から書き足すアップロードバッファ
+  Microsoft::WRL::ComPtr<ID3D12Resource> instanceResource_ = nullptr;
+  InstanceBatcher::InstanceData *instanceData_ = nullptr;
+  uint32_t instanceCapacity_ = 0;
+  uint32_t instanceCursor_ = 0;
+  std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> retiredInstanceResources_;
+
+  /// <summary>
+  /// インスタンスバッファに count 個書ける場所を用意する
+  /// </summary>
+  void ReserveInstances(uint32_t count);
+
 public:
   ID3D12RootSignature* GetSkinningComputeRootSignature() const { return skinningComputeRootSignature_.Get(); }
   ID3D12PipelineState* GetSkinningComputePipelineState() const { return skinningComputePipelineState_.Get(); }
@@ -62,6 +168,13 @@ public:
   void SetDefaultCamera(const ICamera *camera) { defaultCamera = camera; }
   const ICamera *GetDefaultCamera() const { return defaultCamera; }
 
+private:
+  // デフォルトカメラに対する視錐台カリング
+  FrustumCuller culler_;
+
+public:
+  FrustumCuller *GetCuller() { return &culler_; }
+
 public:
   struct DirectionalLight {
     Vector4 color;     // ライトの色
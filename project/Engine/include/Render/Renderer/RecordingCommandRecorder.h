@@ -0,0 +1,80 @@
+#pragma once
+#include "Renderer/ICommandRecorder.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// 積まれたコマンドを記録するだけの ICommandRecorder（GPU なしでのテスト・計測用）
+/// コマンドの並びと、種類ごとの数・描画数・インスタンス数を数える
+/// </summary>
+class RecordingCommandRecorder : public ICommandRecorder {
+public:
+  enum class Type : uint8_t {
+    SetRootSignature,
+    SetPipelineState,
+    SetPrimitiveTopology,
+    SetRootConstantBufferView,
+    SetRootShaderResourceView,
+    SetRootDescriptorTable,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    DrawInstanced,
+    DrawIndexedInstanced,
+    Count,
+  };
+
+  struct Command {
+    Type type = Type::Count;
+    uint32_t index = 0; // ルートパラメータの番号・頂点バッファのスロット
+    uint64_t value = 0; // アドレス・ハンドル・PSO など（ポインタは整数にして持つ）
+    // 描画の引数（頂点/インデックス数, インスタンス数, 開始頂点/インデックス, ベース頂点, 開始インスタンス）
+    uint32_t count = 0;
+    uint32_t instanceCount = 0;
+    uint32_t start = 0;
+    int32_t baseVertex = 0;
+    uint32_t startInstance = 0;
+  };
+
+  void SetRootSignature(RootSignatureHandle rootSignature) override;
+  void SetPipelineState(PipelineHandle pipelineState) override;
+  void SetPrimitiveTopology(PrimitiveTopology topology) override;
+
+  void SetRootConstantBufferView(uint32_t rootIndex, GpuAddress address) override;
+  void SetRootShaderResourceView(uint32_t rootIndex, GpuAddress address) override;
+  void SetRootDescriptorTable(uint32_t rootIndex, DescriptorHandle handle) override;
+
+  void SetVertexBuffer(uint32_t slot, const VertexBufferView &view) override;
+  void SetIndexBuffer(const IndexBufferView &view) override;
+
+  void DrawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+                     uint32_t startInstance) override;
+  void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex,
+                            int32_t baseVertex, uint32_t startInstance) override;
+
+  /// <summary>
+  /// 記録と集計を捨てる
+  /// </summary>
+  void Clear();
+
+  const std::vector<Command> &GetCommands() const { return commands_; }
+  size_t GetCommandCount() const { return commands_.size(); }
+  size_t Count(Type type) const { return counts_[size_t(type)]; }
+
+  // 描画コマンドの数（DrawInstanced + DrawIndexedInstanced）
+  size_t GetDrawCount() const { return Count(Type::DrawInstanced) + Count(Type::DrawIndexedInstanced); }
+  // ルートパラメータを設定した回数
+  size_t GetRootParameterCount() const {
+    return Count(Type::SetRootConstantBufferView) + Count(Type::SetRootShaderResourceView) +
+           Count(Type::SetRootDescriptorTable);
+  }
+  // 描画したインスタンスの合計
+  uint64_t GetInstanceCount() const { return instanceCount_; }
+
+private:
+  void Push(const Command &command);
+
+  std::vector<Command> commands_;
+  std::array<size_t, size_t(Type::Count)> counts_{};
+  uint64_t instanceCount_ = 0;
+};
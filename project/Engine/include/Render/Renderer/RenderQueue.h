@@ -0,0 +1,96 @@
+#pragma once
+#include "Renderer/ICommandRecorder.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 描画の並べ替えキュー
+/// 登録した描画に 64bit のソートキーを付け、フレームごとに基数ソートしてから積む
+/// キーの並び（上位から）:
+///   不透明: [レイヤー 4][0][PSO 11][マテリアル 24][深度 24]       … 状態の切り替えが少なく、同じ状態の中は手前から
+///   半透明: [レイヤー 4][1][奥からの深度 24][PSO 11][マテリアル 24] … 奥から順（ブレンドの正しさを優先）
+/// 同じキーは登録順のまま（安定ソート）
+/// </summary>
+class RenderQueue {
+public:
+  struct Item {
+    uint64_t key = 0;
+    uint32_t payload = 0; // 呼び出し側の識別子
+  };
+
+  // 並びの中で状態が切り替わる回数
+  struct Stats {
+    uint32_t items = 0;
+    uint32_t layerChanges = 0;
+    uint32_t pipelineChanges = 0;
+    uint32_t materialChanges = 0;
+  };
+
+  static constexpr uint32_t kLayerBits = 4;
+  static constexpr uint32_t kPipelineBits = 11;
+  static constexpr uint32_t kMaterialBits = 24;
+  static constexpr uint32_t kDepthBits = 24;
+  static constexpr uint32_t kMaxLayer = (1u << kLayerBits) - 1;
+  // デプステストなしで重ねて描くもののレイヤー（最後に描く）
+  static constexpr uint32_t kOverlayLayer = kMaxLayer;
+
+  /// <summary>
+  /// 不透明のキー（同じ PSO・マテリアルをまとめ、その中は手前から）
+  /// </summary>
+  /// <param name="pipeline">GetPipelineId の値</param>
+  /// <param name="material">マテリアルのハッシュ（上位ビットを使う。衝突しても並びが少し悪くなるだけ）</param>
+  /// <param name="depth">カメラからの距離（またはその2乗）。0 以上で、大きいほど奥</param>
+  static uint64_t MakeOpaqueKey(uint32_t layer, uint32_t pipeline, uint64_t material, float depth);
+
+  /// <summary>
+  /// 半透明のキー（奥から順。同じ深度なら PSO・マテリアルをまとめる）
+  /// </summary>
+  static uint64_t MakeTransparentKey(uint32_t layer, uint32_t pipeline, uint64_t material, float depth);
+
+  /// <summary>
+  /// 深度を 24bit にする（0 以上の float のビット列は大小の順に並ぶので、上位ビットを使う）
+  /// 負の値・NaN は 0
+  /// </summary>
+  static uint32_t QuantizeDepth(float depth);
+
+  // キーから取り出す
+  static uint32_t GetLayer(uint64_t key) { return uint32_t(key >> 60); }
+  static bool IsTransparent(uint64_t key) { return ((key >> 59) & 1) != 0; }
+  static uint32_t GetPipeline(uint64_t key);
+  static uint32_t GetMaterial(uint64_t key);
+
+  /// <summary>
+  /// PSO を 11bit の番号にする（初めて見た順に振る。キューを作り直すまで変わらない）
+  /// </summary>
+  uint32_t GetPipelineId(ICommandRecorder::PipelineHandle pipeline);
+
+  /// <summary>
+  /// 登録を捨てる（確保したメモリは残す）
+  /// </summary>
+  void Clear() { items_.clear(); }
+
+  void Submit(uint64_t key, uint32_t payload) { items_.push_back({key, payload}); }
+
+  /// <summary>
+  /// キーの昇順に並べる（8bit ずつの LSD 基数ソート。全要素で同じ桁は飛ばす）。並べた後の Stats も求める
+  /// </summary>
+  void Sort();
+
+  const std::vector<Item> &GetItems() const { return items_; }
+  size_t GetItemCount() const { return items_.size(); }
+  const Stats &GetStats() const { return stats_; }
+
+  /// <summary>
+  /// 並びの中で状態が切り替わる回数を数える（並べる前後の比較用）
+  /// </summary>
+  static Stats CountStateChanges(const Item *items, size_t count);
+
+private:
+  std::vector<Item> items_;
+  std::vector<Item> scratch_;
+  std::array<std::array<uint32_t, 256>, 8> histograms_{};
+  std::vector<ICommandRecorder::PipelineHandle> pipelines_;
+  Stats stats_;
+};
@@ -0,0 +1,146 @@
+#pragma once
+#include "Math/Vector2.h"
+#include "Math/Vector4.h"
+#include "Renderer/ICommandRecorder.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// スプライトの四角形を1つの頂点バッファに集め、状態（テクスチャ・ブレンド・エフェクト）が変わるところでだけ描画を分ける
+/// 2D は後に描いたものが上になるので並べ替えない（登録順のまま、続けて同じ状態のものをまとめる）
+/// 使い方: Clear → Add（スプライトごと）→ GetVertices を頂点バッファに書く → Record
+/// GPU に触れないので、RecordingCommandRecorder と組み合わせてテストできる
+/// </summary>
+class SpriteBatch {
+public:
+  /// <summary>
+  /// 頂点（SpriteBatch.VS.hlsl の入力と同じ並び）
+  /// 色・UV・エフェクトのパラメータを頂点に持つので、値が違うだけのスプライトは1回で描ける
+  /// </summary>
+  struct Vertex {
+    Vector4 position;      // クリップ空間（CPU で WVP を掛けておく）
+    Vector2 texcoord;      // uvTransform を掛けた後の UV
+    Vector4 color;
+    Vector4 effectParams0; // UIEffect: time, effectType, splitY, amplitude
+    Vector4 effectParams1; // UIEffect: frequency, speed, blurWidth, boundaryAmp
+  };
+
+  enum class BlendMode : uint32_t {
+    Alpha, // 半透明合成
+    Add,   // 加算
+    kCount,
+  };
+
+  enum class Effect : uint32_t {
+    None,     // SpriteBatch.PS（テクスチャ × 頂点カラー）
+    UIEffect, // UIEffect.PS（波打ちなど）
+    kCount,
+  };
+
+  // 描画を分ける状態（PSO とテクスチャ）
+  struct State {
+    ICommandRecorder::DescriptorHandle texture = 0;
+    BlendMode blendMode = BlendMode::Alpha;
+    Effect effect = Effect::None;
+    bool operator==(const State &other) const {
+      return texture == other.texture && blendMode == other.blendMode && effect == other.effect;
+    }
+    bool operator!=(const State &other) const { return !(*this == other); }
+  };
+
+  struct Batch {
+    State state;
+    uint32_t firstQuad = 0; // GetVertices() の中の先頭の四角形
+    uint32_t quadCount = 0;
+  };
+
+  static constexpr uint32_t kVerticesPerQuad = 4;
+  static constexpr uint32_t kIndicesPerQuad = 6;
+  // 1回の描画の四角形の上限（16bit インデックスで表せる頂点数まで。超えたら描画を分ける）
+  static constexpr uint32_t kMaxQuadsPerDraw = 65536 / kVerticesPerQuad;
+
+  /// <summary>
+  /// 登録を捨てる（確保したメモリは残す）
+  /// </summary>
+  void Clear();
+
+  /// <summary>
+  /// 四角形を登録する。直前と同じ状態なら同じバッチに入る
+  /// </summary>
+  /// <param name="quad">左下・左上・右下・右上の順の4頂点</param>
+  void Add(const State &state, const Vertex (&quad)[kVerticesPerQuad]);
+
+  /// <summary>
+  /// 同じ状態の四角形をまとめて登録する（Text のグリフなど）
+  /// </summary>
+  /// <param name="vertices">quadCount 個分の四角形（それぞれ左下・左上・右下・右上の順）</param>
+  void Add(const State &state, const Vertex *vertices, uint32_t quadCount);
+
+  /// <summary>
+  /// バッチごとに、状態が変わるときだけ PSO とテクスチャを設定して描く
+  /// 頂点・インデックスバッファは最初に1回だけ設定し、ベース頂点で四角形の先頭をずらす
+  /// </summary>
+  /// <param name="vertexBuffer">GetVertices() をそのまま書き込んだバッファの GPU アドレス</param>
+  /// <param name="indexBuffer">WriteIndices で kMaxQuadsPerDraw 個分（以上）を書いたインデックスバッファ</param>
+  /// <param name="textureRootIndex">テクスチャのディスクリプタテーブルのルートパラメータの番号</param>
+  /// <param name="pipelineOf">State から PSO を返す</param>
+  /// <returns>描画コマンドの数</returns>
+  template <typename PipelineOf>
+  uint32_t Record(ICommandRecorder &recorder, ICommandRecorder::GpuAddress vertexBuffer,
+                  const ICommandRecorder::IndexBufferView &indexBuffer, uint32_t textureRootIndex,
+                  PipelineOf &&pipelineOf) const;
+
+  const std::vector<Vertex> &GetVertices() const { return vertices_; }
+  const std::vector<Batch> &GetBatches() const { return batches_; }
+  uint32_t GetQuadCount() const { return uint32_t(vertices_.size() / kVerticesPerQuad); }
+  bool IsEmpty() const { return vertices_.empty(); }
+
+  /// <summary>
+  /// 四角形 quadCount 個分のインデックス（0,1,2 / 1,3,2 の順）を書く
+  /// </summary>
+  static void WriteIndices(uint16_t *indices, uint32_t quadCount);
+
+private:
+  std::vector<Vertex> vertices_;
+  std::vector<Batch> batches_;
+};
+
+template <typename PipelineOf>
+uint32_t SpriteBatch::Record(ICommandRecorder &recorder, ICommandRecorder::GpuAddress vertexBuffer,
+                             const ICommandRecorder::IndexBufferView &indexBuffer, uint32_t textureRootIndex,
+                             PipelineOf &&pipelineOf) const {
+  if (batches_.empty()) {
+    return 0;
+  }
+
+  recorder.SetVertexBuffer(0, {vertexBuffer, uint32_t(vertices_.size() * sizeof(Vertex)), uint32_t(sizeof(Vertex))});
+  recorder.SetIndexBuffer(indexBuffer);
+
+  uint32_t drawCount = 0;
+  ICommandRecorder::PipelineHandle currentPipeline = nullptr;
+  ICommandRecorder::DescriptorHandle currentTexture = 0;
+  bool hasTexture = false;
+  for (const Batch &batch : batches_) {
+    ICommandRecorder::PipelineHandle pipeline = pipelineOf(batch.state);
+    if (pipeline != currentPipeline) {
+      recorder.SetPipelineState(pipeline);
+      currentPipeline = pipeline;
+    }
+    if (!hasTexture || batch.state.texture != currentTexture) {
+      recorder.SetRootDescriptorTable(textureRootIndex, batch.state.texture);
+      currentTexture = batch.state.texture;
+      hasTexture = true;
+    }
+    for (uint32_t offset = 0; offset < batch.quadCount; offset += kMaxQuadsPerDraw) {
+      uint32_t quadCount = batch.quadCount - offset;
+      if (quadCount > kMaxQuadsPerDraw) {
+        quadCount = kMaxQuadsPerDraw;
+      }
+      recorder.DrawIndexedInstanced(quadCount * kIndicesPerQuad, 1, 0,
+                                    int32_t((batch.firstQuad + offset) * kVerticesPerQuad), 0);
+      ++drawCount;
+    }
+  }
+  return drawCount;
+}
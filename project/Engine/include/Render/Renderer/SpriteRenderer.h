@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Dx12Core.h"
+#include "Renderer/SpriteBatch.h"
 
 class SpriteRenderer {
 
@@ -12,14 +13,35 @@ public:
   // Dx12Core *GetDx12Core() const { return dx12Core_; }
 
   /// <summary>
-  /// 通常描画設定
+  /// フレームの最初に呼ぶ（統計のリセット）
   /// </summary>
-  void Begin();
+  void BeginFrame();
 
   /// <summary>
-  /// UIEffect描画設定
+  /// スプライトの四角形をバッチに登録する（描画は Flush でまとめて行う）
   /// </summary>
-  void BeginUIEffect();
+  void Submit(const SpriteBatch::State &state,
+              const SpriteBatch::Vertex (&quad)[SpriteBatch::kVerticesPerQuad]);
+
+  /// <summary>
+  /// 同じ状態の四角形をまとめてバッチに登録する（Text のグリフ）
+  /// </summary>
+  void Submit(const SpriteBatch::State &state, const SpriteBatch::Vertex *vertices,
+              uint32_t quadCount);
+
+  /// <summary>
+  /// 登録済みの四角形を登録順に描く（2D 描画の最後に呼ぶ）
+  /// </summary>
+  void Flush();
+
+  // 1フレーム分の描画の統計
+  struct Stats {
+    uint32_t quadCount = 0;  // 描いた四角形の数
+    uint32_t batchCount = 0; // 状態（テクスチャ・ブレンド・エフェクト）の切り替えで分かれた数
+    uint32_t drawCount = 0;  // 描画コマンドの数
+  };
+
+  const Stats &GetStats() const { return stats_; }
 
 private:
   Dx12Core *dx12Core_ = nullptr;
@@ -32,20 +54,37 @@ private:
 
   ID3D12GraphicsCommandList *commandList_ = nullptr;
 
-  // ルートシグネチャ
-  Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_ = nullptr;
+  /* バッチ描画
+  -----------------------*/
 
-  // PSO
-  Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipeLineState_ = nullptr;
-  Microsoft::WRL::ComPtr<ID3D12PipelineState> uiEffectPipeLineState_ = nullptr;
+  // ルートシグネチャ（テクスチャだけ。ほかは頂点に入っている）
+  Microsoft::WRL::ComPtr<ID3D12RootSignature> batchRootSignature_ = nullptr;
+
+  // ブレンド × エフェクトごとの PSO
+  Microsoft::WRL::ComPtr<ID3D12PipelineState>
+      batchPipelineStates_[size_t(SpriteBatch::BlendMode::kCount)]
+                          [size_t(SpriteBatch::Effect::kCount)];
+
+  // 四角形 kMaxQuadsPerDraw 個分のインデックス（初期化で書いたまま使い回す）
+  Microsoft::WRL::ComPtr<ID3D12Resource> batchIndexResource_ = nullptr;
+  ICommandRecorder::IndexBufferView batchIndexBufferView_{};
+
+  SpriteBatch batch_;
+
+  Stats stats_;
+
+  /// <summary>
+  /// バッチ用ルートシグネチャの生成
+  /// </summary>
+  void CreateBatchRootSignature();
 
   /// <summary>
-  /// ルートシグネチャの生成
+  /// バッチ用PSOの生成
   /// </summary>
-  void CreateSpriteRootSignature();
+  void CreateBatchPSO();
 
   /// <summary>
-  /// PSOの生成
+  /// バッチ用インデックスバッファの生成
   /// </summary>
-  void CreateSpritePSO();
+  void CreateBatchIndexBuffer();
 };
@@ -5,31 +5,20 @@
 #include "Math/Vector2.h"
 #include "Math/Vector3.h"
 #include "Math/Vector4.h"
+#include "Renderer/SpriteBatch.h"
 #include <cassert>
-#include <d3d12.h>
 #include <string>
-#include <wrl.h>
 
 class Dx12Core;
 
 class SpriteRenderer;
 
+/// <summary>
+/// スプライト（GPU のリソースは持たない）
+/// Update で四角形の頂点を CPU で作っておき、Draw で SpriteRenderer のバッチに登録する
+/// </summary>
 class Sprite {
 
-  struct VertexData {
-    Vector4 position;
-    Vector2 texcoord;
-  };
-
-  struct Material {
-    Vector4 color;
-    Matrix4x4 uvTransform;
-  };
-
-  struct TransformationMatrix {
-    Matrix4x4 WVP;
-  };
-
   struct UIEffectParams {
     float time;
     int effectType;
@@ -37,8 +26,8 @@ class Sprite {
     float amplitude;
     float frequency;
     float speed;
-    float padding1;
-    float padding2;
+    float blurWidth;
+    float boundaryAmp;
   };
 
 public:
@@ -54,12 +43,12 @@ public:
   void Update(Transform uvTransform);
 
   /// <summary>
-  /// 描画処理
+  /// 描画処理（バッチに登録する。実際の描画は SpriteRenderer::Flush）
   /// </summary>
   void Draw();
 
   /// <summary>
-  /// UIエフェクト用の描画処理
+  /// UIエフェクト用の描画処理（バッチに登録する）
   /// </summary>
   void DrawUIEffect();
 
@@ -84,60 +73,23 @@ private:
 private:
   /* 頂点データ
   -----------------------*/
+  // Update で WVP と uvTransform を掛けた四角形（左下・左上・右下・右上）
+  // 色とエフェクトのパラメータは Draw のときに入れる
+  SpriteBatch::Vertex vertices_[SpriteBatch::kVerticesPerQuad] = {};
 
-  // バッファリソース
-  Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource = nullptr;
-  Microsoft::WRL::ComPtr<ID3D12Resource> indexResource = nullptr;
-
-  // バッファリソース内のデータを指すポインタ
-  VertexData *vertexData = nullptr;
-  uint32_t *indexData = nullptr;
-
-  // バッファリソースの使い道を補足するバッファビュー
-  D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
-  D3D12_INDEX_BUFFER_VIEW indexBufferView{};
-
-  /* マテリアルデータ
-  ----------------------------*/
-
-  // マテリアルバッファリソース
-  Microsoft::WRL::ComPtr<ID3D12Resource> materialResource = nullptr;
-
-  // バッファリソース内のデータを指すポインタ
-  Material *materialData = nullptr;
-
-  /* 座標変換行列データ
-  -----------------------------*/
-
-  // バッファリソース
-  Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource = nullptr;
-
-  // バッファリソース内のデータを指すポインタ
-  TransformationMatrix *transformationMatrixData = nullptr;
+  Vector4 color_{1.0f, 1.0f, 1.0f, 1.0f};
+  UIEffectParams uiEffectParams_{};
+  SpriteBatch::BlendMode blendMode_ = SpriteBatch::BlendMode::Alpha;
 
   /// <summary>
-  /// 頂点データを作成
+  /// UIEffect のパラメータの初期値を設定
   /// </summary>
-  void CreateVertexData();
+  void InitializeUIEffectParams();
 
   /// <summary>
-  /// マテリアルデータを作成
+  /// 色とエフェクトのパラメータを入れてバッチに登録する（Draw と DrawUIEffect で共通）
   /// </summary>
-  void CreateMaterialData();
-
-  /// <summary>
-  /// 座標変換行列データを生成
-  /// </summary>
-  void CreateTransformationMatrixData();
-
-  /// <summary>
-  /// UIEffectデータを生成
-  /// </summary>
-  void CreateUIEffectParamsData();
-
-  // UIEffectのバッファリソース
-  Microsoft::WRL::ComPtr<ID3D12Resource> uiEffectParamsResource_ = nullptr;
-  UIEffectParams *uiEffectParamsData_ = nullptr;
+  void Submit(SpriteBatch::Effect effect);
 
 private:
   Transform transform_{
@@ -197,18 +149,23 @@ public:
   /// colorのゲッター
   /// </summary>
   /// <param name="rotation"></param>
-  Vector4 GetColor() const {
-    return materialData ? materialData->color : Vector4(1, 1, 1, 1);
-  }
+  Vector4 GetColor() const { return color_; }
 
   /// <summary>
   /// colorのセッター
   /// </summary>
   /// <param name="rotation"></param>
-  void SetColor(const Vector4 &color) {
-    assert(materialData);
-    materialData->color = color;
-  }
+  void SetColor(const Vector4 &color) { color_ = color; }
+
+  /// <summary>
+  /// ブレンドモードのゲッター
+  /// </summary>
+  SpriteBatch::BlendMode GetBlendMode() const { return blendMode_; }
+
+  /// <summary>
+  /// ブレンドモードのセッター（Add は加算合成）
+  /// </summary>
+  void SetBlendMode(SpriteBatch::BlendMode blendMode) { blendMode_ = blendMode; }
 
   ///// <summary>
   ///// sizeのゲッター
@@ -5,43 +5,30 @@
 #include "Math/Vector2.h"
 #include "Math/Vector3.h"
 #include "Math/Vector4.h"
+#include "Render/Text/TextMesh.h"
 #include <cassert>
-#include <d3d12.h>
 #include <string>
-#include <wrl.h>
 
 class Dx12Core;
 class SpriteRenderer;
 
+/// <summary>
+/// 文字列の描画（GPU のリソースは持たない）
+/// グリフの頂点は TextMesh が変わったときだけ作り直し、Draw で SpriteRenderer のバッチに登録する
+/// 同じフォントの Text が続けば、スプライトと同じ頂点バッファに入って1回の描画になる
+/// </summary>
 class Text {
-  struct VertexData {
-    Vector4 position;
-    Vector2 texcoord;
-  };
-
-  struct Material {
-    Vector4 color;
-    Matrix4x4 uvTransform;
-  };
-
-  struct TransformationMatrix {
-    Matrix4x4 WVP;
-  };
-
-  struct UIEffectParams {
-    float time;
-    int effectType;
-    float splitY;
-    float amplitude;
-    float frequency;
-    float speed;
-    float padding1;
-    float padding2;
-  };
-
 public:
   void Initialize(SpriteRenderer *spriteRenderer, const std::string &fontName);
+
+  /// <summary>
+  /// 文字列・フォント・アンカー・Transform・色が変わっていればグリフを作り直す
+  /// </summary>
   void Update();
+
+  /// <summary>
+  /// グリフをバッチに登録する（実際の描画は SpriteRenderer::Flush）
+  /// </summary>
   void Draw();
 
   void SetText(const std::string &text) { text_ = text; }
@@ -63,40 +50,19 @@ public:
   void SetAnchorPoint(const Vector2 &anchor) { anchorPoint_ = anchor; }
   Vector2 GetAnchorPoint() const { return anchorPoint_; }
 
-  Vector2 GetSize() const { return size_; }
+  Vector2 GetSize() const { return mesh_.GetSize(); }
 
   void SetColor(const Vector4 &color) { color_ = color; }
   Vector4 GetColor() const { return color_; }
 
 private:
-  void CreateBuffers();
-  void UpdateVertices();
-
   SpriteRenderer *spriteRenderer_ = nullptr;
   Dx12Core *dx12Core_ = nullptr;
   std::string fontName_;
   std::string text_;
-  Vector2 size_ = {0.0f, 0.0f};
-
-  // 1回の描画でサポートする最大文字数
-  static const int kMaxCharacters = 256;
-
-  Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource = nullptr;
-  Microsoft::WRL::ComPtr<ID3D12Resource> indexResource = nullptr;
-  VertexData *vertexData = nullptr;
-  uint32_t *indexData = nullptr;
-
-  D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
-  D3D12_INDEX_BUFFER_VIEW indexBufferView{};
-
-  Microsoft::WRL::ComPtr<ID3D12Resource> materialResource = nullptr;
-  Material *materialData = nullptr;
-
-  Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource = nullptr;
-  TransformationMatrix *transformationMatrixData = nullptr;
 
-  Microsoft::WRL::ComPtr<ID3D12Resource> uiEffectParamsResource_ = nullptr;
-  UIEffectParams *uiEffectParamsData_ = nullptr;
+  // グリフの頂点（変わったときだけ作り直す）
+  TextMesh mesh_;
 
   Transform transform_{
       {1.0f, 1.0f, 1.0f},
@@ -0,0 +1,84 @@
+#pragma once
+#include "Math/Matrix4x4.h"
+#include "Math/Transform.h"
+#include "Math/Vector2.h"
+#include "Math/Vector4.h"
+#include "Renderer/SpriteBatch.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct FontData;
+
+/// <summary>
+/// 文字列のグリフ（1文字1枚の四角形）を作って持っておく
+/// 文字列・フォント・アンカーが変わったときだけ並べ直し、Transform・色・ビュー射影が変わったときだけ頂点を作り直す
+/// 変わらないフレームは何もしない。GPU に触れないので、FontData を手で作ればテストできる
+/// </summary>
+class TextMesh {
+public:
+  // 作り直した回数（変わらないフレームで増えないことの確認用）
+  struct Stats {
+    uint32_t layoutCount = 0; // グリフを並べ直した回数
+    uint32_t vertexCount = 0; // 頂点を作り直した回数
+  };
+
+  // 並べたグリフ（テキストの左上を原点としたピクセル座標）
+  struct Glyph {
+    Vector2 leftTop;
+    Vector2 rightBottom;
+    Vector2 texLeftTop;
+    Vector2 texRightBottom;
+  };
+
+  /// <summary>
+  /// 文字列をフォントのアトラスで並べる（ASCII 32～127 以外の文字は飛ばす）
+  /// </summary>
+  /// <param name="glyphs">並べたグリフ（前の中身は捨てる）</param>
+  /// <returns>テキストの大きさ（幅, フォントの高さ）</returns>
+  static Vector2 Layout(const FontData &font, const std::string &text, std::vector<Glyph> &glyphs);
+
+  // 値が変わったときだけ作り直しの印を付ける
+  void SetText(const std::string &text);
+  void SetFont(const FontData *font);
+  void SetAnchorPoint(const Vector2 &anchorPoint);
+  void SetTransform(const Transform &transform);
+  void SetColor(const Vector4 &color);
+  void SetViewProjection(const Matrix4x4 &viewProjection);
+
+  /// <summary>
+  /// 印が付いていれば作り直す
+  /// </summary>
+  /// <returns>頂点を作り直したら true</returns>
+  bool Update();
+
+  /// <summary>
+  /// 頂点（グリフごとに左下・左上・右下・右上の4つ、クリップ空間）
+  /// </summary>
+  const std::vector<SpriteBatch::Vertex> &GetVertices() const { return vertices_; }
+  uint32_t GetGlyphCount() const { return uint32_t(glyphs_.size()); }
+  Vector2 GetSize() const { return size_; }
+  bool IsDirty() const { return layoutDirty_ || verticesDirty_; }
+  const Stats &GetStats() const { return stats_; }
+
+private:
+  std::string text_;
+  const FontData *font_ = nullptr;
+  Vector2 anchorPoint_ = {0.0f, 0.0f};
+  Transform transform_{
+      {1.0f, 1.0f, 1.0f},
+      {0.0f, 0.0f, 0.0f},
+      {0.0f, 0.0f, 0.0f},
+  };
+  Vector4 color_ = {1.0f, 1.0f, 1.0f, 1.0f};
+  Matrix4x4 viewProjection_{};
+
+  std::vector<Glyph> glyphs_;
+  std::vector<SpriteBatch::Vertex> vertices_;
+  Vector2 size_ = {0.0f, 0.0f};
+
+  bool layoutDirty_ = true;
+  bool verticesDirty_ = true;
+
+  Stats stats_;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "Core/Dx12Core.h"
 #include "DirectXTex.h"
+#include "Util/AsyncLoader.h"
 #include <d3d12.h>
 #include <string>
 #include <unordered_map>
@@ -35,6 +36,18 @@ public:
   /// <returns>画像イメージデータ</returns>
   void LoadTexture(const std::string &filePath);
 
+  /// <summary>
+  /// テクスチャファイルを非同期で読み込む（デコードはワーカー、GPU 転送は AsyncLoader::Update で行う）
+  /// 読み込み中の GetSrvHandleGPU / GetMetaData は白のプレースホルダーを返す
+  /// </summary>
+  /// <param name="filePath">テクスチャファイルパス</param>
+  LoadHandle LoadTextureAsync(const std::string &filePath);
+
+  /// <summary>
+  /// 非同期で読み込み中か
+  /// </summary>
+  bool IsLoading(const std::string &filePath) const { return pendingTextures_.contains(filePath); }
+
   /// <summary>
   /// メモリ上のピクセルデータからテクスチャを生成・登録する
   /// </summary>
@@ -62,6 +75,19 @@ private:
   // テクスチャデータ
   // std::vector<TextureData> textureDatas;
 
+  // 非同期読み込み中に代わりに使うテクスチャ
+  static constexpr const char *kPlaceholderTexturePath = "resources/white1x1.png";
+
+  /// <summary>
+  /// ファイルを読み込んでミップマップまで作る（GPU を使わないのでワーカースレッドから呼べる）
+  /// </summary>
+  static bool DecodeTextureFile(const std::string &filePath, DirectX::ScratchImage &mipImages);
+
+  /// <summary>
+  /// デコード済みの画像から GPU リソースと SRV を作る（メインスレッド専用）
+  /// </summary>
+  void CreateTexture(const std::string &filePath, const DirectX::ScratchImage &mipImages);
+
   Dx12Core *dx12Core_ = nullptr;
 
   // SRVインデックスの開始番号
@@ -102,5 +128,8 @@ private:
 
   std::unordered_map<std::string, TextureData> textureDatas;
 
+  // 非同期で読み込み中のテクスチャ
+  std::unordered_map<std::string, LoadHandle> pendingTextures_;
+
   std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> intermediateResources_;
 };
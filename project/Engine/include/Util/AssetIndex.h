@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// resources 以下のファイル一覧を1回だけ走査して、ファイル名・相対パスから実パスを引く索引
+/// モデル・テクスチャ・サウンドなど、どのリソースマネージャーからでも使える
+/// </summary>
+class AssetIndex {
+public:
+  static AssetIndex *GetInstance();
+
+  AssetIndex() = default;
+  ~AssetIndex();
+  AssetIndex(const AssetIndex &) = delete;
+  AssetIndex &operator=(const AssetIndex &) = delete;
+
+  /// <summary>
+  /// ルート以下を走査して索引を作り直す
+  /// </summary>
+  /// <param name="root">走査するディレクトリ（既定は resources）</param>
+  void Build(const std::string &root = "resources");
+
+  /// <summary>
+  /// 現在のルートで索引を作り直す（ファイルを追加・削除したとき用）
+  /// </summary>
+  void Refresh();
+
+  /// <summary>
+  /// パスを解決する
+  /// ファイル名だけならルート以下から探し、ルートからの相対パスならルートを付ける
+  /// 見つからなければ入力をそのまま返す。未構築なら最初の呼び出しで構築する
+  /// </summary>
+  /// <param name="input">ファイル名またはパス</param>
+  /// <returns>解決したパス（区切りは '/'）</returns>
+  std::string Resolve(const std::string &input);
+
+  /// <summary>
+  /// 同じファイル名の候補をすべて取得（並びは Resolve が選ぶ順）
+  /// </summary>
+  std::vector<std::string> FindCandidates(const std::string &fileName);
+
+  /// <summary>
+  /// ファイル名が複数の場所に存在するか
+  /// </summary>
+  bool IsAmbiguous(const std::string &fileName);
+
+  /// <summary>
+  /// ルート以下の変更監視を開始する（Windows のみ。それ以外では何もしない）
+  /// </summary>
+  void StartWatching();
+
+  void StopWatching();
+
+  /// <summary>
+  /// 変更通知が来ていれば索引を作り直す。毎フレーム呼んでよい
+  /// </summary>
+  /// <returns>作り直したら true</returns>
+  bool PollChanges();
+
+  const std::string &GetRoot() const { return root_; }
+  bool IsBuilt() const { return isBuilt_; }
+  size_t GetFileCount() const { return fileCount_; }
+
+private:
+  std::string ResolveLocked(const std::string &input) const;
+
+private:
+  std::string root_ = "resources";
+  bool isBuilt_ = false;
+  size_t fileCount_ = 0;
+
+  // ファイル名 -> 実パスの候補（辞書順。先頭を採用する）
+  std::unordered_map<std::string, std::vector<std::string>> byName_;
+  // ルートからの相対パス -> 実パス
+  std::unordered_map<std::string, std::string> byRelativePath_;
+
+  // 非同期ロードなど、別スレッドからの参照に備える
+  mutable std::shared_mutex mutex_;
+
+  // 変更監視ハンドル（Windows の HANDLE）
+  void *watchHandle_ = nullptr;
+};
@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// 読み込み状態
+/// </summary>
+enum class LoadState : uint8_t {
+  Pending, // ワーカーで読み込み・デコード中、またはメインスレッドでの後処理待ち
+  Ready,   // 後処理（GPU 転送など）まで終わって使える
+  Failed,  // 読み込みに失敗した（プレースホルダーのまま）
+};
+
+/// <summary>
+/// 非同期読み込み1件分のハンドル。コピーして持ち回ってよい
+/// </summary>
+class LoadHandle {
+public:
+  LoadHandle() = default;
+
+  bool IsValid() const { return state_ != nullptr; }
+  LoadState GetState() const {
+    return state_ ? state_->state.load(std::memory_order_acquire) : LoadState::Failed;
+  }
+  bool IsReady() const { return GetState() == LoadState::Ready; }
+  bool IsDone() const { return GetState() != LoadState::Pending; }
+  const std::string &GetName() const;
+
+private:
+  friend class AsyncLoader;
+
+  struct State {
+    std::string name;
+    std::atomic<LoadState> state{LoadState::Pending};
+    std::function<void()> work;                    // ワーカースレッドで実行
+    std::function<void(bool succeeded)> finalize; // メインスレッドで実行
+    bool workSucceeded = false;
+  };
+
+  explicit LoadHandle(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+  std::shared_ptr<State> state_;
+};
+
+/// <summary>
+/// ファイル I/O とデコードをワーカースレッドで行い、GPU への転送などの後処理はメインスレッドで行う読み込み器
+/// 後処理は Update / Wait を呼んだメインスレッドで、完了した順に実行される
+/// </summary>
+class AsyncLoader {
+public:
+  static AsyncLoader *GetInstance();
+
+  AsyncLoader() = default;
+  ~AsyncLoader();
+  AsyncLoader(const AsyncLoader &) = delete;
+  AsyncLoader &operator=(const AsyncLoader &) = delete;
+
+  /// <summary>
+  /// ワーカースレッドを起動する。呼んだスレッドをメインスレッドとみなす
+  /// </summary>
+  /// <param name="workerCount">スレッド数（0 ならコア数 - 1、最低 1）</param>
+  void Initialize(uint32_t workerCount = 0);
+
+  /// <summary>
+  /// ワーカースレッドを止める。未処理の読み込みは捨て、後処理も呼ばない
+  /// 後処理が参照するマネージャーより先に呼ぶこと
+  /// </summary>
+  void Shutdown();
+
+  /// <summary>
+  /// 読み込みを登録する。Initialize 前ならその場で work を実行し、後処理だけ Update に回す
+  /// </summary>
+  /// <param name="name">ログ・デバッグ用の名前</param>
+  /// <param name="work">ワーカーで行う処理（ファイル読み込み・デコード）。例外を投げたら失敗扱い</param>
+  /// <param name="finalize">メインスレッドで行う後処理。失敗時も false で呼ばれる</param>
+  LoadHandle Submit(const std::string &name, std::function<void()> work,
+                    std::function<void(bool succeeded)> finalize);
+
+  /// <summary>
+  /// 読み込み済みのものと同じ扱いのハンドル（すでにある資産を返すとき用）
+  /// </summary>
+  static LoadHandle MakeReady(const std::string &name);
+
+  /// <summary>
+  /// デコードが終わったものの後処理を実行する。毎フレームメインスレッドで呼ぶ
+  /// 少なくとも1件は処理し、budgetMs を超えたら残りは次のフレームに回す
+  /// </summary>
+  /// <returns>後処理した件数</returns>
+  uint32_t Update(double budgetMs = 4.0);
+
+  /// <summary>
+  /// 指定の読み込みが終わるまで待つ（待つ間に届いた他の後処理も実行する）。メインスレッド専用
+  /// </summary>
+  void Wait(const LoadHandle &handle);
+
+  /// <summary>
+  /// 登録済みのすべての読み込みが終わるまで待つ。メインスレッド専用
+  /// </summary>
+  void WaitAll();
+
+  /// <summary>
+  /// まだ後処理が終わっていない件数
+  /// </summary>
+  size_t GetPendingCount() const;
+
+  uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+  bool IsMainThread() const { return std::this_thread::get_id() == mainThreadId_; }
+
+private:
+  using StatePtr = std::shared_ptr<LoadHandle::State>;
+
+  void WorkerLoop();
+  static void RunWork(LoadHandle::State &state);
+  void RunFinalize(const StatePtr &state);
+
+private:
+  std::vector<std::thread> workers_;
+  std::thread::id mainThreadId_ = std::this_thread::get_id();
+
+  mutable std::mutex mutex_;
+  std::condition_variable workAvailable_; // ワーカーを起こす
+  std::condition_variable workFinished_;  // Wait 中のメインスレッドを起こす
+  std::deque<StatePtr> workQueue_;        // ワーカー待ち
+  std::deque<StatePtr> finalizeQueue_;    // 後処理待ち
+  size_t pendingCount_ = 0;
+  bool stopping_ = false;
+};
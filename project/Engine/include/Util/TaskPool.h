@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// フレーム内の計算（アニメーションの評価など）を分けて並列に回すためのワーカースレッド
+/// AsyncLoader と違い、投げた処理は ParallelFor の中で全部終わる（呼んだスレッドも手伝う）
+/// </summary>
+class TaskPool {
+public:
+  static TaskPool *GetInstance();
+
+  TaskPool() = default;
+  ~TaskPool();
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  /// <summary>
+  /// ワーカースレッドを起動する
+  /// </summary>
+  /// <param name="workerCount">スレッド数（0 ならコア数 - 1。1コアなら起動せず、呼んだスレッドだけで回す）</param>
+  void Initialize(uint32_t workerCount = 0);
+
+  /// <summary>
+  /// ワーカースレッドを止める
+  /// </summary>
+  void Shutdown();
+
+  /// <summary>
+  /// [0, count) を grainSize 個ずつに分けて body(begin, end) を並列に呼び、全部終わるまで待つ
+  /// 処理の中から呼ばれたとき・ワーカーがないときはその場で順に回す
+  /// </summary>
+  void ParallelFor(size_t count, size_t grainSize,
+                   const std::function<void(size_t begin, size_t end)> &body);
+
+  uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+private:
+  void WorkerLoop();
+  // 分けた範囲を取れるだけ取って回す
+  void RunChunks();
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable workFinished_;
+  bool stopping_ = false;
+  uint64_t generation_ = 0; // ParallelFor ごとに進める（ワーカーが同じ仕事を二度始めないように）
+
+  std::mutex parallelForMutex_; // ParallelFor は一度に1つだけ
+  const std::function<void(size_t, size_t)> *body_ = nullptr;
+  size_t count_ = 0;
+  size_t grainSize_ = 1;
+  std::atomic<size_t> nextIndex_{0};
+  std::atomic<size_t> finishedCount_{0};
+  uint32_t activeWorkers_ = 0; // 今の仕事を回しているワーカーの数
+};
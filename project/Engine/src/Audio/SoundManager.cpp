@@ -1,9 +1,11 @@
 #include "Audio/SoundManager.h"
+#include "Debug/Logger.h"
 #include <Windows.h>
 #include <mfapi.h>
 #include <mfidl.h>
 #include <mfreadwrite.h>
 #include <propvarutil.h>
+#include <unordered_set>
 #include <wrl.h>
 
 #pragma comment(lib, "mfplat.lib")
@@ -190,6 +192,7 @@ void SoundManager::Finalize() {
   assert(!bgmVoice_ && "Finalize(): BGM voice still alive");
   assert(seVoices_.empty() && "Finalize(): SE voices still alive");
 
+  pendingSounds_.clear();
   sounds_.clear();
 
   xAudio2_ = nullptr;
@@ -342,10 +345,52 @@ void SoundManager::Load(const std::string &key, const std::string &filename) {
     return;
   }
 
+  // 非同期で読み込み中なら、それを待つ
+  if (auto pending = pendingSounds_.find(key); pending != pendingSounds_.end()) {
+    AsyncLoader::GetInstance()->Wait(pending->second);
+    return;
+  }
+
   SoundData sd = SoundLoadFile(filename);
   sounds_.emplace(key, std::move(sd));
 }
 
+LoadHandle SoundManager::LoadAsync(const std::string &key, const std::string &filename) {
+  assert(xAudio2_ && "SoundManager::Initialize must be called before LoadAsync().");
+
+  if (auto pending = pendingSounds_.find(key); pending != pendingSounds_.end()) {
+    return pending->second;
+  }
+  if (sounds_.find(key) != sounds_.end()) {
+    return AsyncLoader::MakeReady(key);
+  }
+
+  // デコード（PCM への変換）はワーカーで行い、登録だけメインスレッドで行う
+  auto sd = std::make_shared<SoundData>();
+  LoadHandle handle = AsyncLoader::GetInstance()->Submit(
+      key, [this, filename, sd] { *sd = SoundLoadFile(filename); },
+      [this, key, sd](bool succeeded) {
+        pendingSounds_.erase(key);
+        if (succeeded) {
+          sounds_.emplace(key, std::move(*sd));
+        }
+      });
+  pendingSounds_.emplace(key, handle);
+  return handle;
+}
+
+bool SoundManager::SkipIfLoading(const std::string &key) {
+  if (!pendingSounds_.contains(key)) {
+    return false;
+  }
+  // 読み込み中は鳴らさない（ログは1回だけ）
+  static std::unordered_set<std::string> loggedKeys;
+  if (loggedKeys.insert(key).second) {
+    Logger::Log("[SoundManager] " + key + " is still loading. Skipped playback.\n");
+  }
+  return true;
+}
+
 void SoundManager::Unload(const std::string &key) {
   auto it = sounds_.find(key);
   if (it == sounds_.end()) {
@@ -373,6 +418,10 @@ void SoundManager::PlaySE(const std::string &key) {
   assert(xAudio2_ &&
          "SoundManager::Initialize must be called before PlaySE().");
 
+  if (SkipIfLoading(key)) {
+    return;
+  }
+
   auto it = sounds_.find(key);
   assert(it != sounds_.end() && "Sound key not found. Call Load() first.");
 
@@ -431,6 +480,10 @@ void SoundManager::PlayBGM(const std::string &key) {
   assert(xAudio2_ &&
          "SoundManager::Initialize must be called before PlayBGM().");
 
+  if (SkipIfLoading(key)) {
+    return;
+  }
+
   auto it = sounds_.find(key);
   assert(it != sounds_.end() && "Sound key not found. Call Load() first.");
 
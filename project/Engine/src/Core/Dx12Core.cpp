@@ -175,6 +175,9 @@ void Dx12Core::Initialize(WindowSystem *windowSystem) {
   // フェンスの初期化
   InitializeFence();
 
+  // フレームごとの定数データ用のアロケータの初期化
+  InitializeFrameUploadAllocator();
+
   // ビューポート矩形の初期化
   InitializeViewport();
 
@@ -256,6 +259,9 @@ void Dx12Core::EndFrame() {
   // GPUがここまでたどり着いたときに、Fenceの値を指定した値に代入するようにSignalを送る
   commandQueue->Signal(fence.Get(), fenceValue);
 
+  // このフレームで切り出した定数データは、GPU がこの Signal に着くまで使われる
+  frameUploadAllocator_.EndFrame(fenceValue);
+
   // Fenceの値が指定したSignal値にたどり着いたか確認する
   // GetCompletedValueの初期値はFenceの作成時に渡した初期値
   if (fence->GetCompletedValue() < fenceValue) {
@@ -266,6 +272,9 @@ void Dx12Core::EndFrame() {
     WaitForSingleObject(fenceEvent, INFINITE);
   }
 
+  // 完了したフレームの定数データのページを使い回す
+  frameUploadAllocator_.Reclaim(fence->GetCompletedValue());
+
   // FPS固定
   if (set60FPS) {
     UpdateFixFPS();
@@ -560,6 +569,27 @@ void Dx12Core::InitializeFence() {
   assert(fenceEvent != nullptr);
 }
 
+void Dx12Core::InitializeFrameUploadAllocator() {
+  frameUploadAllocator_.Initialize(
+      LinearUploadAllocator::kDefaultPageSize,
+      [this](size_t size, LinearUploadAllocator::Page &page) {
+        Microsoft::WRL::ComPtr<ID3D12Resource> resource =
+            CreateBufferResource(size);
+
+        // アップロードヒープは Map したままでよい
+        void *mapped = nullptr;
+        HRESULT hr = resource->Map(0, nullptr, &mapped);
+        if (FAILED(hr) || !mapped) {
+          return false;
+        }
+        page.cpu = static_cast<uint8_t *>(mapped);
+        page.gpuAddress = resource->GetGPUVirtualAddress();
+        page.size = size;
+        frameUploadPages_.push_back(resource);
+        return true;
+      });
+}
+
 void Dx12Core::InitializeViewport() {
 
   // クライアント領域のサイズと一緒にして画面全体に表示
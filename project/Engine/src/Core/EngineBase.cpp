@@ -2,11 +2,17 @@
 #include "Audio/SoundManager.h"
 #include "Camera/GameCamera.h"
 #include "Core/WindowSystem.h"
+#include "Model/AnimationLibrary.h"
 #include "Model/ModelManager.h"
 #include "Texture/TextureManager.h"
 #include "Render/Text/FontManager.h"
 #include "Framework/UIManager.h"
+#include "Util/AssetIndex.h"
+#include "Util/AsyncLoader.h"
+#include "Util/TaskPool.h"
+#include <algorithm>
 #include <cassert>
+#include <thread>
 #include <xaudio2.h>
 
 EngineBase::~EngineBase() = default;
@@ -69,6 +75,23 @@ void EngineBase::Initialize() {
   skyboxRenderer_ = std::make_unique<SkyboxRenderer>();
   skyboxRenderer_->Initialize(dx12Core_.get());
 
+  // アセット索引の構築（ファイル名からのパス解決を走査なしで行う）
+  AssetIndex::GetInstance()->Build("resources");
+  AssetIndex::GetInstance()->StartWatching();
+
+  // ワーカースレッドの数をコア数から割り振る（両方を既定のコア数 - 1 で起動するとコア数の約2倍になる）
+  // 読み込みはファイル待ちが多く遅れても困らないので少なめ、残りをフレーム内の計算に回す
+  // メインスレッドも TaskPool の ParallelFor を手伝うので、その分の1コアは空けておく
+  const uint32_t hardware = (std::max)(std::thread::hardware_concurrency(), 1u);
+  const uint32_t loaderWorkers = std::clamp(hardware / 4, 1u, 4u);
+  const uint32_t taskWorkers = hardware > loaderWorkers + 1 ? hardware - 1 - loaderWorkers : 1;
+
+  // 非同期読み込み用のワーカースレッドを起動（呼んだこのスレッドがメインスレッド）
+  AsyncLoader::GetInstance()->Initialize(loaderWorkers);
+
+  // フレーム内の計算（アニメーションの評価など）を分けて回すワーカースレッドを起動
+  TaskPool::GetInstance()->Initialize(taskWorkers);
+
   // テクスチャマネージャーの初期化
   TextureManager::GetInstance()->Initialize(dx12Core_.get(), srvManager_.get());
 
@@ -90,6 +113,10 @@ void EngineBase::Initialize() {
 }
 
 void EngineBase::Finalize() {
+  // 後処理が各マネージャーを参照するので、マネージャーより先に止める
+  AsyncLoader::GetInstance()->Shutdown();
+  TaskPool::GetInstance()->Shutdown();
+
   UIManager::GetInstance()->Finalize();
   FontManager::GetInstance()->Finalize();
 
@@ -100,9 +127,12 @@ void EngineBase::Finalize() {
   ParticleManager::GetInstance()->Finalize();
 
   ModelManager::GetInstance()->Finalize();
+  AnimationLibrary::GetInstance()->Finalize();
 
   TextureManager::GetInstance()->Finalize();
 
+  AssetIndex::GetInstance()->StopWatching();
+
   LineRenderer::GetInstance()->Finalize();
 
   // delete input_;
@@ -155,6 +185,18 @@ void EngineBase::Update() {
 
   // キー入力
   input_->Update();
+
+  // resources 以下でファイルが増減していたら索引を作り直す
+  AssetIndex::GetInstance()->PollChanges();
+
+  // ワーカーで読み終わったアセットの GPU 転送などをまとめて行う
+  AsyncLoader::GetInstance()->Update();
+
+  // カリング用の登録とインスタンスバッファをフレームごとにやり直す
+  object3dRenderer_->BeginFrame();
+
+  // スプライトのバッチと統計をフレームごとにやり直す
+  spriteRenderer_->BeginFrame();
 }
 
 void EngineBase::BeginFrame() {
@@ -173,16 +215,17 @@ void EngineBase::Begin3D() {
 }
 
 void EngineBase::Begin2D() {
-  // Spriteの描画準備。Spriteの描画に共通のグラフィックスコマンドを積む
-  spriteRenderer_->Begin();
+  // Sprite と Text はバッチに登録するだけで、描画の設定は End2D の Flush で積む
 }
 
 void EngineBase::End3D() {
-  // 今は何もしない
+  // 描画キューとインスタンス描画に登録されたものを並べ替えて描く
+  object3dRenderer_->Flush();
 }
 
 void EngineBase::End2D() {
-  // 今は何もしない
+  // バッチに登録されたスプライトを登録順にまとめて描く
+  spriteRenderer_->Flush();
 }
 
 void EngineBase::Run() {
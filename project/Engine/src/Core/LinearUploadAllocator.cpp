@@ -0,0 +1,89 @@
+#include "Core/LinearUploadAllocator.h"
+#include "Debug/Logger.h"
+#include <cassert>
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+} // namespace
+
+void LinearUploadAllocator::Initialize(size_t pageSize, CreatePage createPage) {
+  assert(pageSize > 0 && "LinearUploadAllocator::Initialize: pageSize is 0");
+  assert(createPage && "LinearUploadAllocator::Initialize: createPage is null");
+  pageSize_ = AlignUp(pageSize, kConstantBufferAlignment);
+  createPage_ = std::move(createPage);
+}
+
+LinearUploadAllocator::Allocation LinearUploadAllocator::Allocate(size_t size, size_t alignment) {
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0 &&
+         "LinearUploadAllocator::Allocate: alignment must be a power of two");
+  // 定数バッファは 256 バイト単位で読まれるので、大きさも境界に合わせる
+  size = AlignUp(size == 0 ? 1 : size, alignment);
+
+  size_t offset = AlignUp(offset_, alignment);
+  if (framePages_.empty() || offset + size > pages_[framePages_.back()].size) {
+    if (!AcquirePage(size)) {
+      return {};
+    }
+    offset = 0;
+  }
+
+  const Page &page = pages_[framePages_.back()];
+  Allocation allocation;
+  allocation.cpu = page.cpu + offset;
+  allocation.gpuAddress = page.gpuAddress + offset;
+  allocation.size = size;
+
+  stats_.frameBytes += offset + size - offset_;
+  ++stats_.allocationCount;
+  offset_ = offset + size;
+  return allocation;
+}
+
+bool LinearUploadAllocator::AcquirePage(size_t size) {
+  // 空きページは大きさがまちまち（大きな要求用のページもある）なので、入るものを後ろから探す
+  for (size_t i = freePages_.size(); i-- > 0;) {
+    uint32_t index = freePages_[i];
+    if (pages_[index].size >= size) {
+      freePages_.erase(freePages_.begin() + i);
+      framePages_.push_back(index);
+      offset_ = 0;
+      --stats_.freePageCount;
+      return true;
+    }
+  }
+
+  Page page;
+  const size_t pageSize = size > pageSize_ ? AlignUp(size, kConstantBufferAlignment) : pageSize_;
+  if (!createPage_ || !createPage_(pageSize, page) || !page.cpu || page.size < size) {
+    Logger::Log("[LinearUploadAllocator] failed to create an upload page.\n");
+    assert(false && "LinearUploadAllocator: failed to create an upload page");
+    return false;
+  }
+  pages_.push_back(page);
+  framePages_.push_back(uint32_t(pages_.size() - 1));
+  offset_ = 0;
+  ++stats_.pageCount;
+  return true;
+}
+
+void LinearUploadAllocator::EndFrame(uint64_t fenceValue) {
+  for (uint32_t page : framePages_) {
+    retiredPages_.push_back({fenceValue, page});
+  }
+  stats_.retiredPageCount += uint32_t(framePages_.size());
+  framePages_.clear();
+  offset_ = 0;
+  stats_.allocationCount = 0;
+  stats_.frameBytes = 0;
+}
+
+void LinearUploadAllocator::Reclaim(uint64_t completedFenceValue) {
+  while (!retiredPages_.empty() && retiredPages_.front().fenceValue <= completedFenceValue) {
+    freePages_.push_back(retiredPages_.front().page);
+    retiredPages_.pop_front();
+    --stats_.retiredPageCount;
+    ++stats_.freePageCount;
+  }
+}
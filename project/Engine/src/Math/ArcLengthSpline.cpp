@@ -0,0 +1,279 @@
+#include "Math/ArcLengthSpline.h"
+#include "Math/MathUtil.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 3点のガウス・ルジャンドル積分の節点と重み（区間 [-1, 1]）
+constexpr float kGaussNodes[3] = {-0.774596669f, 0.0f, 0.774596669f};
+constexpr float kGaussWeights[3] = {0.555555556f, 0.888888889f, 0.555555556f};
+
+// 距離→パラメータ変換の補正回数と許容誤差（ワールド単位）
+constexpr int kMaxNewtonIterations = 4;
+constexpr float kDistanceTolerance = 1e-3f;
+
+// 制御点の添字を端でクランプしてセグメントとローカルなtを求める
+void FindSegment(size_t pointCount, float t, int &outIndex, float &outLocalT) {
+  int maxIdx = static_cast<int>(pointCount - 1);
+  float clamped = std::clamp(t, 0.0f, static_cast<float>(maxIdx));
+  int i = static_cast<int>(clamped);
+  if (i >= maxIdx) {
+    // 終端は最後のセグメントの t=1 として扱う
+    outIndex = maxIdx - 1;
+    outLocalT = 1.0f;
+    return;
+  }
+  outIndex = i;
+  outLocalT = clamped - static_cast<float>(i);
+}
+
+// t を含むセグメントの4つの制御点（端はクランプ）とローカルな t
+struct SegmentPoints {
+  const Vector3 *p0;
+  const Vector3 *p1;
+  const Vector3 *p2;
+  const Vector3 *p3;
+  float localT;
+};
+
+SegmentPoints GetSegmentPoints(const std::vector<Vector3> &controlPoints, float t) {
+  int i = 0;
+  SegmentPoints segment{};
+  FindSegment(controlPoints.size(), t, i, segment.localT);
+
+  int maxIdx = static_cast<int>(controlPoints.size() - 1);
+  segment.p0 = &controlPoints[std::max(i - 1, 0)];
+  segment.p1 = &controlPoints[i];
+  segment.p2 = &controlPoints[std::min(i + 1, maxIdx)];
+  segment.p3 = &controlPoints[std::min(i + 2, maxIdx)];
+  return segment;
+}
+
+} // namespace
+
+Vector3 ArcLengthSpline::EvaluatePosition(const std::vector<Vector3> &controlPoints, float t) {
+  if (controlPoints.empty()) {
+    return {0.0f, 0.0f, 0.0f};
+  }
+  if (controlPoints.size() == 1) {
+    return controlPoints[0];
+  }
+
+  SegmentPoints segment = GetSegmentPoints(controlPoints, t);
+  return CatmullRom(*segment.p0, *segment.p1, *segment.p2, *segment.p3, segment.localT);
+}
+
+Vector3 ArcLengthSpline::EvaluateDerivative(const std::vector<Vector3> &controlPoints, float t) {
+  if (controlPoints.size() < 2) {
+    return {0.0f, 0.0f, 0.0f};
+  }
+
+  SegmentPoints segment = GetSegmentPoints(controlPoints, t);
+  return CatmullRomDerivative(*segment.p0, *segment.p1, *segment.p2, *segment.p3, segment.localT);
+}
+
+void ArcLengthSpline::Build(const std::vector<Vector3> &controlPoints,
+                            uint32_t samplesPerSegment, bool bakeFrames) {
+  controlPoints_ = controlPoints;
+  samplesPerSegment_ = std::max(samplesPerSegment, 1u);
+  cumulativeLengths_.clear();
+  frameUps_.clear();
+  distanceParams_.clear();
+  distanceSampleSpacing_ = 0.0f;
+  segmentCubics_.clear();
+
+  if (!IsValid()) {
+    return;
+  }
+
+  // CatmullRom を t について展開しておく
+  segmentCubics_.resize(controlPoints_.size() - 1);
+  for (size_t i = 0; i < segmentCubics_.size(); ++i) {
+    SegmentPoints segment = GetSegmentPoints(controlPoints_, static_cast<float>(i));
+    const Vector3 &p0 = *segment.p0, &p1 = *segment.p1, &p2 = *segment.p2, &p3 = *segment.p3;
+    segmentCubics_[i] = {(-p0 + p1 * 3.0f - p2 * 3.0f + p3) * 0.5f,
+                         (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * 0.5f, (p2 - p0) * 0.5f, p1};
+  }
+
+  // 各サンプル区間の長さを |dP/dt| の積分で求める
+  const uint32_t sampleCount =
+      static_cast<uint32_t>(controlPoints_.size() - 1) * samplesPerSegment_ + 1;
+  const float step = 1.0f / static_cast<float>(samplesPerSegment_);
+  cumulativeLengths_.resize(sampleCount);
+  cumulativeLengths_[0] = 0.0f;
+  for (uint32_t s = 1; s < sampleCount; ++s) {
+    float t0 = static_cast<float>(s - 1) * step;
+    cumulativeLengths_[s] = cumulativeLengths_[s - 1] + IntegrateLength(t0, t0 + step);
+  }
+
+  if (bakeFrames) {
+    BakeFrames();
+  }
+}
+
+float ArcLengthSpline::GetMaxParam() const {
+  return controlPoints_.empty() ? 0.0f : static_cast<float>(controlPoints_.size() - 1);
+}
+
+float ArcLengthSpline::DistanceToParam(float distance) const {
+  if (cumulativeLengths_.size() < 2) {
+    return 0.0f;
+  }
+  if (distance <= 0.0f) {
+    return 0.0f;
+  }
+  if (distance >= GetLength()) {
+    return GetMaxParam();
+  }
+
+  // distance を含むサンプル区間を二分探索する
+  auto it = std::upper_bound(cumulativeLengths_.begin(), cumulativeLengths_.end(), distance);
+  size_t upper = static_cast<size_t>(it - cumulativeLengths_.begin());
+  size_t lower = upper - 1;
+
+  // 区間内は線形補間で初期値を作る
+  const float step = 1.0f / static_cast<float>(samplesPerSegment_);
+  float d0 = cumulativeLengths_[lower];
+  float d1 = cumulativeLengths_[upper];
+  float ratio = (d1 > d0) ? (distance - d0) / (d1 - d0) : 0.0f;
+  float t0 = static_cast<float>(lower) * step;
+  float t = t0 + ratio * step;
+
+  // 区間内でも速さは変わるので、ニュートン法で補正する（通常は1回で収束する）
+  for (int iteration = 0; iteration < kMaxNewtonIterations; ++iteration) {
+    float error = d0 + IntegrateLength(t0, t) - distance;
+    float speed = Length(EvaluateDerivative(controlPoints_, t));
+    if (std::abs(error) <= kDistanceTolerance || speed <= 1e-6f) {
+      break;
+    }
+    t = std::clamp(t - error / speed, t0, t0 + step);
+  }
+  return t;
+}
+
+float ArcLengthSpline::IntegrateLength(float t0, float t1) const {
+  float half = (t1 - t0) * 0.5f;
+  float mid = t0 + half;
+  float length = 0.0f;
+  for (int g = 0; g < 3; ++g) {
+    length += kGaussWeights[g] * Length(EvaluateDerivative(controlPoints_, mid + kGaussNodes[g] * half));
+  }
+  return length * half;
+}
+
+float ArcLengthSpline::ParamToDistance(float t) const {
+  if (cumulativeLengths_.size() < 2) {
+    return 0.0f;
+  }
+
+  float clamped = std::clamp(t, 0.0f, GetMaxParam());
+  float sample = clamped * static_cast<float>(samplesPerSegment_);
+  size_t lower = std::min(static_cast<size_t>(sample), cumulativeLengths_.size() - 2);
+  float t0 = static_cast<float>(lower) / static_cast<float>(samplesPerSegment_);
+  return cumulativeLengths_[lower] + IntegrateLength(t0, clamped);
+}
+
+Vector3 ArcLengthSpline::GetTangent(float t) const {
+  return SafeNormalize(EvaluateDerivative(controlPoints_, t));
+}
+
+void ArcLengthSpline::BakeDistanceSamples(float spacing) {
+  distanceParams_.clear();
+  distanceSampleSpacing_ = 0.0f;
+  if (!IsValid() || spacing <= 0.0f || GetLength() <= 0.0f) {
+    return;
+  }
+
+  // 極端に長いスプラインでもメモリを使いすぎないよう上限を設ける
+  const float kMaxSampleCount = 65536.0f;
+  float intervals = std::min(std::ceil(GetLength() / spacing), kMaxSampleCount - 1.0f);
+  uint32_t sampleCount = static_cast<uint32_t>(intervals) + 1;
+
+  distanceSampleSpacing_ = GetLength() / intervals;
+  distanceParams_.resize(sampleCount);
+  for (uint32_t i = 0; i < sampleCount; ++i) {
+    distanceParams_[i] = DistanceToParam(static_cast<float>(i) * distanceSampleSpacing_);
+  }
+}
+
+ArcLengthSpline::Sample ArcLengthSpline::SampleAtDistance(float distance) const {
+  float t = 0.0f;
+  if (distanceParams_.empty()) {
+    t = DistanceToParam(distance);
+  } else {
+    // サンプル間は速さがほぼ一定なので、パラメータの線形補間で十分に弧長どおりになる
+    // 接線を焼いて補間すると、サンプル間隔より急なカーブで向きが大きくずれる
+    float position = std::clamp(distance, 0.0f, GetLength()) / distanceSampleSpacing_;
+    size_t lower = std::min(static_cast<size_t>(position), distanceParams_.size() - 2);
+    float ratio = position - static_cast<float>(lower);
+    t = distanceParams_[lower] + (distanceParams_[lower + 1] - distanceParams_[lower]) * ratio;
+  }
+  if (segmentCubics_.empty()) {
+    return {EvaluatePosition(controlPoints_, t), {0.0f, 0.0f, 0.0f}};
+  }
+  // 位置と微分は同じセグメントの係数から求める
+  int i = 0;
+  float u = 0.0f;
+  FindSegment(controlPoints_.size(), t, i, u);
+  const Cubic &cubic = segmentCubics_[i];
+  return {((cubic.a * u + cubic.b) * u + cubic.c) * u + cubic.d,
+          SafeNormalize((cubic.a * (3.0f * u) + cubic.b * 2.0f) * u + cubic.c)};
+}
+
+void ArcLengthSpline::BakeFrames() {
+  const size_t sampleCount = cumulativeLengths_.size();
+  const float step = 1.0f / static_cast<float>(samplesPerSegment_);
+  frameUps_.resize(sampleCount);
+
+  // 始点はワールドの上方向から作る（真上を向いている場合は奥方向を使う）
+  Vector3 tangent = GetTangent(0.0f);
+  Vector3 reference = {0.0f, 1.0f, 0.0f};
+  if (std::abs(Dot(tangent, reference)) > 0.99f) {
+    reference = {0.0f, 0.0f, 1.0f};
+  }
+  Vector3 right = SafeNormalize(Cross(reference, tangent));
+  frameUps_[0] = SafeNormalize(Cross(tangent, right));
+
+  // 二重反射法で前のサンプルの上方向をねじれなく運ぶ
+  Vector3 prevPos = GetPosition(0.0f);
+  for (size_t s = 1; s < sampleCount; ++s) {
+    float t = static_cast<float>(s) * step;
+    Vector3 pos = GetPosition(t);
+    Vector3 nextTangent = GetTangent(t);
+
+    Vector3 v1 = pos - prevPos;
+    float c1 = Dot(v1, v1);
+    Vector3 up = frameUps_[s - 1];
+    if (c1 > 1e-12f) {
+      Vector3 upL = up - v1 * (2.0f / c1 * Dot(v1, up));
+      Vector3 tangentL = tangent - v1 * (2.0f / c1 * Dot(v1, tangent));
+      Vector3 v2 = nextTangent - tangentL;
+      float c2 = Dot(v2, v2);
+      up = (c2 > 1e-12f) ? upL - v2 * (2.0f / c2 * Dot(v2, upL)) : upL;
+    }
+    frameUps_[s] = SafeNormalize(up);
+
+    prevPos = pos;
+    tangent = nextTangent;
+  }
+}
+
+ArcLengthSpline::Frame ArcLengthSpline::GetFrameAtDistance(float distance) const {
+  float t = DistanceToParam(distance);
+  Frame frame;
+  frame.forward = GetTangent(t);
+
+  Vector3 up = {0.0f, 1.0f, 0.0f};
+  if (!frameUps_.empty()) {
+    float sample = t * static_cast<float>(samplesPerSegment_);
+    size_t lower = std::min(static_cast<size_t>(sample), frameUps_.size() - 1);
+    size_t upper = std::min(lower + 1, frameUps_.size() - 1);
+    up = Lerp(frameUps_[lower], frameUps_[upper], sample - static_cast<float>(lower));
+  }
+
+  // 補間で崩れた直交性を接線基準で直す
+  frame.right = SafeNormalize(Cross(up, frame.forward));
+  frame.up = Cross(frame.forward, frame.right);
+  return frame;
+}
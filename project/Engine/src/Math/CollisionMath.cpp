@@ -68,4 +68,27 @@ bool IsCollision(const Segment &segment, const Sphere &sphere) {
   return distanceSq <= (sphere.radius * sphere.radius);
 }
 
+bool IsCollision(const Frustum &frustum, const Sphere &sphere) {
+  // どれか1枚の平面で完全に外側なら見えていない
+  for (const Plane &plane : frustum.planes) {
+    if (Dot(plane.normal, sphere.center) + plane.distance < -sphere.radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsCollision(const Frustum &frustum, const AABB &aabb) {
+  for (const Plane &plane : frustum.planes) {
+    // 平面の法線方向に最も進んだ頂点(p-vertex)が外側なら箱全体が外側
+    Vector3 positive = {plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x,
+                        plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y,
+                        plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z};
+    if (Dot(plane.normal, positive) + plane.distance < 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace CollisionMath
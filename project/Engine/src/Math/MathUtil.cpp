@@ -532,6 +532,15 @@ Vector3 TransformNormal(const Vector3 &v, const Matrix4x4 &m) {
   return result;
 }
 
+Vector4 Multiply(const Vector4 &v, const Matrix4x4 &m) {
+  Vector4 result;
+  result.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + v.w * m.m[3][0];
+  result.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + v.w * m.m[3][1];
+  result.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + v.w * m.m[3][2];
+  result.w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + v.w * m.m[3][3];
+  return result;
+}
+
 Vector2 WorldToScreen(const Vector3 &worldPos, const Matrix4x4 &viewProjMatrix,
                       float screenWidth, float screenHeight) {
   //  ViewProjection行列でワールド座標をクリップ空間座標（NDC）へ変換
@@ -568,6 +577,77 @@ Vector2 WorldToScreen(const Vector3 &worldPos, const Matrix4x4 &viewProjMatrix,
   return screenPos;
 }
 
+Frustum MakeFrustum(const Matrix4x4 &viewProjection) {
+  // 行ベクトル形式 (clip = [x y z 1] * VP) なので、VPの各「列」が
+  // クリップ座標の x, y, z, w 成分を作る
+  const Matrix4x4 &m = viewProjection;
+  auto column = [&m](int i) {
+    return Vector4{m.m[0][i], m.m[1][i], m.m[2][i], m.m[3][i]};
+  };
+  Vector4 cx = column(0);
+  Vector4 cy = column(1);
+  Vector4 cz = column(2);
+  Vector4 cw = column(3);
+
+  // -w <= x <= w, -w <= y <= w, 0 <= z <= w (D3D形式の深度範囲)
+  Vector4 raw[6] = {
+      {cw.x + cx.x, cw.y + cx.y, cw.z + cx.z, cw.w + cx.w}, // 左
+      {cw.x - cx.x, cw.y - cx.y, cw.z - cx.z, cw.w - cx.w}, // 右
+      {cw.x + cy.x, cw.y + cy.y, cw.z + cy.z, cw.w + cy.w}, // 下
+      {cw.x - cy.x, cw.y - cy.y, cw.z - cy.z, cw.w - cy.w}, // 上
+      cz,                                                   // 近
+      {cw.x - cz.x, cw.y - cz.y, cw.z - cz.z, cw.w - cz.w}, // 遠
+  };
+
+  Frustum frustum{};
+  for (int i = 0; i < 6; ++i) {
+    // 距離判定にそのまま使えるよう法線の長さで正規化する
+    float length = std::sqrt(raw[i].x * raw[i].x + raw[i].y * raw[i].y +
+                             raw[i].z * raw[i].z);
+    float invLength = (length > 0.0f) ? 1.0f / length : 0.0f;
+    frustum.planes[i].normal = {raw[i].x * invLength, raw[i].y * invLength,
+                                raw[i].z * invLength};
+    frustum.planes[i].distance = raw[i].w * invLength;
+  }
+  return frustum;
+}
+
+Sphere TransformSphere(const Sphere &sphere, const Matrix4x4 &matrix) {
+  const Vector3 &c = sphere.center;
+  Sphere result;
+  result.center = {
+      c.x * matrix.m[0][0] + c.y * matrix.m[1][0] + c.z * matrix.m[2][0] + matrix.m[3][0],
+      c.x * matrix.m[0][1] + c.y * matrix.m[1][1] + c.z * matrix.m[2][1] + matrix.m[3][1],
+      c.x * matrix.m[0][2] + c.y * matrix.m[1][2] + c.z * matrix.m[2][2] + matrix.m[3][2]};
+
+  // 非一様スケールでも球が収まるよう、各基底ベクトルの長さの最大値を使う
+  float scaleSq = 0.0f;
+  for (int row = 0; row < 3; ++row) {
+    Vector3 axis = {matrix.m[row][0], matrix.m[row][1], matrix.m[row][2]};
+    scaleSq = std::max(scaleSq, LengthSq(axis));
+  }
+  result.radius = sphere.radius * std::sqrt(scaleSq);
+  return result;
+}
+
+AABB TransformAABB(const AABB &aabb, const Matrix4x4 &matrix) {
+  const float inMin[3] = {aabb.min.x, aabb.min.y, aabb.min.z};
+  const float inMax[3] = {aabb.max.x, aabb.max.y, aabb.max.z};
+  float outMin[3];
+  float outMax[3];
+  for (int column = 0; column < 3; ++column) {
+    // 平行移動から始め、入力の各軸が出力のこの軸に与える寄与の小さいほう・大きいほうを足す
+    outMin[column] = outMax[column] = matrix.m[3][column];
+    for (int row = 0; row < 3; ++row) {
+      float a = matrix.m[row][column] * inMin[row];
+      float b = matrix.m[row][column] * inMax[row];
+      outMin[column] += std::min(a, b);
+      outMax[column] += std::max(a, b);
+    }
+  }
+  return {{outMin[0], outMin[1], outMin[2]}, {outMax[0], outMax[1], outMax[2]}};
+}
+
 Matrix4x4 Transpose(Matrix4x4 matrix) {
   Matrix4x4 result{};
 
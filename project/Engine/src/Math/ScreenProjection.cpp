@@ -0,0 +1,144 @@
+#include "Math/ScreenProjection.h"
+#include <cassert>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SCREEN_PROJECTION_USE_SSE
+#endif
+
+namespace {
+
+// カメラの後ろにある点の出力先（WorldToScreen と合わせる）
+constexpr float kBehindCamera = -10000.0f;
+
+void ProjectOne(const Vector3 &p, const Matrix4x4 &m, const Viewport &viewport,
+                Vector2 &outScreen, float *outDepth, uint8_t *outOnScreen) {
+  float x = p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0];
+  float y = p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1];
+  float z = p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2];
+  float w = p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3];
+
+  if (w <= 0.0f) {
+    outScreen = {kBehindCamera, kBehindCamera};
+    if (outDepth) {
+      *outDepth = -1.0f;
+    }
+    if (outOnScreen) {
+      *outOnScreen = 0;
+    }
+    return;
+  }
+
+  float invW = 1.0f / w;
+  x *= invW;
+  y *= invW;
+  z *= invW;
+
+  outScreen.x = viewport.left + (x + 1.0f) * 0.5f * viewport.width;
+  outScreen.y = viewport.top + (1.0f - y) * 0.5f * viewport.height;
+  if (outDepth) {
+    *outDepth = z;
+  }
+  if (outOnScreen) {
+    *outOnScreen = (x >= -1.0f && x <= 1.0f && y >= -1.0f && y <= 1.0f && z >= 0.0f &&
+                    z <= 1.0f)
+                       ? 1
+                       : 0;
+  }
+}
+
+} // namespace
+
+void WorldToScreenBatch(std::span<const Vector3> worldPositions, const Matrix4x4 &viewProjection,
+                        const Viewport &viewport, std::span<Vector2> outScreen,
+                        std::span<float> outDepth, std::span<uint8_t> outOnScreen) {
+  const size_t count = worldPositions.size();
+  assert(outScreen.size() >= count);
+  assert(outDepth.empty() || outDepth.size() >= count);
+  assert(outOnScreen.empty() || outOnScreen.size() >= count);
+
+  const bool writeDepth = !outDepth.empty();
+  const bool writeOnScreen = !outOnScreen.empty();
+  const Matrix4x4 &m = viewProjection;
+  size_t i = 0;
+
+#ifdef SCREEN_PROJECTION_USE_SSE
+  // 行列の各要素をレーンに展開しておく
+  __m128 m00 = _mm_set1_ps(m.m[0][0]), m10 = _mm_set1_ps(m.m[1][0]);
+  __m128 m20 = _mm_set1_ps(m.m[2][0]), m30 = _mm_set1_ps(m.m[3][0]);
+  __m128 m01 = _mm_set1_ps(m.m[0][1]), m11 = _mm_set1_ps(m.m[1][1]);
+  __m128 m21 = _mm_set1_ps(m.m[2][1]), m31 = _mm_set1_ps(m.m[3][1]);
+  __m128 m02 = _mm_set1_ps(m.m[0][2]), m12 = _mm_set1_ps(m.m[1][2]);
+  __m128 m22 = _mm_set1_ps(m.m[2][2]), m32 = _mm_set1_ps(m.m[3][2]);
+  __m128 m03 = _mm_set1_ps(m.m[0][3]), m13 = _mm_set1_ps(m.m[1][3]);
+  __m128 m23 = _mm_set1_ps(m.m[2][3]), m33 = _mm_set1_ps(m.m[3][3]);
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 minusOne = _mm_set1_ps(-1.0f);
+  const __m128 halfWidth = _mm_set1_ps(viewport.width * 0.5f);
+  const __m128 halfHeight = _mm_set1_ps(viewport.height * 0.5f);
+  const __m128 left = _mm_set1_ps(viewport.left);
+  const __m128 top = _mm_set1_ps(viewport.top);
+  const __m128 behind = _mm_set1_ps(kBehindCamera);
+
+  for (; i + 4 <= count; i += 4) {
+    const Vector3 *p = worldPositions.data() + i;
+    __m128 px = _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x);
+    __m128 py = _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y);
+    __m128 pz = _mm_setr_ps(p[0].z, p[1].z, p[2].z, p[3].z);
+
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m00), _mm_mul_ps(py, m10)),
+                          _mm_add_ps(_mm_mul_ps(pz, m20), m30));
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m01), _mm_mul_ps(py, m11)),
+                          _mm_add_ps(_mm_mul_ps(pz, m21), m31));
+    __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m02), _mm_mul_ps(py, m12)),
+                          _mm_add_ps(_mm_mul_ps(pz, m22), m32));
+    __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m03), _mm_mul_ps(py, m13)),
+                          _mm_add_ps(_mm_mul_ps(pz, m23), m33));
+
+    // w <= 0 のレーンは除算結果を使わないので、0除算を避けるため 1 に差し替える
+    __m128 front = _mm_cmpgt_ps(w, zero);
+    __m128 safeW = _mm_or_ps(_mm_and_ps(front, w), _mm_andnot_ps(front, one));
+    __m128 invW = _mm_div_ps(one, safeW);
+    x = _mm_mul_ps(x, invW);
+    y = _mm_mul_ps(y, invW);
+    z = _mm_mul_ps(z, invW);
+
+    __m128 sx = _mm_add_ps(left, _mm_mul_ps(_mm_add_ps(x, one), halfWidth));
+    __m128 sy = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(one, y), halfHeight));
+    sx = _mm_or_ps(_mm_and_ps(front, sx), _mm_andnot_ps(front, behind));
+    sy = _mm_or_ps(_mm_and_ps(front, sy), _mm_andnot_ps(front, behind));
+
+    // Vector2 の並び (x0 y0 x1 y1 ...) に戻して書き込む
+    float *dst = &outScreen[i].x;
+    _mm_storeu_ps(dst, _mm_unpacklo_ps(sx, sy));
+    _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(sx, sy));
+
+    if (writeDepth) {
+      __m128 depth = _mm_or_ps(_mm_and_ps(front, z), _mm_andnot_ps(front, minusOne));
+      _mm_storeu_ps(&outDepth[i], depth);
+    }
+    if (writeOnScreen) {
+      __m128 inside = front;
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(x, minusOne));
+      inside = _mm_and_ps(inside, _mm_cmple_ps(x, one));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(y, minusOne));
+      inside = _mm_and_ps(inside, _mm_cmple_ps(y, one));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(z, zero));
+      inside = _mm_and_ps(inside, _mm_cmple_ps(z, one));
+      int mask = _mm_movemask_ps(inside);
+      outOnScreen[i + 0] = static_cast<uint8_t>((mask >> 0) & 1);
+      outOnScreen[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+      outOnScreen[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+      outOnScreen[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+    }
+  }
+#endif
+
+  // 端数（SSE が無い場合は全件）
+  for (; i < count; ++i) {
+    ProjectOne(worldPositions[i], m, viewport, outScreen[i],
+               writeDepth ? &outDepth[i] : nullptr, writeOnScreen ? &outOnScreen[i] : nullptr);
+  }
+}
@@ -0,0 +1,102 @@
+#include "Culling/FrustumCuller.h"
+#include "Math/CollisionMath.h"
+#include "Math/MathUtil.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FRUSTUM_CULLER_USE_SSE
+#endif
+
+void FrustumCuller::BeginFrame() {
+  centerX_.clear();
+  centerY_.clear();
+  centerZ_.clear();
+  radius_.clear();
+  culledSize_ = 0;
+
+  // 番号だけで前フレームの登録と区別できるようにする
+  ++frame_;
+}
+
+uint32_t FrustumCuller::Submit(const Sphere &worldSphere) {
+  uint32_t index = static_cast<uint32_t>(radius_.size());
+  centerX_.push_back(worldSphere.center.x);
+  centerY_.push_back(worldSphere.center.y);
+  centerZ_.push_back(worldSphere.center.z);
+  radius_.push_back(worldSphere.radius);
+  return index;
+}
+
+void FrustumCuller::Cull(const Matrix4x4 &viewProjection) {
+  frustum_ = MakeFrustum(viewProjection);
+
+  uint32_t count = static_cast<uint32_t>(radius_.size());
+  visible_.resize(count);
+  CullSpheres(frustum_, centerX_.data(), centerY_.data(), centerZ_.data(), radius_.data(),
+              count, visible_.data());
+  culledSize_ = count;
+
+  // 統計
+  uint32_t visibleCount = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    visibleCount += visible_[i];
+  }
+  submittedCount_ = count;
+  visibleCount_ = isEnabled_ ? visibleCount : count;
+  culledCount_ = count - visibleCount_;
+}
+
+bool FrustumCuller::IsVisible(uint32_t index, uint32_t frame) const {
+  if (!isEnabled_ || frame != frame_ || index >= culledSize_) {
+    return true;
+  }
+  return visible_[index] != 0;
+}
+
+void FrustumCuller::CullSpheres(const Frustum &frustum, const float *centerX,
+                                const float *centerY, const float *centerZ,
+                                const float *radius, uint32_t count, uint8_t *outVisible) {
+  uint32_t i = 0;
+
+#ifdef FRUSTUM_CULLER_USE_SSE
+  // 平面ごとの係数をレーンに展開しておく
+  __m128 planeX[6];
+  __m128 planeY[6];
+  __m128 planeZ[6];
+  __m128 planeD[6];
+  for (int p = 0; p < 6; ++p) {
+    planeX[p] = _mm_set1_ps(frustum.planes[p].normal.x);
+    planeY[p] = _mm_set1_ps(frustum.planes[p].normal.y);
+    planeZ[p] = _mm_set1_ps(frustum.planes[p].normal.z);
+    planeD[p] = _mm_set1_ps(frustum.planes[p].distance);
+  }
+
+  for (; i + 4 <= count; i += 4) {
+    __m128 x = _mm_loadu_ps(centerX + i);
+    __m128 y = _mm_loadu_ps(centerY + i);
+    __m128 z = _mm_loadu_ps(centerZ + i);
+    __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+
+    // 6平面すべてで dot(n, c) + d >= -r なら見えている
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int p = 0; p < 6; ++p) {
+      __m128 distance = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+          _mm_add_ps(_mm_mul_ps(planeZ[p], z), planeD[p]));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+    }
+
+    int mask = _mm_movemask_ps(inside);
+    outVisible[i + 0] = static_cast<uint8_t>((mask >> 0) & 1);
+    outVisible[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+    outVisible[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+    outVisible[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+  }
+#endif
+
+  // 端数（SSE が無い場合は全件）はスカラーで判定する
+  for (; i < count; ++i) {
+    Sphere sphere{{centerX[i], centerY[i], centerZ[i]}, radius[i]};
+    outVisible[i] = CollisionMath::IsCollision(frustum, sphere) ? 1 : 0;
+  }
+}
@@ -0,0 +1,633 @@
+#include "Render/Model/AnimationBlend.h"
+#include "Math/MathUtil.h"
+#include "Util/TaskPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ANIMATION_BLEND_USE_SSE
+#endif
+
+namespace {
+
+constexpr size_t kLaneCount = 4;
+
+size_t PaddedCount(size_t count) { return (count + kLaneCount - 1) / kLaneCount * kLaneCount; }
+
+float LoopTime(float time, float duration, bool loop) {
+  if (duration <= 0.0f) {
+    return 0.0f;
+  }
+  if (loop) {
+    time = std::fmod(time, duration);
+    return time < 0.0f ? time + duration : time;
+  }
+  return std::clamp(time, 0.0f, duration);
+}
+
+#ifndef ANIMATION_BLEND_USE_SSE
+
+// 1 Joint 分の計算（SSE がないとき）
+struct JointValue {
+  float tx, ty, tz;
+  float rx, ry, rz, rw;
+  float sx, sy, sz;
+};
+
+JointValue Load(const PoseBuffer &pose, size_t i) {
+  return {pose.translateX[i], pose.translateY[i], pose.translateZ[i], pose.rotateX[i], pose.rotateY[i],
+          pose.rotateZ[i],    pose.rotateW[i],    pose.scaleX[i],     pose.scaleY[i],  pose.scaleZ[i]};
+}
+
+void Store(PoseBuffer &pose, size_t i, const JointValue &v) {
+  pose.translateX[i] = v.tx;
+  pose.translateY[i] = v.ty;
+  pose.translateZ[i] = v.tz;
+  pose.rotateX[i] = v.rx;
+  pose.rotateY[i] = v.ry;
+  pose.rotateZ[i] = v.rz;
+  pose.rotateW[i] = v.rw;
+  pose.scaleX[i] = v.sx;
+  pose.scaleY[i] = v.sy;
+  pose.scaleZ[i] = v.sz;
+}
+
+void NormalizeRotation(JointValue &v) {
+  float inverseLength = 1.0f / std::sqrt(v.rx * v.rx + v.ry * v.ry + v.rz * v.rz + v.rw * v.rw);
+  v.rx *= inverseLength;
+  v.ry *= inverseLength;
+  v.rz *= inverseLength;
+  v.rw *= inverseLength;
+}
+
+JointValue BlendJoint(const JointValue &a, JointValue b, float w) {
+  // 近い側を通るように向きを揃える
+  if (a.rx * b.rx + a.ry * b.ry + a.rz * b.rz + a.rw * b.rw < 0.0f) {
+    b.rx = -b.rx;
+    b.ry = -b.ry;
+    b.rz = -b.rz;
+    b.rw = -b.rw;
+  }
+  JointValue r{Lerp(a.tx, b.tx, w), Lerp(a.ty, b.ty, w), Lerp(a.tz, b.tz, w),
+               Lerp(a.rx, b.rx, w), Lerp(a.ry, b.ry, w), Lerp(a.rz, b.rz, w), Lerp(a.rw, b.rw, w),
+               Lerp(a.sx, b.sx, w), Lerp(a.sy, b.sy, w), Lerp(a.sz, b.sz, w)};
+  NormalizeRotation(r);
+  return r;
+}
+
+// a * b（ハミルトン積）
+void MultiplyRotation(float ax, float ay, float az, float aw, float bx, float by, float bz, float bw,
+                      JointValue &out) {
+  out.rx = aw * bx + ax * bw + ay * bz - az * by;
+  out.ry = aw * by - ax * bz + ay * bw + az * bx;
+  out.rz = aw * bz + ax * by - ay * bx + az * bw;
+  out.rw = aw * bw - ax * bx - ay * by - az * bz;
+}
+
+float SafeDivide(float a, float b) { return b != 0.0f ? a / b : a; }
+
+#else
+
+struct Lanes {
+  __m128 tx, ty, tz;
+  __m128 rx, ry, rz, rw;
+  __m128 sx, sy, sz;
+};
+
+Lanes LoadLanes(const PoseBuffer &pose, size_t i) {
+  return {_mm_loadu_ps(&pose.translateX[i]), _mm_loadu_ps(&pose.translateY[i]),
+          _mm_loadu_ps(&pose.translateZ[i]), _mm_loadu_ps(&pose.rotateX[i]),
+          _mm_loadu_ps(&pose.rotateY[i]),    _mm_loadu_ps(&pose.rotateZ[i]),
+          _mm_loadu_ps(&pose.rotateW[i]),    _mm_loadu_ps(&pose.scaleX[i]),
+          _mm_loadu_ps(&pose.scaleY[i]),     _mm_loadu_ps(&pose.scaleZ[i])};
+}
+
+void StoreLanes(PoseBuffer &pose, size_t i, const Lanes &v) {
+  _mm_storeu_ps(&pose.translateX[i], v.tx);
+  _mm_storeu_ps(&pose.translateY[i], v.ty);
+  _mm_storeu_ps(&pose.translateZ[i], v.tz);
+  _mm_storeu_ps(&pose.rotateX[i], v.rx);
+  _mm_storeu_ps(&pose.rotateY[i], v.ry);
+  _mm_storeu_ps(&pose.rotateZ[i], v.rz);
+  _mm_storeu_ps(&pose.rotateW[i], v.rw);
+  _mm_storeu_ps(&pose.scaleX[i], v.sx);
+  _mm_storeu_ps(&pose.scaleY[i], v.sy);
+  _mm_storeu_ps(&pose.scaleZ[i], v.sz);
+}
+
+__m128 Lerp(__m128 a, __m128 b, __m128 t) { return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)); }
+
+__m128 Dot4(__m128 ax, __m128 ay, __m128 az, __m128 aw, __m128 bx, __m128 by, __m128 bz, __m128 bw) {
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                    _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+}
+
+void NormalizeRotation(Lanes &v) {
+  __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(Dot4(v.rx, v.ry, v.rz, v.rw, v.rx, v.ry, v.rz, v.rw)));
+  v.rx = _mm_mul_ps(v.rx, inverseLength);
+  v.ry = _mm_mul_ps(v.ry, inverseLength);
+  v.rz = _mm_mul_ps(v.rz, inverseLength);
+  v.rw = _mm_mul_ps(v.rw, inverseLength);
+}
+
+// 負のレーンだけ符号を反転するマスク
+__m128 NegativeSignMask(__m128 value) {
+  return _mm_and_ps(_mm_cmplt_ps(value, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+}
+
+__m128 Weights(float weight, const float *jointWeights, size_t i) {
+  __m128 w = _mm_set1_ps(weight);
+  return jointWeights ? _mm_mul_ps(w, _mm_loadu_ps(jointWeights + i)) : w;
+}
+
+#endif
+
+} // namespace
+
+//=========================
+// PoseBuffer
+//=========================
+void PoseBuffer::Resize(size_t count) {
+  const size_t padded = PaddedCount(count);
+  // 増えた分と余りは単位の姿勢
+  translateX.resize(padded, 0.0f);
+  translateY.resize(padded, 0.0f);
+  translateZ.resize(padded, 0.0f);
+  rotateX.resize(padded, 0.0f);
+  rotateY.resize(padded, 0.0f);
+  rotateZ.resize(padded, 0.0f);
+  rotateW.resize(padded, 1.0f);
+  scaleX.resize(padded, 1.0f);
+  scaleY.resize(padded, 1.0f);
+  scaleZ.resize(padded, 1.0f);
+  jointCount = count;
+}
+
+void PoseBuffer::SetJoint(size_t joint, const QuaternionTransform &transform) {
+  translateX[joint] = transform.translate.x;
+  translateY[joint] = transform.translate.y;
+  translateZ[joint] = transform.translate.z;
+  rotateX[joint] = transform.rotate.x;
+  rotateY[joint] = transform.rotate.y;
+  rotateZ[joint] = transform.rotate.z;
+  rotateW[joint] = transform.rotate.w;
+  scaleX[joint] = transform.scale.x;
+  scaleY[joint] = transform.scale.y;
+  scaleZ[joint] = transform.scale.z;
+}
+
+QuaternionTransform PoseBuffer::GetJoint(size_t joint) const {
+  QuaternionTransform transform;
+  transform.translate = {translateX[joint], translateY[joint], translateZ[joint]};
+  transform.rotate = {rotateX[joint], rotateY[joint], rotateZ[joint], rotateW[joint]};
+  transform.scale = {scaleX[joint], scaleY[joint], scaleZ[joint]};
+  return transform;
+}
+
+//=========================
+// AnimationClip
+//=========================
+AnimationClip MakeAnimationClip(const Skeleton &skeleton, const Animation &animation) {
+  AnimationClip clip;
+  clip.animation = &animation;
+  clip.binding = BindAnimation(skeleton, animation);
+  clip.duration = animation.duration;
+  return clip;
+}
+
+AnimationClip MakeAnimationClip(const Skeleton &skeleton, const CompressedAnimation &animation) {
+  AnimationClip clip;
+  clip.compressed = &animation;
+  clip.binding = BindAnimation(skeleton, animation);
+  clip.duration = animation.duration;
+  return clip;
+}
+
+namespace PoseBlend {
+
+void Blend(const PoseBuffer &a, const PoseBuffer &b, float weight, const float *jointWeights,
+           PoseBuffer &out) {
+  assert(a.jointCount == b.jointCount);
+  out.Resize(a.jointCount);
+  const size_t count = PaddedCount(a.jointCount);
+#ifdef ANIMATION_BLEND_USE_SSE
+  for (size_t i = 0; i < count; i += kLaneCount) {
+    const __m128 w = Weights(weight, jointWeights, i);
+    const Lanes va = LoadLanes(a, i);
+    Lanes vb = LoadLanes(b, i);
+    // 近い側を通るように向きを揃える
+    const __m128 flip = NegativeSignMask(Dot4(va.rx, va.ry, va.rz, va.rw, vb.rx, vb.ry, vb.rz, vb.rw));
+    vb.rx = _mm_xor_ps(vb.rx, flip);
+    vb.ry = _mm_xor_ps(vb.ry, flip);
+    vb.rz = _mm_xor_ps(vb.rz, flip);
+    vb.rw = _mm_xor_ps(vb.rw, flip);
+    Lanes r{Lerp(va.tx, vb.tx, w), Lerp(va.ty, vb.ty, w), Lerp(va.tz, vb.tz, w),
+            Lerp(va.rx, vb.rx, w), Lerp(va.ry, vb.ry, w), Lerp(va.rz, vb.rz, w), Lerp(va.rw, vb.rw, w),
+            Lerp(va.sx, vb.sx, w), Lerp(va.sy, vb.sy, w), Lerp(va.sz, vb.sz, w)};
+    NormalizeRotation(r);
+    StoreLanes(out, i, r);
+  }
+#else
+  for (size_t i = 0; i < count; ++i) {
+    float w = jointWeights ? weight * jointWeights[i] : weight;
+    Store(out, i, BlendJoint(Load(a, i), Load(b, i), w));
+  }
+#endif
+}
+
+void MakeAdditive(const PoseBuffer &source, const PoseBuffer &reference, PoseBuffer &out) {
+  assert(source.jointCount == reference.jointCount);
+  out.Resize(source.jointCount);
+  const size_t count = PaddedCount(source.jointCount);
+#ifdef ANIMATION_BLEND_USE_SSE
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 signBit = _mm_set1_ps(-0.0f);
+  for (size_t i = 0; i < count; i += kLaneCount) {
+    const Lanes s = LoadLanes(source, i);
+    const Lanes r = LoadLanes(reference, i);
+    Lanes d;
+    d.tx = _mm_sub_ps(s.tx, r.tx);
+    d.ty = _mm_sub_ps(s.ty, r.ty);
+    d.tz = _mm_sub_ps(s.tz, r.tz);
+    // conj(reference) * source
+    const __m128 ax = _mm_xor_ps(r.rx, signBit);
+    const __m128 ay = _mm_xor_ps(r.ry, signBit);
+    const __m128 az = _mm_xor_ps(r.rz, signBit);
+    const __m128 aw = r.rw;
+    d.rx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, s.rx), _mm_mul_ps(ax, s.rw)), _mm_mul_ps(ay, s.rz)),
+                      _mm_mul_ps(az, s.ry));
+    d.ry = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, s.ry), _mm_mul_ps(ax, s.rz)), _mm_mul_ps(ay, s.rw)),
+                      _mm_mul_ps(az, s.rx));
+    d.rz = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, s.rz), _mm_mul_ps(ax, s.ry)), _mm_mul_ps(ay, s.rx)),
+                      _mm_mul_ps(az, s.rw));
+    d.rw = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, s.rw), _mm_mul_ps(ax, s.rx)), _mm_mul_ps(ay, s.ry)),
+                      _mm_mul_ps(az, s.rz));
+    // スケールは比。基準が 0 の成分は割らずにそのまま
+    auto ratio = [&](__m128 a, __m128 b) {
+      __m128 isZero = _mm_cmpeq_ps(b, zero);
+      __m128 safe = _mm_or_ps(_mm_and_ps(isZero, one), _mm_andnot_ps(isZero, b));
+      return _mm_div_ps(a, safe);
+    };
+    d.sx = ratio(s.sx, r.sx);
+    d.sy = ratio(s.sy, r.sy);
+    d.sz = ratio(s.sz, r.sz);
+    StoreLanes(out, i, d);
+  }
+#else
+  for (size_t i = 0; i < count; ++i) {
+    const JointValue s = Load(source, i);
+    const JointValue r = Load(reference, i);
+    JointValue d{};
+    d.tx = s.tx - r.tx;
+    d.ty = s.ty - r.ty;
+    d.tz = s.tz - r.tz;
+    MultiplyRotation(-r.rx, -r.ry, -r.rz, r.rw, s.rx, s.ry, s.rz, s.rw, d);
+    d.sx = SafeDivide(s.sx, r.sx);
+    d.sy = SafeDivide(s.sy, r.sy);
+    d.sz = SafeDivide(s.sz, r.sz);
+    Store(out, i, d);
+  }
+#endif
+}
+
+void ApplyAdditive(const PoseBuffer &base, const PoseBuffer &additive, float weight,
+                   const float *jointWeights, PoseBuffer &out) {
+  assert(base.jointCount == additive.jointCount);
+  out.Resize(base.jointCount);
+  const size_t count = PaddedCount(base.jointCount);
+#ifdef ANIMATION_BLEND_USE_SSE
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (size_t i = 0; i < count; i += kLaneCount) {
+    const __m128 w = Weights(weight, jointWeights, i);
+    const Lanes b = LoadLanes(base, i);
+    Lanes d = LoadLanes(additive, i);
+    Lanes r;
+    r.tx = _mm_add_ps(b.tx, _mm_mul_ps(d.tx, w));
+    r.ty = _mm_add_ps(b.ty, _mm_mul_ps(d.ty, w));
+    r.tz = _mm_add_ps(b.tz, _mm_mul_ps(d.tz, w));
+    r.sx = _mm_mul_ps(b.sx, Lerp(one, d.sx, w));
+    r.sy = _mm_mul_ps(b.sy, Lerp(one, d.sy, w));
+    r.sz = _mm_mul_ps(b.sz, Lerp(one, d.sz, w));
+
+    // 単位回転から差分へ nlerp したもの（差分は w >= 0 の側へ揃える）を base の後ろから掛ける
+    const __m128 flip = NegativeSignMask(d.rw);
+    Lanes q;
+    q.rx = _mm_mul_ps(_mm_xor_ps(d.rx, flip), w);
+    q.ry = _mm_mul_ps(_mm_xor_ps(d.ry, flip), w);
+    q.rz = _mm_mul_ps(_mm_xor_ps(d.rz, flip), w);
+    q.rw = Lerp(one, _mm_xor_ps(d.rw, flip), w);
+    NormalizeRotation(q);
+    r.rx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b.rw, q.rx), _mm_mul_ps(b.rx, q.rw)), _mm_mul_ps(b.ry, q.rz)),
+                      _mm_mul_ps(b.rz, q.ry));
+    r.ry = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(b.rw, q.ry), _mm_mul_ps(b.rx, q.rz)), _mm_mul_ps(b.ry, q.rw)),
+                      _mm_mul_ps(b.rz, q.rx));
+    r.rz = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(b.rw, q.rz), _mm_mul_ps(b.rx, q.ry)), _mm_mul_ps(b.ry, q.rx)),
+                      _mm_mul_ps(b.rz, q.rw));
+    r.rw = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(b.rw, q.rw), _mm_mul_ps(b.rx, q.rx)), _mm_mul_ps(b.ry, q.ry)),
+                      _mm_mul_ps(b.rz, q.rz));
+    StoreLanes(out, i, r);
+  }
+#else
+  for (size_t i = 0; i < count; ++i) {
+    const float w = jointWeights ? weight * jointWeights[i] : weight;
+    const JointValue b = Load(base, i);
+    const JointValue d = Load(additive, i);
+    JointValue r{};
+    r.tx = b.tx + d.tx * w;
+    r.ty = b.ty + d.ty * w;
+    r.tz = b.tz + d.tz * w;
+    r.sx = b.sx * Lerp(1.0f, d.sx, w);
+    r.sy = b.sy * Lerp(1.0f, d.sy, w);
+    r.sz = b.sz * Lerp(1.0f, d.sz, w);
+    const float sign = d.rw < 0.0f ? -1.0f : 1.0f;
+    JointValue q{};
+    q.rx = d.rx * sign * w;
+    q.ry = d.ry * sign * w;
+    q.rz = d.rz * sign * w;
+    q.rw = Lerp(1.0f, d.rw * sign, w);
+    NormalizeRotation(q);
+    MultiplyRotation(b.rx, b.ry, b.rz, b.rw, q.rx, q.ry, q.rz, q.rw, r);
+    Store(out, i, r);
+  }
+#endif
+}
+
+void SampleClip(const AnimationClip &clip, float time, const std::vector<QuaternionTransform> &basePose,
+                std::vector<NodeAnimationCursor> &cursors, std::vector<QuaternionTransform> &scratch,
+                PoseBuffer &out) {
+  assert(clip.binding.jointCount == basePose.size());
+  scratch = basePose;
+  const size_t channelCount = clip.binding.jointIndices.size();
+  if (clip.compressed) {
+    AnimationCompression::SampleNodes(*clip.compressed, time, clip.binding.nodeIndices.data(),
+                                      clip.binding.jointIndices.data(), channelCount, scratch.data());
+  } else if (clip.animation) {
+    if (cursors.size() != channelCount) {
+      cursors.assign(channelCount, NodeAnimationCursor{});
+    }
+    for (size_t i = 0; i < channelCount; ++i) {
+      const NodeAnimation &nodeAnimation = *clip.binding.nodeAnimations[i];
+      QuaternionTransform &transform = scratch[clip.binding.jointIndices[i]];
+      transform.translate = SampleKeyframes(nodeAnimation.translate.keyframes, time, cursors[i].translate);
+      transform.rotate = SampleKeyframes(nodeAnimation.rotate.keyframes, time, cursors[i].rotate);
+      transform.scale = SampleKeyframes(nodeAnimation.scale.keyframes, time, cursors[i].scale);
+    }
+  }
+
+  out.Resize(scratch.size());
+  for (size_t joint = 0; joint < scratch.size(); ++joint) {
+    out.SetJoint(joint, scratch[joint]);
+  }
+}
+
+std::vector<float> MakeJointMask(const Skeleton &skeleton, const std::string &rootJointName, float weight) {
+  const size_t jointCount = skeleton.joints.size();
+  std::vector<float> mask(PaddedCount(jointCount), 0.0f);
+  auto it = skeleton.jointMap.find(rootJointName);
+  if (it == skeleton.jointMap.end()) {
+    return mask;
+  }
+  // 親は子より前にあるので、前から順に「親が含まれていれば自分も含める」で子孫が全部拾える
+  std::vector<uint8_t> inside(jointCount, 0);
+  inside[it->second] = 1;
+  for (size_t joint = 0; joint < jointCount; ++joint) {
+    int32_t parent = skeleton.parentIndices[joint];
+    if (parent >= 0 && inside[parent]) {
+      inside[joint] = 1;
+    }
+    if (inside[joint]) {
+      mask[joint] = weight;
+    }
+  }
+  return mask;
+}
+
+} // namespace PoseBlend
+
+//=========================
+// AnimationController
+//=========================
+void AnimationController::Initialize(const Skeleton &skeleton) {
+  bindPose_ = skeleton.transforms;
+  layers_.clear();
+  layers_.emplace_back();
+  result_.Resize(bindPose_.size());
+  for (size_t joint = 0; joint < bindPose_.size(); ++joint) {
+    result_.SetJoint(joint, bindPose_[joint]);
+  }
+}
+
+uint32_t AnimationController::AddLayer(BlendMode mode, float weight) {
+  Layer layer;
+  layer.mode = mode;
+  layer.weight = weight;
+  layers_.push_back(std::move(layer));
+  return static_cast<uint32_t>(layers_.size() - 1);
+}
+
+void AnimationController::SetLayerWeight(uint32_t layer, float weight) {
+  assert(layer < layers_.size());
+  layers_[layer].weight = weight;
+}
+
+void AnimationController::SetLayerMask(uint32_t layer, std::vector<float> jointWeights) {
+  assert(layer < layers_.size());
+  if (!jointWeights.empty()) {
+    jointWeights.resize(PaddedCount(bindPose_.size()), 0.0f);
+  }
+  layers_[layer].mask = std::move(jointWeights);
+}
+
+void AnimationController::Play(const AnimationClip &clip, float fadeSeconds, uint32_t layer, bool loop) {
+  assert(layer < layers_.size());
+  assert(clip.binding.jointCount == bindPose_.size());
+  Layer &target = layers_[layer];
+
+  if (fadeSeconds > 0.0f && target.current.clip) {
+    // 今のクリップをフェード元にする（カーソルと差分の基準もそのまま引き継ぐ）
+    std::swap(target.previous, target.current);
+    target.fadeElapsed = 0.0f;
+    target.fadeDuration = fadeSeconds;
+  } else {
+    target.previous.clip = nullptr;
+    target.fadeDuration = 0.0f;
+  }
+  target.current.clip = &clip;
+  target.current.time = 0.0f;
+  target.current.loop = loop;
+  target.current.cursors.clear();
+  target.stopFadeDuration = 0.0f;
+  target.stopFadeElapsed = 0.0f;
+
+  if (target.mode == BlendMode::Additive) {
+    // 差分の基準はクリップの先頭フレーム
+    PoseBlend::SampleClip(clip, 0.0f, bindPose_, referenceCursors_, scratch_, target.current.additiveReference);
+    referenceCursors_.clear();
+  }
+}
+
+void AnimationController::Stop(uint32_t layer, float fadeSeconds) {
+  assert(layer < layers_.size());
+  Layer &target = layers_[layer];
+  if (fadeSeconds > 0.0f && target.current.clip) {
+    target.stopFadeDuration = fadeSeconds;
+    target.stopFadeElapsed = 0.0f;
+    return;
+  }
+  target.current.clip = nullptr;
+  target.previous.clip = nullptr;
+  target.fadeDuration = 0.0f;
+}
+
+void AnimationController::Advance(Playback &playback, float deltaTime) const {
+  if (playback.clip) {
+    playback.time = LoopTime(playback.time + deltaTime, playback.clip->duration, playback.loop);
+  }
+}
+
+void AnimationController::Update(float deltaTime) {
+  for (Layer &layer : layers_) {
+    Advance(layer.current, deltaTime);
+    Advance(layer.previous, deltaTime);
+
+    if (layer.fadeDuration > 0.0f) {
+      layer.fadeElapsed += deltaTime;
+      if (layer.fadeElapsed >= layer.fadeDuration) {
+        layer.previous.clip = nullptr;
+        layer.fadeDuration = 0.0f;
+      }
+    }
+    if (layer.stopFadeDuration > 0.0f) {
+      layer.stopFadeElapsed += deltaTime;
+      if (layer.stopFadeElapsed >= layer.stopFadeDuration) {
+        layer.current.clip = nullptr;
+        layer.previous.clip = nullptr;
+        layer.fadeDuration = 0.0f;
+        layer.stopFadeDuration = 0.0f;
+      }
+    }
+  }
+}
+
+float AnimationController::EffectiveWeight(const Layer &layer) const {
+  float weight = layer.weight;
+  if (layer.stopFadeDuration > 0.0f) {
+    weight *= 1.0f - std::clamp(layer.stopFadeElapsed / layer.stopFadeDuration, 0.0f, 1.0f);
+  }
+  return weight;
+}
+
+void AnimationController::SampleLayer(Layer &layer, PoseBuffer &out) {
+  // Additive はクリップごとに自分の先頭フレームからの差分にしてから混ぜる
+  // （フェード元の差分を新しいクリップの基準で取ると、フェードの始まりで姿勢が跳ぶ）
+  const bool additive = layer.mode == BlendMode::Additive;
+  PoseBlend::SampleClip(*layer.current.clip, layer.current.time, bindPose_, layer.current.cursors, scratch_, out);
+  if (additive) {
+    PoseBlend::MakeAdditive(out, layer.current.additiveReference, out);
+  }
+  if (layer.previous.clip && layer.fadeDuration > 0.0f) {
+    PoseBlend::SampleClip(*layer.previous.clip, layer.previous.time, bindPose_, layer.previous.cursors, scratch_,
+                          fadePose_);
+    if (additive) {
+      PoseBlend::MakeAdditive(fadePose_, layer.previous.additiveReference, fadePose_);
+    }
+    float alpha = std::clamp(layer.fadeElapsed / layer.fadeDuration, 0.0f, 1.0f);
+    PoseBlend::Blend(fadePose_, out, alpha, nullptr, out);
+  }
+}
+
+void AnimationController::Evaluate(Skeleton &skeleton) {
+  assert(skeleton.transforms.size() == bindPose_.size());
+
+  // クリップのない Joint・レイヤーはバインドポーズのまま
+  result_.Resize(bindPose_.size());
+  for (size_t joint = 0; joint < bindPose_.size(); ++joint) {
+    result_.SetJoint(joint, bindPose_[joint]);
+  }
+
+  for (Layer &layer : layers_) {
+    if (!layer.current.clip) {
+      continue;
+    }
+    const float weight = EffectiveWeight(layer);
+    if (weight <= 0.0f) {
+      continue;
+    }
+    const float *mask = layer.mask.empty() ? nullptr : layer.mask.data();
+
+    if (layer.mode == BlendMode::Override) {
+      if (weight >= 1.0f && !mask) {
+        // 全部置き換えるなら補間しない（結果がクリップの値そのままになる）
+        SampleLayer(layer, result_);
+        continue;
+      }
+      SampleLayer(layer, layerPose_);
+      PoseBlend::Blend(result_, layerPose_, weight, mask, result_);
+    } else {
+      SampleLayer(layer, layerPose_);
+      PoseBlend::ApplyAdditive(result_, layerPose_, weight, mask, result_);
+    }
+  }
+
+  for (size_t joint = 0; joint < bindPose_.size(); ++joint) {
+    skeleton.transforms[joint] = result_.GetJoint(joint);
+  }
+}
+
+void AnimationController::UpdateAndEvaluateParallel(std::span<AnimationController *const> controllers,
+                                                    std::span<Skeleton *const> skeletons, float deltaTime) {
+  assert(controllers.size() == skeletons.size());
+  // インスタンス同士は何も共有しない（クリップとバインドは読むだけ）ので、そのまま分けて回せる
+  TaskPool::GetInstance()->ParallelFor(controllers.size(), 8, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      controllers[i]->Update(deltaTime);
+      controllers[i]->Evaluate(*skeletons[i]);
+    }
+  });
+}
+
+float AnimationController::GetLayerTime(uint32_t layer) const {
+  assert(layer < layers_.size());
+  return layers_[layer].current.time;
+}
+
+bool AnimationController::IsFading(uint32_t layer) const {
+  assert(layer < layers_.size());
+  return layers_[layer].fadeDuration > 0.0f;
+}
+
+const AnimationClip *AnimationController::GetLayerClip(uint32_t layer) const {
+  assert(layer < layers_.size());
+  return layers_[layer].current.clip;
+}
+
+bool AnimationController::IsSingleClip() const {
+  // レイヤー0がクリップをそのまま出す（重み 1・マスクなしの Override）ときだけ
+  if (layers_.empty() || !layers_[0].current.clip || IsFading(0) || layers_[0].mode != BlendMode::Override ||
+      EffectiveWeight(layers_[0]) < 1.0f || !layers_[0].mask.empty()) {
+    return false;
+  }
+  for (size_t i = 1; i < layers_.size(); ++i) {
+    if (layers_[i].current.clip && EffectiveWeight(layers_[i]) > 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AnimationController::EvaluateBaseAt(float time, Skeleton &skeleton) {
+  assert(skeleton.transforms.size() == bindPose_.size());
+  Playback &playback = layers_[0].current;
+  if (!playback.clip) {
+    return;
+  }
+  // クリップのない Joint はバインドポーズのまま
+  PoseBlend::SampleClip(*playback.clip, time, bindPose_, playback.cursors, scratch_, result_);
+  for (size_t joint = 0; joint < bindPose_.size(); ++joint) {
+    skeleton.transforms[joint] = result_.GetJoint(joint);
+  }
+}
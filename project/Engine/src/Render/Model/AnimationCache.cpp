@@ -0,0 +1,261 @@
+#include "Model/AnimationCache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace AnimationCache {
+namespace {
+
+constexpr char kMagic[4] = {'A', 'N', 'M', 'C'};
+
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t sourceHash;
+  uint32_t importFlags;
+  uint32_t clipCount;
+  uint32_t channelCount;
+  uint32_t vectorKeyCount;     // translate と scale のキー
+  uint32_t quaternionKeyCount; // rotate のキー
+  uint32_t stringBytes;
+};
+
+// チャンネルはクリップごとに続けて並べる
+struct ClipRecord {
+  uint32_t nameOffset;
+  uint32_t nameLength;
+  float duration;
+  uint32_t firstChannel;
+  uint32_t channelCount;
+};
+
+// translate と scale は同じ配列に続けて並べる
+struct ChannelRecord {
+  uint32_t nameOffset;
+  uint32_t nameLength;
+  uint32_t firstTranslate;
+  uint32_t translateCount;
+  uint32_t firstRotate;
+  uint32_t rotateCount;
+  uint32_t firstScale;
+  uint32_t scaleCount;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+static_assert(std::is_trivially_copyable_v<ClipRecord>);
+static_assert(std::is_trivially_copyable_v<ChannelRecord>);
+static_assert(std::is_trivially_copyable_v<KeyframeVector3>);
+static_assert(std::is_trivially_copyable_v<KeyframeQuaternion>);
+
+uint64_t PayloadBytes(const FileHeader &header) {
+  return uint64_t(header.clipCount) * sizeof(ClipRecord) +
+         uint64_t(header.channelCount) * sizeof(ChannelRecord) +
+         uint64_t(header.vectorKeyCount) * sizeof(KeyframeVector3) +
+         uint64_t(header.quaternionKeyCount) * sizeof(KeyframeQuaternion) +
+         uint64_t(header.stringBytes);
+}
+
+uint32_t AppendString(std::string &table, const std::string &value) {
+  uint32_t offset = static_cast<uint32_t>(table.size());
+  table += value;
+  return offset;
+}
+
+template <typename T>
+uint32_t AppendKeys(std::vector<T> &table, const std::vector<T> &keys) {
+  uint32_t offset = static_cast<uint32_t>(table.size());
+  table.insert(table.end(), keys.begin(), keys.end());
+  return offset;
+}
+
+bool ReadString(const std::string &strings, uint32_t offset, uint32_t length, std::string &out) {
+  if (uint64_t(offset) + length > strings.size()) {
+    return false;
+  }
+  out.assign(strings, offset, length);
+  return true;
+}
+
+template <typename T>
+bool ReadKeys(const std::vector<T> &table, uint32_t first, uint32_t count, std::vector<T> &out) {
+  if (uint64_t(first) + count > table.size()) {
+    return false;
+  }
+  out.assign(table.begin() + first, table.begin() + first + count);
+  return true;
+}
+
+template <typename T> bool ReadArray(std::ifstream &file, std::vector<T> &out, uint32_t count) {
+  out.resize(count);
+  if (count == 0) {
+    return true;
+  }
+  file.read(reinterpret_cast<char *>(out.data()), std::streamsize(sizeof(T)) * count);
+  return static_cast<bool>(file);
+}
+
+template <typename T> void WriteArray(std::ofstream &file, const std::vector<T> &values) {
+  if (!values.empty()) {
+    file.write(reinterpret_cast<const char *>(values.data()),
+               std::streamsize(sizeof(T) * values.size()));
+  }
+}
+
+} // namespace
+
+std::string GetCachePath(const std::string &sourcePath) {
+  // MeshCache のパス（～.mesh）と並べて置く
+  std::string path = MeshCache::GetCachePath(sourcePath);
+  const std::string meshExtension = ".mesh";
+  if (path.size() >= meshExtension.size() &&
+      path.compare(path.size() - meshExtension.size(), meshExtension.size(), meshExtension) == 0) {
+    path.resize(path.size() - meshExtension.size());
+  }
+  return path + ".anim";
+}
+
+bool Save(const std::string &cachePath, const MeshCache::Key &key,
+          const std::vector<NamedAnimation> &animations) {
+  std::string strings;
+  std::vector<ClipRecord> clips;
+  std::vector<ChannelRecord> channels;
+  std::vector<KeyframeVector3> vectorKeys;
+  std::vector<KeyframeQuaternion> quaternionKeys;
+  clips.reserve(animations.size());
+  for (const NamedAnimation &clip : animations) {
+    ClipRecord clipRecord{};
+    clipRecord.nameOffset = AppendString(strings, clip.name);
+    clipRecord.nameLength = static_cast<uint32_t>(clip.name.size());
+    clipRecord.duration = clip.animation.duration;
+    clipRecord.firstChannel = static_cast<uint32_t>(channels.size());
+    clipRecord.channelCount = static_cast<uint32_t>(clip.animation.nodeAnimations.size());
+    clips.push_back(clipRecord);
+
+    for (const auto &[nodeName, nodeAnimation] : clip.animation.nodeAnimations) {
+      ChannelRecord record{};
+      record.nameOffset = AppendString(strings, nodeName);
+      record.nameLength = static_cast<uint32_t>(nodeName.size());
+      record.translateCount = static_cast<uint32_t>(nodeAnimation.translate.keyframes.size());
+      record.firstTranslate = AppendKeys(vectorKeys, nodeAnimation.translate.keyframes);
+      record.rotateCount = static_cast<uint32_t>(nodeAnimation.rotate.keyframes.size());
+      record.firstRotate = AppendKeys(quaternionKeys, nodeAnimation.rotate.keyframes);
+      record.scaleCount = static_cast<uint32_t>(nodeAnimation.scale.keyframes.size());
+      record.firstScale = AppendKeys(vectorKeys, nodeAnimation.scale.keyframes);
+      channels.push_back(record);
+    }
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.sourceHash = key.sourceHash;
+  header.importFlags = key.importFlags;
+  header.clipCount = static_cast<uint32_t>(clips.size());
+  header.channelCount = static_cast<uint32_t>(channels.size());
+  header.vectorKeyCount = static_cast<uint32_t>(vectorKeys.size());
+  header.quaternionKeyCount = static_cast<uint32_t>(quaternionKeys.size());
+  header.stringBytes = static_cast<uint32_t>(strings.size());
+
+  std::error_code ec;
+  fs::path path(cachePath);
+  if (path.has_parent_path()) {
+    fs::create_directories(path.parent_path(), ec);
+  }
+
+  // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+  const std::string tempPath = cachePath + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    WriteArray(file, clips);
+    WriteArray(file, channels);
+    WriteArray(file, vectorKeys);
+    WriteArray(file, quaternionKeys);
+    file.write(strings.data(), std::streamsize(strings.size()));
+    if (!file) {
+      return false;
+    }
+  }
+
+  fs::rename(tempPath, cachePath, ec);
+  if (ec) {
+    fs::remove(tempPath, ec);
+    return false;
+  }
+  return true;
+}
+
+bool Load(const std::string &cachePath, const MeshCache::Key &key,
+          std::vector<NamedAnimation> &outAnimations) {
+  std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    return false;
+  }
+  const uint64_t fileBytes = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+
+  FileHeader header{};
+  if (fileBytes < sizeof(header) ||
+      !file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+
+  // 別物・古い・途中で切れたキャッシュは使わない
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+      header.sourceHash != key.sourceHash || header.importFlags != key.importFlags ||
+      fileBytes != sizeof(header) + PayloadBytes(header)) {
+    return false;
+  }
+
+  std::vector<ClipRecord> clips;
+  std::vector<ChannelRecord> channels;
+  std::vector<KeyframeVector3> vectorKeys;
+  std::vector<KeyframeQuaternion> quaternionKeys;
+  std::string strings(header.stringBytes, '\0');
+  if (!ReadArray(file, clips, header.clipCount) ||
+      !ReadArray(file, channels, header.channelCount) ||
+      !ReadArray(file, vectorKeys, header.vectorKeyCount) ||
+      !ReadArray(file, quaternionKeys, header.quaternionKeyCount) ||
+      !file.read(strings.data(), std::streamsize(strings.size()))) {
+    return false;
+  }
+
+  std::vector<NamedAnimation> animations(clips.size());
+  for (size_t clipIndex = 0; clipIndex < clips.size(); ++clipIndex) {
+    const ClipRecord &clipRecord = clips[clipIndex];
+    NamedAnimation &clip = animations[clipIndex];
+    if (!ReadString(strings, clipRecord.nameOffset, clipRecord.nameLength, clip.name) ||
+        uint64_t(clipRecord.firstChannel) + clipRecord.channelCount > channels.size()) {
+      return false;
+    }
+    clip.animation.duration = clipRecord.duration;
+
+    for (uint32_t i = 0; i < clipRecord.channelCount; ++i) {
+      const ChannelRecord &record = channels[clipRecord.firstChannel + i];
+      std::string nodeName;
+      if (!ReadString(strings, record.nameOffset, record.nameLength, nodeName)) {
+        return false;
+      }
+      NodeAnimation &nodeAnimation = clip.animation.nodeAnimations[nodeName];
+      if (!ReadKeys(vectorKeys, record.firstTranslate, record.translateCount,
+                    nodeAnimation.translate.keyframes) ||
+          !ReadKeys(quaternionKeys, record.firstRotate, record.rotateCount,
+                    nodeAnimation.rotate.keyframes) ||
+          !ReadKeys(vectorKeys, record.firstScale, record.scaleCount,
+                    nodeAnimation.scale.keyframes)) {
+        return false;
+      }
+    }
+  }
+
+  outAnimations = std::move(animations);
+  return true;
+}
+
+} // namespace AnimationCache
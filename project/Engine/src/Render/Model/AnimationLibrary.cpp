@@ -0,0 +1,138 @@
+#include "Model/AnimationLibrary.h"
+#include "Debug/Logger.h"
+#include "Model/AnimationCache.h"
+#include "Model/MeshCache.h"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <chrono>
+#include <filesystem>
+
+namespace {
+
+// assimp のアニメーション1つを秒単位・左手系に直す
+Animation ConvertAnimation(const aiAnimation *animationAssimp) {
+  Animation animation;
+  // mTicksPerSecond が 0 のファイルもある（assimp の既定に合わせて 25 とみなす）
+  const double ticksPerSecond =
+      animationAssimp->mTicksPerSecond != 0.0 ? animationAssimp->mTicksPerSecond : 25.0;
+  animation.duration = float(animationAssimp->mDuration / ticksPerSecond); // 時間の単位を秒に変換
+
+  // assimpでは個々のNodeのAnimationをchannelと呼んでいるのでchannelを回してNodeAnimationの情報をとってくる
+  for (uint32_t channelIndex = 0; channelIndex < animationAssimp->mNumChannels; ++channelIndex) {
+    const aiNodeAnim *nodeAnimationAssimp = animationAssimp->mChannels[channelIndex];
+    NodeAnimation &nodeAnimation = animation.nodeAnimations[nodeAnimationAssimp->mNodeName.C_Str()];
+
+    // Translate
+    nodeAnimation.translate.keyframes.reserve(nodeAnimationAssimp->mNumPositionKeys);
+    for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumPositionKeys; ++keyIndex) {
+      const aiVectorKey &keyAssimp = nodeAnimationAssimp->mPositionKeys[keyIndex];
+      KeyframeVector3 keyframe;
+      keyframe.time = float(keyAssimp.mTime / ticksPerSecond); // ここも秒に変換
+      keyframe.value = {-keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z}; // 右手->左手
+      nodeAnimation.translate.keyframes.push_back(keyframe);
+    }
+
+    // Rotate
+    nodeAnimation.rotate.keyframes.reserve(nodeAnimationAssimp->mNumRotationKeys);
+    for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumRotationKeys; ++keyIndex) {
+      const aiQuatKey &keyAssimp = nodeAnimationAssimp->mRotationKeys[keyIndex];
+      KeyframeQuaternion keyframe;
+      keyframe.time = float(keyAssimp.mTime / ticksPerSecond); // ここも秒に変換
+      // RotateはQuaternionで、右手->左手に変換するために、yとzを反転させる必要がある
+      keyframe.value = {keyAssimp.mValue.x, -keyAssimp.mValue.y, -keyAssimp.mValue.z, keyAssimp.mValue.w};
+      nodeAnimation.rotate.keyframes.push_back(keyframe);
+    }
+
+    // Scale
+    nodeAnimation.scale.keyframes.reserve(nodeAnimationAssimp->mNumScalingKeys);
+    for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumScalingKeys; ++keyIndex) {
+      const aiVectorKey &keyAssimp = nodeAnimationAssimp->mScalingKeys[keyIndex];
+      KeyframeVector3 keyframe;
+      keyframe.time = float(keyAssimp.mTime / ticksPerSecond); // ここも秒に変換
+      // Scaleはそのままで良い
+      keyframe.value = {keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z};
+      nodeAnimation.scale.keyframes.push_back(keyframe);
+    }
+  }
+  return animation;
+}
+
+// ファイル内の全アニメーションを取り込む。ファイルが読めなければ false
+bool ImportAnimations(const std::string &filePath, std::vector<NamedAnimation> &outClips) {
+  Assimp::Importer importer;
+  const aiScene *scene = importer.ReadFile(filePath.c_str(), 0);
+  if (!scene) {
+    Logger::Log("[AnimationLibrary] failed to read " + filePath + ": " + importer.GetErrorString() + "\n");
+    return false;
+  }
+
+  outClips.resize(scene->mNumAnimations);
+  for (uint32_t i = 0; i < scene->mNumAnimations; ++i) {
+    outClips[i].name = scene->mAnimations[i]->mName.C_Str();
+    outClips[i].animation = ConvertAnimation(scene->mAnimations[i]);
+  }
+  return true;
+}
+
+} // namespace
+
+AnimationLibrary *AnimationLibrary::GetInstance() {
+  static AnimationLibrary instance;
+  return &instance;
+}
+
+void AnimationLibrary::Finalize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sets_.clear();
+}
+
+const AnimationSet *AnimationLibrary::Load(const std::string &filePath) {
+  // 同じファイルを別の書き方で渡されても1つにまとめる
+  const std::string key = std::filesystem::path(filePath).lexically_normal().generic_string();
+
+  // 読み込みは一度に1つ（同じファイルを2つのスレッドで二重に取り込まないように）
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto it = sets_.find(key); it != sets_.end()) {
+    return it->second.get();
+  }
+
+  auto loadStart = std::chrono::steady_clock::now();
+  auto elapsedMs = [&]() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+  };
+
+  // 元ファイルが変わっていなければ前回取り込んだものを使う
+  const MeshCache::Key cacheKey{MeshCache::HashSourceFiles(key), 0};
+  const std::string cachePath = AnimationCache::GetCachePath(key);
+  std::vector<NamedAnimation> clips;
+  if (cacheKey.sourceHash != 0 && AnimationCache::Load(cachePath, cacheKey, clips)) {
+    Logger::Log("[AnimationLibrary] " + key + ": animation cache hit (" + std::to_string(elapsedMs()) + " ms)\n");
+  } else {
+    if (!ImportAnimations(key, clips)) {
+      return nullptr;
+    }
+    if (cacheKey.sourceHash != 0 && !AnimationCache::Save(cachePath, cacheKey, clips)) {
+      Logger::Log("[AnimationLibrary] failed to write animation cache: " + cachePath + "\n");
+    }
+    Logger::Log("[AnimationLibrary] " + key + ": imported with Assimp (" + std::to_string(elapsedMs()) + " ms)\n");
+  }
+
+  auto set = std::make_unique<AnimationSet>(MakeAnimationSet(key, std::move(clips)));
+  Logger::Log("[AnimationLibrary] " + key + ": " + std::to_string(set->GetCount()) + " clip(s)\n");
+  const AnimationSet *result = set.get();
+  sets_.emplace(key, std::move(set));
+  return result;
+}
+
+const AnimationSet *AnimationLibrary::Find(const std::string &filePath) const {
+  const std::string key = std::filesystem::path(filePath).lexically_normal().generic_string();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = sets_.find(key);
+  return it != sets_.end() ? it->second.get() : nullptr;
+}
+
+const Animation *AnimationLibrary::LoadAnimation(const std::string &filePath,
+                                                 const std::string &clipName) {
+  const AnimationSet *set = Load(filePath);
+  return set ? set->Find(clipName) : nullptr;
+}
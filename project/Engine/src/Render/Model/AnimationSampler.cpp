@@ -0,0 +1,120 @@
+#include "Model/AnimationSampler.h"
+#include "Math/MathUtil.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+// 区間 index が time を含む最初の区間か
+// 時刻順なら keyframes[index].time < time <= keyframes[index + 1].time を満たす区間は1つだけ
+// （先頭区間は time <= keyframes[0].time を呼び出し側で先に処理しているので下限を見なくてよい）
+template <typename tValue>
+bool IsSegmentOf(const std::vector<Keyframe<tValue>> &keyframes, uint32_t index, float time) {
+  return index + 1 < keyframes.size() && time <= keyframes[index + 1].time &&
+         (index == 0 || keyframes[index].time < time);
+}
+
+// カーソルの区間から少しだけ先を見て、だめなら二分探索する
+constexpr uint32_t kForwardProbeCount = 2;
+
+} // namespace
+
+template <typename tValue>
+uint32_t FindKeyframeSegment(const std::vector<Keyframe<tValue>> &keyframes, float time,
+                             KeyframeCursor &cursor) {
+  const uint32_t lastIndex = static_cast<uint32_t>(keyframes.size() - 1);
+
+  for (uint32_t probe = 0; probe <= kForwardProbeCount; ++probe) {
+    const uint32_t index = cursor.index + probe;
+    if (index >= lastIndex) {
+      break;
+    }
+    if (IsSegmentOf(keyframes, index, time)) {
+      cursor.index = index;
+      return index;
+    }
+  }
+
+  // シーク・ループ・大きく進んだとき：keyframes[index + 1].time >= time となる最初の index
+  auto it = std::lower_bound(keyframes.begin() + 1, keyframes.end(), time,
+                             [](const Keyframe<tValue> &keyframe, float value) {
+                               return keyframe.time < value;
+                             });
+  const uint32_t index = static_cast<uint32_t>(it - (keyframes.begin() + 1));
+  // 最後のキーより後なら、次のループ先頭に備えてカーソルは0に戻しておく
+  cursor.index = (index < lastIndex) ? index : 0;
+  return index;
+}
+
+template uint32_t FindKeyframeSegment(const std::vector<KeyframeVector3> &, float, KeyframeCursor &);
+template uint32_t FindKeyframeSegment(const std::vector<KeyframeQuaternion> &, float,
+                                      KeyframeCursor &);
+
+Vector3 CalculateValue(const std::vector<KeyframeVector3> &keyframes, float time) {
+  assert(!keyframes.empty()); // キーがないものはダメ
+  if (keyframes.size() == 1 || time <= keyframes[0].time) {
+    return keyframes[0].value;
+  }
+
+  for (size_t index = 0; index < keyframes.size() - 1; ++index) {
+    size_t nextIndex = index + 1;
+    if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
+      float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
+      return Lerp(keyframes[index].value, keyframes[nextIndex].value, t);
+    }
+  }
+  return (*keyframes.rbegin()).value;
+}
+
+Quaternion CalculateValue(const std::vector<KeyframeQuaternion> &keyframes, float time) {
+  assert(!keyframes.empty());
+  if (keyframes.size() == 1 || time <= keyframes[0].time) {
+    return keyframes[0].value;
+  }
+
+  for (size_t index = 0; index < keyframes.size() - 1; ++index) {
+    size_t nextIndex = index + 1;
+    if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
+      float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
+      return Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
+    }
+  }
+  return (*keyframes.rbegin()).value;
+}
+
+Vector3 SampleKeyframes(const std::vector<KeyframeVector3> &keyframes, float time,
+                        KeyframeCursor &cursor) {
+  assert(!keyframes.empty());
+  if (keyframes.size() == 1 || time <= keyframes[0].time) {
+    cursor.index = 0;
+    return keyframes[0].value;
+  }
+
+  const uint32_t index = FindKeyframeSegment(keyframes, time, cursor);
+  if (index + 1 >= keyframes.size()) {
+    return keyframes.back().value;
+  }
+  // CalculateValue と同じ式で補間する（結果がビット単位で一致するように）
+  const KeyframeVector3 &current = keyframes[index];
+  const KeyframeVector3 &next = keyframes[index + 1];
+  float t = (time - current.time) / (next.time - current.time);
+  return Lerp(current.value, next.value, t);
+}
+
+Quaternion SampleKeyframes(const std::vector<KeyframeQuaternion> &keyframes, float time,
+                           KeyframeCursor &cursor) {
+  assert(!keyframes.empty());
+  if (keyframes.size() == 1 || time <= keyframes[0].time) {
+    cursor.index = 0;
+    return keyframes[0].value;
+  }
+
+  const uint32_t index = FindKeyframeSegment(keyframes, time, cursor);
+  if (index + 1 >= keyframes.size()) {
+    return keyframes.back().value;
+  }
+  const KeyframeQuaternion &current = keyframes[index];
+  const KeyframeQuaternion &next = keyframes[index + 1];
+  float t = (time - current.time) / (next.time - current.time);
+  return Slerp(current.value, next.value, t);
+}
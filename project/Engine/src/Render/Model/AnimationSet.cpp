@@ -0,0 +1,52 @@
+#include "Model/AnimationSet.h"
+#include "Debug/Logger.h"
+#include <utility>
+
+int32_t AnimationSet::FindIndex(const std::string &name) const {
+  auto it = indexByName.find(name);
+  return it != indexByName.end() ? static_cast<int32_t>(it->second) : -1;
+}
+
+const Animation *AnimationSet::Get(size_t index) const {
+  return index < animations.size() ? &animations[index] : nullptr;
+}
+
+const CompressedAnimation *AnimationSet::GetCompressed(size_t index) const {
+  return index < compressedAnimations.size() ? &compressedAnimations[index] : nullptr;
+}
+
+const Animation *AnimationSet::Find(const std::string &name) const {
+  int32_t index = FindIndex(name);
+  return index >= 0 ? &animations[index] : nullptr;
+}
+
+const CompressedAnimation *AnimationSet::FindCompressed(const std::string &name) const {
+  int32_t index = FindIndex(name);
+  return index >= 0 ? &compressedAnimations[index] : nullptr;
+}
+
+AnimationSet MakeAnimationSet(const std::string &sourcePath, std::vector<NamedAnimation> clips) {
+  AnimationSet set;
+  set.sourcePath = sourcePath;
+  set.names.reserve(clips.size());
+  set.animations.reserve(clips.size());
+  set.compressedAnimations.reserve(clips.size());
+  for (size_t i = 0; i < clips.size(); ++i) {
+    NamedAnimation &clip = clips[i];
+    if (clip.name.empty()) {
+      clip.name = "Animation" + std::to_string(i);
+    }
+    // 同じ名前は最初のものを残す（後のものは番号で引ける）
+    if (!set.indexByName.emplace(clip.name, static_cast<uint32_t>(i)).second) {
+      Logger::Log("[AnimationSet] " + sourcePath + ": duplicate clip name '" + clip.name +
+                  "' (index " + std::to_string(i) + " is only reachable by index)\n");
+    }
+    set.compressedAnimations.push_back(AnimationCompression::Compress(clip.animation));
+    Logger::Log("[AnimationSet] " + sourcePath + ": '" + clip.name + "' compressed " +
+                std::to_string(AnimationCompression::GetMemorySize(clip.animation)) + " -> " +
+                std::to_string(set.compressedAnimations.back().GetMemorySize()) + " bytes\n");
+    set.names.push_back(std::move(clip.name));
+    set.animations.push_back(std::move(clip.animation));
+  }
+  return set;
+}
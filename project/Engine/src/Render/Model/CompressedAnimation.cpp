@@ -0,0 +1,694 @@
+#include "Model/CompressedAnimation.h"
+#include "Math/MathUtil.h"
+#include "Model/AnimationSampler.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ANIMATION_COMPRESSION_USE_SSE
+#endif
+
+namespace {
+
+using Track = CompressedAnimation::Track;
+
+constexpr uint32_t kComponentsPerSample = 4;
+constexpr uint32_t kRawComponentsPerSample = 8; // 量子化しないトラックは float 4つ
+constexpr uint32_t kMaxStrideShift = 4; // 間引く間隔は最大 16 フレーム
+constexpr float kQuantizeMax = 65535.0f;
+// 最も大きい成分を除いた残り3成分は [-1/√2, 1/√2] に収まる
+// 0 をちょうど表せるよう段数は偶数（65534）にする
+constexpr float kSmallestThreeRange = 0.70710678118f;
+constexpr float kSmallestThreeMax = 65534.0f;
+constexpr float kSmallestThreeStep = 2.0f * kSmallestThreeRange / kSmallestThreeMax;
+
+//=========================
+// 補間・誤差
+//=========================
+
+float Distance(const Vector3 &a, const Vector3 &b) {
+  float dx = a.x - b.x;
+  float dy = a.y - b.y;
+  float dz = a.z - b.z;
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+float Dot(const Quaternion &a, const Quaternion &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+// 2つの回転の差（ラジアン）。q と -q は同じ回転として扱う
+// acos(dot) は差が小さいと float の丸めで 0 になるので、単位四元数の間の距離 2sin(θ/4) から求める
+float AngleBetween(const Quaternion &a, const Quaternion &b) {
+  float sign = Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+  float dx = a.x - b.x * sign;
+  float dy = a.y - b.y * sign;
+  float dz = a.z - b.z * sign;
+  float dw = a.w - b.w * sign;
+  float distance = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+  return 4.0f * std::asin(std::min(1.0f, distance * 0.5f));
+}
+
+Quaternion NormalizeQuaternion(const Quaternion &q) {
+  float length = std::sqrt(Dot(q, q));
+  return {q.x / length, q.y / length, q.z / length, q.w / length};
+}
+
+#ifndef ANIMATION_COMPRESSION_USE_SSE
+Quaternion Nlerp(const Quaternion &a, Quaternion b, float t) {
+  if (Dot(a, b) < 0.0f) {
+    b = {-b.x, -b.y, -b.z, -b.w};
+  }
+  return NormalizeQuaternion({a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                              a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t});
+}
+#endif
+
+//=========================
+// フレーム位置
+//=========================
+
+// 再サンプリングの格子（クリップ内の全トラックで共通）
+struct FrameGrid {
+  float duration = 0.0f;
+  float sampleRate = 30.0f;
+  uint32_t frameCount = 1; // 最後のフレームは duration ちょうど
+};
+
+float FrameTime(const FrameGrid &grid, uint32_t frame) {
+  return frame + 1 >= grid.frameCount ? grid.duration
+                                      : static_cast<float>(frame) / grid.sampleRate;
+}
+
+// stride ごとに間引いたとき、何番目のサンプルの区間にいるか
+struct Segment {
+  uint32_t index = 0; // 区間の先頭サンプル
+  float alpha = 0.0f; // 次のサンプルへの補間係数
+};
+
+// 残るサンプル数（最後のフレームは必ず残す）
+uint32_t SampleCountFor(uint32_t lastFrame, uint32_t stride) {
+  return (lastFrame + stride - 1) / stride + 1;
+}
+
+// 残すサンプルの元のフレーム番号
+uint32_t FrameOfSample(uint32_t sample, uint32_t stride, uint32_t lastFrame) {
+  return std::min(sample * stride, lastFrame);
+}
+
+Segment FindSegment(uint32_t stride, uint32_t sampleCount, uint32_t lastFrame,
+                    float framePosition) {
+  if (sampleCount <= 1) {
+    return {};
+  }
+  uint32_t index = static_cast<uint32_t>(framePosition) / stride;
+  if (index >= sampleCount - 1u) {
+    return {sampleCount - 1u, 0.0f};
+  }
+  uint32_t start = index * stride;
+  uint32_t end = std::min(start + stride, lastFrame);
+  return {index, (framePosition - static_cast<float>(start)) / static_cast<float>(end - start)};
+}
+
+// 時刻を元のフレーム単位の位置にする。最後のフレームだけ間隔が短いことがあるのでそこは詰める
+float FramePosition(const FrameGrid &grid, float time) {
+  const uint32_t lastFrame = grid.frameCount - 1;
+  if (lastFrame == 0) {
+    return 0.0f;
+  }
+  time = std::clamp(time, 0.0f, grid.duration);
+  float position = time * grid.sampleRate;
+  const float lastStart = static_cast<float>(lastFrame - 1);
+  if (position > lastStart) {
+    float lastInterval = grid.duration - lastStart / grid.sampleRate;
+    float t = lastInterval > 0.0f ? (time - lastStart / grid.sampleRate) / lastInterval : 1.0f;
+    position = lastStart + std::min(t, 1.0f);
+  }
+  return position;
+}
+
+float FramePosition(const CompressedAnimation &animation, float time) {
+  return FramePosition(FrameGrid{animation.duration, animation.sampleRate, animation.frameCount}, time);
+}
+
+//=========================
+// 展開
+//=========================
+
+uint32_t ComponentsPerSample(const Track &track) {
+  return track.quantized ? kComponentsPerSample : kRawComponentsPerSample;
+}
+
+void LoadRaw(const uint16_t *sample, float out[4]) {
+  std::memcpy(out, sample, sizeof(float) * 4);
+}
+
+// 量子化した位置・スケールを戻して補間する（SSE があれば xyz をまとめて）
+Vector3 DecodeVector(const Track &track, const uint16_t *samples, const Segment &segment) {
+  if (track.sampleCount <= 1) {
+    return {track.rangeMin[0], track.rangeMin[1], track.rangeMin[2]};
+  }
+  const uint32_t components = ComponentsPerSample(track);
+  const uint16_t *a = samples + track.offset + segment.index * components;
+  const uint16_t *b = (segment.index + 1 < track.sampleCount) ? a + components : a;
+
+  if (!track.quantized) {
+    float va[4];
+    float vb[4];
+    LoadRaw(a, va);
+    LoadRaw(b, vb);
+    return {va[0] + (vb[0] - va[0]) * segment.alpha, va[1] + (vb[1] - va[1]) * segment.alpha,
+            va[2] + (vb[2] - va[2]) * segment.alpha};
+  }
+
+#ifdef ANIMATION_COMPRESSION_USE_SSE
+  const __m128i zero = _mm_setzero_si128();
+  __m128 rangeMin = _mm_loadu_ps(track.rangeMin);
+  __m128 rangeScale = _mm_loadu_ps(track.rangeScale);
+  __m128 va = _mm_cvtepi32_ps(
+      _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(a)), zero));
+  __m128 vb = _mm_cvtepi32_ps(
+      _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(b)), zero));
+  va = _mm_add_ps(rangeMin, _mm_mul_ps(va, rangeScale));
+  vb = _mm_add_ps(rangeMin, _mm_mul_ps(vb, rangeScale));
+  __m128 result = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), _mm_set1_ps(segment.alpha)));
+  alignas(16) float out[4];
+  _mm_store_ps(out, result);
+  return {out[0], out[1], out[2]};
+#else
+  float out[3];
+  for (int c = 0; c < 3; ++c) {
+    float va = track.rangeMin[c] + static_cast<float>(a[c]) * track.rangeScale[c];
+    float vb = track.rangeMin[c] + static_cast<float>(b[c]) * track.rangeScale[c];
+    out[c] = va + (vb - va) * segment.alpha;
+  }
+  return {out[0], out[1], out[2]};
+#endif
+}
+
+Quaternion DecodeRotationSample(const Track &track, const uint16_t *sample) {
+  if (!track.quantized) {
+    float q[4];
+    LoadRaw(sample, q);
+    return {q[0], q[1], q[2], q[3]};
+  }
+  return AnimationCompression::UnpackQuaternion(sample);
+}
+
+Quaternion DecodeRotation(const Track &track, const uint16_t *samples, const Segment &segment) {
+  if (track.sampleCount <= 1) {
+    return {track.rangeMin[0], track.rangeMin[1], track.rangeMin[2], track.rangeMin[3]};
+  }
+  const uint32_t components = ComponentsPerSample(track);
+  const uint16_t *a = samples + track.offset + segment.index * components;
+  Quaternion qa = DecodeRotationSample(track, a);
+  if (segment.alpha == 0.0f || segment.index + 1 >= track.sampleCount) {
+    return qa;
+  }
+  Quaternion qb = DecodeRotationSample(track, a + components);
+
+#ifdef ANIMATION_COMPRESSION_USE_SSE
+  __m128 va = _mm_loadu_ps(&qa.x);
+  __m128 vb = _mm_loadu_ps(&qb.x);
+  if (Dot(qa, qb) < 0.0f) {
+    vb = _mm_sub_ps(_mm_setzero_ps(), vb);
+  }
+  __m128 r = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), _mm_set1_ps(segment.alpha)));
+  // 長さで割って正規化（水平加算は shuffle で）
+  __m128 squared = _mm_mul_ps(r, r);
+  __m128 sum = _mm_add_ps(squared, _mm_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 3, 0, 1)));
+  sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  r = _mm_div_ps(r, _mm_sqrt_ps(sum));
+  Quaternion result;
+  _mm_storeu_ps(&result.x, r);
+  return result;
+#else
+  return Nlerp(qa, qb, segment.alpha);
+#endif
+}
+
+//=========================
+// トラックの作成
+//=========================
+
+void PushRaw(const float (&values)[4], std::vector<uint16_t> &samples) {
+  uint16_t raw[kRawComponentsPerSample];
+  std::memcpy(raw, values, sizeof(raw));
+  samples.insert(samples.end(), raw, raw + kRawComponentsPerSample);
+}
+
+// 圧縮後の値を確かめる時刻と、その時刻の元の値（CalculateValue と同じ値）
+// 再サンプリングしたフレームと元のキーの時刻で確かめる。位置・スケールはどちらも折れ線なので
+// 差が最大になるのはその折れ目だけだが、回転は Slerp と nlerp の差が区間の中ほどで大きくなるので
+// キーとキーの間も 1/kRotationReferenceSteps ごとに見る
+constexpr int kRotationReferenceSteps = 8;
+
+template <typename tValue>
+struct Reference {
+  std::vector<float> times;
+  std::vector<tValue> values;
+};
+
+template <typename tValue>
+void MakeReference(const std::vector<Keyframe<tValue>> &keyframes, const FrameGrid &grid,
+                   int stepsPerKey, Reference<tValue> &reference) {
+  reference.times.clear();
+  reference.values.clear();
+  for (uint32_t frame = 0; frame < grid.frameCount; ++frame) {
+    reference.times.push_back(FrameTime(grid, frame));
+  }
+  for (size_t i = 0; i < keyframes.size(); ++i) {
+    reference.times.push_back(keyframes[i].time);
+    if (i + 1 < keyframes.size()) {
+      const float start = keyframes[i].time;
+      const float interval = keyframes[i + 1].time - start;
+      for (int step = 1; step < stepsPerKey; ++step) {
+        reference.times.push_back(start + interval * static_cast<float>(step) / stepsPerKey);
+      }
+    }
+  }
+  for (float &time : reference.times) {
+    time = std::clamp(time, 0.0f, grid.duration);
+  }
+  std::sort(reference.times.begin(), reference.times.end());
+  reference.times.erase(std::unique(reference.times.begin(), reference.times.end()),
+                        reference.times.end());
+  KeyframeCursor cursor;
+  for (float time : reference.times) {
+    reference.values.push_back(SampleKeyframes(keyframes, time, cursor));
+  }
+}
+
+// 量子化・間引きした後の値が、確かめるすべての時刻で許容誤差に収まる最大の間隔を選んで samples に書く
+// 間引かなくても収まらなければ量子化せずに持つ。それでも収まらなければ false（サンプリングレートが粗い）
+// fits(track, samples) は確かめる時刻すべてで許容誤差に収まるか（外れたところで打ち切る）
+template <typename Encode, typename Fits>
+bool ChooseTrack(uint32_t lastFrame, uint16_t maxStride, Encode encode, Fits fits, Track &track,
+                 std::vector<uint16_t> &samples) {
+  std::vector<uint16_t> scratch;
+  auto build = [&](uint32_t stride, bool quantized) {
+    track = {};
+    track.stride = static_cast<uint16_t>(stride);
+    track.quantized = quantized;
+    track.sampleCount = SampleCountFor(lastFrame, stride);
+    scratch.clear();
+    encode(track, scratch);
+    return fits(track, scratch.data());
+  };
+  auto commit = [&] {
+    track.offset = static_cast<uint32_t>(samples.size());
+    samples.insert(samples.end(), scratch.begin(), scratch.end());
+  };
+
+  for (uint32_t stride = maxStride; stride >= 1; stride /= 2) {
+    if (stride > 1 && stride > lastFrame) {
+      continue;
+    }
+    if (build(stride, true)) {
+      commit();
+      return true;
+    }
+  }
+  // 量子化の誤差で収まらない（値の範囲が広い）なら float のまま持つ
+  // それでも収まらなければフレームの間隔が粗いので、最も細かい形で書いて false を返す
+  bool rawFits = build(1, false);
+  commit();
+  return rawFits;
+}
+
+bool BuildVectorTrack(const std::vector<KeyframeVector3> &keyframes,
+                      const std::vector<Vector3> &frames, const Vector3 &defaultValue,
+                      const FrameGrid &grid, float tolerance, uint16_t maxStride,
+                      Track &track, std::vector<uint16_t> &samples) {
+  track = {};
+  if (keyframes.empty()) {
+    track.rangeMin[0] = defaultValue.x;
+    track.rangeMin[1] = defaultValue.y;
+    track.rangeMin[2] = defaultValue.z;
+    return true;
+  }
+
+  // 一定値のチャンネルはサンプルを持たない（キーが最初のキーから許容誤差内なら、補間した値も収まる）
+  bool isConstant = std::all_of(keyframes.begin(), keyframes.end(), [&](const KeyframeVector3 &key) {
+    return Distance(key.value, keyframes[0].value) <= tolerance;
+  });
+  if (isConstant) {
+    track.rangeMin[0] = keyframes[0].value.x;
+    track.rangeMin[1] = keyframes[0].value.y;
+    track.rangeMin[2] = keyframes[0].value.z;
+    return true;
+  }
+
+  Reference<Vector3> reference;
+  MakeReference(keyframes, grid, 1, reference);
+  const uint32_t lastFrame = grid.frameCount - 1;
+
+  auto encode = [&](Track &candidate, std::vector<uint16_t> &out) {
+    if (!candidate.quantized) {
+      for (uint32_t i = 0; i < candidate.sampleCount; ++i) {
+        const Vector3 &value = frames[FrameOfSample(i, candidate.stride, lastFrame)];
+        PushRaw({value.x, value.y, value.z, 0.0f}, out);
+      }
+      return;
+    }
+    Vector3 minValue = frames[0];
+    Vector3 maxValue = frames[0];
+    for (uint32_t i = 0; i < candidate.sampleCount; ++i) {
+      const Vector3 &value = frames[FrameOfSample(i, candidate.stride, lastFrame)];
+      minValue = {std::min(minValue.x, value.x), std::min(minValue.y, value.y),
+                  std::min(minValue.z, value.z)};
+      maxValue = {std::max(maxValue.x, value.x), std::max(maxValue.y, value.y),
+                  std::max(maxValue.z, value.z)};
+    }
+    const float minComponents[3] = {minValue.x, minValue.y, minValue.z};
+    const float maxComponents[3] = {maxValue.x, maxValue.y, maxValue.z};
+    for (int c = 0; c < 3; ++c) {
+      candidate.rangeMin[c] = minComponents[c];
+      candidate.rangeScale[c] = (maxComponents[c] - minComponents[c]) / kQuantizeMax;
+    }
+    for (uint32_t i = 0; i < candidate.sampleCount; ++i) {
+      const Vector3 &value = frames[FrameOfSample(i, candidate.stride, lastFrame)];
+      const float components[3] = {value.x, value.y, value.z};
+      for (int c = 0; c < 3; ++c) {
+        float q = candidate.rangeScale[c] > 0.0f
+                      ? std::round((components[c] - candidate.rangeMin[c]) / candidate.rangeScale[c])
+                      : 0.0f;
+        out.push_back(static_cast<uint16_t>(std::clamp(q, 0.0f, kQuantizeMax)));
+      }
+      out.push_back(0);
+    }
+  };
+  auto fits = [&](const Track &candidate, const uint16_t *candidateSamples) {
+    for (size_t i = 0; i < reference.times.size(); ++i) {
+      Segment segment = FindSegment(candidate.stride, candidate.sampleCount, lastFrame,
+                                    FramePosition(grid, reference.times[i]));
+      if (Distance(DecodeVector(candidate, candidateSamples, segment), reference.values[i]) >
+          tolerance) {
+        return false;
+      }
+    }
+    return true;
+  };
+  return ChooseTrack(lastFrame, maxStride, encode, fits, track, samples);
+}
+
+bool BuildRotationTrack(const std::vector<KeyframeQuaternion> &keyframes,
+                        const std::vector<Quaternion> &frames, const FrameGrid &grid,
+                        float tolerance, uint16_t maxStride, Track &track,
+                        std::vector<uint16_t> &samples) {
+  track = {};
+  if (keyframes.empty()) {
+    track.rangeMin[3] = 1.0f;
+    return true;
+  }
+
+  bool isConstant = std::all_of(keyframes.begin(), keyframes.end(), [&](const KeyframeQuaternion &key) {
+    return AngleBetween(NormalizeQuaternion(key.value), NormalizeQuaternion(keyframes[0].value)) <=
+           tolerance;
+  });
+  if (isConstant) {
+    const Quaternion value = NormalizeQuaternion(keyframes[0].value);
+    track.rangeMin[0] = value.x;
+    track.rangeMin[1] = value.y;
+    track.rangeMin[2] = value.z;
+    track.rangeMin[3] = value.w;
+    return true;
+  }
+
+  Reference<Quaternion> reference;
+  MakeReference(keyframes, grid, kRotationReferenceSteps, reference);
+  // Slerp は角度が小さいと正規化しない線形補間を返すので、そろえてから比べる
+  for (Quaternion &value : reference.values) {
+    value = NormalizeQuaternion(value);
+  }
+  const uint32_t lastFrame = grid.frameCount - 1;
+
+  auto encode = [&](Track &candidate, std::vector<uint16_t> &out) {
+    for (uint32_t i = 0; i < candidate.sampleCount; ++i) {
+      const Quaternion value = NormalizeQuaternion(frames[FrameOfSample(i, candidate.stride, lastFrame)]);
+      if (candidate.quantized) {
+        uint16_t packed[kComponentsPerSample];
+        AnimationCompression::PackQuaternion(value, packed);
+        out.insert(out.end(), packed, packed + kComponentsPerSample);
+      } else {
+        PushRaw({value.x, value.y, value.z, value.w}, out);
+      }
+    }
+  };
+  auto fits = [&](const Track &candidate, const uint16_t *candidateSamples) {
+    for (size_t i = 0; i < reference.times.size(); ++i) {
+      Segment segment = FindSegment(candidate.stride, candidate.sampleCount, lastFrame,
+                                    FramePosition(grid, reference.times[i]));
+      if (AngleBetween(DecodeRotation(candidate, candidateSamples, segment), reference.values[i]) >
+          tolerance) {
+        return false;
+      }
+    }
+    return true;
+  };
+  return ChooseTrack(lastFrame, maxStride, encode, fits, track, samples);
+}
+
+// 元のキーの最も短い間隔から、キーがフレームの格子に乗るサンプリングレートを求める
+float SourceSampleRate(const Animation &animation, const AnimationCompression::Settings &settings) {
+  constexpr float kMinInterval = 1.0e-4f; // 同じ時刻に並んだキー（段差）は除く
+  float minInterval = std::numeric_limits<float>::max();
+  auto visit = [&](const auto &keyframes) {
+    for (size_t i = 1; i < keyframes.size(); ++i) {
+      float interval = keyframes[i].time - keyframes[i - 1].time;
+      if (interval > kMinInterval) {
+        minInterval = std::min(minInterval, interval);
+      }
+    }
+  };
+  for (const auto &[name, nodeAnimation] : animation.nodeAnimations) {
+    visit(nodeAnimation.translate.keyframes);
+    visit(nodeAnimation.rotate.keyframes);
+    visit(nodeAnimation.scale.keyframes);
+  }
+  if (minInterval == std::numeric_limits<float>::max()) {
+    return settings.sampleRate;
+  }
+  // 1/60 秒刻みのキーは float の丸めで 59.99… や 60.01… になるので整数に寄せる
+  float rate = 1.0f / minInterval;
+  float rounded = std::round(rate);
+  if (std::fabs(rate - rounded) <= rate * 1.0e-3f) {
+    rate = rounded;
+  }
+  return std::clamp(rate, settings.sampleRate, std::max(settings.sampleRate, settings.maxSampleRate));
+}
+
+// 指定のサンプリングレートで圧縮する。許容誤差に収まらないトラックがあれば false
+bool CompressAt(const Animation &animation, const AnimationCompression::Settings &settings,
+                float sampleRate, CompressedAnimation &result) {
+  result = {};
+  result.duration = std::max(animation.duration, 0.0f);
+  result.sampleRate = sampleRate;
+  // 最後のフレームは duration ちょうどに置く
+  result.frameCount =
+      static_cast<uint32_t>(std::ceil(result.duration * sampleRate - 1.0e-3f)) + 1;
+  result.frameCount = std::max(result.frameCount, 1u);
+  const FrameGrid grid{result.duration, sampleRate, result.frameCount};
+  const uint32_t lastFrame = result.frameCount - 1;
+
+  // std::map なので名前順に並んでいる
+  result.nodeNames.reserve(animation.nodeAnimations.size());
+  result.nodes.reserve(animation.nodeAnimations.size());
+  std::vector<Vector3> vectors(result.frameCount);
+  std::vector<Quaternion> rotations(result.frameCount);
+  bool fits = true;
+
+  for (const auto &[name, nodeAnimation] : animation.nodeAnimations) {
+    CompressedAnimation::NodeTracks tracks;
+
+    auto resampleVector = [&](const std::vector<KeyframeVector3> &keyframes) {
+      vectors.clear();
+      if (keyframes.empty()) {
+        return;
+      }
+      KeyframeCursor cursor;
+      for (uint32_t frame = 0; frame <= lastFrame; ++frame) {
+        vectors.push_back(SampleKeyframes(keyframes, FrameTime(grid, frame), cursor));
+      }
+    };
+
+    resampleVector(nodeAnimation.translate.keyframes);
+    fits &= BuildVectorTrack(nodeAnimation.translate.keyframes, vectors, {0.0f, 0.0f, 0.0f}, grid,
+                             settings.translationTolerance, settings.maxStride, tracks.translate,
+                             result.samples);
+
+    resampleVector(nodeAnimation.scale.keyframes);
+    fits &= BuildVectorTrack(nodeAnimation.scale.keyframes, vectors, {1.0f, 1.0f, 1.0f}, grid,
+                             settings.scaleTolerance, settings.maxStride, tracks.scale,
+                             result.samples);
+
+    rotations.clear();
+    if (!nodeAnimation.rotate.keyframes.empty()) {
+      KeyframeCursor cursor;
+      for (uint32_t frame = 0; frame <= lastFrame; ++frame) {
+        rotations.push_back(
+            SampleKeyframes(nodeAnimation.rotate.keyframes, FrameTime(grid, frame), cursor));
+      }
+    }
+    fits &= BuildRotationTrack(nodeAnimation.rotate.keyframes, rotations, grid,
+                               settings.rotationTolerance, settings.maxStride, tracks.rotate,
+                               result.samples);
+
+    result.nodeNames.push_back(name);
+    result.nodes.push_back(tracks);
+  }
+
+  result.samples.shrink_to_fit();
+  return fits;
+}
+
+// 間隔（2の累乗）ごとの区間。同じ時刻なら同じ間隔のトラックはすべて同じ区間になる
+struct SegmentTable {
+  Segment segments[kMaxStrideShift + 1];
+};
+
+SegmentTable MakeSegmentTable(const CompressedAnimation &animation, float framePosition) {
+  SegmentTable table;
+  const uint32_t lastFrame = animation.frameCount - 1;
+  for (uint32_t shift = 0; shift <= kMaxStrideShift; ++shift) {
+    const uint32_t stride = 1u << shift;
+    table.segments[shift] =
+        FindSegment(stride, SampleCountFor(lastFrame, stride), lastFrame, framePosition);
+  }
+  return table;
+}
+
+const Segment &SegmentOf(const SegmentTable &table, const Track &track) {
+  return table.segments[std::countr_zero(static_cast<uint32_t>(track.stride))];
+}
+
+QuaternionTransform DecodeNode(const CompressedAnimation::NodeTracks &tracks,
+                               const uint16_t *samples, const SegmentTable &table) {
+  QuaternionTransform transform;
+  transform.translate = DecodeVector(tracks.translate, samples, SegmentOf(table, tracks.translate));
+  transform.rotate = DecodeRotation(tracks.rotate, samples, SegmentOf(table, tracks.rotate));
+  transform.scale = DecodeVector(tracks.scale, samples, SegmentOf(table, tracks.scale));
+  return transform;
+}
+
+} // namespace
+
+int32_t CompressedAnimation::FindNode(const std::string &name) const {
+  auto it = std::lower_bound(nodeNames.begin(), nodeNames.end(), name);
+  if (it == nodeNames.end() || *it != name) {
+    return -1;
+  }
+  return static_cast<int32_t>(it - nodeNames.begin());
+}
+
+size_t CompressedAnimation::GetMemorySize() const {
+  size_t size = sizeof(CompressedAnimation);
+  size += samples.size() * sizeof(uint16_t);
+  size += nodes.size() * sizeof(NodeTracks);
+  for (const std::string &name : nodeNames) {
+    size += sizeof(std::string) + name.size();
+  }
+  return size;
+}
+
+namespace AnimationCompression {
+
+void PackQuaternion(const Quaternion &q, uint16_t out[4]) {
+  const float components[4] = {q.x, q.y, q.z, q.w};
+  uint16_t largest = 0;
+  for (uint16_t i = 1; i < 4; ++i) {
+    if (std::fabs(components[i]) > std::fabs(components[largest])) {
+      largest = i;
+    }
+  }
+  // 捨てる成分が正になる向きにそろえる（q と -q は同じ回転）
+  const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+  int written = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (i == largest) {
+      continue;
+    }
+    float value = components[i] * sign;
+    float quantized = std::round((value + kSmallestThreeRange) / kSmallestThreeStep);
+    out[written++] = static_cast<uint16_t>(std::clamp(quantized, 0.0f, kSmallestThreeMax));
+  }
+  out[3] = largest;
+}
+
+Quaternion UnpackQuaternion(const uint16_t in[4]) {
+  const float a = static_cast<float>(in[0]) * kSmallestThreeStep - kSmallestThreeRange;
+  const float b = static_cast<float>(in[1]) * kSmallestThreeStep - kSmallestThreeRange;
+  const float c = static_cast<float>(in[2]) * kSmallestThreeStep - kSmallestThreeRange;
+  const float largest = std::sqrt(std::max(0.0f, 1.0f - (a * a + b * b + c * c)));
+  switch (in[3] & 3u) {
+  case 0:
+    return {largest, a, b, c};
+  case 1:
+    return {a, largest, b, c};
+  case 2:
+    return {a, b, largest, c};
+  default:
+    return {a, b, c, largest};
+  }
+}
+
+CompressedAnimation Compress(const Animation &animation, const Settings &settings) {
+  assert(settings.sampleRate > 0.0f);
+  assert(std::has_single_bit(settings.maxStride) &&
+         settings.maxStride <= (1u << kMaxStrideShift));
+
+  // 元のキーの間隔に合わせたレートから始め、収まらないトラックがあればレートを倍にして作り直す
+  float sampleRate = SourceSampleRate(animation, settings);
+  CompressedAnimation result;
+  while (!CompressAt(animation, settings, sampleRate, result) &&
+         sampleRate < settings.maxSampleRate) {
+    sampleRate = std::min(sampleRate * 2.0f, settings.maxSampleRate);
+  }
+  return result;
+}
+
+QuaternionTransform SampleNode(const CompressedAnimation &animation, uint32_t nodeIndex,
+                               float time) {
+  assert(nodeIndex < animation.nodes.size());
+  const SegmentTable table = MakeSegmentTable(animation, FramePosition(animation, time));
+  return DecodeNode(animation.nodes[nodeIndex], animation.samples.data(), table);
+}
+
+void SamplePose(const CompressedAnimation &animation, float time, QuaternionTransform *outPose) {
+  // 区間は間隔（stride）ごとに全ノード共通なので、先に求めておく
+  const SegmentTable table = MakeSegmentTable(animation, FramePosition(animation, time));
+  const uint16_t *samples = animation.samples.data();
+  const uint32_t nodeCount = static_cast<uint32_t>(animation.nodes.size());
+  for (uint32_t i = 0; i < nodeCount; ++i) {
+    outPose[i] = DecodeNode(animation.nodes[i], samples, table);
+  }
+}
+
+void SampleNodes(const CompressedAnimation &animation, float time, const uint32_t *nodeIndices,
+                 const int32_t *outIndices, size_t count, QuaternionTransform *outPose) {
+  const SegmentTable table = MakeSegmentTable(animation, FramePosition(animation, time));
+  const uint16_t *samples = animation.samples.data();
+  for (size_t i = 0; i < count; ++i) {
+    assert(nodeIndices[i] < animation.nodes.size());
+    outPose[outIndices[i]] = DecodeNode(animation.nodes[nodeIndices[i]], samples, table);
+  }
+}
+
+size_t GetMemorySize(const Animation &animation) {
+  size_t size = sizeof(Animation);
+  for (const auto &[name, nodeAnimation] : animation.nodeAnimations) {
+    // map のノード（左右・親へのポインタと色）の分も目安として足す
+    size += sizeof(std::string) + name.size() + sizeof(NodeAnimation) + 4 * sizeof(void *);
+    size += nodeAnimation.translate.keyframes.size() * sizeof(KeyframeVector3);
+    size += nodeAnimation.rotate.keyframes.size() * sizeof(KeyframeQuaternion);
+    size += nodeAnimation.scale.keyframes.size() * sizeof(KeyframeVector3);
+  }
+  return size;
+}
+
+} // namespace AnimationCompression
@@ -0,0 +1,426 @@
+#include "Model/MeshCache.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace MeshCache {
+namespace {
+
+constexpr char kMagic[4] = {'M', 'S', 'H', 'C'};
+
+// キャッシュの置き場所。resources の外に置いて、アセット索引の監視に引っかからないようにする
+std::string gCacheDirectory = "cache/mesh";
+
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t sourceHash;
+  uint32_t importFlags;
+  uint32_t vertexStride; // 頂点レイアウトが変わったキャッシュを弾くため
+  uint32_t vertexCount;
+  uint32_t indexCount;
+  uint32_t nodeCount;
+  uint32_t jointCount;
+  uint32_t weightCount;
+  uint32_t subMeshCount;
+  uint32_t materialCount;
+  uint32_t stringBytes;
+  uint32_t lodCount;
+  uint32_t lodSubMeshCount;
+  uint32_t reserved; // 8バイト境界に揃える
+};
+
+// LOD のサブメッシュは LOD ごとに続けて並べる
+struct LodRecord {
+  float error;
+  float screenSize;
+  uint32_t firstSubMesh;
+  uint32_t subMeshCount;
+};
+
+struct MaterialRecord {
+  uint32_t textureOffset;
+  uint32_t textureLength;
+};
+
+// ノードは行きがけ順に並べ、子の数から階層を復元する
+struct NodeRecord {
+  QuaternionTransform transform;
+  Matrix4x4 localMatrix;
+  uint32_t nameOffset;
+  uint32_t nameLength;
+  uint32_t childCount;
+};
+
+struct JointRecord {
+  Matrix4x4 inverseBindPoseMatrix;
+  uint32_t nameOffset;
+  uint32_t nameLength;
+  uint32_t firstWeight;
+  uint32_t weightCount;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+static_assert(std::is_trivially_copyable_v<NodeRecord>);
+static_assert(std::is_trivially_copyable_v<JointRecord>);
+static_assert(std::is_trivially_copyable_v<MaterialRecord>);
+static_assert(std::is_trivially_copyable_v<LodRecord>);
+static_assert(std::is_trivially_copyable_v<ModelAsset::SubMesh>);
+static_assert(std::is_trivially_copyable_v<ModelAsset::VertexData>);
+static_assert(std::is_trivially_copyable_v<ModelAsset::VertexWeightData>);
+
+uint64_t PayloadBytes(const FileHeader &header) {
+  return uint64_t(header.vertexCount) * sizeof(ModelAsset::VertexData) +
+         uint64_t(header.indexCount) * sizeof(uint32_t) +
+         uint64_t(header.nodeCount) * sizeof(NodeRecord) +
+         uint64_t(header.jointCount) * sizeof(JointRecord) +
+         uint64_t(header.weightCount) * sizeof(ModelAsset::VertexWeightData) +
+         uint64_t(header.subMeshCount) * sizeof(ModelAsset::SubMesh) +
+         uint64_t(header.materialCount) * sizeof(MaterialRecord) +
+         uint64_t(header.lodCount) * sizeof(LodRecord) +
+         uint64_t(header.lodSubMeshCount) * sizeof(ModelAsset::SubMesh) +
+         uint64_t(header.stringBytes);
+}
+
+uint32_t AppendString(std::string &table, const std::string &value) {
+  uint32_t offset = static_cast<uint32_t>(table.size());
+  table += value;
+  return offset;
+}
+
+void FlattenNode(const ModelAsset::Node &node, std::vector<NodeRecord> &records,
+                 std::string &strings) {
+  NodeRecord record{};
+  record.transform = node.transform;
+  record.localMatrix = node.localMatrix;
+  record.nameOffset = AppendString(strings, node.name);
+  record.nameLength = static_cast<uint32_t>(node.name.size());
+  record.childCount = static_cast<uint32_t>(node.children.size());
+  records.push_back(record);
+
+  for (const ModelAsset::Node &child : node.children) {
+    FlattenNode(child, records, strings);
+  }
+}
+
+bool ReadString(const std::string &strings, uint32_t offset, uint32_t length, std::string &out) {
+  if (uint64_t(offset) + length > strings.size()) {
+    return false;
+  }
+  out.assign(strings, offset, length);
+  return true;
+}
+
+bool BuildNode(const std::vector<NodeRecord> &records, const std::string &strings, size_t &cursor,
+               ModelAsset::Node &out) {
+  if (cursor >= records.size()) {
+    return false;
+  }
+  const NodeRecord &record = records[cursor++];
+  out.transform = record.transform;
+  out.localMatrix = record.localMatrix;
+  if (!ReadString(strings, record.nameOffset, record.nameLength, out.name)) {
+    return false;
+  }
+
+  // 壊れたファイルで巨大な確保をしないよう、残りのレコード数を超える子は不正とみなす
+  if (record.childCount > records.size() - cursor) {
+    return false;
+  }
+  out.children.resize(record.childCount);
+  for (ModelAsset::Node &child : out.children) {
+    if (!BuildNode(records, strings, cursor, child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T> bool ReadArray(std::ifstream &file, std::vector<T> &out, uint32_t count) {
+  out.resize(count);
+  if (count == 0) {
+    return true;
+  }
+  file.read(reinterpret_cast<char *>(out.data()), std::streamsize(sizeof(T)) * count);
+  return static_cast<bool>(file);
+}
+
+template <typename T> void WriteArray(std::ofstream &file, const std::vector<T> &values) {
+  if (!values.empty()) {
+    file.write(reinterpret_cast<const char *>(values.data()),
+               std::streamsize(sizeof(T) * values.size()));
+  }
+}
+
+// 64bit FNV-1a を8バイト単位で回したもの（改ざん検知ではなく変更検知用）
+constexpr uint64_t kHashOffset = 14695981039346656037ull;
+constexpr uint64_t kHashPrime = 1099511628211ull;
+
+bool HashFile(const std::string &path, uint64_t &hash) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  std::vector<char> buffer(1 << 20);
+  uint64_t totalBytes = 0;
+  while (file) {
+    file.read(buffer.data(), std::streamsize(buffer.size()));
+    size_t bytes = static_cast<size_t>(file.gcount());
+    totalBytes += bytes;
+
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, buffer.data() + i, 8);
+      hash = (hash ^ word) * kHashPrime;
+    }
+    for (; i < bytes; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(buffer[i])) * kHashPrime;
+    }
+  }
+  hash = (hash ^ totalBytes) * kHashPrime;
+  return true;
+}
+
+} // namespace
+
+void SetCacheDirectory(const std::string &directory) { gCacheDirectory = directory; }
+
+const std::string &GetCacheDirectory() { return gCacheDirectory; }
+
+std::string GetCachePath(const std::string &sourcePath) {
+  // パス区切りを置き換えて1階層のファイル名にする（resources/a/b.obj -> resources_a_b.obj.mesh）
+  std::string name = fs::path(sourcePath).lexically_normal().generic_string();
+  for (char &c : name) {
+    if (c == '/' || c == '\\' || c == ':') {
+      c = '_';
+    }
+  }
+  return gCacheDirectory + "/" + name + ".mesh";
+}
+
+uint64_t HashSourceFiles(const std::string &sourcePath) {
+  uint64_t hash = kHashOffset;
+  if (!HashFile(sourcePath, hash)) {
+    return 0;
+  }
+
+  // マテリアルやバッファを別ファイルに持つ形式は、同名の付随ファイルも含める
+  fs::path path(sourcePath);
+  std::string extension = path.extension().string();
+  fs::path companion;
+  if (extension == ".obj") {
+    companion = fs::path(path).replace_extension(".mtl");
+  } else if (extension == ".gltf") {
+    companion = fs::path(path).replace_extension(".bin");
+  }
+  if (!companion.empty()) {
+    HashFile(companion.string(), hash);
+  }
+  return hash;
+}
+
+bool Save(const std::string &cachePath, const Key &key, const ModelAsset::ModelData &modelData) {
+  std::string strings;
+  std::vector<NodeRecord> nodes;
+  FlattenNode(modelData.rootNode, nodes, strings);
+
+  std::vector<JointRecord> joints;
+  std::vector<ModelAsset::VertexWeightData> weights;
+  joints.reserve(modelData.skinClusterData.size());
+  for (const auto &[name, jointWeight] : modelData.skinClusterData) {
+    JointRecord record{};
+    record.inverseBindPoseMatrix = jointWeight.inverseBindPoseMatrix;
+    record.nameOffset = AppendString(strings, name);
+    record.nameLength = static_cast<uint32_t>(name.size());
+    record.firstWeight = static_cast<uint32_t>(weights.size());
+    record.weightCount = static_cast<uint32_t>(jointWeight.vertexWeights.size());
+    weights.insert(weights.end(), jointWeight.vertexWeights.begin(),
+                   jointWeight.vertexWeights.end());
+    joints.push_back(record);
+  }
+
+  std::vector<MaterialRecord> materials;
+  materials.reserve(modelData.materials.size());
+  for (const ModelAsset::MaterialData &material : modelData.materials) {
+    materials.push_back({AppendString(strings, material.textureFilePath),
+                         static_cast<uint32_t>(material.textureFilePath.size())});
+  }
+
+  std::vector<LodRecord> lods;
+  std::vector<ModelAsset::SubMesh> lodSubMeshes;
+  lods.reserve(modelData.lods.size());
+  for (const ModelAsset::MeshLod &lod : modelData.lods) {
+    lods.push_back({lod.error, lod.screenSize, static_cast<uint32_t>(lodSubMeshes.size()),
+                    static_cast<uint32_t>(lod.subMeshes.size())});
+    lodSubMeshes.insert(lodSubMeshes.end(), lod.subMeshes.begin(), lod.subMeshes.end());
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.sourceHash = key.sourceHash;
+  header.importFlags = key.importFlags;
+  header.vertexStride = sizeof(ModelAsset::VertexData);
+  header.vertexCount = static_cast<uint32_t>(modelData.vertices.size());
+  header.indexCount = static_cast<uint32_t>(modelData.indices.size());
+  header.nodeCount = static_cast<uint32_t>(nodes.size());
+  header.jointCount = static_cast<uint32_t>(joints.size());
+  header.weightCount = static_cast<uint32_t>(weights.size());
+  header.subMeshCount = static_cast<uint32_t>(modelData.subMeshes.size());
+  header.materialCount = static_cast<uint32_t>(materials.size());
+  header.stringBytes = static_cast<uint32_t>(strings.size());
+  header.lodCount = static_cast<uint32_t>(lods.size());
+  header.lodSubMeshCount = static_cast<uint32_t>(lodSubMeshes.size());
+
+  std::error_code ec;
+  fs::path path(cachePath);
+  if (path.has_parent_path()) {
+    fs::create_directories(path.parent_path(), ec);
+  }
+
+  // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+  const std::string tempPath = cachePath + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    WriteArray(file, modelData.vertices);
+    WriteArray(file, modelData.indices);
+    WriteArray(file, nodes);
+    WriteArray(file, joints);
+    WriteArray(file, weights);
+    WriteArray(file, modelData.subMeshes);
+    WriteArray(file, materials);
+    WriteArray(file, lods);
+    WriteArray(file, lodSubMeshes);
+    file.write(strings.data(), std::streamsize(strings.size()));
+    if (!file) {
+      return false;
+    }
+  }
+
+  fs::rename(tempPath, cachePath, ec);
+  if (ec) {
+    fs::remove(tempPath, ec);
+    return false;
+  }
+  return true;
+}
+
+bool Load(const std::string &cachePath, const Key &key, ModelAsset::ModelData &outModelData) {
+  std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    return false;
+  }
+  const uint64_t fileBytes = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+
+  FileHeader header{};
+  if (fileBytes < sizeof(header) ||
+      !file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+
+  // 別物・古い・途中で切れたキャッシュは使わない
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+      header.sourceHash != key.sourceHash || header.importFlags != key.importFlags ||
+      header.vertexStride != sizeof(ModelAsset::VertexData) ||
+      fileBytes != sizeof(header) + PayloadBytes(header)) {
+    return false;
+  }
+
+  // 各セクションは配置先の配列へ直接読み込む（解析は不要）
+  ModelAsset::ModelData modelData;
+  std::vector<NodeRecord> nodes;
+  std::vector<JointRecord> joints;
+  std::vector<ModelAsset::VertexWeightData> weights;
+  std::vector<MaterialRecord> materials;
+  std::vector<LodRecord> lods;
+  std::vector<ModelAsset::SubMesh> lodSubMeshes;
+  std::string strings(header.stringBytes, '\0');
+  if (!ReadArray(file, modelData.vertices, header.vertexCount) ||
+      !ReadArray(file, modelData.indices, header.indexCount) ||
+      !ReadArray(file, nodes, header.nodeCount) || !ReadArray(file, joints, header.jointCount) ||
+      !ReadArray(file, weights, header.weightCount) ||
+      !ReadArray(file, modelData.subMeshes, header.subMeshCount) ||
+      !ReadArray(file, materials, header.materialCount) ||
+      !ReadArray(file, lods, header.lodCount) ||
+      !ReadArray(file, lodSubMeshes, header.lodSubMeshCount) ||
+      !file.read(strings.data(), std::streamsize(strings.size()))) {
+    return false;
+  }
+
+  size_t cursor = 0;
+  if (!BuildNode(nodes, strings, cursor, modelData.rootNode) || cursor != nodes.size()) {
+    return false;
+  }
+
+  // 重みが頂点バッファの外を指していたら壊れている（Skinning で頂点ごとに数えるときに範囲外へ書く）
+  const uint64_t vertexCount = modelData.vertices.size();
+  if (!std::all_of(weights.begin(), weights.end(), [&](const ModelAsset::VertexWeightData &weight) {
+        return weight.vertexIndex < vertexCount;
+      })) {
+    return false;
+  }
+
+  for (const JointRecord &record : joints) {
+    std::string name;
+    if (!ReadString(strings, record.nameOffset, record.nameLength, name) ||
+        uint64_t(record.firstWeight) + record.weightCount > weights.size()) {
+      return false;
+    }
+    ModelAsset::JointWeightData &jointWeight = modelData.skinClusterData[name];
+    jointWeight.inverseBindPoseMatrix = record.inverseBindPoseMatrix;
+    jointWeight.vertexWeights.assign(weights.begin() + record.firstWeight,
+                                     weights.begin() + record.firstWeight + record.weightCount);
+  }
+
+  modelData.materials.resize(materials.size());
+  for (size_t i = 0; i < materials.size(); ++i) {
+    if (!ReadString(strings, materials[i].textureOffset, materials[i].textureLength,
+                    modelData.materials[i].textureFilePath)) {
+      return false;
+    }
+  }
+
+  for (const LodRecord &record : lods) {
+    if (uint64_t(record.firstSubMesh) + record.subMeshCount > lodSubMeshes.size()) {
+      return false;
+    }
+    modelData.lods.push_back({record.error, record.screenSize,
+                              std::vector<ModelAsset::SubMesh>(
+                                  lodSubMeshes.begin() + record.firstSubMesh,
+                                  lodSubMeshes.begin() + record.firstSubMesh + record.subMeshCount)});
+  }
+
+  // サブメッシュが結合バッファの外を指していたら壊れている
+  // インデックスもサブメッシュの頂点の範囲に収まっていなければ、描画で頂点バッファの外を読む
+  auto isValidSubMesh = [&](const ModelAsset::SubMesh &subMesh) {
+    if (uint64_t(subMesh.indexOffset) + subMesh.indexCount > modelData.indices.size() ||
+        uint64_t(subMesh.vertexOffset) + subMesh.vertexCount > vertexCount ||
+        (!modelData.materials.empty() && subMesh.materialIndex >= modelData.materials.size())) {
+      return false;
+    }
+    const uint32_t *indices = modelData.indices.data() + subMesh.indexOffset;
+    return std::all_of(indices, indices + subMesh.indexCount, [&](uint32_t index) {
+      return index >= subMesh.vertexOffset && index - subMesh.vertexOffset < subMesh.vertexCount;
+    });
+  };
+  if (!std::all_of(modelData.subMeshes.begin(), modelData.subMeshes.end(), isValidSubMesh) ||
+      !std::all_of(lodSubMeshes.begin(), lodSubMeshes.end(), isValidSubMesh)) {
+    return false;
+  }
+
+  outModelData = std::move(modelData);
+  return true;
+}
+
+} // namespace MeshCache
@@ -0,0 +1,454 @@
+#include "Model/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace MeshOptimizer {
+namespace {
+
+constexpr uint32_t kInvalid = 0xffffffffu;
+
+// キャッシュ模擬の集計値（サブメッシュをまたいで合算するため比率にする前の値で持つ）
+struct CacheCounts {
+  uint64_t misses = 0;
+  uint64_t triangles = 0;
+  uint64_t vertices = 0; // 参照された頂点の数
+};
+
+CacheCounts CountCacheMisses(std::span<const uint32_t> indices, uint32_t vertexCount,
+                             uint32_t cacheSize) {
+  CacheCounts counts;
+  // FIFO: 入った時刻だけを記録し、ヒットしても更新しない
+  std::vector<uint32_t> insertedAt(vertexCount, 0);
+  uint32_t time = 0;
+  for (uint32_t index : indices) {
+    uint32_t stamp = insertedAt[index];
+    if (stamp == 0) {
+      ++counts.vertices;
+    }
+    if (stamp == 0 || time - stamp >= cacheSize) {
+      ++time;
+      insertedAt[index] = time;
+      ++counts.misses;
+    }
+  }
+  counts.triangles = indices.size() / 3;
+  return counts;
+}
+
+CacheStats ToStats(const CacheCounts &counts) {
+  CacheStats stats;
+  if (counts.triangles > 0) {
+    stats.acmr = float(double(counts.misses) / double(counts.triangles));
+  }
+  if (counts.vertices > 0) {
+    stats.atvr = float(double(counts.misses) / double(counts.vertices));
+  }
+  return stats;
+}
+
+// 頂点ごとのスキンウェイト（結合の判定とウェイトの付け替えに使う）
+using WeightSignature = std::vector<std::pair<uint32_t, float>>;
+
+std::vector<WeightSignature> BuildWeightSignatures(const ModelAsset::ModelData &modelData) {
+  std::vector<WeightSignature> signatures;
+  if (modelData.skinClusterData.empty()) {
+    return signatures;
+  }
+  signatures.resize(modelData.vertices.size());
+  uint32_t jointIndex = 0;
+  for (const auto &[name, joint] : modelData.skinClusterData) {
+    for (const ModelAsset::VertexWeightData &weight : joint.vertexWeights) {
+      if (weight.vertexIndex < signatures.size()) {
+        signatures[weight.vertexIndex].emplace_back(jointIndex, weight.weight);
+      }
+    }
+    ++jointIndex;
+  }
+  for (WeightSignature &signature : signatures) {
+    std::sort(signature.begin(), signature.end());
+  }
+  return signatures;
+}
+
+uint64_t HashVertex(const ModelAsset::VertexData &vertex) {
+  // 64bit FNV-1a（完全一致の判定なのでビット列をそのまま使う）
+  uint32_t words[sizeof(ModelAsset::VertexData) / 4];
+  std::memcpy(words, &vertex, sizeof(words));
+  uint64_t hash = 14695981039346656037ull;
+  for (uint32_t word : words) {
+    hash = (hash ^ word) * 1099511628211ull;
+  }
+  return hash;
+}
+
+/// <summary>
+/// サブメッシュ内の完全に同じ頂点をまとめる
+/// </summary>
+/// <returns>まとめた後の頂点数。outRemap[旧番号] = 新番号、outUnique[新番号] = 代表の旧番号</returns>
+uint32_t WeldLocal(std::span<const ModelAsset::VertexData> vertices,
+                   const std::vector<WeightSignature> &signatures, uint32_t vertexOffset,
+                   std::vector<uint32_t> &outRemap, std::vector<uint32_t> &outUnique) {
+  outRemap.assign(vertices.size(), kInvalid);
+  outUnique.clear();
+
+  std::unordered_multimap<uint64_t, uint32_t> table;
+  table.reserve(vertices.size());
+  for (uint32_t v = 0; v < vertices.size(); ++v) {
+    uint64_t hash = HashVertex(vertices[v]);
+    auto [begin, end] = table.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      uint32_t candidate = outUnique[it->second];
+      if (std::memcmp(&vertices[candidate], &vertices[v], sizeof(ModelAsset::VertexData)) == 0 &&
+          (signatures.empty() ||
+           signatures[vertexOffset + candidate] == signatures[vertexOffset + v])) {
+        outRemap[v] = it->second;
+        break;
+      }
+    }
+    if (outRemap[v] == kInvalid) {
+      outRemap[v] = static_cast<uint32_t>(outUnique.size());
+      table.emplace(hash, outRemap[v]);
+      outUnique.push_back(v);
+    }
+  }
+  return static_cast<uint32_t>(outUnique.size());
+}
+
+} // namespace
+
+CacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount,
+                              uint32_t cacheSize) {
+  return ToStats(CountCacheMisses(indices, vertexCount, cacheSize));
+}
+
+void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize) {
+  const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+  if (triangleCount == 0 || vertexCount == 0) {
+    return;
+  }
+
+  // 頂点 -> 三角形の隣接リスト（CSR形式）
+  std::vector<uint32_t> live(vertexCount, 0);
+  for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+    live[indices[i]]++;
+  }
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+  for (uint32_t v = 0; v < vertexCount; ++v) {
+    offsets[v + 1] = offsets[v] + live[v];
+  }
+  std::vector<uint32_t> adjacency(offsets[vertexCount]);
+  {
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+      for (uint32_t k = 0; k < 3; ++k) {
+        adjacency[cursor[indices[t * 3 + k]]++] = t;
+      }
+    }
+  }
+
+  std::vector<uint32_t> cacheTime(vertexCount, 0);
+  std::vector<uint8_t> emitted(triangleCount, 0);
+  std::vector<uint32_t> deadEnd;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> output;
+  output.reserve(triangleCount * 3);
+
+  uint32_t timeStamp = cacheSize + 1;
+  uint32_t scanCursor = 0;
+  uint32_t fanning = 0;
+  while (fanning != kInvalid) {
+    candidates.clear();
+
+    // 扇の中心の頂点を使う三角形をすべて出力する
+    for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+      uint32_t t = adjacency[a];
+      if (emitted[t]) {
+        continue;
+      }
+      for (uint32_t k = 0; k < 3; ++k) {
+        uint32_t v = indices[t * 3 + k];
+        output.push_back(v);
+        deadEnd.push_back(v);
+        candidates.push_back(v);
+        live[v]--;
+        if (timeStamp - cacheTime[v] > cacheSize) {
+          cacheTime[v] = timeStamp++;
+        }
+      }
+      emitted[t] = 1;
+    }
+
+    // 次の中心: キャッシュに残っていて、使い切れそうな頂点を優先する
+    uint32_t next = kInvalid;
+    int64_t bestPriority = -1;
+    for (uint32_t v : candidates) {
+      if (live[v] == 0) {
+        continue;
+      }
+      int64_t priority = 0;
+      if (int64_t(timeStamp) - cacheTime[v] + 2 * int64_t(live[v]) <= int64_t(cacheSize)) {
+        priority = int64_t(timeStamp) - cacheTime[v];
+      }
+      if (priority > bestPriority) {
+        bestPriority = priority;
+        next = v;
+      }
+    }
+
+    // 行き止まり: 最近使った頂点、それもなければ番号順に未使用の頂点を探す
+    if (next == kInvalid) {
+      while (!deadEnd.empty()) {
+        uint32_t v = deadEnd.back();
+        deadEnd.pop_back();
+        if (live[v] > 0) {
+          next = v;
+          break;
+        }
+      }
+    }
+    while (next == kInvalid && scanCursor < vertexCount) {
+      if (live[scanCursor] > 0) {
+        next = scanCursor;
+      }
+      ++scanCursor;
+    }
+    fanning = next;
+  }
+
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const ModelAsset::VertexData> vertices,
+                      uint32_t cacheSize) {
+  const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+  if (triangleCount < 2) {
+    return;
+  }
+
+  // キャッシュが全部外れる三角形（Tipsify の行き止まり）でクラスタを区切る
+  std::vector<uint32_t> clusterStarts;
+  {
+    std::vector<uint32_t> insertedAt(vertices.size(), 0);
+    uint32_t time = 0;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+      uint32_t misses = 0;
+      for (uint32_t k = 0; k < 3; ++k) {
+        uint32_t v = indices[t * 3 + k];
+        if (insertedAt[v] == 0 || time - insertedAt[v] >= cacheSize) {
+          insertedAt[v] = ++time;
+          ++misses;
+        }
+      }
+      if (t == 0 || misses == 3) {
+        clusterStarts.push_back(t);
+      }
+    }
+  }
+  if (clusterStarts.size() < 2) {
+    return;
+  }
+  clusterStarts.push_back(triangleCount);
+
+  // メッシュ全体の中心
+  Vector3 meshCenter{0.0f, 0.0f, 0.0f};
+  for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+    const Vector4 &p = vertices[indices[i]].position;
+    meshCenter = {meshCenter.x + p.x, meshCenter.y + p.y, meshCenter.z + p.z};
+  }
+  float inv = 1.0f / float(triangleCount * 3);
+  meshCenter = {meshCenter.x * inv, meshCenter.y * inv, meshCenter.z * inv};
+
+  // 外側を向いているクラスタほど手前の面を覆うので先に描く
+  struct Cluster {
+    uint32_t begin;
+    uint32_t end;
+    float sortKey;
+  };
+  std::vector<Cluster> clusters;
+  for (size_t c = 0; c + 1 < clusterStarts.size(); ++c) {
+    Vector3 center{0.0f, 0.0f, 0.0f};
+    Vector3 normal{0.0f, 0.0f, 0.0f};
+    for (uint32_t i = clusterStarts[c] * 3; i < clusterStarts[c + 1] * 3; ++i) {
+      const ModelAsset::VertexData &v = vertices[indices[i]];
+      center = {center.x + v.position.x, center.y + v.position.y, center.z + v.position.z};
+      normal = {normal.x + v.normal.x, normal.y + v.normal.y, normal.z + v.normal.z};
+    }
+    float count = float((clusterStarts[c + 1] - clusterStarts[c]) * 3);
+    Vector3 offset = {center.x / count - meshCenter.x, center.y / count - meshCenter.y,
+                      center.z / count - meshCenter.z};
+    float normalLength =
+        std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+    float key = 0.0f;
+    if (normalLength > 0.0f) {
+      key = (offset.x * normal.x + offset.y * normal.y + offset.z * normal.z) / normalLength;
+    }
+    clusters.push_back({clusterStarts[c], clusterStarts[c + 1], key});
+  }
+  std::stable_sort(clusters.begin(), clusters.end(),
+                   [](const Cluster &a, const Cluster &b) { return a.sortKey > b.sortKey; });
+
+  std::vector<uint32_t> output;
+  output.reserve(triangleCount * 3);
+  for (const Cluster &cluster : clusters) {
+    output.insert(output.end(), indices.begin() + cluster.begin * 3,
+                  indices.begin() + cluster.end * 3);
+  }
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+Report Optimize(ModelAsset::ModelData &modelData, const Options &options) {
+  Report report;
+  report.verticesBefore = static_cast<uint32_t>(modelData.vertices.size());
+  report.verticesAfter = report.verticesBefore;
+  if (modelData.indices.empty() || modelData.vertices.empty()) {
+    return report;
+  }
+
+  // サブメッシュ情報がなければ全体を1つとして扱う
+  std::vector<ModelAsset::SubMesh> subMeshes = modelData.subMeshes;
+  if (subMeshes.empty()) {
+    subMeshes.push_back({0, static_cast<uint32_t>(modelData.vertices.size()), 0,
+                         static_cast<uint32_t>(modelData.indices.size()), 0});
+  }
+
+  const std::vector<WeightSignature> signatures = BuildWeightSignatures(modelData);
+  const uint32_t oldVertexCount = static_cast<uint32_t>(modelData.vertices.size());
+
+  std::vector<ModelAsset::VertexData> newVertices;
+  std::vector<uint32_t> newIndices;
+  newVertices.reserve(modelData.vertices.size());
+  newIndices.reserve(modelData.indices.size());
+
+  // 旧頂点番号 -> 新頂点番号（まとめられた頂点は代表と同じ番号）。ウェイトは代表の分だけ残す
+  std::vector<uint32_t> globalRemap(oldVertexCount, kInvalid);
+  std::vector<uint8_t> isRepresentative(oldVertexCount, 0);
+
+  CacheCounts before;
+  CacheCounts after;
+  std::vector<uint32_t> localRemap;
+  std::vector<uint32_t> unique;
+  std::vector<uint32_t> fetchOrder;
+  std::vector<uint32_t> localIndices;
+
+  for (ModelAsset::SubMesh &subMesh : subMeshes) {
+    std::span<const ModelAsset::VertexData> vertices(
+        modelData.vertices.data() + subMesh.vertexOffset, subMesh.vertexCount);
+    localIndices.resize(subMesh.indexCount);
+    for (uint32_t i = 0; i < subMesh.indexCount; ++i) {
+      localIndices[i] = modelData.indices[subMesh.indexOffset + i] - subMesh.vertexOffset;
+    }
+
+    CacheCounts counts = CountCacheMisses(localIndices, subMesh.vertexCount, options.cacheSize);
+    before.misses += counts.misses;
+    before.triangles += counts.triangles;
+    before.vertices += counts.vertices;
+
+    // 1. 重複頂点の結合
+    uint32_t uniqueCount = subMesh.vertexCount;
+    if (options.weldVertices) {
+      uniqueCount = WeldLocal(vertices, signatures, subMesh.vertexOffset, localRemap, unique);
+      for (uint32_t &index : localIndices) {
+        index = localRemap[index];
+      }
+    } else {
+      localRemap.resize(subMesh.vertexCount);
+      unique.resize(subMesh.vertexCount);
+      for (uint32_t v = 0; v < subMesh.vertexCount; ++v) {
+        localRemap[v] = v;
+        unique[v] = v;
+      }
+    }
+
+    // 2. 頂点キャッシュ向けの三角形の並べ替えと、オーバードローを減らすクラスタ順
+    if (options.optimizeVertexCache) {
+      OptimizeVertexCache(localIndices, uniqueCount, options.cacheSize);
+      if (options.optimizeOverdraw) {
+        std::vector<ModelAsset::VertexData> welded(uniqueCount);
+        for (uint32_t v = 0; v < uniqueCount; ++v) {
+          welded[v] = vertices[unique[v]];
+        }
+        OptimizeOverdraw(localIndices, welded, options.cacheSize);
+      }
+    }
+
+    // 3. 頂点を最初に使われる順に並べる（使われない頂点は捨てる）
+    fetchOrder.assign(uniqueCount, kInvalid);
+    uint32_t newLocalCount = 0;
+    if (options.optimizeVertexFetch) {
+      std::vector<uint32_t> order;
+      order.reserve(uniqueCount);
+      for (uint32_t &index : localIndices) {
+        if (fetchOrder[index] == kInvalid) {
+          fetchOrder[index] = newLocalCount++;
+          order.push_back(index);
+        }
+        index = fetchOrder[index];
+      }
+      std::vector<uint32_t> reordered(order.size());
+      for (size_t i = 0; i < order.size(); ++i) {
+        reordered[i] = unique[order[i]];
+      }
+      unique = std::move(reordered);
+    } else {
+      for (uint32_t u = 0; u < uniqueCount; ++u) {
+        fetchOrder[u] = u;
+      }
+      newLocalCount = uniqueCount;
+      unique.resize(uniqueCount);
+    }
+
+    // 新しいバッファに書き出す
+    const uint32_t newOffset = static_cast<uint32_t>(newVertices.size());
+    for (uint32_t n = 0; n < newLocalCount; ++n) {
+      newVertices.push_back(vertices[unique[n]]);
+      isRepresentative[subMesh.vertexOffset + unique[n]] = 1;
+    }
+    for (uint32_t v = 0; v < subMesh.vertexCount; ++v) {
+      uint32_t local = fetchOrder[localRemap[v]];
+      if (local != kInvalid) {
+        globalRemap[subMesh.vertexOffset + v] = newOffset + local;
+      }
+    }
+
+    counts = CountCacheMisses(localIndices, newLocalCount, options.cacheSize);
+    after.misses += counts.misses;
+    after.triangles += counts.triangles;
+    after.vertices += counts.vertices;
+
+    subMesh.vertexOffset = newOffset;
+    subMesh.vertexCount = newLocalCount;
+    subMesh.indexOffset = static_cast<uint32_t>(newIndices.size());
+    for (uint32_t index : localIndices) {
+      newIndices.push_back(index + newOffset);
+    }
+  }
+
+  // スキンのウェイトを新しい頂点番号に付け替える（まとめられた頂点の分は重複するので捨てる）
+  for (auto &[name, joint] : modelData.skinClusterData) {
+    std::vector<ModelAsset::VertexWeightData> remapped;
+    remapped.reserve(joint.vertexWeights.size());
+    for (const ModelAsset::VertexWeightData &weight : joint.vertexWeights) {
+      if (weight.vertexIndex < oldVertexCount && isRepresentative[weight.vertexIndex] &&
+          globalRemap[weight.vertexIndex] != kInvalid) {
+        remapped.push_back({weight.weight, globalRemap[weight.vertexIndex]});
+      }
+    }
+    joint.vertexWeights = std::move(remapped);
+  }
+
+  modelData.vertices = std::move(newVertices);
+  modelData.indices = std::move(newIndices);
+  if (!modelData.subMeshes.empty()) {
+    modelData.subMeshes = std::move(subMeshes);
+  }
+
+  report.verticesAfter = static_cast<uint32_t>(modelData.vertices.size());
+  report.before = ToStats(before);
+  report.after = ToStats(after);
+  return report;
+}
+
+} // namespace MeshOptimizer
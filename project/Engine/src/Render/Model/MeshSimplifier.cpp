@@ -0,0 +1,558 @@
+#include "Model/MeshSimplifier.h"
+#include "Math/MathUtil.h"
+#include "Model/MeshOptimizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace MeshSimplifier {
+namespace {
+
+/// <summary>
+/// 平面までの距離の二乗和を表す対称 4x4 行列（面積で重み付け）
+/// </summary>
+struct Quadric {
+  double a2 = 0, ab = 0, ac = 0, ad = 0;
+  double b2 = 0, bc = 0, bd = 0;
+  double c2 = 0, cd = 0;
+  double d2 = 0;
+  double weight = 0;
+
+  void AddPlane(double a, double b, double c, double d, double w) {
+    a2 += w * a * a;
+    ab += w * a * b;
+    ac += w * a * c;
+    ad += w * a * d;
+    b2 += w * b * b;
+    bc += w * b * c;
+    bd += w * b * d;
+    c2 += w * c * c;
+    cd += w * c * d;
+    d2 += w * d * d;
+    weight += w;
+  }
+
+  void Add(const Quadric &q) {
+    a2 += q.a2;
+    ab += q.ab;
+    ac += q.ac;
+    ad += q.ad;
+    b2 += q.b2;
+    bc += q.bc;
+    bd += q.bd;
+    c2 += q.c2;
+    cd += q.cd;
+    d2 += q.d2;
+    weight += q.weight;
+  }
+};
+
+// 2つの二次誤差を合わせたものを点 p で評価し、平均の距離の二乗を返す
+double Evaluate(const Quadric &q0, const Quadric &q1, const Vector4 &p) {
+  Quadric q = q0;
+  q.Add(q1);
+  if (q.weight <= 0.0) {
+    return 0.0;
+  }
+  double x = p.x, y = p.y, z = p.z;
+  double value = q.a2 * x * x + q.b2 * y * y + q.c2 * z * z +
+                 2.0 * (q.ab * x * y + q.ac * x * z + q.bc * y * z) +
+                 2.0 * (q.ad * x + q.bd * y + q.cd * z) + q.d2;
+  return std::max(value, 0.0) / q.weight;
+}
+
+// 三角形の面積の2倍の長さを持つ法線（回り順の向き）
+Vector3 TriangleNormal(const Vector4 &p0, const Vector4 &p1, const Vector4 &p2) {
+  return Cross({p1.x - p0.x, p1.y - p0.y, p1.z - p0.z}, {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z});
+}
+
+// 点 p から三角形 abc までの距離の二乗（Ericson, Real-Time Collision Detection 5.1.5 の最近点）
+float PointTriangleDistanceSq(const Vector3 &p, const Vector3 &a, const Vector3 &b, const Vector3 &c) {
+  const Vector3 ab = b - a, ac = c - a, ap = p - a;
+  auto distanceSq = [&](const Vector3 &q) { return LengthSq(p - q); };
+  float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+  if (d1 <= 0.0f && d2 <= 0.0f) {
+    return distanceSq(a);
+  }
+  const Vector3 bp = p - b;
+  float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+  if (d3 >= 0.0f && d4 <= d3) {
+    return distanceSq(b);
+  }
+  float vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+    return distanceSq(a + ab * (d1 / (d1 - d3)));
+  }
+  const Vector3 cp = p - c;
+  float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+  if (d6 >= 0.0f && d5 <= d6) {
+    return distanceSq(c);
+  }
+  float vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+    return distanceSq(a + ac * (d2 / (d2 - d6)));
+  }
+  float va = d3 * d6 - d5 * d4;
+  if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+    return distanceSq(b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+  }
+  float denom = 1.0f / (va + vb + vc);
+  return distanceSq(a + ab * (vb * denom) + ac * (vc * denom));
+}
+
+// 三角形の並び（3点ずつ）のうち最も近いものまでの距離の二乗
+float NearestDistanceSq(const Vector3 &p, const std::vector<Vector3> &triangles) {
+  float nearest = FLT_MAX;
+  for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+    nearest = std::min(nearest, PointTriangleDistanceSq(p, triangles[i], triangles[i + 1], triangles[i + 2]));
+  }
+  return nearest;
+}
+
+uint64_t EdgeKey(uint32_t a, uint32_t b) {
+  return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+struct Collapse {
+  uint32_t from;
+  uint32_t to;
+  float cost;
+};
+
+// 誤差は 0 以上の float なのでビット列のまま大小を比べられる。11bit ずつ3回の基数ソートで並べる
+void SortCollapses(std::vector<Collapse> &collapses, std::vector<Collapse> &scratch) {
+  constexpr uint32_t kBits = 11;
+  constexpr uint32_t kBuckets = 1u << kBits;
+  scratch.resize(collapses.size());
+  uint32_t histogram[kBuckets];
+  for (uint32_t shift = 0; shift < 32; shift += kBits) {
+    std::fill(std::begin(histogram), std::end(histogram), 0u);
+    for (const Collapse &collapse : collapses) {
+      uint32_t bits;
+      std::memcpy(&bits, &collapse.cost, sizeof(bits));
+      histogram[(bits >> shift) & (kBuckets - 1)]++;
+    }
+    uint32_t sum = 0;
+    for (uint32_t &count : histogram) {
+      uint32_t value = count;
+      count = sum;
+      sum += value;
+    }
+    for (const Collapse &collapse : collapses) {
+      uint32_t bits;
+      std::memcpy(&bits, &collapse.cost, sizeof(bits));
+      scratch[histogram[(bits >> shift) & (kBuckets - 1)]++] = collapse;
+    }
+    collapses.swap(scratch);
+  }
+}
+
+} // namespace
+
+Result Simplify(std::span<const uint32_t> indices, std::span<const ModelAsset::VertexData> vertices,
+                size_t targetIndexCount, float targetError) {
+  Result result;
+  result.indices.assign(indices.begin(), indices.end());
+  const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+  if (result.indices.size() <= targetIndexCount || vertexCount == 0) {
+    return result;
+  }
+
+  // 1. 位置が同じ頂点をまとめる（UV・法線の継ぎ目で分かれた頂点）
+  std::vector<uint32_t> canonical(vertexCount);
+  std::vector<uint32_t> groupSize(vertexCount, 0);
+  {
+    std::unordered_map<uint64_t, std::vector<uint32_t>> table;
+    table.reserve(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+      uint32_t bits[3];
+      std::memcpy(bits, &vertices[v].position, sizeof(bits));
+      uint64_t hash = (uint64_t(bits[0]) * 73856093u) ^ (uint64_t(bits[1]) * 19349663u) ^
+                      (uint64_t(bits[2]) * 83492791u);
+      canonical[v] = v;
+      for (uint32_t other : table[hash]) {
+        if (std::memcmp(&vertices[other].position, &vertices[v].position, sizeof(bits)) == 0) {
+          canonical[v] = other;
+          break;
+        }
+      }
+      if (canonical[v] == v) {
+        table[hash].push_back(v);
+      }
+      groupSize[canonical[v]]++;
+    }
+  }
+
+  // 2. 動かさない頂点: 継ぎ目（同じ位置に複数の頂点）・穴の縁・3枚以上で共有される辺
+  std::vector<uint8_t> locked(vertexCount, 0);
+  {
+    std::unordered_map<uint64_t, uint32_t> edgeUse;
+    edgeUse.reserve(result.indices.size());
+    for (size_t i = 0; i + 2 < result.indices.size(); i += 3) {
+      for (int k = 0; k < 3; ++k) {
+        uint32_t a = canonical[result.indices[i + k]];
+        uint32_t b = canonical[result.indices[i + (k + 1) % 3]];
+        edgeUse[EdgeKey(a, b)]++;
+      }
+    }
+    for (const auto &[key, count] : edgeUse) {
+      if (count != 2) {
+        locked[uint32_t(key >> 32)] = 1;
+        locked[uint32_t(key & 0xffffffffu)] = 1;
+      }
+    }
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+      if (groupSize[canonical[v]] > 1 || locked[canonical[v]]) {
+        locked[v] = 1;
+      }
+    }
+  }
+
+  // 3. 各頂点の二次誤差（位置ごとに集める）
+  std::vector<Quadric> quadrics(vertexCount);
+  for (size_t i = 0; i + 2 < result.indices.size(); i += 3) {
+    const Vector4 &p0 = vertices[result.indices[i]].position;
+    const Vector4 &p1 = vertices[result.indices[i + 1]].position;
+    const Vector4 &p2 = vertices[result.indices[i + 2]].position;
+    Vector3 normal = TriangleNormal(p0, p1, p2);
+    double length = std::sqrt(double(LengthSq(normal)));
+    if (length <= 0.0) {
+      continue;
+    }
+    double a = normal.x / length, b = normal.y / length, c = normal.z / length;
+    double d = -(a * p0.x + b * p0.y + c * p0.z);
+    for (int k = 0; k < 3; ++k) {
+      quadrics[canonical[result.indices[i + k]]].AddPlane(a, b, c, d, length * 0.5);
+    }
+  }
+
+  // 4. 元の頂点は、縮約で寄せた先の頂点が受け持つ。受け持つ頂点の周りの面も簡略化後の面の一部なので、
+  //    そこまでの距離が簡略化後の面までの距離の上限になる（二次誤差は面積で重み付けた平均なので上限には使えない）
+  std::vector<std::vector<uint32_t>> carried(vertexCount);
+  for (uint32_t index : result.indices) {
+    if (carried[index].empty()) {
+      carried[index].push_back(index);
+    }
+  }
+  auto position = [&](uint32_t v) {
+    const Vector4 &p = vertices[v].position;
+    return Vector3{p.x, p.y, p.z};
+  };
+
+  // 5. 誤差の小さい辺から縮約する。1パスでは互いに影響しない辺だけを選び、足りなければ繰り返す
+  //    二次誤差は縮約の順番と候補の絞り込みに使い、縮約してよいかは元の頂点からの距離で決める
+  const double errorLimit = double(targetError) * double(targetError);
+  const float deviationLimit = targetError * targetError;
+  std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+  std::vector<uint32_t> adjacency;
+  std::vector<Collapse> collapses;
+  std::vector<Collapse> scratch;
+  std::vector<uint8_t> touched(vertexCount);
+  std::vector<uint32_t> remap(vertexCount);
+  std::vector<uint32_t> ring;
+  std::vector<Vector3> fan;
+
+  while (result.indices.size() > targetIndexCount) {
+    const uint32_t triangleCount = static_cast<uint32_t>(result.indices.size() / 3);
+
+    // 頂点 -> 三角形
+    std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+    for (uint32_t index : result.indices) {
+      adjacencyOffsets[index + 1]++;
+    }
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+      adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+    adjacency.resize(result.indices.size());
+    {
+      std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+      for (uint32_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+          adjacency[cursor[result.indices[t * 3 + k]]++] = t;
+        }
+      }
+    }
+
+    // 候補: 辺ごとに、動かせる側を相手の位置へ寄せる向きのうち誤差の小さい方
+    // 動かせる頂点の辺は必ず2枚の三角形で共有されるので、a < b の向きだけ見れば重複しない
+    collapses.clear();
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+      for (int k = 0; k < 3; ++k) {
+        uint32_t a = result.indices[t * 3 + k];
+        uint32_t b = result.indices[t * 3 + (k + 1) % 3];
+        if (a > b || (locked[a] && locked[b])) {
+          continue;
+        }
+        const Quadric &qa = quadrics[canonical[a]];
+        const Quadric &qb = quadrics[canonical[b]];
+        double costAB = locked[a] ? DBL_MAX : Evaluate(qa, qb, vertices[b].position);
+        double costBA = locked[b] ? DBL_MAX : Evaluate(qa, qb, vertices[a].position);
+        double cost = std::min(costAB, costBA);
+        if (cost <= errorLimit) {
+          collapses.push_back(costAB <= costBA ? Collapse{a, b, float(cost)}
+                                               : Collapse{b, a, float(cost)});
+        }
+      }
+    }
+    SortCollapses(collapses, scratch);
+
+    std::fill(touched.begin(), touched.end(), 0);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+      remap[v] = v;
+    }
+    const uint32_t targetTriangles = static_cast<uint32_t>(targetIndexCount / 3);
+    uint32_t remaining = triangleCount;
+    uint32_t applied = 0;
+
+    for (const Collapse &collapse : collapses) {
+      if (remaining <= targetTriangles) {
+        break;
+      }
+      if (touched[collapse.from] || touched[collapse.to]) {
+        continue;
+      }
+
+      // 寄せた結果、裏返ったり潰れたりする三角形があれば縮約しない
+      const Vector4 &target = vertices[collapse.to].position;
+      bool valid = true;
+      uint32_t removed = 0;
+      for (uint32_t a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1];
+           ++a) {
+        const uint32_t *tri = &result.indices[adjacency[a] * 3];
+        if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to) {
+          ++removed;
+          continue;
+        }
+        Vector4 before[3] = {vertices[tri[0]].position, vertices[tri[1]].position,
+                             vertices[tri[2]].position};
+        Vector4 after[3] = {before[0], before[1], before[2]};
+        for (int k = 0; k < 3; ++k) {
+          if (tri[k] == collapse.from) {
+            after[k] = target;
+          }
+        }
+        Vector3 normalBefore = TriangleNormal(before[0], before[1], before[2]);
+        Vector3 normalAfter = TriangleNormal(after[0], after[1], after[2]);
+        // 向きが 60 度以上変わるものも細い三角形になりやすいので避ける
+        float lengthBefore = Length(normalBefore);
+        float lengthAfter = Length(normalAfter);
+        if (lengthAfter <= 0.0f ||
+            Dot(normalBefore, normalAfter) < 0.5f * lengthBefore * lengthAfter) {
+          valid = false;
+          break;
+        }
+      }
+      if (!valid) {
+        continue;
+      }
+
+      // 周りの面が変わるのは from の隣の頂点だけ。それぞれが受け持つ元の頂点が、縮約後の周りの面から離れすぎないか確かめる
+      // （このパスで先に縮約した頂点は remap で寄せ先に読み替える）。寄せる頂点の受け持ちが最も離れやすいので寄せ先から見る
+      ring.assign(1, collapse.to);
+      for (uint32_t a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1];
+           ++a) {
+        const uint32_t *tri = &result.indices[adjacency[a] * 3];
+        for (int k = 0; k < 3; ++k) {
+          uint32_t v = remap[tri[k]];
+          if (v != collapse.from && std::find(ring.begin(), ring.end(), v) == ring.end()) {
+            ring.push_back(v);
+          }
+        }
+      }
+      for (uint32_t center : ring) {
+        fan.clear();
+        auto addFan = [&](uint32_t vertex) {
+          for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; ++a) {
+            uint32_t tri[3];
+            for (int k = 0; k < 3; ++k) {
+              tri[k] = remap[result.indices[adjacency[a] * 3 + k]];
+              if (tri[k] == collapse.from) {
+                tri[k] = collapse.to;
+              }
+            }
+            if (tri[0] != tri[1] && tri[1] != tri[2] && tri[2] != tri[0]) {
+              fan.push_back(position(tri[0]));
+              fan.push_back(position(tri[1]));
+              fan.push_back(position(tri[2]));
+            }
+          }
+        };
+        auto fits = [&](const std::vector<uint32_t> &points) {
+          const Vector3 c = position(center);
+          for (uint32_t point : points) {
+            const Vector3 p = position(point);
+            // 受け持つ頂点そのものが十分近ければ、周りの面はもっと近い
+            if (LengthSq(p - c) <= deviationLimit) {
+              continue;
+            }
+            if (fan.empty()) {
+              addFan(center);
+              if (center == collapse.to) {
+                addFan(collapse.from);
+              }
+            }
+            if (NearestDistanceSq(p, fan) > deviationLimit) {
+              return false;
+            }
+          }
+          return true;
+        };
+        valid = fits(carried[center]) && (center != collapse.to || fits(carried[collapse.from]));
+        if (!valid) {
+          break;
+        }
+      }
+      if (!valid) {
+        continue;
+      }
+
+      remap[collapse.from] = collapse.to;
+      for (uint32_t a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1];
+           ++a) {
+        const uint32_t *tri = &result.indices[adjacency[a] * 3];
+        touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+      }
+      quadrics[canonical[collapse.to]].Add(quadrics[canonical[collapse.from]]);
+      carried[collapse.to].insert(carried[collapse.to].end(), carried[collapse.from].begin(),
+                                  carried[collapse.from].end());
+      carried[collapse.from].clear();
+      remaining -= std::min(remaining, removed);
+      ++applied;
+    }
+    if (applied == 0) {
+      break;
+    }
+
+    // 縮約を反映し、潰れた三角形を取り除く（残る三角形の頂点の順番はそのまま）
+    size_t write = 0;
+    for (size_t i = 0; i + 2 < result.indices.size(); i += 3) {
+      uint32_t a = remap[result.indices[i]];
+      uint32_t b = remap[result.indices[i + 1]];
+      uint32_t c = remap[result.indices[i + 2]];
+      if (a == b || b == c || c == a) {
+        continue;
+      }
+      result.indices[write++] = a;
+      result.indices[write++] = b;
+      result.indices[write++] = c;
+    }
+    result.indices.resize(write);
+  }
+
+  // 誤差は、受け持つ元の頂点から簡略化後の周りの面までの距離の最大
+  std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+  for (uint32_t index : result.indices) {
+    adjacencyOffsets[index + 1]++;
+  }
+  for (uint32_t v = 0; v < vertexCount; ++v) {
+    adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+  }
+  adjacency.resize(result.indices.size());
+  {
+    std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t i = 0; i < result.indices.size(); ++i) {
+      adjacency[cursor[result.indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
+  float maxDeviation = 0.0f;
+  for (uint32_t v = 0; v < vertexCount; ++v) {
+    if (carried[v].size() <= 1) {
+      continue; // 自分だけなら面の上にある
+    }
+    fan.clear();
+    for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; ++a) {
+      for (int k = 0; k < 3; ++k) {
+        fan.push_back(position(result.indices[adjacency[a] * 3 + k]));
+      }
+    }
+    for (uint32_t point : carried[v]) {
+      maxDeviation = std::max(maxDeviation, NearestDistanceSq(position(point), fan));
+    }
+  }
+  result.error = std::sqrt(maxDeviation);
+  return result;
+}
+
+float ComputeExtent(std::span<const ModelAsset::VertexData> vertices) {
+  if (vertices.empty()) {
+    return 0.0f;
+  }
+  Vector4 minimum = vertices[0].position;
+  Vector4 maximum = vertices[0].position;
+  for (const ModelAsset::VertexData &vertex : vertices) {
+    minimum = {std::min(minimum.x, vertex.position.x), std::min(minimum.y, vertex.position.y),
+               std::min(minimum.z, vertex.position.z), 1.0f};
+    maximum = {std::max(maximum.x, vertex.position.x), std::max(maximum.y, vertex.position.y),
+               std::max(maximum.z, vertex.position.z), 1.0f};
+  }
+  return std::max({maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z});
+}
+
+void GenerateLods(ModelAsset::ModelData &modelData, const LodSettings &settings) {
+  // 作り直すときは前回追加した LOD のインデックスを捨てる
+  uint32_t indexEnd = 0;
+  for (const ModelAsset::SubMesh &subMesh : modelData.subMeshes) {
+    indexEnd = std::max(indexEnd, subMesh.indexOffset + subMesh.indexCount);
+  }
+  modelData.lods.clear();
+  if (modelData.subMeshes.empty()) {
+    return;
+  }
+  modelData.indices.resize(indexEnd);
+
+  const float extent = ComputeExtent(modelData.vertices);
+  if (extent <= 0.0f) {
+    return;
+  }
+
+  const size_t lodCount = std::min(
+      {settings.targetRatios.size(), settings.maxErrors.size(), settings.screenSizes.size()});
+  size_t previousIndexCount = indexEnd;
+  std::vector<uint32_t> localIndices;
+
+  for (size_t level = 0; level < lodCount; ++level) {
+    ModelAsset::MeshLod lod{};
+    lod.screenSize = settings.screenSizes[level];
+    std::vector<uint32_t> lodIndices;
+    size_t lodIndexCount = 0;
+
+    for (const ModelAsset::SubMesh &subMesh : modelData.subMeshes) {
+      localIndices.resize(subMesh.indexCount);
+      for (uint32_t i = 0; i < subMesh.indexCount; ++i) {
+        localIndices[i] = modelData.indices[subMesh.indexOffset + i] - subMesh.vertexOffset;
+      }
+      // 各 LOD は誤差を正しく測れるよう LOD0 から簡略化する
+      size_t targetIndexCount =
+          static_cast<size_t>(float(subMesh.indexCount / 3) * settings.targetRatios[level]) * 3;
+      std::span<const ModelAsset::VertexData> vertices(
+          modelData.vertices.data() + subMesh.vertexOffset, subMesh.vertexCount);
+      Result simplified =
+          Simplify(localIndices, vertices, targetIndexCount, settings.maxErrors[level] * extent);
+      MeshOptimizer::OptimizeVertexCache(simplified.indices, subMesh.vertexCount);
+
+      ModelAsset::SubMesh lodSubMesh = subMesh;
+      lodSubMesh.indexOffset = static_cast<uint32_t>(indexEnd + lodIndices.size());
+      lodSubMesh.indexCount = static_cast<uint32_t>(simplified.indices.size());
+      for (uint32_t index : simplified.indices) {
+        lodIndices.push_back(index + subMesh.vertexOffset);
+      }
+      lod.subMeshes.push_back(lodSubMesh);
+      lod.error = std::max(lod.error, simplified.error / extent);
+      lodIndexCount += simplified.indices.size();
+    }
+
+    // 誤差の上限で止まってほとんど減らなかったら、それより粗い LOD も作れない
+    if (float(lodIndexCount) > float(previousIndexCount) * settings.minReduction) {
+      break;
+    }
+    previousIndexCount = lodIndexCount;
+    indexEnd += static_cast<uint32_t>(lodIndices.size());
+    modelData.indices.insert(modelData.indices.end(), lodIndices.begin(), lodIndices.end());
+    modelData.lods.push_back(std::move(lod));
+  }
+}
+
+} // namespace MeshSimplifier
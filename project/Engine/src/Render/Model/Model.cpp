@@ -1,12 +1,24 @@
 #include "Model/Model.h"
 #include "Debug/Logger.h"
 #include "Math/MathUtil.h"
+#include "Model/AnimationLibrary.h"
+#include "Model/MeshCache.h"
+#include "Model/MeshOptimizer.h"
+#include "Model/MeshSimplifier.h"
+#include "Renderer/D3D12CommandRecorder.h"
 #include "Renderer/ModelRenderer.h"
 #include "Texture/TextureManager.h"
 #include "Render/Model/SkinCluster.h"
+#include <chrono>
 #include <fstream>
 #include <stdexcept>
 
+namespace {
+// Assimpの後処理フラグ（メッシュキャッシュのキーにも含める）
+constexpr unsigned int kImportFlags =
+	aiProcess_Triangulate | aiProcess_FlipWindingOrder | aiProcess_FlipUVs;
+}
+
 void Model::Initialize(ModelRenderer* modelRenderer,
 	const std::string& directorypath,
 	const std::string& filename) {
@@ -17,6 +29,33 @@ void Model::Initialize(ModelRenderer* modelRenderer,
 
 	LoadModelFile(directorypath, filename);
 
+	SetupResources(false);
+}
+
+Model::ModelData Model::ReadModelFile(const std::string& directoryPath,
+	const std::string& filename) {
+	// GPU には触れないので、ワーカースレッドから呼べる
+	Model model;
+	model.LoadModelFile(directoryPath, filename);
+	return std::move(model.modelData_);
+}
+
+void Model::InitializeFromData(ModelRenderer* modelRenderer, ModelData&& modelData,
+	bool loadTexturesAsync) {
+
+	modelRenderer_ = modelRenderer;
+
+	dx12Core_ = modelRenderer_->GetDx12Core();
+
+	modelData_ = std::move(modelData);
+
+	SetupResources(loadTexturesAsync);
+}
+
+void Model::SetupResources(bool loadTexturesAsync) {
+
+	CalculateBounds();
+
 	CreateVertexData();
 
 	defaultMaterial_.color = Vector4(1, 1, 1, 1);
@@ -25,17 +64,34 @@ void Model::Initialize(ModelRenderer* modelRenderer,
 	defaultMaterial_.shininess = 30.0f;
 	defaultMaterial_.environmentCoefficient = 0.0f;
 
+	// マテリアルがひとつもない場合でも1つは用意しておく
+	if (modelData_.materials.empty()) {
+		modelData_.materials.emplace_back();
+	}
+
 	// objデータが参照しているテクスチャ読み込み
-	if (!modelData_.material.textureFilePath.empty()) {
-		TextureManager::GetInstance()->LoadTexture(
-			modelData_.material.textureFilePath);
-	} else {
-		// テクスチャがない場合は白テクスチャを割り当てる
-		modelData_.material.textureFilePath = "resources/white1x1.png";
-		TextureManager::GetInstance()->LoadTexture(
-			modelData_.material.textureFilePath);
+	for (MaterialData& material : modelData_.materials) {
+		if (material.textureFilePath.empty()) {
+			// テクスチャがない場合は白テクスチャを割り当てる
+			material.textureFilePath = "resources/white1x1.png";
+		}
+		if (loadTexturesAsync) {
+			// 届くまでは白テクスチャで描かれる
+			TextureManager::GetInstance()->LoadTextureAsync(material.textureFilePath);
+		} else {
+			TextureManager::GetInstance()->LoadTexture(material.textureFilePath);
+		}
 	}
 
+	// マテリアルごとの描画範囲を作る
+	drawRanges_ = ModelAsset::BuildDrawRanges(modelData_.subMeshes);
+	lodDrawRanges_.clear();
+	for (const ModelAsset::MeshLod& lod : modelData_.lods) {
+		lodDrawRanges_.push_back(ModelAsset::BuildDrawRanges(lod.subMeshes));
+	}
+
+	isReady_ = true;
+
 	// 読み込んだテクスチャの番号を取得
 	// modelData_.material.textureIndex =
 	//    TextureManager::GetInstance()->GetTextureIndexByFilePath(
@@ -47,11 +103,13 @@ void Model::InitializeFromVertices(ModelRenderer* modelRenderer, const std::vect
 	dx12Core_ = modelRenderer_->GetDx12Core();
 
 	modelData_.vertices = vertices;
-	modelData_.material.textureFilePath = "resources/white1x1.png";
-	TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
+	modelData_.materials.assign(1, MaterialData{ "resources/white1x1.png" });
+	TextureManager::GetInstance()->LoadTexture(modelData_.materials[0].textureFilePath);
 	modelData_.rootNode.localMatrix = MakeIdentity4x4();
 	modelData_.rootNode.name = "RootNode";
 
+	CalculateBounds();
+
 	CreateVertexData();
 
 	defaultMaterial_.color = Vector4(1, 1, 1, 1);
@@ -59,33 +117,49 @@ void Model::InitializeFromVertices(ModelRenderer* modelRenderer, const std::vect
 	defaultMaterial_.uvTransform = MakeIdentity4x4();
 	defaultMaterial_.shininess = 30.0f;
 	defaultMaterial_.environmentCoefficient = 0.0f;
+
+	isReady_ = true;
 }
 
-void Model::Draw(const SkinCluster* skinCluster) {
+void Model::Draw(const SkinCluster* skinCluster, uint32_t lodIndex) {
 
-	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList =
-		dx12Core_->GetCommandList();
+	D3D12CommandRecorder recorder(dx12Core_->GetCommandList());
+	Record(recorder, skinCluster, lodIndex, 1);
+}
+
+void Model::Record(ICommandRecorder& recorder, const SkinCluster* skinCluster,
+	uint32_t lodIndex, uint32_t instanceCount) {
+
+	// 非同期読み込み中のプレースホルダーは何も描かない
+	if (!isReady_) {
+		return;
+	}
 
 	if (skinCluster) {
 		// Skinning描画の場合、CSで計算されたSkinnedVertexのVBVをセット
-		commandList->IASetVertexBuffers(0, 1, &skinCluster->skinnedVertexBufferView);
+		recorder.SetVertexBuffer(0, D3D12CommandRecorder::ToVertexBufferView(skinCluster->skinnedVertexBufferView));
 	} else {
 		// 通常の描画の場合、元のVBVだけをセット
-		commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+		recorder.SetVertexBuffer(0, D3D12CommandRecorder::ToVertexBufferView(vertexBufferView));
 	}
 
-	// SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である。
-	commandList->SetGraphicsRootDescriptorTable(
-		2, TextureManager::GetInstance()->GetSrvHandleGPU(
-			modelData_.material.textureFilePath));
-
 	if (!modelData_.indices.empty()) {
-		// インデックスがある場合はIndexBufferを使って描画
-		commandList->IASetIndexBuffer(&indexBufferView_);
-		commandList->DrawIndexedInstanced(UINT(modelData_.indices.size()), 1, 0, 0, 0);
+		// インデックスがある場合はIndexBufferを使い、マテリアルごとの範囲で描画
+		recorder.SetIndexBuffer(D3D12CommandRecorder::ToIndexBufferView(indexBufferView_));
+		const std::vector<DrawRange>& ranges = GetDrawRanges(lodIndex);
+		for (const DrawRange& range : ranges) {
+			// SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である。
+			recorder.SetRootDescriptorTable(
+				2, TextureManager::GetInstance()->GetSrvHandleGPU(
+					modelData_.materials[range.materialIndex].textureFilePath).ptr);
+			recorder.DrawIndexedInstanced(range.indexCount, instanceCount, range.indexOffset, 0, 0);
+		}
 	} else {
 		// インデックスがない場合（Primitive等）はVertexBufferのみで描画
-		commandList->DrawInstanced(UINT(modelData_.vertices.size()), 1, 0, 0);
+		recorder.SetRootDescriptorTable(
+			2, TextureManager::GetInstance()->GetSrvHandleGPU(
+				modelData_.materials[0].textureFilePath).ptr);
+		recorder.DrawInstanced(UINT(modelData_.vertices.size()), instanceCount, 0, 0);
 	}
 }
 
@@ -126,16 +200,27 @@ Model::LoadMaterialTemplateFile(const std::string& directoryPath,
 void Model::LoadModelFile(const std::string& directoryPath,
 	const std::string& filename) {
 
+	std::string filePath = directoryPath + "/" + filename;
+	auto loadStart = std::chrono::steady_clock::now();
+	auto elapsedMs = [&]() {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+	};
+
+	// 前回の読み込み結果が残っていて、元ファイルが変わっていなければそれを使う
+	const MeshCache::Key cacheKey{ MeshCache::HashSourceFiles(filePath), kImportFlags };
+	const std::string cachePath = MeshCache::GetCachePath(filePath);
+	if (cacheKey.sourceHash != 0 && MeshCache::Load(cachePath, cacheKey, modelData_)) {
+		Logger::Log("[Model] " + filePath + ": mesh cache hit (" + std::to_string(elapsedMs()) + " ms)\n");
+		return;
+	}
+
 	// assimp読み込み
 	Assimp::Importer importer;
-	std::string filePath = directoryPath + "/" + filename;
 
 	// 1. 中で必要となる変数の宣言
 	ModelData modelData; // 構築するModelData
 
-	const aiScene* scene = importer.ReadFile(
-		filePath.c_str(),
-		aiProcess_Triangulate | aiProcess_FlipWindingOrder | aiProcess_FlipUVs);
+	const aiScene* scene = importer.ReadFile(filePath.c_str(), kImportFlags);
 
 	if (!scene || !scene->HasMeshes()) {
 		throw std::runtime_error("Assimp failed to load model: " + filePath + " - " + importer.GetErrorString());
@@ -143,14 +228,24 @@ void Model::LoadModelFile(const std::string& directoryPath,
 
 	modelData.rootNode = ReadNode(scene->mRootNode);
 
+	// 同じマテリアルのメッシュがインデックスバッファ上で隣り合うよう、マテリアル順に結合する
+	std::vector<uint32_t> meshMaterials(scene->mNumMeshes);
 	for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+		meshMaterials[meshIndex] = scene->mMeshes[meshIndex]->mMaterialIndex;
+	}
+	const std::vector<uint32_t> meshOrder = ModelAsset::MakeMaterialOrder(meshMaterials);
+
+	std::vector<VertexData> meshVertices;
+	std::vector<uint32_t> meshIndices;
+	for (uint32_t meshIndex : meshOrder) {
 		aiMesh* mesh = scene->mMeshes[meshIndex];
 
 		assert(mesh->HasNormals());        // 法線がないMeshは今回は非対応
 		// assert(mesh->HasTextureCoords(0)); // TexcoordがないMeshは今回は非対応
 
 		// 最初から頂点数分のメモリを確保しておく
-		modelData.vertices.resize(mesh->mNumVertices);
+		meshVertices.resize(mesh->mNumVertices);
+		meshIndices.clear();
 		for (uint32_t vertexIndex = 0; vertexIndex < mesh->mNumVertices; ++vertexIndex) {
 			aiVector3D& position = mesh->mVertices[vertexIndex];
 			aiVector3D& normal = mesh->mNormals[vertexIndex];
@@ -161,9 +256,9 @@ void Model::LoadModelFile(const std::string& directoryPath,
 			}
 
 			// 右手系->左手系への変換を忘れずに
-			modelData.vertices[vertexIndex].position = { -position.x, position.y, position.z, 1.0f };
-			modelData.vertices[vertexIndex].normal = { -normal.x, normal.y, normal.z };
-			modelData.vertices[vertexIndex].texcoord = { texcoord.x, texcoord.y };
+			meshVertices[vertexIndex].position = { -position.x, position.y, position.z, 1.0f };
+			meshVertices[vertexIndex].normal = { -normal.x, normal.y, normal.z };
+			meshVertices[vertexIndex].texcoord = { texcoord.x, texcoord.y };
 		}
 
 		// 面からIndexの情報を取得する
@@ -173,10 +268,14 @@ void Model::LoadModelFile(const std::string& directoryPath,
 
 			for (uint32_t element = 0; element < face.mNumIndices; ++element) {
 				uint32_t vertexIndex = face.mIndices[element];
-				modelData.indices.push_back(vertexIndex);
+				meshIndices.push_back(vertexIndex);
 			}
 		}
 
+		// 結合バッファへ追加（インデックスは結合後の頂点番号になる）
+		const SubMesh subMesh = ModelAsset::AppendSubMesh(
+			modelData, meshVertices, meshIndices, mesh->mMaterialIndex);
+
 		// SkinCluster構築用のデータ取得を追加
 		for (uint32_t boneIndex = 0; boneIndex < mesh->mNumBones; ++boneIndex) {
 			aiBone* bone = mesh->mBones[boneIndex];
@@ -192,11 +291,13 @@ void Model::LoadModelFile(const std::string& directoryPath,
 			jointWeightData.inverseBindPoseMatrix = Inverse(bindPoseMatrix);
 
 			for (uint32_t weightIndex = 0; weightIndex < bone->mNumWeights; ++weightIndex) {
-				jointWeightData.vertexWeights.push_back({ bone->mWeights[weightIndex].mWeight, bone->mWeights[weightIndex].mVertexId });
+				jointWeightData.vertexWeights.push_back({ bone->mWeights[weightIndex].mWeight, subMesh.vertexOffset + bone->mWeights[weightIndex].mVertexId });
 			}
 		}
 	}
 
+	// マテリアルはSubMesh::materialIndexと同じ並びで持つ（テクスチャがなければ空）
+	modelData.materials.resize(scene->mNumMaterials);
 	for (uint32_t materialIndex = 0; materialIndex < scene->mNumMaterials;
 		++materialIndex) {
 		aiMaterial* material = scene->mMaterials[materialIndex];
@@ -205,7 +306,7 @@ void Model::LoadModelFile(const std::string& directoryPath,
 			aiString textureFilePath;
 			material->GetTexture(aiTextureType_DIFFUSE, 0, &textureFilePath);
 
-			modelData.material.textureFilePath =
+			modelData.materials[materialIndex].textureFilePath =
 				directoryPath + "/" + textureFilePath.C_Str();
 		}
 	}
@@ -296,8 +397,33 @@ void Model::LoadModelFile(const std::string& directoryPath,
 	//  }
 	//}
 
+	// 重複頂点の結合と、頂点キャッシュ・オーバードロー向けの並べ替え（キャッシュには最適化後を保存する）
+	const MeshOptimizer::Report optimizeReport = MeshOptimizer::Optimize(modelData);
+	Logger::Log("[Model] " + filePath + ": vertices " + std::to_string(optimizeReport.verticesBefore) +
+		" -> " + std::to_string(optimizeReport.verticesAfter) +
+		", ACMR " + std::to_string(optimizeReport.before.acmr) + " -> " + std::to_string(optimizeReport.after.acmr) +
+		", ATVR " + std::to_string(optimizeReport.before.atvr) + " -> " + std::to_string(optimizeReport.after.atvr) + "\n");
+
+	// 遠くで使う簡略化メッシュ（頂点は共有し、インデックスだけ末尾に追加する）
+	MeshSimplifier::GenerateLods(modelData);
+	for (size_t level = 0; level < modelData.lods.size(); ++level) {
+		uint32_t lodIndexCount = 0;
+		for (const SubMesh& subMesh : modelData.lods[level].subMeshes) {
+			lodIndexCount += subMesh.indexCount;
+		}
+		Logger::Log("[Model] " + filePath + ": LOD" + std::to_string(level + 1) + " " +
+			std::to_string(lodIndexCount / 3) + " triangles, error " +
+			std::to_string(modelData.lods[level].error) + "\n");
+	}
+
 	// 4. ModelDataを返す
 	modelData_ = modelData;
+
+	// 次回の起動からAssimpを通さずに読めるよう保存しておく
+	if (cacheKey.sourceHash != 0 && !MeshCache::Save(cachePath, cacheKey, modelData_)) {
+		Logger::Log("[Model] failed to write mesh cache: " + cachePath + "\n");
+	}
+	Logger::Log("[Model] " + filePath + ": imported with Assimp (" + std::to_string(elapsedMs()) + " ms)\n");
 }
 
 void Model::CreateVertexData() {
@@ -334,6 +460,15 @@ void Model::CreateVertexData() {
 	}
 }
 
+void Model::CalculateBounds() {
+	// モデル全体・サブメッシュごと・スキンの Joint ごと（読み込み時に1回だけ）
+	BoundingVolume bounds = ModelBounds::Compute(modelData_.vertices);
+	localAABB_ = bounds.aabb;
+	localSphere_ = bounds.sphere;
+	subMeshBounds_ = ModelBounds::ComputeSubMeshes(modelData_);
+	jointBounds_ = ModelBounds::ComputeJointBounds(modelData_);
+}
+
 Model::Node Model::ReadNode(aiNode* node) {
 
 	Node result{};
@@ -363,80 +498,8 @@ Model::Node Model::ReadNode(aiNode* node) {
 }
 
 Animation LoadAnimationFile(const std::string& directoryPath, const std::string& filename) {
-	Animation animation; // 今回作るアニメーション
-	Assimp::Importer importer;
-	std::string filePath = directoryPath + "/" + filename;
-	const aiScene* scene = importer.ReadFile(filePath.c_str(), 0);
-	assert(scene->mNumAnimations != 0); // アニメーションがない
-	aiAnimation* animationAssimp = scene->mAnimations[0]; // 最初のアニメーションだけ採用
-	animation.duration = float(animationAssimp->mDuration / animationAssimp->mTicksPerSecond); // 時間の単位を秒に変換
-
-	// assimpでは個々のNodeのAnimationをchannelと呼んでいるのでchannelを回してNodeAnimationの情報をとってくる
-	for (uint32_t channelIndex = 0; channelIndex < animationAssimp->mNumChannels; ++channelIndex) {
-		aiNodeAnim* nodeAnimationAssimp = animationAssimp->mChannels[channelIndex];
-		NodeAnimation& nodeAnimation = animation.nodeAnimations[nodeAnimationAssimp->mNodeName.C_Str()];
-
-		// Translate
-		for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumPositionKeys; ++keyIndex) {
-			aiVectorKey& keyAssimp = nodeAnimationAssimp->mPositionKeys[keyIndex];
-			KeyframeVector3 keyframe;
-			keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond); // ここも秒に変換
-			keyframe.value = { -keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z }; // 右手->左手
-			nodeAnimation.translate.keyframes.push_back(keyframe);
-		}
-
-		// Rotate
-		for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumRotationKeys; ++keyIndex) {
-			aiQuatKey& keyAssimp = nodeAnimationAssimp->mRotationKeys[keyIndex];
-			KeyframeQuaternion keyframe;
-			keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond); // ここも秒に変換
-			// RotateはQuaternionで、右手->左手に変換するために、yとzを反転させる必要がある
-			keyframe.value = { keyAssimp.mValue.x, -keyAssimp.mValue.y, -keyAssimp.mValue.z, keyAssimp.mValue.w };
-			nodeAnimation.rotate.keyframes.push_back(keyframe);
-		}
-
-		// Scale
-		for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumScalingKeys; ++keyIndex) {
-			aiVectorKey& keyAssimp = nodeAnimationAssimp->mScalingKeys[keyIndex];
-			KeyframeVector3 keyframe;
-			keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond); // ここも秒に変換
-			// Scaleはそのままで良い
-			keyframe.value = { keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
-			nodeAnimation.scale.keyframes.push_back(keyframe);
-		}
-	}
-	// 解析完了
-	return animation;
-}
-
-Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time) {
-    assert(!keyframes.empty()); // キーがないものはダメ
-    if (keyframes.size() == 1 || time <= keyframes[0].time) {
-        return keyframes[0].value;
-    }
-
-    for (size_t index = 0; index < keyframes.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-            float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-            return Lerp(keyframes[index].value, keyframes[nextIndex].value, t);
-        }
-    }
-    return (*keyframes.rbegin()).value;
-}
-
-Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time) {
-    assert(!keyframes.empty());
-    if (keyframes.size() == 1 || time <= keyframes[0].time) {
-        return keyframes[0].value;
-    }
-
-    for (size_t index = 0; index < keyframes.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-            float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-            return Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
-        }
-    }
-    return (*keyframes.rbegin()).value;
+	// ファイル内の全クリップは AnimationLibrary が一度だけ読み込んで持っている（2回目以降は解析しない）
+	const AnimationSet* animationSet = AnimationLibrary::GetInstance()->Load(directoryPath + "/" + filename);
+	assert(animationSet && animationSet->GetCount() != 0); // アニメーションがない
+	return *animationSet->Get(0); // 最初のアニメーションだけ採用
 }
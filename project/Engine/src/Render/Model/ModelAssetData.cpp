@@ -0,0 +1,91 @@
+#include "Model/ModelAssetData.h"
+#include <algorithm>
+
+namespace ModelAsset {
+
+std::vector<uint32_t> MakeMaterialOrder(std::span<const uint32_t> materialIndices) {
+  std::vector<uint32_t> order(materialIndices.size());
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return materialIndices[a] < materialIndices[b];
+  });
+  return order;
+}
+
+SubMesh AppendSubMesh(ModelData &modelData, std::span<const VertexData> vertices,
+                      std::span<const uint32_t> indices, uint32_t materialIndex) {
+  SubMesh subMesh{};
+  subMesh.vertexOffset = static_cast<uint32_t>(modelData.vertices.size());
+  subMesh.vertexCount = static_cast<uint32_t>(vertices.size());
+  subMesh.indexOffset = static_cast<uint32_t>(modelData.indices.size());
+  subMesh.indexCount = static_cast<uint32_t>(indices.size());
+  subMesh.materialIndex = materialIndex;
+
+  modelData.vertices.insert(modelData.vertices.end(), vertices.begin(), vertices.end());
+
+  // 結合後の頂点番号に直す
+  modelData.indices.reserve(modelData.indices.size() + indices.size());
+  for (uint32_t index : indices) {
+    modelData.indices.push_back(index + subMesh.vertexOffset);
+  }
+
+  modelData.subMeshes.push_back(subMesh);
+  return subMesh;
+}
+
+std::vector<DrawRange> BuildDrawRanges(const std::vector<SubMesh> &subMeshes) {
+  // マテリアル順に並べ、その中はインデックス順にする
+  std::vector<SubMesh> sorted = subMeshes;
+  std::stable_sort(sorted.begin(), sorted.end(), [](const SubMesh &a, const SubMesh &b) {
+    if (a.materialIndex != b.materialIndex) {
+      return a.materialIndex < b.materialIndex;
+    }
+    return a.indexOffset < b.indexOffset;
+  });
+
+  std::vector<DrawRange> ranges;
+  for (const SubMesh &subMesh : sorted) {
+    if (subMesh.indexCount == 0) {
+      continue;
+    }
+
+    // 直前の範囲と同じマテリアルでインデックスが続いていれば伸ばす
+    if (!ranges.empty()) {
+      DrawRange &last = ranges.back();
+      if (last.materialIndex == subMesh.materialIndex &&
+          last.indexOffset + last.indexCount == subMesh.indexOffset) {
+        last.indexCount += subMesh.indexCount;
+        continue;
+      }
+    }
+    ranges.push_back({subMesh.indexOffset, subMesh.indexCount, subMesh.materialIndex});
+  }
+  return ranges;
+}
+
+float ProjectedScreenSize(float radius, float distance, float projectionScaleY) {
+  // カメラが球の中にあるときは画面いっぱいとみなす
+  if (distance <= radius) {
+    return 1.0f;
+  }
+  return radius * projectionScaleY / distance;
+}
+
+uint32_t SelectLod(const std::vector<MeshLod> &lods, float screenSize, uint32_t currentLod,
+                   float hysteresis) {
+  const uint32_t lodCount = static_cast<uint32_t>(lods.size());
+  uint32_t lod = std::min(currentLod, lodCount);
+
+  // 粗くするときはしきい値より少し小さくなるまで、細かくするときは少し大きくなるまで待つ
+  while (lod < lodCount && screenSize < lods[lod].screenSize * (1.0f - hysteresis)) {
+    ++lod;
+  }
+  while (lod > 0 && screenSize > lods[lod - 1].screenSize * (1.0f + hysteresis)) {
+    --lod;
+  }
+  return lod;
+}
+
+} // namespace ModelAsset
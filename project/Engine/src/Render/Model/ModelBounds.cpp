@@ -0,0 +1,132 @@
+#include "Model/ModelBounds.h"
+#include "Math/MathUtil.h"
+#include "Model/Skeleton.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ModelBounds {
+namespace {
+
+// 空の箱（何を Union しても相手になる）
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+constexpr AABB kEmptyAABB = {{kInfinity, kInfinity, kInfinity}, {-kInfinity, -kInfinity, -kInfinity}};
+
+void Expand(AABB &aabb, const Vector3 &point) {
+  aabb.min.x = std::min(aabb.min.x, point.x);
+  aabb.min.y = std::min(aabb.min.y, point.y);
+  aabb.min.z = std::min(aabb.min.z, point.z);
+  aabb.max.x = std::max(aabb.max.x, point.x);
+  aabb.max.y = std::max(aabb.max.y, point.y);
+  aabb.max.z = std::max(aabb.max.z, point.z);
+}
+
+Vector3 TransformPoint(const Vector4 &p, const Matrix4x4 &m) {
+  return {p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+          p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+          p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2]};
+}
+
+} // namespace
+
+BoundingVolume Compute(std::span<const ModelAsset::VertexData> vertices) {
+  BoundingVolume result{};
+  if (vertices.empty()) {
+    return result;
+  }
+
+  result.aabb = kEmptyAABB;
+  for (const ModelAsset::VertexData &vertex : vertices) {
+    Expand(result.aabb, {vertex.position.x, vertex.position.y, vertex.position.z});
+  }
+
+  // 球はAABBの中心から最も遠い頂点までを半径にする（AABB を包む球より小さくなる）
+  result.sphere.center = {(result.aabb.min.x + result.aabb.max.x) * 0.5f,
+                          (result.aabb.min.y + result.aabb.max.y) * 0.5f,
+                          (result.aabb.min.z + result.aabb.max.z) * 0.5f};
+  float radiusSq = 0.0f;
+  for (const ModelAsset::VertexData &vertex : vertices) {
+    Vector3 diff = {vertex.position.x - result.sphere.center.x, vertex.position.y - result.sphere.center.y,
+                    vertex.position.z - result.sphere.center.z};
+    radiusSq = std::max(radiusSq, LengthSq(diff));
+  }
+  result.sphere.radius = std::sqrt(radiusSq);
+  return result;
+}
+
+std::vector<BoundingVolume> ComputeSubMeshes(const ModelAsset::ModelData &modelData) {
+  std::vector<BoundingVolume> result;
+  result.reserve(modelData.subMeshes.size());
+  for (const ModelAsset::SubMesh &subMesh : modelData.subMeshes) {
+    // サブメッシュの頂点は結合バッファ内で連続している
+    std::span<const ModelAsset::VertexData> vertices(modelData.vertices);
+    if (uint64_t(subMesh.vertexOffset) + subMesh.vertexCount > vertices.size()) {
+      result.push_back({});
+      continue;
+    }
+    result.push_back(Compute(vertices.subspan(subMesh.vertexOffset, subMesh.vertexCount)));
+  }
+  return result;
+}
+
+JointBounds ComputeJointBounds(const ModelAsset::ModelData &modelData) {
+  JointBounds result;
+  for (const auto &[name, jointWeight] : modelData.skinClusterData) {
+    AABB aabb = kEmptyAABB;
+    bool influences = false;
+    for (const ModelAsset::VertexWeightData &vertexWeight : jointWeight.vertexWeights) {
+      // 重み 0 は結果に効かない。PackSkinWeights が落とす小さい重みは含めたままでよい（箱が少し大きいだけ）
+      if (vertexWeight.weight <= 0.0f || vertexWeight.vertexIndex >= modelData.vertices.size()) {
+        continue;
+      }
+      const Vector4 &position = modelData.vertices[vertexWeight.vertexIndex].position;
+      Expand(aabb, TransformPoint(position, jointWeight.inverseBindPoseMatrix));
+      influences = true;
+    }
+    if (influences) {
+      result.jointNames.push_back(name);
+      result.aabbs.push_back(aabb);
+    }
+  }
+  return result;
+}
+
+std::vector<int32_t> ResolveJoints(const JointBounds &jointBounds, const Skeleton &skeleton) {
+  std::vector<int32_t> result(jointBounds.jointNames.size(), -1);
+  for (size_t i = 0; i < jointBounds.jointNames.size(); ++i) {
+    auto it = skeleton.jointMap.find(jointBounds.jointNames[i]);
+    if (it != skeleton.jointMap.end()) {
+      result[i] = it->second;
+    }
+  }
+  return result;
+}
+
+AABB ComputeSkinnedAABB(const JointBounds &jointBounds, std::span<const int32_t> jointIndices,
+                        const Matrix4x4 *skeletonSpaceMatrices) {
+  AABB result = kEmptyAABB;
+  const size_t count = std::min(jointIndices.size(), jointBounds.aabbs.size());
+  for (size_t i = 0; i < count; ++i) {
+    if (jointIndices[i] < 0) {
+      continue;
+    }
+    result = Union(result, TransformAABB(jointBounds.aabbs[i], skeletonSpaceMatrices[jointIndices[i]]));
+  }
+  if (result.min.x > result.max.x) {
+    return {};
+  }
+  return result;
+}
+
+AABB Union(const AABB &a, const AABB &b) {
+  return {{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+          {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)}};
+}
+
+Sphere MakeSphere(const AABB &aabb) {
+  Vector3 halfExtent = {(aabb.max.x - aabb.min.x) * 0.5f, (aabb.max.y - aabb.min.y) * 0.5f,
+                        (aabb.max.z - aabb.min.z) * 0.5f};
+  return {{aabb.min.x + halfExtent.x, aabb.min.y + halfExtent.y, aabb.min.z + halfExtent.z}, Length(halfExtent)};
+}
+
+} // namespace ModelBounds
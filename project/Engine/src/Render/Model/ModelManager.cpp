@@ -2,37 +2,15 @@
 #include "Model/Model.h"
 #include "Renderer/ModelRenderer.h"
 #include "Debug/Logger.h"
+#include "Util/AssetIndex.h"
+#include "Util/AsyncLoader.h"
 #include <cassert>
-#include <filesystem>
 
 bool ModelManager::isFinalized_ = false;
 
-namespace fs = std::filesystem;
-
 std::string ModelManager::ResolveModelPath(const std::string &input) {
-  const fs::path base = "resources";
-
-  // すでにパスならそのまま
-  if (input.find('/') != std::string::npos ||
-      input.find('\\') != std::string::npos) {
-    return input;
-  }
-
-  // resources 以下を再帰検索
-  if (fs::exists(base)) {
-    for (const auto &e : fs::recursive_directory_iterator(base)) {
-      if (!e.is_regular_file()) {
-        continue;
-      }
-
-      if (e.path().filename() == input) {
-        return e.path().generic_string();
-      }
-    }
-  }
-
-  // 見つからなければ、そのまま
-  return input;
+  // 毎回ディレクトリを走査せず、起動時に作った索引から引く
+  return AssetIndex::GetInstance()->Resolve(input);
 }
 
 ModelManager *ModelManager::GetInstance() {
@@ -55,6 +33,7 @@ void ModelManager::Finalize() {
   }
 
   ModelManager *instance = GetInstance();
+  instance->pendingModels_.clear();
   instance->modelRenderer.reset();
   instance->models.clear();
 
@@ -67,27 +46,38 @@ void ModelManager::Initialize(Dx12Core *dx12Core) {
   modelRenderer->Initialize(dx12Core);
 }
 
+void ModelManager::SplitModelPath(const std::string &resolved, std::string &directoryPath,
+                                  std::string &filename) {
+  // "resources/" を基準にする
+  directoryPath = "resources";
+  filename = resolved;
+
+  // ディレクトリ部分とファイル名部分に分解
+  const size_t slash = resolved.find_last_of("/\\");
+  if (slash != std::string::npos) {
+    directoryPath = resolved.substr(0, slash);
+    filename = resolved.substr(slash + 1);
+  }
+}
+
 void ModelManager::LoadModel(const std::string &filePath) {
 
   const std::string resolved = ResolveModelPath(filePath);
 
+  // 非同期で読み込み中なら、それを待つ
+  if (auto pending = pendingModels_.find(resolved); pending != pendingModels_.end()) {
+    AsyncLoader::GetInstance()->Wait(pending->second);
+    return;
+  }
+
   if (models.contains(resolved)) {
     // 読み込み済みなら早期リターン
     return;
   }
 
-  // "resources/" を基準にする
-  const std::string baseDir = "resources";
-
-  // ディレクトリ部分とファイル名部分に分解
-  std::string directoryPath = baseDir;
-  std::string filename = resolved;
-
-  const size_t slash = resolved.find_last_of("/\\");
-  if (slash != std::string::npos) {
-    directoryPath = resolved.substr(0, slash);
-    filename = resolved.substr(slash + 1);
-  }
+  std::string directoryPath;
+  std::string filename;
+  SplitModelPath(resolved, directoryPath, filename);
   // if (slash != std::string::npos) {
   //   directoryPath = baseDir + "/" + filePath.substr(0, slash);
   //   filename = filePath.substr(slash + 1);
@@ -110,6 +100,44 @@ void ModelManager::LoadModel(const std::string &filePath) {
   // models.insert(std::make_pair(filePath, std::move(model)));
 }
 
+LoadHandle ModelManager::LoadModelAsync(const std::string &filePath) {
+
+  const std::string resolved = ResolveModelPath(filePath);
+
+  if (auto pending = pendingModels_.find(resolved); pending != pendingModels_.end()) {
+    return pending->second;
+  }
+  if (models.contains(resolved)) {
+    return AsyncLoader::MakeReady(resolved);
+  }
+
+  std::string directoryPath;
+  std::string filename;
+  SplitModelPath(resolved, directoryPath, filename);
+
+  // 先にプレースホルダーを登録しておき、FindModel がすぐに返せるようにする（準備できるまでは描かない）
+  Model *placeholder = models.emplace(resolved, std::make_unique<Model>()).first->second.get();
+
+  // ファイル読み込み・メッシュ最適化・LOD 生成はワーカーで、バッファ作成はメインスレッドで行う
+  auto modelData = std::make_shared<Model::ModelData>();
+  LoadHandle handle = AsyncLoader::GetInstance()->Submit(
+      resolved,
+      [directoryPath, filename, modelData] {
+        *modelData = Model::ReadModelFile(directoryPath, filename);
+      },
+      [this, resolved, placeholder, modelData](bool succeeded) {
+        pendingModels_.erase(resolved);
+        if (!succeeded) {
+          // 失敗したらプレースホルダーのまま（描かれない）
+          Logger::Log("[ModelManager] Failed to load model: " + resolved + "\n");
+          return;
+        }
+        placeholder->InitializeFromData(modelRenderer.get(), std::move(*modelData), true);
+      });
+  pendingModels_.emplace(resolved, handle);
+  return handle;
+}
+
 Model *ModelManager::FindModel(const std::string &filePath) {
 
   const std::string resolved = ResolveModelPath(filePath);
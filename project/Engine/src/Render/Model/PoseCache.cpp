@@ -0,0 +1,157 @@
+#include "Model/PoseCache.h"
+#include "Model/AnimationBlend.h"
+#include "Model/Skeleton.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace {
+
+// 64bit FNV-1a（Skeleton の見分けに使うだけ）
+constexpr uint64_t kHashOffset = 14695981039346656037ull;
+constexpr uint64_t kHashPrime = 1099511628211ull;
+
+uint64_t HashBytes(uint64_t hash, const void *data, size_t size) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * kHashPrime;
+  }
+  return hash;
+}
+
+} // namespace
+
+void PoseCache::Initialize(const Settings &settings) {
+  settings_ = settings;
+  Clear();
+  frame_ = 0;
+  hitCount_ = 0;
+  missCount_ = 0;
+  evictionCount_ = 0;
+}
+
+void PoseCache::Clear() {
+  for (auto &[key, entry] : entries_) {
+    assert(entry->refCount == 0);
+  }
+  entries_.clear();
+  freePalettes_.clear();
+}
+
+void PoseCache::BeginFrame() {
+  ++frame_;
+
+  std::vector<Entry *> idle;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    Entry &entry = *it->second;
+    if (entry.refCount == 0 && frame_ - entry.lastUsedFrame > settings_.maxIdleFrames) {
+      auto next = std::next(it);
+      Evict(it);
+      it = next;
+      continue;
+    }
+    if (entry.refCount == 0) {
+      idle.push_back(&entry);
+    }
+    ++it;
+  }
+
+  // 上限を超えた分は、使われていないものを古い順に捨てる
+  if (entries_.size() > settings_.maxEntries && !idle.empty()) {
+    size_t excess = std::min(entries_.size() - settings_.maxEntries, idle.size());
+    std::nth_element(idle.begin(), idle.begin() + (excess - 1), idle.end(),
+                     [](const Entry *a, const Entry *b) { return a->lastUsedFrame < b->lastUsedFrame; });
+    for (size_t i = 0; i < excess; ++i) {
+      Evict(entries_.find(idle[i]->key));
+    }
+  }
+}
+
+PoseCache::Key PoseCache::MakeKey(uint64_t skeletonKey, const void *clip, float time) const {
+  Key key;
+  key.skeleton = skeletonKey;
+  key.clip = clip;
+  // sampleRate が 0 以下なら丸めない（時刻のビット列をそのまま使うので、一致したときだけ共有する）
+  if (settings_.sampleRate > 0.0f) {
+    key.frame = static_cast<int32_t>(std::lround(time * settings_.sampleRate));
+  } else {
+    std::memcpy(&key.frame, &time, sizeof(time));
+  }
+  return key;
+}
+
+PoseCache::Key PoseCache::MakeKey(uint64_t skeletonKey, const AnimationClip &clip, float time) const {
+  // 同じファイルのクリップなら、別々に Bind したインスタンス同士でも同じキーになる
+  const void *source = clip.compressed ? static_cast<const void *>(clip.compressed) : clip.animation;
+  return MakeKey(skeletonKey, source, time);
+}
+
+float PoseCache::GetKeyTime(const Key &key) const {
+  if (settings_.sampleRate > 0.0f) {
+    return static_cast<float>(key.frame) / settings_.sampleRate;
+  }
+  float time;
+  std::memcpy(&time, &key.frame, sizeof(time));
+  return time;
+}
+
+void PoseCache::Release(Entry *entry) {
+  assert(entry && entry->refCount > 0);
+  --entry->refCount;
+  entry->lastUsedFrame = frame_;
+}
+
+uint64_t PoseCache::MakeSkeletonKey(const Skeleton &skeleton, const Matrix4x4 *inverseBindPoseMatrices) {
+  uint64_t hash = kHashOffset;
+  const uint64_t jointCount = skeleton.joints.size();
+  hash = HashBytes(hash, &jointCount, sizeof(jointCount));
+  for (const Joint &joint : skeleton.joints) {
+    hash = HashBytes(hash, joint.name.data(), joint.name.size() + 1);
+  }
+  if (!skeleton.parentIndices.empty()) {
+    hash = HashBytes(hash, skeleton.parentIndices.data(), sizeof(int32_t) * skeleton.parentIndices.size());
+  }
+  // クリップにない Joint は初期姿勢のままなので、それも結果に入る
+  if (!skeleton.transforms.empty()) {
+    hash = HashBytes(hash, skeleton.transforms.data(), sizeof(QuaternionTransform) * skeleton.transforms.size());
+  }
+  if (inverseBindPoseMatrices) {
+    hash = HashBytes(hash, inverseBindPoseMatrices, sizeof(Matrix4x4) * skeleton.joints.size());
+  }
+  return hash;
+}
+
+size_t PoseCache::KeyHash::operator()(const Key &key) const {
+  uint64_t hash = kHashOffset;
+  hash = HashBytes(hash, &key.skeleton, sizeof(key.skeleton));
+  hash = HashBytes(hash, &key.clip, sizeof(key.clip));
+  hash = HashBytes(hash, &key.frame, sizeof(key.frame));
+  return static_cast<size_t>(hash);
+}
+
+PoseCache::Entry *PoseCache::Find(const Key &key) {
+  auto it = entries_.find(key);
+  return it != entries_.end() ? it->second.get() : nullptr;
+}
+
+PoseCache::Entry *PoseCache::Insert(const Key &key, size_t jointCount) {
+  auto entry = std::make_unique<Entry>();
+  entry->key = key;
+  if (!freePalettes_.empty()) {
+    entry->palette = std::move(freePalettes_.back());
+    freePalettes_.pop_back();
+  }
+  entry->palette.resize(jointCount);
+  Entry *result = entry.get();
+  entries_.emplace(key, std::move(entry));
+  return result;
+}
+
+void PoseCache::Evict(std::unordered_map<Key, std::unique_ptr<Entry>, KeyHash>::iterator it) {
+  assert(it != entries_.end() && it->second->refCount == 0);
+  freePalettes_.push_back(std::move(it->second->palette));
+  entries_.erase(it);
+  ++evictionCount_;
+}
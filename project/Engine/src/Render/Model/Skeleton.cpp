@@ -1,32 +1,36 @@
 #include "Render/Model/Skeleton.h"
+#include <cassert>
 
-int32_t CreateJoint(const Model::Node& node, const std::optional<int32_t>& parent, std::vector<Joint>& joints) {
+int32_t CreateJoint(const ModelAsset::Node& node, const std::optional<int32_t>& parent, Skeleton& skeleton) {
     Joint joint;
     joint.name = node.name;
-    joint.localMatrix = node.localMatrix;
-    joint.skeletonSpaceMatrix = MakeIdentity4x4();
-    joint.transform = node.transform;
-    joint.index = int32_t(joints.size()); // 現在登録されている数をIndexに
+    joint.index = int32_t(skeleton.joints.size()); // 現在登録されている数をIndexに
     joint.parent = parent;
-    joints.push_back(joint); // SkeletonのJoint列に追加
+    skeleton.joints.push_back(joint); // SkeletonのJoint列に追加
+    skeleton.parentIndices.push_back(parent ? *parent : -1);
+    skeleton.transforms.push_back(node.transform);
+    skeleton.localMatrices.push_back(node.localMatrix);
+    skeleton.skeletonSpaceMatrices.push_back(MakeIdentity4x4());
 
-    for (const Model::Node& child : node.children) {
+    for (const ModelAsset::Node& child : node.children) {
         // 子Jointを作成し、そのIndexを登録
-        int32_t childIndex = CreateJoint(child, joint.index, joints);
-        joints[joint.index].children.push_back(childIndex);
+        int32_t childIndex = CreateJoint(child, joint.index, skeleton);
+        skeleton.joints[joint.index].children.push_back(childIndex);
     }
 
     // 自身のIndexを返す
     return joint.index;
 }
 
-Skeleton CreateSkeleton(const Model::Node& rootNode) {
+Skeleton CreateSkeleton(const ModelAsset::Node& rootNode) {
     Skeleton skeleton;
-    skeleton.root = CreateJoint(rootNode, {}, skeleton.joints);
+    skeleton.root = CreateJoint(rootNode, {}, skeleton);
 
     // 名前とindexのマッピングを行いアクセスしやすくする
     for (const Joint& joint : skeleton.joints) {
         skeleton.jointMap.emplace(joint.name, joint.index);
+        // 親を先に登録しているので、Update は先頭からの1回のループで済む
+        assert(skeleton.parentIndices[joint.index] < joint.index);
     }
 
     return skeleton;
@@ -34,23 +38,112 @@ Skeleton CreateSkeleton(const Model::Node& rootNode) {
 
 void Update(Skeleton& skeleton) {
     // すべてのJointを更新。親が若いので通常ループで処理可能になっている
-    for (Joint& joint : skeleton.joints) {
-        joint.localMatrix = MakeAffineMatrix(joint.transform.scale, joint.transform.rotate, joint.transform.translate);
-        if (joint.parent) { // 親がいれば親の行列を掛ける
-            joint.skeletonSpaceMatrix = Multiply(joint.localMatrix, skeleton.joints[*joint.parent].skeletonSpaceMatrix);
+    const size_t jointCount = skeleton.parentIndices.size();
+    const int32_t* parentIndices = skeleton.parentIndices.data();
+    const QuaternionTransform* transforms = skeleton.transforms.data();
+    Matrix4x4* localMatrices = skeleton.localMatrices.data();
+    Matrix4x4* skeletonSpaceMatrices = skeleton.skeletonSpaceMatrices.data();
+    for (size_t i = 0; i < jointCount; ++i) {
+        localMatrices[i] = MakeAffineMatrix(transforms[i].scale, transforms[i].rotate, transforms[i].translate);
+        if (parentIndices[i] >= 0) { // 親がいれば親の行列を掛ける
+            skeletonSpaceMatrices[i] = Multiply(localMatrices[i], skeletonSpaceMatrices[parentIndices[i]]);
         } else { // 親がいないのでlocalMatrixとskeletonSpaceMatrixは一致する
-            joint.skeletonSpaceMatrix = joint.localMatrix;
+            skeletonSpaceMatrices[i] = localMatrices[i];
         }
     }
 }
 
 void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime) {
-    for (Joint& joint : skeleton.joints) {
+    for (const Joint& joint : skeleton.joints) {
+        if (auto it = animation.nodeAnimations.find(joint.name); it != animation.nodeAnimations.end()) {
+            const NodeAnimation& rootNodeAnimation = it->second;
+            QuaternionTransform& transform = skeleton.transforms[joint.index];
+            transform.translate = CalculateValue(rootNodeAnimation.translate.keyframes, animationTime);
+            transform.rotate = CalculateValue(rootNodeAnimation.rotate.keyframes, animationTime);
+            transform.scale = CalculateValue(rootNodeAnimation.scale.keyframes, animationTime);
+        }
+    }
+}
+
+void ApplyAnimation(Skeleton& skeleton, const Animation& animation, float animationTime,
+                    std::vector<NodeAnimationCursor>& cursors) {
+    // カーソルは Joint ごとに1つ。Skeleton を作り直したときは合わせて作り直す
+    if (cursors.size() != skeleton.joints.size()) {
+        cursors.assign(skeleton.joints.size(), NodeAnimationCursor{});
+    }
+    for (const Joint& joint : skeleton.joints) {
         if (auto it = animation.nodeAnimations.find(joint.name); it != animation.nodeAnimations.end()) {
             const NodeAnimation& rootNodeAnimation = it->second;
-            joint.transform.translate = CalculateValue(rootNodeAnimation.translate.keyframes, animationTime);
-            joint.transform.rotate = CalculateValue(rootNodeAnimation.rotate.keyframes, animationTime);
-            joint.transform.scale = CalculateValue(rootNodeAnimation.scale.keyframes, animationTime);
+            NodeAnimationCursor& cursor = cursors[joint.index];
+            QuaternionTransform& transform = skeleton.transforms[joint.index];
+            transform.translate = SampleKeyframes(rootNodeAnimation.translate.keyframes, animationTime, cursor.translate);
+            transform.rotate = SampleKeyframes(rootNodeAnimation.rotate.keyframes, animationTime, cursor.rotate);
+            transform.scale = SampleKeyframes(rootNodeAnimation.scale.keyframes, animationTime, cursor.scale);
+        }
+    }
+}
+
+void ApplyAnimation(Skeleton& skeleton, const CompressedAnimation& animation, float animationTime) {
+    for (const Joint& joint : skeleton.joints) {
+        int32_t nodeIndex = animation.FindNode(joint.name);
+        if (nodeIndex >= 0) {
+            skeleton.transforms[joint.index] =
+                AnimationCompression::SampleNode(animation, static_cast<uint32_t>(nodeIndex), animationTime);
         }
     }
 }
+
+AnimationBinding BindAnimation(const Skeleton& skeleton, const Animation& animation) {
+    AnimationBinding binding;
+    binding.jointCount = skeleton.joints.size();
+    // Joint の並び（親が先）で持つと、書き込み先が前から順になる
+    for (const Joint& joint : skeleton.joints) {
+        if (auto it = animation.nodeAnimations.find(joint.name); it != animation.nodeAnimations.end()) {
+            binding.jointIndices.push_back(joint.index);
+            binding.nodeAnimations.push_back(&it->second);
+        }
+    }
+    return binding;
+}
+
+AnimationBinding BindAnimation(const Skeleton& skeleton, const CompressedAnimation& animation) {
+    AnimationBinding binding;
+    binding.jointCount = skeleton.joints.size();
+    for (const Joint& joint : skeleton.joints) {
+        int32_t nodeIndex = animation.FindNode(joint.name);
+        if (nodeIndex >= 0) {
+            binding.jointIndices.push_back(joint.index);
+            binding.nodeIndices.push_back(static_cast<uint32_t>(nodeIndex));
+        }
+    }
+    return binding;
+}
+
+void ApplyAnimation(Skeleton& skeleton, const AnimationBinding& binding, float animationTime,
+                    std::vector<NodeAnimationCursor>& cursors) {
+    assert(binding.jointCount == skeleton.joints.size());
+    assert(binding.nodeAnimations.size() == binding.jointIndices.size());
+    // カーソルはチャンネルごとに1つ
+    const size_t channelCount = binding.jointIndices.size();
+    if (cursors.size() != channelCount) {
+        cursors.assign(channelCount, NodeAnimationCursor{});
+    }
+    QuaternionTransform* transforms = skeleton.transforms.data();
+    for (size_t i = 0; i < channelCount; ++i) {
+        const NodeAnimation& nodeAnimation = *binding.nodeAnimations[i];
+        NodeAnimationCursor& cursor = cursors[i];
+        QuaternionTransform& transform = transforms[binding.jointIndices[i]];
+        transform.translate = SampleKeyframes(nodeAnimation.translate.keyframes, animationTime, cursor.translate);
+        transform.rotate = SampleKeyframes(nodeAnimation.rotate.keyframes, animationTime, cursor.rotate);
+        transform.scale = SampleKeyframes(nodeAnimation.scale.keyframes, animationTime, cursor.scale);
+    }
+}
+
+void ApplyAnimation(Skeleton& skeleton, const CompressedAnimation& animation,
+                    const AnimationBinding& binding, float animationTime) {
+    assert(binding.jointCount == skeleton.joints.size());
+    assert(binding.nodeIndices.size() == binding.jointIndices.size());
+    AnimationCompression::SampleNodes(animation, animationTime, binding.nodeIndices.data(),
+                                      binding.jointIndices.data(), binding.jointIndices.size(),
+                                      skeleton.transforms.data());
+}
@@ -2,9 +2,11 @@
 #include "Render/Model/Skeleton.h"
 #include "Core/Dx12Core.h"
 #include "Core/SrvManager.h"
+#include "Debug/Logger.h"
 #include <algorithm>
 
-SkinCluster CreateSkinCluster(Dx12Core* dx12Core, SrvManager* srvManager, const Skeleton& skeleton, Model* model) {
+SkinCluster CreateSkinCluster(Dx12Core* dx12Core, SrvManager* srvManager, const Skeleton& skeleton, Model* model,
+                              const SkinWeightSettings& weightSettings) {
     SkinCluster skinCluster;
     const Model::ModelData& modelData = model->GetModelData();
 
@@ -20,24 +22,12 @@ SkinCluster CreateSkinCluster(Dx12Core* dx12Core, SrvManager* srvManager, const
     skinCluster.paletteSrvHandle.second = srvManager->GetGPUDescriptorHandle(srvIndex);
     srvManager->CreateSRVforStructuredBuffer(srvIndex, skinCluster.paletteResource.Get(), static_cast<UINT>(skeleton.joints.size()), sizeof(WellForGPU));
 
-    // 3. influence用のResourceを確保
-    skinCluster.influenceResource = dx12Core->CreateBufferResource(sizeof(VertexInfluence) * modelData.vertices.size());
-    VertexInfluence* mappedInfluence = nullptr;
-    skinCluster.influenceResource->Map(0, nullptr, reinterpret_cast<void**>(&mappedInfluence));
-    std::memset(mappedInfluence, 0, sizeof(VertexInfluence) * modelData.vertices.size()); // 0埋め。weightを0にしておく。
-    skinCluster.mappedInfluence = { mappedInfluence, modelData.vertices.size() };
-
-    // 4. Influence用のSRVを作成
-    uint32_t influenceSrvIndex = srvManager->Allocate();
-    skinCluster.influenceSrvHandle.first = srvManager->GetCPUDescriptorHandle(influenceSrvIndex);
-    skinCluster.influenceSrvHandle.second = srvManager->GetGPUDescriptorHandle(influenceSrvIndex);
-    srvManager->CreateSRVforStructuredBuffer(influenceSrvIndex, skinCluster.influenceResource.Get(), static_cast<UINT>(modelData.vertices.size()), sizeof(VertexInfluence));
-
-    // 5. InverseBindPoseMatrixの保存領域を作成して、単位行列で埋める
+    // 3. InverseBindPoseMatrixの保存領域を作成して、単位行列で埋める
     skinCluster.inverseBindPoseMatrices.resize(skeleton.joints.size());
     std::generate(skinCluster.inverseBindPoseMatrices.begin(), skinCluster.inverseBindPoseMatrices.end(), MakeIdentity4x4);
 
-    // 6. ModelDataのSkinCluster情報を解析してInfluenceの中身を埋める
+    // 4. ModelDataのSkinCluster情報を解析して、InverseBindPoseMatrixと頂点ごとの影響を集める
+    std::vector<SkinWeight> skinWeights;
     for (const auto& jointWeight : modelData.skinClusterData) {
         auto it = skeleton.jointMap.find(jointWeight.first);
         if (it == skeleton.jointMap.end()) {
@@ -48,17 +38,33 @@ SkinCluster CreateSkinCluster(Dx12Core* dx12Core, SrvManager* srvManager, const
         skinCluster.inverseBindPoseMatrices[(*it).second] = jointWeight.second.inverseBindPoseMatrix;
 
         for (const auto& vertexWeight : jointWeight.second.vertexWeights) {
-            auto& currentInfluence = skinCluster.mappedInfluence[vertexWeight.vertexIndex]; // 該当のvertexIndexのinfluence情報を参照しておく
-            for (uint32_t index = 0; index < kNumMaxInfluence; ++index) {
-                if (currentInfluence.weights[index] == 0.0f) { // weight==0が空いている状態なので、その場所にweightとjointのindexを代入
-                    currentInfluence.weights[index] = vertexWeight.weight;
-                    currentInfluence.jointIndices[index] = (*it).second;
-                    break;
-                }
-            }
+            skinWeights.push_back({ vertexWeight.vertexIndex, static_cast<uint32_t>((*it).second), vertexWeight.weight });
         }
     }
 
+    // 5. 大きい順に上限まで残して正規化し、量子化して詰める（float4 + int4 の 32 バイトより小さくなる）
+    PackedSkinWeights packed = Skinning::PackSkinWeights(skinWeights.data(), skinWeights.size(), modelData.vertices.size(),
+                                                         static_cast<uint32_t>(skeleton.joints.size()), weightSettings);
+    if (packed.truncatedVertexCount != 0) {
+        Logger::Log("[SkinCluster] " + std::to_string(packed.truncatedVertexCount) + " vertices had more than " +
+                    std::to_string(packed.influenceCount) + " influences (max " + std::to_string(packed.maxSourceInfluences) +
+                    ", dropped up to " + std::to_string(packed.maxDroppedWeight * 100.0f) + "% of the weight, renormalized)\n");
+    }
+
+    // 6. influence用のResourceを確保してSRVを作成 (uintのStructuredBuffer)
+    const size_t influenceWordCount = std::max<size_t>(packed.words.size(), 1);
+    skinCluster.influenceResource = dx12Core->CreateBufferResource(sizeof(uint32_t) * influenceWordCount);
+    uint32_t* mappedInfluence = nullptr;
+    skinCluster.influenceResource->Map(0, nullptr, reinterpret_cast<void**>(&mappedInfluence));
+    std::memset(mappedInfluence, 0, sizeof(uint32_t) * influenceWordCount);
+    std::memcpy(mappedInfluence, packed.words.data(), sizeof(uint32_t) * packed.words.size());
+    skinCluster.mappedInfluence = { mappedInfluence, packed.words.size() };
+
+    uint32_t influenceSrvIndex = srvManager->Allocate();
+    skinCluster.influenceSrvHandle.first = srvManager->GetCPUDescriptorHandle(influenceSrvIndex);
+    skinCluster.influenceSrvHandle.second = srvManager->GetGPUDescriptorHandle(influenceSrvIndex);
+    srvManager->CreateSRVforStructuredBuffer(influenceSrvIndex, skinCluster.influenceResource.Get(), static_cast<UINT>(influenceWordCount), sizeof(uint32_t));
+
     // 7. 入力頂点用のSRVを作成 (ModelのVertexResourceを利用)
     uint32_t inputVertexSrvIndex = srvManager->Allocate();
     skinCluster.inputVertexSrvHandle.first = srvManager->GetCPUDescriptorHandle(inputVertexSrvIndex);
@@ -85,21 +91,22 @@ SkinCluster CreateSkinCluster(Dx12Core* dx12Core, SrvManager* srvManager, const
     SkinningInformation* mappedInfo = nullptr;
     skinCluster.skinningInformationResource->Map(0, nullptr, reinterpret_cast<void**>(&mappedInfo));
     mappedInfo->numVertices = static_cast<uint32_t>(modelData.vertices.size());
+    mappedInfo->influenceCount = packed.influenceCount;
+    mappedInfo->weightBits = packed.weightBits;
+    mappedInfo->indexBits = packed.indexBits;
+    mappedInfo->weightWords = packed.weightWords;
+    mappedInfo->strideInWords = packed.strideInWords;
     // mappedInfoのUnmapは省略（MapしっぱなしでOK）
 
     return skinCluster;
 }
 
 void Update(SkinCluster& skinCluster, const Skeleton& skeleton) {
-    for (size_t jointIndex = 0; jointIndex < skeleton.joints.size(); ++jointIndex) {
-        assert(jointIndex < skinCluster.inverseBindPoseMatrices.size());
-        
-        // パレットの位置用行列を計算： 初期姿勢の逆行列 * 現在のアニメーション姿勢行列
-        skinCluster.mappedPalette[jointIndex].skeletonSpaceMatrix =
-            Multiply(skinCluster.inverseBindPoseMatrices[jointIndex], skeleton.joints[jointIndex].skeletonSpaceMatrix);
-        
-        // パレットの法線用行列を計算： 位置用行列の逆転置行列
-        skinCluster.mappedPalette[jointIndex].skeletonSpaceInverseTransposeMatrix =
-            Transpose(Inverse(skinCluster.mappedPalette[jointIndex].skeletonSpaceMatrix));
-    }
+    assert(skeleton.skeletonSpaceMatrices.size() <= skinCluster.inverseBindPoseMatrices.size());
+
+    // 位置用： 初期姿勢の逆行列 * 現在のアニメーション姿勢行列
+    // 法線用： 位置用の逆転置（一般の逆行列は使わず、3x3 の余因子から求める）
+    // mappedPalette は Map したままのアップロード用バッファなので、書くだけで読み戻さない
+    Skinning::BuildPalette(skinCluster.inverseBindPoseMatrices.data(), skeleton.skeletonSpaceMatrices.data(),
+                           skeleton.skeletonSpaceMatrices.size(), skinCluster.mappedPalette.data());
 }
@@ -0,0 +1,336 @@
+#include "Render/Model/Skinning.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SKINNING_USE_SSE
+#endif
+
+namespace {
+
+// 行列式がこれより小さい（潰れた）行列は割らずに余因子のまま使う。法線は最後に正規化するので向きは保たれる
+constexpr float kMinDeterminant = 1.0e-20f;
+
+#ifdef SKINNING_USE_SSE
+
+__m128 LoadRow(const Matrix4x4 &m, int row) { return _mm_loadu_ps(m.m[row]); }
+
+// row * matrix（行ベクトル × 行列）。Multiply と同じ順に足すので結果も一致する
+__m128 TransformRow(__m128 row, const __m128 b[4]) {
+  __m128 x = _mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0));
+  __m128 y = _mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1));
+  __m128 z = _mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2));
+  __m128 w = _mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3));
+  __m128 result = _mm_add_ps(_mm_mul_ps(x, b[0]), _mm_mul_ps(y, b[1]));
+  result = _mm_add_ps(result, _mm_mul_ps(z, b[2]));
+  return _mm_add_ps(result, _mm_mul_ps(w, b[3]));
+}
+
+// 外積。w レーンは a.w * b.w - a.w * b.w で 0 になる
+__m128 Cross(__m128 a, __m128 b) {
+  __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+  return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+float Dot3(__m128 a, __m128 b) {
+  __m128 m = _mm_mul_ps(a, b);
+  __m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+  __m128 z = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+  return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(m, y), z));
+}
+
+#else
+
+void Cross(const float a[3], const float b[3], float out[4]) {
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+  out[3] = 0.0f;
+}
+
+#endif
+
+// bits（8 か 16）ビットずつ下位から詰めた element 番目に書く／読む（Skinning.CS の ReadPacked と同じ並び）
+// 1語に入る数は 4 か 2 なので、割り算ではなくシフトで語と位置を求める
+uint32_t ElementsPerWordShift(uint32_t bits) { return bits == 8 ? 2 : 1; }
+
+void PackBits(uint32_t *words, uint32_t element, uint32_t bits, uint32_t value) {
+  const uint32_t shift = ElementsPerWordShift(bits);
+  words[element >> shift] |= value << ((element & ((1u << shift) - 1)) * bits);
+}
+
+uint32_t ReadBits(const uint32_t *words, uint32_t element, uint32_t bits) {
+  const uint32_t shift = ElementsPerWordShift(bits);
+  return (words[element >> shift] >> ((element & ((1u << shift) - 1)) * bits)) & ((1u << bits) - 1u);
+}
+
+// 1頂点分の線形ブレンドスキニング（count 個の影響を順に足す）
+template <typename Index>
+void SkinVertex(const WellForGPU *palette, const ModelAsset::VertexData &input, const float *weights,
+                const Index *jointIndices, uint32_t count, ModelAsset::VertexData &skinned) {
+#ifdef SKINNING_USE_SSE
+  const __m128 px = _mm_set1_ps(input.position.x);
+  const __m128 py = _mm_set1_ps(input.position.y);
+  const __m128 pz = _mm_set1_ps(input.position.z);
+  const __m128 pw = _mm_set1_ps(input.position.w);
+  const __m128 nx = _mm_set1_ps(input.normal.x);
+  const __m128 ny = _mm_set1_ps(input.normal.y);
+  const __m128 nz = _mm_set1_ps(input.normal.z);
+
+  __m128 position = _mm_setzero_ps();
+  __m128 normal = _mm_setzero_ps();
+  for (uint32_t k = 0; k < count; ++k) {
+    const WellForGPU &well = palette[jointIndices[k]];
+    const __m128 weight = _mm_set1_ps(weights[k]);
+
+    // mul(position, skeletonSpaceMatrix) * weight
+    __m128 p = _mm_add_ps(_mm_mul_ps(px, LoadRow(well.skeletonSpaceMatrix, 0)),
+                          _mm_mul_ps(py, LoadRow(well.skeletonSpaceMatrix, 1)));
+    p = _mm_add_ps(p, _mm_mul_ps(pz, LoadRow(well.skeletonSpaceMatrix, 2)));
+    p = _mm_add_ps(p, _mm_mul_ps(pw, LoadRow(well.skeletonSpaceMatrix, 3)));
+    position = _mm_add_ps(position, _mm_mul_ps(p, weight));
+
+    // mul(normal, (float3x3)skeletonSpaceInverseTransposeMatrix) * weight（w レーンは使わない）
+    __m128 n = _mm_add_ps(_mm_mul_ps(nx, LoadRow(well.skeletonSpaceInverseTransposeMatrix, 0)),
+                          _mm_mul_ps(ny, LoadRow(well.skeletonSpaceInverseTransposeMatrix, 1)));
+    n = _mm_add_ps(n, _mm_mul_ps(nz, LoadRow(well.skeletonSpaceInverseTransposeMatrix, 2)));
+    normal = _mm_add_ps(normal, _mm_mul_ps(n, weight));
+  }
+
+  alignas(16) float positionOut[4];
+  _mm_store_ps(positionOut, position);
+  skinned.position = {positionOut[0], positionOut[1], positionOut[2], 1.0f}; // 確実に1を入れる
+
+  float lengthSquared = Dot3(normal, normal);
+  alignas(16) float normalOut[4];
+  _mm_store_ps(normalOut, _mm_mul_ps(normal, _mm_set1_ps(1.0f / std::sqrt(lengthSquared))));
+  skinned.normal = {normalOut[0], normalOut[1], normalOut[2]};
+#else
+  float position[4] = {};
+  float normal[3] = {};
+  for (uint32_t k = 0; k < count; ++k) {
+    const WellForGPU &well = palette[jointIndices[k]];
+    const Matrix4x4 &m = well.skeletonSpaceMatrix;
+    const Matrix4x4 &n = well.skeletonSpaceInverseTransposeMatrix;
+    const float weight = weights[k];
+    for (int j = 0; j < 4; ++j) {
+      float p = input.position.x * m.m[0][j] + input.position.y * m.m[1][j] +
+                input.position.z * m.m[2][j] + input.position.w * m.m[3][j];
+      position[j] += p * weight;
+    }
+    for (int j = 0; j < 3; ++j) {
+      float value = input.normal.x * n.m[0][j] + input.normal.y * n.m[1][j] + input.normal.z * n.m[2][j];
+      normal[j] += value * weight;
+    }
+  }
+  skinned.position = {position[0], position[1], position[2], 1.0f}; // 確実に1を入れる
+  float inverseLength =
+      1.0f / std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+  skinned.normal = {normal[0] * inverseLength, normal[1] * inverseLength, normal[2] * inverseLength};
+#endif
+
+  skinned.texcoord = input.texcoord;
+}
+
+} // namespace
+
+uint32_t PackedSkinWeights::Decode(size_t vertex, float *outWeights, uint32_t *outJointIndices) const {
+  const uint32_t *record = words.data() + vertex * strideInWords;
+  const float weightScale = weightBits == 8 ? 1.0f / 255.0f : 1.0f / 65535.0f;
+  uint32_t count = 0;
+  for (; count < influenceCount; ++count) {
+    float weight = float(ReadBits(record, count, weightBits)) * weightScale;
+    if (weight == 0.0f) {
+      break; // 大きい順に並んでいるので、0 が出たら残りも 0
+    }
+    outWeights[count] = weight;
+    outJointIndices[count] = ReadBits(record + weightWords, count, indexBits);
+  }
+  return count;
+}
+
+namespace Skinning {
+
+void BuildPalette(const Matrix4x4 *inverseBindPoseMatrices, const Matrix4x4 *skeletonSpaceMatrices,
+                  size_t jointCount, WellForGPU *outPalette) {
+  for (size_t joint = 0; joint < jointCount; ++joint) {
+    const Matrix4x4 &inverseBindPose = inverseBindPoseMatrices[joint];
+    const Matrix4x4 &skeletonSpace = skeletonSpaceMatrices[joint];
+    WellForGPU &well = outPalette[joint];
+
+#ifdef SKINNING_USE_SSE
+    const __m128 b[4] = {LoadRow(skeletonSpace, 0), LoadRow(skeletonSpace, 1),
+                         LoadRow(skeletonSpace, 2), LoadRow(skeletonSpace, 3)};
+    __m128 row0 = TransformRow(LoadRow(inverseBindPose, 0), b);
+    __m128 row1 = TransformRow(LoadRow(inverseBindPose, 1), b);
+    __m128 row2 = TransformRow(LoadRow(inverseBindPose, 2), b);
+    __m128 row3 = TransformRow(LoadRow(inverseBindPose, 3), b);
+
+    // 書き込み先は書き込み結合のメモリのことがあるので、求めた値を順に書くだけにする
+    _mm_storeu_ps(well.skeletonSpaceMatrix.m[0], row0);
+    _mm_storeu_ps(well.skeletonSpaceMatrix.m[1], row1);
+    _mm_storeu_ps(well.skeletonSpaceMatrix.m[2], row2);
+    _mm_storeu_ps(well.skeletonSpaceMatrix.m[3], row3);
+
+    // 3x3 の逆転置 = 余因子行列 / 行列式。余因子の各行は他の2行の外積になる
+    __m128 cofactor0 = Cross(row1, row2);
+    __m128 cofactor1 = Cross(row2, row0);
+    __m128 cofactor2 = Cross(row0, row1);
+    float determinant = Dot3(row0, cofactor0);
+    __m128 scale = _mm_set1_ps(std::fabs(determinant) > kMinDeterminant ? 1.0f / determinant : 1.0f);
+    _mm_storeu_ps(well.skeletonSpaceInverseTransposeMatrix.m[0], _mm_mul_ps(cofactor0, scale));
+    _mm_storeu_ps(well.skeletonSpaceInverseTransposeMatrix.m[1], _mm_mul_ps(cofactor1, scale));
+    _mm_storeu_ps(well.skeletonSpaceInverseTransposeMatrix.m[2], _mm_mul_ps(cofactor2, scale));
+    _mm_storeu_ps(well.skeletonSpaceInverseTransposeMatrix.m[3], _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+#else
+    Matrix4x4 position;
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        position.m[i][j] = inverseBindPose.m[i][0] * skeletonSpace.m[0][j] +
+                           inverseBindPose.m[i][1] * skeletonSpace.m[1][j] +
+                           inverseBindPose.m[i][2] * skeletonSpace.m[2][j] +
+                           inverseBindPose.m[i][3] * skeletonSpace.m[3][j];
+      }
+    }
+    well.skeletonSpaceMatrix = position;
+
+    Matrix4x4 normal{};
+    Cross(position.m[1], position.m[2], normal.m[0]);
+    Cross(position.m[2], position.m[0], normal.m[1]);
+    Cross(position.m[0], position.m[1], normal.m[2]);
+    float determinant = position.m[0][0] * normal.m[0][0] + position.m[0][1] * normal.m[0][1] +
+                        position.m[0][2] * normal.m[0][2];
+    float scale = std::fabs(determinant) > kMinDeterminant ? 1.0f / determinant : 1.0f;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        normal.m[i][j] *= scale;
+      }
+    }
+    normal.m[3][3] = 1.0f;
+    well.skeletonSpaceInverseTransposeMatrix = normal;
+#endif
+  }
+}
+
+void SkinVertices(const WellForGPU *palette, const ModelAsset::VertexData *inputVertices,
+                  const VertexInfluence *influences, size_t vertexCount,
+                  ModelAsset::VertexData *outVertices) {
+  for (size_t v = 0; v < vertexCount; ++v) {
+    SkinVertex(palette, inputVertices[v], influences[v].weights.data(), influences[v].jointIndices.data(),
+               kNumMaxInfluence, outVertices[v]);
+  }
+}
+
+PackedSkinWeights PackSkinWeights(const SkinWeight *weights, size_t weightCount, size_t vertexCount,
+                                  uint32_t jointCount, const SkinWeightSettings &settings) {
+  assert(settings.maxInfluences == 4 || settings.maxInfluences == 8);
+  assert(settings.weightBits == 8 || settings.weightBits == 16);
+  assert(settings.indexBits == 0 || settings.indexBits == 8 || settings.indexBits == 16);
+
+  PackedSkinWeights packed;
+  packed.influenceCount = settings.maxInfluences;
+  packed.weightBits = settings.weightBits;
+  packed.indexBits = settings.indexBits != 0 ? settings.indexBits : (jointCount <= 256 ? 8 : 16);
+  assert(jointCount <= (1u << packed.indexBits));
+  packed.weightWords = (packed.influenceCount * packed.weightBits + 31) / 32;
+  packed.strideInWords = packed.weightWords + (packed.influenceCount * packed.indexBits + 31) / 32;
+  packed.vertexCount = vertexCount;
+  packed.words.assign(vertexCount * packed.strideInWords, 0);
+
+  // 頂点ごとにまとめる（数えて先頭を決めてから並べる）
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+  for (size_t i = 0; i < weightCount; ++i) {
+    assert(weights[i].vertexIndex < vertexCount);
+    if (weights[i].weight > 0.0f) {
+      ++offsets[weights[i].vertexIndex + 1];
+    }
+  }
+  for (size_t v = 0; v < vertexCount; ++v) {
+    offsets[v + 1] += offsets[v];
+  }
+  std::vector<SkinWeight> sorted(offsets[vertexCount]);
+  {
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < weightCount; ++i) {
+      if (weights[i].weight > 0.0f) {
+        sorted[cursor[weights[i].vertexIndex]++] = weights[i];
+      }
+    }
+  }
+
+  const uint32_t maxValue = (1u << packed.weightBits) - 1;
+  for (size_t v = 0; v < vertexCount; ++v) {
+    SkinWeight *begin = sorted.data() + offsets[v];
+    SkinWeight *end = sorted.data() + offsets[v + 1];
+    const uint32_t sourceCount = static_cast<uint32_t>(end - begin);
+    if (sourceCount == 0) {
+      continue; // 影響のない頂点は重み 0 のまま（元の float の形と同じ）
+    }
+    packed.maxSourceInfluences = std::max(packed.maxSourceInfluences, sourceCount);
+
+    // 大きい順（同じ重みは Joint 番号順にして、結果を並び順によらず決める）
+    std::sort(begin, end, [](const SkinWeight &a, const SkinWeight &b) {
+      return a.weight != b.weight ? a.weight > b.weight : a.jointIndex < b.jointIndex;
+    });
+
+    const uint32_t keptCount = std::min(sourceCount, packed.influenceCount);
+    float totalWeight = 0.0f;
+    float keptWeight = 0.0f;
+    for (uint32_t k = 0; k < sourceCount; ++k) {
+      totalWeight += begin[k].weight;
+      if (k < keptCount) {
+        keptWeight += begin[k].weight;
+      }
+    }
+    if (keptCount < sourceCount) {
+      ++packed.truncatedVertexCount;
+      packed.maxDroppedWeight = std::max(packed.maxDroppedWeight, 1.0f - keptWeight / totalWeight);
+    }
+
+    // 残したものを正規化して量子化し、丸めのずれは一番大きい重みに寄せて合計をちょうど maxValue にする
+    uint32_t quantized[kNumMaxPackedInfluence] = {};
+    int32_t quantizedSum = 0;
+    for (uint32_t k = 0; k < keptCount; ++k) {
+      quantized[k] = static_cast<uint32_t>(std::lround(begin[k].weight / keptWeight * float(maxValue)));
+      quantizedSum += static_cast<int32_t>(quantized[k]);
+    }
+    quantized[0] = static_cast<uint32_t>(static_cast<int32_t>(quantized[0]) + (int32_t(maxValue) - quantizedSum));
+
+    uint32_t *record = packed.words.data() + v * packed.strideInWords;
+    for (uint32_t k = 0; k < keptCount; ++k) {
+      PackBits(record, k, packed.weightBits, quantized[k]);
+      PackBits(record + packed.weightWords, k, packed.indexBits, begin[k].jointIndex);
+    }
+  }
+  return packed;
+}
+
+void SkinVerticesPacked(const WellForGPU *palette, const ModelAsset::VertexData *inputVertices,
+                        const PackedSkinWeights &influences, ModelAsset::VertexData *outVertices) {
+  // 重み 0 の枠も番号 0 として足す（0 を掛けて足しても結果は変わらない）
+  // 影響の数が頂点ごとに変わらないので、分岐の予測が外れず、ループも展開される
+  const uint32_t *record = influences.words.data();
+  const uint32_t influenceCount = influences.influenceCount;
+  const uint32_t weightBits = influences.weightBits;
+  const uint32_t indexBits = influences.indexBits;
+  const float weightScale = weightBits == 8 ? 1.0f / 255.0f : 1.0f / 65535.0f;
+  float weights[kNumMaxPackedInfluence];
+  uint32_t jointIndices[kNumMaxPackedInfluence];
+  for (size_t v = 0; v < influences.vertexCount; ++v, record += influences.strideInWords) {
+    for (uint32_t k = 0; k < influenceCount; ++k) {
+      weights[k] = float(ReadBits(record, k, weightBits)) * weightScale;
+      jointIndices[k] = ReadBits(record + influences.weightWords, k, indexBits);
+    }
+    if (influenceCount == 4) {
+      SkinVertex(palette, inputVertices[v], weights, jointIndices, 4, outVertices[v]);
+    } else {
+      SkinVertex(palette, inputVertices[v], weights, jointIndices, kNumMaxPackedInfluence, outVertices[v]);
+    }
+  }
+}
+
+} // namespace Skinning
@@ -2,7 +2,9 @@
 #include "Camera/ICamera.h"
 #include "Debug/Logger.h"
 #include "Math/MathUtil.h"
+#include "Model/ModelBounds.h"
 #include "Model/ModelManager.h"
+#include "Renderer/D3D12CommandRecorder.h"
 #include "Renderer/Object3dRenderer.h"
 #include "Texture/TextureManager.h"
 #include <cassert>
@@ -27,11 +29,14 @@ void Object3d::Initialize(Object3dRenderer *object3dRenderer) {
     return;
   }
 
-  CreateTransformationMatrixData();
+  // 定数バッファは描くたびにフレームのアップロード領域から切り出すので、ここでは初期値だけ
+  transformation_.WVP = MakeIdentity4x4();
+  transformation_.World = MakeIdentity4x4();
+  transformation_.WorldInverseTranspose = MakeIdentity4x4();
 
-  CreateCameraForGPUData();
+  cameraForGPU_.worldPosition = {0.0f, 0.0f, 0.0f};
 
-  CreateMaterialData();
+  InitializeMaterial();
 
   TextureManager::GetInstance()->LoadTexture("resources/Skybox/Skybox.dds");
   TextureManager::GetInstance()->LoadTexture(maskTexturePath_);
@@ -42,23 +47,23 @@ void Object3d::Initialize(Object3dRenderer *object3dRenderer) {
 void Object3d::Update() {
 
   assert(object3dRenderer_ && "Object3d::Update: not initialized");
-  assert(transformationMatrixData &&
-         "Object3d::Update: transformationMatrixData is null");
-  assert(cameraForGPUData && "Object3d::Update: cameraForGPUData is null");
 
   const ICamera *activeCamera =
       (camera_ != nullptr) ? camera_ : object3dRenderer_->GetDefaultCamera();
 
+  // 非同期読み込み中のプレースホルダーはデータが空なので参照しない
+  const bool isModelReady = model_ && model_->IsReady();
+
   Matrix4x4 localMatrix = MakeIdentity4x4();
-  if (isPlayingAnimation_ && model_) {
+  if (isPlayingAnimation_ && isModelReady) {
       animationTime_ += 1.0f / 60.0f; // 時刻を進める
       animationTime_ = std::fmod(animationTime_, currentAnimation_.duration); // リピート再生
       NodeAnimation& rootNodeAnimation = currentAnimation_.nodeAnimations[model_->GetRootNode().name];
-      Vector3 translate = CalculateValue(rootNodeAnimation.translate.keyframes, animationTime_);
-      Quaternion rotate = CalculateValue(rootNodeAnimation.rotate.keyframes, animationTime_);
-      Vector3 scale = CalculateValue(rootNodeAnimation.scale.keyframes, animationTime_);
+      Vector3 translate = SampleKeyframes(rootNodeAnimation.translate.keyframes, animationTime_, animationCursor_.translate);
+      Quaternion rotate = SampleKeyframes(rootNodeAnimation.rotate.keyframes, animationTime_, animationCursor_.rotate);
+      Vector3 scale = SampleKeyframes(rootNodeAnimation.scale.keyframes, animationTime_, animationCursor_.scale);
       localMatrix = MakeAffineMatrix(scale, rotate, translate);
-  } else if (model_) {
+  } else if (isModelReady) {
       localMatrix = model_->GetRootLocalMatrix();
   }
 
@@ -84,71 +89,141 @@ void Object3d::Update() {
   if (activeCamera) {
     const Matrix4x4 &vp = activeCamera->GetViewProjectionMatrix();
     worldViewProjectionMatrix = Multiply(finalWorld, vp);
-    cameraForGPUData->worldPosition = activeCamera->GetTranslate();
+    cameraForGPU_.worldPosition = activeCamera->GetTranslate();
   } else {
     worldViewProjectionMatrix = finalWorld;
   }
 
-  transformationMatrixData->WVP = worldViewProjectionMatrix;
-  transformationMatrixData->World = finalWorld;
-  transformationMatrixData->WorldInverseTranspose =
-      Transpose(Inverse(finalWorld));
+  // GPU へは Draw で書き出す（インスタンス描画ではインスタンスバッファに集める）
+  transformation_.WVP = worldViewProjectionMatrix;
+  transformation_.World = finalWorld;
+  transformation_.WorldInverseTranspose = Transpose(Inverse(finalWorld));
+  drawCamera_ = activeCamera;
+
+  // アニメーションの境界が設定されていればそれを使う（ノードアニメーションは finalWorld に入っている）
+  if (hasAnimatedBounds_) {
+    worldAABB_ = TransformAABB(animatedAABB_, finalWorld);
+    worldSphere_ = TransformSphere(ModelBounds::MakeSphere(animatedAABB_), finalWorld);
+  } else if (isModelReady) {
+    worldAABB_ = TransformAABB(model_->GetLocalAABB(), finalWorld);
+    worldSphere_ = TransformSphere(model_->GetLocalSphere(), finalWorld);
+  } else {
+    worldAABB_ = {};
+    worldSphere_ = {};
+  }
+  const Sphere &worldSphere = worldSphere_;
+
+  // 描画キューの深度（距離の2乗。大小の順だけ使う）
+  sortDepth_ = activeCamera ? LengthSq(worldSphere.center - activeCamera->GetTranslate()) : 0.0f;
+
+  // デフォルトカメラで描くメッシュはカリング対象として登録する
+  // スキニングは頂点がボーンで動くため、バインドポーズの境界球では判定できない。姿勢の境界があるときだけ対象にする
+  isCullRegistered_ = false;
+  if (isModelReady && (!skinCluster_ || hasAnimatedBounds_) && camera_ == nullptr) {
+    FrustumCuller *culler = object3dRenderer_->GetCuller();
+    cullIndex_ = culler->Submit(worldSphere);
+    cullFrame_ = culler->GetFrame();
+    isCullRegistered_ = true;
+  }
+
+  // 画面に映る大きさから LOD を選ぶ（LOD は頂点を共有するのでスキニングでも使える）
+  if (isModelReady && activeCamera && lodEnabled_ && !model_->GetLods().empty()) {
+    float distance = Length(worldSphere.center - activeCamera->GetTranslate());
+    float screenSize = ModelAsset::ProjectedScreenSize(
+        worldSphere.radius, distance, activeCamera->GetProjectionMatrix().m[1][1]);
+    lodIndex_ = ModelAsset::SelectLod(model_->GetLods(), screenSize, lodIndex_, kLodHysteresis);
+  } else {
+    lodIndex_ = 0;
+  }
 }
 
 void Object3d::Draw() {
 
   assert(dx12Core_ && "Object3d::Draw: not initialized");
   assert(object3dRenderer_ && "Object3d::Draw: not initialized");
-  assert(materialResource && "Object3d::Draw: materialResource is null");
-  assert(transformationMatrixResource &&
-         "Object3d::Draw: transformationMatrixResource is null");
-  assert(cameraForGPUResource &&
-         "Object3d::Draw: cameraForGPUResource is null");
-
-  Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList =
-      dx12Core_->GetCommandList();
+
+  // 視錐台の外にあるものはコマンドを積まない
+  if (isCullRegistered_ &&
+      !object3dRenderer_->GetCuller()->IsVisible(cullIndex_, cullFrame_)) {
+    return;
+  }
+
+  // インスタンス描画が有効なら登録だけして、Object3dRenderer::Flush でまとめて描く
+  // スキニングは頂点バッファがオブジェクトごとなのでまとめられない
+  if (isInstancingEnabled_ && !skinCluster_ && model_ && model_->IsReady()) {
+    UploadFrameConstants(false);
+    InstanceBatcher::Key key;
+    key.mesh = model_;
+    key.lodIndex = lodIndex_;
+    key.pipeline = object3dRenderer_->GetInstancedPipelineState();
+    key.material = GetMaterialKey();
+    key.view = drawCamera_;
+    object3dRenderer_->SubmitInstance(
+        this, key,
+        {transformation_.WVP, transformation_.World,
+         transformation_.WorldInverseTranspose});
+    return;
+  }
+
+  // 3Dモデルが割り当てられていなければ描くものがない
+  if (!model_) {
+    return;
+  }
+
+  // このフレームの定数データ（描く時点の値。キューで後から積んでも変わらない）
+  UploadFrameConstants(true);
+
+  // 並べ替えが有効ならキューに登録して、Object3dRenderer::Flush でソートキーの順に描く
+  if (object3dRenderer_->IsSortEnabled()) {
+    object3dRenderer_->SubmitObject(this, GetMaterialKey());
+    return;
+  }
+
+  ID3D12GraphicsCommandList *commandList = dx12Core_->GetCommandList();
   assert(commandList && "Object3d::Draw: commandList is null");
+  D3D12CommandRecorder recorder(commandList);
 
-  // マテリアルCBufferの場所を設定
-  commandList->SetGraphicsRootConstantBufferView(
-      0, materialResource->GetGPUVirtualAddress());
+  // ライト・環境マップ・フォグ
+  object3dRenderer_->RecordSharedParameters(recorder);
 
-  // wvp用のCBufferの場所を設定
-  commandList->SetGraphicsRootConstantBufferView(
-      1, transformationMatrixResource->GetGPUVirtualAddress());
+  RecordDraw(recorder);
+}
 
-  // Lighting
-  commandList->SetGraphicsRootConstantBufferView(
-      3,
-      object3dRenderer_->GetDirectionalLightResource()->GetGPUVirtualAddress());
+void Object3d::RecordDraw(ICommandRecorder &recorder) const {
+  // マテリアル・カメラ・マスク
+  RecordObjectParameters(recorder);
 
-  // Camera
-  commandList->SetGraphicsRootConstantBufferView(
-      4, cameraForGPUResource->GetGPUVirtualAddress());
+  // wvp用のCBufferの場所を設定
+  recorder.SetRootConstantBufferView(1, transformationAddress_);
 
-  // PointLight
-  commandList->SetGraphicsRootConstantBufferView(
-      5, object3dRenderer_->GetPointLightResource()->GetGPUVirtualAddress());
+  if (model_) {
+    model_->Record(recorder, skinCluster_, lodIndex_, 1);
+  }
+}
 
-  // SpotLight
-  commandList->SetGraphicsRootConstantBufferView(
-      6, object3dRenderer_->GetSpotLightResource()->GetGPUVirtualAddress());
+void Object3d::RecordObjectParameters(ICommandRecorder &recorder) const {
+  // マテリアルCBufferの場所を設定
+  recorder.SetRootConstantBufferView(0, materialAddress_);
 
-  // Environment Map (Skybox)
-  commandList->SetGraphicsRootDescriptorTable(
-      7, TextureManager::GetInstance()->GetSrvHandleGPU("resources/Skybox/Skybox.dds"));
+  // Camera
+  recorder.SetRootConstantBufferView(4, cameraAddress_);
 
   // Mask Texture for Dissolve
-  commandList->SetGraphicsRootDescriptorTable(
-      8, TextureManager::GetInstance()->GetSrvHandleGPU(maskTexturePath_));
+  recorder.SetRootDescriptorTable(
+      8, TextureManager::GetInstance()->GetSrvHandleGPU(maskTexturePath_).ptr);
+}
 
-  // Fog
-  commandList->SetGraphicsRootConstantBufferView(
-      9, object3dRenderer_->GetFogResource()->GetGPUVirtualAddress());
-  // 3Dモデルが割り当てられていれば描画する
-  if (model_) {
-    model_->Draw(skinCluster_);
+uint64_t Object3d::GetMaterialKey() {
+  // マテリアルは setter でしか書き換えないので、変わったときだけハッシュを取り直す
+  if (materialKeyDirty_) {
+    materialKey_ = InstanceBatcher::HashBytes(&material_, sizeof(Model::Material));
+    materialKey_ = InstanceBatcher::HashBytes(maskTexturePath_.data(),
+                                              maskTexturePath_.size(), materialKey_);
+    // 色のアルファが 1 未満ならブレンドするので、半透明として奥から描く
+    isTransparent_ = material_.color.w < 1.0f;
+    materialKeyDirty_ = false;
   }
+  return materialKey_;
 }
 
 void Object3d::SetModel(const std::string &filePath) {
@@ -161,7 +236,8 @@ void Object3d::SetModel(const std::string &filePath) {
   model_ = ModelManager::GetInstance()->FindModel(filePath);
 
   // LoadModel と SetModel の引数不一致（スペルミス等）を即座に検知する
-  if (!model_) {
+  // 非同期読み込みに失敗したものはプレースホルダーのまま残るので、それも失敗扱い
+  if (!model_ || !model_->IsReady()) {
     Logger::Log(std::string("[Object3d] SetModel failed. Model not found: ") +
                 filePath);
     Logger::Log("[Object3d] Falling back to ERROR model (magenta cube).");
@@ -176,84 +252,41 @@ void Object3d::SetModel(const std::string &filePath) {
   }
 
   // モデルのデフォルトマテリアルをコピー
-  if (materialData && model_) {
-    *materialData = model_->GetDefaultMaterial();
+  if (model_) {
+    material_ = model_->GetDefaultMaterial();
+    materialKeyDirty_ = true;
   }
 }
 
 void Object3d::SetMaskTexturePath(const std::string& path) {
   maskTexturePath_ = path;
   TextureManager::GetInstance()->LoadTexture(maskTexturePath_);
+  materialKeyDirty_ = true;
 }
 
-void Object3d::CreateTransformationMatrixData() {
-
-  // cbvのsizeは256バイト単位で確保する
-  UINT transformationMatrixSize = (sizeof(TransformationMatrix) + 255) & ~255;
-
-  assert(transformationMatrixSize % 256 == 0);
-
-  // データを書き込む
-  transformationMatrixResource =
-      dx12Core_->CreateBufferResource(transformationMatrixSize);
-
-  // 書き込むためのアドレスを取得
-  HRESULT hr = transformationMatrixResource->Map(
-      0, nullptr, reinterpret_cast<void **>(&transformationMatrixData));
-  assert(SUCCEEDED(hr));
-  assert(transformationMatrixData);
-
-  // 単位行列を書き込んでおく
-  transformationMatrixData->World = MakeIdentity4x4();
-  transformationMatrixData->WVP = MakeIdentity4x4();
-  transformationMatrixData->WorldInverseTranspose = MakeIdentity4x4();
-}
-
-void Object3d::CreateCameraForGPUData() {
-
-  UINT cameraSize = (sizeof(CameraForGPU) + 255) & ~255;
-  cameraForGPUResource = dx12Core_->CreateBufferResource(cameraSize);
-
-  // データを書き込む
-  cameraForGPUData = nullptr;
-
-  // 書き込むためのアドレスを取得
-  HRESULT hr = cameraForGPUResource->Map(
-      0, nullptr, reinterpret_cast<void **>(&cameraForGPUData));
-  assert(SUCCEEDED(hr));
-  assert(cameraForGPUData);
-
-  cameraForGPUData->worldPosition = {0.0f, 0.0f, 0.0f};
+void Object3d::UploadFrameConstants(bool includeTransformation) {
+  LinearUploadAllocator &allocator = dx12Core_->GetFrameUploadAllocator();
+  if (includeTransformation) {
+    transformationAddress_ = allocator.Upload(transformation_).gpuAddress;
+  }
+  cameraAddress_ = allocator.Upload(cameraForGPU_).gpuAddress;
+  materialAddress_ = allocator.Upload(material_).gpuAddress;
 }
 
-void Object3d::CreateMaterialData() {
-
-  UINT materialSize = (sizeof(Model::Material) + 255) & ~255;
-  assert(materialSize % 256 == 0);
-
-  materialResource = dx12Core_->CreateBufferResource(materialSize);
-
-  // マテリアルにデータを書き込む
-  materialData = nullptr;
-
-  // 書き込むためのアドレスを取得
-  HRESULT hr = materialResource->Map(0, nullptr,
-                                     reinterpret_cast<void **>(&materialData));
-  assert(SUCCEEDED(hr));
-  assert(materialData);
+void Object3d::InitializeMaterial() {
 
   // 色の指定
-  materialData->color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+  material_.color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
   // Lightingさせるか
-  materialData->enableLighting = true;
+  material_.enableLighting = true;
   // UVTransform 単位行列を入れておく
-  materialData->uvTransform = MakeIdentity4x4();
-  materialData->shininess = 30.0f;
-  materialData->environmentCoefficient = 0.0f;
-
-  materialData->enableDissolve = 0;
-  materialData->dissolveThreshold = 0.0f;
-  materialData->dissolveEdgeRange = 0.05f;
-  materialData->maskTransform = {0.0f, 0.0f};
-  materialData->dissolveEdgeColor = Vector4(1.0f, 0.4f, 0.3f, 1.0f);
+  material_.uvTransform = MakeIdentity4x4();
+  material_.shininess = 30.0f;
+  material_.environmentCoefficient = 0.0f;
+
+  material_.enableDissolve = 0;
+  material_.dissolveThreshold = 0.0f;
+  material_.dissolveEdgeRange = 0.05f;
+  material_.maskTransform = {0.0f, 0.0f};
+  material_.dissolveEdgeColor = Vector4(1.0f, 0.4f, 0.3f, 1.0f);
 }
@@ -1,8 +1,14 @@
 #include "Render/Object3d/SkinnedObject.h"
 #include "Core/SrvManager.h"
+#include "Debug/Logger.h"
+#include "Render/Model/AnimationLibrary.h"
+#include "Render/Model/ModelBounds.h"
 #include "Render/Model/ModelManager.h"
 #include "Render/Renderer/Object3dRenderer.h"
-#include <cmath>
+#include <cstring>
+#include <string>
+
+SkinnedObject::~SkinnedObject() { ReleasePoseCacheEntry(); }
 
 void SkinnedObject::Initialize(Object3dRenderer *object3dRenderer,
                                SrvManager *srvManager,
@@ -18,16 +24,41 @@ void SkinnedObject::Initialize(Object3dRenderer *object3dRenderer,
   model_->Initialize(ModelManager::GetInstance()->GetModelRenderer(),
                      directoryPath, filename);
 
-  // アニメーションの読み込み
-  animation_ = LoadAnimationFile(directoryPath, filename);
-
   // スケルトンの作成
   skeleton_ = CreateSkeleton(model_->GetRootNode());
 
+  // ファイル内の全クリップは AnimationLibrary が一度だけ読み込み、同じファイルのインスタンスで共有する
+  // 再生には圧縮したものを使う（一定間隔・量子化済みで小さく、時刻から直接引ける）
+  animationSet_ = AnimationLibrary::GetInstance()->Load(directoryPath + "/" + filename);
+
+  // チャンネルと Joint の対応は一度だけ解決しておく（毎フレーム名前で引かない）
+  // コントローラーはクリップをポインタで持つので、ここで作ったら以降は配列を増減させない
+  const size_t clipCount = animationSet_ ? animationSet_->GetCount() : 0;
+  animationClips_.resize(clipCount);
+  compressedAnimationClips_.resize(clipCount);
+  for (size_t i = 0; i < clipCount; ++i) {
+    animationClips_[i] = MakeAnimationClip(skeleton_, *animationSet_->Get(i));
+    compressedAnimationClips_[i] = MakeAnimationClip(skeleton_, *animationSet_->GetCompressed(i));
+  }
+  animationController_.Initialize(skeleton_);
+  if (clipCount != 0) {
+    baseClipIndex_ = 0;
+    animationController_.Play(useCompressedAnimation_ ? compressedAnimationClips_[0] : animationClips_[0]);
+  } else {
+    Logger::Log("[SkinnedObject] no animation in " + filename + "\n");
+  }
+
   // スキンクラスターの作成
   skinCluster_ = CreateSkinCluster(object3dRenderer->GetDx12Core(), srvManager,
                                    skeleton_, model_.get());
 
+  // PoseCache で同じモデルのインスタンスを見分けるキー（まだ初期姿勢のうちに作る）
+  skeletonKey_ = PoseCache::MakeSkeletonKey(skeleton_, skinCluster_.inverseBindPoseMatrices.data());
+
+  // Joint ごとの境界を Skeleton の番号に解決しておく（毎フレームの境界は名前を引かずに作る）
+  boundJointIndices_ = ModelBounds::ResolveJoints(model_->GetJointBounds(), skeleton_);
+  localBounds_ = model_->GetLocalAABB();
+
   // 描画用Object3dの作成と割り当て
   object3d_ = std::make_unique<Object3d>();
   object3d_->Initialize(object3dRenderer);
@@ -36,18 +67,24 @@ void SkinnedObject::Initialize(Object3dRenderer *object3dRenderer,
 }
 
 void SkinnedObject::Update(float deltaTime) {
-  // アニメーション時間の更新
-  animationTime_ += deltaTime;
-  animationTime_ = std::fmod(animationTime_, animation_.duration);
+  // アニメーションの時間を進めて、レイヤーを重ねた姿勢を各関節に書く
+  animationController_.Update(deltaTime);
 
-  // アニメーションの適用（各関節のローカル行列更新）
-  ApplyAnimation(skeleton_, animation_, animationTime_);
+  // 1つのクリップだけを再生しているなら、同じ時刻のインスタンスと評価済みのパレットを共有する
+  if (!UpdatePaletteFromPoseCache()) {
+    ReleasePoseCacheEntry();
+    animationController_.Evaluate(skeleton_);
 
-  // スケルトンの更新（親から子への行列伝播）
-  ::Update(skeleton_);
+    // スケルトンの更新（親から子への行列伝播）
+    ::Update(skeleton_);
 
-  // スキンクラスターの更新（パレットの更新）
-  ::Update(skinCluster_, skeleton_);
+    // スキンクラスターの更新（パレットの更新）
+    ::Update(skinCluster_, skeleton_);
+
+    // 今の姿勢の境界（Joint ごとの箱を動かして合わせる。頂点は見ない）
+    localBounds_ = ModelBounds::ComputeSkinnedAABB(model_->GetJointBounds(), boundJointIndices_,
+                                                   skeleton_.skeletonSpaceMatrices.data());
+  }
 
   // ComputeShaderを実行してスキニング計算
   if (object3dRenderer_ && srvManager_ && model_) {
@@ -99,10 +136,96 @@ void SkinnedObject::Update(float deltaTime) {
     commandList->ResourceBarrier(1, &barrierVBV);
   }
 
-  // 3Dオブジェクトの全体更新（WVP行列などの計算）
+  // 3Dオブジェクトの全体更新（WVP行列などの計算）。姿勢の境界があればそれでカリングする
+  if (!boundJointIndices_.empty()) {
+    object3d_->SetAnimatedBounds(localBounds_);
+  }
   object3d_->Update();
 }
 
+void SkinnedObject::PlayAnimation(const AnimationClip &clip, float fadeSeconds,
+                                  uint32_t layer, bool loop) {
+  animationController_.Play(clip, fadeSeconds, layer, loop);
+}
+
+const AnimationClip *SkinnedObject::FindClip(const std::string &clipName) const {
+  int32_t index = animationSet_ ? animationSet_->FindIndex(clipName) : -1;
+  if (index < 0) {
+    return nullptr;
+  }
+  return useCompressedAnimation_ ? &compressedAnimationClips_[index] : &animationClips_[index];
+}
+
+bool SkinnedObject::PlayAnimation(const std::string &clipName, float fadeSeconds,
+                                  uint32_t layer, bool loop) {
+  const AnimationClip *clip = FindClip(clipName);
+  if (!clip) {
+    Logger::Log("[SkinnedObject] animation not found: " + clipName + "\n");
+    return false;
+  }
+  if (layer == 0) {
+    baseClipIndex_ = static_cast<size_t>(animationSet_->FindIndex(clipName));
+  }
+  animationController_.Play(*clip, fadeSeconds, layer, loop);
+  return true;
+}
+
+void SkinnedObject::SetUseCompressedAnimation(bool enabled) {
+  if (useCompressedAnimation_ == enabled) {
+    return;
+  }
+  useCompressedAnimation_ = enabled;
+  if (baseClipIndex_ < animationClips_.size()) {
+    animationController_.Play(enabled ? compressedAnimationClips_[baseClipIndex_]
+                                      : animationClips_[baseClipIndex_]);
+  }
+}
+
+void SkinnedObject::SetPoseCache(PoseCache *poseCache) {
+  if (poseCache_ == poseCache) {
+    return;
+  }
+  ReleasePoseCacheEntry();
+  poseCache_ = poseCache;
+}
+
+void SkinnedObject::ReleasePoseCacheEntry() {
+  if (poseCacheEntry_) {
+    poseCache_->Release(poseCacheEntry_);
+    poseCacheEntry_ = nullptr;
+  }
+}
+
+bool SkinnedObject::UpdatePaletteFromPoseCache() {
+  if (!poseCache_ || !animationController_.IsSingleClip()) {
+    return false;
+  }
+  const PoseCache::Key key = poseCache_->MakeKey(skeletonKey_, *animationController_.GetLayerClip(0),
+                                                 animationController_.GetLayerTime(0));
+  if (poseCacheEntry_ && poseCacheEntry_->key == key) {
+    // 丸めた時刻が変わっていなければパレットも同じ
+    return true;
+  }
+
+  // 誰も評価していなければ、丸めた時刻で評価して作る（そのときだけ skeleton_ も更新される）
+  const size_t jointCount = skeleton_.joints.size();
+  PoseCache::Entry *entry = poseCache_->Acquire(key, jointCount, [&](float time, PoseCache::Entry &evaluated) {
+    animationController_.EvaluateBaseAt(time, skeleton_);
+    ::Update(skeleton_);
+    Skinning::BuildPalette(skinCluster_.inverseBindPoseMatrices.data(), skeleton_.skeletonSpaceMatrices.data(),
+                           jointCount, evaluated.palette.data());
+    evaluated.bounds = ModelBounds::ComputeSkinnedAABB(model_->GetJointBounds(), boundJointIndices_,
+                                                       skeleton_.skeletonSpaceMatrices.data());
+  });
+  ReleasePoseCacheEntry();
+  poseCacheEntry_ = entry;
+
+  // mappedPalette は Map したままのアップロード用バッファなので、書くだけで読み戻さない
+  std::memcpy(skinCluster_.mappedPalette.data(), entry->palette.data(), sizeof(WellForGPU) * jointCount);
+  localBounds_ = entry->bounds;
+  return true;
+}
+
 void SkinnedObject::Draw() {
   if (object3d_) {
     object3d_->Draw();
@@ -0,0 +1,61 @@
+#include "Renderer/D3D12CommandRecorder.h"
+#include <cassert>
+
+void D3D12CommandRecorder::SetRootSignature(RootSignatureHandle rootSignature) {
+  assert(commandList_);
+  commandList_->SetGraphicsRootSignature(
+      static_cast<ID3D12RootSignature *>(const_cast<void *>(rootSignature)));
+}
+
+void D3D12CommandRecorder::SetPipelineState(PipelineHandle pipelineState) {
+  assert(commandList_);
+  commandList_->SetPipelineState(
+      static_cast<ID3D12PipelineState *>(const_cast<void *>(pipelineState)));
+}
+
+void D3D12CommandRecorder::SetPrimitiveTopology(PrimitiveTopology topology) {
+  assert(commandList_);
+  commandList_->IASetPrimitiveTopology(topology == PrimitiveTopology::LineList
+                                           ? D3D_PRIMITIVE_TOPOLOGY_LINELIST
+                                           : D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void D3D12CommandRecorder::SetRootConstantBufferView(uint32_t rootIndex, GpuAddress address) {
+  assert(commandList_);
+  commandList_->SetGraphicsRootConstantBufferView(rootIndex, address);
+}
+
+void D3D12CommandRecorder::SetRootShaderResourceView(uint32_t rootIndex, GpuAddress address) {
+  assert(commandList_);
+  commandList_->SetGraphicsRootShaderResourceView(rootIndex, address);
+}
+
+void D3D12CommandRecorder::SetRootDescriptorTable(uint32_t rootIndex, DescriptorHandle handle) {
+  assert(commandList_);
+  commandList_->SetGraphicsRootDescriptorTable(rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE{handle});
+}
+
+void D3D12CommandRecorder::SetVertexBuffer(uint32_t slot, const VertexBufferView &view) {
+  assert(commandList_);
+  D3D12_VERTEX_BUFFER_VIEW vbv{view.location, view.sizeInBytes, view.strideInBytes};
+  commandList_->IASetVertexBuffers(slot, 1, &vbv);
+}
+
+void D3D12CommandRecorder::SetIndexBuffer(const IndexBufferView &view) {
+  assert(commandList_);
+  D3D12_INDEX_BUFFER_VIEW ibv{view.location, view.sizeInBytes,
+                              view.format == IndexFormat::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT};
+  commandList_->IASetIndexBuffer(&ibv);
+}
+
+void D3D12CommandRecorder::DrawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+                                         uint32_t startInstance) {
+  assert(commandList_);
+  commandList_->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+}
+
+void D3D12CommandRecorder::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex,
+                                                int32_t baseVertex, uint32_t startInstance) {
+  assert(commandList_);
+  commandList_->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+}
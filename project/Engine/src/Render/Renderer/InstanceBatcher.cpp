@@ -0,0 +1,59 @@
+#include "Renderer/InstanceBatcher.h"
+#include <functional>
+
+void InstanceBatcher::Clear() {
+  groupIndices_.clear();
+  pending_.clear();
+  instances_.clear();
+  groups_.clear();
+}
+
+void InstanceBatcher::Add(const Key &key, const InstanceData &instance, uint32_t userData) {
+  auto [it, inserted] = groupIndices_.try_emplace(key, uint32_t(groups_.size()));
+  if (inserted) {
+    Group group;
+    group.key = key;
+    group.representative = userData;
+    groups_.push_back(group);
+  }
+  ++groups_[it->second].instanceCount;
+  pending_.push_back({instance, it->second});
+}
+
+void InstanceBatcher::Build() {
+  // グループの先頭を決めてから、登録順のままグループごとに詰める（数え上げソート）
+  uint32_t offset = 0;
+  for (Group &group : groups_) {
+    group.firstInstance = offset;
+    offset += group.instanceCount;
+  }
+
+  instances_.resize(pending_.size());
+  cursors_.resize(groups_.size());
+  for (size_t i = 0; i < groups_.size(); ++i) {
+    cursors_[i] = groups_[i].firstInstance;
+  }
+  for (const Pending &pending : pending_) {
+    instances_[cursors_[pending.group]++] = pending.instance;
+  }
+}
+
+uint64_t InstanceBatcher::HashBytes(const void *data, size_t size, uint64_t seed) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  uint64_t hash = seed;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+size_t InstanceBatcher::KeyHash::operator()(const Key &key) const {
+  size_t hash = std::hash<const void *>()(key.mesh);
+  auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2); };
+  combine(std::hash<uint32_t>()(key.lodIndex));
+  combine(std::hash<const void *>()(key.pipeline));
+  combine(std::hash<uint64_t>()(key.material));
+  combine(std::hash<const void *>()(key.view));
+  return hash;
+}
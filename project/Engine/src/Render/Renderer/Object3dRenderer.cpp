@@ -1,6 +1,12 @@
 #include "Renderer/Object3dRenderer.h"
+#include "Camera/ICamera.h"
 #include "Debug/Logger.h"
+#include "Object3d/Object3d.h"
+#include "Renderer/D3D12CommandRecorder.h"
+#include "Texture/TextureManager.h"
 #include "Util/StringUtil.h"
+#include <algorithm>
+#include <cstring>
 
 void Object3dRenderer::Initialize(Dx12Core *dx12Core) {
   dx12Core_ = dx12Core;
@@ -142,26 +148,41 @@ void Object3dRenderer::CreateRootSignature() {
   descriptionRootSignature.pStaticSamplers = staticSamplers;
   descriptionRootSignature.NumStaticSamplers = _countof(staticSamplers);
 
-  // シリアライズしてバイナリにする
-  Microsoft::WRL::ComPtr<ID3DBlob> signatureBlob = nullptr;
-  Microsoft::WRL::ComPtr<ID3DBlob> errorBlob = nullptr;
-  hr = D3D12SerializeRootSignature(
-      &descriptionRootSignature, D3D_ROOT_SIGNATURE_VERSION_1,
-      signatureBlob.GetAddressOf(), errorBlob.GetAddressOf());
-
-  if (FAILED(hr)) {
-    if (errorBlob) {
-      Logger::Log(reinterpret_cast<char *>(errorBlob->GetBufferPointer()));
-    }
-    assert(false);
-  }
-
-  // バイナリを元に生成
-  rootSignature_ = nullptr;
-  hr = device->CreateRootSignature(0, signatureBlob->GetBufferPointer(),
-                                   signatureBlob->GetBufferSize(),
-                                   IID_PPV_ARGS(&rootSignature_));
-  assert(SUCCEEDED(hr));
+  auto createRootSignature =
+      [&](Microsoft::WRL::ComPtr<ID3D12RootSignature> &rootSignature) {
+        // シリアライズしてバイナリにする
+        Microsoft::WRL::ComPtr<ID3DBlob> signatureBlob = nullptr;
+        Microsoft::WRL::ComPtr<ID3DBlob> errorBlob = nullptr;
+        hr = D3D12SerializeRootSignature(
+            &descriptionRootSignature, D3D_ROOT_SIGNATURE_VERSION_1,
+            signatureBlob.GetAddressOf(), errorBlob.GetAddressOf());
+
+        if (FAILED(hr)) {
+          if (errorBlob) {
+            Logger::Log(
+                reinterpret_cast<char *>(errorBlob->GetBufferPointer()));
+          }
+          assert(false);
+        }
+
+        // バイナリを元に生成
+        rootSignature = nullptr;
+        hr = device->CreateRootSignature(0, signatureBlob->GetBufferPointer(),
+                                         signatureBlob->GetBufferSize(),
+                                         IID_PPV_ARGS(&rootSignature));
+        assert(SUCCEEDED(hr));
+      };
+
+  createRootSignature(rootSignature_);
+
+  // インスタンス描画用。rootParameter[1] だけを行列の StructuredBuffer (t0, space1) のルート SRV に替える
+  // ほかの番号は同じなので、Object3d のルートパラメータの設定をそのまま使える
+  rootParameterObject3d[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+  rootParameterObject3d[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+  rootParameterObject3d[1].Descriptor.ShaderRegister = 0;
+  rootParameterObject3d[1].Descriptor.RegisterSpace = 1;
+
+  createRootSignature(instancedRootSignature_);
 }
 
 void Object3dRenderer::CreatePSO() {
@@ -297,9 +318,45 @@ void Object3dRenderer::CreatePSO() {
   hr = device->CreateGraphicsPipelineState(
       &graphicsPipeLineStateDesc, IID_PPV_ARGS(&graphicsPipeLineStateDepthDisabled_));
   assert(SUCCEEDED(hr));
+
+  // インスタンス描画用のPSO（VSとルートシグネチャだけが違う）
+  IDxcBlob *instancedVertexShaderBlob = dx12Core_->CompileShader(
+      L"resources/shaders/Object3dInstanced.VS.hlsl", L"vs_6_0");
+  assert(instancedVertexShaderBlob != nullptr);
+
+  graphicsPipeLineStateDesc.pRootSignature = instancedRootSignature_.Get();
+  graphicsPipeLineStateDesc.VS = {
+      instancedVertexShaderBlob->GetBufferPointer(),
+      instancedVertexShaderBlob->GetBufferSize()};
+
+  instancedPipelineStateDepthDisabled_ = nullptr;
+  hr = device->CreateGraphicsPipelineState(
+      &graphicsPipeLineStateDesc,
+      IID_PPV_ARGS(&instancedPipelineStateDepthDisabled_));
+  assert(SUCCEEDED(hr));
+
+  depthStencilDesc.DepthEnable = true;
+  graphicsPipeLineStateDesc.DepthStencilState = depthStencilDesc;
+
+  instancedPipelineState_ = nullptr;
+  hr = device->CreateGraphicsPipelineState(
+      &graphicsPipeLineStateDesc, IID_PPV_ARGS(&instancedPipelineState_));
+  assert(SUCCEEDED(hr));
+}
+
+void Object3dRenderer::BeginFrame() {
+  culler_.BeginFrame();
+
+  // 前フレームのコマンドは実行済みなので、インスタンスバッファは先頭から使い直す
+  instanceCursor_ = 0;
+  retiredInstanceResources_.clear();
+  renderStats_ = {};
 }
 
 void Object3dRenderer::Begin() {
+  // 登録済みの描画を先に済ませておく（ほかのレンダラーの状態に変わる前に）
+  Flush();
+
   Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList =
       dx12Core_->GetCommandList();
 
@@ -308,9 +365,15 @@ void Object3dRenderer::Begin() {
 
   // PSOをセット
   commandList->SetPipelineState(graphicsPipeLineState_.Get());
+  isDepthEnabled_ = true;
 
   // プリミティブトポロジー(形状）をセット
   commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+  // Updateで登録された境界球をまとめて判定しておく
+  if (defaultCamera) {
+    culler_.Cull(defaultCamera->GetViewProjectionMatrix());
+  }
 }
 
 
@@ -324,6 +387,181 @@ void Object3dRenderer::SetDepthEnable(bool enable) {
   } else {
       commandList->SetPipelineState(graphicsPipeLineStateDepthDisabled_.Get());
   }
+  isDepthEnabled_ = enable;
+}
+
+void Object3dRenderer::SubmitObject(const Object3d *object,
+                                    uint64_t materialKey) {
+  assert(object && "Object3dRenderer::SubmitObject: object is null");
+  ICommandRecorder::PipelineHandle pipeline =
+      isDepthEnabled_ ? graphicsPipeLineState_.Get()
+                      : graphicsPipeLineStateDepthDisabled_.Get();
+  queue_.Submit(MakeSortKey(object, pipeline, materialKey),
+                uint32_t(queuedObjects_.size()));
+  queuedObjects_.push_back({object, pipeline});
+}
+
+void Object3dRenderer::SubmitInstance(const Object3d *object,
+                                      const InstanceBatcher::Key &key,
+                                      const InstanceBatcher::InstanceData &instance) {
+  assert(object && "Object3dRenderer::SubmitInstance: object is null");
+  batcher_.Add(key, instance, uint32_t(instancedObjects_.size()));
+  instancedObjects_.push_back(object);
+}
+
+uint64_t Object3dRenderer::MakeSortKey(const Object3d *object,
+                                       ICommandRecorder::PipelineHandle pipeline,
+                                       uint64_t materialKey) {
+  const bool isDepthDisabled =
+      pipeline == graphicsPipeLineStateDepthDisabled_.Get() ||
+      pipeline == instancedPipelineStateDepthDisabled_.Get();
+  const uint32_t layer =
+      isDepthDisabled ? RenderQueue::kOverlayLayer : object->GetRenderLayer();
+  const uint32_t pipelineId = queue_.GetPipelineId(pipeline);
+  return object->IsTransparent()
+             ? RenderQueue::MakeTransparentKey(layer, pipelineId, materialKey,
+                                               object->GetSortDepth())
+             : RenderQueue::MakeOpaqueKey(layer, pipelineId, materialKey,
+                                          object->GetSortDepth());
+}
+
+void Object3dRenderer::Flush() {
+  if (queue_.GetItemCount() == 0 && batcher_.GetSubmittedCount() == 0) {
+    return;
+  }
+
+  // インスタンス描画のグループもキューに入れる（キーは代表のオブジェクトで作る）
+  ICommandRecorder::GpuAddress instanceBuffer = 0;
+  if (batcher_.GetSubmittedCount() > 0) {
+    batcher_.Build();
+    const std::vector<InstanceBatcher::InstanceData> &instances =
+        batcher_.GetInstances();
+    const uint32_t instanceCount = uint32_t(instances.size());
+
+    // 今フレームのインスタンスバッファに書き足す
+    ReserveInstances(instanceCount);
+    std::memcpy(instanceData_ + instanceCursor_, instances.data(),
+                sizeof(InstanceBatcher::InstanceData) * instanceCount);
+    instanceBuffer =
+        instanceResource_->GetGPUVirtualAddress() +
+        uint64_t(instanceCursor_) * sizeof(InstanceBatcher::InstanceData);
+    instanceCursor_ += instanceCount;
+
+    const std::vector<InstanceBatcher::Group> &groups = batcher_.GetGroups();
+    for (uint32_t i = 0; i < groups.size(); ++i) {
+      const InstanceBatcher::Group &group = groups[i];
+      queue_.Submit(MakeSortKey(instancedObjects_[group.representative],
+                                group.key.pipeline, group.key.material),
+                    kGroupPayloadBit | i);
+    }
+    renderStats_.instances += instanceCount;
+    renderStats_.groups += uint32_t(groups.size());
+  }
+
+  queue_.Sort();
+
+  D3D12CommandRecorder recorder(dx12Core_->GetCommandList());
+  recorder.SetPrimitiveTopology(ICommandRecorder::PrimitiveTopology::TriangleList);
+
+  // 切り替わるときだけ積む
+  ID3D12RootSignature *currentRootSignature = nullptr;
+  ICommandRecorder::PipelineHandle currentPipeline = nullptr;
+  auto bindRootSignature = [&](ID3D12RootSignature *rootSignature) {
+    if (rootSignature == currentRootSignature) {
+      return;
+    }
+    recorder.SetRootSignature(rootSignature);
+    // ルートシグネチャを替えるとルート引数は消えるので積み直す
+    RecordSharedParameters(recorder);
+    currentRootSignature = rootSignature;
+    ++renderStats_.rootSignatureChanges;
+  };
+  auto bindPipeline = [&](ICommandRecorder::PipelineHandle pipeline) {
+    if (pipeline == currentPipeline) {
+      return;
+    }
+    recorder.SetPipelineState(pipeline);
+    currentPipeline = pipeline;
+    ++renderStats_.pipelineChanges;
+  };
+
+  for (const RenderQueue::Item &item : queue_.GetItems()) {
+    if (item.payload & kGroupPayloadBit) {
+      // マテリアル・カメラ・マスクはグループのキーが同じなので代表のものを使う
+      const InstanceBatcher::Group &group =
+          batcher_.GetGroups()[item.payload & ~kGroupPayloadBit];
+      const Object3d *object = instancedObjects_[group.representative];
+      bindRootSignature(instancedRootSignature_.Get());
+      bindPipeline(group.key.pipeline);
+      recorder.SetRootShaderResourceView(
+          1, InstanceBatcher::GetInstanceAddress(instanceBuffer, group));
+      object->RecordObjectParameters(recorder);
+      object->GetModel()->Record(recorder, nullptr, group.key.lodIndex,
+                                 group.instanceCount);
+    } else {
+      const QueuedObject &queued = queuedObjects_[item.payload];
+      bindRootSignature(rootSignature_.Get());
+      bindPipeline(queued.pipeline);
+      queued.object->RecordDraw(recorder);
+    }
+  }
+
+  renderStats_.items += uint32_t(queue_.GetItemCount());
+  renderStats_.materialChanges += queue_.GetStats().materialChanges;
+
+  queue_.Clear();
+  queuedObjects_.clear();
+  batcher_.Clear();
+  instancedObjects_.clear();
+
+  // 通常の描画に戻す
+  recorder.SetRootSignature(rootSignature_.Get());
+  recorder.SetPipelineState(isDepthEnabled_
+                                ? graphicsPipeLineState_.Get()
+                                : graphicsPipeLineStateDepthDisabled_.Get());
+}
+
+void Object3dRenderer::RecordSharedParameters(ICommandRecorder &recorder) const {
+  // Lighting
+  recorder.SetRootConstantBufferView(
+      3, directionalLightResource_->GetGPUVirtualAddress());
+
+  // PointLight
+  recorder.SetRootConstantBufferView(
+      5, pointLightResource_->GetGPUVirtualAddress());
+
+  // SpotLight
+  recorder.SetRootConstantBufferView(
+      6, spotLightResource_->GetGPUVirtualAddress());
+
+  // Environment Map (Skybox)
+  recorder.SetRootDescriptorTable(
+      7, TextureManager::GetInstance()
+             ->GetSrvHandleGPU("resources/Skybox/Skybox.dds")
+             .ptr);
+
+  // Fog
+  recorder.SetRootConstantBufferView(9, fogResource_->GetGPUVirtualAddress());
+}
+
+void Object3dRenderer::ReserveInstances(uint32_t count) {
+  if (instanceCursor_ + count <= instanceCapacity_) {
+    return;
+  }
+
+  // 足りなければ作り直す。古いバッファは今フレームのコマンドが参照しているので、次のフレームまで残す
+  if (instanceResource_) {
+    retiredInstanceResources_.push_back(instanceResource_);
+  }
+  instanceCapacity_ =
+      (std::max)({kMinInstanceCapacity, count, instanceCapacity_ * 2});
+  instanceResource_ = dx12Core_->CreateBufferResource(
+      sizeof(InstanceBatcher::InstanceData) * instanceCapacity_);
+  instanceData_ = nullptr;
+  HRESULT hr = instanceResource_->Map(
+      0, nullptr, reinterpret_cast<void **>(&instanceData_));
+  assert(SUCCEEDED(hr));
+  instanceCursor_ = 0;
 }
 
 void Object3dRenderer::CreateDirectionalLightData() {
@@ -0,0 +1,74 @@
+#include "Renderer/RecordingCommandRecorder.h"
+#include <cstdint>
+
+void RecordingCommandRecorder::SetRootSignature(RootSignatureHandle rootSignature) {
+  Push({Type::SetRootSignature, 0, uint64_t(reinterpret_cast<uintptr_t>(rootSignature))});
+}
+
+void RecordingCommandRecorder::SetPipelineState(PipelineHandle pipelineState) {
+  Push({Type::SetPipelineState, 0, uint64_t(reinterpret_cast<uintptr_t>(pipelineState))});
+}
+
+void RecordingCommandRecorder::SetPrimitiveTopology(PrimitiveTopology topology) {
+  Push({Type::SetPrimitiveTopology, 0, uint64_t(topology)});
+}
+
+void RecordingCommandRecorder::SetRootConstantBufferView(uint32_t rootIndex, GpuAddress address) {
+  Push({Type::SetRootConstantBufferView, rootIndex, address});
+}
+
+void RecordingCommandRecorder::SetRootShaderResourceView(uint32_t rootIndex, GpuAddress address) {
+  Push({Type::SetRootShaderResourceView, rootIndex, address});
+}
+
+void RecordingCommandRecorder::SetRootDescriptorTable(uint32_t rootIndex, DescriptorHandle handle) {
+  Push({Type::SetRootDescriptorTable, rootIndex, handle});
+}
+
+void RecordingCommandRecorder::SetVertexBuffer(uint32_t slot, const VertexBufferView &view) {
+  Command command{Type::SetVertexBuffer, slot, view.location};
+  command.count = view.sizeInBytes;
+  command.start = view.strideInBytes;
+  Push(command);
+}
+
+void RecordingCommandRecorder::SetIndexBuffer(const IndexBufferView &view) {
+  Command command{Type::SetIndexBuffer, 0, view.location};
+  command.count = view.sizeInBytes;
+  command.start = uint32_t(view.format);
+  Push(command);
+}
+
+void RecordingCommandRecorder::DrawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+                                             uint32_t startInstance) {
+  Command command{Type::DrawInstanced};
+  command.count = vertexCount;
+  command.instanceCount = instanceCount;
+  command.start = startVertex;
+  command.startInstance = startInstance;
+  Push(command);
+}
+
+void RecordingCommandRecorder::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                                                    uint32_t startIndex, int32_t baseVertex,
+                                                    uint32_t startInstance) {
+  Command command{Type::DrawIndexedInstanced};
+  command.count = indexCount;
+  command.instanceCount = instanceCount;
+  command.start = startIndex;
+  command.baseVertex = baseVertex;
+  command.startInstance = startInstance;
+  Push(command);
+}
+
+void RecordingCommandRecorder::Clear() {
+  commands_.clear();
+  counts_.fill(0);
+  instanceCount_ = 0;
+}
+
+void RecordingCommandRecorder::Push(const Command &command) {
+  commands_.push_back(command);
+  ++counts_[size_t(command.type)];
+  instanceCount_ += command.instanceCount;
+}
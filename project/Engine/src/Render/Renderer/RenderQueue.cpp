@@ -0,0 +1,128 @@
+#include "Renderer/RenderQueue.h"
+#include "Debug/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t kPipelineMask = (1ull << RenderQueue::kPipelineBits) - 1;
+constexpr uint64_t kMaterialMask = (1ull << RenderQueue::kMaterialBits) - 1;
+constexpr uint64_t kDepthMask = (1ull << RenderQueue::kDepthBits) - 1;
+
+uint64_t MakeHeader(uint32_t layer, bool transparent) {
+  return (uint64_t(std::min(layer, RenderQueue::kMaxLayer)) << 60) | (uint64_t(transparent ? 1 : 0) << 59);
+}
+
+// ハッシュの上位ビットを使う（下位ビットより偏りが少ない）
+uint64_t MaterialBits(uint64_t material) { return material >> (64 - RenderQueue::kMaterialBits); }
+
+} // namespace
+
+uint64_t RenderQueue::MakeOpaqueKey(uint32_t layer, uint32_t pipeline, uint64_t material, float depth) {
+  return MakeHeader(layer, false) | ((uint64_t(pipeline) & kPipelineMask) << 48) | (MaterialBits(material) << 24) |
+         QuantizeDepth(depth);
+}
+
+uint64_t RenderQueue::MakeTransparentKey(uint32_t layer, uint32_t pipeline, uint64_t material, float depth) {
+  // 奥ほど小さくする
+  uint64_t backToFront = kDepthMask - QuantizeDepth(depth);
+  return MakeHeader(layer, true) | (backToFront << 35) | ((uint64_t(pipeline) & kPipelineMask) << 24) |
+         MaterialBits(material);
+}
+
+uint32_t RenderQueue::QuantizeDepth(float depth) {
+  if (!(depth > 0.0f)) {
+    return 0;
+  }
+  uint32_t bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  // 符号ビットは 0 なので残り 31bit の上位 24bit
+  return bits >> (31 - kDepthBits);
+}
+
+uint32_t RenderQueue::GetPipeline(uint64_t key) {
+  return uint32_t((IsTransparent(key) ? key >> 24 : key >> 48) & kPipelineMask);
+}
+
+uint32_t RenderQueue::GetMaterial(uint64_t key) {
+  return uint32_t((IsTransparent(key) ? key : key >> 24) & kMaterialMask);
+}
+
+uint32_t RenderQueue::GetPipelineId(ICommandRecorder::PipelineHandle pipeline) {
+  // PSO は数えるほどしかないので線形に探す
+  for (size_t i = 0; i < pipelines_.size(); ++i) {
+    if (pipelines_[i] == pipeline) {
+      return uint32_t(i);
+    }
+  }
+  if (pipelines_.size() > kPipelineMask) {
+    Logger::Log("[RenderQueue] too many pipelines. Sort keys will share pipeline ids.\n");
+  }
+  pipelines_.push_back(pipeline);
+  return uint32_t((pipelines_.size() - 1) & kPipelineMask);
+}
+
+void RenderQueue::Sort() {
+  const size_t count = items_.size();
+  if (count > 1) {
+    // 8桁分の度数を1回の走査でまとめて数える
+    for (auto &histogram : histograms_) {
+      histogram.fill(0);
+    }
+    for (const Item &item : items_) {
+      for (uint32_t digit = 0; digit < 8; ++digit) {
+        ++histograms_[digit][(item.key >> (digit * 8)) & 0xFF];
+      }
+    }
+
+    scratch_.resize(count);
+    Item *source = items_.data();
+    Item *destination = scratch_.data();
+    for (uint32_t digit = 0; digit < 8; ++digit) {
+      std::array<uint32_t, 256> &histogram = histograms_[digit];
+      // 全要素が同じ値の桁は並びが変わらないので飛ばす（レイヤーや PSO の桁はたいていこれ）
+      const uint32_t shift = digit * 8;
+      if (histogram[(source[0].key >> shift) & 0xFF] == count) {
+        continue;
+      }
+      uint32_t offset = 0;
+      for (uint32_t &bucket : histogram) {
+        uint32_t bucketCount = bucket;
+        bucket = offset;
+        offset += bucketCount;
+      }
+      for (size_t i = 0; i < count; ++i) {
+        destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+      }
+      std::swap(source, destination);
+    }
+    if (source != items_.data()) {
+      std::memcpy(items_.data(), source, sizeof(Item) * count);
+    }
+  }
+  stats_ = CountStateChanges(items_.data(), count);
+}
+
+RenderQueue::Stats RenderQueue::CountStateChanges(const Item *items, size_t count) {
+  Stats stats;
+  stats.items = uint32_t(count);
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t key = items[i].key;
+    if (i == 0) {
+      // 最初の1回も切り替えとして数える
+      stats.layerChanges = stats.pipelineChanges = stats.materialChanges = 1;
+      continue;
+    }
+    const uint64_t previous = items[i - 1].key;
+    if (GetLayer(key) != GetLayer(previous)) {
+      ++stats.layerChanges;
+    }
+    if (GetPipeline(key) != GetPipeline(previous)) {
+      ++stats.pipelineChanges;
+    }
+    if (GetPipeline(key) != GetPipeline(previous) || GetMaterial(key) != GetMaterial(previous)) {
+      ++stats.materialChanges;
+    }
+  }
+  return stats;
+}
@@ -0,0 +1,38 @@
+#include "Renderer/SpriteBatch.h"
+
+void SpriteBatch::Clear() {
+  vertices_.clear();
+  batches_.clear();
+}
+
+void SpriteBatch::Add(const State &state, const Vertex (&quad)[kVerticesPerQuad]) {
+  Add(state, quad, 1);
+}
+
+void SpriteBatch::Add(const State &state, const Vertex *vertices, uint32_t quadCount) {
+  if (quadCount == 0) {
+    return;
+  }
+  // 直前のバッチと同じ状態なら伸ばすだけ（間に別の状態が挟まったら新しいバッチにする）
+  if (batches_.empty() || batches_.back().state != state) {
+    Batch batch;
+    batch.state = state;
+    batch.firstQuad = GetQuadCount();
+    batches_.push_back(batch);
+  }
+  batches_.back().quadCount += quadCount;
+  vertices_.insert(vertices_.end(), vertices, vertices + size_t(quadCount) * kVerticesPerQuad);
+}
+
+void SpriteBatch::WriteIndices(uint16_t *indices, uint32_t quadCount) {
+  for (uint32_t i = 0; i < quadCount; ++i) {
+    const uint16_t base = uint16_t(i * kVerticesPerQuad);
+    uint16_t *quad = indices + i * kIndicesPerQuad;
+    quad[0] = base + 0; // 左下
+    quad[1] = base + 1; // 左上
+    quad[2] = base + 2; // 右下
+    quad[3] = base + 1;
+    quad[4] = base + 3; // 右上
+    quad[5] = base + 2;
+  }
+}
@@ -1,5 +1,7 @@
 #include "Renderer/SpriteRenderer.h"
 #include "Debug/Logger.h"
+#include "Renderer/D3D12CommandRecorder.h"
+#include <cstring>
 
 void SpriteRenderer::Initialize(Dx12Core *dx12Core) {
 
@@ -9,10 +11,12 @@ void SpriteRenderer::Initialize(Dx12Core *dx12Core) {
 
   commandList_ = dx12Core_->GetCommandList();
 
-  CreateSpritePSO();
+  CreateBatchPSO();
+
+  CreateBatchIndexBuffer();
 }
 
-void SpriteRenderer::CreateSpriteRootSignature() {
+void SpriteRenderer::CreateBatchRootSignature() {
 
   HRESULT hr;
 
@@ -21,53 +25,32 @@ void SpriteRenderer::CreateSpriteRootSignature() {
   descriptionRootSignature.Flags =
       D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
-  // Object3d用のRootParameterを作成
-  D3D12_ROOT_PARAMETER rootParameter[4] = {};
-  
-  // Material (b0)
-  rootParameter[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-  rootParameter[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-  rootParameter[0].Descriptor.ShaderRegister = 0;
-
-  // Transform (b0 in VS)
-  rootParameter[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-  rootParameter[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
-  rootParameter[1].Descriptor.ShaderRegister = 0;
-
   D3D12_DESCRIPTOR_RANGE descriptorRange[1] = {};
   descriptorRange[0].BaseShaderRegister = 0;
   descriptorRange[0].NumDescriptors = 1;
   descriptorRange[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
   descriptorRange[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
-  // Texture (t0)
-  rootParameter[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-  rootParameter[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-  rootParameter[2].DescriptorTable.pDescriptorRanges = descriptorRange;
-  rootParameter[2].DescriptorTable.NumDescriptorRanges = _countof(descriptorRange);
-
-  // UIEffectParams (b1)
-  rootParameter[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-  rootParameter[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-  rootParameter[3].Descriptor.ShaderRegister = 1;
+  // 色・座標変換・UIEffect は頂点に入っているので、テクスチャ (t0) だけ
+  D3D12_ROOT_PARAMETER rootParameter[1] = {};
+  rootParameter[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+  rootParameter[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+  rootParameter[0].DescriptorTable.pDescriptorRanges = descriptorRange;
+  rootParameter[0].DescriptorTable.NumDescriptorRanges = _countof(descriptorRange);
 
+  // バイリニアフィルタ、0~1の範囲外をリピート
   D3D12_STATIC_SAMPLER_DESC staticSamplers[1] = {};
-  staticSamplers[0].Filter =
-      D3D12_FILTER_MIN_MAG_MIP_LINEAR; // バイリニアフィルタ
-  staticSamplers[0].AddressU =
-      D3D12_TEXTURE_ADDRESS_MODE_WRAP; // 0~1の範囲外をリピート
+  staticSamplers[0].Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+  staticSamplers[0].AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
   staticSamplers[0].AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
   staticSamplers[0].AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
-  staticSamplers[0].ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER; // 比較しない
+  staticSamplers[0].ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
   staticSamplers[0].MaxLOD = D3D12_FLOAT32_MAX;
-  staticSamplers[0].ShaderRegister = 0; // レジスタ番号0
-  staticSamplers[0].ShaderVisibility =
-      D3D12_SHADER_VISIBILITY_PIXEL; // pixelShaderを使う
-
-  descriptionRootSignature.pParameters =
-      rootParameter; // ルートパラメータ配列へのポインタ
-  descriptionRootSignature.NumParameters =
-      _countof(rootParameter); // 配列の長さ
+  staticSamplers[0].ShaderRegister = 0;
+  staticSamplers[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+  descriptionRootSignature.pParameters = rootParameter;
+  descriptionRootSignature.NumParameters = _countof(rootParameter);
   descriptionRootSignature.pStaticSamplers = staticSamplers;
   descriptionRootSignature.NumStaticSamplers = _countof(staticSamplers);
 
@@ -86,21 +69,21 @@ void SpriteRenderer::CreateSpriteRootSignature() {
   }
 
   // バイナリを元に生成
-  rootSignature_ = nullptr;
+  batchRootSignature_ = nullptr;
   hr = device_->CreateRootSignature(0, signatureBlob->GetBufferPointer(),
                                     signatureBlob->GetBufferSize(),
-                                    IID_PPV_ARGS(&rootSignature_));
+                                    IID_PPV_ARGS(&batchRootSignature_));
   assert(SUCCEEDED(hr));
 }
 
-void SpriteRenderer::CreateSpritePSO() {
+void SpriteRenderer::CreateBatchPSO() {
 
   HRESULT hr;
 
-  CreateSpriteRootSignature();
+  CreateBatchRootSignature();
 
-  // inputLayout
-  D3D12_INPUT_ELEMENT_DESC inputElementDescs[2] = {};
+  // inputLayout（SpriteBatch::Vertex と同じ並び）
+  D3D12_INPUT_ELEMENT_DESC inputElementDescs[5] = {};
   inputElementDescs[0].SemanticName = "POSITION";
   inputElementDescs[0].SemanticIndex = 0;
   inputElementDescs[0].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
@@ -111,123 +94,155 @@ void SpriteRenderer::CreateSpritePSO() {
   inputElementDescs[1].Format = DXGI_FORMAT_R32G32_FLOAT;
   inputElementDescs[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 
-  D3D12_INPUT_LAYOUT_DESC inputLayoutDesc{};
-  inputLayoutDesc.pInputElementDescs = inputElementDescs;
-  inputLayoutDesc.NumElements = _countof(inputElementDescs);
-
-  // BlendStateの設定
-  D3D12_BLEND_DESC blendDesc{};
-
-  // すべての色要素を書き込む
-  blendDesc.RenderTarget[0].RenderTargetWriteMask =
-      D3D12_COLOR_WRITE_ENABLE_ALL;
-
-  blendDesc.RenderTarget[0].BlendEnable = true; // ブレンドを有効化
+  inputElementDescs[2].SemanticName = "COLOR";
+  inputElementDescs[2].SemanticIndex = 0;
+  inputElementDescs[2].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+  inputElementDescs[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 
-  blendDesc.RenderTarget[0].SrcBlend =
-      D3D12_BLEND_SRC_ALPHA; // 元画像の透明度を使う
+  inputElementDescs[3].SemanticName = "TEXCOORD";
+  inputElementDescs[3].SemanticIndex = 1;
+  inputElementDescs[3].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+  inputElementDescs[3].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 
-  blendDesc.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD; // 合成方法　(加算)
+  inputElementDescs[4].SemanticName = "TEXCOORD";
+  inputElementDescs[4].SemanticIndex = 2;
+  inputElementDescs[4].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+  inputElementDescs[4].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 
-  blendDesc.RenderTarget[0].DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
-
-  blendDesc.RenderTarget[0].SrcBlendAlpha =
-      D3D12_BLEND_ONE; // 元画像の透明度をブレンドに反映
-
-  blendDesc.RenderTarget[0].BlendOpAlpha =
-      D3D12_BLEND_OP_ADD; // 上二つを合成(加算)
-
-  blendDesc.RenderTarget[0].DestBlendAlpha =
-      D3D12_BLEND_INV_SRC_ALPHA; // 背景の透明度は無視
+  D3D12_INPUT_LAYOUT_DESC inputLayoutDesc{};
+  inputLayoutDesc.pInputElementDescs = inputElementDescs;
+  inputLayoutDesc.NumElements = _countof(inputElementDescs);
 
   // RasterizerStateの設定
   D3D12_RASTERIZER_DESC rasterizerDesc{};
-
-  // 裏面(時計回り)を表示しない
   rasterizerDesc.CullMode = D3D12_CULL_MODE_NONE;
-
-  // 三角形の中を塗りつぶす
   rasterizerDesc.FillMode = D3D12_FILL_MODE_SOLID;
 
-  // shaderをcompileする
-  IDxcBlob *vertexShaderBlob =
-      dx12Core_->CompileShader(L"resources/shaders/Sprite.VS.hlsl", L"vs_6_0");
-  assert(vertexShaderBlob != nullptr);
-
-  IDxcBlob *pixelShaderBlob =
-      dx12Core_->CompileShader(L"resources/shaders/Sprite.PS.hlsl", L"ps_6_0");
-  assert(pixelShaderBlob != nullptr);
-
-  IDxcBlob *uiEffectPixelShaderBlob =
-      dx12Core_->CompileShader(L"resources/shaders/UIEffect.PS.hlsl", L"ps_6_0");
-  assert(uiEffectPixelShaderBlob != nullptr);
-
-  // DepthStencilStateの設定
+  // DepthStencilStateの設定（2D は深度を使わない）
   D3D12_DEPTH_STENCIL_DESC depthStencilDesc{};
-
-  // Depthの機能を有効化する
   depthStencilDesc.DepthEnable = false;
+  depthStencilDesc.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+  depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
 
-  // 書き込み
-  depthStencilDesc.DepthWriteMask =
-      D3D12_DEPTH_WRITE_MASK_ZERO; // Depthの書き込みを行わない
+  // shaderをcompileする
+  IDxcBlob *vertexShaderBlob = dx12Core_->CompileShader(
+      L"resources/shaders/SpriteBatch.VS.hlsl", L"vs_6_0");
+  assert(vertexShaderBlob != nullptr);
 
-  // 比較関数はLessEqual。近ければ描画される
-  depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+  IDxcBlob *pixelShaderBlobs[size_t(SpriteBatch::Effect::kCount)] = {};
+  pixelShaderBlobs[size_t(SpriteBatch::Effect::None)] = dx12Core_->CompileShader(
+      L"resources/shaders/SpriteBatch.PS.hlsl", L"ps_6_0");
+  pixelShaderBlobs[size_t(SpriteBatch::Effect::UIEffect)] = dx12Core_->CompileShader(
+      L"resources/shaders/UIEffect.PS.hlsl", L"ps_6_0");
+  for (IDxcBlob *pixelShaderBlob : pixelShaderBlobs) {
+    assert(pixelShaderBlob != nullptr);
+    (void)pixelShaderBlob;
+  }
 
-  // PSOの生成
   D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsPipeLineStateDesc{};
-  graphicsPipeLineStateDesc.pRootSignature =
-      rootSignature_.Get();                                // RootSignature
-  graphicsPipeLineStateDesc.InputLayout = inputLayoutDesc; // InputLayout
-  graphicsPipeLineStateDesc.VS = {
-      vertexShaderBlob->GetBufferPointer(),
-      vertexShaderBlob->GetBufferSize()}; // VertexShader
-  graphicsPipeLineStateDesc.PS = {
-      pixelShaderBlob->GetBufferPointer(),
-      pixelShaderBlob->GetBufferSize()};                      // PixelShader
-  graphicsPipeLineStateDesc.BlendState = blendDesc;           // BlendState
-  graphicsPipeLineStateDesc.RasterizerState = rasterizerDesc; // RasterizerState
+  graphicsPipeLineStateDesc.pRootSignature = batchRootSignature_.Get();
+  graphicsPipeLineStateDesc.InputLayout = inputLayoutDesc;
+  graphicsPipeLineStateDesc.VS = {vertexShaderBlob->GetBufferPointer(),
+                                  vertexShaderBlob->GetBufferSize()};
+  graphicsPipeLineStateDesc.RasterizerState = rasterizerDesc;
   graphicsPipeLineStateDesc.DepthStencilState = depthStencilDesc;
   graphicsPipeLineStateDesc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
-
-  // 書き込むRTVの情報
   graphicsPipeLineStateDesc.NumRenderTargets = 1;
   graphicsPipeLineStateDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
-
-  // 利用するトポロジ(形状)のタイプ。三角形
   graphicsPipeLineStateDesc.PrimitiveTopologyType =
       D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-
-  // どのように画面に色を打ち込むかの設定
   graphicsPipeLineStateDesc.SampleDesc.Count = 1;
   graphicsPipeLineStateDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
 
-  // 通常スプライト用PSO生成
-  graphicsPipeLineState_ = nullptr;
-  hr = device_->CreateGraphicsPipelineState(
-      &graphicsPipeLineStateDesc, IID_PPV_ARGS(&graphicsPipeLineState_));
-  assert(SUCCEEDED(hr));
+  for (size_t blendMode = 0; blendMode < size_t(SpriteBatch::BlendMode::kCount); ++blendMode) {
+
+    // BlendStateの設定（Alpha は半透明合成、Add は背景に足す）
+    D3D12_BLEND_DESC blendDesc{};
+    blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+    blendDesc.RenderTarget[0].BlendEnable = true;
+    blendDesc.RenderTarget[0].SrcBlend = D3D12_BLEND_SRC_ALPHA;
+    blendDesc.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;
+    blendDesc.RenderTarget[0].DestBlend =
+        blendMode == size_t(SpriteBatch::BlendMode::Add) ? D3D12_BLEND_ONE : D3D12_BLEND_INV_SRC_ALPHA;
+    blendDesc.RenderTarget[0].SrcBlendAlpha = D3D12_BLEND_ONE;
+    blendDesc.RenderTarget[0].BlendOpAlpha = D3D12_BLEND_OP_ADD;
+    blendDesc.RenderTarget[0].DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+    graphicsPipeLineStateDesc.BlendState = blendDesc;
+
+    for (size_t effect = 0; effect < size_t(SpriteBatch::Effect::kCount); ++effect) {
+      graphicsPipeLineStateDesc.PS = {pixelShaderBlobs[effect]->GetBufferPointer(),
+                                      pixelShaderBlobs[effect]->GetBufferSize()};
+
+      batchPipelineStates_[blendMode][effect] = nullptr;
+      hr = device_->CreateGraphicsPipelineState(
+          &graphicsPipeLineStateDesc, IID_PPV_ARGS(&batchPipelineStates_[blendMode][effect]));
+      assert(SUCCEEDED(hr));
+    }
+  }
+}
+
+void SpriteRenderer::CreateBatchIndexBuffer() {
+
+  // 四角形のインデックスはどのフレームでも同じなので、最大数ぶんを一度だけ書く
+  const uint32_t indexCount = SpriteBatch::kMaxQuadsPerDraw * SpriteBatch::kIndicesPerQuad;
+  const uint32_t sizeInBytes = uint32_t(sizeof(uint16_t) * indexCount);
+  batchIndexResource_ = dx12Core_->CreateBufferResource(sizeInBytes);
 
-  // UIEffect用PSO生成
-  graphicsPipeLineStateDesc.PS = {
-      uiEffectPixelShaderBlob->GetBufferPointer(),
-      uiEffectPixelShaderBlob->GetBufferSize()};
-  
-  uiEffectPipeLineState_ = nullptr;
-  hr = device_->CreateGraphicsPipelineState(
-      &graphicsPipeLineStateDesc, IID_PPV_ARGS(&uiEffectPipeLineState_));
+  uint16_t *indexData = nullptr;
+  HRESULT hr = batchIndexResource_->Map(0, nullptr, reinterpret_cast<void **>(&indexData));
   assert(SUCCEEDED(hr));
+  assert(indexData);
+  SpriteBatch::WriteIndices(indexData, SpriteBatch::kMaxQuadsPerDraw);
+  batchIndexResource_->Unmap(0, nullptr);
+
+  batchIndexBufferView_.location = batchIndexResource_->GetGPUVirtualAddress();
+  batchIndexBufferView_.sizeInBytes = sizeInBytes;
+  batchIndexBufferView_.format = ICommandRecorder::IndexFormat::UInt16;
+}
+
+void SpriteRenderer::BeginFrame() {
+  batch_.Clear();
+  stats_ = {};
 }
 
-void SpriteRenderer::Begin() {
-  commandList_->SetGraphicsRootSignature(rootSignature_.Get());
-  commandList_->SetPipelineState(graphicsPipeLineState_.Get());
-  commandList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+void SpriteRenderer::Submit(const SpriteBatch::State &state,
+                            const SpriteBatch::Vertex (&quad)[SpriteBatch::kVerticesPerQuad]) {
+  batch_.Add(state, quad);
 }
 
-void SpriteRenderer::BeginUIEffect() {
-  commandList_->SetGraphicsRootSignature(rootSignature_.Get());
-  commandList_->SetPipelineState(uiEffectPipeLineState_.Get());
-  commandList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-}
\ No newline at end of file
+void SpriteRenderer::Submit(const SpriteBatch::State &state, const SpriteBatch::Vertex *vertices,
+                            uint32_t quadCount) {
+  batch_.Add(state, vertices, quadCount);
+}
+
+void SpriteRenderer::Flush() {
+  if (batch_.IsEmpty()) {
+    return;
+  }
+
+  // 頂点はこのフレームのアップロード領域へまとめて書き出す（Flush ごとに1回）
+  const std::vector<SpriteBatch::Vertex> &vertices = batch_.GetVertices();
+  const size_t sizeInBytes = sizeof(SpriteBatch::Vertex) * vertices.size();
+  LinearUploadAllocator::Allocation allocation =
+      dx12Core_->GetFrameUploadAllocator().Allocate(sizeInBytes);
+  if (!allocation) {
+    Logger::Log("[SpriteRenderer] Flush: failed to allocate the vertex buffer\n");
+    batch_.Clear();
+    return;
+  }
+  std::memcpy(allocation.cpu, vertices.data(), sizeInBytes);
+
+  D3D12CommandRecorder recorder(commandList_);
+  recorder.SetRootSignature(batchRootSignature_.Get());
+  recorder.SetPrimitiveTopology(ICommandRecorder::PrimitiveTopology::TriangleList);
+  uint32_t drawCount = batch_.Record(
+      recorder, allocation.gpuAddress, batchIndexBufferView_, 0,
+      [this](const SpriteBatch::State &state) -> ICommandRecorder::PipelineHandle {
+        return batchPipelineStates_[size_t(state.blendMode)][size_t(state.effect)].Get();
+      });
+
+  stats_.quadCount += batch_.GetQuadCount();
+  stats_.batchCount += uint32_t(batch_.GetBatches().size());
+  stats_.drawCount += drawCount;
+  batch_.Clear();
+}
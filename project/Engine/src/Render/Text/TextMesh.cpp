@@ -0,0 +1,142 @@
+#include "Render/Text/TextMesh.h"
+#include "Math/MathUtil.h"
+#include "Render/Text/FontManager.h"
+
+namespace {
+
+bool Equal(const Vector2 &a, const Vector2 &b) { return a.x == b.x && a.y == b.y; }
+bool Equal(const Vector3 &a, const Vector3 &b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+bool Equal(const Vector4 &a, const Vector4 &b) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+
+bool Equal(const Matrix4x4 &a, const Matrix4x4 &b) {
+  for (int row = 0; row < 4; ++row) {
+    for (int column = 0; column < 4; ++column) {
+      if (a.m[row][column] != b.m[row][column]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+Vector2 TextMesh::Layout(const FontData &font, const std::string &text, std::vector<Glyph> &glyphs) {
+  glyphs.clear();
+  glyphs.reserve(text.size());
+
+  float x = 0.0f;
+  float y = font.pixelHeight; // ベースラインを下げて画面内に収める
+
+  for (char c : text) {
+    // アトラスにあるのは ASCII 32～127 の96文字だけ
+    if (c < 32 || c >= 32 + int(font.cdata.size())) {
+      continue;
+    }
+    stbtt_aligned_quad q;
+    stbtt_GetBakedQuad(const_cast<stbtt_bakedchar *>(font.cdata.data()), font.textureWidth,
+                       font.textureHeight, c - 32, &x, &y, &q, 1);
+
+    Glyph glyph;
+    glyph.leftTop = {q.x0, q.y0};
+    glyph.rightBottom = {q.x1, q.y1};
+    glyph.texLeftTop = {q.s0, q.t0};
+    glyph.texRightBottom = {q.s1, q.t1};
+    glyphs.push_back(glyph);
+  }
+  return {x, font.pixelHeight};
+}
+
+void TextMesh::SetText(const std::string &text) {
+  if (text != text_) {
+    text_ = text;
+    layoutDirty_ = true;
+  }
+}
+
+void TextMesh::SetFont(const FontData *font) {
+  if (font != font_) {
+    font_ = font;
+    layoutDirty_ = true;
+  }
+}
+
+void TextMesh::SetAnchorPoint(const Vector2 &anchorPoint) {
+  if (!Equal(anchorPoint, anchorPoint_)) {
+    anchorPoint_ = anchorPoint;
+    verticesDirty_ = true;
+  }
+}
+
+void TextMesh::SetTransform(const Transform &transform) {
+  if (!Equal(transform.scale, transform_.scale) || !Equal(transform.rotate, transform_.rotate) ||
+      !Equal(transform.translate, transform_.translate)) {
+    transform_ = transform;
+    verticesDirty_ = true;
+  }
+}
+
+void TextMesh::SetColor(const Vector4 &color) {
+  if (!Equal(color, color_)) {
+    color_ = color;
+    verticesDirty_ = true;
+  }
+}
+
+void TextMesh::SetViewProjection(const Matrix4x4 &viewProjection) {
+  if (!Equal(viewProjection, viewProjection_)) {
+    viewProjection_ = viewProjection;
+    verticesDirty_ = true;
+  }
+}
+
+bool TextMesh::Update() {
+  if (!layoutDirty_ && !verticesDirty_) {
+    return false;
+  }
+
+  if (layoutDirty_) {
+    // フォントがまだなければ空にしておく（読み込まれたら SetFont で作り直す）
+    if (font_) {
+      size_ = Layout(*font_, text_, glyphs_);
+    } else {
+      glyphs_.clear();
+      size_ = {0.0f, 0.0f};
+    }
+    layoutDirty_ = false;
+    ++stats_.layoutCount;
+  }
+
+  // アンカーポイントの分ずらしてから WVP を掛ける
+  const Vector2 offset = {size_.x * anchorPoint_.x, size_.y * anchorPoint_.y};
+  const Matrix4x4 worldViewProjection =
+      Multiply(MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate), viewProjection_);
+
+  vertices_.resize(glyphs_.size() * SpriteBatch::kVerticesPerQuad);
+  for (size_t i = 0; i < glyphs_.size(); ++i) {
+    const Glyph &glyph = glyphs_[i];
+    const float left = glyph.leftTop.x - offset.x;
+    const float top = glyph.leftTop.y - offset.y;
+    const float right = glyph.rightBottom.x - offset.x;
+    const float bottom = glyph.rightBottom.y - offset.y;
+
+    // 左下・左上・右下・右上
+    SpriteBatch::Vertex *quad = &vertices_[i * SpriteBatch::kVerticesPerQuad];
+    quad[0].position = Multiply(Vector4{left, bottom, 0.0f, 1.0f}, worldViewProjection);
+    quad[0].texcoord = {glyph.texLeftTop.x, glyph.texRightBottom.y};
+    quad[1].position = Multiply(Vector4{left, top, 0.0f, 1.0f}, worldViewProjection);
+    quad[1].texcoord = {glyph.texLeftTop.x, glyph.texLeftTop.y};
+    quad[2].position = Multiply(Vector4{right, bottom, 0.0f, 1.0f}, worldViewProjection);
+    quad[2].texcoord = {glyph.texRightBottom.x, glyph.texRightBottom.y};
+    quad[3].position = Multiply(Vector4{right, top, 0.0f, 1.0f}, worldViewProjection);
+    quad[3].texcoord = {glyph.texRightBottom.x, glyph.texLeftTop.y};
+    for (uint32_t j = 0; j < SpriteBatch::kVerticesPerQuad; ++j) {
+      quad[j].color = color_;
+      quad[j].effectParams0 = {};
+      quad[j].effectParams1 = {};
+    }
+  }
+  verticesDirty_ = false;
+  ++stats_.vertexCount;
+  return true;
+}
@@ -4,6 +4,7 @@
 #include "Debug/Logger.h"
 #include "Util/StringUtil.h"
 #include <filesystem>
+#include <stdexcept>
 #include <unordered_set>
 
 // ImGuiで０番を使用するため、1番から使用する
@@ -26,6 +27,7 @@ void TextureManager::Initialize(Dx12Core *dx12Core, SrvManager *srvManager) {
 
 void TextureManager::Finalize() {
   TextureManager *instance = GetInstance();
+  instance->pendingTextures_.clear();
   instance->textureDatas.clear();
   instance->intermediateResources_.clear();
   instance->dx12Core_ = nullptr;
@@ -34,14 +36,58 @@ void TextureManager::Finalize() {
 
 void TextureManager::LoadTexture(const std::string &filePath) {
 
+  // 非同期で読み込み中なら、それを待つ
+  if (auto pending = pendingTextures_.find(filePath); pending != pendingTextures_.end()) {
+    AsyncLoader::GetInstance()->Wait(pending->second);
+    return;
+  }
+
   if (textureDatas.contains(filePath)) {
     return;
   }
 
-  assert(srvManager_->CanAllocate());
+  DirectX::ScratchImage mipImages{};
+  if (!DecodeTextureFile(filePath, mipImages)) {
+    return;
+  }
+  CreateTexture(filePath, mipImages);
+}
+
+LoadHandle TextureManager::LoadTextureAsync(const std::string &filePath) {
+
+  if (auto pending = pendingTextures_.find(filePath); pending != pendingTextures_.end()) {
+    return pending->second;
+  }
+  if (textureDatas.contains(filePath)) {
+    return AsyncLoader::MakeReady(filePath);
+  }
+
+  // 読み込み中はプレースホルダー（白）を返すので、先にそれだけは同期で用意する
+  LoadTexture(kPlaceholderTexturePath);
+
+  // デコード（ファイル読み込み・ミップマップ生成）はワーカーで、GPU 転送と SRV 作成はメインスレッドで行う
+  auto mipImages = std::make_shared<DirectX::ScratchImage>();
+  LoadHandle handle = AsyncLoader::GetInstance()->Submit(
+      filePath,
+      [filePath, mipImages] {
+        if (!DecodeTextureFile(filePath, *mipImages)) {
+          throw std::runtime_error("decode failed");
+        }
+      },
+      [this, filePath, mipImages](bool succeeded) {
+        pendingTextures_.erase(filePath);
+        if (succeeded && !textureDatas.contains(filePath)) {
+          CreateTexture(filePath, *mipImages);
+        }
+      });
+  pendingTextures_.emplace(filePath, handle);
+  return handle;
+}
+
+bool TextureManager::DecodeTextureFile(const std::string &filePath,
+                                       DirectX::ScratchImage &mipImages) {
 
   DirectX::ScratchImage image{};
-  DirectX::ScratchImage mipImages{};
   std::wstring filePathW = StringUtil::ConvertString(filePath);
 
   HRESULT hr = S_OK;
@@ -64,7 +110,7 @@ void TextureManager::LoadTexture(const std::string &filePath) {
     hr = DirectX::LoadFromWICFile(L"resources/white1x1.png", DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
     if (FAILED(hr)) {
       Logger::Log("Fallback texture white1x1.png also failed to load.\n");
-      return;
+      return false;
     }
   }
 
@@ -87,6 +133,13 @@ void TextureManager::LoadTexture(const std::string &filePath) {
       mipImages = std::move(image);
     }
   }
+  return true;
+}
+
+void TextureManager::CreateTexture(const std::string &filePath,
+                                   const DirectX::ScratchImage &mipImages) {
+
+  assert(srvManager_->CanAllocate());
 
   TextureData &textureData = textureDatas[filePath];
 
@@ -176,6 +229,10 @@ D3D12_GPU_DESCRIPTOR_HANDLE
 TextureManager::GetSrvHandleGPU(const std::string &filePath) const {
 
   if (!textureDatas.contains(filePath)) {
+    // 非同期で読み込み中はプレースホルダーを使う
+    if (pendingTextures_.contains(filePath) && textureDatas.contains(kPlaceholderTexturePath)) {
+      return textureDatas.at(kPlaceholderTexturePath).srvHandleGPU;
+    }
     static std::unordered_set<std::string> loggedErrors;
     if (!loggedErrors.contains(filePath)) {
       Logger::Log("Texture not found in GetSrvHandleGPU: " + filePath + "\n");
@@ -194,6 +251,9 @@ TextureManager::GetSrvHandleGPU(const std::string &filePath) const {
 const DirectX::TexMetadata &
 TextureManager::GetMetaData(const std::string &filePath) const {
   if (!textureDatas.contains(filePath)) {
+    if (pendingTextures_.contains(filePath) && textureDatas.contains(kPlaceholderTexturePath)) {
+      return textureDatas.at(kPlaceholderTexturePath).metadata;
+    }
     if (!textureDatas.empty()) {
       return textureDatas.begin()->second.metadata;
     }
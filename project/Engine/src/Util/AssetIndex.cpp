@@ -0,0 +1,167 @@
+#include "Util/AssetIndex.h"
+#include "Debug/Logger.h"
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool HasSeparator(const std::string &path) {
+  return path.find('/') != std::string::npos || path.find('\\') != std::string::npos;
+}
+
+std::string ToGenericSeparator(std::string path) {
+  std::replace(path.begin(), path.end(), '\\', '/');
+  return path;
+}
+
+} // namespace
+
+AssetIndex *AssetIndex::GetInstance() {
+  static AssetIndex instance;
+  return &instance;
+}
+
+AssetIndex::~AssetIndex() { StopWatching(); }
+
+void AssetIndex::Build(const std::string &root) {
+  // 走査はロックの外で行い、できあがった表だけを差し替える
+  std::unordered_map<std::string, std::vector<std::string>> byName;
+  std::unordered_map<std::string, std::string> byRelativePath;
+  size_t fileCount = 0;
+
+  std::error_code ec;
+  const fs::path base = root;
+  if (fs::exists(base, ec)) {
+    for (auto it = fs::recursive_directory_iterator(base, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+      if (!it->is_regular_file(ec)) {
+        continue;
+      }
+
+      std::string resolved = it->path().generic_string();
+      std::string relative = it->path().lexically_relative(base).generic_string();
+      byName[it->path().filename().string()].push_back(resolved);
+      byRelativePath.emplace(std::move(relative), std::move(resolved));
+      ++fileCount;
+    }
+  }
+
+  // 同名ファイルは辞書順で先頭のものを採用し、警告を出しておく
+  for (auto &[name, candidates] : byName) {
+    if (candidates.size() < 2) {
+      continue;
+    }
+    std::sort(candidates.begin(), candidates.end());
+    std::string message = "[AssetIndex] ambiguous file name: " + name + " ->";
+    for (const std::string &candidate : candidates) {
+      message += " " + candidate;
+    }
+    Logger::Log(message + " (using " + candidates.front() + ")\n");
+  }
+
+  std::unique_lock lock(mutex_);
+  root_ = root;
+  byName_ = std::move(byName);
+  byRelativePath_ = std::move(byRelativePath);
+  fileCount_ = fileCount;
+  isBuilt_ = true;
+}
+
+void AssetIndex::Refresh() { Build(root_); }
+
+std::string AssetIndex::Resolve(const std::string &input) {
+  {
+    std::shared_lock lock(mutex_);
+    if (isBuilt_) {
+      return ResolveLocked(input);
+    }
+  }
+
+  Build(root_);
+  std::shared_lock lock(mutex_);
+  return ResolveLocked(input);
+}
+
+std::string AssetIndex::ResolveLocked(const std::string &input) const {
+  if (HasSeparator(input)) {
+    // ルートからの相対パスならルートを付ける。それ以外のパスはそのまま
+    auto it = byRelativePath_.find(ToGenericSeparator(input));
+    return (it != byRelativePath_.end()) ? it->second : input;
+  }
+
+  auto it = byName_.find(input);
+  if (it != byName_.end()) {
+    return it->second.front();
+  }
+
+  // 見つからなければ、そのまま
+  return input;
+}
+
+std::vector<std::string> AssetIndex::FindCandidates(const std::string &fileName) {
+  Resolve(fileName); // 未構築なら構築する
+
+  std::shared_lock lock(mutex_);
+  auto it = byName_.find(fileName);
+  return (it != byName_.end()) ? it->second : std::vector<std::string>{};
+}
+
+bool AssetIndex::IsAmbiguous(const std::string &fileName) {
+  return FindCandidates(fileName).size() > 1;
+}
+
+void AssetIndex::StartWatching() {
+#ifdef _WIN32
+  if (watchHandle_) {
+    return;
+  }
+
+  // ファイル・ディレクトリの追加/削除/名前変更だけを監視する（内容の更新では索引は変わらない）
+  HANDLE handle = FindFirstChangeNotificationA(
+      root_.c_str(), TRUE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME);
+  if (handle == INVALID_HANDLE_VALUE) {
+    Logger::Log("[AssetIndex] failed to watch " + root_ + "\n");
+    return;
+  }
+  watchHandle_ = handle;
+#endif
+}
+
+void AssetIndex::StopWatching() {
+#ifdef _WIN32
+  if (watchHandle_) {
+    FindCloseChangeNotification(static_cast<HANDLE>(watchHandle_));
+    watchHandle_ = nullptr;
+  }
+#endif
+}
+
+bool AssetIndex::PollChanges() {
+#ifdef _WIN32
+  if (!watchHandle_) {
+    return false;
+  }
+
+  HANDLE handle = static_cast<HANDLE>(watchHandle_);
+  if (WaitForSingleObject(handle, 0) != WAIT_OBJECT_0) {
+    return false;
+  }
+
+  // 連続した変更はまとめて1回の再構築にする
+  do {
+    FindNextChangeNotification(handle);
+  } while (WaitForSingleObject(handle, 0) == WAIT_OBJECT_0);
+
+  Refresh();
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,239 @@
+#include "Util/AsyncLoader.h"
+#include "Debug/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <objbase.h>
+#endif
+
+const std::string &LoadHandle::GetName() const {
+  static const std::string kEmpty;
+  return state_ ? state_->name : kEmpty;
+}
+
+AsyncLoader *AsyncLoader::GetInstance() {
+  static AsyncLoader instance;
+  return &instance;
+}
+
+AsyncLoader::~AsyncLoader() { Shutdown(); }
+
+void AsyncLoader::Initialize(uint32_t workerCount) {
+  Shutdown();
+
+  if (workerCount == 0) {
+    // メインスレッドの分を1つ空けておく
+    uint32_t hardware = std::thread::hardware_concurrency();
+    workerCount = std::max(1u, hardware > 1 ? hardware - 1 : 1u);
+  }
+
+  mainThreadId_ = std::this_thread::get_id();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+  }
+  workers_.reserve(workerCount);
+  for (uint32_t i = 0; i < workerCount; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+void AsyncLoader::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  workAvailable_.notify_all();
+  for (std::thread &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+
+  // 途中のものは失敗扱いにして捨てる（後処理が参照するマネージャーはもう使えない前提）
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const StatePtr &state : workQueue_) {
+    state->state.store(LoadState::Failed, std::memory_order_release);
+  }
+  for (const StatePtr &state : finalizeQueue_) {
+    state->state.store(LoadState::Failed, std::memory_order_release);
+  }
+  workQueue_.clear();
+  finalizeQueue_.clear();
+  pendingCount_ = 0;
+}
+
+LoadHandle AsyncLoader::Submit(const std::string &name, std::function<void()> work,
+                               std::function<void(bool succeeded)> finalize) {
+  auto state = std::make_shared<LoadHandle::State>();
+  state->name = name;
+  state->work = std::move(work);
+  state->finalize = std::move(finalize);
+
+  if (workers_.empty()) {
+    // ワーカーがなければその場で読む（後処理のタイミングは非同期と同じにする）
+    RunWork(*state);
+    std::lock_guard<std::mutex> lock(mutex_);
+    finalizeQueue_.push_back(state);
+    ++pendingCount_;
+    return LoadHandle(state);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workQueue_.push_back(state);
+    ++pendingCount_;
+  }
+  workAvailable_.notify_one();
+  return LoadHandle(state);
+}
+
+LoadHandle AsyncLoader::MakeReady(const std::string &name) {
+  auto state = std::make_shared<LoadHandle::State>();
+  state->name = name;
+  state->state.store(LoadState::Ready, std::memory_order_release);
+  return LoadHandle(state);
+}
+
+uint32_t AsyncLoader::Update(double budgetMs) {
+  const auto start = std::chrono::steady_clock::now();
+  uint32_t finalized = 0;
+
+  while (true) {
+    StatePtr state;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (finalizeQueue_.empty()) {
+        break;
+      }
+      state = std::move(finalizeQueue_.front());
+      finalizeQueue_.pop_front();
+    }
+    RunFinalize(state);
+    ++finalized;
+
+    double elapsedMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (elapsedMs >= budgetMs) {
+      break;
+    }
+  }
+  return finalized;
+}
+
+void AsyncLoader::Wait(const LoadHandle &handle) {
+  if (!handle.IsValid()) {
+    return;
+  }
+  while (!handle.IsDone()) {
+    StatePtr state;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      workFinished_.wait(lock, [&] { return !finalizeQueue_.empty() || pendingCount_ == 0; });
+      if (finalizeQueue_.empty()) {
+        // Shutdown 済みなどで、もう終わらない
+        break;
+      }
+      state = std::move(finalizeQueue_.front());
+      finalizeQueue_.pop_front();
+    }
+    RunFinalize(state);
+  }
+}
+
+void AsyncLoader::WaitAll() {
+  while (true) {
+    StatePtr state;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      workFinished_.wait(lock, [&] { return !finalizeQueue_.empty() || pendingCount_ == 0; });
+      if (finalizeQueue_.empty()) {
+        return;
+      }
+      state = std::move(finalizeQueue_.front());
+      finalizeQueue_.pop_front();
+    }
+    RunFinalize(state);
+  }
+}
+
+size_t AsyncLoader::GetPendingCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pendingCount_;
+}
+
+void AsyncLoader::WorkerLoop() {
+#ifdef _WIN32
+  // WIC・Media Foundation はスレッドごとに COM の初期化が要る
+  HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+  while (true) {
+    StatePtr state;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      workAvailable_.wait(lock, [&] { return stopping_ || !workQueue_.empty(); });
+      if (stopping_) {
+        break;
+      }
+      state = std::move(workQueue_.front());
+      workQueue_.pop_front();
+    }
+
+    RunWork(*state);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_) {
+        state->state.store(LoadState::Failed, std::memory_order_release);
+        break;
+      }
+      finalizeQueue_.push_back(std::move(state));
+    }
+    workFinished_.notify_all();
+  }
+
+#ifdef _WIN32
+  if (SUCCEEDED(comResult)) {
+    CoUninitialize();
+  }
+#endif
+}
+
+void AsyncLoader::RunWork(LoadHandle::State &state) {
+  try {
+    if (state.work) {
+      state.work();
+    }
+    state.workSucceeded = true;
+  } catch (const std::exception &e) {
+    Logger::Log("[AsyncLoader] " + state.name + " failed: " + e.what() + "\n");
+    state.workSucceeded = false;
+  }
+  state.work = nullptr;
+}
+
+void AsyncLoader::RunFinalize(const StatePtr &state) {
+  bool succeeded = state->workSucceeded;
+  if (state->finalize) {
+    try {
+      state->finalize(succeeded);
+    } catch (const std::exception &e) {
+      Logger::Log("[AsyncLoader] " + state->name + " finalize failed: " + e.what() + "\n");
+      succeeded = false;
+    }
+    state->finalize = nullptr;
+  }
+  state->state.store(succeeded ? LoadState::Ready : LoadState::Failed, std::memory_order_release);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pendingCount_ > 0) {
+    --pendingCount_;
+  }
+  // WaitAll が pendingCount_ == 0 を見られるよう起こす
+  workFinished_.notify_all();
+}
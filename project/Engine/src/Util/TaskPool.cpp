@@ -0,0 +1,132 @@
+#include "Util/TaskPool.h"
+#include <algorithm>
+
+namespace {
+// ParallelFor の処理の中から ParallelFor を呼んだら、その場で回す（待ち合って止まらないように）
+// ワーカーは常に、呼んだスレッドは自分の分を回している間だけ立てる
+thread_local bool tInsideParallelFor = false;
+} // namespace
+
+TaskPool *TaskPool::GetInstance() {
+  static TaskPool instance;
+  return &instance;
+}
+
+TaskPool::~TaskPool() { Shutdown(); }
+
+void TaskPool::Initialize(uint32_t workerCount) {
+  Shutdown();
+
+  if (workerCount == 0) {
+    // 呼んだスレッドも手伝うので、その分を1つ空けておく
+    uint32_t hardware = std::thread::hardware_concurrency();
+    workerCount = hardware > 1 ? hardware - 1 : 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+  }
+  workers_.reserve(workerCount);
+  for (uint32_t i = 0; i < workerCount; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+void TaskPool::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  workAvailable_.notify_all();
+  for (std::thread &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+void TaskPool::ParallelFor(size_t count, size_t grainSize,
+                           const std::function<void(size_t begin, size_t end)> &body) {
+  if (count == 0) {
+    return;
+  }
+  grainSize = std::max<size_t>(grainSize, 1);
+
+  // 分けるほどの量がない・ワーカーがない・処理の中から呼ばれたときはその場で回す
+  if (workers_.empty() || count <= grainSize || tInsideParallelFor) {
+    for (size_t begin = 0; begin < count; begin += grainSize) {
+      body(begin, std::min(begin + grainSize, count));
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> parallelForLock(parallelForMutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    count_ = count;
+    grainSize_ = grainSize;
+    nextIndex_.store(0, std::memory_order_relaxed);
+    finishedCount_.store(0, std::memory_order_relaxed);
+    ++generation_;
+  }
+  workAvailable_.notify_all();
+
+  tInsideParallelFor = true;
+  RunChunks();
+  tInsideParallelFor = false;
+
+  // 自分の分が終わったら、ワーカーが持っていった分を待つ
+  // ワーカーが body_ を触り終えるまで待ってから戻る（body は呼び出し元のスタックにある）
+  std::unique_lock<std::mutex> lock(mutex_);
+  workFinished_.wait(lock, [&] {
+    return finishedCount_.load(std::memory_order_acquire) >= count_ && activeWorkers_ == 0;
+  });
+  body_ = nullptr;
+}
+
+void TaskPool::RunChunks() {
+  const std::function<void(size_t, size_t)> &body = *body_;
+  const size_t count = count_;
+  const size_t grainSize = grainSize_;
+  while (true) {
+    size_t begin = nextIndex_.fetch_add(grainSize, std::memory_order_relaxed);
+    if (begin >= count) {
+      break;
+    }
+    size_t end = std::min(begin + grainSize, count);
+    body(begin, end);
+    finishedCount_.fetch_add(end - begin, std::memory_order_acq_rel);
+  }
+}
+
+void TaskPool::WorkerLoop() {
+  tInsideParallelFor = true;
+  uint64_t seenGeneration = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    seenGeneration = generation_;
+  }
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      workAvailable_.wait(lock, [&] { return stopping_ || (generation_ != seenGeneration && body_); });
+      if (stopping_) {
+        break;
+      }
+      seenGeneration = generation_;
+      ++activeWorkers_;
+    }
+
+    RunChunks();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --activeWorkers_;
+    }
+    workFinished_.notify_all();
+  }
+}
@@ -0,0 +1,469 @@
+// アニメーションのブレンド（PoseBlend / AnimationController）と TaskPool の確認とベンチマーク
+// 200 体が「歩き→走りのクロスフェード＋上半身だけ別クリップ＋呼吸の加算」を再生する1フレーム分を測る
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -pthread -IEngine/include -IEngine/include/Render -Iexternals
+//       -o animation_blend_benchmark tools/Benchmark/AnimationBlendBenchmark.cpp
+//       Engine/src/Render/Model/AnimationBlend.cpp Engine/src/Render/Model/Skeleton.cpp
+//       Engine/src/Render/Model/CompressedAnimation.cpp Engine/src/Render/Model/AnimationSampler.cpp
+//       Engine/src/Util/TaskPool.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./animation_blend_benchmark --out animation_blend_baseline.json
+//   ./animation_blend_benchmark --baseline animation_blend_baseline.json
+#include "BenchmarkCommon.h"
+#include "Model/AnimationBlend.h"
+#include "Util/TaskPool.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kCharacterCount = 200;
+constexpr uint32_t kJointCount = 70;
+constexpr float kKeysPerSecond = 30.0f;
+constexpr float kFrameTime = 1.0f / 60.0f;
+
+std::string JointName(uint32_t index) { return "Armature|mixamorig:Joint_" + std::to_string(index); }
+
+Quaternion AxisAngle(Vector3 axis, float angle) {
+  float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+  float s = std::sin(angle * 0.5f) / length;
+  return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+// 背骨から枝分かれする木（Joint 1 の子孫を「上半身」として使う）
+ModelAsset::Node MakeHierarchy() {
+  std::vector<ModelAsset::Node> nodes(kJointCount);
+  for (uint32_t i = 0; i < kJointCount; ++i) {
+    nodes[i].name = JointName(i);
+    nodes[i].transform = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.3f, 0.0f}};
+    nodes[i].localMatrix = MakeAffineMatrix(nodes[i].transform.scale, nodes[i].transform.rotate,
+                                            nodes[i].transform.translate);
+  }
+  for (int32_t i = kJointCount - 1; i > 0; --i) {
+    int32_t parent = (i - 1) / 2;
+    nodes[parent].children.insert(nodes[parent].children.begin(), std::move(nodes[i]));
+  }
+  return nodes[0];
+}
+
+// amplitude が 0 のクリップは全フレーム同じ姿勢になる
+Animation MakeClip(uint32_t seed, float seconds, float amplitude) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> speed(0.5f, 3.0f);
+  Animation animation;
+  animation.duration = seconds;
+  const uint32_t keyCount = static_cast<uint32_t>(seconds * kKeysPerSecond) + 1;
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    NodeAnimation &node = animation.nodeAnimations[JointName(j)];
+    const Vector3 axis{unit(rng), unit(rng), unit(rng) + 1.5f};
+    const float base = unit(rng);
+    const float frequency = speed(rng);
+    for (uint32_t k = 0; k < keyCount; ++k) {
+      float time = std::min(static_cast<float>(k) / kKeysPerSecond, seconds);
+      float phase = time * frequency;
+      node.rotate.keyframes.push_back({time, AxisAngle(axis, base + std::sin(phase) * amplitude)});
+      node.translate.keyframes.push_back({time, {0.0f, 0.3f + 0.05f * std::sin(phase) * amplitude, 0.0f}});
+      float s = 1.0f + 0.05f * std::sin(phase) * amplitude;
+      node.scale.keyframes.push_back({time, {s, s, s}});
+    }
+  }
+  return animation;
+}
+
+double RotationAngle(const Quaternion &a, const Quaternion &b) {
+  double dot = double(a.x) * b.x + double(a.y) * b.y + double(a.z) * b.z + double(a.w) * b.w;
+  double la = std::sqrt(double(a.x) * a.x + double(a.y) * a.y + double(a.z) * a.z + double(a.w) * a.w);
+  double lb = std::sqrt(double(b.x) * b.x + double(b.y) * b.y + double(b.z) * b.z + double(b.w) * b.w);
+  return 2.0 * std::acos(std::fmin(1.0, std::fabs(dot) / (la * lb)));
+}
+
+double Distance(const Vector3 &a, const Vector3 &b) {
+  double x = double(a.x) - b.x;
+  double y = double(a.y) - b.y;
+  double z = double(a.z) - b.z;
+  return std::sqrt(x * x + y * y + z * z);
+}
+
+// 2つの姿勢の最大の差（位置・スケール・回転角をまとめて）
+double PoseDifference(const PoseBuffer &a, const PoseBuffer &b) {
+  double difference = 0.0;
+  for (size_t j = 0; j < a.jointCount; ++j) {
+    QuaternionTransform ta = a.GetJoint(j);
+    QuaternionTransform tb = b.GetJoint(j);
+    difference = std::fmax(difference, Distance(ta.translate, tb.translate));
+    difference = std::fmax(difference, Distance(ta.scale, tb.scale));
+    difference = std::fmax(difference, RotationAngle(ta.rotate, tb.rotate));
+  }
+  return difference;
+}
+
+PoseBuffer RandomPose(uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+  PoseBuffer pose;
+  pose.Resize(kJointCount);
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    QuaternionTransform t;
+    t.translate = {unit(rng), unit(rng), unit(rng)};
+    t.rotate = AxisAngle({unit(rng), unit(rng), unit(rng) + 2.0f}, 3.0f * unit(rng));
+    t.scale = {scale(rng), scale(rng), scale(rng)};
+    pose.SetJoint(j, t);
+  }
+  return pose;
+}
+
+bool SameTransforms(const Skeleton &a, const Skeleton &b) {
+  return std::memcmp(a.transforms.data(), b.transforms.data(),
+                     a.transforms.size() * sizeof(QuaternionTransform)) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "animation_blend_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const Skeleton bindSkeleton = CreateSkeleton(MakeHierarchy());
+  const Animation walk = MakeClip(1, 1.0f, 0.6f);
+  const Animation run = MakeClip(2, 0.7f, 1.0f);
+  const Animation wave = MakeClip(3, 2.0f, 0.8f);
+  const Animation breathe = MakeClip(4, 3.0f, 0.1f);
+  const Animation still = MakeClip(5, 1.0f, 0.0f);
+  const CompressedAnimation walkCompressed = AnimationCompression::Compress(walk);
+
+  const AnimationClip walkClip = MakeAnimationClip(bindSkeleton, walk);
+  const AnimationClip runClip = MakeAnimationClip(bindSkeleton, run);
+  const AnimationClip waveClip = MakeAnimationClip(bindSkeleton, wave);
+  const AnimationClip breatheClip = MakeAnimationClip(bindSkeleton, breathe);
+  const AnimationClip stillClip = MakeAnimationClip(bindSkeleton, still);
+  const AnimationClip walkCompressedClip = MakeAnimationClip(bindSkeleton, walkCompressed);
+  const std::vector<float> upperBody = PoseBlend::MakeJointMask(bindSkeleton, JointName(1));
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[AnimationBlend] %s\n", label);
+      ok = false;
+    }
+  };
+
+  {
+    // Blend：端点・中点・反対側の四元数・マスク
+    const PoseBuffer a = RandomPose(10);
+    const PoseBuffer b = RandomPose(11);
+    PoseBuffer out;
+    PoseBlend::Blend(a, b, 0.0f, nullptr, out);
+    check("blend weight 0 is a", PoseDifference(out, a) < 1.0e-5);
+    PoseBlend::Blend(a, b, 1.0f, nullptr, out);
+    check("blend weight 1 is b", PoseDifference(out, b) < 1.0e-5);
+
+    PoseBlend::Blend(a, b, 0.5f, nullptr, out);
+    bool midpoint = true;
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      QuaternionTransform ta = a.GetJoint(j), tb = b.GetJoint(j), tm = out.GetJoint(j);
+      Vector3 mid{(ta.translate.x + tb.translate.x) * 0.5f, (ta.translate.y + tb.translate.y) * 0.5f,
+                  (ta.translate.z + tb.translate.z) * 0.5f};
+      // nlerp の 0.5 は slerp と同じく両端からちょうど半分の角度になる
+      double toA = RotationAngle(tm.rotate, ta.rotate);
+      double toB = RotationAngle(tm.rotate, tb.rotate);
+      double whole = RotationAngle(ta.rotate, tb.rotate);
+      double length = std::sqrt(double(tm.rotate.x) * tm.rotate.x + double(tm.rotate.y) * tm.rotate.y +
+                                double(tm.rotate.z) * tm.rotate.z + double(tm.rotate.w) * tm.rotate.w);
+      midpoint = midpoint && Distance(tm.translate, mid) < 1.0e-6 && std::fabs(toA - toB) < 1.0e-3 &&
+                 std::fabs(toA + toB - whole) < 1.0e-3 && std::fabs(length - 1.0) < 1.0e-6;
+    }
+    check("blend midpoint", midpoint);
+
+    // b の四元数の符号を反転しても（同じ回転）結果は同じ
+    PoseBuffer negated = b;
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      negated.rotateX[j] = -negated.rotateX[j];
+      negated.rotateY[j] = -negated.rotateY[j];
+      negated.rotateZ[j] = -negated.rotateZ[j];
+      negated.rotateW[j] = -negated.rotateW[j];
+    }
+    PoseBuffer flipped;
+    PoseBlend::Blend(a, negated, 0.3f, nullptr, flipped);
+    PoseBlend::Blend(a, b, 0.3f, nullptr, out);
+    check("blend takes the short path", PoseDifference(out, flipped) < 1.0e-6);
+
+    // マスクが 0 の Joint は a のまま、1 の Joint は b
+    PoseBlend::Blend(a, b, 1.0f, upperBody.data(), out);
+    bool masked = true;
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      PoseBuffer one, expected;
+      one.Resize(1);
+      expected.Resize(1);
+      one.SetJoint(0, out.GetJoint(j));
+      expected.SetJoint(0, upperBody[j] > 0.0f ? b.GetJoint(j) : a.GetJoint(j));
+      masked = masked && PoseDifference(one, expected) < 1.0e-5;
+    }
+    check("blend mask", masked);
+
+    // 加算：差分を作って基準に重み 1 で足すと元に戻る。重み 0 なら base のまま
+    PoseBuffer additive;
+    PoseBlend::MakeAdditive(b, a, additive);
+    PoseBlend::ApplyAdditive(a, additive, 1.0f, nullptr, out);
+    check("additive round trip", PoseDifference(out, b) < 1.0e-5);
+    const PoseBuffer base = RandomPose(12);
+    PoseBlend::ApplyAdditive(base, additive, 0.0f, nullptr, out);
+    check("additive weight 0", PoseDifference(out, base) < 1.0e-5);
+    // 差分なし（source == reference）は何も変えない
+    PoseBlend::MakeAdditive(a, a, additive);
+    PoseBlend::ApplyAdditive(base, additive, 0.7f, nullptr, out);
+    check("empty additive", PoseDifference(out, base) < 1.0e-5);
+  }
+
+  {
+    // 1クリップだけなら、バインド済みの ApplyAnimation と結果がビット単位で一致する
+    Skeleton expected = bindSkeleton;
+    Skeleton actual = bindSkeleton;
+    AnimationController controller;
+    controller.Initialize(bindSkeleton);
+    controller.Play(walkClip);
+    std::vector<NodeAnimationCursor> cursors;
+    bool same = true;
+    for (uint32_t frame = 0; frame < 150; ++frame) {
+      controller.Update(kFrameTime);
+      controller.Evaluate(actual);
+      ApplyAnimation(expected, walkClip.binding, controller.GetLayerTime(0), cursors);
+      same = same && SameTransforms(expected, actual);
+    }
+    check("single clip matches ApplyAnimation", same);
+
+    // 圧縮したクリップも同じように再生できる
+    controller.Play(walkCompressedClip);
+    controller.Update(0.25f);
+    controller.Evaluate(actual);
+    ApplyAnimation(expected, walkCompressed, walkCompressedClip.binding, 0.25f);
+    check("compressed clip", SameTransforms(expected, actual));
+  }
+
+  {
+    // クロスフェード：途中は2つのクリップの補間、終わったら新しいクリップそのもの
+    AnimationController controller;
+    controller.Initialize(bindSkeleton);
+    controller.Play(walkClip);
+    controller.Update(0.3f);
+    controller.Play(runClip, 0.2f);
+    controller.Update(0.1f);
+    check("fading", controller.IsFading(0));
+
+    Skeleton actual = bindSkeleton;
+    controller.Evaluate(actual);
+    std::vector<QuaternionTransform> basePose = bindSkeleton.transforms;
+    std::vector<NodeAnimationCursor> cursors;
+    std::vector<QuaternionTransform> scratch;
+    PoseBuffer from, to, expected, got;
+    PoseBlend::SampleClip(walkClip, 0.4f, basePose, cursors, scratch, from);
+    cursors.clear();
+    PoseBlend::SampleClip(runClip, 0.1f, basePose, cursors, scratch, to);
+    PoseBlend::Blend(from, to, 0.5f, nullptr, expected);
+    got.Resize(kJointCount);
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      got.SetJoint(j, actual.transforms[j]);
+    }
+    check("crossfade midpoint", PoseDifference(got, expected) < 1.0e-5);
+
+    controller.Update(0.15f);
+    check("fade finished", !controller.IsFading(0));
+    controller.Evaluate(actual);
+    Skeleton expectedSkeleton = bindSkeleton;
+    cursors.clear();
+    ApplyAnimation(expectedSkeleton, runClip.binding, controller.GetLayerTime(0), cursors);
+    check("after fade is the new clip", SameTransforms(expectedSkeleton, actual));
+  }
+
+  {
+    // 上半身だけ上書きするレイヤー・加算レイヤー
+    AnimationController controller;
+    controller.Initialize(bindSkeleton);
+    controller.Play(walkClip);
+    uint32_t upper = controller.AddLayer(AnimationController::BlendMode::Override);
+    controller.SetLayerMask(upper, upperBody);
+    controller.Play(waveClip, 0.0f, upper);
+    controller.Update(0.5f);
+
+    Skeleton actual = bindSkeleton;
+    controller.Evaluate(actual);
+    Skeleton walkOnly = bindSkeleton;
+    Skeleton waveOnly = bindSkeleton;
+    std::vector<NodeAnimationCursor> cursors;
+    ApplyAnimation(walkOnly, walkClip.binding, 0.5f, cursors);
+    cursors.clear();
+    ApplyAnimation(waveOnly, waveClip.binding, 0.5f, cursors);
+    bool layered = true;
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      const QuaternionTransform &expected = upperBody[j] > 0.0f ? waveOnly.transforms[j] : walkOnly.transforms[j];
+      layered = layered && Distance(actual.transforms[j].translate, expected.translate) < 1.0e-5 &&
+                RotationAngle(actual.transforms[j].rotate, expected.rotate) < 1.0e-3;
+    }
+    check("masked override layer", layered);
+
+    // 先頭フレームから動かないクリップを加算しても変わらない
+    uint32_t additive = controller.AddLayer(AnimationController::BlendMode::Additive, 0.8f);
+    controller.Play(stillClip, 0.0f, additive);
+    Skeleton withAdditive = bindSkeleton;
+    controller.Evaluate(withAdditive);
+    bool unchanged = true;
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      unchanged = unchanged &&
+                  Distance(withAdditive.transforms[j].translate, actual.transforms[j].translate) < 1.0e-5 &&
+                  RotationAngle(withAdditive.transforms[j].rotate, actual.transforms[j].rotate) < 1.0e-3;
+    }
+    check("still additive layer", unchanged);
+
+    // レイヤーをフェードアウトで止める
+    controller.Stop(upper, 0.2f);
+    controller.Update(0.3f);
+    controller.Evaluate(actual);
+    controller.Stop(additive);
+    controller.Evaluate(actual);
+    cursors.clear();
+    ApplyAnimation(walkOnly, walkClip.binding, controller.GetLayerTime(0), cursors);
+    check("stopped layers", SameTransforms(walkOnly, actual));
+  }
+
+  {
+    // 加算レイヤーのクロスフェード：差分はクリップごとに自分の先頭フレームから取るので、切り替えた瞬間は姿勢が跳ばない
+    AnimationController controller;
+    controller.Initialize(bindSkeleton);
+    controller.Play(walkClip);
+    uint32_t additive = controller.AddLayer(AnimationController::BlendMode::Additive);
+    controller.Play(waveClip, 0.0f, additive);
+    controller.Update(0.5f);
+    Skeleton before = bindSkeleton;
+    controller.Evaluate(before);
+    controller.Play(runClip, 0.5f, additive);
+    Skeleton after = bindSkeleton;
+    controller.Evaluate(after);
+    bool continuous = true;
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      continuous = continuous && Distance(after.transforms[j].translate, before.transforms[j].translate) < 1.0e-5 &&
+                   RotationAngle(after.transforms[j].rotate, before.transforms[j].rotate) < 1.0e-3;
+    }
+    check("additive cross-fade starts from the current pose", continuous);
+  }
+
+  {
+    // TaskPool：全部の番号がちょうど1回ずつ回る。中から呼んでも止まらない
+    TaskPool pool;
+    pool.Initialize(3);
+    std::vector<std::atomic<int>> visits(1000);
+    pool.ParallelFor(visits.size(), 7, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        visits[i].fetch_add(1);
+        pool.ParallelFor(2, 1, [](size_t, size_t) {});
+      }
+    });
+    bool once = true;
+    for (const std::atomic<int> &visit : visits) {
+      once = once && visit.load() == 1;
+    }
+    check("parallel for visits each index once", once);
+    pool.Shutdown();
+    check("pool shutdown", pool.GetWorkerCount() == 0);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // 200 体：歩き→走りのクロスフェード中＋上半身の別クリップ＋呼吸の加算
+  std::vector<AnimationController> controllers(kCharacterCount);
+  std::vector<Skeleton> skeletons(kCharacterCount, bindSkeleton);
+  std::vector<AnimationController *> controllerPointers;
+  std::vector<Skeleton *> skeletonPointers;
+  auto setup = [&] {
+    for (uint32_t i = 0; i < kCharacterCount; ++i) {
+      AnimationController &controller = controllers[i];
+      controller.Initialize(bindSkeleton);
+      controller.Play(walkClip);
+      controller.Update(0.01f * i);
+      // 計測中ずっとフェードが続くように長めにする
+      controller.Play(runClip, 1.0e6f);
+      uint32_t upper = controller.AddLayer(AnimationController::BlendMode::Override, 0.8f);
+      controller.SetLayerMask(upper, upperBody);
+      controller.Play(waveClip, 0.0f, upper);
+      uint32_t breath = controller.AddLayer(AnimationController::BlendMode::Additive, 0.5f);
+      controller.Play(breatheClip, 0.0f, breath);
+    }
+  };
+  setup();
+  for (uint32_t i = 0; i < kCharacterCount; ++i) {
+    controllerPointers.push_back(&controllers[i]);
+    skeletonPointers.push_back(&skeletons[i]);
+  }
+
+  runner.Run("AnimationBlend/200 characters serial(3 layers, crossfade)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kCharacterCount; ++i) {
+      controllers[i].Update(kFrameTime);
+      controllers[i].Evaluate(skeletons[i]);
+    }
+    Benchmark::DoNotOptimize(skeletons.data());
+  });
+
+  // 並列版が直列と同じ結果になることも確かめておく
+  setup();
+  std::vector<Skeleton> serialResult = skeletons;
+  for (uint32_t i = 0; i < kCharacterCount; ++i) {
+    controllers[i].Update(kFrameTime);
+    controllers[i].Evaluate(serialResult[i]);
+  }
+  setup();
+  TaskPool::GetInstance()->Initialize();
+  AnimationController::UpdateAndEvaluateParallel(controllerPointers, skeletonPointers, kFrameTime);
+  bool parallelSame = true;
+  for (uint32_t i = 0; i < kCharacterCount; ++i) {
+    parallelSame = parallelSame && SameTransforms(serialResult[i], skeletons[i]);
+  }
+  if (!parallelSame) {
+    std::fprintf(stderr, "[AnimationBlend] parallel result differs from serial\n");
+    return 1;
+  }
+  std::printf("TaskPool workers: %u (+ calling thread)\n", TaskPool::GetInstance()->GetWorkerCount());
+
+  runner.Run("AnimationBlend/200 characters TaskPool(3 layers, crossfade)", [&](uint64_t) {
+    AnimationController::UpdateAndEvaluateParallel(controllerPointers, skeletonPointers, kFrameTime);
+    Benchmark::DoNotOptimize(skeletons.data());
+  });
+  TaskPool::GetInstance()->Shutdown();
+
+  // ブレンド1回分（70 Joint）：SoA の Blend と、Joint ごとに Slerp する素朴な書き方
+  const PoseBuffer a = RandomPose(20);
+  const PoseBuffer b = RandomPose(21);
+  PoseBuffer out;
+  runner.Run("AnimationBlend/PoseBlend::Blend(70 joints)", [&](uint64_t iteration) {
+    PoseBlend::Blend(a, b, static_cast<float>(iteration % 100) * 0.01f, nullptr, out);
+    Benchmark::DoNotOptimize(out.rotateW.data());
+  });
+  std::vector<QuaternionTransform> aos(kJointCount);
+  runner.Run("AnimationBlend/Per-joint Lerp+Slerp(70 joints)", [&](uint64_t iteration) {
+    float t = static_cast<float>(iteration % 100) * 0.01f;
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      QuaternionTransform ta = a.GetJoint(j), tb = b.GetJoint(j);
+      aos[j].translate = Lerp(ta.translate, tb.translate, t);
+      aos[j].rotate = Slerp(ta.rotate, tb.rotate, t);
+      aos[j].scale = Lerp(ta.scale, tb.scale, t);
+    }
+    Benchmark::DoNotOptimize(aos.data());
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
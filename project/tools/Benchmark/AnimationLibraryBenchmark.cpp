@@ -0,0 +1,289 @@
+// アニメーションキャッシュ（AnimationCache）の往復確認と、AnimationSet の引き方・読み込み時間のベンチマーク
+// 同梱の AnimatedCube/AnimatedCube.gltf と human/sneakWalk.gltf を GltfReader で読んで AnimationSet を作り、
+// クリップの数・名前・長さとキャッシュの往復を確かめる（Assimp での取り込みは Windows 上で AnimationLibrary のログ
+// "imported with Assimp" / "animation cache hit" で比べる）
+// 名前の重なりなど同梱のファイルにない場合は、idle / walk / attack / hit が入ったキャラクターを想定したクリップで確かめる
+//
+// ビルド例（Linux, project/ ディレクトリで実行。モデルは Application/resources から読む）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o animation_library_benchmark tools/Benchmark/AnimationLibraryBenchmark.cpp
+//       Engine/src/Render/Model/AnimationCache.cpp Engine/src/Render/Model/AnimationSet.cpp
+//       Engine/src/Render/Model/MeshCache.cpp Engine/src/Render/Model/CompressedAnimation.cpp
+//       Engine/src/Render/Model/AnimationSampler.cpp Engine/src/Render/Model/ModelAssetData.cpp
+//       Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./animation_library_benchmark --out animation_library_baseline.json
+//   ./animation_library_benchmark --baseline animation_library_baseline.json
+#include "BenchmarkCommon.h"
+#include "GltfReader.h"
+#include "Model/AnimationCache.h"
+#include "Model/AnimationSet.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace fs = std::filesystem;
+
+// Logger は Windows に依存するので、ここでは標準エラーへ流す（計測中は黙らせる）
+namespace {
+bool gQuietLog = false;
+}
+namespace Logger {
+void Log(const std::string &message) {
+  if (!gQuietLog) {
+    std::fputs(message.c_str(), stderr);
+  }
+}
+} // namespace Logger
+
+namespace {
+
+const char *kAnimatedCubePath = "Application/resources/AnimatedCube/AnimatedCube.gltf";
+const char *kHumanPath = "Application/resources/human/sneakWalk.gltf";
+
+constexpr uint32_t kJointCount = 64;
+constexpr float kKeysPerSecond = 30.0f;
+
+// 30fps でベイクされたクリップ
+Animation MakeClip(float seconds, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+  Animation animation;
+  animation.duration = seconds;
+  const uint32_t keyCount = static_cast<uint32_t>(seconds * kKeysPerSecond) + 1;
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    NodeAnimation &node = animation.nodeAnimations["mixamorig:joint" + std::to_string(j)];
+    const float frequency = 1.0f + unit(rng);
+    for (uint32_t k = 0; k < keyCount; ++k) {
+      float time = std::min(static_cast<float>(k) / kKeysPerSecond, seconds);
+      float angle = std::sin(time * frequency) * 0.8f;
+      node.rotate.keyframes.push_back({time, {0.0f, std::sin(angle * 0.5f), 0.0f, std::cos(angle * 0.5f)}});
+      node.translate.keyframes.push_back({time, {unit(rng) * 0.01f, 1.0f, 0.0f}});
+      // 一定のスケールはキー1つだけのことが多い
+      if (k == 0) {
+        node.scale.keyframes.push_back({time, {1.0f, 1.0f, 1.0f}});
+      }
+    }
+  }
+  return animation;
+}
+
+std::vector<NamedAnimation> MakeCharacterClips() {
+  return {
+      {"idle", MakeClip(4.0f, 1)},
+      {"walk", MakeClip(1.2f, 2)},
+      {"attack", MakeClip(0.9f, 3)},
+      {"hit", MakeClip(0.5f, 4)},
+  };
+}
+
+template <typename T> bool SameKeys(const std::vector<Keyframe<T>> &a, const std::vector<Keyframe<T>> &b) {
+  return a.size() == b.size() &&
+         (a.empty() || std::memcmp(a.data(), b.data(), sizeof(Keyframe<T>) * a.size()) == 0);
+}
+
+bool SameAnimation(const Animation &a, const Animation &b) {
+  if (a.duration != b.duration || a.nodeAnimations.size() != b.nodeAnimations.size()) {
+    return false;
+  }
+  for (auto itA = a.nodeAnimations.begin(), itB = b.nodeAnimations.begin(); itA != a.nodeAnimations.end();
+       ++itA, ++itB) {
+    if (itA->first != itB->first || !SameKeys(itA->second.translate.keyframes, itB->second.translate.keyframes) ||
+        !SameKeys(itA->second.rotate.keyframes, itB->second.rotate.keyframes) ||
+        !SameKeys(itA->second.scale.keyframes, itB->second.scale.keyframes)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// AnimationLibrary が Assimp で取り込んだときと同じく、ファイル内の全クリップを名前付きで取り出す
+bool ReadClips(const std::string &path, std::vector<NamedAnimation> &clips) {
+  GltfReader reader;
+  if (!reader.Open(path)) {
+    std::fprintf(stderr, "[AnimationLibrary] cannot open %s (run from project/)\n", path.c_str());
+    return false;
+  }
+  GltfModel model = reader.Read();
+  clips.clear();
+  for (size_t i = 0; i < model.animations.size(); ++i) {
+    clips.push_back({model.animationNames[i], std::move(model.animations[i])});
+  }
+  return true;
+}
+
+bool SameClips(const std::vector<NamedAnimation> &a, const std::vector<NamedAnimation> &b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].name != b[i].name || !SameAnimation(a[i].animation, b[i].animation)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "animation_library_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const fs::path root = fs::temp_directory_path() / "animation_library_benchmark";
+  fs::remove_all(root);
+  fs::create_directories(root);
+  MeshCache::SetCacheDirectory((root / "cache").generic_string());
+
+  std::vector<NamedAnimation> cubeClips;
+  std::vector<NamedAnimation> humanClips;
+  if (!ReadClips(kAnimatedCubePath, cubeClips) || !ReadClips(kHumanPath, humanClips)) {
+    return 1;
+  }
+  const std::vector<NamedAnimation> clips = MakeCharacterClips();
+  const MeshCache::Key key{0x5eed1234ull, 0};
+  const std::string cachePath = AnimationCache::GetCachePath("resources/human/character.gltf");
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[AnimationLibrary] %s\n", label);
+      ok = false;
+    }
+  };
+
+  // 同梱のファイル: どちらもクリップは1つ。名前はファイルのまま、長さは最後のキーの時刻
+  {
+    const AnimationSet cube = MakeAnimationSet(kAnimatedCubePath, cubeClips);
+    const AnimationSet human = MakeAnimationSet(kHumanPath, humanClips);
+    check("AnimatedCube clip count", cube.GetCount() == 1 && cube.compressedAnimations.size() == 1);
+    check("AnimatedCube clip name", cube.FindIndex("animation_AnimatedCube") == 0);
+    check("AnimatedCube duration", std::abs(cube.Get(0)->duration - 2.0f) < 1e-4f &&
+                                       cube.GetCompressed(0)->duration == cube.Get(0)->duration);
+    check("AnimatedCube channels", cube.Get(0)->nodeAnimations.size() == 1);
+    check("sneakWalk clip count", human.GetCount() == 1 && human.compressedAnimations.size() == 1);
+    check("sneakWalk clip name", human.FindIndex("Armature|mixamo.com|Layer0") == 0);
+    check("sneakWalk duration", std::abs(human.Get(0)->duration - 0.9f) < 1e-4f &&
+                                    human.GetCompressed(0)->duration == human.Get(0)->duration);
+    check("sneakWalk channels", human.Get(0)->nodeAnimations.size() == 65);
+  }
+
+  // 同梱のファイルのクリップもキャッシュを往復して同じになる
+  for (const auto &[path, fileClips] : {std::pair{kAnimatedCubePath, &cubeClips}, std::pair{kHumanPath, &humanClips}}) {
+    const std::string fileCachePath = AnimationCache::GetCachePath(path);
+    std::vector<NamedAnimation> fileLoaded;
+    check("save gltf clips", AnimationCache::Save(fileCachePath, key, *fileClips));
+    check("load gltf clips", AnimationCache::Load(fileCachePath, key, fileLoaded));
+    check("gltf clips round trip", SameClips(*fileClips, fileLoaded));
+  }
+
+  // キャッシュはメッシュのキャッシュと並べて置く
+  check("cache path", cachePath == MeshCache::GetCacheDirectory() + "/resources_human_character.gltf.anim");
+
+  std::vector<NamedAnimation> loaded;
+  check("save", AnimationCache::Save(cachePath, key, clips));
+  check("load", AnimationCache::Load(cachePath, key, loaded));
+  check("round trip", SameClips(clips, loaded));
+
+  const std::vector<NamedAnimation> none;
+  check("save empty", AnimationCache::Save(cachePath + ".empty", key, none));
+  check("empty round trip", AnimationCache::Load(cachePath + ".empty", key, loaded) && loaded.empty());
+
+  // キーが違う・ファイルがない・壊れている場合は読まない
+  check("reject hash", !AnimationCache::Load(cachePath, {key.sourceHash + 1, 0}, loaded));
+  check("reject missing", !AnimationCache::Load(cachePath + ".none", key, loaded));
+  {
+    fs::copy_file(cachePath, cachePath + ".cut");
+    fs::resize_file(cachePath + ".cut", fs::file_size(cachePath) - 3);
+    check("reject truncated", !AnimationCache::Load(cachePath + ".cut", key, loaded));
+
+    fs::copy_file(cachePath, cachePath + ".old");
+    std::fstream file(cachePath + ".old", std::ios::in | std::ios::out | std::ios::binary);
+    uint32_t version = AnimationCache::kVersion + 1;
+    file.seekp(4);
+    file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    file.close();
+    check("reject version", !AnimationCache::Load(cachePath + ".old", key, loaded));
+  }
+  check("failed load keeps output", loaded.empty());
+
+  // 名前と番号で引ける。名前の重なり・空の名前も扱える
+  std::vector<NamedAnimation> withDuplicates = clips;
+  withDuplicates.push_back({"walk", MakeClip(2.0f, 5)});
+  withDuplicates.push_back({"", MakeClip(1.0f, 6)});
+  const AnimationSet set = MakeAnimationSet("resources/human/character.gltf", withDuplicates);
+  check("count", set.GetCount() == 6 && set.compressedAnimations.size() == 6);
+  check("find by name", set.FindIndex("attack") == 2 && set.Find("attack") == set.Get(2) &&
+                            SameAnimation(*set.Find("attack"), clips[2].animation));
+  check("find compressed", set.FindCompressed("hit") == set.GetCompressed(3) &&
+                               set.GetCompressed(3)->duration == clips[3].animation.duration);
+  check("duplicate keeps first", set.FindIndex("walk") == 1 && set.names[4] == "walk" &&
+                                     set.Get(4)->duration == 2.0f);
+  check("unnamed clip", set.FindIndex("Animation5") == 5);
+  check("missing clip", set.FindIndex("run") == -1 && !set.Find("run") && !set.FindCompressed("run") &&
+                            !set.Get(6) && !set.GetCompressed(6));
+  if (!ok) {
+    return 1;
+  }
+
+  size_t keyCount = 0;
+  for (const NamedAnimation &clip : clips) {
+    for (const auto &[name, node] : clip.animation.nodeAnimations) {
+      keyCount += node.translate.keyframes.size() + node.rotate.keyframes.size() + node.scale.keyframes.size();
+    }
+  }
+  std::printf("%zu clips, %u joints, %zu keys, cache %.1f KB\n\n", clips.size(), kJointCount, keyCount,
+              fs::file_size(cachePath) / 1024.0);
+
+  //=========================
+  // 計測
+  //=========================
+  gQuietLog = true;
+  runner.Run("AnimationLibrary/AnimationCache::Load(4 clips)", [&](uint64_t) {
+    std::vector<NamedAnimation> data;
+    bool r = AnimationCache::Load(cachePath, key, data);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  const std::string humanCachePath = AnimationCache::GetCachePath(kHumanPath);
+  runner.Run("AnimationLibrary/AnimationCache::Load(sneakWalk.gltf)", [&](uint64_t) {
+    std::vector<NamedAnimation> data;
+    bool r = AnimationCache::Load(humanCachePath, key, data);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("AnimationLibrary/AnimationCache::Save(4 clips)", [&](uint64_t) {
+    bool r = AnimationCache::Save(cachePath, key, clips);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("AnimationLibrary/MakeAnimationSet(4 clips)", [&](uint64_t) {
+    AnimationSet made = MakeAnimationSet("character.gltf", clips);
+    Benchmark::DoNotOptimize(made.animations.data());
+  });
+
+  // 以前はインスタンスごとに Animation をコピーして持っていた（いまは共有した AnimationSet を引くだけ）
+  runner.Run("AnimationLibrary/Copy Animation(per instance)", [&](uint64_t) {
+    Animation copy = *set.Get(1);
+    Benchmark::DoNotOptimize(copy.duration);
+  });
+
+  const char *names[] = {"idle", "walk", "attack", "hit"};
+  runner.Run("AnimationLibrary/AnimationSet::Find", [&](uint64_t iteration) {
+    const Animation *animation = set.Find(names[iteration & 3]);
+    Benchmark::DoNotOptimize(animation);
+  });
+
+  fs::remove_all(root);
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+// キーフレームのカーソル付きサンプリング（SampleKeyframes）の確認とベンチマーク
+// 長いクリップでは、毎回先頭から探す CalculateValue は再生位置が後ろになるほど遅くなる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o animation_sampler_benchmark tools/Benchmark/AnimationSamplerBenchmark.cpp
+//       Engine/src/Render/Model/AnimationSampler.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./animation_sampler_benchmark --out animation_sampler_baseline.json
+//   ./animation_sampler_benchmark --baseline animation_sampler_baseline.json
+#include "BenchmarkCommon.h"
+#include "Math/MathUtil.h"
+#include "Model/AnimationSampler.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kJointCount = 64;        // human 程度の Joint 数
+constexpr float kClipSeconds = 60.0f;       // 長いクリップ
+constexpr float kKeysPerSecond = 30.0f;     // ベイクされたクリップのキー密度
+constexpr float kFrameSeconds = 1.0f / 60.0f;
+
+struct Channel {
+  std::vector<KeyframeVector3> translate;
+  std::vector<KeyframeQuaternion> rotate;
+  std::vector<KeyframeVector3> scale;
+};
+
+// キー間隔が少しずつ揺れる、時刻順のキーフレーム
+template <typename tValue, typename MakeValue>
+std::vector<Keyframe<tValue>> MakeKeys(std::mt19937 &rng, uint32_t count, MakeValue makeValue) {
+  std::uniform_real_distribution<float> jitter(0.5f, 1.5f);
+  std::vector<Keyframe<tValue>> keys(count);
+  float step = kClipSeconds / static_cast<float>(count > 1 ? count - 1 : 1);
+  float time = 0.0f;
+  for (uint32_t i = 0; i < count; ++i) {
+    keys[i] = {time, makeValue(i)};
+    time += step * jitter(rng);
+  }
+  return keys;
+}
+
+std::vector<Channel> MakeClip(uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  const uint32_t keyCount = static_cast<uint32_t>(kClipSeconds * kKeysPerSecond);
+  std::vector<Channel> clip(kJointCount);
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    Channel &channel = clip[j];
+    channel.translate = MakeKeys<Vector3>(rng, keyCount, [&](uint32_t) {
+      return Vector3{unit(rng), unit(rng), unit(rng)};
+    });
+    channel.rotate = MakeKeys<Quaternion>(rng, keyCount, [&](uint32_t) {
+      Quaternion q{unit(rng), unit(rng), unit(rng), unit(rng)};
+      float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+      return Quaternion{q.x / length, q.y / length, q.z / length, q.w / length};
+    });
+    // スケールはキーが1つだけのことが多い
+    channel.scale = MakeKeys<Vector3>(rng, 1, [](uint32_t) { return Vector3{1.0f, 1.0f, 1.0f}; });
+  }
+  return clip;
+}
+
+template <typename T> bool SameBits(const T &a, const T &b) { return std::memcmp(&a, &b, sizeof(T)) == 0; }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "animation_sampler_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const std::vector<Channel> clip = MakeClip(7);
+
+  //=========================
+  // 動作確認（CalculateValue とビット単位で一致すること）
+  //=========================
+  bool ok = true;
+  uint64_t mismatches = 0;
+  auto compare = [&](const std::vector<KeyframeVector3> &keys, float time, KeyframeCursor &cursor) {
+    if (!SameBits(SampleKeyframes(keys, time, cursor), CalculateValue(keys, time))) {
+      ++mismatches;
+    }
+  };
+  auto compareQ = [&](const std::vector<KeyframeQuaternion> &keys, float time,
+                      KeyframeCursor &cursor) {
+    if (!SameBits(SampleKeyframes(keys, time, cursor), CalculateValue(keys, time))) {
+      ++mismatches;
+    }
+  };
+
+  {
+    // 順再生（fmod でのループを含む）・逆再生・ランダムなシーク・キーちょうどの時刻
+    std::vector<float> times;
+    for (float t = -0.5f; t < kClipSeconds * 2.5f; t += kFrameSeconds) {
+      times.push_back(std::fmod(std::fmax(t, 0.0f), kClipSeconds + 1.0f) - 0.25f);
+    }
+    for (float t = kClipSeconds + 1.0f; t > -1.0f; t -= kFrameSeconds * 7.0f) {
+      times.push_back(t);
+    }
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> anywhere(-1.0f, kClipSeconds + 1.0f);
+    for (int i = 0; i < 2000; ++i) {
+      times.push_back(anywhere(rng));
+    }
+    for (size_t k = 0; k < clip[0].translate.size(); k += 13) {
+      times.push_back(clip[0].translate[k].time);
+    }
+
+    for (const Channel &channel : clip) {
+      NodeAnimationCursor cursor;
+      for (float time : times) {
+        compare(channel.translate, time, cursor.translate);
+        compareQ(channel.rotate, time, cursor.rotate);
+        compare(channel.scale, time, cursor.scale);
+      }
+    }
+
+    // 同じ時刻のキーが並ぶ場合（最初に見つかる区間を使う）
+    std::vector<KeyframeVector3> duplicated = {
+        {0.0f, {0, 0, 0}}, {1.0f, {1, 0, 0}}, {1.0f, {2, 0, 0}}, {2.0f, {3, 0, 0}}, {2.0f, {4, 0, 0}}};
+    KeyframeCursor cursor;
+    for (float time : {0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 1.0f, 0.0f, 1.25f}) {
+      compare(duplicated, time, cursor);
+    }
+  }
+  if (mismatches != 0) {
+    std::fprintf(stderr, "[AnimationSampler] %llu samples differ from CalculateValue\n",
+                 static_cast<unsigned long long>(mismatches));
+    ok = false;
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // 1フレーム分（全 Joint × 3 チャンネル）。再生位置はクリップの先頭から末尾まで順に進める
+  const uint32_t frameCount = static_cast<uint32_t>(kClipSeconds / kFrameSeconds);
+  auto frameTime = [&](uint64_t iteration) {
+    return static_cast<float>(iteration % frameCount) * kFrameSeconds;
+  };
+
+  runner.Run("AnimationSampler/CalculateValue(64 joints, 60s clip)", [&](uint64_t iteration) {
+    float time = frameTime(iteration);
+    float sum = 0.0f;
+    for (const Channel &channel : clip) {
+      sum += CalculateValue(channel.translate, time).x;
+      sum += CalculateValue(channel.rotate, time).w;
+      sum += CalculateValue(channel.scale, time).y;
+    }
+    Benchmark::DoNotOptimize(sum);
+  });
+
+  std::vector<NodeAnimationCursor> cursors(clip.size());
+  runner.Run("AnimationSampler/SampleKeyframes(64 joints, 60s clip)", [&](uint64_t iteration) {
+    float time = frameTime(iteration);
+    float sum = 0.0f;
+    for (size_t j = 0; j < clip.size(); ++j) {
+      sum += SampleKeyframes(clip[j].translate, time, cursors[j].translate).x;
+      sum += SampleKeyframes(clip[j].rotate, time, cursors[j].rotate).w;
+      sum += SampleKeyframes(clip[j].scale, time, cursors[j].scale).y;
+    }
+    Benchmark::DoNotOptimize(sum);
+  });
+
+  // 毎回ランダムにシークする最悪ケース（二分探索になる）
+  std::vector<float> seeks(4096);
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> anywhere(0.0f, kClipSeconds);
+  for (float &seek : seeks) {
+    seek = anywhere(rng);
+  }
+  runner.Run("AnimationSampler/SampleKeyframes(random seek)", [&](uint64_t iteration) {
+    float time = seeks[iteration % seeks.size()];
+    float sum = 0.0f;
+    for (size_t j = 0; j < clip.size(); ++j) {
+      sum += SampleKeyframes(clip[j].translate, time, cursors[j].translate).x;
+      sum += SampleKeyframes(clip[j].rotate, time, cursors[j].rotate).w;
+      sum += SampleKeyframes(clip[j].scale, time, cursors[j].scale).y;
+    }
+    Benchmark::DoNotOptimize(sum);
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// アセット索引（AssetIndex）と従来のディレクトリ走査によるパス解決の比較
+// 一時ディレクトリに数千ファイルのツリーを作って計測する
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -Iexternals -o asset_index_benchmark
+//       tools/Benchmark/AssetIndexBenchmark.cpp Engine/src/Util/AssetIndex.cpp
+//
+// 実行例:
+//   ./asset_index_benchmark --out asset_index_baseline.json
+//   ./asset_index_benchmark --baseline asset_index_baseline.json
+#include "BenchmarkCommon.h"
+#include "Util/AssetIndex.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Logger は Windows に依存するので、ここでは標準エラーへ流す（計測中は黙らせる）
+namespace {
+bool gQuietLog = false;
+}
+namespace Logger {
+void Log(const std::string &message) {
+  if (!gQuietLog) {
+    std::fputs(message.c_str(), stderr);
+  }
+}
+} // namespace Logger
+
+namespace {
+
+constexpr uint32_t kDirectoryCount = 64;    // モデル・テクスチャ・設定などのフォルダ
+constexpr uint32_t kFilesPerDirectory = 64; // 合計で 4096 ファイル程度
+
+// 変更前の ModelManager::ResolveModelPath と同じ処理
+std::string LegacyResolve(const fs::path &base, const std::string &input) {
+  if (input.find('/') != std::string::npos || input.find('\\') != std::string::npos) {
+    return input;
+  }
+  if (fs::exists(base)) {
+    for (const auto &e : fs::recursive_directory_iterator(base)) {
+      if (!e.is_regular_file()) {
+        continue;
+      }
+      if (e.path().filename() == input) {
+        return e.path().generic_string();
+      }
+    }
+  }
+  return input;
+}
+
+void Touch(const fs::path &path) {
+  fs::create_directories(path.parent_path());
+  std::ofstream(path) << "x";
+}
+
+// resources 相当のツリーを作る（深さ1～2、最後のフォルダに弾のモデルを置く）
+void CreateTree(const fs::path &root) {
+  fs::remove_all(root);
+  for (uint32_t d = 0; d < kDirectoryCount; ++d) {
+    fs::path dir = root / ("dir" + std::to_string(d));
+    if (d % 4 == 0) {
+      dir /= "sub";
+    }
+    for (uint32_t f = 0; f < kFilesPerDirectory; ++f) {
+      Touch(dir / ("asset_" + std::to_string(d) + "_" + std::to_string(f) + ".png"));
+    }
+  }
+  Touch(root / "zz_models" / "suzanne" / "suzanne.obj");
+  // 同名ファイル（曖昧なケース）
+  Touch(root / "dir1" / "common.obj");
+  Touch(root / "dir2" / "common.obj");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "asset_index_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const fs::path root = fs::temp_directory_path() / "asset_index_benchmark";
+  CreateTree(root);
+  const std::string rootString = root.generic_string();
+
+  AssetIndex index;
+  index.Build(rootString);
+  std::printf("indexed %zu files under %s\n", index.GetFileCount(), rootString.c_str());
+
+  //=========================
+  // 動作確認
+  //=========================
+  // 1. 一意なファイル名は従来と同じパスになる
+  // 2. 見つからない名前・パス指定は従来どおりそのまま返る
+  // 3. ルートからの相対パスは実パスになる
+  // 4. 同名ファイルは候補がすべて取れて、辞書順の先頭が選ばれる
+  bool ok = true;
+  auto expect = [&](const std::string &label, const std::string &actual,
+                    const std::string &expected) {
+    if (actual != expected) {
+      std::fprintf(stderr, "[AssetIndex] %s: %s != %s\n", label.c_str(), actual.c_str(),
+                   expected.c_str());
+      ok = false;
+    }
+  };
+  const std::vector<std::string> names = {"suzanne.obj", "asset_0_0.png", "asset_33_17.png",
+                                          "asset_63_63.png", "missing.obj"};
+  for (const std::string &name : names) {
+    expect(name, index.Resolve(name), LegacyResolve(root, name));
+  }
+  expect("path", index.Resolve("resources/suzanne.obj"), "resources/suzanne.obj");
+  expect("relative", index.Resolve("zz_models/suzanne/suzanne.obj"),
+         rootString + "/zz_models/suzanne/suzanne.obj");
+  expect("relative(\\)", index.Resolve("zz_models\\suzanne\\suzanne.obj"),
+         rootString + "/zz_models/suzanne/suzanne.obj");
+  expect("ambiguous", index.Resolve("common.obj"), rootString + "/dir1/common.obj");
+  if (!index.IsAmbiguous("common.obj") || index.FindCandidates("common.obj").size() != 2) {
+    std::fprintf(stderr, "[AssetIndex] ambiguous candidates not reported\n");
+    ok = false;
+  }
+
+  // 5. ファイルを追加しても Refresh するまでは索引は変わらない
+  Touch(root / "dir5" / "added.obj");
+  expect("before refresh", index.Resolve("added.obj"), "added.obj");
+  index.Refresh();
+  expect("after refresh", index.Resolve("added.obj"), rootString + "/dir5/added.obj");
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // 弾を1発撃つごとに SetModel("suzanne.obj") で LoadModel と FindModel が呼ばれる
+  runner.Run("ResolveModelPath/LegacyWalk", [&](uint64_t) {
+    std::string r = LegacyResolve(root, "suzanne.obj");
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("ResolveModelPath/LegacyWalk(miss)", [&](uint64_t) {
+    std::string r = LegacyResolve(root, "missing.obj");
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("ResolveModelPath/AssetIndex", [&](uint64_t) {
+    std::string r = index.Resolve("suzanne.obj");
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("ResolveModelPath/AssetIndex(miss)", [&](uint64_t) {
+    std::string r = index.Resolve("missing.obj");
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("ResolveModelPath/AssetIndex(relative)", [&](uint64_t) {
+    std::string r = index.Resolve("zz_models/suzanne/suzanne.obj");
+    Benchmark::DoNotOptimize(r);
+  });
+
+  gQuietLog = true;
+  runner.Run("AssetIndex/Build", [&](uint64_t) {
+    AssetIndex rebuilt;
+    rebuilt.Build(rootString);
+    Benchmark::DoNotOptimize(rebuilt.GetFileCount());
+  });
+
+  fs::remove_all(root);
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+// AsyncLoader（ワーカーでの読み込み・デコードと、メインスレッドでの後処理）の確認とベンチマーク
+// D3D12 / WIC / Media Foundation はこの環境にないため、ファイル読み込みを待ち時間＋デコード処理で、
+// GPU 転送を「メインスレッドでしか触ってはいけないバッファ」へのコピーで置き換えて確かめる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -pthread -IEngine/include -IEngine/include/Render -Iexternals
+//       -o async_loader_benchmark tools/Benchmark/AsyncLoaderBenchmark.cpp
+//       Engine/src/Util/AsyncLoader.cpp
+//
+// 実行例:
+//   ./async_loader_benchmark --out async_loader_baseline.json
+//   ./async_loader_benchmark --baseline async_loader_baseline.json
+#include "BenchmarkCommon.h"
+#include "Util/AsyncLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Logger は Windows に依存するので、ここでは標準エラーへ流す（失敗ケースの確認中は黙らせる）
+namespace {
+bool gQuietLog = false;
+}
+namespace Logger {
+void Log(const std::string &message) {
+  if (!gQuietLog) {
+    std::fputs(message.c_str(), stderr);
+  }
+}
+} // namespace Logger
+
+namespace {
+
+constexpr uint32_t kAssetCount = 24;                           // シーン1つ分のアセット数
+constexpr auto kReadLatency = std::chrono::microseconds(1500); // ファイル読み込みの待ち時間
+constexpr size_t kDecodedSize = 64 * 1024;                     // デコード後のサイズ
+
+// ファイル読み込み（待ち時間）とデコード（CPU 処理）の代わり
+std::vector<uint32_t> DecodeAsset(uint32_t seed) {
+  std::this_thread::sleep_for(kReadLatency);
+  std::vector<uint32_t> pixels(kDecodedSize / sizeof(uint32_t));
+  uint32_t state = seed * 2654435761u + 1u;
+  for (uint32_t &pixel : pixels) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    pixel = state;
+  }
+  return pixels;
+}
+
+// GPU 転送の代わり。メインスレッド以外から触ったら記録する
+struct FakeGpu {
+  std::thread::id owner = std::this_thread::get_id();
+  std::unordered_map<std::string, std::vector<uint32_t>> resources;
+  uint32_t offThreadUploads = 0;
+
+  void Upload(const std::string &name, const std::vector<uint32_t> &pixels) {
+    if (std::this_thread::get_id() != owner) {
+      ++offThreadUploads;
+    }
+    resources[name] = pixels;
+  }
+};
+
+// TextureManager::LoadTextureAsync と同じ形（プレースホルダーを返しつつ、届いたら差し替える）
+struct FakeTextureManager {
+  FakeGpu *gpu = nullptr;
+  std::unordered_map<std::string, LoadHandle> pending{};
+
+  LoadHandle LoadAsync(AsyncLoader &loader, const std::string &name, uint32_t seed,
+                       bool fail = false) {
+    if (auto it = pending.find(name); it != pending.end()) {
+      return it->second;
+    }
+    if (gpu->resources.contains(name)) {
+      return AsyncLoader::MakeReady(name);
+    }
+    auto decoded = std::make_shared<std::vector<uint32_t>>();
+    LoadHandle handle = loader.Submit(
+        name,
+        [decoded, seed, fail] {
+          *decoded = DecodeAsset(seed);
+          if (fail) {
+            throw std::runtime_error("decode failed");
+          }
+        },
+        [this, name, decoded](bool succeeded) {
+          pending.erase(name);
+          if (succeeded) {
+            gpu->Upload(name, *decoded);
+          }
+        });
+    pending.emplace(name, handle);
+    return handle;
+  }
+
+  // 読み込み中はプレースホルダーを返す
+  const char *Resolve(const std::string &name) const {
+    if (gpu->resources.contains(name)) {
+      return name.c_str();
+    }
+    return pending.contains(name) ? "white1x1" : nullptr;
+  }
+};
+
+std::string AssetName(uint32_t index) { return "resources/asset" + std::to_string(index) + ".png"; }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "async_loader_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[AsyncLoader] %s\n", label);
+      ok = false;
+    }
+  };
+
+  {
+    AsyncLoader loader;
+    loader.Initialize(4);
+    FakeGpu gpu;
+    FakeTextureManager textures{&gpu};
+
+    check("worker count", loader.GetWorkerCount() == 4);
+    check("main thread", loader.IsMainThread());
+
+    LoadHandle first = textures.LoadAsync(loader, AssetName(0), 0);
+    check("duplicate request shares the handle",
+          textures.LoadAsync(loader, AssetName(0), 0).GetName() == first.GetName());
+    check("placeholder while pending", std::string(textures.Resolve(AssetName(0))) == "white1x1");
+
+    // デコードが終わっても、Update を呼ぶまでは転送されない
+    std::this_thread::sleep_for(kReadLatency * 4);
+    check("not uploaded before Update", !gpu.resources.contains(AssetName(0)) && !first.IsDone());
+    while (!first.IsDone()) {
+      loader.Update();
+    }
+    check("ready after Update", first.IsReady());
+    check("resolved after Update", std::string(textures.Resolve(AssetName(0))) == AssetName(0));
+    check("already loaded returns ready",
+          textures.LoadAsync(loader, AssetName(0), 0).IsReady());
+
+    // 失敗したものはプレースホルダーのまま
+    gQuietLog = true;
+    LoadHandle broken = textures.LoadAsync(loader, "resources/broken.png", 1, true);
+    loader.Wait(broken);
+    gQuietLog = false;
+    check("failed state", broken.GetState() == LoadState::Failed);
+    check("failed is not uploaded", textures.Resolve("resources/broken.png") == nullptr);
+
+    // まとめて投げて、1つだけ待つ・全部待つ
+    std::vector<LoadHandle> handles;
+    for (uint32_t i = 1; i < kAssetCount; ++i) {
+      handles.push_back(textures.LoadAsync(loader, AssetName(i), i));
+    }
+    loader.Wait(handles[5]);
+    check("wait for one", handles[5].IsReady());
+    loader.WaitAll();
+    check("wait all", std::all_of(handles.begin(), handles.end(),
+                                  [](const LoadHandle &h) { return h.IsReady(); }));
+    check("pending count", loader.GetPendingCount() == 0 && textures.pending.empty());
+    check("uploads only on main thread", gpu.offThreadUploads == 0);
+    check("decoded data", gpu.resources.at(AssetName(7)) == DecodeAsset(7));
+
+    // 後処理待ちを残したまま止めると、後処理は呼ばれず失敗扱いになる
+    bool finalized = false;
+    LoadHandle dropped = loader.Submit("dropped", [] {}, [&](bool) { finalized = true; });
+    std::this_thread::sleep_for(kReadLatency);
+    loader.Shutdown();
+    check("shutdown drops finalize", !finalized && dropped.GetState() == LoadState::Failed);
+    check("shutdown stops workers", loader.GetWorkerCount() == 0);
+  }
+
+  {
+    // ワーカーなし（Initialize 前）はその場で読み、後処理だけ後回しにする
+    AsyncLoader loader;
+    bool finalized = false;
+    LoadHandle handle = loader.Submit("inline", [] {}, [&](bool succeeded) { finalized = succeeded; });
+    check("inline defers finalize", !finalized && !handle.IsDone());
+    loader.Update();
+    check("inline finalize", finalized && handle.IsReady());
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // シーン読み込み1回分：同期で順に読む場合と、先にまとめて投げて待つ場合
+  runner.Run("AsyncLoader/Serial(24 assets)", [&](uint64_t) {
+    FakeGpu gpu;
+    for (uint32_t i = 0; i < kAssetCount; ++i) {
+      gpu.Upload(AssetName(i), DecodeAsset(i));
+    }
+    Benchmark::DoNotOptimize(gpu.resources.size());
+  });
+
+  AsyncLoader loader;
+  loader.Initialize(4);
+  runner.Run("AsyncLoader/Async(24 assets, 4 workers)", [&](uint64_t) {
+    FakeGpu gpu;
+    FakeTextureManager textures{&gpu};
+    for (uint32_t i = 0; i < kAssetCount; ++i) {
+      textures.LoadAsync(loader, AssetName(i), i);
+    }
+    loader.WaitAll();
+    Benchmark::DoNotOptimize(gpu.resources.size());
+  });
+
+  // 何も届いていないフレームの Update のコスト
+  runner.Run("AsyncLoader/Update(idle)", [&](uint64_t) { Benchmark::DoNotOptimize(loader.Update()); });
+  loader.Shutdown();
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+#pragma once
+// ベンチマーク共通処理（計測・結果出力・ベースライン比較）
+// Windowsヘッダーに依存しないので、Linux上でもそのままビルドできる
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Benchmark {
+
+/// <summary>
+/// 最適化で計算が消されないように値を外部へ逃がす
+/// </summary>
+template <typename T> inline void DoNotOptimize(const T &value) {
+#if defined(_MSC_VER)
+  static const void *volatile sink;
+  sink = &value;
+#else
+  asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/// <summary>
+/// 1項目分の計測結果
+/// </summary>
+struct Result {
+  std::string name;
+  double nsPerCall = 0.0;    // 1回あたりの時間（ナノ秒）
+  double callsPerSec = 0.0;  // スループット（回/秒）
+  uint64_t iterations = 0;   // 1サンプルあたりの呼び出し回数
+};
+
+/// <summary>
+/// 実行オプション
+/// </summary>
+struct Options {
+  std::string outputPath = "benchmark_result.json"; // 結果JSONの出力先
+  std::string baselinePath;                         // 比較対象のJSON（空なら比較しない）
+  std::string filter;                               // 名前に含まれる項目だけ実行
+  double threshold = 10.0;                          // 劣化とみなす割合（%）
+  double minTimeMs = 200.0;                         // 1項目あたりの最低計測時間
+  int samples = 5;                                  // サンプル数（中央値を採用）
+};
+
+inline Options ParseOptions(int argc, char **argv, const std::string &defaultOutput) {
+  Options options;
+  options.outputPath = defaultOutput;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+    if (arg == "--out") {
+      options.outputPath = next();
+    } else if (arg == "--baseline") {
+      options.baselinePath = next();
+    } else if (arg == "--filter") {
+      options.filter = next();
+    } else if (arg == "--threshold") {
+      options.threshold = std::stod(next());
+    } else if (arg == "--min-time") {
+      options.minTimeMs = std::stod(next());
+    } else if (arg == "--samples") {
+      options.samples = std::max(1, std::stoi(next()));
+    } else if (arg == "--help" || arg == "-h") {
+      std::printf("usage: %s [--out file.json] [--baseline file.json] "
+                  "[--threshold pct] [--filter name] [--min-time ms] [--samples n]\n",
+                  argv[0]);
+      std::exit(0);
+    }
+  }
+  return options;
+}
+
+/// <summary>
+/// 計測をまとめて実行し、結果を保持するクラス
+/// </summary>
+class Runner {
+public:
+  explicit Runner(const Options &options) : options_(options) {}
+
+  /// <summary>
+  /// 計測する
+  /// </summary>
+  /// <param name="name">項目名</param>
+  /// <param name="body">呼び出し1回分の処理。引数は通し番号</param>
+  template <typename Body> void Run(const std::string &name, Body &&body) {
+    if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+      return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    // 最低計測時間を満たす回数を探す（ウォームアップも兼ねる）
+    uint64_t iterations = 1;
+    const double targetNs = options_.minTimeMs * 1.0e6 / options_.samples;
+    for (;;) {
+      auto begin = Clock::now();
+      for (uint64_t i = 0; i < iterations; ++i) {
+        body(i);
+      }
+      double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+      if (elapsed >= targetNs || iterations >= (1ull << 32)) {
+        break;
+      }
+      iterations *= 2;
+    }
+
+    // 複数回計測して中央値を採用する
+    std::vector<double> nsPerCall;
+    for (int s = 0; s < options_.samples; ++s) {
+      auto begin = Clock::now();
+      for (uint64_t i = 0; i < iterations; ++i) {
+        body(i);
+      }
+      double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+      nsPerCall.push_back(elapsed / static_cast<double>(iterations));
+    }
+    std::sort(nsPerCall.begin(), nsPerCall.end());
+
+    Result result;
+    result.name = name;
+    result.nsPerCall = nsPerCall[nsPerCall.size() / 2];
+    result.callsPerSec = (result.nsPerCall > 0.0) ? 1.0e9 / result.nsPerCall : 0.0;
+    result.iterations = iterations;
+    results_.push_back(result);
+
+    std::printf("%-36s %10.2f ns/call %12.2f Mcalls/s\n", name.c_str(), result.nsPerCall,
+                result.callsPerSec / 1.0e6);
+  }
+
+  /// <summary>
+  /// 結果をJSONで保存する
+  /// </summary>
+  bool Save() const {
+    nlohmann::json root;
+    root["benchmarks"] = nlohmann::json::array();
+    for (const Result &result : results_) {
+      root["benchmarks"].push_back({{"name", result.name},
+                                    {"ns_per_call", result.nsPerCall},
+                                    {"calls_per_sec", result.callsPerSec},
+                                    {"iterations", result.iterations}});
+    }
+
+    std::ofstream file(options_.outputPath);
+    if (!file.is_open()) {
+      std::fprintf(stderr, "[Benchmark] cannot write %s\n", options_.outputPath.c_str());
+      return false;
+    }
+    file << root.dump(2) << "\n";
+    std::printf("\nresults written to %s\n", options_.outputPath.c_str());
+    return true;
+  }
+
+  /// <summary>
+  /// ベースラインと比較する
+  /// </summary>
+  /// <returns>しきい値を超えて遅くなった項目があれば false</returns>
+  bool CompareWithBaseline() const {
+    if (options_.baselinePath.empty()) {
+      return true;
+    }
+
+    std::ifstream file(options_.baselinePath);
+    if (!file.is_open()) {
+      std::fprintf(stderr, "[Benchmark] baseline not found: %s\n", options_.baselinePath.c_str());
+      return false;
+    }
+
+    nlohmann::json baseline = nlohmann::json::parse(file, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("benchmarks")) {
+      std::fprintf(stderr, "[Benchmark] invalid baseline: %s\n", options_.baselinePath.c_str());
+      return false;
+    }
+
+    std::printf("\ncompare with %s (threshold %.1f%%)\n", options_.baselinePath.c_str(),
+                options_.threshold);
+
+    bool ok = true;
+    for (const Result &result : results_) {
+      const nlohmann::json *found = nullptr;
+      for (const nlohmann::json &entry : baseline["benchmarks"]) {
+        if (entry.value("name", "") == result.name) {
+          found = &entry;
+          break;
+        }
+      }
+      if (!found) {
+        std::printf("%-36s %10s\n", result.name.c_str(), "(new)");
+        continue;
+      }
+
+      double base = found->value("ns_per_call", 0.0);
+      double diff = (base > 0.0) ? (result.nsPerCall - base) / base * 100.0 : 0.0;
+      const char *mark = "";
+      if (diff > options_.threshold) {
+        mark = "  REGRESSION";
+        ok = false;
+      } else if (diff < -options_.threshold) {
+        mark = "  improved";
+      }
+      std::printf("%-36s %10.2f -> %10.2f ns (%+6.1f%%)%s\n", result.name.c_str(), base,
+                  result.nsPerCall, diff, mark);
+    }
+    return ok;
+  }
+
+  const std::vector<Result> &GetResults() const { return results_; }
+
+private:
+  Options options_;
+  std::vector<Result> results_;
+};
+
+} // namespace Benchmark
@@ -0,0 +1,384 @@
+// アニメーション圧縮（AnimationCompression）の誤差・メモリ量・展開速度の確認とベンチマーク
+// 30fps でベイクした想定の合成クリップと、同梱の human/sneakWalk.gltf・human/walk.gltf（60fps）で確かめる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o compressed_animation_benchmark tools/Benchmark/CompressedAnimationBenchmark.cpp
+//       Engine/src/Render/Model/CompressedAnimation.cpp Engine/src/Render/Model/AnimationSampler.cpp
+//       Engine/src/Render/Model/ModelAssetData.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./compressed_animation_benchmark --out compressed_animation_baseline.json
+//   ./compressed_animation_benchmark --baseline compressed_animation_baseline.json
+#include "BenchmarkCommon.h"
+#include "GltfReader.h"
+#include "Math/MathUtil.h"
+#include "Model/AnimationSampler.h"
+#include "Model/CompressedAnimation.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kJointCount = 64;
+constexpr float kKeysPerSecond = 30.0f;
+
+Quaternion AxisAngle(Vector3 axis, float angle) {
+  float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+  float s = std::sin(angle * 0.5f) / length;
+  return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+// 30fps でベイクされたクリップ。Joint によって動き方を変える
+// （ゆっくり回るだけ・位置も動く・一定・細かく震える）
+Animation MakeClip(float seconds, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> speed(0.3f, 2.0f);
+
+  Animation animation;
+  animation.duration = seconds;
+  const uint32_t keyCount = static_cast<uint32_t>(seconds * kKeysPerSecond) + 1;
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    NodeAnimation &node = animation.nodeAnimations["joint" + std::to_string(j)];
+    const Vector3 axis{unit(rng), unit(rng), unit(rng) + 1.5f};
+    const Vector3 offset{unit(rng), unit(rng) + 1.0f, unit(rng)};
+    const float frequency = speed(rng);
+    const uint32_t kind = j % 4;
+    for (uint32_t k = 0; k < keyCount; ++k) {
+      float time = std::min(static_cast<float>(k) / kKeysPerSecond, seconds);
+      float phase = time * frequency;
+      float jitter = (kind == 3) ? 0.02f * unit(rng) : 0.0f;
+      node.rotate.keyframes.push_back({time, AxisAngle(axis, std::sin(phase) * 1.2f + jitter)});
+      Vector3 translate = offset;
+      if (kind == 1 || kind == 3) {
+        translate = {offset.x + std::sin(phase * 1.3f) * 0.5f, offset.y + std::cos(phase) * 0.2f,
+                     offset.z + jitter};
+      }
+      node.translate.keyframes.push_back({time, translate});
+      if (kind != 2) {
+        node.scale.keyframes.push_back({time, {1.0f, 1.0f, 1.0f}});
+      } else {
+        float s = 1.0f + 0.1f * std::sin(phase);
+        node.scale.keyframes.push_back({time, {s, s, s}});
+      }
+    }
+  }
+  return animation;
+}
+
+float Distance(const Vector3 &a, const Vector3 &b) {
+  return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+}
+
+// 2つの回転の差（ラジアン）。acos(dot) は差が小さいと丸めで 0 になるので、double で求める
+// Slerp は角度が小さいと正規化しない線形補間を返すので、長さで割ってから比べる
+float Angle(const Quaternion &a, const Quaternion &b) {
+  double dot = double(a.x) * b.x + double(a.y) * b.y + double(a.z) * b.z + double(a.w) * b.w;
+  double lengthA = std::sqrt(double(a.x) * a.x + double(a.y) * a.y + double(a.z) * a.z + double(a.w) * a.w);
+  double lengthB = std::sqrt(double(b.x) * b.x + double(b.y) * b.y + double(b.z) * b.z + double(b.w) * b.w);
+  return static_cast<float>(2.0 * std::acos(std::fmin(1.0, std::fabs(dot) / (lengthA * lengthB))));
+}
+
+struct Errors {
+  float translate = 0.0f;
+  float rotate = 0.0f;
+  float scale = 0.0f;
+};
+
+// time での元のキーフレーム（CalculateValue）との誤差を errors に足し込む（最大を取る）
+void AccumulateErrors(const Animation &animation, const CompressedAnimation &compressed, float time,
+                      Errors &errors) {
+  for (const auto &[name, node] : animation.nodeAnimations) {
+    QuaternionTransform pose =
+        AnimationCompression::SampleNode(compressed, compressed.FindNode(name), time);
+    if (!node.translate.keyframes.empty()) {
+      errors.translate = std::fmax(errors.translate,
+                                   Distance(pose.translate, CalculateValue(node.translate.keyframes, time)));
+    }
+    if (!node.rotate.keyframes.empty()) {
+      errors.rotate = std::fmax(errors.rotate, Angle(pose.rotate, CalculateValue(node.rotate.keyframes, time)));
+    }
+    if (!node.scale.keyframes.empty()) {
+      errors.scale = std::fmax(errors.scale, Distance(pose.scale, CalculateValue(node.scale.keyframes, time)));
+    }
+  }
+}
+
+// 合成クリップの最大誤差（キーの時刻とランダムな時刻）
+Errors MeasureErrors(const Animation &animation, const CompressedAnimation &compressed,
+                     uint32_t sampleCount) {
+  Errors errors;
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<float> anywhere(0.0f, animation.duration);
+  for (uint32_t i = 0; i < sampleCount; ++i) {
+    float time = (i % 4 == 0) ? static_cast<float>(i / 4) / kKeysPerSecond : anywhere(rng);
+    AccumulateErrors(animation, compressed, std::fmin(time, animation.duration), errors);
+  }
+  return errors;
+}
+
+// 一定の刻みで頭から最後まで見たときの最大誤差（キーの間隔と関係なく、途中の値も確かめる）
+Errors MeasureErrorsEvery(const Animation &animation, const CompressedAnimation &compressed,
+                          float step) {
+  Errors errors;
+  const uint32_t count = static_cast<uint32_t>(animation.duration / step);
+  for (uint32_t i = 0; i <= count; ++i) {
+    AccumulateErrors(animation, compressed, std::fmin(static_cast<float>(i) * step, animation.duration),
+                     errors);
+  }
+  return errors;
+}
+
+bool WithinTolerance(const Errors &errors, const AnimationCompression::Settings &settings) {
+  return errors.translate <= settings.translationTolerance &&
+         errors.rotate <= settings.rotationTolerance && errors.scale <= settings.scaleTolerance;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "compressed_animation_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const AnimationCompression::Settings settings;
+  const Animation clip = MakeClip(20.0f, 1);
+  const CompressedAnimation compressed = AnimationCompression::Compress(clip, settings);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[CompressedAnimation] %s\n", label);
+      ok = false;
+    }
+  };
+
+  // 最小3成分の量子化の往復
+  {
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    float maxAngle = 0.0f;
+    for (int i = 0; i < 100000; ++i) {
+      Quaternion q = AxisAngle({unit(rng), unit(rng), unit(rng) + 0.01f}, unit(rng) * 3.14159f);
+      uint16_t packed[4];
+      AnimationCompression::PackQuaternion(q, packed);
+      maxAngle = std::fmax(maxAngle, Angle(q, AnimationCompression::UnpackQuaternion(packed)));
+    }
+    std::printf("smallest-three round trip: max %.6f rad\n", maxAngle);
+    check("smallest-three precision", maxAngle < 1.0e-4f);
+  }
+
+  // 誤差が許容範囲に収まる
+  {
+    Errors errors = MeasureErrors(clip, compressed, 2000);
+    std::printf("max error: translate %.6f (tol %.4f), rotate %.6f rad (tol %.4f), scale %.6f (tol %.4f)\n",
+                errors.translate, settings.translationTolerance, errors.rotate,
+                settings.rotationTolerance, errors.scale, settings.scaleTolerance);
+    check("translation error bound", errors.translate <= settings.translationTolerance);
+    check("rotation error bound", errors.rotate <= settings.rotationTolerance);
+    check("scale error bound", errors.scale <= settings.scaleTolerance);
+
+    // 許容誤差を広げると小さくなり、誤差もそれに応じて増える（が範囲内）
+    AnimationCompression::Settings loose = settings;
+    loose.translationTolerance *= 20.0f;
+    loose.rotationTolerance *= 20.0f;
+    loose.scaleTolerance *= 20.0f;
+    loose.maxStride = 16;
+    CompressedAnimation looseClip = AnimationCompression::Compress(clip, loose);
+    Errors looseErrors = MeasureErrors(clip, looseClip, 500);
+    check("loose clip is smaller", looseClip.samples.size() < compressed.samples.size());
+    check("loose error bound", looseErrors.translate <= loose.translationTolerance &&
+                                   looseErrors.rotate <= loose.rotationTolerance &&
+                                   looseErrors.scale <= loose.scaleTolerance);
+  }
+
+  // 同梱の 60fps のクリップ（30fps の格子に乗らないキーと、1キーで大きく回るつま先を含む）
+  for (const char *path : {"Application/resources/human/sneakWalk.gltf", "Application/resources/human/walk.gltf"}) {
+    GltfReader reader;
+    if (!reader.Open(path)) {
+      std::fprintf(stderr, "[CompressedAnimation] cannot open %s (run from project/)\n", path);
+      return 1;
+    }
+    const GltfModel model = reader.Read();
+    check("bundled clip loaded", model.animations.size() == 1);
+    if (model.animations.empty()) {
+      continue;
+    }
+    const Animation &animation = model.animations[0];
+    const CompressedAnimation bundled = AnimationCompression::Compress(animation, settings);
+    Errors errors = MeasureErrorsEvery(animation, bundled, 0.0005f);
+    std::printf("%s: %.0f Hz, max error: translate %.6f, rotate %.6f rad, scale %.6f, %.1f KiB -> %.1f KiB\n",
+                path, bundled.sampleRate, errors.translate, errors.rotate, errors.scale,
+                AnimationCompression::GetMemorySize(animation) / 1024.0, bundled.GetMemorySize() / 1024.0);
+    check("bundled clip keeps the source key rate", bundled.sampleRate >= 60.0f);
+    check("bundled clip error bound", WithinTolerance(errors, settings));
+  }
+
+  // 値の範囲が広いトラック（ルートモーション）は 16bit では許容誤差に収まらないので量子化しない
+  {
+    Animation rootMotion;
+    rootMotion.duration = 10.0f;
+    NodeAnimation &root = rootMotion.nodeAnimations["root"];
+    for (int k = 0; k <= 300; ++k) {
+      float time = k / kKeysPerSecond;
+      root.translate.keyframes.push_back({time, {0.0f, std::sin(time * 7.0f) * 0.1f, time * 40.0f}});
+    }
+    CompressedAnimation rootClip = AnimationCompression::Compress(rootMotion, settings);
+    const CompressedAnimation::Track &track = rootClip.nodes[rootClip.FindNode("root")].translate;
+    Errors errors = MeasureErrorsEvery(rootMotion, rootClip, 0.001f);
+    std::printf("root motion (400 units): quantized %d, max error %.6f\n", track.quantized ? 1 : 0,
+                errors.translate);
+    check("wide range falls back to floats", !track.quantized);
+    check("wide range error bound", errors.translate <= settings.translationTolerance);
+    // 合成クリップは範囲が狭いので量子化したまま
+    bool allQuantized = true;
+    for (const CompressedAnimation::NodeTracks &tracks : compressed.nodes) {
+      allQuantized &= tracks.translate.quantized && tracks.rotate.quantized && tracks.scale.quantized;
+    }
+    check("narrow ranges stay quantized", allQuantized);
+  }
+
+  // 65535 を超えるサンプル数（長いクリップを間引かずに持つ）
+  // 時刻の丸めで格子からずれないよう、キーは 1/32 秒刻み（float でちょうど表せる）にする
+  {
+    Animation longNoise;
+    longNoise.duration = 2400.0f;
+    NodeAnimation &node = longNoise.nodeAnimations["noise"];
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int k = 0; k <= 76800; ++k) {
+      node.translate.keyframes.push_back({k / 32.0f, {unit(rng), 0.0f, 0.0f}});
+    }
+    CompressedAnimation noiseClip = AnimationCompression::Compress(longNoise, settings);
+    const CompressedAnimation::Track &track = noiseClip.nodes[0].translate;
+    QuaternionTransform end = AnimationCompression::SampleNode(noiseClip, 0, longNoise.duration);
+    check("more than 65535 samples", track.sampleCount == 76801 &&
+                                         Distance(end.translate, node.translate.keyframes.back().value) <=
+                                             settings.translationTolerance);
+  }
+
+  // 端・範囲外・一定値・キーなし
+  {
+    const NodeAnimation &node = clip.nodeAnimations.at("joint5");
+    int32_t index = compressed.FindNode("joint5");
+    check("find node", index >= 0 && compressed.FindNode("missing") == -1);
+    QuaternionTransform first = AnimationCompression::SampleNode(compressed, index, -1.0f);
+    QuaternionTransform last = AnimationCompression::SampleNode(compressed, index, 100.0f);
+    check("clamp start", Distance(first.translate, node.translate.keyframes.front().value) <=
+                             settings.translationTolerance);
+    check("clamp end", Distance(last.translate, node.translate.keyframes.back().value) <=
+                           settings.translationTolerance);
+
+    Animation odd;
+    odd.duration = 1.01f; // 最後のフレーム間隔が短い
+    odd.nodeAnimations["still"].rotate.keyframes = {{0.0f, AxisAngle({0, 1, 0}, 0.5f)}};
+    odd.nodeAnimations["empty"];
+    NodeAnimation &moving = odd.nodeAnimations["moving"];
+    for (int k = 0; k <= 101; ++k) {
+      float time = std::fmin(k * 0.01f, 1.01f);
+      moving.translate.keyframes.push_back({time, {time * 2.0f, 0.0f, 0.0f}});
+    }
+    CompressedAnimation oddClip = AnimationCompression::Compress(odd, settings);
+    QuaternionTransform still = AnimationCompression::SampleNode(oddClip, oddClip.FindNode("still"), 0.7f);
+    QuaternionTransform empty = AnimationCompression::SampleNode(oddClip, oddClip.FindNode("empty"), 0.7f);
+    check("constant track", Angle(still.rotate, AxisAngle({0, 1, 0}, 0.5f)) < 1.0e-6f &&
+                                oddClip.nodes[oddClip.FindNode("still")].rotate.sampleCount == 1);
+    check("empty track defaults", Distance(empty.translate, {0, 0, 0}) == 0.0f &&
+                                      Distance(empty.scale, {1, 1, 1}) == 0.0f && empty.rotate.w == 1.0f);
+    float worst = 0.0f;
+    for (float time = 0.0f; time <= 1.01f; time += 0.0037f) {
+      QuaternionTransform pose = AnimationCompression::SampleNode(oddClip, oddClip.FindNode("moving"), time);
+      worst = std::fmax(worst, std::fabs(pose.translate.x - time * 2.0f));
+    }
+    check("short last interval", worst <= settings.translationTolerance);
+  }
+
+  // メモリ量
+  const Animation longClip = MakeClip(120.0f, 2);
+  const CompressedAnimation longCompressed = AnimationCompression::Compress(longClip, settings);
+  {
+    size_t rawSize = AnimationCompression::GetMemorySize(longClip);
+    size_t compressedSize = longCompressed.GetMemorySize();
+    uint32_t reduced = 0, constant = 0, total = 0;
+    for (const CompressedAnimation::NodeTracks &tracks : longCompressed.nodes) {
+      for (const CompressedAnimation::Track *track : {&tracks.translate, &tracks.rotate, &tracks.scale}) {
+        ++total;
+        constant += track->sampleCount == 1;
+        reduced += track->stride > 1;
+      }
+    }
+    std::printf("120s clip, %u joints: %.1f KiB -> %.1f KiB (%.1fx), tracks %u: constant %u, reduced %u\n\n",
+                kJointCount, rawSize / 1024.0, compressedSize / 1024.0,
+                static_cast<double>(rawSize) / compressedSize, total, constant, reduced);
+    check("memory savings", compressedSize * 4 < rawSize);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  std::vector<QuaternionTransform> pose(longCompressed.nodes.size());
+  const float frameSeconds = 1.0f / 60.0f;
+  const uint32_t frameCount = static_cast<uint32_t>(longClip.duration / frameSeconds);
+
+  // 比較：元のキーフレームからカーソル付きで1ポーズ
+  std::vector<NodeAnimationCursor> cursors(longClip.nodeAnimations.size());
+  runner.Run("CompressedAnimation/SampleKeyframes pose(64 joints)", [&](uint64_t iteration) {
+    float time = static_cast<float>(iteration % frameCount) * frameSeconds;
+    size_t j = 0;
+    for (const auto &[name, node] : longClip.nodeAnimations) {
+      pose[j].translate = SampleKeyframes(node.translate.keyframes, time, cursors[j].translate);
+      pose[j].rotate = SampleKeyframes(node.rotate.keyframes, time, cursors[j].rotate);
+      pose[j].scale = SampleKeyframes(node.scale.keyframes, time, cursors[j].scale);
+      ++j;
+    }
+    Benchmark::DoNotOptimize(pose.data());
+  });
+
+  runner.Run("CompressedAnimation/SamplePose(64 joints)", [&](uint64_t iteration) {
+    float time = static_cast<float>(iteration % frameCount) * frameSeconds;
+    AnimationCompression::SamplePose(longCompressed, time, pose.data());
+    Benchmark::DoNotOptimize(pose.data());
+  });
+
+  // シーク（ブレンド先の頭出し・スクラブ）：元のキーフレームは二分探索、圧縮後は位置から直接引ける
+  std::vector<float> seeks(4096);
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> anywhere(0.0f, longClip.duration);
+  for (float &seek : seeks) {
+    seek = anywhere(rng);
+  }
+  runner.Run("CompressedAnimation/SampleKeyframes pose(random seek)", [&](uint64_t iteration) {
+    float time = seeks[iteration % seeks.size()];
+    size_t j = 0;
+    for (const auto &[name, node] : longClip.nodeAnimations) {
+      pose[j].translate = SampleKeyframes(node.translate.keyframes, time, cursors[j].translate);
+      pose[j].rotate = SampleKeyframes(node.rotate.keyframes, time, cursors[j].rotate);
+      pose[j].scale = SampleKeyframes(node.scale.keyframes, time, cursors[j].scale);
+      ++j;
+    }
+    Benchmark::DoNotOptimize(pose.data());
+  });
+
+  runner.Run("CompressedAnimation/SamplePose(random seek)", [&](uint64_t iteration) {
+    AnimationCompression::SamplePose(longCompressed, seeks[iteration % seeks.size()], pose.data());
+    Benchmark::DoNotOptimize(pose.data());
+  });
+
+  runner.Run("CompressedAnimation/Compress(20s clip)", [&](uint64_t) {
+    CompressedAnimation result = AnimationCompression::Compress(clip, settings);
+    Benchmark::DoNotOptimize(result.samples.data());
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+// 視錐台カリングのベンチマーク（10000オブジェクト）
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o culling_benchmark tools/Benchmark/CullingBenchmark.cpp
+//       Engine/src/Math/MathUtil.cpp Engine/src/Math/CollisionMath.cpp
+//       Engine/src/Render/Culling/FrustumCuller.cpp
+//
+// 実行例:
+//   ./culling_benchmark --out culling_baseline.json
+//   ./culling_benchmark --baseline culling_baseline.json --threshold 10
+#include "BenchmarkCommon.h"
+#include "Culling/FrustumCuller.h"
+#include "Math/CollisionMath.h"
+#include "Math/Geometry.h"
+#include "Math/MathUtil.h"
+#include <iterator>
+#include <numbers>
+#include <random>
+#include <string>
+
+namespace {
+
+constexpr uint32_t kObjectCount = 10000;
+
+// レール上のカメラから見た配置に近い分布（前方に多く、横・背後にも散らばる）
+struct Scene {
+  std::vector<Sphere> spheres;
+  std::vector<Matrix4x4> worlds;
+  Matrix4x4 viewProjection;
+};
+
+// 答えの分かっている球（BuildScene と同じカメラ: (0, 5, 0) から +Z を見る、縦 45 度・16:9・near 0.1・far 1000）
+// z = 100 での視錐台の断面は、横 ±73.64、縦 5 ± 41.42
+struct KnownCase {
+  const char *label;
+  Sphere sphere;
+  bool visible;
+};
+
+const KnownCase kKnownCases[] = {
+    {"fully inside", {{0.0f, 5.0f, 50.0f}, 1.0f}, true},
+    {"behind camera", {{0.0f, 5.0f, -10.0f}, 1.0f}, false},
+    {"straddling near plane", {{0.0f, 5.0f, -0.5f}, 1.0f}, true},
+    {"beyond far plane", {{0.0f, 5.0f, 1010.0f}, 5.0f}, false},
+    {"straddling far plane", {{0.0f, 5.0f, 1002.0f}, 5.0f}, true},
+    {"straddling left plane", {{-75.0f, 5.0f, 100.0f}, 5.0f}, true},
+    {"outside left plane", {{-90.0f, 5.0f, 100.0f}, 5.0f}, false},
+    {"straddling right plane", {{75.0f, 5.0f, 100.0f}, 5.0f}, true},
+    {"outside right plane", {{90.0f, 5.0f, 100.0f}, 5.0f}, false},
+    {"straddling top plane", {{0.0f, 47.42f, 100.0f}, 5.0f}, true},
+    {"outside top plane", {{0.0f, 58.42f, 100.0f}, 5.0f}, false},
+    {"straddling bottom plane", {{0.0f, -37.42f, 100.0f}, 5.0f}, true},
+    {"outside bottom plane", {{0.0f, -48.42f, 100.0f}, 5.0f}, false},
+};
+
+Scene BuildScene() {
+  std::mt19937 rng(12345);
+  auto range = [&rng](float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+  };
+
+  Scene scene;
+  Matrix4x4 view = MakeLookAtMatrix({0.0f, 5.0f, 0.0f}, {0.0f, 5.0f, 1.0f}, {0.0f, 1.0f, 0.0f});
+  Matrix4x4 projection = MakePerspectiveFovMatrix(45.0f * std::numbers::pi_v<float> / 180.0f,
+                                                  1280.0f / 720.0f, 0.1f, 1000.0f);
+  scene.viewProjection = Multiply(view, projection);
+
+  Sphere local{{0.0f, 0.5f, 0.0f}, 1.2f};
+  for (uint32_t i = 0; i < kObjectCount; ++i) {
+    Vector3 scale = {range(0.5f, 3.0f), range(0.5f, 3.0f), range(0.5f, 3.0f)};
+    Vector3 rotate = {0.0f, range(-3.14f, 3.14f), 0.0f};
+    Vector3 translate = {range(-300.0f, 300.0f), range(-10.0f, 40.0f), range(-200.0f, 800.0f)};
+    Matrix4x4 world = MakeAffineMatrix(scale, rotate, translate);
+    scene.worlds.push_back(world);
+    scene.spheres.push_back(TransformSphere(local, world));
+  }
+  return scene;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "culling_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  Scene scene = BuildScene();
+  Frustum frustum = MakeFrustum(scene.viewProjection);
+
+  // SoA にしたものを事前に用意（判定処理だけを測る）
+  FrustumCuller culler;
+  culler.BeginFrame();
+  for (const Sphere &sphere : scene.spheres) {
+    culler.Submit(sphere);
+  }
+
+  std::vector<float> centerX, centerY, centerZ, radius;
+  for (const Sphere &sphere : scene.spheres) {
+    centerX.push_back(sphere.center.x);
+    centerY.push_back(sphere.center.y);
+    centerZ.push_back(sphere.center.z);
+    radius.push_back(sphere.radius);
+  }
+  std::vector<uint8_t> visible(kObjectCount);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool checked = true;
+  auto check = [&](const std::string &label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[Culling] %s\n", label.c_str());
+      checked = false;
+    }
+  };
+
+  // 答えの分かっている球を、スカラー・SIMD（端数を含む 13 個）・FrustumCuller の3通りで判定する
+  {
+    constexpr uint32_t kKnownCount = static_cast<uint32_t>(std::size(kKnownCases));
+    float knownX[kKnownCount], knownY[kKnownCount], knownZ[kKnownCount], knownRadius[kKnownCount];
+    uint8_t knownVisible[kKnownCount];
+    FrustumCuller knownCuller;
+    knownCuller.BeginFrame();
+    for (uint32_t i = 0; i < kKnownCount; ++i) {
+      const Sphere &sphere = kKnownCases[i].sphere;
+      knownX[i] = sphere.center.x;
+      knownY[i] = sphere.center.y;
+      knownZ[i] = sphere.center.z;
+      knownRadius[i] = sphere.radius;
+      knownCuller.Submit(sphere);
+    }
+    FrustumCuller::CullSpheres(frustum, knownX, knownY, knownZ, knownRadius, kKnownCount, knownVisible);
+    knownCuller.Cull(scene.viewProjection);
+    for (uint32_t i = 0; i < kKnownCount; ++i) {
+      const KnownCase &known = kKnownCases[i];
+      check(std::string(known.label) + " (scalar)", CollisionMath::IsCollision(frustum, known.sphere) == known.visible);
+      check(std::string(known.label) + " (SIMD)", (knownVisible[i] != 0) == known.visible);
+      check(std::string(known.label) + " (FrustumCuller)",
+            knownCuller.IsVisible(i, knownCuller.GetFrame()) == known.visible);
+    }
+  }
+  if (!checked) {
+    return 1;
+  }
+
+  // SIMD とスカラーの判定結果が一致するか確認しておく
+  FrustumCuller::CullSpheres(frustum, centerX.data(), centerY.data(), centerZ.data(),
+                             radius.data(), kObjectCount, visible.data());
+  uint32_t visibleCount = 0;
+  for (uint32_t i = 0; i < kObjectCount; ++i) {
+    bool expected = CollisionMath::IsCollision(frustum, scene.spheres[i]);
+    if (expected != (visible[i] != 0)) {
+      std::fprintf(stderr, "[Culling] mismatch at %u\n", i);
+      return 1;
+    }
+    visibleCount += visible[i];
+  }
+  std::printf("objects %u, visible %u, culled %u\n\n", kObjectCount, visibleCount,
+              kObjectCount - visibleCount);
+
+  runner.Run("Culling/MakeFrustum", [&](uint64_t) {
+    Frustum r = MakeFrustum(scene.viewProjection);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("Culling/TransformSphere x10000", [&](uint64_t) {
+    Sphere local{{0.0f, 0.5f, 0.0f}, 1.2f};
+    for (uint32_t i = 0; i < kObjectCount; ++i) {
+      Sphere r = TransformSphere(local, scene.worlds[i]);
+      Benchmark::DoNotOptimize(r);
+    }
+  });
+
+  runner.Run("Culling/Scalar x10000", [&](uint64_t) {
+    for (uint32_t i = 0; i < kObjectCount; ++i) {
+      visible[i] = CollisionMath::IsCollision(frustum, scene.spheres[i]) ? 1 : 0;
+    }
+    Benchmark::DoNotOptimize(visible.data()[0]);
+  });
+
+  runner.Run("Culling/SIMD x10000", [&](uint64_t) {
+    FrustumCuller::CullSpheres(frustum, centerX.data(), centerY.data(), centerZ.data(),
+                               radius.data(), kObjectCount, visible.data());
+    Benchmark::DoNotOptimize(visible.data()[0]);
+  });
+
+  runner.Run("Culling/FrustumCuller::Cull x10000", [&](uint64_t) {
+    culler.Cull(scene.viewProjection);
+    Benchmark::DoNotOptimize(culler.GetVisibleCount());
+  });
+
+  bool saved = runner.Save();
+  bool ok = runner.CompareWithBaseline();
+  return (saved && ok) ? 0 : 1;
+}
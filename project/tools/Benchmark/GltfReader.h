@@ -0,0 +1,210 @@
+#pragma once
+// ベンチマーク用の glTF 読み込み（Assimp なしで、同梱の .gltf からモデルとアニメーションを取り出す）
+// 座標系の変換はしない（境界の確認や、クリップの数・名前・長さの確認には十分）
+#include "Math/MathUtil.h"
+#include "Model/Animation.h"
+#include "Model/ModelAssetData.h"
+#include "Model/Skinning.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// glTF から読んだもの（ModelData は Model が Assimp から作るものと同じ形）
+struct GltfModel {
+  ModelAsset::ModelData modelData;
+  std::vector<Animation> animations;
+  std::vector<std::string> animationNames; // animations と同じ並び（名前がなければ空）
+  std::vector<VertexInfluence> influences; // 頂点ごと（スキンがなければ空。番号は skinJointNames の番号）
+  std::vector<std::string> skinJointNames; // JOINTS_0 の番号 → Joint 名
+};
+
+class GltfReader {
+public:
+  using json = nlohmann::json;
+
+  bool Open(const std::string &path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+      return false;
+    }
+    document_ = json::parse(file, nullptr, false);
+    if (document_.is_discarded()) {
+      return false;
+    }
+    const std::string directory = path.substr(0, path.find_last_of('/') + 1);
+    for (const json &buffer : document_["buffers"]) {
+      std::ifstream binary(directory + buffer["uri"].get<std::string>(), std::ios::binary);
+      std::vector<uint8_t> bytes(buffer["byteLength"].get<size_t>());
+      if (!binary.read(reinterpret_cast<char *>(bytes.data()), std::streamsize(bytes.size()))) {
+        return false;
+      }
+      buffers_.push_back(std::move(bytes));
+    }
+    return true;
+  }
+
+  // 要素を float で読む（整数の成分は正規化せずそのまま）
+  std::vector<float> ReadFloats(int32_t accessorIndex, uint32_t &outComponents) const {
+    const json &accessor = document_["accessors"][accessorIndex];
+    const json &view = document_["bufferViews"][accessor["bufferView"].get<int32_t>()];
+    const std::string type = accessor["type"];
+    outComponents = type == "SCALAR" ? 1 : type == "VEC2" ? 2 : type == "VEC3" ? 3 : type == "VEC4" ? 4 : 16;
+    const uint32_t componentType = accessor["componentType"];
+    const size_t componentBytes = componentType == 5126 || componentType == 5125 ? 4 : componentType == 5123 ? 2 : 1;
+    const size_t stride = view.value("byteStride", componentBytes * outComponents);
+    const size_t count = accessor["count"];
+    const uint8_t *base = buffers_[view["buffer"].get<size_t>()].data() + view.value("byteOffset", size_t(0)) +
+                          accessor.value("byteOffset", size_t(0));
+
+    std::vector<float> values(count * outComponents);
+    for (size_t i = 0; i < count; ++i) {
+      for (uint32_t c = 0; c < outComponents; ++c) {
+        const uint8_t *p = base + i * stride + c * componentBytes;
+        float value = 0.0f;
+        if (componentType == 5126) {
+          std::memcpy(&value, p, 4);
+        } else if (componentType == 5125) {
+          uint32_t v;
+          std::memcpy(&v, p, 4);
+          value = float(v);
+        } else if (componentType == 5123) {
+          uint16_t v;
+          std::memcpy(&v, p, 2);
+          value = float(v);
+        } else {
+          value = float(*p);
+        }
+        values[i * outComponents + c] = value;
+      }
+    }
+    return values;
+  }
+
+  GltfModel Read() const {
+    GltfModel model;
+    const json &nodes = document_["nodes"];
+
+    // シーンのルートの上に、Assimp と同じく単位行列のルートを置く
+    ModelAsset::Node &root = model.modelData.rootNode;
+    root.name = "RootNode";
+    root.transform = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+    root.localMatrix = MakeIdentity4x4();
+    for (int32_t index : document_["scenes"][document_.value("scene", 0)]["nodes"]) {
+      root.children.push_back(ReadNode(nodes, index));
+    }
+
+    for (const json &node : nodes) {
+      if (node.contains("mesh")) {
+        ReadMesh(node, model);
+      }
+    }
+
+    for (const json &source : document_.value("animations", json::array())) {
+      model.animationNames.push_back(source.value("name", ""));
+      Animation animation{};
+      for (const json &channel : source["channels"]) {
+        const json &sampler = source["samplers"][channel["sampler"].get<int32_t>()];
+        uint32_t timeComponents = 0, valueComponents = 0;
+        std::vector<float> times = ReadFloats(sampler["input"], timeComponents);
+        std::vector<float> values = ReadFloats(sampler["output"], valueComponents);
+        NodeAnimation &nodeAnimation = animation.nodeAnimations[NodeName(nodes, channel["target"]["node"])];
+        const std::string path = channel["target"]["path"];
+        for (size_t k = 0; k < times.size(); ++k) {
+          const float *v = &values[k * valueComponents];
+          animation.duration = std::max(animation.duration, times[k]);
+          if (path == "translation") {
+            nodeAnimation.translate.keyframes.push_back({times[k], {v[0], v[1], v[2]}});
+          } else if (path == "scale") {
+            nodeAnimation.scale.keyframes.push_back({times[k], {v[0], v[1], v[2]}});
+          } else if (path == "rotation") {
+            nodeAnimation.rotate.keyframes.push_back({times[k], {v[0], v[1], v[2], v[3]}});
+          }
+        }
+      }
+      model.animations.push_back(std::move(animation));
+    }
+    return model;
+  }
+
+private:
+  static std::string NodeName(const json &nodes, int32_t index) {
+    return nodes[index].value("name", "node" + std::to_string(index));
+  }
+
+  ModelAsset::Node ReadNode(const json &nodes, int32_t index) const {
+    const json &source = nodes[index];
+    ModelAsset::Node node;
+    node.name = NodeName(nodes, index);
+    node.transform = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+    if (source.contains("scale")) {
+      node.transform.scale = {source["scale"][0], source["scale"][1], source["scale"][2]};
+    }
+    if (source.contains("rotation")) {
+      const json &r = source["rotation"];
+      node.transform.rotate = {r[0], r[1], r[2], r[3]};
+    }
+    if (source.contains("translation")) {
+      node.transform.translate = {source["translation"][0], source["translation"][1], source["translation"][2]};
+    }
+    node.localMatrix = MakeAffineMatrix(node.transform.scale, node.transform.rotate, node.transform.translate);
+    for (int32_t child : source.value("children", json::array())) {
+      node.children.push_back(ReadNode(nodes, child));
+    }
+    return node;
+  }
+
+  void ReadMesh(const json &node, GltfModel &model) const {
+    const json &nodes = document_["nodes"];
+    for (const json &primitive : document_["meshes"][node["mesh"].get<int32_t>()]["primitives"]) {
+      const json &attributes = primitive["attributes"];
+      uint32_t components = 0;
+      std::vector<float> positions = ReadFloats(attributes["POSITION"], components);
+      std::vector<ModelAsset::VertexData> vertices(positions.size() / 3);
+      for (size_t v = 0; v < vertices.size(); ++v) {
+        vertices[v].position = {positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2], 1.0f};
+        vertices[v].texcoord = {0.0f, 0.0f};
+        vertices[v].normal = {0.0f, 1.0f, 0.0f};
+      }
+      std::vector<float> indexValues = ReadFloats(primitive["indices"], components);
+      std::vector<uint32_t> indices(indexValues.begin(), indexValues.end());
+      ModelAsset::SubMesh subMesh = ModelAsset::AppendSubMesh(model.modelData, vertices, indices, 0);
+
+      if (!node.contains("skin")) {
+        continue;
+      }
+      // 影響は Joint ごとにまとめる（Model::LoadModelFile と同じ形）
+      const json &skin = document_["skins"][node["skin"].get<int32_t>()];
+      std::vector<float> inverseBinds = ReadFloats(skin["inverseBindMatrices"], components);
+      std::vector<float> joints = ReadFloats(attributes["JOINTS_0"], components);
+      std::vector<float> weights = ReadFloats(attributes["WEIGHTS_0"], components);
+      model.influences.resize(model.modelData.vertices.size());
+      for (size_t v = 0; v < vertices.size(); ++v) {
+        const uint32_t vertexIndex = subMesh.vertexOffset + static_cast<uint32_t>(v);
+        for (uint32_t slot = 0; slot < 4; ++slot) {
+          const float weight = weights[v * 4 + slot];
+          const int32_t skinJoint = static_cast<int32_t>(joints[v * 4 + slot]);
+          const std::string jointName = NodeName(nodes, skin["joints"][skinJoint]);
+          ModelAsset::JointWeightData &jointWeight = model.modelData.skinClusterData[jointName];
+          // glTF の列優先の行列をそのまま並べると、このエンジンの行ベクトルの行列になる
+          std::memcpy(&jointWeight.inverseBindPoseMatrix, &inverseBinds[skinJoint * 16], sizeof(Matrix4x4));
+          if (weight > 0.0f) {
+            jointWeight.vertexWeights.push_back({weight, vertexIndex});
+          }
+          model.influences[vertexIndex].weights[slot] = weight;
+          model.influences[vertexIndex].jointIndices[slot] = skinJoint; // Skeleton の番号へは後で直す
+        }
+      }
+      model.skinJointNames.clear();
+      for (int32_t jointNode : skin["joints"]) {
+        model.skinJointNames.push_back(NodeName(nodes, jointNode));
+      }
+    }
+  }
+
+  json document_;
+  std::vector<std::vector<uint8_t>> buffers_;
+};
@@ -0,0 +1,320 @@
+// インスタンス描画のまとめ（InstanceBatcher）の確認とベンチマーク
+// GPU を使わず RecordingCommandRecorder にコマンドを積み、Object3d を1個ずつ描く場合と
+// （モデル, LOD, PSO, マテリアル, カメラ）でまとめて描く場合の、描画コマンド数・ルートパラメータ数・CPU 時間を比べる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o instance_batch_benchmark tools/Benchmark/InstanceBatchBenchmark.cpp
+//       Engine/src/Render/Renderer/InstanceBatcher.cpp Engine/src/Render/Renderer/RecordingCommandRecorder.cpp
+//
+// 実行例:
+//   ./instance_batch_benchmark --out instance_batch_baseline.json
+//   ./instance_batch_benchmark --baseline instance_batch_baseline.json
+#include "BenchmarkCommon.h"
+#include "Renderer/InstanceBatcher.h"
+#include "Renderer/RecordingCommandRecorder.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Model::Record と同じ積み方をするメッシュ（マテリアルごとの描画範囲を持つ）
+struct FakeMesh {
+  ICommandRecorder::VertexBufferView vertexBuffer;
+  ICommandRecorder::IndexBufferView indexBuffer;
+  struct Range {
+    uint32_t indexCount;
+    uint32_t indexOffset;
+    ICommandRecorder::DescriptorHandle texture;
+  };
+  std::vector<Range> ranges;
+
+  void Record(ICommandRecorder &recorder, uint32_t instanceCount) const {
+    recorder.SetVertexBuffer(0, vertexBuffer);
+    recorder.SetIndexBuffer(indexBuffer);
+    for (const Range &range : ranges) {
+      recorder.SetRootDescriptorTable(2, range.texture);
+      recorder.DrawIndexedInstanced(range.indexCount, instanceCount, range.indexOffset, 0, 0);
+    }
+  }
+};
+
+// Object3d の描画に必要なもの（定数バッファのアドレスなど）
+struct FakeObject {
+  const FakeMesh *mesh = nullptr;
+  ICommandRecorder::PipelineHandle pipeline = nullptr;
+  uint64_t material = 0;
+  const void *camera = nullptr;
+  ICommandRecorder::GpuAddress materialBuffer = 0;
+  ICommandRecorder::GpuAddress transformBuffer = 0;
+  ICommandRecorder::GpuAddress cameraBuffer = 0;
+  InstanceBatcher::InstanceData instance{};
+
+  // Object3d::RecordObjectParameters と同じ
+  void RecordObjectParameters(ICommandRecorder &recorder) const {
+    recorder.SetRootConstantBufferView(0, materialBuffer);
+    recorder.SetRootConstantBufferView(4, cameraBuffer);
+    recorder.SetRootDescriptorTable(8, 0x8000);
+  }
+};
+
+// Object3dRenderer::RecordSharedParameters と同じ（ライト3つ・環境マップ・フォグ）
+void RecordSharedParameters(ICommandRecorder &recorder) {
+  recorder.SetRootConstantBufferView(3, 0x3000);
+  recorder.SetRootConstantBufferView(5, 0x5000);
+  recorder.SetRootConstantBufferView(6, 0x6000);
+  recorder.SetRootDescriptorTable(7, 0x7000);
+  recorder.SetRootConstantBufferView(9, 0x9000);
+}
+
+// 1個ずつ描く（Object3d::Draw の積み方）
+void RecordIndividually(ICommandRecorder &recorder, const std::vector<FakeObject> &objects) {
+  ICommandRecorder::PipelineHandle currentPipeline = nullptr;
+  for (const FakeObject &object : objects) {
+    if (object.pipeline != currentPipeline) {
+      recorder.SetPipelineState(object.pipeline);
+      currentPipeline = object.pipeline;
+    }
+    object.RecordObjectParameters(recorder);
+    recorder.SetRootConstantBufferView(1, object.transformBuffer);
+    RecordSharedParameters(recorder);
+    object.mesh->Record(recorder, 1);
+  }
+}
+
+constexpr ICommandRecorder::GpuAddress kInstanceBuffer = 0x10000000;
+
+// まとめて描く（Object3d::Draw で登録し、Object3dRenderer::Flush で積む）
+void RecordBatched(ICommandRecorder &recorder, InstanceBatcher &batcher, const std::vector<FakeObject> &objects) {
+  batcher.Clear();
+  for (uint32_t i = 0; i < objects.size(); ++i) {
+    const FakeObject &object = objects[i];
+    InstanceBatcher::Key key;
+    key.mesh = object.mesh;
+    key.pipeline = object.pipeline;
+    key.material = object.material;
+    key.view = object.camera;
+    batcher.Add(key, object.instance, i);
+  }
+  batcher.Build();
+
+  recorder.SetRootSignature(reinterpret_cast<const void *>(0x100));
+  recorder.SetPrimitiveTopology(ICommandRecorder::PrimitiveTopology::TriangleList);
+  RecordSharedParameters(recorder);
+  batcher.Record(recorder, kInstanceBuffer, 1,
+                 [&](ICommandRecorder &groupRecorder, const InstanceBatcher::Group &group) {
+                   const FakeObject &object = objects[group.representative];
+                   object.RecordObjectParameters(groupRecorder);
+                   static_cast<const FakeMesh *>(group.key.mesh)->Record(groupRecorder, group.instanceCount);
+                 });
+}
+
+Matrix4x4 MakeTranslation(float x, float y, float z) {
+  Matrix4x4 m{};
+  m.m[0][0] = m.m[1][1] = m.m[2][2] = m.m[3][3] = 1.0f;
+  m.m[3][0] = x;
+  m.m[3][1] = y;
+  m.m[3][2] = z;
+  return m;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "instance_batch_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  // メッシュ: 弾（1範囲）、敵2種（2範囲）、背景の小物 100 種（1範囲）
+  std::vector<FakeMesh> meshes(103);
+  for (size_t i = 0; i < meshes.size(); ++i) {
+    FakeMesh &mesh = meshes[i];
+    mesh.vertexBuffer = {0x20000000 + i * 0x10000, 0x10000, 40};
+    mesh.indexBuffer = {0x30000000 + i * 0x10000, 0x8000, ICommandRecorder::IndexFormat::UInt32};
+    mesh.ranges.push_back({960, 0, 0x1000 + i});
+    if (i == 1 || i == 2) {
+      mesh.ranges.push_back({480, 960, 0x2000 + i});
+    }
+  }
+  const FakeMesh &bullet = meshes[0];
+  const void *const kOpaquePipeline = reinterpret_cast<const void *>(0x200);
+  const void *const kOverlayPipeline = reinterpret_cast<const void *>(0x201); // デプスなし
+  int cameraTag = 0;
+  const void *const camera = &cameraTag;
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[InstanceBatch] %s\n", label);
+      ok = false;
+    }
+  };
+
+  {
+    // 3種類のキーを交互に登録する
+    std::vector<FakeObject> objects;
+    for (uint32_t i = 0; i < 9; ++i) {
+      FakeObject object;
+      object.mesh = (i % 3 == 2) ? &meshes[1] : &bullet;
+      object.pipeline = kOpaquePipeline;
+      object.material = (i % 3 == 1) ? 2 : 1;
+      object.camera = camera;
+      object.materialBuffer = 0x40000000 + i * 256;
+      object.instance.World = MakeTranslation(float(i), 0.0f, 0.0f);
+      objects.push_back(object);
+    }
+
+    InstanceBatcher batcher;
+    RecordingCommandRecorder recorder;
+    RecordBatched(recorder, batcher, objects);
+
+    const std::vector<InstanceBatcher::Group> &groups = batcher.GetGroups();
+    const std::vector<InstanceBatcher::InstanceData> &instances = batcher.GetInstances();
+    check("group count", groups.size() == 3);
+    check("instance count", instances.size() == objects.size());
+    bool grouped = groups.size() == 3;
+    for (uint32_t g = 0; grouped && g < groups.size(); ++g) {
+      // グループは最初に登録された順、代表は最初に登録されたもの、中身は登録順
+      grouped = groups[g].representative == g && groups[g].instanceCount == 3 && groups[g].firstInstance == g * 3;
+      for (uint32_t k = 0; grouped && k < 3; ++k) {
+        grouped = instances[groups[g].firstInstance + k].World.m[3][0] == float(g + k * 3);
+      }
+    }
+    check("instances grouped in submission order", grouped);
+
+    // 3グループ × 範囲数（弾 1 + 弾 1 + 敵 2）の描画、インスタンスの合計は範囲ごとに数える
+    check("draw count", recorder.GetDrawCount() == 4);
+    check("instance total", recorder.GetInstanceCount() == 3 + 3 + 3 * 2);
+    check("pipeline set once", recorder.Count(RecordingCommandRecorder::Type::SetPipelineState) == 1);
+
+    // 各グループのルート SRV はバッファの先頭からグループの先頭だけずれている
+    std::vector<uint64_t> srvs;
+    for (const RecordingCommandRecorder::Command &command : recorder.GetCommands()) {
+      if (command.type == RecordingCommandRecorder::Type::SetRootShaderResourceView) {
+        check("srv root index", command.index == 1);
+        srvs.push_back(command.value);
+      }
+      if (command.type == RecordingCommandRecorder::Type::DrawIndexedInstanced) {
+        check("start instance is zero", command.startInstance == 0);
+      }
+    }
+    check("srv per group", srvs.size() == 3);
+    for (size_t g = 0; g < srvs.size() && g < groups.size(); ++g) {
+      check("srv offset", srvs[g] == kInstanceBuffer + groups[g].firstInstance * sizeof(InstanceBatcher::InstanceData));
+    }
+
+    // マテリアルの定数バッファは代表のもの
+    std::vector<uint64_t> materials;
+    for (const RecordingCommandRecorder::Command &command : recorder.GetCommands()) {
+      if (command.type == RecordingCommandRecorder::Type::SetRootConstantBufferView && command.index == 0) {
+        materials.push_back(command.value);
+      }
+    }
+    check("representative material", materials.size() == 3 && materials[0] == objects[0].materialBuffer &&
+                                         materials[1] == objects[1].materialBuffer &&
+                                         materials[2] == objects[2].materialBuffer);
+
+    // PSO・カメラ・LOD が違えば別のグループ
+    InstanceBatcher::Key key;
+    key.mesh = &bullet;
+    key.pipeline = kOpaquePipeline;
+    batcher.Clear();
+    batcher.Add(key, {}, 0);
+    key.pipeline = kOverlayPipeline;
+    batcher.Add(key, {}, 1);
+    key.view = camera;
+    batcher.Add(key, {}, 2);
+    key.lodIndex = 1;
+    batcher.Add(key, {}, 3);
+    key.lodIndex = 0;
+    key.view = nullptr;
+    key.pipeline = kOpaquePipeline;
+    batcher.Add(key, {}, 4);
+    batcher.Build();
+    check("keys split groups", batcher.GetGroups().size() == 4 && batcher.GetGroups()[0].instanceCount == 2);
+
+    recorder.Clear();
+    batcher.Record(recorder, kInstanceBuffer, 1, [](ICommandRecorder &, const InstanceBatcher::Group &) {});
+    check("pipeline set on change", recorder.Count(RecordingCommandRecorder::Type::SetPipelineState) == 2);
+
+    // Clear で空に戻る
+    batcher.Clear();
+    batcher.Build();
+    check("clear", batcher.GetSubmittedCount() == 0 && batcher.GetGroups().empty() && batcher.GetInstances().empty());
+
+    // マテリアルのハッシュ
+    float a[4] = {1.0f, 0.5f, 0.0f, 1.0f};
+    float b[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    check("hash equal", InstanceBatcher::HashBytes(a, sizeof(a)) == InstanceBatcher::HashBytes(a, sizeof(a)));
+    check("hash differs", InstanceBatcher::HashBytes(a, sizeof(a)) != InstanceBatcher::HashBytes(b, sizeof(b)));
+    check("hash seed chains", InstanceBatcher::HashBytes("mask", 4, InstanceBatcher::HashBytes(a, sizeof(a))) !=
+                                  InstanceBatcher::HashBytes("mask", 4, InstanceBatcher::HashBytes(b, sizeof(b))));
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // 弾 600（色 3 種）、敵 300（2 種、1 割が被弾で色違い）、背景の小物 100（すべて別モデル）、
+  // うち敵の一部をデプスなしの PSO で描く
+  std::vector<FakeObject> objects;
+  std::mt19937 random(7);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    FakeObject object;
+    object.pipeline = kOpaquePipeline;
+    object.camera = camera;
+    if (i < 600) {
+      object.mesh = &bullet;
+      object.material = 10 + random() % 3;
+    } else if (i < 900) {
+      object.mesh = &meshes[1 + random() % 2];
+      object.material = (random() % 10 == 0) ? 21 : 20;
+      if (i >= 880) {
+        object.pipeline = kOverlayPipeline;
+      }
+    } else {
+      object.mesh = &meshes[3 + (i - 900)];
+      object.material = 30;
+    }
+    object.materialBuffer = 0x40000000 + uint64_t(i) * 256;
+    object.transformBuffer = 0x50000000 + uint64_t(i) * 256;
+    object.cameraBuffer = 0x60000000 + uint64_t(i) * 256;
+    object.instance.World = MakeTranslation(float(i % 32), float(i / 32), 0.0f);
+    objects.push_back(object);
+  }
+  // 描画順はバラバラ（アクターの更新順）
+  std::shuffle(objects.begin(), objects.end(), random);
+
+  RecordingCommandRecorder individual;
+  RecordIndividually(individual, objects);
+  RecordingCommandRecorder batched;
+  InstanceBatcher batcher;
+  RecordBatched(batched, batcher, objects);
+  std::printf("1000 objects: individual %zu draws / %zu root parameters / %zu commands\n",
+              individual.GetDrawCount(), individual.GetRootParameterCount(), individual.GetCommandCount());
+  std::printf("              batched    %zu draws / %zu root parameters / %zu commands (%zu groups)\n",
+              batched.GetDrawCount(), batched.GetRootParameterCount(), batched.GetCommandCount(),
+              batcher.GetGroups().size());
+
+  runner.Run("InstanceBatch/individual (1000 objects)", [&](uint64_t) {
+    individual.Clear();
+    RecordIndividually(individual, objects);
+    Benchmark::DoNotOptimize(individual.GetCommandCount());
+  });
+  runner.Run("InstanceBatch/batched (1000 objects)", [&](uint64_t) {
+    batched.Clear();
+    RecordBatched(batched, batcher, objects);
+    Benchmark::DoNotOptimize(batched.GetCommandCount());
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+// MathUtil / CollisionMath のマイクロベンチマーク
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -Iexternals -o math_benchmark
+//       tools/Benchmark/MathBenchmark.cpp
+//       Engine/src/Math/MathUtil.cpp Engine/src/Math/CollisionMath.cpp
+//
+// 実行例:
+//   ./math_benchmark --out math_baseline.json
+//   ./math_benchmark --baseline math_baseline.json --threshold 10
+#include "BenchmarkCommon.h"
+#include "Math/CollisionMath.h"
+#include "Math/Geometry.h"
+#include "Math/MathUtil.h"
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+
+// 入力データの個数（L1/L2に収まる程度にして、メモリ待ちではなく計算コストを測る）
+constexpr uint32_t kPoolSize = 1024;
+constexpr uint32_t kPoolMask = kPoolSize - 1;
+
+// ゲーム内の値に近い範囲で入力を作る
+struct InputPool {
+  std::mt19937 rng{12345};
+
+  float Range(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+  }
+
+  Vector3 RangeVector(float min, float max) {
+    return {Range(min, max), Range(min, max), Range(min, max)};
+  }
+
+  Quaternion RandomRotation() {
+    // 一様な単位クォータニオン
+    float u1 = Range(0.0f, 1.0f);
+    float u2 = Range(0.0f, 2.0f * std::numbers::pi_v<float>);
+    float u3 = Range(0.0f, 2.0f * std::numbers::pi_v<float>);
+    float a = std::sqrt(1.0f - u1);
+    float b = std::sqrt(u1);
+    return {a * std::sin(u2), a * std::cos(u2), b * std::sin(u3), b * std::cos(u3)};
+  }
+
+  // 敵・弾・背景オブジェクト相当のワールド行列
+  Matrix4x4 RandomAffine() {
+    return MakeAffineMatrix(RangeVector(0.5f, 3.0f), RangeVector(-3.14f, 3.14f),
+                            RangeVector(-200.0f, 200.0f));
+  }
+
+  // レールカメラ相当のビュープロジェクション行列
+  Matrix4x4 RandomViewProjection(Vector3 *outEye = nullptr, Vector3 *outForward = nullptr) {
+    Vector3 eye = RangeVector(-200.0f, 200.0f);
+    Vector3 forward = SafeNormalize(RangeVector(-1.0f, 1.0f));
+    if (LengthSq(forward) == 0.0f) {
+      forward = {0.0f, 0.0f, 1.0f};
+    }
+    Matrix4x4 view = MakeLookAtMatrix(eye, eye + forward, {0.0f, 1.0f, 0.0f});
+    Matrix4x4 projection =
+        MakePerspectiveFovMatrix(45.0f * std::numbers::pi_v<float> / 180.0f, 1280.0f / 720.0f,
+                                 0.1f, 1000.0f);
+    if (outEye) {
+      *outEye = eye;
+    }
+    if (outForward) {
+      *outForward = forward;
+    }
+    return Multiply(view, projection);
+  }
+};
+
+struct Pools {
+  std::array<Matrix4x4, kPoolSize> matrixA;
+  std::array<Matrix4x4, kPoolSize> matrixB;
+  std::array<Matrix4x4, kPoolSize> viewProjection;
+  std::array<Quaternion, kPoolSize> quatA;
+  std::array<Quaternion, kPoolSize> quatB;
+  std::array<float, kPoolSize> t;
+  std::array<Vector3, kPoolSize + 3> railPoints;
+  std::array<Vector3, kPoolSize> worldPos;
+  std::array<Vector3, kPoolSize> eye;
+  std::array<Vector3, kPoolSize> target;
+  std::array<Sphere, kPoolSize> sphereA;
+  std::array<Sphere, kPoolSize> sphereB;
+  std::array<AABB, kPoolSize> aabbA;
+  std::array<AABB, kPoolSize> aabbB;
+  std::array<Segment, kPoolSize> segment;
+  std::array<Ray, kPoolSize> ray;
+};
+
+void BuildPools(Pools &pools) {
+  InputPool in;
+
+  for (uint32_t i = 0; i < kPoolSize; ++i) {
+    pools.matrixA[i] = in.RandomAffine();
+    pools.matrixB[i] = in.RandomAffine();
+
+    Vector3 eye{};
+    Vector3 forward{};
+    pools.viewProjection[i] = in.RandomViewProjection(&eye, &forward);
+    pools.eye[i] = eye;
+    pools.target[i] = eye + forward * in.Range(5.0f, 50.0f);
+
+    // 大半はカメラ前方、一部は背後にある対象を投影する
+    float distance = in.Range(-20.0f, 300.0f);
+    pools.worldPos[i] = eye + forward * distance + in.RangeVector(-30.0f, 30.0f);
+
+    pools.quatA[i] = in.RandomRotation();
+    pools.quatB[i] = in.RandomRotation();
+    pools.t[i] = in.Range(0.0f, 1.0f);
+  }
+
+  // レールのウェイポイント（間隔5～30程度で前方へ伸びる）
+  Vector3 point{0.0f, 0.0f, 0.0f};
+  for (Vector3 &p : pools.railPoints) {
+    p = point;
+    point += Vector3{in.Range(-10.0f, 10.0f), in.Range(-3.0f, 3.0f), in.Range(5.0f, 30.0f)};
+  }
+
+  // 当たり判定はプレイヤー周辺 50 ユニットにばらまく（ヒット/ミスが混在する分布）
+  for (uint32_t i = 0; i < kPoolSize; ++i) {
+    pools.sphereA[i] = {in.RangeVector(-50.0f, 50.0f), in.Range(0.5f, 3.0f)};
+    pools.sphereB[i] = {in.RangeVector(-50.0f, 50.0f), in.Range(0.5f, 3.0f)};
+
+    Vector3 centerA = in.RangeVector(-50.0f, 50.0f);
+    Vector3 halfA = in.RangeVector(0.5f, 8.0f);
+    pools.aabbA[i] = {centerA - halfA, centerA + halfA};
+    Vector3 centerB = in.RangeVector(-50.0f, 50.0f);
+    Vector3 halfB = in.RangeVector(0.5f, 8.0f);
+    pools.aabbB[i] = {centerB - halfB, centerB + halfB};
+
+    // 弾の1フレーム分の移動量相当の線分
+    pools.segment[i] = {in.RangeVector(-50.0f, 50.0f), in.RangeVector(-4.0f, 4.0f)};
+    pools.ray[i] = {in.RangeVector(-50.0f, 50.0f), SafeNormalize(in.RangeVector(-1.0f, 1.0f))};
+  }
+}
+
+bool NearlyEqual(float a, float b, float tolerance) { return std::abs(a - b) <= tolerance; }
+
+bool NearlyEqual(const Vector3 &a, const Vector3 &b, float tolerance) {
+  return NearlyEqual(a.x, b.x, tolerance) && NearlyEqual(a.y, b.y, tolerance) &&
+         NearlyEqual(a.z, b.z, tolerance);
+}
+
+// 符号が逆でも同じ回転とみなす
+bool SameRotation(const Quaternion &a, const Quaternion &b, float tolerance) {
+  float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+  return NearlyEqual(std::abs(dot), 1.0f, tolerance);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "math_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  static Pools pools;
+  BuildPools(pools);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool checked = true;
+  auto check = [&](const std::string &label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[Math] %s\n", label.c_str());
+      checked = false;
+    }
+  };
+
+  // 計測に使う入力で、結果の分かっている性質を確かめる
+  {
+    bool inverseOk = true;
+    bool slerpOk = true;
+    bool catmullRomOk = true;
+    bool screenCenterOk = true;
+    const Matrix4x4 identity = MakeIdentity4x4();
+    for (uint32_t i = 0; i < kPoolSize; ++i) {
+      Matrix4x4 product = Multiply(pools.matrixA[i], Inverse(pools.matrixA[i]));
+      for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+          inverseOk &= NearlyEqual(product.m[row][column], identity.m[row][column], 1e-3f);
+        }
+      }
+
+      slerpOk &= SameRotation(Slerp(pools.quatA[i], pools.quatB[i], 0.0f), pools.quatA[i], 1e-5f);
+      slerpOk &= SameRotation(Slerp(pools.quatA[i], pools.quatB[i], 1.0f), pools.quatB[i], 1e-5f);
+      Quaternion middle = Slerp(pools.quatA[i], pools.quatB[i], pools.t[i]);
+      slerpOk &= NearlyEqual(middle.x * middle.x + middle.y * middle.y + middle.z * middle.z +
+                                 middle.w * middle.w,
+                             1.0f, 1e-4f);
+
+      // レールは先へ行くほど座標が大きくなるので、許容誤差も座標の大きさに合わせる
+      const Vector3 *rail = &pools.railPoints[i];
+      const float railTolerance = 1e-3f + Length(rail[3]) * 1e-6f;
+      catmullRomOk &= NearlyEqual(CatmullRom(rail[0], rail[1], rail[2], rail[3], 0.0f), rail[1], railTolerance);
+      catmullRomOk &= NearlyEqual(CatmullRom(rail[0], rail[1], rail[2], rail[3], 1.0f), rail[2], railTolerance);
+
+      // 注視点は画面の中央に映る
+      Vector2 center = WorldToScreen(pools.target[i], pools.viewProjection[i], 1280.0f, 720.0f);
+      screenCenterOk &= NearlyEqual(center.x, 640.0f, 0.05f) && NearlyEqual(center.y, 360.0f, 0.05f);
+    }
+    check("Inverse * matrix is identity", inverseOk);
+    check("Slerp endpoints and unit length", slerpOk);
+    check("CatmullRom passes through p1 and p2", catmullRomOk);
+    check("look target projects to the screen center", screenCenterOk);
+  }
+
+  // 当たり判定は境界の内側と外側で答えが分かっている形を使う
+  {
+    const Sphere unit{{0.0f, 0.0f, 0.0f}, 1.0f};
+    check("spheres overlapping", CollisionMath::IsCollision(unit, Sphere{{1.9f, 0.0f, 0.0f}, 1.0f}));
+    check("spheres apart", !CollisionMath::IsCollision(unit, Sphere{{2.1f, 0.0f, 0.0f}, 1.0f}));
+
+    const AABB box{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+    check("AABBs touching", CollisionMath::IsCollision(box, AABB{{1.0f, 0.0f, 0.0f}, {2.0f, 1.0f, 1.0f}}));
+    check("AABBs apart", !CollisionMath::IsCollision(box, AABB{{1.1f, 0.0f, 0.0f}, {2.0f, 1.0f, 1.0f}}));
+
+    check("sphere reaching an AABB corner",
+          CollisionMath::IsCollision(Sphere{{1.5f, 1.5f, 0.0f}, 0.75f}, box));
+    check("sphere short of an AABB corner",
+          !CollisionMath::IsCollision(Sphere{{1.5f, 1.5f, 0.0f}, 0.65f}, box));
+
+    check("segment passing through a sphere",
+          CollisionMath::IsCollision(Segment{{-5.0f, 0.9f, 0.0f}, {10.0f, 0.0f, 0.0f}}, unit));
+    check("segment ending before a sphere",
+          !CollisionMath::IsCollision(Segment{{-5.0f, 0.0f, 0.0f}, {3.0f, 0.0f, 0.0f}}, unit));
+
+    float distance = 0.0f;
+    bool rayHit = IsCollision(Ray{{0.0f, 0.0f, -10.0f}, {0.0f, 0.0f, 1.0f}}, unit, &distance);
+    check("ray hits the near side of a sphere", rayHit && NearlyEqual(distance, 9.0f, 1e-4f));
+    check("ray pointing away from a sphere", !IsCollision(Ray{{0.0f, 0.0f, -10.0f}, {0.0f, 0.0f, -1.0f}}, unit));
+  }
+  if (!checked) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+
+  //=========================
+  // MathUtil
+  //=========================
+  runner.Run("MathUtil/Multiply", [&](uint64_t i) {
+    Matrix4x4 r = Multiply(pools.matrixA[i & kPoolMask], pools.matrixB[(i + 7) & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/Inverse", [&](uint64_t i) {
+    Matrix4x4 r = Inverse(pools.matrixA[i & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/Transpose(Inverse)", [&](uint64_t i) {
+    Matrix4x4 r = Transpose(Inverse(pools.matrixA[i & kPoolMask]));
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/MakeAffineMatrix", [&](uint64_t i) {
+    const Vector3 &v = pools.worldPos[i & kPoolMask];
+    Vector3 rotate = {v.x * 0.01f, v.y * 0.01f, v.z * 0.01f};
+    Matrix4x4 r = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, rotate, v);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/MakeAffineMatrix(Quaternion)", [&](uint64_t i) {
+    Matrix4x4 r = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, pools.quatA[i & kPoolMask],
+                                   pools.worldPos[i & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/Slerp", [&](uint64_t i) {
+    Quaternion r = Slerp(pools.quatA[i & kPoolMask], pools.quatB[i & kPoolMask],
+                         pools.t[i & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/CatmullRom", [&](uint64_t i) {
+    uint32_t index = static_cast<uint32_t>(i & kPoolMask);
+    Vector3 r = CatmullRom(pools.railPoints[index], pools.railPoints[index + 1],
+                           pools.railPoints[index + 2], pools.railPoints[index + 3],
+                           pools.t[index]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/WorldToScreen", [&](uint64_t i) {
+    Vector2 r = WorldToScreen(pools.worldPos[i & kPoolMask],
+                              pools.viewProjection[(i >> 4) & kPoolMask], 1280.0f, 720.0f);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/MakeLookAtMatrix", [&](uint64_t i) {
+    Matrix4x4 r = MakeLookAtMatrix(pools.eye[i & kPoolMask], pools.target[i & kPoolMask],
+                                   {0.0f, 1.0f, 0.0f});
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/TransformNormal", [&](uint64_t i) {
+    Vector3 r = TransformNormal(pools.worldPos[i & kPoolMask], pools.matrixA[(i >> 3) & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MathUtil/IsCollision(Ray,Sphere)", [&](uint64_t i) {
+    float distance = 0.0f;
+    bool r = IsCollision(pools.ray[i & kPoolMask], pools.sphereA[(i + 3) & kPoolMask], &distance);
+    Benchmark::DoNotOptimize(r);
+    Benchmark::DoNotOptimize(distance);
+  });
+
+  //=========================
+  // CollisionMath
+  //=========================
+  runner.Run("CollisionMath/Sphere-Sphere", [&](uint64_t i) {
+    bool r = CollisionMath::IsCollision(pools.sphereA[i & kPoolMask],
+                                        pools.sphereB[(i + 5) & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("CollisionMath/AABB-AABB", [&](uint64_t i) {
+    bool r = CollisionMath::IsCollision(pools.aabbA[i & kPoolMask],
+                                        pools.aabbB[(i + 5) & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("CollisionMath/Sphere-AABB", [&](uint64_t i) {
+    bool r = CollisionMath::IsCollision(pools.sphereA[i & kPoolMask],
+                                        pools.aabbA[(i + 5) & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("CollisionMath/Segment-Sphere", [&](uint64_t i) {
+    bool r = CollisionMath::IsCollision(pools.segment[i & kPoolMask],
+                                        pools.sphereB[(i + 5) & kPoolMask]);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  bool saved = runner.Save();
+  bool ok = runner.CompareWithBaseline();
+  return (saved && ok) ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+// メッシュキャッシュ（MeshCache）の往復確認と読み込み時間のベンチマーク
+// Assimp での読み込み時間は Windows 上で Model のログ（"imported with Assimp" / "mesh cache hit"）で比べる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o mesh_cache_benchmark tools/Benchmark/MeshCacheBenchmark.cpp
+//       Engine/src/Render/Model/MeshCache.cpp
+//
+// 実行例:
+//   ./mesh_cache_benchmark --out mesh_cache_baseline.json
+//   ./mesh_cache_benchmark --baseline mesh_cache_baseline.json
+#include "BenchmarkCommon.h"
+#include "Model/MeshCache.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kTerrainGrid = 256;  // terrain.obj 相当（6.6万頂点・39万インデックス）
+constexpr uint32_t kSkinnedVertices = 12000; // 人型のスキンメッシュ相当
+constexpr uint32_t kJointCount = 64;
+
+ModelAsset::Node MakeNode(const std::string &name) {
+  ModelAsset::Node node{};
+  node.transform = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+  node.name = name;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      node.localMatrix.m[i][j] = (i == j) ? 1.0f : 0.0f;
+    }
+  }
+  return node;
+}
+
+ModelAsset::ModelData MakeTerrain() {
+  ModelAsset::ModelData data;
+  data.vertices.reserve(kTerrainGrid * kTerrainGrid);
+  for (uint32_t z = 0; z < kTerrainGrid; ++z) {
+    for (uint32_t x = 0; x < kTerrainGrid; ++x) {
+      float fx = static_cast<float>(x);
+      float fz = static_cast<float>(z);
+      data.vertices.push_back({{fx, std::sin(fx * 0.1f) * std::cos(fz * 0.1f), fz, 1.0f},
+                               {fx / kTerrainGrid, fz / kTerrainGrid},
+                               {0.0f, 1.0f, 0.0f}});
+    }
+  }
+  for (uint32_t z = 0; z + 1 < kTerrainGrid; ++z) {
+    for (uint32_t x = 0; x + 1 < kTerrainGrid; ++x) {
+      uint32_t i = z * kTerrainGrid + x;
+      data.indices.insert(data.indices.end(), {i, i + kTerrainGrid, i + 1, i + 1,
+                                               i + kTerrainGrid, i + kTerrainGrid + 1});
+    }
+  }
+  data.materials = {{"resources/terrain/grass.png"}};
+  data.subMeshes = {{0, static_cast<uint32_t>(data.vertices.size()), 0,
+                     static_cast<uint32_t>(data.indices.size()), 0}};
+  data.rootNode = MakeNode("terrain");
+  return data;
+}
+
+ModelAsset::ModelData MakeSkinned() {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> range(-1.0f, 1.0f);
+
+  ModelAsset::ModelData data;
+  data.vertices.resize(kSkinnedVertices);
+  for (ModelAsset::VertexData &v : data.vertices) {
+    v = {{range(rng), range(rng), range(rng), 1.0f}, {range(rng), range(rng)}, {0.0f, 0.0f, 1.0f}};
+  }
+  for (uint32_t i = 0; i + 2 < kSkinnedVertices; i += 3) {
+    data.indices.insert(data.indices.end(), {i, i + 1, i + 2});
+  }
+  // 体と顔で2つのサブメッシュ・2つのマテリアル
+  data.materials = {{"resources/human/body.png"}, {"resources/human/face.png"}};
+  uint32_t half = static_cast<uint32_t>(data.indices.size()) / 6 * 3;
+  data.subMeshes = {{0, kSkinnedVertices, 0, half, 0},
+                    {0, kSkinnedVertices, half, static_cast<uint32_t>(data.indices.size()) - half, 1}};
+
+  // 背骨から枝分かれする階層（深さのあるノードツリー）
+  data.rootNode = MakeNode("Armature");
+  std::vector<ModelAsset::Node *> chain = {&data.rootNode};
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    ModelAsset::Node *parent = chain[j / 2];
+    parent->children.reserve(4);
+    parent->children.push_back(MakeNode("joint_" + std::to_string(j)));
+    parent->children.back().transform.translate = {range(rng), range(rng), range(rng)};
+    chain.push_back(&parent->children.back());
+  }
+
+  // 1頂点あたり4ジョイントの重み
+  for (uint32_t v = 0; v < kSkinnedVertices; ++v) {
+    for (uint32_t k = 0; k < 4; ++k) {
+      uint32_t joint = (v * 7 + k * 13) % kJointCount;
+      auto &weight = data.skinClusterData["joint_" + std::to_string(joint)];
+      weight.inverseBindPoseMatrix = data.rootNode.localMatrix;
+      weight.inverseBindPoseMatrix.m[3][0] = static_cast<float>(joint);
+      weight.vertexWeights.push_back({0.25f, v});
+    }
+  }
+  return data;
+}
+
+bool SameNode(const ModelAsset::Node &a, const ModelAsset::Node &b) {
+  if (a.name != b.name || a.children.size() != b.children.size() ||
+      std::memcmp(&a.transform, &b.transform, sizeof(a.transform)) != 0 ||
+      std::memcmp(&a.localMatrix, &b.localMatrix, sizeof(a.localMatrix)) != 0) {
+    return false;
+  }
+  for (size_t i = 0; i < a.children.size(); ++i) {
+    if (!SameNode(a.children[i], b.children[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameModel(const ModelAsset::ModelData &a, const ModelAsset::ModelData &b) {
+  if (a.vertices.size() != b.vertices.size() || a.indices != b.indices ||
+      a.materials.size() != b.materials.size() || a.subMeshes.size() != b.subMeshes.size() ||
+      a.skinClusterData.size() != b.skinClusterData.size() || !SameNode(a.rootNode, b.rootNode)) {
+    return false;
+  }
+  if (!a.vertices.empty() &&
+      std::memcmp(a.vertices.data(), b.vertices.data(),
+                  sizeof(ModelAsset::VertexData) * a.vertices.size()) != 0) {
+    return false;
+  }
+  for (size_t i = 0; i < a.materials.size(); ++i) {
+    if (a.materials[i].textureFilePath != b.materials[i].textureFilePath) {
+      return false;
+    }
+  }
+  if (!a.subMeshes.empty() && std::memcmp(a.subMeshes.data(), b.subMeshes.data(),
+                                          sizeof(ModelAsset::SubMesh) * a.subMeshes.size()) != 0) {
+    return false;
+  }
+  for (const auto &[name, joint] : a.skinClusterData) {
+    auto it = b.skinClusterData.find(name);
+    if (it == b.skinClusterData.end() || joint.vertexWeights.size() != it->second.vertexWeights.size() ||
+        std::memcmp(&joint.inverseBindPoseMatrix, &it->second.inverseBindPoseMatrix,
+                    sizeof(Matrix4x4)) != 0 ||
+        (!joint.vertexWeights.empty() &&
+         std::memcmp(joint.vertexWeights.data(), it->second.vertexWeights.data(),
+                     sizeof(ModelAsset::VertexWeightData) * joint.vertexWeights.size()) != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WriteText(const fs::path &path, const std::string &text) {
+  std::ofstream(path, std::ios::binary) << text;
+}
+
+// terrain.obj と同程度の大きさのテキスト（ハッシュ計測用）
+std::string MakeObjText(const ModelAsset::ModelData &data) {
+  std::string text = "mtllib terrain.mtl\n";
+  char line[128];
+  for (const ModelAsset::VertexData &v : data.vertices) {
+    std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn 0 1 0\n", v.position.x,
+                  v.position.y, v.position.z, v.texcoord.x, v.texcoord.y);
+    text += line;
+  }
+  for (size_t i = 0; i + 2 < data.indices.size(); i += 3) {
+    std::snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u\n", data.indices[i] + 1,
+                  data.indices[i] + 1, data.indices[i] + 1, data.indices[i + 1] + 1,
+                  data.indices[i + 1] + 1, data.indices[i + 1] + 1, data.indices[i + 2] + 1,
+                  data.indices[i + 2] + 1, data.indices[i + 2] + 1);
+    text += line;
+  }
+  return text;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "mesh_cache_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const fs::path root = fs::temp_directory_path() / "mesh_cache_benchmark";
+  fs::remove_all(root);
+  fs::create_directories(root / "resources" / "terrain");
+  MeshCache::SetCacheDirectory((root / "cache").generic_string());
+
+  const ModelAsset::ModelData terrain = MakeTerrain();
+  const ModelAsset::ModelData skinned = MakeSkinned();
+
+  const std::string objPath = (root / "resources" / "terrain" / "terrain.obj").generic_string();
+  const std::string mtlPath = (root / "resources" / "terrain" / "terrain.mtl").generic_string();
+  WriteText(objPath, MakeObjText(terrain));
+  WriteText(mtlPath, "newmtl grass\nmap_Kd grass.png\n");
+
+  const uint32_t flags = 0x1800008u; // Triangulate | FlipWindingOrder | FlipUVs と同じ値
+  const MeshCache::Key terrainKey{MeshCache::HashSourceFiles(objPath), flags};
+  const MeshCache::Key skinnedKey{0x1234abcdull, flags};
+  const std::string terrainCache = MeshCache::GetCachePath(objPath);
+  const std::string skinnedCache = MeshCache::GetCachePath("resources/human/walk.gltf");
+
+  //=========================
+  // 往復確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[MeshCache] %s\n", label);
+      ok = false;
+    }
+  };
+
+  ModelAsset::ModelData loaded;
+  check("save terrain", MeshCache::Save(terrainCache, terrainKey, terrain));
+  check("load terrain", MeshCache::Load(terrainCache, terrainKey, loaded));
+  check("terrain round trip", SameModel(terrain, loaded));
+
+  check("save skinned", MeshCache::Save(skinnedCache, skinnedKey, skinned));
+  check("load skinned", MeshCache::Load(skinnedCache, skinnedKey, loaded));
+  check("skinned round trip", SameModel(skinned, loaded));
+
+  ModelAsset::ModelData empty;
+  empty.rootNode = MakeNode("empty");
+  check("save empty", MeshCache::Save(skinnedCache + ".empty", skinnedKey, empty));
+  check("empty round trip", MeshCache::Load(skinnedCache + ".empty", skinnedKey, loaded) &&
+                                SameModel(empty, loaded));
+
+  // キーが違う・ファイルがない・壊れている場合は読まない
+  check("reject hash", !MeshCache::Load(terrainCache, {terrainKey.sourceHash + 1, flags}, loaded));
+  check("reject flags", !MeshCache::Load(terrainCache, {terrainKey.sourceHash, flags | 1u}, loaded));
+  check("reject missing", !MeshCache::Load(terrainCache + ".none", terrainKey, loaded));
+  {
+    fs::copy_file(skinnedCache, skinnedCache + ".cut");
+    fs::resize_file(skinnedCache + ".cut", fs::file_size(skinnedCache) - 5);
+    check("reject truncated", !MeshCache::Load(skinnedCache + ".cut", skinnedKey, loaded));
+
+    fs::copy_file(skinnedCache, skinnedCache + ".old");
+    std::fstream file(skinnedCache + ".old", std::ios::in | std::ios::out | std::ios::binary);
+    uint32_t version = MeshCache::kVersion + 1;
+    file.seekp(4);
+    file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    file.close();
+    check("reject version", !MeshCache::Load(skinnedCache + ".old", skinnedKey, loaded));
+
+    // 長さは合っていても、インデックスや重みが頂点の外を指すキャッシュは読まない（作り直させる）
+    ModelAsset::ModelData badIndex = skinned;
+    badIndex.indices[1] = static_cast<uint32_t>(badIndex.vertices.size());
+    check("save bad index", MeshCache::Save(skinnedCache + ".index", skinnedKey, badIndex));
+    check("reject index out of range", !MeshCache::Load(skinnedCache + ".index", skinnedKey, loaded));
+
+    ModelAsset::ModelData badWeight = skinned;
+    badWeight.skinClusterData.begin()->second.vertexWeights[0].vertexIndex = 0xffffffffu;
+    check("save bad weight", MeshCache::Save(skinnedCache + ".weight", skinnedKey, badWeight));
+    check("reject weight out of range", !MeshCache::Load(skinnedCache + ".weight", skinnedKey, loaded));
+  }
+  check("failed load keeps output", SameModel(empty, loaded));
+
+  // 元ファイル・付随ファイルを書き換えるとハッシュが変わる
+  WriteText(mtlPath, "newmtl grass\nmap_Kd rock.png\n");
+  check("mtl change invalidates", MeshCache::HashSourceFiles(objPath) != terrainKey.sourceHash);
+  WriteText(mtlPath, "newmtl grass\nmap_Kd grass.png\n");
+  check("hash is stable", MeshCache::HashSourceFiles(objPath) == terrainKey.sourceHash);
+  check("missing source", MeshCache::HashSourceFiles(objPath + ".none") == 0);
+  if (!ok) {
+    return 1;
+  }
+
+  std::printf("terrain: %zu vertices, %zu indices, cache %.1f KB, obj %.1f KB\n",
+              terrain.vertices.size(), terrain.indices.size(),
+              fs::file_size(terrainCache) / 1024.0, fs::file_size(objPath) / 1024.0);
+  std::printf("skinned: %zu vertices, %zu joints, cache %.1f KB\n\n", skinned.vertices.size(),
+              skinned.skinClusterData.size(), fs::file_size(skinnedCache) / 1024.0);
+
+  //=========================
+  // 計測
+  //=========================
+  runner.Run("MeshCache/HashSource(terrain.obj)", [&](uint64_t) {
+    uint64_t hash = MeshCache::HashSourceFiles(objPath);
+    Benchmark::DoNotOptimize(hash);
+  });
+
+  runner.Run("MeshCache/Load(terrain)", [&](uint64_t) {
+    ModelAsset::ModelData data;
+    bool r = MeshCache::Load(terrainCache, terrainKey, data);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MeshCache/Load(skinned)", [&](uint64_t) {
+    ModelAsset::ModelData data;
+    bool r = MeshCache::Load(skinnedCache, skinnedKey, data);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("MeshCache/Save(terrain)", [&](uint64_t) {
+    bool r = MeshCache::Save(terrainCache, terrainKey, terrain);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  fs::remove_all(root);
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,398 @@
+// 読み込み時のメッシュ最適化（MeshOptimizer）の確認とベンチマーク
+// 同梱の terrain.obj / suzanne.obj を ObjReader で読んだデータ（Assimp と同じく三角形ごとに頂点が別）と、
+// 三角形の順番がばらばらのグリッドで、結合数・ACMR/ATVR・オーバードロー・三角形の保存を確かめる
+//
+// ビルド例（Linux, project/ ディレクトリで実行。モデルは Application/resources から読む）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o mesh_optimizer_benchmark tools/Benchmark/MeshOptimizerBenchmark.cpp
+//       Engine/src/Render/Model/ModelAssetData.cpp Engine/src/Render/Model/MeshOptimizer.cpp
+//
+// 実行例:
+//   ./mesh_optimizer_benchmark --out mesh_optimizer_baseline.json
+//   ./mesh_optimizer_benchmark --baseline mesh_optimizer_baseline.json
+#include "BenchmarkCommon.h"
+#include "ObjReader.h"
+#include "Model/MeshOptimizer.h"
+#include "Model/ModelAssetData.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+
+const char *kResourceDirectory = "Application/resources";
+
+// Model::LoadModelFile と同じく、マテリアル順に結合したモデルにする
+bool LoadObj(const std::string &directoryPath, const std::string &filename, ModelAsset::ModelData &data) {
+  ObjReader::Scene scene;
+  if (!ObjReader::Read(directoryPath, filename, scene)) {
+    std::fprintf(stderr, "[MeshOptimizer] cannot open %s/%s (run from project/)\n", directoryPath.c_str(),
+                 filename.c_str());
+    return false;
+  }
+  std::vector<uint32_t> materialIndices;
+  for (const ObjReader::Mesh &mesh : scene.meshes) {
+    materialIndices.push_back(mesh.materialIndex);
+  }
+  data = {};
+  data.materials = scene.materials;
+  for (uint32_t meshIndex : ModelAsset::MakeMaterialOrder(materialIndices)) {
+    const ObjReader::Mesh &mesh = scene.meshes[meshIndex];
+    ModelAsset::AppendSubMesh(data, mesh.vertices, mesh.indices, mesh.materialIndex);
+  }
+  return true;
+}
+
+// 中身が同じ頂点の種類（結合後に残るはずの頂点数）
+uint32_t CountDistinctVertices(const ModelAsset::ModelData &data) {
+  std::vector<ModelAsset::VertexData> sorted = data.vertices;
+  auto less = [](const ModelAsset::VertexData &a, const ModelAsset::VertexData &b) {
+    return std::memcmp(&a, &b, sizeof(ModelAsset::VertexData)) < 0;
+  };
+  auto equal = [](const ModelAsset::VertexData &a, const ModelAsset::VertexData &b) {
+    return std::memcmp(&a, &b, sizeof(ModelAsset::VertexData)) == 0;
+  };
+  std::sort(sorted.begin(), sorted.end(), less);
+  return static_cast<uint32_t>(std::unique(sorted.begin(), sorted.end(), equal) - sorted.begin());
+}
+
+// オーバードロー（描いたピクセル数 / 覆ったピクセル数）。±X・±Y・±Z の6方向から平行投影し、
+// 深度テストありで描画順どおりにラスタライズする。法線が視線と逆を向く三角形は裏面として捨てる
+float AnalyzeOverdraw(const ModelAsset::ModelData &data) {
+  constexpr int32_t kResolution = 256;
+  Vector3 minimum{1e30f, 1e30f, 1e30f};
+  Vector3 maximum{-1e30f, -1e30f, -1e30f};
+  for (const ModelAsset::VertexData &vertex : data.vertices) {
+    minimum = {std::min(minimum.x, vertex.position.x), std::min(minimum.y, vertex.position.y),
+               std::min(minimum.z, vertex.position.z)};
+    maximum = {std::max(maximum.x, vertex.position.x), std::max(maximum.y, vertex.position.y),
+               std::max(maximum.z, vertex.position.z)};
+  }
+  const float extent = std::max({maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z, 1e-6f});
+  auto component = [](const Vector4 &p, int axis) { return axis == 0 ? p.x : (axis == 1 ? p.y : p.z); };
+  auto normalComponent = [](const Vector3 &n, int axis) { return axis == 0 ? n.x : (axis == 1 ? n.y : n.z); };
+  auto minimumComponent = [&](int axis) { return axis == 0 ? minimum.x : (axis == 1 ? minimum.y : minimum.z); };
+
+  uint64_t shaded = 0;
+  uint64_t covered = 0;
+  std::vector<float> depth(kResolution * kResolution);
+  for (int axis = 0; axis < 3; ++axis) {
+    const int uAxis = (axis + 1) % 3;
+    const int vAxis = (axis + 2) % 3;
+    for (float sign : {1.0f, -1.0f}) {
+      // 視点は sign 側の無限遠。depth が小さいほど手前
+      std::fill(depth.begin(), depth.end(), 1e30f);
+      for (size_t i = 0; i + 2 < data.indices.size(); i += 3) {
+        float x[3], y[3], z[3];
+        float facing = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+          const ModelAsset::VertexData &vertex = data.vertices[data.indices[i + k]];
+          x[k] = (component(vertex.position, uAxis) - minimumComponent(uAxis)) / extent * (kResolution - 1);
+          y[k] = (component(vertex.position, vAxis) - minimumComponent(vAxis)) / extent * (kResolution - 1);
+          z[k] = -sign * component(vertex.position, axis);
+          facing += sign * normalComponent(vertex.normal, axis);
+        }
+        if (facing <= 0.0f) {
+          continue;
+        }
+        const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (area == 0.0f) {
+          continue;
+        }
+        const int32_t left = std::max(0, static_cast<int32_t>(std::floor(std::min({x[0], x[1], x[2]}))));
+        const int32_t right = std::min(kResolution - 1, static_cast<int32_t>(std::ceil(std::max({x[0], x[1], x[2]}))));
+        const int32_t top = std::max(0, static_cast<int32_t>(std::floor(std::min({y[0], y[1], y[2]}))));
+        const int32_t bottom = std::min(kResolution - 1, static_cast<int32_t>(std::ceil(std::max({y[0], y[1], y[2]}))));
+        for (int32_t py = top; py <= bottom; ++py) {
+          for (int32_t px = left; px <= right; ++px) {
+            const float cx = static_cast<float>(px) + 0.5f;
+            const float cy = static_cast<float>(py) + 0.5f;
+            const float w0 = ((x[2] - x[1]) * (cy - y[1]) - (cx - x[1]) * (y[2] - y[1])) / area;
+            const float w1 = ((x[0] - x[2]) * (cy - y[2]) - (cx - x[2]) * (y[0] - y[2])) / area;
+            const float w2 = 1.0f - w0 - w1;
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+              continue;
+            }
+            const float d = w0 * z[0] + w1 * z[1] + w2 * z[2];
+            float &stored = depth[py * kResolution + px];
+            if (d < stored) {
+              covered += stored == 1e30f ? 1 : 0;
+              stored = d;
+              ++shaded;
+            }
+          }
+        }
+      }
+    }
+  }
+  return covered ? static_cast<float>(shaded) / static_cast<float>(covered) : 0.0f;
+}
+
+// grid x grid のマス（高さは波形）。soup なら三角形ごとに頂点を複製する（aiProcess_JoinIdenticalVertices なしの OBJ と同じ）
+ModelAsset::ModelData MakeTerrain(uint32_t grid, bool soup, bool shuffle, uint32_t seed) {
+  std::vector<ModelAsset::VertexData> vertices;
+  for (uint32_t z = 0; z <= grid; ++z) {
+    for (uint32_t x = 0; x <= grid; ++x) {
+      float fx = static_cast<float>(x);
+      float fz = static_cast<float>(z);
+      float height = std::sin(fx * 0.3f) * std::cos(fz * 0.2f);
+      vertices.push_back({{fx, height, fz, 1.0f},
+                          {fx / grid, fz / grid},
+                          {0.0f, 1.0f, 0.0f}});
+    }
+  }
+  std::vector<std::array<uint32_t, 3>> triangles;
+  for (uint32_t z = 0; z < grid; ++z) {
+    for (uint32_t x = 0; x < grid; ++x) {
+      uint32_t i = z * (grid + 1) + x;
+      triangles.push_back({i, i + grid + 1, i + 1});
+      triangles.push_back({i + 1, i + grid + 1, i + grid + 2});
+    }
+  }
+  if (shuffle) {
+    std::mt19937 rng(seed);
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+  }
+
+  std::vector<ModelAsset::VertexData> outVertices;
+  std::vector<uint32_t> outIndices;
+  for (const auto &triangle : triangles) {
+    for (uint32_t v : triangle) {
+      if (soup) {
+        outIndices.push_back(static_cast<uint32_t>(outVertices.size()));
+        outVertices.push_back(vertices[v]);
+      } else {
+        outIndices.push_back(v);
+      }
+    }
+  }
+  if (!soup) {
+    outVertices = vertices;
+  }
+
+  ModelAsset::ModelData data;
+  data.materials.resize(1);
+  ModelAsset::AppendSubMesh(data, outVertices, outIndices, 0);
+  return data;
+}
+
+// 2ジョイントで x 方向にウェイトを分ける（複製された頂点にも同じウェイトを付ける）
+void AddSkinWeights(ModelAsset::ModelData &data, float width) {
+  auto &left = data.skinClusterData["left"];
+  auto &right = data.skinClusterData["right"];
+  for (uint32_t v = 0; v < data.vertices.size(); ++v) {
+    float t = std::clamp(data.vertices[v].position.x / width, 0.0f, 1.0f);
+    left.vertexWeights.push_back({1.0f - t, v});
+    right.vertexWeights.push_back({t, v});
+  }
+}
+
+using TriangleKey = std::array<float, 9>;
+
+// 三角形を位置で表し、頂点の回り順を保ったまま先頭が最小になるよう回す
+std::vector<TriangleKey> CollectTriangles(const ModelAsset::ModelData &data) {
+  std::vector<TriangleKey> result;
+  for (size_t i = 0; i + 2 < data.indices.size(); i += 3) {
+    std::array<std::array<float, 3>, 3> corners;
+    for (int k = 0; k < 3; ++k) {
+      const Vector4 &p = data.vertices[data.indices[i + k]].position;
+      corners[k] = {p.x, p.y, p.z};
+    }
+    auto first = std::min_element(corners.begin(), corners.end());
+    std::rotate(corners.begin(), first, corners.end());
+    TriangleKey key;
+    for (int k = 0; k < 3; ++k) {
+      std::copy(corners[k].begin(), corners[k].end(), key.begin() + k * 3);
+    }
+    result.push_back(key);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+// 頂点ごとのウェイト合計（位置で引けるようにする）
+std::vector<std::pair<std::array<float, 3>, float>> CollectWeightSums(
+    const ModelAsset::ModelData &data) {
+  std::vector<float> sums(data.vertices.size(), 0.0f);
+  for (const auto &[name, joint] : data.skinClusterData) {
+    for (const ModelAsset::VertexWeightData &weight : joint.vertexWeights) {
+      sums[weight.vertexIndex] += weight.weight;
+    }
+  }
+  std::vector<std::pair<std::array<float, 3>, float>> result;
+  for (uint32_t v = 0; v < data.vertices.size(); ++v) {
+    const Vector4 &p = data.vertices[v].position;
+    result.push_back({{p.x, p.y, p.z}, sums[v]});
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+// maxAtvr は使う頂点1つあたりの実行回数の上限（面ごとに法線が違うモデルは ACMR が 3 近くから下がらないので、こちらで見る）
+bool Verify(const char *label, const ModelAsset::ModelData &source,
+            uint32_t expectedVertices, float maxAcmr, float maxAtvr = 3.0f) {
+  bool ok = true;
+  auto fail = [&](const std::string &message) {
+    std::fprintf(stderr, "[MeshOptimizer] %s: %s\n", label, message.c_str());
+    ok = false;
+  };
+
+  ModelAsset::ModelData data = source;
+  MeshOptimizer::Report report = MeshOptimizer::Optimize(data);
+
+  if (report.verticesAfter != expectedVertices || data.vertices.size() != expectedVertices) {
+    fail("expected " + std::to_string(expectedVertices) + " vertices after welding, got " +
+         std::to_string(data.vertices.size()));
+  }
+  if (data.subMeshes.size() != 1 || data.subMeshes[0].vertexCount != data.vertices.size() ||
+      data.subMeshes[0].indexCount != data.indices.size()) {
+    fail("submesh ranges were not updated");
+  }
+  // 同じ三角形（回り順込み）がちょうど同じ数だけ残る
+  if (CollectTriangles(data) != CollectTriangles(source)) {
+    fail("triangle set or winding changed");
+  }
+  if (report.after.acmr > report.before.acmr || report.after.acmr > maxAcmr) {
+    fail("ACMR did not improve enough (" + std::to_string(report.after.acmr) + ")");
+  }
+  if (report.after.atvr > maxAtvr) {
+    fail("ATVR is too high (" + std::to_string(report.after.atvr) + ")");
+  }
+  // 頂点は最初に使われる順に並ぶ
+  uint32_t nextVertex = 0;
+  for (uint32_t index : data.indices) {
+    if (index > nextVertex) {
+      fail("vertices are not in first-use order");
+      break;
+    }
+    if (index == nextVertex) {
+      ++nextVertex;
+    }
+  }
+  // スキンのウェイトは頂点ごとの合計が変わらない（結合で二重にならない）
+  if (!source.skinClusterData.empty() && CollectWeightSums(data) != CollectWeightSums(source)) {
+    fail("skin weights changed while welding");
+  }
+
+  std::printf("%-16s vertices %6u -> %6u  ACMR %.3f -> %.3f  ATVR %.3f -> %.3f\n", label,
+              report.verticesBefore, report.verticesAfter, report.before.acmr, report.after.acmr,
+              report.before.atvr, report.after.atvr);
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "mesh_optimizer_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const std::string &label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[MeshOptimizer] %s\n", label.c_str());
+      ok = false;
+    }
+  };
+  constexpr uint32_t kGrid = 32;
+  constexpr uint32_t kGridVertices = (kGrid + 1) * (kGrid + 1);
+
+  // OBJ の三角形の羅列: 結合で格子の頂点数まで減り、ACMR も下がる
+  ok &= Verify("soup", MakeTerrain(kGrid, true, false, 1), kGridVertices, 1.0f);
+  // 三角形の順番がばらばら: Tipsify で並べ直す
+  ok &= Verify("shuffled", MakeTerrain(kGrid, false, true, 2), kGridVertices, 1.0f);
+  // スキン付き: ウェイトが同じ頂点だけが結合され、ウェイトは二重にならない
+  {
+    ModelAsset::ModelData skinned = MakeTerrain(kGrid, true, true, 3);
+    AddSkinWeights(skinned, static_cast<float>(kGrid));
+    ok &= Verify("skinned soup", skinned, kGridVertices, 1.0f);
+
+    // ウェイトだけが違う頂点は結合しない
+    ModelAsset::ModelData split = MakeTerrain(1, true, false, 4);
+    auto &joint = split.skinClusterData["joint"];
+    for (uint32_t v = 0; v < split.vertices.size(); ++v) {
+      joint.vertexWeights.push_back({v < 3 ? 1.0f : 0.5f, v});
+    }
+    ok &= Verify("weight seam", split, 6, 3.0f);
+  }
+
+  // 同梱のモデル: 結合で中身が同じ頂点の種類まで減り、Tipsify で ACMR が下がる
+  // どちらも面ごとの法線（s off）なので結合できる頂点は少なく、ACMR ではなく ATVR が 1 に近いかを見る
+  // オーバードロー順は Tipsify だけのときよりオーバードローを増やさない
+  struct ObjCase {
+    const char *label;
+    std::string directoryPath;
+    const char *filename;
+  };
+  const ObjCase objCases[] = {
+      {"terrain.obj", std::string(kResourceDirectory) + "/terrain", "terrain.obj"},
+      {"suzanne.obj", kResourceDirectory, "suzanne.obj"},
+  };
+  for (const ObjCase &objCase : objCases) {
+    ModelAsset::ModelData model;
+    if (!LoadObj(objCase.directoryPath, objCase.filename, model)) {
+      return 1;
+    }
+    ok &= Verify(objCase.label, model, CountDistinctVertices(model), 3.0f, 1.1f);
+
+    MeshOptimizer::Options tipsifyOnly;
+    tipsifyOnly.optimizeOverdraw = false;
+    ModelAsset::ModelData tipsified = model;
+    MeshOptimizer::Optimize(tipsified, tipsifyOnly);
+    ModelAsset::ModelData optimized = model;
+    MeshOptimizer::Optimize(optimized);
+    const float overdrawBefore = AnalyzeOverdraw(model);
+    const float overdrawTipsify = AnalyzeOverdraw(tipsified);
+    const float overdrawAfter = AnalyzeOverdraw(optimized);
+    std::printf("%-16s overdraw %.3f -> %.3f (Tipsify only %.3f)\n", objCase.label, overdrawBefore,
+                overdrawAfter, overdrawTipsify);
+    check(std::string(objCase.label) + ": overdraw order made overdraw worse", overdrawAfter <= overdrawTipsify && overdrawAfter <= overdrawBefore);
+  }
+  if (!ok) {
+    return 1;
+  }
+  std::printf("\n");
+
+  //=========================
+  // 計測
+  //=========================
+  // 地形程度の大きさ（256x256 マス、約13万三角形）
+  ModelAsset::ModelData terrain = MakeTerrain(256, true, true, 5);
+  ModelAsset::ModelData optimizedTerrain = terrain;
+  MeshOptimizer::Optimize(optimizedTerrain);
+
+  runner.Run("MeshOptimizer/Optimize(terrain 256)", [&](uint64_t) {
+    ModelAsset::ModelData data = terrain;
+    MeshOptimizer::Report report = MeshOptimizer::Optimize(data);
+    Benchmark::DoNotOptimize(report.after.acmr);
+  });
+
+  ModelAsset::ModelData suzanne;
+  LoadObj(kResourceDirectory, "suzanne.obj", suzanne);
+  runner.Run("MeshOptimizer/Optimize(suzanne.obj)", [&](uint64_t) {
+    ModelAsset::ModelData data = suzanne;
+    MeshOptimizer::Report report = MeshOptimizer::Optimize(data);
+    Benchmark::DoNotOptimize(report.after.acmr);
+  });
+
+  runner.Run("MeshOptimizer/AnalyzeVertexCache(before)", [&](uint64_t) {
+    MeshOptimizer::CacheStats stats = MeshOptimizer::AnalyzeVertexCache(
+        terrain.indices, static_cast<uint32_t>(terrain.vertices.size()));
+    Benchmark::DoNotOptimize(stats.acmr);
+  });
+
+  runner.Run("MeshOptimizer/AnalyzeVertexCache(after)", [&](uint64_t) {
+    MeshOptimizer::CacheStats stats = MeshOptimizer::AnalyzeVertexCache(
+        optimizedTerrain.indices, static_cast<uint32_t>(optimizedTerrain.vertices.size()));
+    Benchmark::DoNotOptimize(stats.acmr);
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
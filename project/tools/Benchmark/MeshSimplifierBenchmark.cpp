@@ -0,0 +1,412 @@
+// QEM による LOD 生成（MeshSimplifier）と LOD 選択（ModelAsset::SelectLod）の確認とベンチマーク
+// 同梱の suzanne.obj（ObjReader で読む）と、UV の継ぎ目を持つ凸凹の球・平面で確かめる
+//
+// ビルド例（Linux, project/ ディレクトリで実行。モデルは Application/resources から読む）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o mesh_simplifier_benchmark tools/Benchmark/MeshSimplifierBenchmark.cpp
+//       Engine/src/Render/Model/ModelAssetData.cpp Engine/src/Render/Model/MeshOptimizer.cpp
+//       Engine/src/Render/Model/MeshSimplifier.cpp Engine/src/Render/Model/MeshCache.cpp
+//
+// 実行例:
+//   ./mesh_simplifier_benchmark --out mesh_simplifier_baseline.json
+//   ./mesh_simplifier_benchmark --baseline mesh_simplifier_baseline.json
+#include "BenchmarkCommon.h"
+#include "ObjReader.h"
+#include "Math/MathUtil.h"
+#include "Model/MeshCache.h"
+#include "Model/MeshOptimizer.h"
+#include "Model/MeshSimplifier.h"
+#include "Model/ModelAssetData.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <numbers>
+
+namespace {
+
+const char *kResourceDirectory = "Application/resources";
+
+// Model::LoadModelFile と同じく、マテリアル順に結合して最適化したモデルにする（LOD はこの後に作る）
+// smoothNormals なら位置ごとに法線を平均する（Blender でスムーズシェードにして書き出したのと同じ）
+bool LoadObj(const std::string &directoryPath, const std::string &filename, bool smoothNormals,
+             ModelAsset::ModelData &data) {
+  ObjReader::Scene scene;
+  if (!ObjReader::Read(directoryPath, filename, scene)) {
+    std::fprintf(stderr, "[MeshSimplifier] cannot open %s/%s (run from project/)\n", directoryPath.c_str(),
+                 filename.c_str());
+    return false;
+  }
+  std::vector<uint32_t> materialIndices;
+  for (const ObjReader::Mesh &mesh : scene.meshes) {
+    materialIndices.push_back(mesh.materialIndex);
+  }
+  data = {};
+  data.materials = scene.materials;
+  for (uint32_t meshIndex : ModelAsset::MakeMaterialOrder(materialIndices)) {
+    const ObjReader::Mesh &mesh = scene.meshes[meshIndex];
+    ModelAsset::AppendSubMesh(data, mesh.vertices, mesh.indices, mesh.materialIndex);
+  }
+  if (smoothNormals) {
+    std::map<std::array<float, 3>, Vector3> sums;
+    for (const ModelAsset::VertexData &vertex : data.vertices) {
+      Vector3 &sum = sums[{vertex.position.x, vertex.position.y, vertex.position.z}];
+      sum = sum + vertex.normal;
+    }
+    for (ModelAsset::VertexData &vertex : data.vertices) {
+      vertex.normal = Normalize(sums[{vertex.position.x, vertex.position.y, vertex.position.z}]);
+    }
+  }
+  MeshOptimizer::Optimize(data);
+  return true;
+}
+
+// 経度方向の継ぎ目（u = 0 と 1）で頂点が分かれた、表面に凹凸のある球
+ModelAsset::ModelData MakeBumpySphere(uint32_t slices, uint32_t stacks, float bump) {
+  std::vector<ModelAsset::VertexData> vertices;
+  for (uint32_t j = 0; j <= stacks; ++j) {
+    float v = static_cast<float>(j) / stacks;
+    float theta = v * std::numbers::pi_v<float>;
+    for (uint32_t i = 0; i <= slices; ++i) {
+      float u = static_cast<float>(i) / slices;
+      float phi = u * 2.0f * std::numbers::pi_v<float>;
+      float radius = 1.0f + bump * std::sin(phi * 3.0f) * std::sin(theta * 4.0f);
+      Vector3 normal = {std::sin(theta) * std::cos(phi), std::cos(theta),
+                        std::sin(theta) * std::sin(phi)};
+      // 極は経度によらず同じ位置にする（継ぎ目と同じく位置が重なる頂点になる）
+      if (j == 0 || j == stacks) {
+        normal = {0.0f, j == 0 ? 1.0f : -1.0f, 0.0f};
+      }
+      vertices.push_back({{normal.x * radius, normal.y * radius, normal.z * radius, 1.0f},
+                          {u, v},
+                          normal});
+    }
+  }
+  std::vector<uint32_t> indices;
+  for (uint32_t j = 0; j < stacks; ++j) {
+    for (uint32_t i = 0; i < slices; ++i) {
+      uint32_t a = j * (slices + 1) + i;
+      uint32_t b = a + slices + 1;
+      if (j != 0) {
+        indices.insert(indices.end(), {a, a + 1, b});
+      }
+      if (j != stacks - 1) {
+        indices.insert(indices.end(), {a + 1, b + 1, b});
+      }
+    }
+  }
+  ModelAsset::ModelData data;
+  data.materials.resize(1);
+  ModelAsset::AppendSubMesh(data, vertices, indices, 0);
+  MeshOptimizer::Optimize(data);
+  return data;
+}
+
+ModelAsset::ModelData MakePlane(uint32_t grid) {
+  std::vector<ModelAsset::VertexData> vertices;
+  for (uint32_t z = 0; z <= grid; ++z) {
+    for (uint32_t x = 0; x <= grid; ++x) {
+      float fx = static_cast<float>(x) / grid;
+      float fz = static_cast<float>(z) / grid;
+      vertices.push_back({{fx, 0.0f, fz, 1.0f}, {fx, fz}, {0.0f, 1.0f, 0.0f}});
+    }
+  }
+  std::vector<uint32_t> indices;
+  for (uint32_t z = 0; z < grid; ++z) {
+    for (uint32_t x = 0; x < grid; ++x) {
+      uint32_t i = z * (grid + 1) + x;
+      indices.insert(indices.end(), {i, i + grid + 1, i + 1, i + 1, i + grid + 1, i + grid + 2});
+    }
+  }
+  ModelAsset::ModelData data;
+  data.materials.resize(1);
+  ModelAsset::AppendSubMesh(data, vertices, indices, 0);
+  return data;
+}
+
+Vector3 ToVector3(const Vector4 &v) { return {v.x, v.y, v.z}; }
+
+// 点と三角形の最短距離（Ericson, Real-Time Collision Detection 5.1.5）
+float PointTriangleDistance(const Vector3 &p, const Vector3 &a, const Vector3 &b, const Vector3 &c) {
+  Vector3 ab = b - a, ac = c - a, ap = p - a;
+  float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+  auto distance = [&](const Vector3 &q) { return Length(p - q); };
+  auto along = [](const Vector3 &o, const Vector3 &dir, float t) {
+    return Vector3{o.x + dir.x * t, o.y + dir.y * t, o.z + dir.z * t};
+  };
+  if (d1 <= 0.0f && d2 <= 0.0f) return distance(a);
+  Vector3 bp = p - b;
+  float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+  if (d3 >= 0.0f && d4 <= d3) return distance(b);
+  float vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return distance(along(a, ab, d1 / (d1 - d3)));
+  Vector3 cp = p - c;
+  float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+  if (d6 >= 0.0f && d5 <= d6) return distance(c);
+  float vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return distance(along(a, ac, d2 / (d2 - d6)));
+  float va = d3 * d6 - d5 * d4;
+  if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+    return distance(along(b, c - b, (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+  }
+  float denom = 1.0f / (va + vb + vc);
+  float v = vb * denom, w = vc * denom;
+  return distance({a.x + ab.x * v + ac.x * w, a.y + ab.y * v + ac.y * w, a.z + ab.z * v + ac.z * w});
+}
+
+// 元の頂点から簡略化後の面までの最大距離（片側ハウスドルフ距離）
+float MeasureDeviation(const ModelAsset::ModelData &data, const ModelAsset::SubMesh &lod) {
+  const ModelAsset::SubMesh &base = data.subMeshes[0];
+  float worst = 0.0f;
+  for (uint32_t v = base.vertexOffset; v < base.vertexOffset + base.vertexCount; ++v) {
+    Vector3 p = ToVector3(data.vertices[v].position);
+    float nearest = 1e30f;
+    for (uint32_t i = lod.indexOffset; i < lod.indexOffset + lod.indexCount; i += 3) {
+      nearest = std::min(nearest, PointTriangleDistance(
+                                      p, ToVector3(data.vertices[data.indices[i]].position),
+                                      ToVector3(data.vertices[data.indices[i + 1]].position),
+                                      ToVector3(data.vertices[data.indices[i + 2]].position)));
+    }
+    worst = std::max(worst, nearest);
+  }
+  return worst;
+}
+
+bool VerifyLods(const char *label, ModelAsset::ModelData data,
+                const MeshSimplifier::LodSettings &settings, size_t minLods) {
+  bool ok = true;
+  auto fail = [&](const std::string &message) {
+    std::fprintf(stderr, "[MeshSimplifier] %s: %s\n", label, message.c_str());
+    ok = false;
+  };
+
+  MeshSimplifier::GenerateLods(data, settings);
+  const float extent = MeshSimplifier::ComputeExtent(data.vertices);
+  const ModelAsset::SubMesh &base = data.subMeshes[0];
+  if (data.lods.size() < minLods) {
+    fail("expected at least " + std::to_string(minLods) + " LODs, got " +
+         std::to_string(data.lods.size()));
+  }
+
+  std::printf("%-14s LOD0 %6u triangles\n", label, base.indexCount / 3);
+  uint32_t previous = base.indexCount;
+  for (size_t level = 0; level < data.lods.size(); ++level) {
+    const ModelAsset::MeshLod &lod = data.lods[level];
+    const ModelAsset::SubMesh &subMesh = lod.subMeshes[0];
+    float ratio = float(subMesh.indexCount) / float(base.indexCount);
+    float deviation = MeasureDeviation(data, subMesh) / extent;
+    std::printf("%-14s LOD%zu %6u triangles (%.3f, target %.3f)  bound %.4f  measured %.4f"
+                "  (limit %.4f)\n",
+                label, level + 1, subMesh.indexCount / 3, ratio, settings.targetRatios[level],
+                lod.error, deviation, settings.maxErrors[level]);
+
+    // 三角形は LOD ごとに減り、目標比まで届かないのは誤差の上限で止まったときだけ
+    if (subMesh.indexCount >= previous) {
+      fail("LOD" + std::to_string(level + 1) + " does not reduce triangles");
+    }
+    if (ratio > settings.targetRatios[level] * 1.05f &&
+        lod.error < settings.maxErrors[level] * 0.5f) {
+      fail("LOD" + std::to_string(level + 1) + " stopped early without reaching the error bound");
+    }
+    // 誤差は上限以内で、実測のずれはその誤差（距離の上限）を超えない
+    if (lod.error > settings.maxErrors[level] || deviation > lod.error || deviation > settings.maxErrors[level]) {
+      fail("LOD" + std::to_string(level + 1) + " exceeds the error bound");
+    }
+    if (subMesh.vertexOffset != base.vertexOffset || subMesh.vertexCount != base.vertexCount ||
+        subMesh.indexOffset < base.indexOffset + base.indexCount) {
+      fail("LOD" + std::to_string(level + 1) + " range is wrong");
+    }
+    for (uint32_t i = subMesh.indexOffset; i < subMesh.indexOffset + subMesh.indexCount; ++i) {
+      if (data.indices[i] < base.vertexOffset ||
+          data.indices[i] >= base.vertexOffset + base.vertexCount) {
+        fail("LOD" + std::to_string(level + 1) + " index outside the vertex range");
+        break;
+      }
+    }
+    previous = subMesh.indexCount;
+  }
+
+  // 作り直しても LOD のインデックスが積み重ならない
+  size_t indexCount = data.indices.size();
+  MeshSimplifier::GenerateLods(data, settings);
+  if (data.indices.size() != indexCount) {
+    fail("regenerating LODs appended indices twice");
+  }
+  return ok;
+}
+
+// 画面サイズを 1 から 0 へ、また 1 へ動かしたときの LOD の切り替え
+bool VerifySelection() {
+  bool ok = true;
+  std::vector<ModelAsset::MeshLod> lods = {{0.0f, 0.35f, {}}, {0.0f, 0.15f, {}}, {0.0f, 0.06f, {}}};
+  constexpr float kHysteresis = 0.15f;
+
+  uint32_t lod = 0;
+  uint32_t switches = 0;
+  for (float size = 1.0f; size > 0.0f; size -= 0.001f) {
+    uint32_t next = ModelAsset::SelectLod(lods, size, lod, kHysteresis);
+    switches += next != lod;
+    lod = next;
+  }
+  if (lod != 3 || switches != 3) {
+    std::fprintf(stderr, "[MeshSimplifier] shrinking: lod %u after %u switches\n", lod, switches);
+    ok = false;
+  }
+  // しきい値付近で揺れても切り替わらない
+  lod = 1;
+  switches = 0;
+  for (int frame = 0; frame < 100; ++frame) {
+    float size = 0.35f + ((frame % 2) ? 0.04f : -0.04f);
+    uint32_t next = ModelAsset::SelectLod(lods, size, lod, kHysteresis);
+    switches += next != lod;
+    lod = next;
+  }
+  if (switches != 0) {
+    std::fprintf(stderr, "[MeshSimplifier] LOD flickered %u times near a threshold\n", switches);
+    ok = false;
+  }
+  // 大きく動いたときは1フレームで飛ぶ
+  if (ModelAsset::SelectLod(lods, 0.01f, 0, kHysteresis) != 3 ||
+      ModelAsset::SelectLod(lods, 0.9f, 3, kHysteresis) != 0 ||
+      ModelAsset::SelectLod({}, 0.01f, 2, kHysteresis) != 0) {
+    std::fprintf(stderr, "[MeshSimplifier] LOD selection did not jump to the right level\n");
+    ok = false;
+  }
+  // 距離が倍になれば投影サイズは半分
+  float nearSize = ModelAsset::ProjectedScreenSize(1.0f, 10.0f, 1.0f / std::tan(0.225f));
+  float farSize = ModelAsset::ProjectedScreenSize(1.0f, 20.0f, 1.0f / std::tan(0.225f));
+  if (std::abs(nearSize - farSize * 2.0f) > 1e-5f ||
+      ModelAsset::ProjectedScreenSize(2.0f, 1.0f, 1.0f) != 1.0f) {
+    std::fprintf(stderr, "[MeshSimplifier] projected size is wrong\n");
+    ok = false;
+  }
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options =
+      Benchmark::ParseOptions(argc, argv, "mesh_simplifier_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  MeshSimplifier::LodSettings settings;
+
+  ModelAsset::ModelData sphere = MakeBumpySphere(64, 32, 0.08f);
+  ok &= VerifyLods("sphere", sphere, settings, 3);
+  ModelAsset::ModelData plane = MakePlane(32);
+  ok &= VerifyLods("plane", plane, settings, 3);
+
+  // suzanne.obj はフラットシェード（面ごとに法線が別）なので、どの頂点も法線の継ぎ目にあって動かせない
+  // LOD は作られず、LOD0 のインデックスもそのまま残る
+  ModelAsset::ModelData suzanne;
+  ModelAsset::ModelData smoothSuzanne;
+  if (!LoadObj(kResourceDirectory, "suzanne.obj", false, suzanne) ||
+      !LoadObj(kResourceDirectory, "suzanne.obj", true, smoothSuzanne)) {
+    return 1;
+  }
+  {
+    ModelAsset::ModelData data = suzanne;
+    MeshSimplifier::GenerateLods(data, settings);
+    std::printf("%-14s LOD0 %6u triangles, flat shaded -> %zu LODs\n", "suzanne", data.subMeshes[0].indexCount / 3,
+                data.lods.size());
+    if (!data.lods.empty() || data.indices != suzanne.indices) {
+      std::fprintf(stderr, "[MeshSimplifier] flat shaded suzanne: seams were collapsed\n");
+      ok = false;
+    }
+  }
+  // 同じ形をスムーズシェードにすれば、UV の継ぎ目以外は縮約できる
+  // 耳や眉のような薄い部分は面積が小さく平均に効きにくいので、最大のずれは上限の 3 倍近くまで出る
+  ok &= VerifyLods("smooth suzanne", smoothSuzanne, settings, 3);
+  ok &= VerifySelection();
+
+  // 誤差の上限を 0 にすると、平面以外はほとんど減らせないので LOD を作らない
+  {
+    MeshSimplifier::LodSettings strict = settings;
+    strict.maxErrors = {0.0f, 0.0f, 0.0f};
+    ModelAsset::ModelData data = sphere;
+    MeshSimplifier::GenerateLods(data, strict);
+    if (!data.lods.empty()) {
+      std::fprintf(stderr, "[MeshSimplifier] zero error bound still produced LODs\n");
+      ok = false;
+    }
+  }
+
+  // LOD はメッシュキャッシュを通しても残る
+  {
+    namespace fs = std::filesystem;
+    ModelAsset::ModelData data = sphere;
+    MeshSimplifier::GenerateLods(data, settings);
+    const fs::path cacheDir = fs::temp_directory_path() / "mesh_simplifier_benchmark";
+    MeshCache::SetCacheDirectory(cacheDir.generic_string());
+    const std::string cachePath = MeshCache::GetCachePath("resources/sphere.obj");
+    ModelAsset::ModelData loaded;
+    bool roundTrip = MeshCache::Save(cachePath, {1, 2}, data) &&
+                     MeshCache::Load(cachePath, {1, 2}, loaded) &&
+                     loaded.lods.size() == data.lods.size() &&
+                     loaded.indices == data.indices;
+    for (size_t i = 0; roundTrip && i < data.lods.size(); ++i) {
+      roundTrip = loaded.lods[i].error == data.lods[i].error &&
+                  loaded.lods[i].subMeshes.size() == data.lods[i].subMeshes.size() &&
+                  loaded.lods[i].subMeshes[0].indexOffset == data.lods[i].subMeshes[0].indexOffset;
+    }
+    fs::remove_all(cacheDir);
+    if (!roundTrip) {
+      std::fprintf(stderr, "[MeshSimplifier] mesh cache lost the LODs\n");
+      ok = false;
+    }
+  }
+  if (!ok) {
+    return 1;
+  }
+  std::printf("\n");
+
+  //=========================
+  // 計測
+  //=========================
+  // 読み込み時のコスト（suzanne 程度と、その 4 倍の細かさ）
+  ModelAsset::ModelData small = MakeBumpySphere(48, 24, 0.08f);
+  ModelAsset::ModelData large = MakeBumpySphere(128, 64, 0.08f);
+  std::printf("small %zu triangles, large %zu triangles\n\n", small.indices.size() / 3,
+              large.indices.size() / 3);
+
+  runner.Run("MeshSimplifier/GenerateLods(small)", [&](uint64_t) {
+    ModelAsset::ModelData data = small;
+    MeshSimplifier::GenerateLods(data, settings);
+    Benchmark::DoNotOptimize(data.indices.data());
+  });
+
+  runner.Run("MeshSimplifier/GenerateLods(large)", [&](uint64_t) {
+    ModelAsset::ModelData data = large;
+    MeshSimplifier::GenerateLods(data, settings);
+    Benchmark::DoNotOptimize(data.indices.data());
+  });
+
+  runner.Run("MeshSimplifier/GenerateLods(smooth suzanne)", [&](uint64_t) {
+    ModelAsset::ModelData data = smoothSuzanne;
+    MeshSimplifier::GenerateLods(data, settings);
+    Benchmark::DoNotOptimize(data.indices.data());
+  });
+
+  const float largeError = settings.maxErrors[1] * MeshSimplifier::ComputeExtent(large.vertices);
+  runner.Run("MeshSimplifier/Simplify(large, 25%)", [&](uint64_t) {
+    MeshSimplifier::Result result = MeshSimplifier::Simplify(
+        large.indices, large.vertices, large.indices.size() / 4, largeError);
+    Benchmark::DoNotOptimize(result.indices.data());
+  });
+
+  std::vector<ModelAsset::MeshLod> lods = {{0.0f, 0.35f, {}}, {0.0f, 0.15f, {}}, {0.0f, 0.06f, {}}};
+  runner.Run("MeshSimplifier/SelectLod", [&](uint64_t iteration) {
+    float size = static_cast<float>(iteration % 1000) * 0.001f;
+    Benchmark::DoNotOptimize(ModelAsset::SelectLod(lods, size, 1, 0.15f));
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+// モデルの境界（ModelBounds）の確認とベンチマーク
+// AnimatedCube.gltf（ノードアニメーション）と human/sneakWalk.gltf（スキンメッシュ）を読み、
+// サブメッシュの境界・TransformAABB・Joint ごとの境界から作るアニメーション中の境界が、実際の頂点を全部包むかを確かめる
+// Assimp を使わずに確かめるため、ここでは GltfReader で glTF を直接読む
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -pthread -IEngine/include -IEngine/include/Render -Iexternals
+//       -o model_bounds_benchmark tools/Benchmark/ModelBoundsBenchmark.cpp
+//       Engine/src/Render/Model/ModelBounds.cpp Engine/src/Render/Model/ModelAssetData.cpp
+//       Engine/src/Render/Model/AnimationBlend.cpp Engine/src/Render/Model/Skeleton.cpp
+//       Engine/src/Render/Model/Skinning.cpp Engine/src/Render/Model/CompressedAnimation.cpp
+//       Engine/src/Render/Model/AnimationSampler.cpp Engine/src/Util/TaskPool.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./model_bounds_benchmark --out model_bounds_baseline.json
+//   ./model_bounds_benchmark --baseline model_bounds_baseline.json
+#include "BenchmarkCommon.h"
+#include "GltfReader.h"
+#include "Model/AnimationBlend.h"
+#include "Model/ModelBounds.h"
+#include "Model/Skinning.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char *kAnimatedCubePath = "Application/resources/AnimatedCube/AnimatedCube.gltf";
+const char *kHumanPath = "Application/resources/human/sneakWalk.gltf";
+
+bool Contains(const AABB &box, const Vector3 &point, float epsilon) {
+  return point.x >= box.min.x - epsilon && point.y >= box.min.y - epsilon && point.z >= box.min.z - epsilon &&
+         point.x <= box.max.x + epsilon && point.y <= box.max.y + epsilon && point.z <= box.max.z + epsilon;
+}
+
+bool Contains(const Sphere &sphere, const Vector3 &point, float epsilon) {
+  return Length(point - sphere.center) <= sphere.radius + epsilon;
+}
+
+Vector3 ToVector3(const Vector4 &v) { return {v.x, v.y, v.z}; }
+
+Vector3 TransformPoint(const Vector3 &p, const Matrix4x4 &m) {
+  return {p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+          p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+          p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2]};
+}
+
+AABB PointsAABB(const std::vector<ModelAsset::VertexData> &vertices) {
+  return ModelBounds::Compute(vertices).aabb;
+}
+
+float Volume(const AABB &box) {
+  return (box.max.x - box.min.x) * (box.max.y - box.min.y) * (box.max.z - box.min.z);
+}
+
+float Extent(const AABB &box) { return Length(box.max - box.min); }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "model_bounds_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  GltfReader cubeReader;
+  GltfReader humanReader;
+  if (!cubeReader.Open(kAnimatedCubePath) || !humanReader.Open(kHumanPath)) {
+    std::fprintf(stderr, "[ModelBounds] run from project/ (could not open %s or %s)\n", kAnimatedCubePath,
+                 kHumanPath);
+    return 1;
+  }
+  const GltfModel cube = cubeReader.Read();
+  GltfModel human = humanReader.Read();
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[ModelBounds] %s\n", label);
+      ok = false;
+    }
+  };
+
+  {
+    // TransformAABB は8頂点を変換して包んだものと同じ
+    const AABB box = {{-1.0f, -2.0f, 0.5f}, {3.0f, 1.0f, 2.0f}};
+    const Matrix4x4 matrix = MakeAffineMatrix(Vector3{2.0f, 0.5f, 1.5f}, Vector3{0.3f, -0.5f, 1.1f}, Vector3{4.0f, -1.0f, 2.0f});
+    AABB expected = {{1e30f, 1e30f, 1e30f}, {-1e30f, -1e30f, -1e30f}};
+    for (int corner = 0; corner < 8; ++corner) {
+      Vector3 p = {corner & 1 ? box.max.x : box.min.x, corner & 2 ? box.max.y : box.min.y,
+                   corner & 4 ? box.max.z : box.min.z};
+      Vector3 q = TransformPoint(p, matrix);
+      expected = ModelBounds::Union(expected, {q, q});
+    }
+    const AABB actual = TransformAABB(box, matrix);
+    check("transform aabb", Length(actual.min - expected.min) < 1e-4f && Length(actual.max - expected.max) < 1e-4f);
+    check("sphere of aabb", Contains(ModelBounds::MakeSphere(box), box.min, 1e-5f) &&
+                                Contains(ModelBounds::MakeSphere(box), box.max, 1e-5f));
+  }
+
+  {
+    // サブメッシュの境界は自分の頂点を包み、合わせるとモデル全体の境界になる
+    const ModelAsset::ModelData &data = cube.modelData;
+    const BoundingVolume whole = ModelBounds::Compute(data.vertices);
+    const std::vector<BoundingVolume> subMeshes = ModelBounds::ComputeSubMeshes(data);
+    check("submesh count", subMeshes.size() == data.subMeshes.size() && !subMeshes.empty());
+    AABB merged = subMeshes.empty() ? AABB{} : subMeshes[0].aabb;
+    bool contained = true;
+    for (size_t s = 0; s < subMeshes.size(); ++s) {
+      merged = ModelBounds::Union(merged, subMeshes[s].aabb);
+      for (uint32_t v = 0; v < data.subMeshes[s].vertexCount; ++v) {
+        Vector3 p = ToVector3(data.vertices[data.subMeshes[s].vertexOffset + v].position);
+        contained = contained && Contains(subMeshes[s].aabb, p, 0.0f) && Contains(subMeshes[s].sphere, p, 1e-5f);
+      }
+    }
+    check("submesh contains vertices", contained);
+    check("submeshes merge to whole", std::memcmp(&merged, &whole.aabb, sizeof(AABB)) == 0);
+    // AnimatedCube は ±1 の立方体
+    check("cube bounds", Length(whole.aabb.min - Vector3{-1.0f, -1.0f, -1.0f}) < 1e-5f &&
+                             Length(whole.aabb.max - Vector3{1.0f, 1.0f, 1.0f}) < 1e-5f);
+    check("no joint bounds without skin", ModelBounds::ComputeJointBounds(data).aabbs.empty());
+  }
+
+  {
+    // ノードアニメーション：ルートノードの行列で変換した境界が、変換した頂点を全部包む
+    const ModelAsset::ModelData &data = cube.modelData;
+    const BoundingVolume local = ModelBounds::Compute(data.vertices);
+    const Animation &animation = cube.animations.at(0);
+    const NodeAnimation &rootAnimation = animation.nodeAnimations.begin()->second;
+    NodeAnimationCursor cursor;
+    bool contained = true;
+    for (uint32_t step = 0; step <= 120; ++step) {
+      const float time = animation.duration * step / 120.0f;
+      Quaternion rotate = SampleKeyframes(rootAnimation.rotate.keyframes, time, cursor.rotate);
+      const Matrix4x4 world = Multiply(MakeAffineMatrix({1.0f, 1.0f, 1.0f}, rotate, {0.0f, 0.0f, 0.0f}),
+                                       MakeAffineMatrix({2.0f, 2.0f, 2.0f}, Quaternion{0.0f, 0.0f, 0.0f, 1.0f},
+                                                        {5.0f, 0.0f, -3.0f}));
+      const AABB worldAABB = TransformAABB(local.aabb, world);
+      const Sphere worldSphere = TransformSphere(local.sphere, world);
+      for (const ModelAsset::VertexData &vertex : data.vertices) {
+        Vector3 p = TransformPoint(ToVector3(vertex.position), world);
+        contained = contained && Contains(worldAABB, p, 1e-4f) && Contains(worldSphere, p, 1e-4f);
+      }
+    }
+    check("node animated cube", contained);
+  }
+
+  // スキンメッシュ
+  const Skeleton bindSkeleton = [&] {
+    Skeleton skeleton = CreateSkeleton(human.modelData.rootNode);
+    Update(skeleton);
+    return skeleton;
+  }();
+  const JointBounds jointBounds = ModelBounds::ComputeJointBounds(human.modelData);
+  const std::vector<int32_t> jointIndices = ModelBounds::ResolveJoints(jointBounds, bindSkeleton);
+  std::vector<Matrix4x4> inverseBindPose(bindSkeleton.joints.size(), MakeIdentity4x4());
+  for (const auto &[name, jointWeight] : human.modelData.skinClusterData) {
+    inverseBindPose[bindSkeleton.jointMap.at(name)] = jointWeight.inverseBindPoseMatrix;
+  }
+  for (VertexInfluence &influence : human.influences) {
+    for (int32_t &joint : influence.jointIndices) {
+      joint = bindSkeleton.jointMap.at(human.skinJointNames[joint]);
+    }
+  }
+  const std::vector<ModelAsset::VertexData> &bindVertices = human.modelData.vertices;
+  const AABB bindAABB = PointsAABB(bindVertices);
+  const float tolerance = Extent(bindAABB) * 1e-4f;
+  std::vector<WellForGPU> palette(bindSkeleton.joints.size());
+  std::vector<ModelAsset::VertexData> skinned(bindVertices.size());
+  auto skin = [&](const Skeleton &skeleton) {
+    Skinning::BuildPalette(inverseBindPose.data(), skeleton.skeletonSpaceMatrices.data(), skeleton.joints.size(),
+                           palette.data());
+    Skinning::SkinVertices(palette.data(), bindVertices.data(), human.influences.data(), bindVertices.size(),
+                           skinned.data());
+  };
+
+  {
+    check("human joint bounds", !jointBounds.aabbs.empty() &&
+                                    std::find(jointIndices.begin(), jointIndices.end(), -1) == jointIndices.end());
+
+    // バインドポーズでスキニングすると元の頂点に戻る（読み込みの行列の向きの確認）
+    skin(bindSkeleton);
+    float bindError = 0.0f;
+    for (size_t v = 0; v < bindVertices.size(); ++v) {
+      bindError = std::max(bindError, Length(ToVector3(skinned[v].position) - ToVector3(bindVertices[v].position)));
+    }
+    check("bind pose round trip", bindError < tolerance);
+    const AABB bindSkinned =
+        ModelBounds::ComputeSkinnedAABB(jointBounds, jointIndices, bindSkeleton.skeletonSpaceMatrices.data());
+    check("bind pose bounds", Contains(bindSkinned, bindAABB.min, tolerance) &&
+                                  Contains(bindSkinned, bindAABB.max, tolerance));
+  }
+
+  const Animation &walk = human.animations.at(0);
+  const AnimationClip walkClip = MakeAnimationClip(bindSkeleton, walk);
+  double worstVolumeRatio = 0.0;
+  double volumeRatioSum = 0.0;
+  uint32_t poseCount = 0;
+  {
+    // 歩きの全体で、Joint ごとの境界から作った箱がスキニング後の頂点を全部包む
+    AnimationController controller;
+    controller.Initialize(bindSkeleton);
+    controller.Play(walkClip);
+    Skeleton skeleton = bindSkeleton;
+    bool contained = true;
+    for (uint32_t step = 0; step <= 120; ++step) {
+      controller.EvaluateBaseAt(walk.duration * step / 120.0f, skeleton);
+      Update(skeleton);
+      skin(skeleton);
+      const AABB bounds = ModelBounds::ComputeSkinnedAABB(jointBounds, jointIndices, skeleton.skeletonSpaceMatrices.data());
+      for (const ModelAsset::VertexData &vertex : skinned) {
+        contained = contained && Contains(bounds, ToVector3(vertex.position), tolerance);
+      }
+      double ratio = Volume(bounds) / Volume(PointsAABB(skinned));
+      worstVolumeRatio = std::max(worstVolumeRatio, ratio);
+      volumeRatioSum += ratio;
+      ++poseCount;
+    }
+    check("skinned bounds contain walk", contained);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  std::printf("AnimatedCube: %zu vertices / human: %zu vertices, %zu joints (%zu with influence)\n",
+              cube.modelData.vertices.size(), bindVertices.size(), bindSkeleton.joints.size(),
+              jointBounds.aabbs.size());
+  std::printf("skinned bounds volume / exact: average %.2f, worst %.2f (%u poses)\n\n",
+              volumeRatioSum / poseCount, worstVolumeRatio, poseCount);
+
+  //=========================
+  // 計測
+  //=========================
+  runner.Run("ModelBounds/ComputeJointBounds(human, import)", [&](uint64_t) {
+    JointBounds made = ModelBounds::ComputeJointBounds(human.modelData);
+    Benchmark::DoNotOptimize(made.aabbs.data());
+  });
+
+  runner.Run("ModelBounds/Compute(human, import)", [&](uint64_t) {
+    BoundingVolume made = ModelBounds::Compute(bindVertices);
+    Benchmark::DoNotOptimize(made);
+  });
+
+  // 毎フレームの境界：Joint の箱を動かすだけ。頂点を全部スキニングして包む場合と比べる
+  Skeleton skeleton = bindSkeleton;
+  AnimationController controller;
+  controller.Initialize(bindSkeleton);
+  controller.Play(walkClip);
+  controller.EvaluateBaseAt(walk.duration * 0.5f, skeleton);
+  Update(skeleton);
+  runner.Run("ModelBounds/ComputeSkinnedAABB(human, per frame)", [&](uint64_t) {
+    AABB bounds = ModelBounds::ComputeSkinnedAABB(jointBounds, jointIndices, skeleton.skeletonSpaceMatrices.data());
+    Benchmark::DoNotOptimize(bounds);
+  });
+
+  runner.Run("ModelBounds/skin all vertices + AABB(human, per frame)", [&](uint64_t) {
+    skin(skeleton);
+    AABB bounds = PointsAABB(skinned);
+    Benchmark::DoNotOptimize(bounds);
+  });
+
+  runner.Run("ModelBounds/TransformAABB", [&](uint64_t iteration) {
+    Matrix4x4 world = MakeAffineMatrix(Vector3{1.0f, 1.0f, 1.0f}, Vector3{0.0f, float(iteration & 7), 0.0f},
+                                      Vector3{1.0f, 2.0f, 3.0f});
+    AABB bounds = TransformAABB(bindAABB, world);
+    Benchmark::DoNotOptimize(bounds);
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
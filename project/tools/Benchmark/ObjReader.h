@@ -0,0 +1,159 @@
+#pragma once
+// ベンチマーク用の OBJ 読み込み（Assimp なしで、同梱のモデルを Model::LoadModelFile と同じ形にする）
+// Assimp の OBJ 読み込みに合わせて、o / usemtl ごとにメッシュを分け、頂点は面の角ごとに作る（結合しない）
+// マテリアルは 0 番が既定のマテリアルで、その後ろに MTL の newmtl の順で並ぶ
+// 座標は Model::LoadModelFile と同じく左手系に直し、aiProcess_FlipWindingOrder / aiProcess_FlipUVs も掛ける
+#include "Model/ModelAssetData.h"
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ObjReader {
+
+struct Mesh {
+  std::string name; // o の名前
+  std::vector<ModelAsset::VertexData> vertices;
+  std::vector<uint32_t> indices; // メッシュ内の頂点番号
+  uint32_t materialIndex = 0;
+};
+
+struct Scene {
+  std::vector<Mesh> meshes;                          // ファイル内の並び
+  std::vector<std::string> materialNames;            // 0 番は "DefaultMaterial"
+  std::vector<ModelAsset::MaterialData> materials;   // materialNames と同じ並び（テクスチャは directory/map_Kd）
+};
+
+namespace Detail {
+
+// "v/vt/vn" の各番号（1 始まり、負なら末尾から）を 0 始まりに直す。なければ -1
+inline void ParseCorner(const std::string &token, size_t positionCount, size_t texcoordCount,
+                        size_t normalCount, int64_t out[3]) {
+  const size_t counts[3] = {positionCount, texcoordCount, normalCount};
+  size_t begin = 0;
+  for (int element = 0; element < 3; ++element) {
+    out[element] = -1;
+    if (begin > token.size()) {
+      continue;
+    }
+    size_t end = token.find('/', begin);
+    std::string field = token.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+    if (!field.empty()) {
+      int64_t value = std::stoll(field);
+      out[element] = value < 0 ? static_cast<int64_t>(counts[element]) + value : value - 1;
+    }
+    begin = end == std::string::npos ? token.size() + 1 : end + 1;
+  }
+}
+
+inline void ReadMaterialLibrary(const std::string &path, const std::string &directory, Scene &scene) {
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream s(line);
+    std::string identifier;
+    s >> identifier;
+    if (identifier == "newmtl") {
+      std::string name;
+      s >> name;
+      scene.materialNames.push_back(name);
+      scene.materials.emplace_back();
+    } else if (identifier == "map_Kd" && !scene.materials.empty()) {
+      std::string textureFilename;
+      s >> textureFilename;
+      scene.materials.back().textureFilePath = directory + "/" + textureFilename;
+    }
+  }
+}
+
+} // namespace Detail
+
+/// <summary>
+/// OBJ を読む。開けなければ false
+/// </summary>
+/// <param name="directoryPath">ディレクトリ（MTL とテクスチャのパスにも使う）</param>
+inline bool Read(const std::string &directoryPath, const std::string &filename, Scene &scene) {
+  std::ifstream file(directoryPath + "/" + filename);
+  if (!file.is_open()) {
+    return false;
+  }
+  scene = {};
+  scene.materialNames.push_back("DefaultMaterial");
+  scene.materials.emplace_back();
+
+  std::vector<Vector3> positions;
+  std::vector<Vector2> texcoords;
+  std::vector<Vector3> normals;
+  std::string objectName;
+  uint32_t materialIndex = 0;
+  Mesh *current = nullptr;
+
+  auto findMaterial = [&](const std::string &name) -> uint32_t {
+    for (uint32_t i = 0; i < scene.materialNames.size(); ++i) {
+      if (scene.materialNames[i] == name) {
+        return i;
+      }
+    }
+    return 0;
+  };
+
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream s(line);
+    std::string identifier;
+    s >> identifier;
+    if (identifier == "v") {
+      Vector3 position{};
+      s >> position.x >> position.y >> position.z;
+      positions.push_back(position);
+    } else if (identifier == "vt") {
+      Vector2 texcoord{};
+      s >> texcoord.x >> texcoord.y;
+      texcoords.push_back(texcoord);
+    } else if (identifier == "vn") {
+      Vector3 normal{};
+      s >> normal.x >> normal.y >> normal.z;
+      normals.push_back(normal);
+    } else if (identifier == "mtllib") {
+      std::string libraryName;
+      s >> libraryName;
+      Detail::ReadMaterialLibrary(directoryPath + "/" + libraryName, directoryPath, scene);
+    } else if (identifier == "o" || identifier == "g") {
+      s >> objectName;
+      current = nullptr;
+    } else if (identifier == "usemtl") {
+      std::string materialName;
+      s >> materialName;
+      materialIndex = findMaterial(materialName);
+      current = nullptr;
+    } else if (identifier == "f") {
+      if (!current) {
+        scene.meshes.push_back({objectName, {}, {}, materialIndex});
+        current = &scene.meshes.back();
+      }
+      // 多角形は扇形に三角形へ分ける（aiProcess_Triangulate）
+      std::vector<uint32_t> corners;
+      std::string token;
+      while (s >> token) {
+        int64_t index[3];
+        Detail::ParseCorner(token, positions.size(), texcoords.size(), normals.size(), index);
+        const Vector3 position = positions[index[0]];
+        const Vector2 texcoord = index[1] >= 0 ? texcoords[index[1]] : Vector2{0.0f, 0.0f};
+        const Vector3 normal = index[2] >= 0 ? normals[index[2]] : Vector3{0.0f, 0.0f, 0.0f};
+        ModelAsset::VertexData vertex;
+        vertex.position = {-position.x, position.y, position.z, 1.0f};
+        vertex.texcoord = {texcoord.x, 1.0f - texcoord.y};
+        vertex.normal = {-normal.x, normal.y, normal.z};
+        corners.push_back(static_cast<uint32_t>(current->vertices.size()));
+        current->vertices.push_back(vertex);
+      }
+      for (size_t i = 2; i < corners.size(); ++i) {
+        current->indices.insert(current->indices.end(), {corners[0], corners[i], corners[i - 1]});
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace ObjReader
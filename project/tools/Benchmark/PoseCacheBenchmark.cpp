@@ -0,0 +1,364 @@
+// 群衆で同じクリップの評価済みパレットを共有するキャッシュ（PoseCache）の確認とベンチマーク
+// 500 体が同じ歩きのクリップを再生する1フレーム分を、位相の種類（1 / 8 / 64 / 500）を変えて測る
+// インスタンスごとに評価する場合は体数に比例し、キャッシュを使うと位相の種類（≒ 評価の回数）に比例する
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -pthread -IEngine/include -IEngine/include/Render -Iexternals
+//       -o pose_cache_benchmark tools/Benchmark/PoseCacheBenchmark.cpp
+//       Engine/src/Render/Model/PoseCache.cpp Engine/src/Render/Model/AnimationBlend.cpp
+//       Engine/src/Render/Model/Skeleton.cpp Engine/src/Render/Model/Skinning.cpp
+//       Engine/src/Render/Model/CompressedAnimation.cpp Engine/src/Render/Model/AnimationSampler.cpp
+//       Engine/src/Util/TaskPool.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./pose_cache_benchmark --out pose_cache_baseline.json
+//   ./pose_cache_benchmark --baseline pose_cache_baseline.json
+#include "BenchmarkCommon.h"
+#include "Model/AnimationBlend.h"
+#include "Model/PoseCache.h"
+#include "Model/Skinning.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kCharacterCount = 500;
+constexpr uint32_t kJointCount = 70;
+constexpr float kKeysPerSecond = 30.0f;
+constexpr float kFrameTime = 1.0f / 60.0f;
+// 500 通りの位相の間隔（0.12 秒）が、エントリーを残すフレーム数より長くなる長さ
+// （間隔が短いと、後ろの位相が前の位相の残したエントリーをそのまま使うので評価が減る）
+constexpr float kClipSeconds = 60.0f;
+
+std::string JointName(uint32_t index) { return "Armature|mixamorig:Joint_" + std::to_string(index); }
+
+Quaternion AxisAngle(Vector3 axis, float angle) {
+  float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+  float s = std::sin(angle * 0.5f) / length;
+  return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+ModelAsset::Node MakeHierarchy(float rootHeight) {
+  std::vector<ModelAsset::Node> nodes(kJointCount);
+  for (uint32_t i = 0; i < kJointCount; ++i) {
+    nodes[i].name = JointName(i);
+    nodes[i].transform = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, i == 0 ? rootHeight : 0.3f, 0.0f}};
+    nodes[i].localMatrix = MakeAffineMatrix(nodes[i].transform.scale, nodes[i].transform.rotate,
+                                            nodes[i].transform.translate);
+  }
+  for (int32_t i = kJointCount - 1; i > 0; --i) {
+    int32_t parent = (i - 1) / 2;
+    nodes[parent].children.insert(nodes[parent].children.begin(), std::move(nodes[i]));
+  }
+  return nodes[0];
+}
+
+Animation MakeClip(uint32_t seed, float seconds) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> speed(0.5f, 3.0f);
+  Animation animation;
+  animation.duration = seconds;
+  const uint32_t keyCount = static_cast<uint32_t>(seconds * kKeysPerSecond) + 1;
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    NodeAnimation &node = animation.nodeAnimations[JointName(j)];
+    const Vector3 axis{unit(rng), unit(rng), unit(rng) + 1.5f};
+    const float base = unit(rng);
+    const float frequency = speed(rng);
+    for (uint32_t k = 0; k < keyCount; ++k) {
+      float time = std::min(static_cast<float>(k) / kKeysPerSecond, seconds);
+      float phase = time * frequency;
+      node.rotate.keyframes.push_back({time, AxisAngle(axis, base + std::sin(phase) * 0.6f)});
+      node.translate.keyframes.push_back({time, {0.0f, 0.3f + 0.03f * std::sin(phase), 0.0f}});
+      node.scale.keyframes.push_back({time, {1.0f, 1.0f, 1.0f}});
+    }
+  }
+  return animation;
+}
+
+std::vector<Matrix4x4> MakeInverseBindPose(const Skeleton &skeleton) {
+  std::vector<Matrix4x4> inverseBindPose(skeleton.joints.size());
+  for (size_t j = 0; j < skeleton.joints.size(); ++j) {
+    inverseBindPose[j] = Inverse(skeleton.skeletonSpaceMatrices[j]);
+  }
+  return inverseBindPose;
+}
+
+// SkinnedObject 1体分（パレットは GPU のアップロード用バッファの代わり）
+struct Character {
+  AnimationController controller;
+  Skeleton skeleton;
+  std::vector<WellForGPU> palette;
+  PoseCache::Entry *entry = nullptr;
+};
+
+// SkinnedObject::Update と同じ流れ（キャッシュなし）
+void UpdateDirect(Character &character, const std::vector<Matrix4x4> &inverseBindPose, float deltaTime) {
+  character.controller.Update(deltaTime);
+  character.controller.Evaluate(character.skeleton);
+  Update(character.skeleton);
+  Skinning::BuildPalette(inverseBindPose.data(), character.skeleton.skeletonSpaceMatrices.data(),
+                         character.skeleton.joints.size(), character.palette.data());
+}
+
+// SkinnedObject::UpdatePaletteFromPoseCache と同じ流れ
+void UpdateCached(Character &character, PoseCache &cache, uint64_t skeletonKey,
+                  const std::vector<Matrix4x4> &inverseBindPose, float deltaTime) {
+  character.controller.Update(deltaTime);
+  const PoseCache::Key key =
+      cache.MakeKey(skeletonKey, *character.controller.GetLayerClip(0), character.controller.GetLayerTime(0));
+  if (character.entry && character.entry->key == key) {
+    return;
+  }
+  const size_t jointCount = character.skeleton.joints.size();
+  PoseCache::Entry *entry = cache.Acquire(key, jointCount, [&](float time, PoseCache::Entry &evaluated) {
+    character.controller.EvaluateBaseAt(time, character.skeleton);
+    Update(character.skeleton);
+    Skinning::BuildPalette(inverseBindPose.data(), character.skeleton.skeletonSpaceMatrices.data(), jointCount,
+                           evaluated.palette.data());
+  });
+  if (character.entry) {
+    cache.Release(character.entry);
+  }
+  character.entry = entry;
+  std::memcpy(character.palette.data(), entry->palette.data(), sizeof(WellForGPU) * jointCount);
+}
+
+bool SamePalette(const std::vector<WellForGPU> &a, const WellForGPU *b) {
+  return std::memcmp(a.data(), b, sizeof(WellForGPU) * a.size()) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "pose_cache_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  Skeleton bindSkeleton = CreateSkeleton(MakeHierarchy(0.0f));
+  Update(bindSkeleton);
+  const std::vector<Matrix4x4> inverseBindPose = MakeInverseBindPose(bindSkeleton);
+  const uint64_t skeletonKey = PoseCache::MakeSkeletonKey(bindSkeleton, inverseBindPose.data());
+
+  const Animation walk = MakeClip(1, kClipSeconds);
+  const Animation run = MakeClip(2, 1.0f);
+  const AnimationClip walkClip = MakeAnimationClip(bindSkeleton, walk);
+  const AnimationClip runClip = MakeAnimationClip(bindSkeleton, run);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[PoseCache] %s\n", label);
+      ok = false;
+    }
+  };
+
+  {
+    // 同じモデルは同じキー。階層・初期姿勢・逆バインド行列が違えば別のキー
+    Skeleton same = CreateSkeleton(MakeHierarchy(0.0f));
+    Skeleton moved = CreateSkeleton(MakeHierarchy(0.5f));
+    check("same skeleton key", PoseCache::MakeSkeletonKey(same, inverseBindPose.data()) == skeletonKey);
+    check("bind pose changes key", PoseCache::MakeSkeletonKey(moved, inverseBindPose.data()) != skeletonKey);
+    std::vector<Matrix4x4> otherInverse = inverseBindPose;
+    otherInverse[3].m[3][1] += 0.25f;
+    check("inverse bind changes key", PoseCache::MakeSkeletonKey(same, otherInverse.data()) != skeletonKey);
+    same.joints[5].name += "_";
+    check("joint name changes key", PoseCache::MakeSkeletonKey(same, inverseBindPose.data()) != skeletonKey);
+  }
+
+  {
+    // 丸め：同じフレームに入る時刻は同じキー、クリップ・Skeleton が違えば別のキー
+    PoseCache cache;
+    cache.Initialize({30.0f, 2, 1024});
+    const PoseCache::Key key = cache.MakeKey(skeletonKey, &walkClip, 10.0f / 30.0f);
+    check("quantized time", key.frame == 10 && cache.GetKeyTime(key) == 10.0f / 30.0f);
+    check("same frame", cache.MakeKey(skeletonKey, &walkClip, 10.4f / 30.0f) == key);
+    check("next frame", !(cache.MakeKey(skeletonKey, &walkClip, 10.6f / 30.0f) == key));
+    check("other clip", !(cache.MakeKey(skeletonKey, &runClip, 10.0f / 30.0f) == key));
+    check("other skeleton", !(cache.MakeKey(skeletonKey + 1, &walkClip, 10.0f / 30.0f) == key));
+
+    PoseCache exact;
+    exact.Initialize({0.0f, 2, 1024});
+    const PoseCache::Key exactKey = exact.MakeKey(skeletonKey, &walkClip, 0.123f);
+    check("sample rate 0 keeps time", exact.GetKeyTime(exactKey) == 0.123f &&
+                                          !(exact.MakeKey(skeletonKey, &walkClip, 0.1231f) == exactKey));
+  }
+
+  {
+    // キャッシュしたパレットは、丸めた時刻でそのまま評価したものとビット単位で一致する
+    PoseCache cache;
+    cache.Initialize({});
+    Character a{{}, bindSkeleton, std::vector<WellForGPU>(kJointCount)};
+    Character b{{}, bindSkeleton, std::vector<WellForGPU>(kJointCount)};
+    Character direct{{}, bindSkeleton, std::vector<WellForGPU>(kJointCount)};
+    for (Character *character : {&a, &b, &direct}) {
+      character->controller.Initialize(bindSkeleton);
+      character->controller.Play(walkClip);
+    }
+    check("single clip", a.controller.IsSingleClip());
+
+    UpdateCached(a, cache, skeletonKey, inverseBindPose, 10.0f / 30.0f);
+    UpdateCached(b, cache, skeletonKey, inverseBindPose, 10.0f / 30.0f);
+    UpdateDirect(direct, inverseBindPose, 10.0f / 30.0f);
+    check("same phase shares entry", a.entry == b.entry && a.entry->refCount == 2 && cache.GetMissCount() == 1 &&
+                                         cache.GetHitCount() == 1 && cache.GetEntryCount() == 1);
+    check("cached palette matches direct", SamePalette(direct.palette, a.entry->palette.data()) &&
+                                               SamePalette(direct.palette, b.palette.data()));
+
+    // 丸めで別の時刻が同じパレットになる（0.4 フレーム分ずらしても同じ）
+    Character near{{}, bindSkeleton, std::vector<WellForGPU>(kJointCount)};
+    near.controller.Initialize(bindSkeleton);
+    near.controller.Play(walkClip);
+    UpdateCached(near, cache, skeletonKey, inverseBindPose, 10.4f / 30.0f);
+    check("near phase shares entry", near.entry == a.entry && cache.GetMissCount() == 1);
+
+    // 先に進めたインスタンスは別のエントリーに移り、古いほうの参照を返す
+    UpdateCached(a, cache, skeletonKey, inverseBindPose, 1.0f / 30.0f);
+    check("advance moves entry", a.entry != b.entry && b.entry->refCount == 2 && a.entry->refCount == 1 &&
+                                     cache.GetEntryCount() == 2);
+
+    // 使われなくなったエントリーは maxIdleFrames を過ぎてから捨てる
+    cache.Release(b.entry);
+    cache.Release(near.entry);
+    b.entry = near.entry = nullptr;
+    for (uint32_t frame = 0; frame < cache.GetSettings().maxIdleFrames; ++frame) {
+      cache.BeginFrame();
+    }
+    check("idle entry kept", cache.GetEntryCount() == 2 && cache.GetEvictionCount() == 0);
+    cache.BeginFrame();
+    check("idle entry evicted", cache.GetEntryCount() == 1 && cache.GetEvictionCount() == 1);
+    for (uint32_t frame = 0; frame < 10; ++frame) {
+      cache.BeginFrame();
+    }
+    check("used entry kept", cache.GetEntryCount() == 1 && a.entry->refCount == 1);
+    cache.Release(a.entry);
+    a.entry = nullptr;
+
+    // 上限を超えたら、使われていないものを古い順に捨てる（使用中は残す）
+    PoseCache small;
+    small.Initialize({30.0f, 100, 4});
+    auto fill = [](float, PoseCache::Entry &) {};
+    PoseCache::Entry *held = small.Acquire(small.MakeKey(skeletonKey, &walkClip, 0.0f), kJointCount, fill);
+    for (int32_t frame = 1; frame < 10; ++frame) {
+      small.BeginFrame();
+      small.Release(small.Acquire(small.MakeKey(skeletonKey, &walkClip, frame / 30.0f), kJointCount, fill));
+    }
+    small.BeginFrame();
+    const PoseCache::Key newest = small.MakeKey(skeletonKey, &walkClip, 9.0f / 30.0f);
+    uint64_t misses = small.GetMissCount();
+    small.Release(small.Acquire(newest, kJointCount, fill));
+    check("trim to max entries", small.GetEntryCount() == 4 && small.GetMissCount() == misses && held->refCount == 1);
+    small.Release(held);
+  }
+
+  {
+    // SkinnedObject はインスタンスごとにクリップを Bind するので、Bind したクリップではなく
+    // 共有している元データ（AnimationLibrary の Animation / CompressedAnimation）でキーを作る
+    const CompressedAnimation compressedWalk = AnimationCompression::Compress(walk);
+    std::vector<AnimationClip> firstClips{MakeAnimationClip(bindSkeleton, walk),
+                                          MakeAnimationClip(bindSkeleton, compressedWalk)};
+    std::vector<AnimationClip> secondClips{MakeAnimationClip(bindSkeleton, walk),
+                                           MakeAnimationClip(bindSkeleton, compressedWalk)};
+    PoseCache cache;
+    cache.Initialize({});
+    Character first{{}, bindSkeleton, std::vector<WellForGPU>(kJointCount)};
+    Character second{{}, bindSkeleton, std::vector<WellForGPU>(kJointCount)};
+    first.controller.Initialize(bindSkeleton);
+    second.controller.Initialize(bindSkeleton);
+    first.controller.Play(firstClips[0]);
+    second.controller.Play(secondClips[0]);
+    UpdateCached(first, cache, skeletonKey, inverseBindPose, 10.0f / 30.0f);
+    UpdateCached(second, cache, skeletonKey, inverseBindPose, 10.0f / 30.0f);
+    check("separately bound clips share entry", first.entry == second.entry && cache.GetMissCount() == 1 &&
+                                                    cache.GetHitCount() == 1);
+
+    // 圧縮したものは別の姿勢になるので別のエントリー
+    first.controller.Play(firstClips[1]);
+    second.controller.Play(secondClips[1]);
+    UpdateCached(first, cache, skeletonKey, inverseBindPose, 0.0f);
+    UpdateCached(second, cache, skeletonKey, inverseBindPose, 0.0f);
+    check("compressed clips share own entry", first.entry == second.entry && cache.GetMissCount() == 2 &&
+                                                  cache.GetHitCount() == 2 && cache.GetEntryCount() == 2);
+    cache.Release(first.entry);
+    cache.Release(second.entry);
+  }
+
+  {
+    // 1つのクリップだけで姿勢が決まるときだけ共有する
+    AnimationController controller;
+    controller.Initialize(bindSkeleton);
+    check("no clip", !controller.IsSingleClip());
+    controller.Play(walkClip);
+    controller.Play(runClip, 0.2f);
+    controller.Update(0.1f);
+    check("fading is not single", !controller.IsSingleClip());
+    controller.Update(0.2f);
+    check("after fade is single", controller.IsSingleClip());
+    uint32_t additive = controller.AddLayer(AnimationController::BlendMode::Additive, 0.5f);
+    controller.Play(walkClip, 0.0f, additive);
+    check("additive layer is not single", !controller.IsSingleClip());
+    controller.SetLayerWeight(additive, 0.0f);
+    check("zero weight layer is ignored", controller.IsSingleClip());
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // 500 体が同じクリップを再生する。位相は unique 通りで、同じ位相のインスタンスは同じ姿勢になる
+  std::vector<Character> characters(kCharacterCount);
+  auto setup = [&](uint32_t unique, PoseCache *cache) {
+    for (uint32_t i = 0; i < kCharacterCount; ++i) {
+      Character &character = characters[i];
+      if (character.entry) {
+        cache->Release(character.entry);
+        character.entry = nullptr;
+      }
+      character.skeleton = bindSkeleton;
+      character.palette.resize(kJointCount);
+      character.controller.Initialize(bindSkeleton);
+      character.controller.Play(walkClip);
+      character.controller.Update(kClipSeconds * static_cast<float>(i % unique) / unique);
+    }
+  };
+
+  std::printf("%u characters, %u joints, clip %.0f s\n", kCharacterCount, kJointCount, kClipSeconds);
+  for (uint32_t unique : {1u, 8u, 64u, 500u}) {
+    PoseCache cache;
+    cache.Initialize({});
+    setup(unique, &cache);
+    const std::string suffix = "(500 characters, " + std::to_string(unique) + " phases)";
+    runner.Run("PoseCache/direct " + suffix, [&](uint64_t) {
+      for (Character &character : characters) {
+        UpdateDirect(character, inverseBindPose, kFrameTime);
+      }
+      Benchmark::DoNotOptimize(characters.data());
+    });
+
+    setup(unique, &cache);
+    uint64_t frames = 0;
+    runner.Run("PoseCache/cached " + suffix, [&](uint64_t) {
+      cache.BeginFrame();
+      for (Character &character : characters) {
+        UpdateCached(character, cache, skeletonKey, inverseBindPose, kFrameTime);
+      }
+      ++frames;
+      Benchmark::DoNotOptimize(characters.data());
+    });
+    std::printf("  %3u phases: %.1f evaluations / frame, %zu entries\n", unique,
+                frames ? static_cast<double>(cache.GetMissCount()) / frames : 0.0, cache.GetEntryCount());
+    setup(1, &cache);
+  }
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// 描画キュー（RenderQueue）の確認とベンチマーク
+// 64bit のソートキーの並び（レイヤー → 不透明/半透明 → PSO・マテリアル・深度）を確かめ、
+// 2万件の基数ソートを std::stable_sort と比べる。並べる前後の状態の切り替え回数も出す
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o render_queue_benchmark tools/Benchmark/RenderQueueBenchmark.cpp
+//       Engine/src/Render/Renderer/RenderQueue.cpp
+//
+// 実行例:
+//   ./render_queue_benchmark --out render_queue_baseline.json
+//   ./render_queue_benchmark --baseline render_queue_baseline.json
+#include "BenchmarkCommon.h"
+#include "Renderer/RenderQueue.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Logger は Windows に依存するので、ここでは標準エラーへ流す
+namespace Logger {
+void Log(const std::string &message) { std::fputs(message.c_str(), stderr); }
+} // namespace Logger
+
+namespace {
+
+constexpr uint32_t kItemCount = 20000;
+
+// Object3dRenderer::MakeSortKey に渡すもの
+struct FakeDraw {
+  uint32_t layer = 0;
+  uint32_t pipeline = 0;
+  uint64_t material = 0;
+  float depth = 0.0f;
+  bool transparent = false;
+};
+
+uint64_t MakeKey(const FakeDraw &draw) {
+  return draw.transparent
+             ? RenderQueue::MakeTransparentKey(draw.layer, draw.pipeline, draw.material, draw.depth)
+             : RenderQueue::MakeOpaqueKey(draw.layer, draw.pipeline, draw.material, draw.depth);
+}
+
+// マテリアルのハッシュの代わり（上位ビットに散らばる値）
+uint64_t MaterialHash(uint32_t index) { return (uint64_t(index) + 1) * 0x9E3779B97F4A7C15ull; }
+
+// シーンの描画: 背景（レイヤー 0）、アクター（1）、デプスなしのデバッグ表示（オーバーレイ）、
+// PSO 8 種・マテリアル 200 種、2 割が半透明
+std::vector<FakeDraw> MakeScene(uint32_t count, uint32_t seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> depth(1.0f, 10000.0f);
+  std::vector<FakeDraw> draws(count);
+  for (FakeDraw &draw : draws) {
+    uint32_t kind = random() % 100;
+    draw.layer = kind < 30 ? 0 : (kind < 98 ? 1 : RenderQueue::kOverlayLayer);
+    draw.pipeline = random() % 8;
+    draw.material = MaterialHash(random() % 200);
+    draw.depth = depth(random);
+    draw.transparent = random() % 5 == 0;
+  }
+  return draws;
+}
+
+void Fill(RenderQueue &queue, const std::vector<FakeDraw> &draws) {
+  queue.Clear();
+  for (uint32_t i = 0; i < draws.size(); ++i) {
+    queue.Submit(MakeKey(draws[i]), i);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "render_queue_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const std::vector<FakeDraw> draws = MakeScene(kItemCount, 11);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[RenderQueue] %s\n", label);
+      ok = false;
+    }
+  };
+
+  {
+    // 深度の量子化は大小の順を保つ
+    bool monotonic = true;
+    float previous = 0.0f;
+    for (float depth = 0.001f; depth < 1.0e6f; depth *= 1.37f) {
+      monotonic &= RenderQueue::QuantizeDepth(previous) <= RenderQueue::QuantizeDepth(depth);
+      previous = depth;
+    }
+    check("depth quantization is monotonic", monotonic);
+    check("depth quantization fits", RenderQueue::QuantizeDepth(1.0e30f) < (1u << RenderQueue::kDepthBits));
+    check("negative depth is zero", RenderQueue::QuantizeDepth(-1.0f) == 0 && RenderQueue::QuantizeDepth(0.0f) == 0);
+
+    // キーから取り出せる
+    uint64_t opaque = RenderQueue::MakeOpaqueKey(3, 1234, MaterialHash(5), 42.0f);
+    uint64_t transparent = RenderQueue::MakeTransparentKey(3, 1234, MaterialHash(5), 42.0f);
+    check("opaque fields", RenderQueue::GetLayer(opaque) == 3 && !RenderQueue::IsTransparent(opaque) &&
+                               RenderQueue::GetPipeline(opaque) == 1234 &&
+                               RenderQueue::GetMaterial(opaque) == RenderQueue::GetMaterial(transparent));
+    check("transparent fields", RenderQueue::GetLayer(transparent) == 3 && RenderQueue::IsTransparent(transparent) &&
+                                    RenderQueue::GetPipeline(transparent) == 1234);
+    check("layer clamps", RenderQueue::GetLayer(RenderQueue::MakeOpaqueKey(99, 0, 0, 0.0f)) == RenderQueue::kMaxLayer);
+
+    // 並びの優先順位
+    check("layer first", RenderQueue::MakeTransparentKey(0, 0, 0, 1.0f) < RenderQueue::MakeOpaqueKey(1, 0, 0, 1.0f));
+    check("opaque before transparent",
+          RenderQueue::MakeOpaqueKey(1, 7, 0, 9999.0f) < RenderQueue::MakeTransparentKey(1, 0, 0, 1.0f));
+    check("opaque groups pipeline before depth",
+          RenderQueue::MakeOpaqueKey(0, 1, 0, 9999.0f) < RenderQueue::MakeOpaqueKey(0, 2, 0, 1.0f));
+    check("opaque front to back", RenderQueue::MakeOpaqueKey(0, 1, 0, 1.0f) < RenderQueue::MakeOpaqueKey(0, 1, 0, 2.0f));
+    check("transparent back to front",
+          RenderQueue::MakeTransparentKey(0, 0, 0, 2.0f) < RenderQueue::MakeTransparentKey(0, 7, 0, 1.0f));
+
+    // PSO の番号は見た順に振る
+    RenderQueue queue;
+    int a = 0;
+    int b = 0;
+    check("pipeline ids", queue.GetPipelineId(&a) == 0 && queue.GetPipelineId(&b) == 1 && queue.GetPipelineId(&a) == 0);
+
+    // 基数ソートは std::stable_sort と同じ並び（同じキーは登録順）
+    Fill(queue, draws);
+    std::vector<RenderQueue::Item> expected = queue.GetItems();
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const RenderQueue::Item &l, const RenderQueue::Item &r) { return l.key < r.key; });
+    queue.Sort();
+    const std::vector<RenderQueue::Item> &items = queue.GetItems();
+    bool same = items.size() == expected.size();
+    for (size_t i = 0; same && i < items.size(); ++i) {
+      same = items[i].key == expected[i].key && items[i].payload == expected[i].payload;
+    }
+    check("radix sort matches stable sort", same);
+
+    // 同じキーばかり（全桁を飛ばす）でも登録順のまま
+    queue.Clear();
+    for (uint32_t i = 0; i < 100; ++i) {
+      queue.Submit(RenderQueue::MakeOpaqueKey(1, 2, 3, 4.0f), i);
+    }
+    queue.Sort();
+    bool stable = true;
+    for (uint32_t i = 0; i < 100; ++i) {
+      stable &= queue.GetItems()[i].payload == i;
+    }
+    check("uniform keys stay in order", stable);
+
+    // オーバーレイは最後、不透明は手前から、半透明は奥から
+    Fill(queue, draws);
+    queue.Sort();
+    bool overlayLast = true;
+    bool depthOrder = true;
+    bool seenOverlay = false;
+    for (size_t i = 0; i < queue.GetItemCount(); ++i) {
+      const FakeDraw &draw = draws[queue.GetItems()[i].payload];
+      seenOverlay |= draw.layer == RenderQueue::kOverlayLayer;
+      overlayLast &= !seenOverlay || draw.layer == RenderQueue::kOverlayLayer;
+      if (i == 0) {
+        continue;
+      }
+      const FakeDraw &prev = draws[queue.GetItems()[i - 1].payload];
+      if (prev.layer == draw.layer && prev.transparent == draw.transparent) {
+        if (!draw.transparent && prev.pipeline == draw.pipeline && prev.material == draw.material) {
+          depthOrder &= RenderQueue::QuantizeDepth(prev.depth) <= RenderQueue::QuantizeDepth(draw.depth);
+        }
+        if (draw.transparent) {
+          depthOrder &= RenderQueue::QuantizeDepth(prev.depth) >= RenderQueue::QuantizeDepth(draw.depth);
+        }
+      }
+    }
+    check("overlay last", overlayLast);
+    check("depth order", depthOrder);
+
+    // 並べると切り替えが減る
+    Fill(queue, draws);
+    RenderQueue::Stats unsorted = RenderQueue::CountStateChanges(queue.GetItems().data(), queue.GetItemCount());
+    queue.Sort();
+    const RenderQueue::Stats &sorted = queue.GetStats();
+    check("sorted reduces pipeline changes", sorted.pipelineChanges < unsorted.pipelineChanges);
+    check("sorted reduces material changes", sorted.materialChanges < unsorted.materialChanges);
+    check("stats count items", sorted.items == kItemCount);
+
+    // 空・1件
+    queue.Clear();
+    queue.Sort();
+    check("empty", queue.GetItemCount() == 0 && queue.GetStats().items == 0);
+    queue.Submit(1, 5);
+    queue.Sort();
+    check("single", queue.GetItems()[0].payload == 5 && queue.GetStats().pipelineChanges == 1);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  RenderQueue queue;
+  Fill(queue, draws);
+  RenderQueue::Stats unsorted = RenderQueue::CountStateChanges(queue.GetItems().data(), queue.GetItemCount());
+  queue.Sort();
+  RenderQueue::Stats sorted = queue.GetStats();
+  std::printf("%u items: unsorted %u layer / %u pipeline / %u material changes\n", kItemCount,
+              unsorted.layerChanges, unsorted.pipelineChanges, unsorted.materialChanges);
+  std::printf("          sorted   %u layer / %u pipeline / %u material changes\n", sorted.layerChanges,
+              sorted.pipelineChanges, sorted.materialChanges);
+
+  std::vector<RenderQueue::Item> reference;
+  runner.Run("RenderQueue/radix sort (20000 items)", [&](uint64_t) {
+    Fill(queue, draws);
+    queue.Sort();
+    Benchmark::DoNotOptimize(queue.GetItems().front().payload);
+  });
+  runner.Run("RenderQueue/std::stable_sort (20000 items)", [&](uint64_t) {
+    Fill(queue, draws);
+    reference.assign(queue.GetItems().begin(), queue.GetItems().end());
+    std::stable_sort(reference.begin(), reference.end(),
+                     [](const RenderQueue::Item &l, const RenderQueue::Item &r) { return l.key < r.key; });
+    Benchmark::DoNotOptimize(reference.front().payload);
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// ワールド→スクリーン座標変換のベンチマーク（ロックオン候補 1000 体）
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -Iexternals -o screen_projection_benchmark
+//       tools/Benchmark/ScreenProjectionBenchmark.cpp
+//       Engine/src/Math/MathUtil.cpp Engine/src/Math/ScreenProjection.cpp
+//
+// 実行例:
+//   ./screen_projection_benchmark --out screen_projection_baseline.json
+//   ./screen_projection_benchmark --baseline screen_projection_baseline.json
+#include "BenchmarkCommon.h"
+#include "Math/MathUtil.h"
+#include "Math/ScreenProjection.h"
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kTargetCount = 1000;
+
+// バッチ版とスカラー版の差の許容値（ピクセル）
+constexpr float kTolerance = 0.05f;
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options =
+      Benchmark::ParseOptions(argc, argv, "screen_projection_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  // レールカメラの前方にばらまいたターゲット（一部は背後）
+  std::mt19937 rng(12345);
+  auto range = [&rng](float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+  };
+  Vector3 eye = {0.0f, 5.0f, 0.0f};
+  Matrix4x4 viewProjection = Multiply(
+      MakeLookAtMatrix(eye, {0.0f, 5.0f, 1.0f}, {0.0f, 1.0f, 0.0f}),
+      MakePerspectiveFovMatrix(45.0f * std::numbers::pi_v<float> / 180.0f, 1280.0f / 720.0f,
+                               0.1f, 1000.0f));
+
+  std::vector<Vector3> positions(kTargetCount);
+  for (Vector3 &p : positions) {
+    p = {range(-80.0f, 80.0f), range(-20.0f, 40.0f), range(-30.0f, 300.0f)};
+  }
+  const Viewport viewport = {0.0f, 0.0f, 1280.0f, 720.0f};
+
+  std::vector<Vector2> screen(kTargetCount);
+  std::vector<float> depth(kTargetCount);
+  std::vector<uint8_t> onScreen(kTargetCount);
+
+  // スカラー版 WorldToScreen と結果が一致するか確認しておく
+  WorldToScreenBatch(positions, viewProjection, viewport, screen, depth, onScreen);
+  uint32_t onScreenCount = 0;
+  for (uint32_t i = 0; i < kTargetCount; ++i) {
+    Vector2 expected = WorldToScreen(positions[i], viewProjection, viewport.width, viewport.height);
+    if (std::abs(expected.x - screen[i].x) > kTolerance ||
+        std::abs(expected.y - screen[i].y) > kTolerance) {
+      std::fprintf(stderr, "[ScreenProjection] mismatch at %u: (%f, %f) != (%f, %f)\n", i,
+                   screen[i].x, screen[i].y, expected.x, expected.y);
+      return 1;
+    }
+    onScreenCount += onScreen[i];
+  }
+  std::printf("targets %u, on screen %u\n\n", kTargetCount, onScreenCount);
+
+  runner.Run("ScreenProjection/WorldToScreen x1000", [&](uint64_t) {
+    for (uint32_t i = 0; i < kTargetCount; ++i) {
+      screen[i] = WorldToScreen(positions[i], viewProjection, viewport.width, viewport.height);
+    }
+    Benchmark::DoNotOptimize(screen.data()[0]);
+  });
+
+  runner.Run("ScreenProjection/Batch x1000", [&](uint64_t) {
+    WorldToScreenBatch(positions, viewProjection, viewport, screen);
+    Benchmark::DoNotOptimize(screen.data()[0]);
+  });
+
+  runner.Run("ScreenProjection/Batch+Depth+Flags x1000", [&](uint64_t) {
+    WorldToScreenBatch(positions, viewProjection, viewport, screen, depth, onScreen);
+    Benchmark::DoNotOptimize(screen.data()[0]);
+  });
+
+  bool saved = runner.Save();
+  bool ok = runner.CompareWithBaseline();
+  return (saved && ok) ? 0 : 1;
+}
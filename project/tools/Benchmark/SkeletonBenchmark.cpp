@@ -0,0 +1,341 @@
+// Skeleton へのアニメーション適用（チャンネルを Joint 番号へ解決しておく AnimationBinding）の確認とベンチマーク
+// スキンメッシュ 100 体が同じクリップを別々の時刻で再生する1フレーム分（適用＋親から子への行列伝播）を測る
+// 比較用に、Joint ごとに名前で map を引いていた以前の形（Joint に行列を持つ構造）をここに残している
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o skeleton_benchmark tools/Benchmark/SkeletonBenchmark.cpp
+//       Engine/src/Render/Model/Skeleton.cpp Engine/src/Render/Model/CompressedAnimation.cpp
+//       Engine/src/Render/Model/AnimationSampler.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./skeleton_benchmark --out skeleton_baseline.json
+//   ./skeleton_benchmark --baseline skeleton_baseline.json
+#include "BenchmarkCommon.h"
+#include "Model/Skeleton.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kInstanceCount = 100;
+constexpr uint32_t kAnimatedJointCount = 64; // クリップに入っている Joint
+constexpr uint32_t kHelperNodeCount = 6;     // アニメーションしない末端（エンドサイトなど）
+constexpr float kKeysPerSecond = 30.0f;
+constexpr float kFrameTime = 1.0f / 60.0f;
+
+// DCC ツールから出てくるような、先頭が共通の長い名前にする（名前比較のコストも実際に近づける）
+std::string JointName(uint32_t index) { return "Armature|mixamorig:Joint_" + std::to_string(index); }
+
+Quaternion AxisAngle(Vector3 axis, float angle) {
+  float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+  float s = std::sin(angle * 0.5f) / length;
+  return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+ModelAsset::Node MakeNode(const std::string &name, const Vector3 &offset) {
+  ModelAsset::Node node;
+  node.name = name;
+  node.transform.scale = {1.0f, 1.0f, 1.0f};
+  node.transform.rotate = {0.0f, 0.0f, 0.0f, 1.0f};
+  node.transform.translate = offset;
+  node.localMatrix =
+      MakeAffineMatrix(node.transform.scale, node.transform.rotate, node.transform.translate);
+  return node;
+}
+
+// 背骨から手足が枝分かれする人型に近い木。番号は幅優先で振るので、深さ優先の Joint 番号とは並びが違う
+ModelAsset::Node MakeHierarchy() {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> unit(-0.2f, 0.2f);
+  std::vector<ModelAsset::Node> nodes;
+  std::vector<int32_t> parents;
+  for (uint32_t i = 0; i < kAnimatedJointCount + kHelperNodeCount; ++i) {
+    std::string name = i < kAnimatedJointCount ? JointName(i) : "Armature|End_" + std::to_string(i);
+    nodes.push_back(MakeNode(name, {unit(rng), 0.3f + unit(rng), unit(rng)}));
+    parents.push_back(i == 0 ? -1 : static_cast<int32_t>((i - 1) / 3));
+  }
+  // 葉から親へ付け替えていく（子の番号は親より大きい）
+  for (int32_t i = static_cast<int32_t>(nodes.size()) - 1; i > 0; --i) {
+    std::vector<ModelAsset::Node> &siblings = nodes[parents[i]].children;
+    siblings.insert(siblings.begin(), std::move(nodes[i]));
+  }
+  return nodes[0];
+}
+
+Animation MakeClip(float seconds) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> speed(0.5f, 2.0f);
+  Animation animation;
+  animation.duration = seconds;
+  const uint32_t keyCount = static_cast<uint32_t>(seconds * kKeysPerSecond) + 1;
+  for (uint32_t j = 0; j < kAnimatedJointCount; ++j) {
+    NodeAnimation &node = animation.nodeAnimations[JointName(j)];
+    const Vector3 axis{unit(rng), unit(rng), unit(rng) + 1.5f};
+    const Vector3 offset{0.2f * unit(rng), 0.3f, 0.2f * unit(rng)};
+    const float frequency = speed(rng);
+    for (uint32_t k = 0; k < keyCount; ++k) {
+      float time = std::min(static_cast<float>(k) / kKeysPerSecond, seconds);
+      float phase = time * frequency;
+      node.rotate.keyframes.push_back({time, AxisAngle(axis, std::sin(phase) * 0.8f)});
+      node.translate.keyframes.push_back(
+          {time, {offset.x, offset.y + (j == 0 ? 0.05f * std::sin(phase * 2.0f) : 0.0f), offset.z}});
+      node.scale.keyframes.push_back({time, {1.0f, 1.0f, 1.0f}});
+    }
+  }
+  // モデル側にない Joint のチャンネル（別モデル用に作られたクリップなど）は無視される
+  animation.nodeAnimations["Armature|Prop"].rotate.keyframes.push_back({0.0f, {0.0f, 0.0f, 0.0f, 1.0f}});
+  return animation;
+}
+
+//=========================
+// 以前の形（比較用）
+//=========================
+struct LegacyJoint {
+  QuaternionTransform transform;
+  Matrix4x4 localMatrix;
+  Matrix4x4 skeletonSpaceMatrix;
+  std::string name;
+  std::vector<int32_t> children;
+  int32_t index;
+  std::optional<int32_t> parent;
+};
+
+struct LegacySkeleton {
+  std::vector<LegacyJoint> joints;
+};
+
+int32_t CreateLegacyJoint(const ModelAsset::Node &node, const std::optional<int32_t> &parent,
+                          std::vector<LegacyJoint> &joints) {
+  LegacyJoint joint;
+  joint.name = node.name;
+  joint.localMatrix = node.localMatrix;
+  joint.skeletonSpaceMatrix = MakeIdentity4x4();
+  joint.transform = node.transform;
+  joint.index = int32_t(joints.size());
+  joint.parent = parent;
+  joints.push_back(joint);
+  for (const ModelAsset::Node &child : node.children) {
+    int32_t childIndex = CreateLegacyJoint(child, joint.index, joints);
+    joints[joint.index].children.push_back(childIndex);
+  }
+  return joint.index;
+}
+
+void LegacyApply(LegacySkeleton &skeleton, const Animation &animation, float time,
+                 std::vector<NodeAnimationCursor> &cursors) {
+  if (cursors.size() != skeleton.joints.size()) {
+    cursors.assign(skeleton.joints.size(), NodeAnimationCursor{});
+  }
+  for (LegacyJoint &joint : skeleton.joints) {
+    if (auto it = animation.nodeAnimations.find(joint.name); it != animation.nodeAnimations.end()) {
+      NodeAnimationCursor &cursor = cursors[joint.index];
+      joint.transform.translate = SampleKeyframes(it->second.translate.keyframes, time, cursor.translate);
+      joint.transform.rotate = SampleKeyframes(it->second.rotate.keyframes, time, cursor.rotate);
+      joint.transform.scale = SampleKeyframes(it->second.scale.keyframes, time, cursor.scale);
+    }
+  }
+}
+
+void LegacyUpdate(LegacySkeleton &skeleton) {
+  for (LegacyJoint &joint : skeleton.joints) {
+    joint.localMatrix =
+        MakeAffineMatrix(joint.transform.scale, joint.transform.rotate, joint.transform.translate);
+    if (joint.parent) {
+      joint.skeletonSpaceMatrix =
+          Multiply(joint.localMatrix, skeleton.joints[*joint.parent].skeletonSpaceMatrix);
+    } else {
+      joint.skeletonSpaceMatrix = joint.localMatrix;
+    }
+  }
+}
+
+bool SameBits(const void *a, const void *b, size_t size) { return std::memcmp(a, b, size) == 0; }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "skeleton_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  const ModelAsset::Node rootNode = MakeHierarchy();
+  const Animation clip = MakeClip(4.0f);
+  const CompressedAnimation compressed = AnimationCompression::Compress(clip);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[Skeleton] %s\n", label);
+      ok = false;
+    }
+  };
+
+  const Skeleton bindPose = CreateSkeleton(rootNode);
+  const uint32_t jointCount = kAnimatedJointCount + kHelperNodeCount;
+  check("joint count", bindPose.joints.size() == jointCount && bindPose.parentIndices.size() == jointCount &&
+                           bindPose.transforms.size() == jointCount &&
+                           bindPose.localMatrices.size() == jointCount &&
+                           bindPose.skeletonSpaceMatrices.size() == jointCount);
+  bool parentsFirst = true;
+  for (const Joint &joint : bindPose.joints) {
+    int32_t parent = bindPose.parentIndices[joint.index];
+    parentsFirst = parentsFirst && parent < joint.index && parent == joint.parent.value_or(-1);
+  }
+  check("parents come first", parentsFirst && bindPose.parentIndices[bindPose.root] == -1);
+
+  const AnimationBinding binding = BindAnimation(bindPose, clip);
+  const AnimationBinding compressedBinding = BindAnimation(bindPose, compressed);
+  check("binding channels", binding.jointIndices.size() == kAnimatedJointCount &&
+                                binding.nodeAnimations.size() == kAnimatedJointCount &&
+                                compressedBinding.nodeIndices.size() == kAnimatedJointCount);
+  bool channelsMatch = true;
+  for (size_t i = 0; i < binding.jointIndices.size(); ++i) {
+    const std::string &name = bindPose.joints[binding.jointIndices[i]].name;
+    channelsMatch = channelsMatch && binding.nodeAnimations[i] == &clip.nodeAnimations.at(name) &&
+                    compressed.nodeNames[compressedBinding.nodeIndices[i]] == name;
+  }
+  check("binding resolves names", channelsMatch);
+
+  {
+    // 以前の形・名前で引く版・バインド版で、各フレームの結果がビット単位で一致する
+    LegacySkeleton legacy;
+    CreateLegacyJoint(rootNode, {}, legacy.joints);
+    Skeleton byName = bindPose;
+    Skeleton bound = bindPose;
+    Skeleton compressedByName = bindPose;
+    Skeleton compressedBound = bindPose;
+    std::vector<NodeAnimationCursor> legacyCursors;
+    std::vector<NodeAnimationCursor> byNameCursors;
+    std::vector<NodeAnimationCursor> boundCursors;
+    bool same = true;
+    bool compressedSame = true;
+    float time = 0.0f;
+    for (uint32_t frame = 0; frame < 400; ++frame) {
+      // 途中でループさせる（カーソルが巻き戻る）
+      time = std::fmod(time + kFrameTime * 1.7f, clip.duration);
+      LegacyApply(legacy, clip, time, legacyCursors);
+      LegacyUpdate(legacy);
+      ApplyAnimation(byName, clip, time, byNameCursors);
+      Update(byName);
+      ApplyAnimation(bound, binding, time, boundCursors);
+      Update(bound);
+      ApplyAnimation(compressedByName, compressed, time);
+      Update(compressedByName);
+      ApplyAnimation(compressedBound, compressed, compressedBinding, time);
+      Update(compressedBound);
+      for (uint32_t j = 0; j < jointCount; ++j) {
+        same = same && SameBits(&legacy.joints[j].skeletonSpaceMatrix, &bound.skeletonSpaceMatrices[j],
+                                sizeof(Matrix4x4));
+        same = same && SameBits(&legacy.joints[j].transform, &bound.transforms[j], sizeof(QuaternionTransform));
+        same = same && SameBits(&byName.skeletonSpaceMatrices[j], &bound.skeletonSpaceMatrices[j],
+                                sizeof(Matrix4x4));
+        compressedSame = compressedSame && SameBits(&compressedByName.skeletonSpaceMatrices[j],
+                                                    &compressedBound.skeletonSpaceMatrices[j],
+                                                    sizeof(Matrix4x4));
+      }
+    }
+    check("bound matches legacy", same);
+    check("compressed bound matches by-name", compressedSame);
+    check("cursor per channel", boundCursors.size() == kAnimatedJointCount);
+
+    // クリップにない Joint はバインドポーズのまま
+    bool helpersKept = true;
+    for (const Joint &joint : bound.joints) {
+      if (!clip.nodeAnimations.contains(joint.name)) {
+        helpersKept = helpersKept && SameBits(&bound.transforms[joint.index],
+                                              &bindPose.transforms[joint.index],
+                                              sizeof(QuaternionTransform));
+      }
+    }
+    check("unanimated joints keep bind pose", helpersKept);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // 100 体を別々の時刻から再生する。1回の呼び出しで全員を1フレーム進める
+  std::vector<float> times(kInstanceCount);
+  for (uint32_t i = 0; i < kInstanceCount; ++i) {
+    times[i] = clip.duration * static_cast<float>(i) / kInstanceCount;
+  }
+  auto advance = [&](uint32_t instance) {
+    times[instance] = std::fmod(times[instance] + kFrameTime, clip.duration);
+    return times[instance];
+  };
+
+  {
+    std::vector<LegacySkeleton> skeletons(kInstanceCount);
+    std::vector<std::vector<NodeAnimationCursor>> cursors(kInstanceCount);
+    for (LegacySkeleton &skeleton : skeletons) {
+      CreateLegacyJoint(rootNode, {}, skeleton.joints);
+    }
+    runner.Run("Skeleton/Legacy name lookup(100 instances)", [&](uint64_t) {
+      for (uint32_t i = 0; i < kInstanceCount; ++i) {
+        LegacyApply(skeletons[i], clip, advance(i), cursors[i]);
+        LegacyUpdate(skeletons[i]);
+      }
+      Benchmark::DoNotOptimize(skeletons.data());
+    });
+  }
+
+  std::vector<Skeleton> skeletons(kInstanceCount, bindPose);
+  std::vector<std::vector<NodeAnimationCursor>> cursors(kInstanceCount);
+  runner.Run("Skeleton/Name lookup(100 instances)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kInstanceCount; ++i) {
+      ApplyAnimation(skeletons[i], clip, advance(i), cursors[i]);
+      Update(skeletons[i]);
+    }
+    Benchmark::DoNotOptimize(skeletons.data());
+  });
+
+  for (auto &instanceCursors : cursors) {
+    instanceCursors.clear();
+  }
+  runner.Run("Skeleton/Bound(100 instances)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kInstanceCount; ++i) {
+      ApplyAnimation(skeletons[i], binding, advance(i), cursors[i]);
+      Update(skeletons[i]);
+    }
+    Benchmark::DoNotOptimize(skeletons.data());
+  });
+
+  runner.Run("Skeleton/Compressed name lookup(100 instances)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kInstanceCount; ++i) {
+      ApplyAnimation(skeletons[i], compressed, advance(i));
+      Update(skeletons[i]);
+    }
+    Benchmark::DoNotOptimize(skeletons.data());
+  });
+
+  runner.Run("Skeleton/Compressed bound(100 instances)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kInstanceCount; ++i) {
+      ApplyAnimation(skeletons[i], compressed, compressedBinding, advance(i));
+      Update(skeletons[i]);
+    }
+    Benchmark::DoNotOptimize(skeletons.data());
+  });
+
+  // 行列の伝播だけ（適用のコストを除いた下限）
+  runner.Run("Skeleton/Update only(100 instances)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kInstanceCount; ++i) {
+      Update(skeletons[i]);
+    }
+    Benchmark::DoNotOptimize(skeletons.data());
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
@@ -0,0 +1,380 @@
+// スキニングの CPU 側の計算（Skinning::BuildPalette / SkinVertices / PackSkinWeights）の確認とベンチマーク
+// パレットは以前の SkinCluster の Update（Multiply と、一般の Inverse + Transpose）と、
+// 頂点は Skinning.CS をそのまま書き写したスカラー版と比べる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o skinning_benchmark tools/Benchmark/SkinningBenchmark.cpp
+//       Engine/src/Render/Model/Skinning.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./skinning_benchmark --out skinning_baseline.json
+//   ./skinning_benchmark --baseline skinning_baseline.json
+#include "BenchmarkCommon.h"
+#include "Math/MathUtil.h"
+#include "Model/Skinning.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kJointCount = 70;
+constexpr uint32_t kInstanceCount = 100;
+constexpr uint32_t kVertexCount = 10000;
+
+using VertexData = ModelAsset::VertexData;
+
+Quaternion RandomRotation(std::mt19937 &rng) {
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  Quaternion q{unit(rng), unit(rng), unit(rng), unit(rng)};
+  float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+  return {q.x / length, q.y / length, q.z / length, q.w / length};
+}
+
+// 非一様スケールや反転（行列式が負）も混ぜた姿勢
+std::vector<Matrix4x4> MakePose(uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+  std::vector<Matrix4x4> pose(kJointCount);
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    Vector3 s{scale(rng), scale(rng), scale(rng)};
+    if (j % 7 == 3) {
+      s.x = -s.x;
+    }
+    pose[j] = MakeAffineMatrix(s, RandomRotation(rng), Vector3{unit(rng), unit(rng), unit(rng)});
+  }
+  return pose;
+}
+
+// Skinning.CS を書き写したもの（比較用）
+void SkinReference(const WellForGPU *palette, const VertexData *input, const VertexInfluence *influences,
+                   size_t count, VertexData *output) {
+  for (size_t v = 0; v < count; ++v) {
+    Vector4 position{};
+    Vector3 normal{};
+    for (uint32_t k = 0; k < kNumMaxInfluence; ++k) {
+      const Matrix4x4 &m = palette[influences[v].jointIndices[k]].skeletonSpaceMatrix;
+      const Matrix4x4 &n = palette[influences[v].jointIndices[k]].skeletonSpaceInverseTransposeMatrix;
+      const float w = influences[v].weights[k];
+      const Vector4 &p = input[v].position;
+      position.x += (p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + p.w * m.m[3][0]) * w;
+      position.y += (p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + p.w * m.m[3][1]) * w;
+      position.z += (p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + p.w * m.m[3][2]) * w;
+      const Vector3 &q = input[v].normal;
+      normal.x += (q.x * n.m[0][0] + q.y * n.m[1][0] + q.z * n.m[2][0]) * w;
+      normal.y += (q.x * n.m[0][1] + q.y * n.m[1][1] + q.z * n.m[2][1]) * w;
+      normal.z += (q.x * n.m[0][2] + q.y * n.m[1][2] + q.z * n.m[2][2]) * w;
+    }
+    float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+    output[v].position = {position.x, position.y, position.z, 1.0f};
+    output[v].normal = {normal.x / length, normal.y / length, normal.z / length};
+    output[v].texcoord = input[v].texcoord;
+  }
+}
+
+// 以前の SkinCluster の Update と同じ作り方
+void BuildPaletteReference(const Matrix4x4 *inverseBindPose, const Matrix4x4 *skeletonSpace, size_t count,
+                           WellForGPU *palette) {
+  for (size_t j = 0; j < count; ++j) {
+    palette[j].skeletonSpaceMatrix = Multiply(inverseBindPose[j], skeletonSpace[j]);
+    palette[j].skeletonSpaceInverseTransposeMatrix = Transpose(Inverse(palette[j].skeletonSpaceMatrix));
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "skinning_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  // バインドポーズと、100 体分のアニメーション後の姿勢
+  const std::vector<Matrix4x4> bindPose = MakePose(1);
+  std::vector<Matrix4x4> inverseBindPose(kJointCount);
+  for (uint32_t j = 0; j < kJointCount; ++j) {
+    inverseBindPose[j] = Inverse(bindPose[j]);
+  }
+  std::vector<std::vector<Matrix4x4>> poses;
+  for (uint32_t i = 0; i < kInstanceCount; ++i) {
+    poses.push_back(MakePose(100 + i));
+  }
+
+  // 1〜4 個の影響を持つ頂点（空きは重み 0・番号 0。CreateSkinCluster の 0 埋めと同じ）
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::uniform_int_distribution<int32_t> anyJoint(0, kJointCount - 1);
+  std::vector<VertexData> vertices(kVertexCount);
+  std::vector<VertexInfluence> influences(kVertexCount);
+  for (uint32_t v = 0; v < kVertexCount; ++v) {
+    vertices[v].position = {unit(rng), unit(rng), unit(rng), 1.0f};
+    vertices[v].texcoord = {0.5f + 0.5f * unit(rng), 0.5f + 0.5f * unit(rng)};
+    Vector3 n{unit(rng), unit(rng), unit(rng) + 2.0f};
+    float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+    vertices[v].normal = {n.x / length, n.y / length, n.z / length};
+
+    VertexInfluence &influence = influences[v];
+    std::memset(&influence, 0, sizeof(influence));
+    uint32_t used = 1 + v % kNumMaxInfluence;
+    float total = 0.0f;
+    for (uint32_t k = 0; k < used; ++k) {
+      influence.weights[k] = 0.1f + 0.5f * (unit(rng) + 1.0f);
+      influence.jointIndices[k] = anyJoint(rng);
+      total += influence.weights[k];
+    }
+    for (uint32_t k = 0; k < used; ++k) {
+      influence.weights[k] /= total;
+    }
+  }
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[Skinning] %s\n", label);
+      ok = false;
+    }
+  };
+
+  std::vector<WellForGPU> palette(kJointCount);
+  std::vector<WellForGPU> referencePalette(kJointCount);
+  float maxNormalMatrixError = 0.0f;
+  bool positionsSame = true;
+  bool lastRowClean = true;
+  for (const std::vector<Matrix4x4> &pose : poses) {
+    Skinning::BuildPalette(inverseBindPose.data(), pose.data(), kJointCount, palette.data());
+    BuildPaletteReference(inverseBindPose.data(), pose.data(), kJointCount, referencePalette.data());
+    for (uint32_t j = 0; j < kJointCount; ++j) {
+      positionsSame = positionsSame && std::memcmp(&palette[j].skeletonSpaceMatrix,
+                                                   &referencePalette[j].skeletonSpaceMatrix,
+                                                   sizeof(Matrix4x4)) == 0;
+      // シェーダーは左上3x3しか使わない。要素の大きさで割った相対誤差で比べる
+      const Matrix4x4 &a = palette[j].skeletonSpaceInverseTransposeMatrix;
+      const Matrix4x4 &b = referencePalette[j].skeletonSpaceInverseTransposeMatrix;
+      float largest = 0.0f;
+      for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+          largest = std::fmax(largest, std::fabs(b.m[r][c]));
+        }
+      }
+      for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+          maxNormalMatrixError = std::fmax(maxNormalMatrixError, std::fabs(a.m[r][c] - b.m[r][c]) / largest);
+        }
+        lastRowClean = lastRowClean && a.m[r][3] == 0.0f && a.m[3][r] == 0.0f;
+      }
+      lastRowClean = lastRowClean && a.m[3][3] == 1.0f;
+    }
+  }
+  std::printf("normal matrix: max relative error %.2e vs Transpose(Inverse(m))\n", maxNormalMatrixError);
+  check("position matrix matches Multiply", positionsSame);
+  check("normal matrix matches inverse transpose", maxNormalMatrixError < 1.0e-5f);
+  check("normal matrix has no translation", lastRowClean);
+
+  {
+    // 潰れた行列（スケール 0）は割らずに余因子のまま。NaN・無限大を出さない
+    Matrix4x4 flat = MakeAffineMatrix(Vector3{1.0f, 0.0f, 1.0f}, Quaternion{0.0f, 0.0f, 0.0f, 1.0f},
+                                      Vector3{1.0f, 2.0f, 3.0f});
+    Matrix4x4 identity = MakeIdentity4x4();
+    WellForGPU well;
+    Skinning::BuildPalette(&identity, &flat, 1, &well);
+    bool finite = true;
+    for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        finite = finite && std::isfinite(well.skeletonSpaceInverseTransposeMatrix.m[r][c]);
+      }
+    }
+    check("degenerate matrix stays finite", finite);
+  }
+
+  {
+    // シェーダーの書き写しと比べる（パレットは以前の作り方のもの）
+    std::vector<VertexData> skinned(kVertexCount);
+    std::vector<VertexData> reference(kVertexCount);
+    float maxPositionError = 0.0f;
+    float maxNormalError = 0.0f;
+    bool attributes = true;
+    for (uint32_t i = 0; i < 8; ++i) {
+      Skinning::BuildPalette(inverseBindPose.data(), poses[i].data(), kJointCount, palette.data());
+      BuildPaletteReference(inverseBindPose.data(), poses[i].data(), kJointCount, referencePalette.data());
+      Skinning::SkinVertices(palette.data(), vertices.data(), influences.data(), kVertexCount, skinned.data());
+      SkinReference(referencePalette.data(), vertices.data(), influences.data(), kVertexCount, reference.data());
+      for (uint32_t v = 0; v < kVertexCount; ++v) {
+        const VertexData &a = skinned[v];
+        const VertexData &b = reference[v];
+        maxPositionError = std::fmax(maxPositionError, std::fabs(a.position.x - b.position.x));
+        maxPositionError = std::fmax(maxPositionError, std::fabs(a.position.y - b.position.y));
+        maxPositionError = std::fmax(maxPositionError, std::fabs(a.position.z - b.position.z));
+        maxNormalError = std::fmax(maxNormalError, std::fabs(a.normal.x - b.normal.x));
+        maxNormalError = std::fmax(maxNormalError, std::fabs(a.normal.y - b.normal.y));
+        maxNormalError = std::fmax(maxNormalError, std::fabs(a.normal.z - b.normal.z));
+        float length = std::sqrt(a.normal.x * a.normal.x + a.normal.y * a.normal.y + a.normal.z * a.normal.z);
+        attributes = attributes && a.position.w == 1.0f && a.texcoord.x == vertices[v].texcoord.x &&
+                     a.texcoord.y == vertices[v].texcoord.y && std::fabs(length - 1.0f) < 1.0e-5f;
+      }
+    }
+    std::printf("skinned vertices: max error position %.2e, normal %.2e vs Skinning.CS transcription\n",
+                maxPositionError, maxNormalError);
+    check("positions match shader", maxPositionError < 1.0e-5f);
+    check("normals match shader", maxNormalError < 1.0e-5f);
+    check("w, texcoord and unit normals", attributes);
+  }
+
+  // インポートしたままの影響（CreateSkinCluster に渡すのと同じ形）
+  std::vector<SkinWeight> skinWeights;
+  for (uint32_t v = 0; v < kVertexCount; ++v) {
+    for (uint32_t k = 0; k < kNumMaxInfluence; ++k) {
+      if (influences[v].weights[k] > 0.0f) {
+        skinWeights.push_back({v, static_cast<uint32_t>(influences[v].jointIndices[k]), influences[v].weights[k]});
+      }
+    }
+  }
+  // 1〜12 個の影響を持ち、合計が 1 でない頂点（上限を超えた分は落として正規化される）
+  std::vector<SkinWeight> heavyWeights;
+  for (uint32_t v = 0; v < kVertexCount; ++v) {
+    uint32_t used = 1 + v % 12;
+    for (uint32_t k = 0; k < used; ++k) {
+      heavyWeights.push_back({v, static_cast<uint32_t>((v * 7 + k * 13) % kJointCount), 0.05f + 0.5f * (unit(rng) + 1.0f)});
+    }
+  }
+  // 並び順によらないことも確かめるため、頂点の順番を崩しておく
+  std::shuffle(heavyWeights.begin(), heavyWeights.end(), rng);
+
+  {
+    const SkinWeightSettings layouts[] = {{4, 16, 0}, {4, 8, 0}, {8, 16, 0}, {8, 8, 16}};
+    for (const SkinWeightSettings &settings : layouts) {
+      PackedSkinWeights packed = Skinning::PackSkinWeights(heavyWeights.data(), heavyWeights.size(), kVertexCount,
+                                                           kJointCount, settings);
+      // 量子化したあとも重みの合計は 1（丸めのずれは一番大きい重みに寄せてある）
+      const float sumTolerance = settings.weightBits == 8 ? 1.0e-5f : 1.0e-6f;
+      const float valueTolerance = (settings.weightBits == 8 ? 1.0f / 255.0f : 1.0f / 65535.0f) * 4.0f;
+      float maxSumError = 0.0f;
+      float maxValueError = 0.0f;
+      bool topN = true;
+      std::vector<std::vector<SkinWeight>> byVertex(kVertexCount);
+      for (const SkinWeight &weight : heavyWeights) {
+        byVertex[weight.vertexIndex].push_back(weight);
+      }
+      for (uint32_t v = 0; v < kVertexCount; ++v) {
+        std::vector<SkinWeight> &source = byVertex[v];
+        std::sort(source.begin(), source.end(), [](const SkinWeight &a, const SkinWeight &b) {
+          return a.weight != b.weight ? a.weight > b.weight : a.jointIndex < b.jointIndex;
+        });
+        const size_t kept = std::min<size_t>(source.size(), settings.maxInfluences);
+        float keptTotal = 0.0f;
+        for (size_t k = 0; k < kept; ++k) {
+          keptTotal += source[k].weight;
+        }
+
+        float weights[kNumMaxPackedInfluence];
+        uint32_t joints[kNumMaxPackedInfluence];
+        uint32_t count = packed.Decode(v, weights, joints);
+        float sum = 0.0f;
+        for (uint32_t k = 0; k < count; ++k) {
+          sum += weights[k];
+          topN = topN && joints[k] == source[k].jointIndex;
+          maxValueError = std::fmax(maxValueError, std::fabs(weights[k] - source[k].weight / keptTotal));
+        }
+        topN = topN && count == kept;
+        maxSumError = std::fmax(maxSumError, std::fabs(sum - 1.0f));
+      }
+      std::printf("packed %u influences, UNORM%u weights, uint%u indices: %u bytes/vertex (float: %zu), "
+                  "weight sum error %.1e, weight error %.1e, %u vertices truncated (dropped up to %.0f%%)\n",
+                  packed.influenceCount, packed.weightBits, packed.indexBits, packed.strideInWords * 4,
+                  sizeof(VertexInfluence), maxSumError, maxValueError, packed.truncatedVertexCount,
+                  packed.maxDroppedWeight * 100.0f);
+      check("packed weights sum to 1", maxSumError <= sumTolerance);
+      check("packed weights keep the largest influences", topN);
+      check("packed weights are renormalized", maxValueError <= valueTolerance);
+      check("packed truncation is recorded",
+            packed.maxSourceInfluences == 12 &&
+                packed.truncatedVertexCount == kVertexCount / 12 * (12 - settings.maxInfluences));
+      check("packed index bits", packed.indexBits == (settings.indexBits != 0 ? settings.indexBits : 8u));
+    }
+  }
+
+  {
+    // 影響が4つ以下なら、パックしても float の影響での結果とほぼ同じ（差は重みの量子化の分だけ）
+    PackedSkinWeights packed16 = Skinning::PackSkinWeights(skinWeights.data(), skinWeights.size(), kVertexCount, kJointCount);
+    PackedSkinWeights packed8 =
+        Skinning::PackSkinWeights(skinWeights.data(), skinWeights.size(), kVertexCount, kJointCount, {4, 8, 0});
+    Skinning::BuildPalette(inverseBindPose.data(), poses[0].data(), kJointCount, palette.data());
+    std::vector<VertexData> expected(kVertexCount);
+    std::vector<VertexData> skinned(kVertexCount);
+    Skinning::SkinVertices(palette.data(), vertices.data(), influences.data(), kVertexCount, expected.data());
+    for (const PackedSkinWeights *packed : {&packed16, &packed8}) {
+      Skinning::SkinVerticesPacked(palette.data(), vertices.data(), *packed, skinned.data());
+      // 誤差は重みの量子化の幅 × 位置の大きさ程度になるので、位置の大きさで割って比べる
+      float maxPositionError = 0.0f;
+      float largest = 0.0f;
+      for (uint32_t v = 0; v < kVertexCount; ++v) {
+        maxPositionError = std::fmax(maxPositionError, std::fabs(skinned[v].position.x - expected[v].position.x));
+        maxPositionError = std::fmax(maxPositionError, std::fabs(skinned[v].position.y - expected[v].position.y));
+        maxPositionError = std::fmax(maxPositionError, std::fabs(skinned[v].position.z - expected[v].position.z));
+        largest = std::fmax(largest, std::fabs(expected[v].position.x));
+        largest = std::fmax(largest, std::fabs(expected[v].position.y));
+        largest = std::fmax(largest, std::fabs(expected[v].position.z));
+      }
+      const float step = 1.0f / float((1u << packed->weightBits) - 1u);
+      std::printf("packed UNORM%u skinning: max position error %.2e (%.2f steps of the largest coordinate %.1f)"
+                  " vs float influences\n",
+                  packed->weightBits, maxPositionError, maxPositionError / (largest * step), largest);
+      check("packed skinning matches float influences",
+            packed->truncatedVertexCount == 0 && maxPositionError <= largest * step * 2.0f);
+    }
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // 100 体分のパレット（1体 70 Joint）
+  std::vector<std::vector<WellForGPU>> palettes(kInstanceCount, std::vector<WellForGPU>(kJointCount));
+  runner.Run("Skinning/Palette Multiply+Inverse(100 x 70 joints)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kInstanceCount; ++i) {
+      BuildPaletteReference(inverseBindPose.data(), poses[i].data(), kJointCount, palettes[i].data());
+    }
+    Benchmark::DoNotOptimize(palettes.data());
+  });
+  runner.Run("Skinning/BuildPalette(100 x 70 joints)", [&](uint64_t) {
+    for (uint32_t i = 0; i < kInstanceCount; ++i) {
+      Skinning::BuildPalette(inverseBindPose.data(), poses[i].data(), kJointCount, palettes[i].data());
+    }
+    Benchmark::DoNotOptimize(palettes.data());
+  });
+
+  // 1体分の頂点（1万頂点）
+  std::vector<VertexData> skinned(kVertexCount);
+  runner.Run("Skinning/Shader transcription(10k vertices)", [&](uint64_t) {
+    SkinReference(palettes[0].data(), vertices.data(), influences.data(), kVertexCount, skinned.data());
+    Benchmark::DoNotOptimize(skinned.data());
+  });
+  runner.Run("Skinning/SkinVertices(10k vertices)", [&](uint64_t) {
+    Skinning::SkinVertices(palettes[0].data(), vertices.data(), influences.data(), kVertexCount,
+                           skinned.data());
+    Benchmark::DoNotOptimize(skinned.data());
+  });
+
+  // パックした影響（4影響・UNORM16 の重み・uint8 の番号で 1頂点 12 バイト。float の形は 32 バイト）
+  const PackedSkinWeights packed = Skinning::PackSkinWeights(skinWeights.data(), skinWeights.size(), kVertexCount, kJointCount);
+  runner.Run("Skinning/SkinVerticesPacked(10k vertices)", [&](uint64_t) {
+    Skinning::SkinVerticesPacked(palettes[0].data(), vertices.data(), packed, skinned.data());
+    Benchmark::DoNotOptimize(skinned.data());
+  });
+  runner.Run("Skinning/PackSkinWeights(10k vertices, 1-12 influences)", [&](uint64_t) {
+    PackedSkinWeights result =
+        Skinning::PackSkinWeights(heavyWeights.data(), heavyWeights.size(), kVertexCount, kJointCount);
+    Benchmark::DoNotOptimize(result.words.data());
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
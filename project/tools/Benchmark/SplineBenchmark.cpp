@@ -0,0 +1,163 @@
+// 弧長スプライン（レールカメラ）のベンチマーク
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -Iexternals -o spline_benchmark
+//       tools/Benchmark/SplineBenchmark.cpp
+//       Engine/src/Math/MathUtil.cpp Engine/src/Math/ArcLengthSpline.cpp
+//
+// 実行例:
+//   ./spline_benchmark --out spline_baseline.json
+//   ./spline_benchmark --baseline spline_baseline.json
+#include "BenchmarkCommon.h"
+#include "Math/ArcLengthSpline.h"
+#include "Math/MathUtil.h"
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kWaypointCount = 64;
+
+// 1フレームの移動量のばらつき（標準偏差 / 平均）の許容値
+constexpr float kMaxStepVariation = 0.01f;
+
+// 間隔がまちまちなレール（短い区間と長い区間が混在する）
+std::vector<Vector3> BuildRail() {
+  std::mt19937 rng(12345);
+  auto range = [&rng](float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+  };
+  std::vector<Vector3> points;
+  Vector3 point = {0.0f, 0.0f, 0.0f};
+  for (uint32_t i = 0; i < kWaypointCount; ++i) {
+    points.push_back(point);
+    point += Vector3{range(-10.0f, 10.0f), range(-3.0f, 3.0f), range(2.0f, 40.0f)};
+  }
+  return points;
+}
+
+// 1フレームの移動量のばらつき
+template <typename PositionAt> float StepVariation(uint32_t frames, PositionAt &&positionAt) {
+  std::vector<float> steps;
+  Vector3 prev = positionAt(0u);
+  for (uint32_t f = 1; f <= frames; ++f) {
+    Vector3 pos = positionAt(f);
+    steps.push_back(Length(pos - prev));
+    prev = pos;
+  }
+  double mean = 0.0;
+  for (float s : steps) {
+    mean += s;
+  }
+  mean /= static_cast<double>(steps.size());
+  double variance = 0.0;
+  for (float s : steps) {
+    variance += (s - mean) * (s - mean);
+  }
+  variance /= static_cast<double>(steps.size());
+  return static_cast<float>(std::sqrt(variance) / mean);
+}
+
+// 旧 RailCamera::CalcTangent 相当（中心差分）
+Vector3 FiniteDifferenceTangent(const std::vector<Vector3> &points, float t) {
+  float delta = 0.01f;
+  float maxT = static_cast<float>(points.size() - 1);
+  Vector3 p0 = ArcLengthSpline::EvaluatePosition(points, std::max(t - delta, 0.0f));
+  Vector3 p1 = ArcLengthSpline::EvaluatePosition(points, std::min(t + delta, maxT));
+  return SafeNormalize(p1 - p0);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "spline_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  std::vector<Vector3> rail = BuildRail();
+  ArcLengthSpline spline;
+  spline.Build(rail, 16, true);
+
+  const float maxT = spline.GetMaxParam();
+  const float length = spline.GetLength();
+  const uint32_t frames = 3600; // 60fps で 1 分
+  std::printf("rail: %u waypoints, length %.1f\n", kWaypointCount, length);
+
+  // 速さの一様性：セグメント単位の t を一定で進めた場合と距離で進めた場合を比べる
+  float segmentVariation = StepVariation(frames, [&](uint32_t f) {
+    return spline.GetPosition(maxT * static_cast<float>(f) / frames);
+  });
+  float arcLengthVariation = StepVariation(frames, [&](uint32_t f) {
+    return spline.GetPositionAtDistance(length * static_cast<float>(f) / frames);
+  });
+  std::printf("step variation: segment-uniform %.2f%%, arc-length %.3f%%\n",
+              segmentVariation * 100.0f, arcLengthVariation * 100.0f);
+  if (arcLengthVariation > kMaxStepVariation) {
+    std::fprintf(stderr, "[Spline] arc-length speed is not uniform\n");
+    return 1;
+  }
+
+  // 往復変換と解析的な接線の確認
+  float maxRoundTripError = 0.0f;
+  float minTangentDot = 1.0f;
+  float minFrameOrthogonality = 1.0f;
+  for (uint32_t i = 0; i <= 1000; ++i) {
+    float t = maxT * static_cast<float>(i) / 1000.0f;
+    maxRoundTripError =
+        std::max(maxRoundTripError, std::abs(spline.DistanceToParam(spline.ParamToDistance(t)) - t));
+    minTangentDot = std::min(minTangentDot, Dot(spline.GetTangent(t), FiniteDifferenceTangent(rail, t)));
+
+    ArcLengthSpline::Frame frame = spline.GetFrameAtDistance(spline.ParamToDistance(t));
+    float orthogonality = 1.0f - std::max({std::abs(Dot(frame.forward, frame.up)),
+                                           std::abs(Dot(frame.forward, frame.right)),
+                                           std::abs(Dot(frame.up, frame.right))});
+    minFrameOrthogonality = std::min(minFrameOrthogonality, orthogonality);
+  }
+  std::printf("round trip error %.5f, tangent dot %.5f, frame orthogonality %.5f\n\n",
+              maxRoundTripError, minTangentDot, minFrameOrthogonality);
+  if (maxRoundTripError > 1e-3f || minTangentDot < 0.999f || minFrameOrthogonality < 0.999f) {
+    std::fprintf(stderr, "[Spline] table or tangent mismatch\n");
+    return 1;
+  }
+
+  runner.Run("Spline/Build(16 samples/segment)", [&](uint64_t) {
+    ArcLengthSpline s;
+    s.Build(rail, 16, false);
+    Benchmark::DoNotOptimize(s.GetLength());
+  });
+
+  runner.Run("Spline/Build(+frames)", [&](uint64_t) {
+    ArcLengthSpline s;
+    s.Build(rail, 16, true);
+    Benchmark::DoNotOptimize(s.GetLength());
+  });
+
+  runner.Run("Spline/DistanceToParam", [&](uint64_t i) {
+    float r = spline.DistanceToParam(length * static_cast<float>(i % 4096) / 4096.0f);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("Spline/PositionAtDistance", [&](uint64_t i) {
+    Vector3 r = spline.GetPositionAtDistance(length * static_cast<float>(i % 4096) / 4096.0f);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("Spline/Tangent(analytic)", [&](uint64_t i) {
+    Vector3 r = spline.GetTangent(maxT * static_cast<float>(i % 4096) / 4096.0f);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("Spline/Tangent(finite difference)", [&](uint64_t i) {
+    Vector3 r = FiniteDifferenceTangent(rail, maxT * static_cast<float>(i % 4096) / 4096.0f);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  runner.Run("Spline/FrameAtDistance", [&](uint64_t i) {
+    ArcLengthSpline::Frame r =
+        spline.GetFrameAtDistance(length * static_cast<float>(i % 4096) / 4096.0f);
+    Benchmark::DoNotOptimize(r);
+  });
+
+  bool saved = runner.Save();
+  bool ok = runner.CompareWithBaseline();
+  return (saved && ok) ? 0 : 1;
+}
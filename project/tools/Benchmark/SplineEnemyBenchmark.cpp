@@ -0,0 +1,233 @@
+// スプライン移動の敵（BehaviorSpline）500体分のベンチマーク
+// 共有テーブルの確認には同梱の resources/levels/splines.json も使う
+// Enemy は D3D に依存するので、BehaviorSpline::Update のスプライン評価部分だけを取り出して比べる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -Iexternals -o spline_enemy_benchmark
+//       tools/Benchmark/SplineEnemyBenchmark.cpp
+//       Engine/src/Math/MathUtil.cpp Engine/src/Math/ArcLengthSpline.cpp
+//
+// 実行例:
+//   ./spline_enemy_benchmark --out spline_enemy_baseline.json
+//   ./spline_enemy_benchmark --baseline spline_enemy_baseline.json
+#include "BenchmarkCommon.h"
+#include "Math/ArcLengthSpline.h"
+#include "Math/MathUtil.h"
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace {
+
+constexpr uint32_t kEnemyCount = 500;
+constexpr uint32_t kSplineCount = 8; // splines.json に並ぶ程度の本数
+constexpr float kSampleSpacing = 0.25f; // GamePlayScene::kSplineSampleSpacing と同じ
+
+struct Pose {
+  Vector3 position;
+  Vector3 direction;
+};
+
+// 変更前の BehaviorSpline::Update と同じ評価（セグメント一様 + 少し先の点を向く）
+Pose LegacyEvaluate(const std::vector<Vector3> &waypoints, float progress) {
+  int maxSegments = static_cast<int>(waypoints.size()) - 1;
+  float totalT = progress * static_cast<float>(maxSegments);
+  int segmentIndex = std::min(static_cast<int>(totalT), maxSegments - 1);
+  float t = totalT - segmentIndex;
+
+  auto getWaypoint = [&](int index) -> const Vector3 & {
+    return waypoints[std::max(0, std::min(index, maxSegments))];
+  };
+  const Vector3 &p0 = getWaypoint(segmentIndex - 1);
+  const Vector3 &p1 = getWaypoint(segmentIndex);
+  const Vector3 &p2 = getWaypoint(segmentIndex + 1);
+  const Vector3 &p3 = getWaypoint(segmentIndex + 2);
+  Vector3 pos = CatmullRom(p0, p1, p2, p3, t);
+
+  float tNext = t + 0.05f;
+  Vector3 next;
+  if (tNext >= 1.0f && segmentIndex + 1 < maxSegments) {
+    next = CatmullRom(getWaypoint(segmentIndex), getWaypoint(segmentIndex + 1),
+                      getWaypoint(segmentIndex + 2), getWaypoint(segmentIndex + 3), tNext - 1.0f);
+  } else {
+    next = CatmullRom(p0, p1, p2, p3, std::min(1.0f, tNext));
+  }
+  return {pos, SafeNormalize(next - pos)};
+}
+
+// 変更後の BehaviorSpline::Update と同じ評価（共有テーブルを距離で引く）
+Pose SharedEvaluate(const ArcLengthSpline &spline, float progress) {
+  ArcLengthSpline::Sample sample = spline.SampleAtDistance(progress * spline.GetLength());
+  return {sample.position, sample.tangent};
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options =
+      Benchmark::ParseOptions(argc, argv, "spline_enemy_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  std::mt19937 rng(12345);
+  auto range = [&rng](float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+  };
+
+  // カメラローカルの敵用スプライン（6～12点）
+  std::vector<std::vector<Vector3>> rawSplines;
+  std::vector<std::shared_ptr<const ArcLengthSpline>> sharedSplines;
+  for (uint32_t s = 0; s < kSplineCount; ++s) {
+    std::vector<Vector3> points;
+    uint32_t count = 6 + (s % 7);
+    for (uint32_t i = 0; i < count; ++i) {
+      points.push_back({range(-30.0f, 30.0f), range(-10.0f, 15.0f), range(10.0f, 80.0f)});
+    }
+    auto spline = std::make_shared<ArcLengthSpline>();
+    spline->Build(points);
+    spline->BakeDistanceSamples(kSampleSpacing);
+    rawSplines.push_back(points);
+    sharedSplines.push_back(spline);
+  }
+
+  // 敵ごとに使うスプラインと経過割合
+  std::vector<uint32_t> splineIndex(kEnemyCount);
+  std::vector<float> progress(kEnemyCount);
+  for (uint32_t e = 0; e < kEnemyCount; ++e) {
+    splineIndex[e] = e % kSplineCount;
+    progress[e] = range(0.0f, 0.999f);
+  }
+
+  // 現在の評価との比較
+  // 1. 同じパラメータなら位置は一致する
+  // 2. 通過点（制御点）は同じ順で通り、始点と終点も一致する
+  // 3. 進行方向は曲線の接線と一致する（先読み方式はカーブのきつい所でずれるので参考値として出す）
+  // 焼き込みサンプル間は線形補間なので、誤差はサンプル間隔の範囲に収まっていればよい
+  float maxPositionError = 0.0f;
+  float maxSampledError = 0.0f;
+  float minTangentDot = 1.0f;
+  double tangentDotSum = 0.0;
+  double lookAheadDotSum = 0.0;
+  uint32_t lookAheadCount = 0;
+  for (uint32_t s = 0; s < kSplineCount; ++s) {
+    const std::vector<Vector3> &points = rawSplines[s];
+    const ArcLengthSpline &spline = *sharedSplines[s];
+    float maxT = spline.GetMaxParam();
+
+    for (uint32_t i = 0; i <= 200; ++i) {
+      float legacyProgress = static_cast<float>(i) / 200.0f * 0.999f;
+      Pose legacy = LegacyEvaluate(points, legacyProgress);
+      Vector3 table = spline.GetPosition(legacyProgress * maxT);
+      maxPositionError = std::max(maxPositionError, Length(legacy.position - table));
+
+      // 同じ地点での進行方向
+      float distance = spline.ParamToDistance(legacyProgress * maxT);
+      Pose shared = SharedEvaluate(spline, distance / spline.GetLength());
+      maxSampledError = std::max(maxSampledError, Length(legacy.position - shared.position));
+      lookAheadDotSum += Dot(legacy.direction, shared.direction);
+      ++lookAheadCount;
+
+      float t = legacyProgress * maxT;
+      Vector3 exact = SafeNormalize(spline.GetPosition(std::min(t + 1e-3f, maxT)) -
+                                    spline.GetPosition(std::max(t - 1e-3f, 0.0f)));
+      minTangentDot = std::min(minTangentDot, Dot(exact, shared.direction));
+      tangentDotSum += Dot(exact, shared.direction);
+    }
+
+    for (uint32_t k = 0; k < points.size(); ++k) {
+      float distance = spline.ParamToDistance(static_cast<float>(k));
+      maxPositionError =
+          std::max(maxPositionError, Length(spline.GetPositionAtDistance(distance) - points[k]));
+    }
+  }
+  double meanTangentDot = tangentDotSum / lookAheadCount;
+  std::printf("max position error %.5f (sampled %.5f), tangent dot mean %.5f / min %.5f, "
+              "mean dot vs look-ahead %.4f\n\n",
+              maxPositionError, maxSampledError, meanTangentDot, minTangentDot,
+              lookAheadDotSum / lookAheadCount);
+  if (maxPositionError > 1e-2f || maxSampledError > kSampleSpacing * 0.5f ||
+      meanTangentDot < 0.999) {
+    std::fprintf(stderr, "[SplineEnemy] shared table does not match legacy evaluation\n");
+    return 1;
+  }
+
+  // 同梱の splines.json のレールと、サンプル間隔より急な折り返しを持つレールで、
+  // 共有テーブルの向きが実際に動いている向きと一致する（接線を焼いて補間すると急なカーブで大きくずれる）
+  // 位置のずれは進んだ距離の補間の誤差だけなので、サンプル間隔の範囲に収まればよい
+  {
+    std::vector<std::pair<std::string, std::vector<Vector3>>> rails;
+    rails.push_back({"hairpin", {{0.0f, 0.0f, 0.0f}, {10.0f, 0.0f, 0.0f}, {10.3f, 0.0f, 0.2f},
+                                 {10.0f, 0.0f, 0.4f}, {0.0f, 0.0f, 0.4f}}});
+    std::ifstream file("Application/resources/levels/splines.json");
+    nlohmann::json root = nlohmann::json::parse(file, nullptr, false);
+    if (!root.is_discarded() && root.contains("rails")) {
+      for (const auto &rail : root["rails"]) {
+        std::vector<Vector3> points;
+        for (const auto &p : rail["points"]) {
+          points.push_back({p[0].get<float>(), p[1].get<float>(), p[2].get<float>()});
+        }
+        rails.push_back({rail["name"].get<std::string>(), std::move(points)});
+      }
+    }
+
+    constexpr float kStep = 0.01f; // 動いている向きを測る幅
+    float railPositionError = 0.0f;
+    float railMinDot = 1.0f;
+    std::string worstRail;
+    for (const auto &[name, points] : rails) {
+      ArcLengthSpline spline;
+      spline.Build(points);
+      spline.BakeDistanceSamples(kSampleSpacing);
+      for (uint32_t i = 0; i <= 100000; ++i) {
+        float distance = kStep + static_cast<float>(i) / 100000.0f * (spline.GetLength() - kStep * 2.0f);
+        ArcLengthSpline::Sample sample = spline.SampleAtDistance(distance);
+        railPositionError =
+            std::max(railPositionError, Length(sample.position - spline.GetPositionAtDistance(distance)));
+        Vector3 motion = SafeNormalize(spline.SampleAtDistance(distance + kStep).position -
+                                       spline.SampleAtDistance(distance - kStep).position);
+        float dot = Dot(sample.tangent, motion);
+        if (dot < railMinDot) {
+          railMinDot = dot;
+          worstRail = name;
+        }
+      }
+    }
+    std::printf("rails %zu (bundled %zu): position error %.5f, facing vs motion dot min %.6f (%s)\n\n",
+                rails.size(), rails.size() - 1, railPositionError, railMinDot, worstRail.c_str());
+    if (rails.size() < 2 || railPositionError > kSampleSpacing * 0.5f || railMinDot < 0.9999f) {
+      std::fprintf(stderr, "[SplineEnemy] shared table facing does not follow the rails\n");
+      return 1;
+    }
+  }
+
+  std::vector<Pose> poses(kEnemyCount);
+
+  runner.Run("SplineEnemy/Legacy x500", [&](uint64_t) {
+    for (uint32_t e = 0; e < kEnemyCount; ++e) {
+      poses[e] = LegacyEvaluate(rawSplines[splineIndex[e]], progress[e]);
+    }
+    Benchmark::DoNotOptimize(poses.data()[0]);
+  });
+
+  runner.Run("SplineEnemy/SharedTable x500", [&](uint64_t) {
+    for (uint32_t e = 0; e < kEnemyCount; ++e) {
+      poses[e] = SharedEvaluate(*sharedSplines[splineIndex[e]], progress[e]);
+    }
+    Benchmark::DoNotOptimize(poses.data()[0]);
+  });
+
+  runner.Run("SplineEnemy/Build x8 (once per load)", [&](uint64_t) {
+    for (uint32_t s = 0; s < kSplineCount; ++s) {
+      ArcLengthSpline spline;
+      spline.Build(rawSplines[s]);
+      spline.BakeDistanceSamples(kSampleSpacing);
+      Benchmark::DoNotOptimize(spline.GetLength());
+    }
+  });
+
+  bool saved = runner.Save();
+  bool ok = runner.CompareWithBaseline();
+  return (saved && ok) ? 0 : 1;
+}
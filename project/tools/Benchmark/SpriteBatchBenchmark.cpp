@@ -0,0 +1,283 @@
+// スプライトのバッチ（SpriteBatch）の確認とベンチマーク
+// 状態（テクスチャ・ブレンド・エフェクト）が変わるところでだけバッチが分かれること、登録順が保たれることを確かめ、
+// HUD を想定した約 340 枚のスプライトを 1 枚ずつ描く場合とバッチで描く場合の描画コマンド数を比べる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o sprite_batch_benchmark tools/Benchmark/SpriteBatchBenchmark.cpp
+//       Engine/src/Render/Renderer/SpriteBatch.cpp Engine/src/Render/Renderer/RecordingCommandRecorder.cpp
+//
+// 実行例:
+//   ./sprite_batch_benchmark --out sprite_batch_baseline.json
+//   ./sprite_batch_benchmark --baseline sprite_batch_baseline.json
+#include "BenchmarkCommon.h"
+#include "Renderer/RecordingCommandRecorder.h"
+#include "Renderer/SpriteBatch.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+using Type = RecordingCommandRecorder::Type;
+using BlendMode = SpriteBatch::BlendMode;
+using Effect = SpriteBatch::Effect;
+
+// テクスチャのハンドルの代わり
+constexpr ICommandRecorder::DescriptorHandle kWhite = 0x1000;
+constexpr ICommandRecorder::DescriptorHandle kReticle = 0x2000;
+constexpr ICommandRecorder::DescriptorHandle kIconA = 0x3000;
+constexpr ICommandRecorder::DescriptorHandle kIconB = 0x4000;
+constexpr ICommandRecorder::DescriptorHandle kFont = 0x5000;
+
+constexpr ICommandRecorder::GpuAddress kVertexBuffer = 0x10000000;
+const ICommandRecorder::IndexBufferView kIndexBuffer = {
+    0x20000000, SpriteBatch::kMaxQuadsPerDraw * SpriteBatch::kIndicesPerQuad * 2,
+    ICommandRecorder::IndexFormat::UInt16};
+
+// PSO の代わり（ブレンド × エフェクトごとに別のアドレス）
+int gPipelines[size_t(BlendMode::kCount)][size_t(Effect::kCount)];
+
+ICommandRecorder::PipelineHandle PipelineOf(const SpriteBatch::State &state) {
+  return &gPipelines[size_t(state.blendMode)][size_t(state.effect)];
+}
+
+SpriteBatch::State MakeState(ICommandRecorder::DescriptorHandle texture, BlendMode blendMode = BlendMode::Alpha,
+                             Effect effect = Effect::None) {
+  SpriteBatch::State state;
+  state.texture = texture;
+  state.blendMode = blendMode;
+  state.effect = effect;
+  return state;
+}
+
+// 1 枚分の四角形（位置の x に通し番号を入れて、並びを確かめられるようにする）
+void MakeQuad(float id, SpriteBatch::Vertex (&quad)[SpriteBatch::kVerticesPerQuad]) {
+  for (uint32_t i = 0; i < SpriteBatch::kVerticesPerQuad; ++i) {
+    quad[i] = {};
+    quad[i].position = {id, float(i), 0.0f, 1.0f};
+    quad[i].color = {1.0f, 1.0f, 1.0f, 1.0f};
+  }
+}
+
+// HUD の1フレーム分のスプライト（描く順）
+struct HudSprite {
+  SpriteBatch::State state;
+};
+
+std::vector<HudSprite> MakeHud() {
+  std::vector<HudSprite> hud;
+  // 敵の HP バー（背景と中身、どちらも白1x1 を色で塗る）
+  for (uint32_t i = 0; i < 60; ++i) {
+    hud.push_back({MakeState(kWhite)});
+    hud.push_back({MakeState(kWhite)});
+  }
+  // ロックオンのレティクル
+  for (uint32_t i = 0; i < 40; ++i) {
+    hud.push_back({MakeState(kReticle)});
+  }
+  // ボスのレティクル（加算）
+  for (uint32_t i = 0; i < 8; ++i) {
+    hud.push_back({MakeState(kReticle, BlendMode::Add)});
+  }
+  // アイコンの並び（2 種類が交互に並ぶ、最も分かれる場合）
+  for (uint32_t i = 0; i < 20; ++i) {
+    hud.push_back({MakeState(i % 2 == 0 ? kIconA : kIconB)});
+  }
+  // 波打ちエフェクトのタイトル
+  hud.push_back({MakeState(kFont, BlendMode::Alpha, Effect::UIEffect)});
+  // 文字（フォントのアトラス）
+  for (uint32_t i = 0; i < 150; ++i) {
+    hud.push_back({MakeState(kFont)});
+  }
+  return hud;
+}
+
+// 以前の Sprite::Draw と同じ積み方（1 枚ごとに頂点・インデックスバッファ、定数 2 つ、テクスチャ、描画）
+void RecordIndividually(RecordingCommandRecorder &recorder, const std::vector<HudSprite> &hud) {
+  ICommandRecorder::PipelineHandle currentPipeline = nullptr;
+  for (size_t i = 0; i < hud.size(); ++i) {
+    // エフェクトを使うときは PSO を切り替えていた（Begin / BeginUIEffect）
+    ICommandRecorder::PipelineHandle pipeline = PipelineOf(hud[i].state);
+    if (pipeline != currentPipeline) {
+      recorder.SetPipelineState(pipeline);
+      currentPipeline = pipeline;
+    }
+    recorder.SetVertexBuffer(0, {kVertexBuffer + i * 0x100, 4 * 24, 24});
+    recorder.SetIndexBuffer({kVertexBuffer + i * 0x100 + 0x80, 6 * 4, ICommandRecorder::IndexFormat::UInt32});
+    recorder.SetRootConstantBufferView(0, kVertexBuffer + i * 0x200);
+    recorder.SetRootConstantBufferView(1, kVertexBuffer + i * 0x200 + 0x100);
+    recorder.SetRootDescriptorTable(2, hud[i].state.texture);
+    recorder.DrawIndexedInstanced(6, 1, 0, 0, 0);
+  }
+}
+
+uint32_t RecordBatched(SpriteBatch &batch, RecordingCommandRecorder &recorder, const std::vector<HudSprite> &hud) {
+  batch.Clear();
+  SpriteBatch::Vertex quad[SpriteBatch::kVerticesPerQuad];
+  for (size_t i = 0; i < hud.size(); ++i) {
+    MakeQuad(float(i), quad);
+    batch.Add(hud[i].state, quad);
+  }
+  return batch.Record(recorder, kVertexBuffer, kIndexBuffer, 0, PipelineOf);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "sprite_batch_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[SpriteBatch] %s\n", label);
+      ok = false;
+    }
+  };
+
+  SpriteBatch::Vertex quad[SpriteBatch::kVerticesPerQuad];
+  {
+    // 同じ状態が続く間は1つのバッチ
+    SpriteBatch batch;
+    check("empty", batch.IsEmpty() && batch.GetBatches().empty());
+    for (uint32_t i = 0; i < 5; ++i) {
+      MakeQuad(float(i), quad);
+      batch.Add(MakeState(kWhite), quad);
+    }
+    check("same state merges", batch.GetBatches().size() == 1 && batch.GetBatches()[0].quadCount == 5 &&
+                                   batch.GetQuadCount() == 5 && batch.GetVertices().size() == 20);
+
+    // テクスチャ・ブレンド・エフェクトのどれが変わっても分かれる
+    MakeQuad(5.0f, quad);
+    batch.Add(MakeState(kReticle), quad);
+    MakeQuad(6.0f, quad);
+    batch.Add(MakeState(kReticle, BlendMode::Add), quad);
+    MakeQuad(7.0f, quad);
+    batch.Add(MakeState(kReticle, BlendMode::Add, Effect::UIEffect), quad);
+    const std::vector<SpriteBatch::Batch> &batches = batch.GetBatches();
+    check("texture splits", batches.size() == 4 && batches[1].state.texture == kReticle);
+    check("blend splits", batches[2].state.blendMode == BlendMode::Add && batches[2].firstQuad == 6);
+    check("effect splits", batches[3].state.effect == Effect::UIEffect && batches[3].firstQuad == 7);
+
+    // 登録順のまま（並べ替えない）
+    bool ordered = true;
+    for (uint32_t i = 0; i < batch.GetQuadCount(); ++i) {
+      ordered = ordered && batch.GetVertices()[i * SpriteBatch::kVerticesPerQuad].position.x == float(i);
+    }
+    check("submission order kept", ordered);
+
+    batch.Clear();
+    check("clear", batch.IsEmpty() && batch.GetBatches().empty() && batch.GetQuadCount() == 0);
+  }
+
+  {
+    // A-B-A は3つ（後ろの A を前の A にまとめると重なり順が変わる）
+    SpriteBatch batch;
+    MakeQuad(0.0f, quad);
+    batch.Add(MakeState(kIconA), quad);
+    batch.Add(MakeState(kIconB), quad);
+    batch.Add(MakeState(kIconA), quad);
+    check("A-B-A stays three batches", batch.GetBatches().size() == 3);
+
+    // 状態が変わるときだけ PSO とテクスチャを設定し、ベース頂点で四角形をずらす
+    RecordingCommandRecorder recorder;
+    uint32_t draws = batch.Record(recorder, kVertexBuffer, kIndexBuffer, 0, PipelineOf);
+    check("record draws", draws == 3 && recorder.GetDrawCount() == 3);
+    check("buffers set once", recorder.Count(Type::SetVertexBuffer) == 1 && recorder.Count(Type::SetIndexBuffer) == 1);
+    check("pipeline set once", recorder.Count(Type::SetPipelineState) == 1);
+    check("texture set per change", recorder.Count(Type::SetRootDescriptorTable) == 3);
+    std::vector<int32_t> baseVertices;
+    for (const RecordingCommandRecorder::Command &command : recorder.GetCommands()) {
+      if (command.type == Type::DrawIndexedInstanced) {
+        baseVertices.push_back(command.baseVertex);
+        check("six indices per quad", command.count == 6 && command.start == 0);
+      }
+    }
+    check("base vertex", baseVertices == std::vector<int32_t>({0, 4, 8}));
+  }
+
+  {
+    // 同じテクスチャでブレンドだけ変わるときは PSO だけ切り替える
+    SpriteBatch batch;
+    MakeQuad(0.0f, quad);
+    batch.Add(MakeState(kReticle), quad);
+    batch.Add(MakeState(kReticle, BlendMode::Add), quad);
+    RecordingCommandRecorder recorder;
+    batch.Record(recorder, kVertexBuffer, kIndexBuffer, 0, PipelineOf);
+    check("blend change keeps texture",
+          recorder.Count(Type::SetPipelineState) == 2 && recorder.Count(Type::SetRootDescriptorTable) == 1);
+
+    // 空なら何も積まない
+    batch.Clear();
+    recorder.Clear();
+    check("empty records nothing",
+          batch.Record(recorder, kVertexBuffer, kIndexBuffer, 0, PipelineOf) == 0 && recorder.GetCommandCount() == 0);
+  }
+
+  {
+    // 16bit インデックスで届かない数は描画を分ける
+    SpriteBatch batch;
+    MakeQuad(0.0f, quad);
+    const uint32_t quadCount = SpriteBatch::kMaxQuadsPerDraw * 2 + 10;
+    for (uint32_t i = 0; i < quadCount; ++i) {
+      batch.Add(MakeState(kFont), quad);
+    }
+    RecordingCommandRecorder recorder;
+    uint32_t draws = batch.Record(recorder, kVertexBuffer, kIndexBuffer, 0, PipelineOf);
+    check("chunked draws", batch.GetBatches().size() == 1 && draws == 3);
+    uint32_t indices = 0;
+    int32_t lastBase = -1;
+    for (const RecordingCommandRecorder::Command &command : recorder.GetCommands()) {
+      if (command.type == Type::DrawIndexedInstanced) {
+        indices += command.count;
+        lastBase = command.baseVertex;
+      }
+    }
+    check("chunks cover all quads", indices == quadCount * SpriteBatch::kIndicesPerQuad &&
+                                        lastBase == int32_t(SpriteBatch::kMaxQuadsPerDraw * 2 * 4));
+  }
+
+  {
+    // インデックスは 0,1,2 / 1,3,2 を4頂点ずつずらしたもの
+    std::vector<uint16_t> indices(SpriteBatch::kMaxQuadsPerDraw * SpriteBatch::kIndicesPerQuad);
+    SpriteBatch::WriteIndices(indices.data(), SpriteBatch::kMaxQuadsPerDraw);
+    check("first quad indices", indices[0] == 0 && indices[1] == 1 && indices[2] == 2 && indices[3] == 1 &&
+                                    indices[4] == 3 && indices[5] == 2);
+    check("second quad indices", indices[6] == 4 && indices[10] == 7);
+    check("last quad fits in 16 bits", indices.back() == uint16_t(SpriteBatch::kMaxQuadsPerDraw * 4 - 2) &&
+                                           indices[indices.size() - 2] == 65535);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  const std::vector<HudSprite> hud = MakeHud();
+  RecordingCommandRecorder individual;
+  RecordIndividually(individual, hud);
+  SpriteBatch batch;
+  RecordingCommandRecorder batched;
+  RecordBatched(batch, batched, hud);
+  std::printf("%zu sprites: individual %zu draws / %zu commands, batched %zu draws / %zu commands (%zu batches)\n",
+              hud.size(), individual.GetDrawCount(), individual.GetCommandCount(), batched.GetDrawCount(),
+              batched.GetCommandCount(), batch.GetBatches().size());
+
+  runner.Run("SpriteBatch/individual draws (HUD)", [&](uint64_t) {
+    individual.Clear();
+    RecordIndividually(individual, hud);
+    Benchmark::DoNotOptimize(individual.GetCommandCount());
+  });
+  runner.Run("SpriteBatch/batched (HUD)", [&](uint64_t) {
+    batched.Clear();
+    Benchmark::DoNotOptimize(RecordBatched(batch, batched, hud));
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
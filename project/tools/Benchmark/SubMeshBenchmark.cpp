@@ -0,0 +1,277 @@
+// 複数メッシュ・複数マテリアルのモデル結合（AppendSubMesh / BuildDrawRanges）の確認とベンチマーク
+// 同梱の multiMesh.obj / multiMaterial.obj を ObjReader（Assimp と同じ分け方）で読んで確かめる
+//
+// ビルド例（Linux, project/ ディレクトリで実行。モデルは Application/resources から読む）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals
+//       -o submesh_benchmark tools/Benchmark/SubMeshBenchmark.cpp
+//       Engine/src/Render/Model/ModelAssetData.cpp Engine/src/Render/Model/MeshCache.cpp
+//
+// 実行例:
+//   ./submesh_benchmark --out submesh_baseline.json
+//   ./submesh_benchmark --baseline submesh_baseline.json
+#include "BenchmarkCommon.h"
+#include "ObjReader.h"
+#include "Model/MeshCache.h"
+#include "Model/ModelAssetData.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+
+const char *kResourceDirectory = "Application/resources";
+
+// Assimp の aiMesh 相当（メッシュ内の頂点番号で書かれたインデックスとマテリアル番号）
+struct SourceMesh {
+  std::vector<ModelAsset::VertexData> vertices;
+  std::vector<uint32_t> indices;
+  uint32_t materialIndex;
+  std::vector<ModelAsset::VertexWeightData> weights; // 1ジョイント分
+};
+
+std::vector<SourceMesh> ToSourceMeshes(const ObjReader::Scene &scene) {
+  std::vector<SourceMesh> meshes;
+  for (const ObjReader::Mesh &mesh : scene.meshes) {
+    meshes.push_back({mesh.vertices, mesh.indices, mesh.materialIndex, {}});
+  }
+  return meshes;
+}
+
+SourceMesh MakeGridMesh(uint32_t quads, float offsetX, uint32_t materialIndex) {
+  SourceMesh mesh;
+  mesh.materialIndex = materialIndex;
+  for (uint32_t q = 0; q <= quads; ++q) {
+    float x = offsetX + static_cast<float>(q);
+    mesh.vertices.push_back({{x, 0.0f, 0.0f, 1.0f}, {x, 0.0f}, {0.0f, 1.0f, 0.0f}});
+    mesh.vertices.push_back({{x, 0.0f, 1.0f, 1.0f}, {x, 1.0f}, {0.0f, 1.0f, 0.0f}});
+  }
+  for (uint32_t q = 0; q < quads; ++q) {
+    uint32_t i = q * 2;
+    mesh.indices.insert(mesh.indices.end(), {i, i + 1, i + 2, i + 2, i + 1, i + 3});
+  }
+  for (uint32_t v = 0; v < mesh.vertices.size(); ++v) {
+    mesh.weights.push_back({1.0f, v});
+  }
+  return mesh;
+}
+
+// Model::LoadModelFile と同じ手順で結合する（マテリアル順に並べてから追加）
+ModelAsset::ModelData Merge(const std::vector<SourceMesh> &meshes, uint32_t materialCount) {
+  std::vector<uint32_t> materialIndices;
+  for (const SourceMesh &mesh : meshes) {
+    materialIndices.push_back(mesh.materialIndex);
+  }
+
+  ModelAsset::ModelData data;
+  data.materials.resize(materialCount);
+  for (uint32_t meshIndex : ModelAsset::MakeMaterialOrder(materialIndices)) {
+    const SourceMesh &mesh = meshes[meshIndex];
+    ModelAsset::SubMesh subMesh =
+        ModelAsset::AppendSubMesh(data, mesh.vertices, mesh.indices, mesh.materialIndex);
+    auto &joint = data.skinClusterData["mesh" + std::to_string(meshIndex)];
+    for (const ModelAsset::VertexWeightData &weight : mesh.weights) {
+      joint.vertexWeights.push_back({weight.weight, subMesh.vertexOffset + weight.vertexIndex});
+    }
+  }
+  return data;
+}
+
+// 結合後のデータが元のメッシュと一致するか
+bool Verify(const char *label, const std::vector<SourceMesh> &meshes,
+            const ModelAsset::ModelData &data, size_t expectedRanges) {
+  bool ok = true;
+  auto fail = [&](const std::string &message) {
+    std::fprintf(stderr, "[SubMesh] %s: %s\n", label, message.c_str());
+    ok = false;
+  };
+
+  size_t vertexTotal = 0;
+  size_t indexTotal = 0;
+  for (const SourceMesh &mesh : meshes) {
+    vertexTotal += mesh.vertices.size();
+    indexTotal += mesh.indices.size();
+  }
+  if (data.vertices.size() != vertexTotal || data.indices.size() != indexTotal ||
+      data.subMeshes.size() != meshes.size()) {
+    fail("merged sizes do not match the source meshes");
+    return false;
+  }
+
+  // 各サブメッシュのインデックスは自分の頂点範囲を指し、元の頂点と同じ位置になる
+  for (size_t s = 0; s < data.subMeshes.size(); ++s) {
+    const ModelAsset::SubMesh &subMesh = data.subMeshes[s];
+    const SourceMesh *source = nullptr;
+    for (const SourceMesh &mesh : meshes) {
+      if (mesh.materialIndex == subMesh.materialIndex &&
+          mesh.vertices.size() == subMesh.vertexCount &&
+          mesh.vertices[0].position.x == data.vertices[subMesh.vertexOffset].position.x) {
+        source = &mesh;
+      }
+    }
+    if (!source) {
+      fail("submesh " + std::to_string(s) + " has no matching source mesh");
+      continue;
+    }
+    for (uint32_t i = 0; i < subMesh.indexCount; ++i) {
+      uint32_t merged = data.indices[subMesh.indexOffset + i];
+      if (merged < subMesh.vertexOffset || merged >= subMesh.vertexOffset + subMesh.vertexCount ||
+          data.vertices[merged].position.x != source->vertices[source->indices[i]].position.x ||
+          data.vertices[merged].position.z != source->vertices[source->indices[i]].position.z) {
+        fail("submesh " + std::to_string(s) + " index " + std::to_string(i) + " is wrong");
+        break;
+      }
+    }
+  }
+
+  // ボーンの頂点番号も結合後の番号になる
+  for (const auto &[name, joint] : data.skinClusterData) {
+    for (const ModelAsset::VertexWeightData &weight : joint.vertexWeights) {
+      if (weight.vertexIndex >= data.vertices.size()) {
+        fail("weight of " + name + " points outside the merged vertices");
+        break;
+      }
+    }
+  }
+
+  // 描画範囲はマテリアルごとに1つで、全インデックスをちょうど1回ずつ覆う
+  std::vector<ModelAsset::DrawRange> ranges = ModelAsset::BuildDrawRanges(data.subMeshes);
+  if (ranges.size() != expectedRanges) {
+    fail("expected " + std::to_string(expectedRanges) + " draw ranges, got " +
+         std::to_string(ranges.size()));
+  }
+  std::vector<uint8_t> covered(data.indices.size(), 0);
+  for (const ModelAsset::DrawRange &range : ranges) {
+    for (uint32_t i = range.indexOffset; i < range.indexOffset + range.indexCount; ++i) {
+      covered[i]++;
+    }
+    for (const ModelAsset::SubMesh &subMesh : data.subMeshes) {
+      bool inside = subMesh.indexOffset >= range.indexOffset &&
+                    subMesh.indexOffset < range.indexOffset + range.indexCount;
+      if (inside && subMesh.materialIndex != range.materialIndex) {
+        fail("draw range mixes materials");
+      }
+    }
+  }
+  if (std::any_of(covered.begin(), covered.end(), [](uint8_t c) { return c != 1; })) {
+    fail("draw ranges do not cover every index exactly once");
+  }
+
+  std::printf("%-16s %zu meshes -> %zu vertices, %zu indices, %zu draw ranges\n", label,
+              meshes.size(), data.vertices.size(), data.indices.size(), ranges.size());
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "submesh_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[SubMesh] %s\n", label);
+      ok = false;
+    }
+  };
+
+  ObjReader::Scene multiMeshScene;
+  ObjReader::Scene multiMaterialScene;
+  if (!ObjReader::Read(kResourceDirectory, "multiMesh.obj", multiMeshScene) ||
+      !ObjReader::Read(kResourceDirectory, "multiMaterial.obj", multiMaterialScene)) {
+    std::fprintf(stderr, "[SubMesh] run from project/ (models are read from %s)\n", kResourceDirectory);
+    return 1;
+  }
+
+  // multiMesh.obj: 同じマテリアルの Plane と Cube（以前は最後のメッシュの頂点しか残らなかった）
+  std::vector<SourceMesh> multiMesh = ToSourceMeshes(multiMeshScene);
+  ModelAsset::ModelData multiMeshData =
+      Merge(multiMesh, static_cast<uint32_t>(multiMeshScene.materials.size()));
+  multiMeshData.materials = multiMeshScene.materials;
+  check("multiMesh has 2 submeshes", multiMeshData.subMeshes.size() == 2);
+  ok &= Verify("multiMesh", multiMesh, multiMeshData, 1);
+  check("multiMesh keeps file order", multiMeshData.subMeshes.size() == 2 &&
+                                          multiMeshData.subMeshes[0].indexCount == 6 &&
+                                          multiMeshData.subMeshes[1].indexCount == 36);
+  check("multiMesh texture", multiMeshData.materials.size() == 2 &&
+                                 multiMeshData.materials[1].textureFilePath ==
+                                     std::string(kResourceDirectory) + "/uvChecker.png");
+
+  // multiMaterial.obj: Plane が Material.001（uvChecker）、Cube が Material（monsterBall）
+  // 0 番は既定マテリアルなので、Cube（1番）が先、Plane（2番）が後に並ぶ
+  std::vector<SourceMesh> multiMaterial = ToSourceMeshes(multiMaterialScene);
+  ModelAsset::ModelData multiMaterialData =
+      Merge(multiMaterial, static_cast<uint32_t>(multiMaterialScene.materials.size()));
+  multiMaterialData.materials = multiMaterialScene.materials;
+  check("multiMaterial has 2 submeshes", multiMaterialData.subMeshes.size() == 2);
+  ok &= Verify("multiMaterial", multiMaterial, multiMaterialData, 2);
+  std::vector<ModelAsset::DrawRange> multiMaterialRanges = ModelAsset::BuildDrawRanges(multiMaterialData.subMeshes);
+  check("multiMaterial sorted by material",
+        multiMaterialRanges.size() == 2 && multiMaterialRanges[0].materialIndex == 1 &&
+            multiMaterialRanges[0].indexCount == 36 && multiMaterialRanges[1].materialIndex == 2 &&
+            multiMaterialRanges[1].indexCount == 6);
+  check("multiMaterial textures",
+        multiMaterialData.materials.size() == 3 && multiMaterialData.materials[0].textureFilePath.empty() &&
+            multiMaterialData.materials[1].textureFilePath == std::string(kResourceDirectory) + "/monsterBall.png" &&
+            multiMaterialData.materials[2].textureFilePath == std::string(kResourceDirectory) + "/uvChecker.png");
+
+  // 結合順を崩しても、同じマテリアルの範囲が別れるだけで全インデックスは1回ずつ描かれる
+  std::vector<SourceMesh> interleaved = {MakeGridMesh(3, 0.0f, 2), MakeGridMesh(4, 10.0f, 1),
+                                         MakeGridMesh(5, 20.0f, 2)};
+  ok &= Verify("grid sorted", interleaved, Merge(interleaved, 3), 2);
+  ModelAsset::ModelData unsorted;
+  for (const SourceMesh &mesh : interleaved) {
+    ModelAsset::AppendSubMesh(unsorted, mesh.vertices, mesh.indices, mesh.materialIndex);
+  }
+  ok &= Verify("grid unsorted", interleaved, unsorted, 3);
+
+  // メッシュキャッシュを通してもサブメッシュとマテリアル表が残る
+  {
+    namespace fs = std::filesystem;
+    const fs::path cacheDir = fs::temp_directory_path() / "submesh_benchmark";
+    MeshCache::SetCacheDirectory(cacheDir.generic_string());
+    const std::string cachePath = MeshCache::GetCachePath("resources/multiMaterial.obj");
+    ModelAsset::ModelData loaded;
+    bool roundTrip = MeshCache::Save(cachePath, {1, 2}, multiMaterialData) &&
+                     MeshCache::Load(cachePath, {1, 2}, loaded) &&
+                     loaded.subMeshes.size() == multiMaterialData.subMeshes.size() &&
+                     loaded.materials.size() == multiMaterialData.materials.size() &&
+                     loaded.materials[2].textureFilePath ==
+                         multiMaterialData.materials[2].textureFilePath &&
+                     ModelAsset::BuildDrawRanges(loaded.subMeshes).size() == 2;
+    fs::remove_all(cacheDir);
+    check("mesh cache keeps submeshes and materials", roundTrip);
+  }
+  if (!ok) {
+    return 1;
+  }
+  std::printf("\n");
+
+  //=========================
+  // 計測
+  //=========================
+  // 64メッシュ・8マテリアルのモデル（分割したまま Object3d を並べると 64 回の描画になる）
+  std::vector<SourceMesh> many;
+  for (uint32_t m = 0; m < 64; ++m) {
+    many.push_back(MakeGridMesh(32, static_cast<float>(m) * 40.0f, m % 8));
+  }
+  ModelAsset::ModelData manyData = Merge(many, 8);
+  std::printf("64 meshes / 8 materials -> %zu draw ranges\n\n",
+              ModelAsset::BuildDrawRanges(manyData.subMeshes).size());
+
+  runner.Run("SubMesh/Merge(64 meshes)", [&](uint64_t) {
+    ModelAsset::ModelData data = Merge(many, 8);
+    Benchmark::DoNotOptimize(data.indices.data());
+  });
+
+  runner.Run("SubMesh/BuildDrawRanges(64 meshes)", [&](uint64_t) {
+    std::vector<ModelAsset::DrawRange> ranges = ModelAsset::BuildDrawRanges(manyData.subMeshes);
+    Benchmark::DoNotOptimize(ranges.data());
+  });
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
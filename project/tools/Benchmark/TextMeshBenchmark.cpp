@@ -0,0 +1,261 @@
+// 文字列のグリフ（TextMesh）の確認とベンチマーク
+// フォントファイルは読まず、グリフの矩形を手で並べたアトラス（FontData）で代用する
+// 並べ方・256 文字を超える文字列・変わったときだけ作り直すこと・同じフォントの Text が1回の描画になることを確かめ、
+// UI の Text 50 個（毎フレーム変わるのはスコアと HP の 2 個）の更新を、毎フレーム作り直す場合と比べる
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -IEngine/include/Render -Iexternals -Iexternals/stb
+//       -o text_mesh_benchmark tools/Benchmark/TextMeshBenchmark.cpp
+//       Engine/src/Render/Text/TextMesh.cpp Engine/src/Render/Renderer/SpriteBatch.cpp
+//       Engine/src/Render/Renderer/RecordingCommandRecorder.cpp Engine/src/Math/MathUtil.cpp
+//
+// 実行例:
+//   ./text_mesh_benchmark --out text_mesh_baseline.json
+//   ./text_mesh_benchmark --baseline text_mesh_baseline.json
+#include "BenchmarkCommon.h"
+#include "Math/MathUtil.h"
+#include "Render/Text/FontManager.h"
+#include "Render/Text/TextMesh.h"
+#include "Renderer/RecordingCommandRecorder.h"
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// stbtt_GetBakedQuad の実装（エンジンでは FontManager.cpp が持つ）
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+
+namespace {
+
+using Type = RecordingCommandRecorder::Type;
+
+// グリフは幅 10・高さ 20 のピクセル、送り幅 12。アトラスには横一列に並べる
+constexpr int kGlyphWidth = 10;
+constexpr int kGlyphHeight = 20;
+constexpr float kAdvance = 12.0f;
+constexpr int kAtlasWidth = 1024;
+constexpr int kAtlasHeight = 32;
+
+FontData MakeHeadlessFont(const std::string &name, float pixelHeight) {
+  FontData font;
+  font.name = name;
+  font.cdata.resize(96);
+  font.textureWidth = kAtlasWidth;
+  font.textureHeight = kAtlasHeight;
+  font.pixelHeight = pixelHeight;
+  for (int i = 0; i < 96; ++i) {
+    stbtt_bakedchar &c = font.cdata[i];
+    c.x0 = uint16_t(i * kGlyphWidth);
+    c.y0 = 0;
+    c.x1 = uint16_t(i * kGlyphWidth + kGlyphWidth);
+    c.y1 = kGlyphHeight;
+    c.xoff = 0.0f;
+    c.yoff = -float(kGlyphHeight); // ベースラインの上に載る
+    c.xadvance = kAdvance;
+  }
+  return font;
+}
+
+bool Near(float a, float b) { return std::fabs(a - b) < 1e-5f; }
+
+// 以前の Text::Update と同じく、毎フレームすべて並べ直して頂点を作る
+uint64_t RebuildAlways(std::vector<std::unique_ptr<TextMesh>> &meshes, const FontData &font,
+                       const std::vector<std::string> &texts, const Matrix4x4 &viewProjection) {
+  uint64_t sum = 0;
+  std::vector<TextMesh::Glyph> glyphs;
+  for (size_t i = 0; i < meshes.size(); ++i) {
+    Vector2 size = TextMesh::Layout(font, texts[i], glyphs);
+    Matrix4x4 wvp = Multiply(MakeAffineMatrix(Vector3{1.0f, 1.0f, 1.0f}, Vector3{0.0f, 0.0f, 0.0f},
+                                              Vector3{float(i % 10) * 120.0f, float(i / 10) * 40.0f, 0.0f}),
+                             viewProjection);
+    for (const TextMesh::Glyph &glyph : glyphs) {
+      Vector4 p = Multiply(Vector4{glyph.leftTop.x - size.x * 0.5f, glyph.leftTop.y, 0.0f, 1.0f}, wvp);
+      sum += uint64_t(p.x * 1000.0f);
+    }
+  }
+  return sum;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "text_mesh_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[TextMesh] %s\n", label);
+      ok = false;
+    }
+  };
+
+  const FontData font = MakeHeadlessFont("headless", 32.0f);
+  const FontData otherFont = MakeHeadlessFont("other", 48.0f);
+
+  {
+    // 送り幅ずつ並び、ベースラインはフォントの高さ
+    std::vector<TextMesh::Glyph> glyphs;
+    Vector2 size = TextMesh::Layout(font, "AB", glyphs);
+    check("glyph count", glyphs.size() == 2);
+    check("size", Near(size.x, 2 * kAdvance) && Near(size.y, 32.0f));
+    check("first glyph", Near(glyphs[0].leftTop.x, 0.0f) && Near(glyphs[0].rightBottom.x, 10.0f) &&
+                             Near(glyphs[0].leftTop.y, 12.0f) && Near(glyphs[0].rightBottom.y, 32.0f));
+    check("second glyph advanced", Near(glyphs[1].leftTop.x, kAdvance));
+    const float u = float(('A' - 32) * kGlyphWidth) / kAtlasWidth;
+    check("atlas uv", Near(glyphs[0].texLeftTop.x, u) && Near(glyphs[0].texLeftTop.y, 0.0f) &&
+                          Near(glyphs[0].texRightBottom.y, float(kGlyphHeight) / kAtlasHeight));
+
+    // アトラスにない文字は飛ばす（送りもしない）
+    size = TextMesh::Layout(font, std::string("A\n\x01") + "\xE3\x81\x82" + "B", glyphs);
+    check("unsupported characters skipped", glyphs.size() == 2 && Near(size.x, 2 * kAdvance));
+
+    // 256 文字を超えても切れない
+    size = TextMesh::Layout(font, std::string(1000, 'x'), glyphs);
+    check("no character limit", glyphs.size() == 1000 && Near(size.x, 1000 * kAdvance));
+
+    size = TextMesh::Layout(font, "", glyphs);
+    check("empty", glyphs.empty() && Near(size.x, 0.0f));
+  }
+
+  {
+    // 変わったときだけ作り直す
+    TextMesh mesh;
+    mesh.SetViewProjection(MakeIdentity4x4());
+    mesh.SetFont(&font);
+    mesh.SetText("Score");
+    check("dirty at first", mesh.IsDirty() && mesh.Update());
+    check("built", mesh.GetGlyphCount() == 5 && mesh.GetVertices().size() == 20 &&
+                       mesh.GetStats().layoutCount == 1 && mesh.GetStats().vertexCount == 1);
+
+    mesh.SetText("Score");
+    mesh.SetFont(&font);
+    mesh.SetColor({1.0f, 1.0f, 1.0f, 1.0f});
+    mesh.SetTransform({{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}});
+    mesh.SetViewProjection(MakeIdentity4x4());
+    check("same values stay clean", !mesh.IsDirty() && !mesh.Update() && mesh.GetStats().vertexCount == 1);
+
+    // 頂点は左下・左上・右下・右上（単位行列ならピクセル座標のまま）
+    const std::vector<SpriteBatch::Vertex> &vertices = mesh.GetVertices();
+    check("quad order", Near(vertices[0].position.y, 32.0f) && Near(vertices[1].position.y, 12.0f) &&
+                            Near(vertices[2].position.x, 10.0f) && Near(vertices[3].position.y, 12.0f) &&
+                            Near(vertices[3].position.x, 10.0f));
+
+    // Transform・色・アンカーは頂点だけ作り直す
+    mesh.SetTransform({{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {100.0f, 50.0f, 0.0f}});
+    check("transform rebuilds vertices", mesh.Update() && mesh.GetStats().layoutCount == 1 &&
+                                             mesh.GetStats().vertexCount == 2 &&
+                                             Near(mesh.GetVertices()[1].position.x, 100.0f) &&
+                                             Near(mesh.GetVertices()[1].position.y, 62.0f));
+    mesh.SetColor({1.0f, 0.0f, 0.0f, 0.5f});
+    check("color rebuilds vertices", mesh.Update() && mesh.GetStats().layoutCount == 1 &&
+                                         Near(mesh.GetVertices()[7].color.x, 1.0f) &&
+                                         Near(mesh.GetVertices()[7].color.w, 0.5f));
+    mesh.SetAnchorPoint({0.5f, 0.0f});
+    check("anchor shifts by half the width", mesh.Update() && mesh.GetStats().layoutCount == 1 &&
+                                                 Near(mesh.GetVertices()[1].position.x, 100.0f - 2.5f * kAdvance));
+
+    // 文字列・フォントは並べ直す
+    mesh.SetText("Score 100");
+    check("text relayouts", mesh.Update() && mesh.GetStats().layoutCount == 2 && mesh.GetGlyphCount() == 9);
+    mesh.SetFont(&otherFont);
+    check("font relayouts", mesh.Update() && mesh.GetStats().layoutCount == 3 && Near(mesh.GetSize().y, 48.0f));
+
+    // フォントがなければ空（読み込まれたら作り直す）
+    mesh.SetFont(nullptr);
+    check("missing font is empty", mesh.Update() && mesh.GetGlyphCount() == 0 && mesh.GetVertices().empty());
+    mesh.SetFont(&font);
+    check("font arrives", mesh.Update() && mesh.GetGlyphCount() == 9);
+  }
+
+  {
+    // 同じフォントの Text は1つのバッチ・1回の描画になる（間に別のフォントが挟まると分かれる）
+    constexpr ICommandRecorder::DescriptorHandle kAtlas = 0x1000;
+    constexpr ICommandRecorder::DescriptorHandle kOtherAtlas = 0x2000;
+    std::vector<TextMesh> meshes(3);
+    for (size_t i = 0; i < meshes.size(); ++i) {
+      meshes[i].SetViewProjection(MakeIdentity4x4());
+      meshes[i].SetFont(&font);
+      meshes[i].SetText(std::string(300, char('a' + i)));
+      meshes[i].Update();
+    }
+    SpriteBatch batch;
+    SpriteBatch::State state;
+    state.texture = kAtlas;
+    for (const TextMesh &mesh : meshes) {
+      batch.Add(state, mesh.GetVertices().data(), mesh.GetGlyphCount());
+    }
+    int pipeline = 0;
+    RecordingCommandRecorder recorder;
+    ICommandRecorder::IndexBufferView indexBuffer{0x20000000, 0, ICommandRecorder::IndexFormat::UInt16};
+    batch.Record(recorder, 0x10000000, indexBuffer, 0, [&](const SpriteBatch::State &) { return &pipeline; });
+    check("same font is one draw", batch.GetBatches().size() == 1 && batch.GetQuadCount() == 900 &&
+                                       recorder.GetDrawCount() == 1 &&
+                                       recorder.GetCommands().back().count == 900 * 6);
+
+    SpriteBatch::State otherState;
+    otherState.texture = kOtherAtlas;
+    batch.Add(otherState, meshes[0].GetVertices().data(), meshes[0].GetGlyphCount());
+    batch.Add(state, meshes[1].GetVertices().data(), meshes[1].GetGlyphCount());
+    check("other font splits", batch.GetBatches().size() == 3);
+    batch.Add(state, nullptr, 0);
+    check("empty text adds nothing", batch.GetBatches().size() == 3 && batch.GetQuadCount() == 1500);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  // UI の Text 50 個（20 文字程度）。毎フレーム変わるのはスコアと HP の 2 個だけ
+  constexpr size_t kTextCount = 50;
+  const Matrix4x4 viewProjection = MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 100.0f);
+  std::vector<std::unique_ptr<TextMesh>> meshes;
+  std::vector<std::string> texts;
+  for (size_t i = 0; i < kTextCount; ++i) {
+    meshes.push_back(std::make_unique<TextMesh>());
+    meshes.back()->SetViewProjection(viewProjection);
+    meshes.back()->SetFont(&font);
+    meshes.back()->SetAnchorPoint({0.5f, 0.0f});
+    meshes.back()->SetTransform(
+        {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {float(i % 10) * 120.0f, float(i / 10) * 40.0f, 0.0f}});
+    texts.push_back("Label " + std::to_string(i) + " : static text");
+  }
+
+  uint32_t frame = 0;
+  runner.Run("TextMesh/dirty-tracked update (50 texts, 2 changing)", [&](uint64_t) {
+    ++frame;
+    texts[0] = "Score " + std::to_string(frame * 10);
+    texts[1] = "HP " + std::to_string(100 - frame % 100);
+    uint32_t rebuilt = 0;
+    for (size_t i = 0; i < kTextCount; ++i) {
+      meshes[i]->SetText(texts[i]);
+      meshes[i]->SetFont(&font);
+      meshes[i]->SetAnchorPoint({0.5f, 0.0f});
+      meshes[i]->SetTransform(
+          {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {float(i % 10) * 120.0f, float(i / 10) * 40.0f, 0.0f}});
+      meshes[i]->SetColor({1.0f, 1.0f, 1.0f, 1.0f});
+      rebuilt += meshes[i]->Update() ? 1 : 0;
+    }
+    Benchmark::DoNotOptimize(rebuilt);
+  });
+  runner.Run("TextMesh/rebuild every frame (50 texts)", [&](uint64_t) {
+    ++frame;
+    texts[0] = "Score " + std::to_string(frame * 10);
+    texts[1] = "HP " + std::to_string(100 - frame % 100);
+    Benchmark::DoNotOptimize(RebuildAlways(meshes, font, texts, viewProjection));
+  });
+  std::printf("50 texts: %u layouts of the score text, static labels laid out %u time(s); "
+              "draws: 50 before, 1 batched\n",
+              meshes[0]->GetStats().layoutCount, meshes[10]->GetStats().layoutCount);
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}
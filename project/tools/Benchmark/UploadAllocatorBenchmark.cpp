@@ -0,0 +1,239 @@
+// フレームごとの定数データ用アロケータ（LinearUploadAllocator）の確認とベンチマーク
+// ページは malloc した領域、フェンスはただのカウンタで代用し、GPU の完了の遅れ（フレームの重なり）も再現する
+// 計測では Object3d 5000 個分（座標変換・カメラ・マテリアル）の定数データを毎フレーム書き出す
+//
+// ビルド例（Linux, project/ ディレクトリで実行）:
+//   g++ -std=c++20 -O2 -IEngine/include -Iexternals -o upload_allocator_benchmark
+//       tools/Benchmark/UploadAllocatorBenchmark.cpp Engine/src/Core/LinearUploadAllocator.cpp
+//
+// 実行例:
+//   ./upload_allocator_benchmark --out upload_allocator_baseline.json
+//   ./upload_allocator_benchmark --baseline upload_allocator_baseline.json
+#include "BenchmarkCommon.h"
+#include "Core/LinearUploadAllocator.h"
+#include "Math/Matrix4x4.h"
+#include "Math/Vector4.h"
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Logger は Windows に依存するので、ここでは標準エラーへ流す
+namespace Logger {
+void Log(const std::string &message) { std::fputs(message.c_str(), stderr); }
+} // namespace Logger
+
+namespace {
+
+// アップロードヒープの代わり（GPU アドレスはページごとに離した値）
+class FakeUploadHeap {
+public:
+  bool CreatePage(size_t size, LinearUploadAllocator::Page &page) {
+    if (failNext_) {
+      failNext_ = false;
+      return false;
+    }
+    pages_.push_back(std::make_unique<uint8_t[]>(size));
+    page.cpu = pages_.back().get();
+    page.gpuAddress = 0x100000000ull * pages_.size();
+    page.size = size;
+    return true;
+  }
+
+  LinearUploadAllocator::CreatePage Callback() {
+    return [this](size_t size, LinearUploadAllocator::Page &page) { return CreatePage(size, page); };
+  }
+
+  size_t GetPageCount() const { return pages_.size(); }
+  void FailNext() { failNext_ = true; }
+
+private:
+  std::vector<std::unique_ptr<uint8_t[]>> pages_;
+  bool failNext_ = false;
+};
+
+// フェンスの代わり。Signal した値は framesInFlight フレーム遅れて完了する
+class FakeFence {
+public:
+  explicit FakeFence(uint32_t framesInFlight) : framesInFlight_(framesInFlight) {}
+
+  uint64_t Signal() {
+    ++value_;
+    pending_.push_back(value_);
+    while (pending_.size() > framesInFlight_) {
+      completed_ = pending_.front();
+      pending_.pop_front();
+    }
+    return value_;
+  }
+
+  uint64_t GetCompletedValue() const { return completed_; }
+
+private:
+  uint32_t framesInFlight_;
+  uint64_t value_ = 0;
+  uint64_t completed_ = 0;
+  std::deque<uint64_t> pending_;
+};
+
+// Object3d の定数データ（Object3d.h の TransformationMatrix・CameraForGPU・Model::Material と同じ大きさ程度）
+struct TransformationMatrix {
+  Matrix4x4 WVP;
+  Matrix4x4 World;
+  Matrix4x4 WorldInverseTranspose;
+};
+struct CameraData {
+  float worldPosition[3];
+};
+struct MaterialData {
+  Vector4 color;
+  int32_t enableLighting;
+  float padding[3];
+  Matrix4x4 uvTransform;
+  float shininess;
+  float environmentCoefficient;
+  int32_t enableDissolve;
+  float dissolveThreshold;
+  Vector4 dissolveEdgeColor;
+};
+
+// 1フレーム分（Object3d::Draw の UploadFrameConstants と同じ書き出し）
+uint64_t UploadFrame(LinearUploadAllocator &allocator, uint32_t objectCount, const TransformationMatrix &transform,
+                     const CameraData &camera, const MaterialData &material) {
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < objectCount; ++i) {
+    sum += allocator.Upload(transform).gpuAddress;
+    sum += allocator.Upload(camera).gpuAddress;
+    sum += allocator.Upload(material).gpuAddress;
+  }
+  return sum;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Benchmark::Options options = Benchmark::ParseOptions(argc, argv, "upload_allocator_benchmark.json");
+  Benchmark::Runner runner(options);
+
+  //=========================
+  // 動作確認
+  //=========================
+  bool ok = true;
+  auto check = [&](const char *label, bool condition) {
+    if (!condition) {
+      std::fprintf(stderr, "[UploadAllocator] %s\n", label);
+      ok = false;
+    }
+  };
+
+  {
+    FakeUploadHeap heap;
+    LinearUploadAllocator allocator;
+    allocator.Initialize(4096, heap.Callback());
+
+    // 256 バイト境界で先頭から詰める
+    LinearUploadAllocator::Allocation a = allocator.Allocate(100);
+    LinearUploadAllocator::Allocation b = allocator.Allocate(300);
+    LinearUploadAllocator::Allocation c = allocator.Allocate(16);
+    check("first allocation at page start", a && a.gpuAddress % 256 == 0 && a.size == 256);
+    check("aligned and packed", b.gpuAddress == a.gpuAddress + 256 && b.size == 512 &&
+                                    c.gpuAddress == b.gpuAddress + 512);
+    check("cpu matches gpu offset", static_cast<uint8_t *>(c.cpu) - static_cast<uint8_t *>(a.cpu) ==
+                                        int64_t(c.gpuAddress - a.gpuAddress));
+    check("one page", heap.GetPageCount() == 1 && allocator.GetStats().allocationCount == 3);
+
+    // 大きい境界
+    LinearUploadAllocator::Allocation d = allocator.Allocate(16, 1024);
+    check("custom alignment", d.gpuAddress % 1024 == 0 && d.gpuAddress >= c.gpuAddress + 256);
+
+    // Upload は中身を写す
+    MaterialData material{};
+    material.color = {0.25f, 0.5f, 0.75f, 1.0f};
+    LinearUploadAllocator::Allocation e = allocator.Upload(material);
+    check("upload copies", e && static_cast<MaterialData *>(e.cpu)->color.y == 0.5f);
+
+    // ページに入らなければ次のページ
+    LinearUploadAllocator::Allocation f = allocator.Allocate(3000);
+    check("overflow opens a new page", heap.GetPageCount() == 2 && f.gpuAddress % 0x100000000ull == 0);
+
+    // ページより大きい要求は専用のページ
+    LinearUploadAllocator::Allocation g = allocator.Allocate(10000);
+    check("large allocation", g && g.size == 10240 && heap.GetPageCount() == 3);
+
+    // フェンスが完了するまでは使い回さない
+    allocator.EndFrame(1);
+    check("retired", allocator.GetStats().retiredPageCount == 3 && allocator.GetStats().frameBytes == 0);
+    allocator.Reclaim(0);
+    allocator.Allocate(256);
+    check("not reused before fence", heap.GetPageCount() == 4);
+    allocator.EndFrame(2);
+    allocator.Reclaim(1);
+    check("reclaimed after fence",
+          allocator.GetStats().freePageCount == 3 && allocator.GetStats().retiredPageCount == 1);
+    LinearUploadAllocator::Allocation h = allocator.Allocate(256);
+    check("reused", heap.GetPageCount() == 4 && h.gpuAddress % 0x100000000ull == 0);
+    LinearUploadAllocator::Allocation i = allocator.Allocate(8000);
+    check("large page reused", heap.GetPageCount() == 4 && i.size == 8192);
+
+    // ページが作れなければ空
+    allocator.Allocate(4096);
+    heap.FailNext();
+    LinearUploadAllocator::Allocation j;
+    // 失敗は assert で止まるので、NDEBUG のときだけ確かめる
+#ifdef NDEBUG
+    j = allocator.Allocate(4096);
+    check("failed page returns empty", !j);
+#endif
+    (void)j;
+  }
+
+  {
+    // 2 フレーム重なっても、ページ数はすぐに頭打ちになる
+    FakeUploadHeap heap;
+    FakeFence fence(2);
+    LinearUploadAllocator allocator;
+    allocator.Initialize(64 * 1024, heap.Callback());
+    TransformationMatrix transform{};
+    CameraData camera{};
+    MaterialData material{};
+    size_t pagesAfterWarmup = 0;
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+      allocator.Reclaim(fence.GetCompletedValue());
+      UploadFrame(allocator, 100 + (frame % 7) * 10, transform, camera, material);
+      allocator.EndFrame(fence.Signal());
+      if (frame == 10) {
+        pagesAfterWarmup = heap.GetPageCount();
+      }
+    }
+    check("steady page count", heap.GetPageCount() == pagesAfterWarmup && pagesAfterWarmup <= 3 * 4);
+  }
+  if (!ok) {
+    return 1;
+  }
+
+  //=========================
+  // 計測
+  //=========================
+  constexpr uint32_t kObjectCount = 5000;
+  FakeUploadHeap heap;
+  FakeFence fence(2);
+  LinearUploadAllocator allocator;
+  allocator.Initialize(LinearUploadAllocator::kDefaultPageSize, heap.Callback());
+  TransformationMatrix transform{};
+  CameraData camera{};
+  MaterialData material{};
+
+  runner.Run("UploadAllocator/frame constants (5000 objects)", [&](uint64_t) {
+    allocator.Reclaim(fence.GetCompletedValue());
+    Benchmark::DoNotOptimize(UploadFrame(allocator, kObjectCount, transform, camera, material));
+    allocator.EndFrame(fence.Signal());
+  });
+  std::printf("5000 objects: %zu pages of %zu KiB (instead of %u committed buffers)\n", heap.GetPageCount(),
+              LinearUploadAllocator::kDefaultPageSize / 1024, kObjectCount * 3);
+
+  bool saved = runner.Save();
+  bool compared = runner.CompareWithBaseline();
+  return (saved && compared) ? 0 : 1;
+}